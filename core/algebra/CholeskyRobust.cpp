@@ -9,6 +9,7 @@
 
 #include "CholeskyRobust.h"
 #include "core/vector/Algorithms.h"
+#include "core/basics/Log.h"
 
 #ifdef NICE_USELIB_CUDACHOLESKY
 #include "cholesky-gpu/niceinterface/CudaCholeskyNICE.h"
@@ -32,7 +33,7 @@ CholeskyRobust::robustChol (const Matrix & A, Matrix & cholA)
 	Matrix ARegularized (A);
 
 	if (m_verbose)
-		cerr << "CholeskyRobust::robustChol: Adding noise " << m_noise << endl;
+		NICE_LOG_DEBUG ( "CholeskyRobust::robustChol: Adding noise " << m_noise );
 
   // add a constant value to the diagonal
 	ARegularized.addIdentity (m_noise);
@@ -58,7 +59,7 @@ CholeskyRobust::robustChol (const Matrix & A, Matrix & cholA)
   // multiplication by 2 is necessary, because ARegularized = cholA'*cholA
 	m_logDetMatrix = 2 * triangleMatrixLogDet (cholA);
 	if (m_verbose)
-		cerr << "CholeskyRobust::robustChol: Cholesky condition (logdet): " << m_logDetMatrix << endl;
+		NICE_LOG_DEBUG ( "CholeskyRobust::robustChol: Cholesky condition (logdet): " << m_logDetMatrix );
 
   // if the log determinant is NaN or Inf, then we should warn!
 	if (!NICE::isFinite (m_logDetMatrix))
@@ -76,7 +77,7 @@ CholeskyRobust::robustCholInv (const Matrix & A, Matrix & invA)
 	Matrix G;
 	double noise = robustChol (A, G);
 	if (m_verbose)
-		cerr << "CholeskyRobust::robustChol: Cholesky inversion" << endl;
+		NICE_LOG_DEBUG ( "CholeskyRobust::robustChol: Cholesky inversion" );
 
 	choleskyInvertLargeScale (G, invA);
 
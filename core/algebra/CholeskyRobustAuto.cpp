@@ -10,6 +10,7 @@
 #include "core/vector/Algorithms.h"
 
 #include "CholeskyRobustAuto.h"
+#include "core/basics/Log.h"
 
 // include the optional cholesky sub-library, when available
 #ifdef NICE_USELIB_CUDACHOLESKY
@@ -40,7 +41,7 @@ CholeskyRobustAuto::robustChol (const Matrix & A, Matrix & cholA)
 	Matrix ARegularized (A);
 
 	if (m_verbose)
-		cerr << "CholeskyRobustAuto::robustChol: A " << A.rows () << " x " << A.cols () << endl;
+		NICE_LOG_DEBUG ( "CholeskyRobustAuto::robustChol: A " << A.rows () << " x " << A.cols () );
 
 	int i = 0;
 	double noise = 0.0;
@@ -54,7 +55,7 @@ CholeskyRobustAuto::robustChol (const Matrix & A, Matrix & cholA)
 		robust = true;
 
 		if (m_verbose)
-			cerr << "CholeskyRobustAuto::robustChol: Cholesky decomposition" << endl;
+			NICE_LOG_DEBUG ( "CholeskyRobustAuto::robustChol: Cholesky decomposition" );
 
 		try
 		{
@@ -74,7 +75,7 @@ CholeskyRobustAuto::robustChol (const Matrix & A, Matrix & cholA)
 		catch (Exception)
 		{
 			if (m_verbose)
-				cerr << "CholeskyRobustAuto::robustChol: failed!" << endl;
+				NICE_LOG_ERROR ( "CholeskyRobustAuto::robustChol: failed!" );
       // Cholesky decomposition failed, therefore, we have to run again
 			robust = false;
 		}
@@ -83,9 +84,7 @@ CholeskyRobustAuto::robustChol (const Matrix & A, Matrix & cholA)
 		if (robust && cholA.containsNaN ())
 		{
 			if (m_verbose)
-				cerr <<
-					"CholeskyRobustAuto::robustChol: cholesky matrix contains NaN values"
-					<< endl;
+				NICE_LOG_WARNING ( "CholeskyRobustAuto::robustChol: cholesky matrix contains NaN values" );
       // if it contains NaNs it is surely not robust
 			robust = false;
 		}
@@ -98,8 +97,7 @@ CholeskyRobustAuto::robustChol (const Matrix & A, Matrix & cholA)
       // compute the log determinant
 			m_logDetMatrix = 2 * triangleMatrixLogDet (cholA);
 			if (m_verbose)
-				cerr << "CholeskyRobustAuto::robustChol: Cholesky condition: " <<
-					m_logDetMatrix << endl;
+				NICE_LOG_DEBUG ( "CholeskyRobustAuto::robustChol: Cholesky condition: " << m_logDetMatrix );
 		}
 
 
@@ -112,8 +110,7 @@ CholeskyRobustAuto::robustChol (const Matrix & A, Matrix & cholA)
 		{
 			robust = false;
 			if (m_verbose)
-				cerr << "CholeskyRobustAuto::robustChol: Adding noise " << noiseStepExp
-					<< endl;
+				NICE_LOG_DEBUG ( "CholeskyRobustAuto::robustChol: Adding noise " << noiseStepExp );
 
       // in case the last estimate was not robust 
       // (1) add something to the diagonal
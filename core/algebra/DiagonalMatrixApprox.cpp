@@ -6,6 +6,9 @@
 
 */
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 #include <core/optimization/gradientBased/FirstOrderRasmussen.h>
 #include <core/vector/Eigen.h>
@@ -13,10 +16,53 @@
 #include "DiagonalMatrixApprox.h"
 
 #include "core/basics/numerictools.h"
+#include "core/basics/Log.h"
 
 using namespace NICE;
 using namespace std;
 
+namespace {
+
+/** A - diag(D) of a symmetric matrix A */
+class GMShiftedSymmetric : public GenericMatrix
+{
+  protected:
+    const Matrix *A;
+    const Vector *D;
+
+  public:
+    GMShiftedSymmetric ( const Matrix *_A, const Vector *_D ) : A ( _A ), D ( _D )
+    {
+    };
+
+    uint rows () const
+    {
+      return A->rows();
+    };
+
+    uint cols () const
+    {
+      return A->cols();
+    };
+
+    void multiply ( Vector & y, const Vector & x ) const
+    {
+      y.resize ( A->rows() );
+      // A is symmetric, the transposed product reads its columns contiguously
+      y.multiply ( *A, x, true );
+      for ( uint i = 0 ; i < y.size(); i++ )
+        y[i] -= (*D)[i] * x[i];
+    }
+};
+
+/** eigenvalues lambda_i with (lambda_max - lambda_i)/epsilon above this value have a negligible weight */
+const double maxLogWeight = 36.0;
+
+/** initial number of eigenvalues of the partial decomposition */
+const uint initialNumEigenvalues = 16;
+
+}
+
 
 DiagonalMatrixApprox::DiagonalMatrixApprox( bool verbose, int maxIterations )
 {
@@ -27,6 +73,9 @@ DiagonalMatrixApprox::DiagonalMatrixApprox( bool verbose, int maxIterations )
 
   this->maxEpsilonIterations = 100;
 
+  this->minDimensionPartial = 1000;
+  this->maxNumEigenvalues = 200;
+
   this->verbose = verbose;
   this->optimizer = new FirstOrderRasmussen( /*false*/ this->verbose );
   ( dynamic_cast< FirstOrderRasmussen * > (optimizer) )->setMaxIterations(maxIterations);
@@ -37,6 +86,12 @@ DiagonalMatrixApprox::~DiagonalMatrixApprox()
 {
 }
 
+void DiagonalMatrixApprox::setPartialEigenDecomposition ( uint minDimension, uint maxNumEigenvalues )
+{
+  this->minDimensionPartial = minDimension;
+  this->maxNumEigenvalues = maxNumEigenvalues;
+}
+
 void DiagonalMatrixApprox::approx ( const Matrix & A, Vector & D ) const
 {
   double f0 = std::numeric_limits<double>::max();
@@ -50,13 +105,17 @@ void DiagonalMatrixApprox::approx ( const Matrix & A, Vector & D ) const
 
   Vector D0 ( D );
 
+  // the problem keeps its workspace and eigendecomposition for all values of epsilon
+  const uint numEigenvalues = ( A.rows() >= minDimensionPartial ) ? maxNumEigenvalues : 0;
+  DiagonalMatrixApproxOptimizationProblem opt ( &A, D0, epsilonStart, false /*verbose*/, numEigenvalues );
+
   double epsilon = epsilonStart;
   for ( uint i = 0; i < maxEpsilonIterations; i++ )
   {
     epsilon = epsilonShrinkFactor * epsilon;
 
     // perform minimization with some gradient based method (this is a convex optimization problem)
-    DiagonalMatrixApproxOptimizationProblem opt ( &A, D0, epsilon, false /*verbose*/ );
+    opt.reset ( D0, epsilon );
 
     optimizer->optimizeFirst ( opt );
 
@@ -65,8 +124,8 @@ void DiagonalMatrixApprox::approx ( const Matrix & A, Vector & D ) const
 
     if ( verbose )
     {
-      cerr << "DiagonalMatrixApprox [" << i << " / " << maxEpsilonIterations << "]: " << f << " (epsilon=" << epsilon << ")" << endl;
-      cerr << D << endl;
+      NICE_LOG_DEBUG ( "DiagonalMatrixApprox [" << i << " / " << maxEpsilonIterations << "]: " << f << " (epsilon=" << epsilon << ")" );
+      NICE_LOG_DEBUG ( D );
     }
 
 	if ( !NICE::isFinite(f) )
@@ -74,7 +133,7 @@ void DiagonalMatrixApprox::approx ( const Matrix & A, Vector & D ) const
       f = f0;
       D = D0;
       if ( verbose )
-        cerr << "DiagonalMatrixApprox ended in iteration " << i << " due to numerical problems when decreasing epsilon..." << endl;
+        NICE_LOG_DEBUG ( "DiagonalMatrixApprox ended in iteration " << i << " due to numerical problems when decreasing epsilon..." );
       return;
     } 
 
@@ -82,7 +141,7 @@ void DiagonalMatrixApprox::approx ( const Matrix & A, Vector & D ) const
     if ( eig_small < 0.0 )
     {
       if ( verbose )
-        cerr << "DiagonalMatrixApprox: resetting current value due to negative eigenvalue: " << eig_small << endl;
+        NICE_LOG_DEBUG ( "DiagonalMatrixApprox: resetting current value due to negative eigenvalue: " << eig_small );
       D = f0;
       D = D0;
     } else {
@@ -93,7 +152,7 @@ void DiagonalMatrixApprox::approx ( const Matrix & A, Vector & D ) const
       if ( fDelta < minFDelta || solDelta < minSolDelta ) 
       {
         if ( verbose )
-          cerr << "DiagonalMatrixApprox: convergence detected delta_f=" << fDelta << " x_delta=" << solDelta << endl;
+          NICE_LOG_DEBUG ( "DiagonalMatrixApprox: convergence detected delta_f=" << fDelta << " x_delta=" << solDelta );
         return;
       }
     }
@@ -106,53 +165,101 @@ void DiagonalMatrixApprox::approx ( const Matrix & A, Vector & D ) const
 
 }
     
-DiagonalMatrixApproxOptimizationProblem::DiagonalMatrixApproxOptimizationProblem ( const Matrix *A, const Vector & D0, double epsilon, bool verbose ) 
+DiagonalMatrixApproxOptimizationProblem::DiagonalMatrixApproxOptimizationProblem ( const Matrix *A, const Vector & D0, double epsilon, bool verbose,
+                                                                                  uint maxNumEigenvalues ) 
   : OptimizationProblemFirst( D0.size() )
 {
   this->A = A;
   this->parameters() = D0;
   this->epsilon = epsilon;
   this->verbose = verbose;
+  this->maxNumEigenvalues = maxNumEigenvalues;
+  this->numEigenvalues = 0;
+  this->decompositionValid = false;
+  this->lanczosSmallest.setSmallest ( true );
 }
 
+void DiagonalMatrixApproxOptimizationProblem::reset ( const Vector & D0, double epsilon )
+{
+  this->parameters() = D0;
+  this->epsilon = epsilon;
+  init();
+}
 
-double DiagonalMatrixApproxOptimizationProblem::computeObjective()
+bool DiagonalMatrixApproxOptimizationProblem::decompose ()
 {
   // Theoretically, we have to compute lambda_max(A - diag(D)). However, we want to solve
   // the regularized and relaxed optimization problem, which involves all eigenvalues
-  
+  // (or at least the ones with a non-negligible weight)
   const Vector & D = parameters();
-  Matrix M = (*A);
-  M.addDiagonal ( (-1.0) * D );
+  const uint n = D.size();
+  const bool partial = ( maxNumEigenvalues > 0 && maxNumEigenvalues < n );
 
-  if ( verbose ) {
-    cerr << "M = " << M << endl;
-    cerr << "D = " << D << endl;
-    cerr << "A = " << *A << endl;
+  if ( decompositionValid && decompositionPosition == D )
+  {
+    // a smaller epsilon might need more eigenvalues
+    const uint k = eigenvalues.size();
+    if ( !partial || k >= maxNumEigenvalues || ( eigenvalues[0] - eigenvalues[k - 1] ) / epsilon > maxLogWeight )
+      return true;
   }
 
-  //if ( verbose )
-  //  cerr << "Computing the eigenvalue decomposition ..." << endl;
-  
   try {
-    eigenvectorvalues  ( M, eigenvectors, eigenvalues );
+    if ( !partial )
+    {
+      // no reallocation after the first call
+      workspace = *A;
+      for ( uint i = 0 ; i < n ; i++ )
+        workspace(i,i) -= D[i];
+
+      if ( verbose ) {
+        NICE_LOG_DEBUG ( "M = " << workspace );
+        NICE_LOG_DEBUG ( "D = " << D );
+        NICE_LOG_DEBUG ( "A = " << *A );
+      }
+
+      eigenvectorvalues ( workspace, eigenvectors, eigenvalues );
+    } else {
+      // the eigenvectors of the previous position are the start vectors
+      GMShiftedSymmetric M ( A, &D );
+      if ( numEigenvalues == 0 )
+        numEigenvalues = std::min ( initialNumEigenvalues, maxNumEigenvalues );
+
+      while ( true )
+      {
+        lanczos.getEigenvalues ( M, eigenvalues, eigenvectors, numEigenvalues );
+        if ( numEigenvalues >= maxNumEigenvalues
+             || ( eigenvalues[0] - eigenvalues[numEigenvalues - 1] ) / epsilon > maxLogWeight )
+          break;
+        numEigenvalues = std::min ( 2 * numEigenvalues, maxNumEigenvalues );
+      }
+
+      if ( verbose )
+        NICE_LOG_DEBUG ( "DiagonalMatrixApprox: " << numEigenvalues << " eigenvalues with "
+                         << lanczos.getNumMultiplications() << " matrix-vector multiplications" );
+    }
   } catch ( ... ) {
-    // the matrix seems to be singular, maybe this is a good sign.
-    // Does not have to be: only the smallest eigenvalue can be zero
-    return 0.0;
+    decompositionValid = false;
+    return false;
   }
 
-  //if ( verbose )
-  //  cerr << "Computing the objective ..." << endl;
+  decompositionPosition = D;
+  decompositionValid = true;
+  return true;
+}
+
+double DiagonalMatrixApproxOptimizationProblem::objectiveOfDecomposition()
+{
+  const Vector & D = parameters();
+
   double sumExp = 0.0;
   for ( uint i = 0 ; i < eigenvalues.size(); i++ )
     sumExp += exp( eigenvalues[i] / epsilon );
 
   double fval = epsilon * log( sumExp ) + 0.5 * D.scalarProduct(D); 
 
-  //if ( verbose ) {
-    cerr << "DiagonalMatrixApprox: maximum eigenvalue is " << eigenvalues.Max() << endl;
-  //}
+  if ( verbose ) {
+    NICE_LOG_DEBUG ( "DiagonalMatrixApprox: maximum eigenvalue is " << eigenvalues.Max() );
+  }
 
   if ( !NICE::isFinite(fval) )
   {
@@ -160,50 +267,84 @@ double DiagonalMatrixApproxOptimizationProblem::computeObjective()
     fval = numeric_limits<double>::infinity();
   }
 
-  //if ( verbose )
-  //  cerr << "Objective value of the sub-problem is: " << fval << endl;
-
   return fval;
 }
 
-void DiagonalMatrixApproxOptimizationProblem::computeGradient(Vector& newGradient)
+void DiagonalMatrixApproxOptimizationProblem::gradientOfDecomposition(Vector& newGradient)
 {
-  // inefficient but straightforward implementation with matrices P (denoted as A in the MATLAB code)
+  // gradient_i = D_i - sum_j mu_j V(i,j)^2 with the softmax weights mu of the eigenvalues,
+  // i.e. the diagonal of V diag(mu) V^T (P_i in the MATLAB code selects element i)
   const Vector & D = parameters();
-  uint n = D.size();
+  const uint n = D.size();
+  const uint k = eigenvalues.size();
 
-  Matrix P ( n, n, 0.0 );
-  Matrix W ( n, n, 0.0 );
+  newGradient = D;
+  if ( k == 0 )
+    return;
 
   if ( verbose ) {
-    cerr << "Eigenvectors are: " << eigenvectors << endl;
-    cerr << "Eigenvalues are: " << eigenvalues << endl;
-  }
-
-  for ( uint i = 0 ; i < n ; i++ )
-  {
-    P(i,i) = 1.0;
-    Matrix Ptilde = eigenvectors.transpose() * P * eigenvectors;
-    for ( uint j = 0 ; j < n ; j++ )
-      W(j,i) = Ptilde(j,j);
-    P(i,i) = 0.0;
+    NICE_LOG_DEBUG ( "Eigenvectors are: " << eigenvectors );
+    NICE_LOG_DEBUG ( "Eigenvalues are: " << eigenvalues );
   }
 
   double eigmax = eigenvalues.Max();
 
-  Vector mu (n);
-  for ( uint i = 0 ; i < n ; i++ )
-    mu[i] = exp( (eigenvalues[i] - eigmax)/epsilon );
-  
+  Vector mu (k);
+  for ( uint j = 0 ; j < k ; j++ )
+    mu[j] = exp( (eigenvalues[j] - eigmax)/epsilon );
   mu.normalizeL1();
-  if ( verbose ) {
-    cerr << "W = " << W << endl;
-    cerr << "mu = " << mu << endl; 
-  }
 
-  newGradient = - 1.0 * W.transpose() * mu + D;
+  for ( uint j = 0 ; j < k ; j++ )
+  {
+    if ( (eigmax - eigenvalues[j]) / epsilon > maxLogWeight )
+      continue;
+    const double *v = eigenvectors.getDataPointer() + (size_t)j * n;
+    for ( uint i = 0 ; i < n ; i++ )
+      newGradient[i] -= mu[j] * v[i] * v[i];
+  }
 
   if ( verbose ) {
-    cerr << "gradient = " << newGradient << endl;
+    NICE_LOG_DEBUG ( "gradient = " << newGradient );
+  }
+}
+
+double DiagonalMatrixApproxOptimizationProblem::computeObjective()
+{
+  if ( !decompose() )
+  {
+    // the matrix seems to be singular, maybe this is a good sign.
+    // Does not have to be: only the smallest eigenvalue can be zero
+    return 0.0;
   }
+
+  return objectiveOfDecomposition();
+}
+
+void DiagonalMatrixApproxOptimizationProblem::computeGradient(Vector& newGradient)
+{
+  // reuses the decomposition of the objective at the same position
+  decompose();
+  gradientOfDecomposition ( newGradient );
+}
+
+double DiagonalMatrixApproxOptimizationProblem::computeObjectiveAndGradient(Vector& newGradient)
+{
+  const bool decomposed = decompose();
+  gradientOfDecomposition ( newGradient );
+  return decomposed ? objectiveOfDecomposition() : 0.0;
+}
+
+double DiagonalMatrixApproxOptimizationProblem::getSmallestEigenvalue ()
+{
+  if ( !decompose() || eigenvalues.size() == 0 )
+    return 0.0;
+
+  if ( eigenvalues.size() == dimension() )
+    return eigenvalues[eigenvalues.size() - 1];
+
+  // the partial decomposition only contains the largest eigenvalues
+  GMShiftedSymmetric M ( A, &parameters() );
+  Vector smallestEigenvalue;
+  lanczosSmallest.getEigenvalues ( M, smallestEigenvalue, smallestEigenvector, 1 );
+  return smallestEigenvalue[0];
 }
@@ -12,6 +12,8 @@
 #include <core/optimization/gradientBased/OptimizationProblemFirst.h>
 #include <core/optimization/gradientBased/OptimizationAlgorithmFirst.h>
 
+#include "EigValues.h"
+
 namespace NICE {
   
 /** @class DiagonalMatrixApprox
@@ -33,6 +35,8 @@ class DiagonalMatrixApprox
 
     uint maxEpsilonIterations;
 
+    uint minDimensionPartial;
+    uint maxNumEigenvalues;
 
     OptimizationAlgorithmFirst *optimizer;
 
@@ -52,10 +56,25 @@ class DiagonalMatrixApprox
     * @param D resulting diagonal matrix given as a vector
     */
     void approx ( const Matrix & A, Vector & D ) const;
+
+    /**
+    * @brief Use the partial eigendecomposition (EVLanczos) for large matrices
+    *
+    * @param minDimension matrices with at least this number of rows (default: 1000)
+    * @param maxNumEigenvalues maximum number of eigenvalues (default: 200)
+    */
+    void setPartialEigenDecomposition ( uint minDimension, uint maxNumEigenvalues = 200 );
      
 };
 
-/** corresponding optimization problem of DiagonalMatrixApprox (do not use directly) */
+/** corresponding optimization problem of DiagonalMatrixApprox (do not use directly)
+ *
+ * Objective and gradient share one eigendecomposition of A - diag(D), which is
+ * kept until the position changes. With a maximum number of eigenvalues, only
+ * the largest eigenvalues are computed (EVLanczos, started with the eigenvectors
+ * of the previous position). Their number is increased until the weights
+ * exp((lambda_i - lambda_max)/epsilon) of the missing ones are negligible.
+ */
 class DiagonalMatrixApproxOptimizationProblem : public OptimizationProblemFirst
 {
   protected:
@@ -63,18 +82,57 @@ class DiagonalMatrixApproxOptimizationProblem : public OptimizationProblemFirst
     const Matrix *A;
     double epsilon;
 
-    /** cached eigen-decomposition */
+    /** maximum and current number of eigenvalues of the partial decomposition (0: full decomposition) */
+    uint maxNumEigenvalues;
+    uint numEigenvalues;
+
+    /** cached eigen-decomposition of A - diag(decompositionPosition) */
     Matrix eigenvectors; 
     Vector eigenvalues;
+    Vector decompositionPosition;
+    bool decompositionValid;
+
+    /** workspace of the full decomposition */
+    Matrix workspace;
+
+    /** partial eigensolvers of the largest eigenvalues and of the smallest eigenvalue */
+    EVLanczos lanczos;
+    EVLanczos lanczosSmallest;
+    Matrix smallestEigenvector;
+
+    /** decomposition at the current position, false if it failed */
+    bool decompose ();
+
+    /** objective of the cached decomposition */
+    double objectiveOfDecomposition ();
+
+    /** gradient of the cached decomposition */
+    void gradientOfDecomposition ( NICE::Vector & newGradient );
+
+    /** objective and gradient with one decomposition */
+    virtual double computeObjectiveAndGradient ( NICE::Vector & newGradient );
 
   public:
 
     /**
     * @brief Constructor
     *
-    * @param gm input generic matrix object
+    * @param A input matrix (symmetric)
+    * @param D0 initial position
+    * @param epsilon smoothing parameter
+    * @param verbose print debug information
+    * @param maxNumEigenvalues maximum number of eigenvalues of the partial decomposition, 0: full decomposition
     */
-    DiagonalMatrixApproxOptimizationProblem ( const Matrix *A, const Vector & D0, double epsilon, bool verbose = false );
+    DiagonalMatrixApproxOptimizationProblem ( const Matrix *A, const Vector & D0, double epsilon, bool verbose = false,
+                                              uint maxNumEigenvalues = 0 );
+
+    /**
+    * @brief restart at a new position with another epsilon, the decomposition is kept for the warm start
+    *
+    * @param D0 initial position
+    * @param epsilon smoothing parameter
+    */
+    void reset ( const Vector & D0, double epsilon );
 
     /**
     * @brief Compute the objective
@@ -92,12 +150,15 @@ class DiagonalMatrixApproxOptimizationProblem : public OptimizationProblemFirst
 
 
     /**
-    * @brief get smallest eigenvalue
+    * @brief get smallest eigenvalue of A - diag(D) at the current position
     * @return smallest eigenvalue
     */
-    double getSmallestEigenvalue () const
+    double getSmallestEigenvalue ();
+
+    /** number of eigenvalues of the last decomposition */
+    uint getNumEigenvalues () const
     {
-      return (eigenvalues.size()>0) ? eigenvalues[eigenvalues.size() - 1] : 0.0;
+      return eigenvalues.size();
     }
 
 };
@@ -6,8 +6,14 @@
 */
 
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 #include "EigValues.h"
+#include "core/basics/Log.h"
+#include "core/basics/Exception.h"
+#include "core/basics/numerictools.h"
+#include "core/vector/Eigen.h"
 
 #define DEBUG_ARNOLDI
 
@@ -43,12 +49,12 @@ EVArnoldi::getEigenvalues ( const GenericMatrix & data, Vector & eigenvalues,
   //////////////////////////////////////
 
   if ( verbose )
-    cerr << "Initialize Matrices" << std::endl;
+    NICE_LOG_DEBUG ( "Initialize Matrices" );
 
   uint n = data.cols ();
   
   if ( verbose )
-    std::cerr << "EVArnoldi: n: " << n << " k: " << k << std::endl;
+    NICE_LOG_DEBUG ( "EVArnoldi: n: " << n << " k: " << k );
   
   NICE::Matrix rmatrix ( n, k, 0 ); //=eigenvectors
   NICE::Matrix qmatrix ( n, k, 0 ); //saves data =eigenvectors
@@ -57,7 +63,7 @@ EVArnoldi::getEigenvalues ( const GenericMatrix & data, Vector & eigenvalues,
   NICE::Vector r ( n );
 
   if ( verbose )
-    cerr << "Random Initialization" << endl;
+    NICE_LOG_DEBUG ( "Random Initialization" );
 
   //random initialisation
   for ( uint i = 0; i < k; i++ )
@@ -74,7 +80,7 @@ EVArnoldi::getEigenvalues ( const GenericMatrix & data, Vector & eigenvalues,
   ///////// start computation  ///////
   ////////////////////////////////////      
   if ( verbose )
-    std::cerr << "EVArnoldi: start main computation" << std::endl;    
+    NICE_LOG_DEBUG ( "EVArnoldi: start main computation" );
       
   //reduceddim
   double delta = 1.0;
@@ -86,7 +92,7 @@ EVArnoldi::getEigenvalues ( const GenericMatrix & data, Vector & eigenvalues,
     NICE::Matrix rold(rmatrix);
     
     if ( verbose )
-      std::cerr << "EVArnoldi: start for loop over reduced dims" << std::endl;
+      NICE_LOG_DEBUG ( "EVArnoldi: start for loop over reduced dims" );
     
     // meta-comment: i is an index for the iteration, j is an index for the basis
     // element (1 <= j <= k)
@@ -114,7 +120,7 @@ EVArnoldi::getEigenvalues ( const GenericMatrix & data, Vector & eigenvalues,
     }
     
     if ( verbose )
-      std::cerr << "EVArnoldi: ended for loop over reduced dims" << std::endl;
+      NICE_LOG_DEBUG ( "EVArnoldi: ended for loop over reduced dims" );
     
     //convergence stuff (replaced by checking all eigenvectors instead of a single one
     //NICE::Vector diff = rold - rmatrix.getColumn ( k - 1 );
@@ -132,11 +138,11 @@ EVArnoldi::getEigenvalues ( const GenericMatrix & data, Vector & eigenvalues,
     iteration++;
 
     if ( verbose )
-      cerr << "EVArnoldi: [" << iteration << "] delta=" << delta << endl;
+      NICE_LOG_DEBUG ( "EVArnoldi: [" << iteration << "] delta=" << delta );
   }
   
   if ( verbose )
-    std::cerr << "EVArnoldi: while-loop done" << std::endl;
+    NICE_LOG_DEBUG ( "EVArnoldi: while-loop done" );
   
   eigenvectors = rmatrix;
   
@@ -189,3 +195,233 @@ EVArnoldi::getEigenvalues ( const GenericMatrix & data, Vector & eigenvalues,
     
   }// sorting is only useful if we compute more then 1 ew  
 }
+
+namespace {
+
+double dotProduct ( const double *a, const double *b, uint n )
+{
+  double sum = 0.0;
+  for ( uint i = 0; i < n; i++ )
+    sum += a[i] * b[i];
+  return sum;
+}
+
+/** orthonormalize column j of the column-major basis Q (n rows) against the
+ * columns 0, ..., j-1 (Gram-Schmidt applied twice), false if it is dependent */
+bool orthonormalizeColumn ( double *Q, uint n, uint j )
+{
+  double *q = Q + ( size_t ) j * n;
+  const double norm0 = sqrt ( dotProduct ( q, q, n ) );
+  if ( ! ( norm0 > 0.0 ) || !NICE::isFinite ( norm0 ) )
+    return false;
+
+  for ( int pass = 0; pass < 2; pass++ )
+    for ( uint l = 0; l < j; l++ )
+    {
+      const double *p = Q + ( size_t ) l * n;
+      const double d = dotProduct ( p, q, n );
+      for ( uint i = 0; i < n; i++ )
+        q[i] -= d * p[i];
+    }
+
+  const double norm = sqrt ( dotProduct ( q, q, n ) );
+  if ( norm <= 1e-10 * norm0 )
+    return false;
+  for ( uint i = 0; i < n; i++ )
+    q[i] /= norm;
+  return true;
+}
+
+/** deterministic start vector number c, independent of the global random state */
+void startVector ( double *q, uint n, uint c )
+{
+  unsigned int state = 12345u + 2654435761u * ( c + 1 );
+  for ( uint i = 0; i < n; i++ )
+  {
+    state = 1664525u * state + 1013904223u;
+    q[i] = double ( state >> 8 ) / 16777216.0 - 0.5;
+  }
+}
+
+}
+
+void
+EVLanczos::getEigenvalues ( const GenericMatrix & data, Vector & eigenvalues,
+                            Matrix & eigenvectors, uint k )
+{
+  const uint n = data.rows ();
+  if ( data.cols () != n )
+    fthrow ( Exception, "EVLanczos: matrix has to be quadratic" );
+  if ( k == 0 || k > n )
+    fthrow ( Exception, "EVLanczos: " << k << " eigenvalues of a " << n << " x " << n << " matrix requested" );
+
+  // block size and maximum size of the basis
+  const uint b = std::min ( n, k + oversampling );
+  const uint mmax = std::min ( n, b * ( std::max ( maxBlockSteps, 1u ) + 1 ) );
+  if ( Q.rows () != n || Q.cols () != mmax )
+  {
+    Q.resize ( n, mmax );
+    AQ.resize ( n, mmax );
+  }
+  if ( Y.rows () != n || Y.cols () != b )
+  {
+    Y.resize ( n, b );
+    AY.resize ( n, b );
+  }
+  double *q = Q.getDataPointer ();
+  double *aq = AQ.getDataPointer ();
+  double *y = Y.getDataPointer ();
+  double *ay = AY.getDataPointer ();
+
+  // the smallest eigenvalues are the largest of -A
+  const double sign = smallest ? -1.0 : 1.0;
+  numMultiplications = 0;
+
+  // start block: given vectors (warm start), filled up with deterministic vectors
+  uint m = 0;
+  if ( eigenvectors.rows () == n )
+    for ( uint j = 0; j < eigenvectors.cols () && m < b; j++ )
+    {
+      std::copy ( eigenvectors.getDataPointer () + ( size_t ) j * n,
+                  eigenvectors.getDataPointer () + ( size_t ) ( j + 1 ) * n, q + ( size_t ) m * n );
+      if ( orthonormalizeColumn ( q, n, m ) )
+        m++;
+    }
+  for ( uint c = 0; m < b && c < 4 * b; c++ )
+  {
+    startVector ( q + ( size_t ) m * n, n, c );
+    if ( orthonormalizeColumn ( q, n, m ) )
+      m++;
+  }
+  if ( m < k )
+    fthrow ( Exception, "EVLanczos: unable to find " << k << " independent start vectors" );
+
+  Vector product ( n );
+  Vector residuals ( b );
+  Matrix H;
+  Matrix S;
+  Vector theta;
+  uint numComputed = 0;
+  uint nr = 0;
+  bool converged = false;
+  for ( uint iteration = 0; ; iteration++ )
+  {
+    // products of the new basis vectors
+    for ( uint j = numComputed; j < m; j++ )
+    {
+      data.multiply ( product, Q.getColumnRef ( j ) );
+      double *aqj = aq + ( size_t ) j * n;
+      for ( uint i = 0; i < n; i++ )
+        aqj[i] = sign * product[i];
+      numMultiplications++;
+    }
+    numComputed = m;
+
+    // Rayleigh-Ritz with the current basis
+    H.resize ( m, m );
+    for ( uint i = 0; i < m; i++ )
+      for ( uint l = 0; l <= i; l++ )
+      {
+        const double h = 0.5 * ( dotProduct ( q + ( size_t ) i * n, aq + ( size_t ) l * n, n )
+                                 + dotProduct ( q + ( size_t ) l * n, aq + ( size_t ) i * n, n ) );
+        H ( i, l ) = h;
+        H ( l, i ) = h;
+      }
+    eigenvectorvalues ( H, S, theta );
+
+    nr = std::min ( b, m );
+    for ( uint c = 0; c < nr; c++ )
+    {
+      double *yc = y + ( size_t ) c * n;
+      double *ayc = ay + ( size_t ) c * n;
+      std::fill ( yc, yc + n, 0.0 );
+      std::fill ( ayc, ayc + n, 0.0 );
+      for ( uint l = 0; l < m; l++ )
+      {
+        const double s = S ( l, c );
+        const double *ql = q + ( size_t ) l * n;
+        const double *aql = aq + ( size_t ) l * n;
+        for ( uint i = 0; i < n; i++ )
+        {
+          yc[i] += s * ql[i];
+          ayc[i] += s * aql[i];
+        }
+      }
+      double r = 0.0;
+      for ( uint i = 0; i < n; i++ )
+      {
+        const double d = ayc[i] - theta[c] * yc[i];
+        r += d * d;
+      }
+      residuals[c] = sqrt ( r );
+    }
+
+    double scale = std::max ( fabs ( theta[0] ), fabs ( theta[m - 1] ) );
+    if ( ! ( scale > 0.0 ) )
+      scale = 1.0;
+    const double threshold = tolerance * scale;
+
+    uint numConverged = 0;
+    uint numUnconverged = 0;
+    for ( uint c = 0; c < nr; c++ )
+      if ( residuals[c] <= threshold )
+      {
+        if ( c < k )
+          numConverged++;
+      } else {
+        numUnconverged++;
+      }
+
+    if ( verbose )
+      NICE_LOG_DEBUG ( "EVLanczos: [" << iteration << "] basis size " << m << ", " << numConverged << " / " << k
+                       << " eigenvalues converged" );
+
+    if ( numConverged == k || m == n )
+    {
+      converged = true;
+      break;
+    }
+    if ( iteration >= maxiterations )
+      break;
+
+    // thick restart with the Ritz vectors
+    if ( m + numUnconverged > mmax )
+    {
+      std::copy ( y, y + ( size_t ) nr * n, q );
+      std::copy ( ay, ay + ( size_t ) nr * n, aq );
+      m = nr;
+      numComputed = nr;
+    }
+
+    // expansion with the residuals of the unconverged Ritz vectors
+    const uint m0 = m;
+    for ( uint c = 0; c < nr && m < mmax; c++ )
+    {
+      if ( residuals[c] <= threshold )
+        continue;
+      const double *yc = y + ( size_t ) c * n;
+      const double *ayc = ay + ( size_t ) c * n;
+      double *qm = q + ( size_t ) m * n;
+      for ( uint i = 0; i < n; i++ )
+        qm[i] = ayc[i] - theta[c] * yc[i];
+      if ( orthonormalizeColumn ( q, n, m ) )
+        m++;
+    }
+    if ( m == m0 )
+    {
+      // the basis is (numerically) an invariant subspace
+      converged = true;
+      break;
+    }
+  }
+
+  if ( !converged && verbose )
+    NICE_LOG_DEBUG ( "EVLanczos: no convergence after " << maxiterations << " iterations" );
+
+  eigenvalues.resize ( k );
+  if ( eigenvectors.rows () != n || eigenvectors.cols () != k )
+    eigenvectors.resize ( n, k );
+  for ( uint c = 0; c < k; c++ )
+    eigenvalues[c] = sign * theta[c];
+  std::copy ( y, y + ( size_t ) k * n, eigenvectors.getDataPointer () );
+}
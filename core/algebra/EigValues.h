@@ -65,6 +65,71 @@ class EVArnoldi : public EigValues
                           NICE::Matrix & eigenvectors, uint k );
 };
 
+/** restarted block Lanczos method for the k largest (or smallest) eigenvalues
+ * of a symmetric matrix
+ *
+ * The basis (full reorthogonalization) is expanded by the residuals of the
+ * Ritz vectors, which spans the same space as a block Lanczos step, and
+ * restarted with the Ritz vectors (thick restart) when it reaches its
+ * maximum size. Ritz pairs are converged if the residual
+ * |A*x - lambda*x| is below tolerance * |lambda_max|.
+ *
+ * Warm start: if \c eigenvectors has as many rows as the matrix on entry,
+ * its columns are the first start vectors, e.g. the eigenvectors of a
+ * slightly different matrix from a previous call.
+ */
+class EVLanczos : public EigValues
+{
+  protected:
+    uint maxiterations;
+    double tolerance;
+    uint oversampling;
+    uint maxBlockSteps;
+    bool smallest;
+    bool verbose;
+
+    uint numMultiplications;
+
+    /** workspace: basis, its product with the matrix, Ritz vectors */
+    NICE::Matrix Q;
+    NICE::Matrix AQ;
+    NICE::Matrix Y;
+    NICE::Matrix AY;
+
+  public:
+    /**
+    * @param verbose print debug information
+    * @param _maxiterations maximum number of expansions of the basis
+    * @param _tolerance relative residual of converged eigenpairs
+    * @param _oversampling additional Ritz vectors of the block (block size k + oversampling)
+    * @param _maxBlockSteps number of block expansions before a restart
+    */
+    EVLanczos ( bool verbose = false, uint _maxiterations = 200, double _tolerance = 1e-8,
+                uint _oversampling = 4, uint _maxBlockSteps = 4 )
+        : maxiterations ( _maxiterations ), tolerance ( _tolerance ),
+          oversampling ( _oversampling ), maxBlockSteps ( _maxBlockSteps ),
+          smallest ( false ), numMultiplications ( 0 )
+    {
+      this->verbose = verbose;
+    };
+
+    /** compute the smallest instead of the largest eigenvalues (increasing order) */
+    void setSmallest ( bool _smallest ) { smallest = _smallest; };
+
+    /** number of matrix-vector multiplications of the last call */
+    uint getNumMultiplications () const { return numMultiplications; };
+
+    /**
+      * k largest eigenvalues (decreasing order) and their eigenvectors
+      * @param data symmetric matrix interface that does allow matrix-vector multiplications
+      * @param k number of eigenvalues/eigenvectors
+      * @param eigenvectors input: optional start vectors, output: eigenvectors as columns
+      * @param eigenvalues output Eigenvalues as Vector
+      */
+    void getEigenvalues ( const GenericMatrix & data, NICE::Vector & eigenvalues,
+                          NICE::Matrix & eigenvectors, uint k );
+};
+
 
 } // namespace
 
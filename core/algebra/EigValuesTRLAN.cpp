@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <assert.h>
+#include "core/basics/Log.h"
 
 
 using namespace NICE;
@@ -50,7 +51,7 @@ void EigValuesTRLAN::getEigenvalues ( const GenericMatrix &data, NICE::Vector &
   fthrow ( Exception, "EigValuesTRLAN::getEigenvalues: this functions needs the TRLAN library" );
 #else
   if ( verbose )
-    fprintf ( stderr, "Starting eigenvalue computation with Lanczos Iteration ...\n" );
+    NICE_LOG_DEBUG ( "Starting eigenvalue computation with Lanczos Iteration ..." );
   assert ( data.rows() == data.cols() );
   if ( data.rows() != data.cols() ) {
     fthrow ( Exception, "EigValuesTRLAN::getEigenvalues: the input matrix is not quadratic\n" );
@@ -75,24 +76,24 @@ void EigValuesTRLAN::getEigenvalues ( const GenericMatrix &data, NICE::Vector &
   workspace[0] = tolerance;
 
   if ( verbose )
-    cerr << "Initialization ready ... Starting TRLAN" << endl;
+    NICE_LOG_DEBUG ( "Initialization ready ... Starting TRLAN" );
   // call lanczos iteration of trlan
   int kint = k;
   trlan77_ ( op, ipar, &mat_size, &kint, evalbuff, evecbuff, &mat_size, workspace, &workspace_size );
 
   if ( ipar[0] != 0 )
   {
-    cerr << "EigValuesTRLAN: Error occured by calling TRLAN Eigenvalue Computation." << endl;
-    cerr << "EigValuesTRLAN: " << ipar[3] << " converged eigenvectors" << endl;
+    NICE_LOG_ERROR ( "EigValuesTRLAN: Error occured by calling TRLAN Eigenvalue Computation." );
+    NICE_LOG_DEBUG ( "EigValuesTRLAN: " << ipar[3] << " converged eigenvectors" );
   }
   if ( verbose )
-    cerr << "TRLAN ready" << endl;
+    NICE_LOG_DEBUG ( "TRLAN ready" );
 
   // copy eigenvectors in evecbuff to vector
   eigenvectors.resize ( mat_size, k );
   eigenvalues.resize ( k );
   if ( verbose )
-    cerr << "Store results" << endl;
+    NICE_LOG_DEBUG ( "Store results" );
 
   /** write back all eigenvalues and eigenvectors */
   if ( magnitude < 0 )
@@ -113,7 +114,7 @@ void EigValuesTRLAN::getEigenvalues ( const GenericMatrix &data, NICE::Vector &
   }
 
   if ( verbose )
-    cerr << "Clean up" << endl;
+    NICE_LOG_DEBUG ( "Clean up" );
 
   /** clean up memory */
   delete[] workspace;
@@ -121,6 +122,6 @@ void EigValuesTRLAN::getEigenvalues ( const GenericMatrix &data, NICE::Vector &
   delete[] evecbuff;
 
   if ( verbose )
-    cerr << "Clean up done" << endl;
+    NICE_LOG_DEBUG ( "Clean up done" );
 #endif
 }
@@ -6,14 +6,35 @@
 
 */
 #include <iostream>
+#include <algorithm>
+#include <limits>
 
 #include <core/basics/Timer.h>
 #include "GBCDSolver.h"
+#include "core/basics/Profiler.h"
+#include "core/basics/Log.h"
 
 using namespace NICE;
 using namespace std;
 
 
+namespace {
+
+/** order coordinates by decreasing score */
+struct GreaterScore
+{
+  const Vector *score;
+
+  GreaterScore ( const Vector *score ) : score ( score ) {};
+
+  bool operator() ( int i, int j ) const
+  {
+    return (*score)[i] > (*score)[j];
+  }
+};
+
+}
+
 GBCDSolver::GBCDSolver( uint randomSetSize, uint stepComponents, bool verbose, uint maxIterations, double minDelta )
 {
   this->verbose = verbose;
@@ -22,6 +43,7 @@ GBCDSolver::GBCDSolver( uint randomSetSize, uint stepComponents, bool verbose, u
   this->stepComponents = stepComponents;
   this->randomSetSize = randomSetSize;
   this->timeAnalysis = false;
+  this->candidatePoolSize = 0;
 }
 
 void GBCDSolver::setTimeAnalysis(bool timeAnalysis)
@@ -29,15 +51,47 @@ void GBCDSolver::setTimeAnalysis(bool timeAnalysis)
   this->timeAnalysis = timeAnalysis;
 }
 
+void GBCDSolver::setCandidatePoolSize ( uint candidatePoolSize )
+{
+  this->candidatePoolSize = candidatePoolSize;
+}
+
 GBCDSolver::~GBCDSolver()
 {
 }
 
-void GBCDSolver::greedyApproximation ( const PartialGenericMatrix & gm, const Vector & b, const Vector & grad,
-                                       PartialGenericMatrix::SetType & B, Vector & deltaAlpha )
+void GBCDSolver::selectCandidates ( const Vector & diagonal, const Vector & grad, PartialGenericMatrix::SetType & candidates ) const
+{
+  int n = grad.size();
+  candidates.resize ( n );
+  for ( int i = 0 ; i < n ; i++ )
+    candidates[i] = i;
+
+  uint poolSize = candidatePoolSize;
+  if ( poolSize == 0 )
+    return;
+  poolSize = std::max<uint> ( poolSize, stepComponents + randomSetSize );
+  if ( poolSize >= (uint)n )
+    return;
+
+  // expected decrease of the objective when optimizing a single coordinate
+  Vector score ( n );
+#pragma omp parallel for schedule(static)
+  for ( int i = 0 ; i < n ; i++ )
+    score[i] = grad[i] * grad[i] / diagonal[i];
+
+  // partial selection in O(n) instead of sorting all coordinates
+  nth_element ( candidates.begin(), candidates.begin() + poolSize, candidates.end(), GreaterScore ( &score ) );
+  candidates.resize ( poolSize );
+}
+
+void GBCDSolver::greedyApproximation ( const PartialGenericMatrix & gm, const Vector & diagonal, const Vector & grad,
+                                       const PartialGenericMatrix::SetType & candidates,
+                                       PartialGenericMatrix::SetType & B, Vector & deltaAlpha, Matrix & R )
 {
   uint t = 0;
-  uint n = b.size();
+  uint n = grad.size();
+  uint numCandidates = candidates.size();
   Vector e ( grad );
 
   // start with an empty set
@@ -46,17 +100,25 @@ void GBCDSolver::greedyApproximation ( const PartialGenericMatrix & gm, const Ve
   //if ( verbose )
   //  cerr << "GBCDSolver::greedyApproximation: size of the problem is " << n << endl;
 
-  PartialGenericMatrix::SetType O;
-  uint elementsN = n;
-  bool *N = new bool [ n ];
-  for ( uint i = 0 ; i < n ; i++ )
-  {
-    O.push_back(i);
-    N[i] = true; //N.insert(i);
-  }
+  // status of each coordinate: 0 not available, 1 available (the set N in the paper), 2 selected for the set O
+  vector<char> status ( n, 0 );
+  PartialGenericMatrix::SetType O ( candidates );
+  uint elementsN = numCandidates;
+  for ( uint i = 0 ; i < numCandidates ; i++ )
+    status[ candidates[i] ] = 1;
+
+  uint numComponents = std::min ( stepComponents, numCandidates );
+  deltaAlpha.resize ( numComponents );
+
+  // helping vectors, which are allocated once
+  Vector a ( numComponents ); // column A(B,s)
+  Vector beta ( numComponents );
+  Vector gradSub ( numComponents );
+  Vector column;
+  Vector eSub;
+  Vector one ( 1, 1.0 );
+  PartialGenericMatrix::SetType sset ( 1 );
 
-  Matrix R ( stepComponents, stepComponents, 0.0 );
-  deltaAlpha.resize ( stepComponents );
   do {
     // step (3) of Algorithm 2 in the paper
     // determine the index s
@@ -65,7 +127,7 @@ void GBCDSolver::greedyApproximation ( const PartialGenericMatrix & gm, const Ve
     for ( PartialGenericMatrix::SetType::const_iterator i = O.begin(); i != O.end(); i++ )
     {
       double evalue = e(*i);
-      double expr = - evalue*evalue / ( 2 * gm.getDiagonalElement(*i) );
+      double expr = - evalue*evalue / ( 2 * diagonal[*i] );
       if ( expr < min_expr )
       {
         min_expr = expr;
@@ -75,115 +137,124 @@ void GBCDSolver::greedyApproximation ( const PartialGenericMatrix & gm, const Ve
     //if ( verbose )
     //  cerr << "GBCDSolver: greedy selection of element " << s << endl;
 
-    Vector deltaAlphaTmp ( t + 1 );
     // step (4) of Algorithm 2 in the paper
     if ( t == 0 ) {
-      R(0,0) = 1 / ( gm.getDiagonalElement(s) );
-      deltaAlpha[0] = - e(s) / ( gm.getDiagonalElement(s) );
-      deltaAlphaTmp[0] = deltaAlpha[0];
+      R(0,0) = 1 / diagonal[s];
     } else {
-      Vector beta ( t );
-      Vector rvector ( t );
-      Vector tmpScalar ( 1 );
-      PartialGenericMatrix::SetType sset;
-      sset.push_back(s);
       // ---- calculation of beta
-      // beta = R * A(B,s)
-      // beta^T = A(s,B) * R^T
-      // beta^T = A(B,s) * R^T (because we assume symmetry)
- 
-      for ( uint i = 0 ; i < beta.size() ; i++ )
+      // beta = R * A(B,s), where the column A(B,s) is computed with a single
+      // sub-matrix multiplication
+      sset[0] = s;
+      gm.multiply ( B, sset, column, one );
+
+      int ti = t;
+#pragma omp parallel for schedule(static) if ( ti > 256 )
+      for ( int i = 0 ; i < ti ; i++ )
       {
-        for ( uint j = 0 ; j < rvector.size(); j++ )
-          rvector[j] = R( i , j );
-
-        gm.multiply ( sset, B, tmpScalar, rvector );
-        beta[i] = tmpScalar[0];
+        double sum = 0.0;
+        for ( int j = 0 ; j < ti; j++ )
+          sum += R( i , j ) * column[j];
+        beta[i] = sum;
       }
 
-      // ---- calculation of nu
-      gm.multiply ( sset, B, tmpScalar, beta );
-      double nu = 1.0 / ( gm.getDiagonalElement ( s ) - tmpScalar[0] );
-
-      // ---- update our R
-      for ( uint i = 0 ; i < t ; i++ ) {
-        for ( uint j = 0 ; j < t ; j++ ) {
-          R(i,j) += nu * beta(i) * beta(j);
-        }
-        R(i,t) = nu * beta(i) * (-1);
-        R(t,i) = nu * beta(i) * (-1);
+      // ---- calculation of nu = 1 / ( A(s,s) - A(s,B) * beta ) (because we assume symmetry)
+      double sum = 0.0;
+      for ( uint i = 0 ; i < t ; i++ )
+        sum += column[i] * beta[i];
+      double nu = 1.0 / ( diagonal[s] - sum );
+
+      // ---- update our R (column-wise due to the memory layout)
+#pragma omp parallel for schedule(static) if ( ti > 256 )
+      for ( int j = 0 ; j < ti ; j++ ) {
+        double nbj = nu * beta(j);
+        for ( int i = 0 ; i < ti ; i++ )
+          R(i,j) += nbj * beta(i);
+        R(t,j) = - nbj;
+        R(j,t) = - nbj;
       }
       R(t, t) = nu;
+    }
 
-      // ---- compute our deltaAlpha update
-      Vector gradSub ( t+1 );
-      uint ii = 0;
-      for ( PartialGenericMatrix::SetType::const_iterator i = B.begin(); i != B.end(); i++,ii++ )
-        gradSub[ii] = grad[*i];
-      gradSub[t] = grad[s];
+    // ---- compute our deltaAlpha update: deltaAlpha = - R * grad(B)
+    uint ii = 0;
+    for ( PartialGenericMatrix::SetType::const_iterator i = B.begin(); i != B.end(); i++,ii++ )
+      gradSub[ii] = grad[*i];
+    gradSub[t] = grad[s];
 
-      // this statement uses a copy of the R sub-matrix, which
-      // might be not beneficial for performance!!!
-      deltaAlphaTmp = (-1.0) * R(0,0,t,t) * gradSub;
-      for ( uint i = 0 ; i < t+1; i++ )
-        deltaAlpha[i] = deltaAlphaTmp[i];
-    } 
+    int tt = t + 1;
+#pragma omp parallel for schedule(static) if ( tt > 256 )
+    for ( int i = 0 ; i < tt; i++ )
+    {
+      double sum = 0.0;
+      for ( int j = 0 ; j < tt; j++ )
+        sum += R(i,j) * gradSub[j];
+      deltaAlpha[i] = - sum;
+    }
 
     // step 5 of algorithm 2
     B.push_back(s);
-    // N.erase ( s );
-    N[s] = false;
+    status[s] = 0;
     elementsN--;
 
+    // increment our iteration counter
+    t++;
+
+    if ( t >= numComponents )
+      break;
+
     if ( elementsN == 0 ) {
-      cerr << "Unable to select more elements! Adjust your parameters!" << endl;
+      NICE_LOG_ERROR ( "Unable to select more elements! Adjust your parameters!" );
       break;
     }
 
     // step 6 of algorithm 2
     // choose a subset O of size kappa = randomSetSize
     O.clear();
-    set<int> selectedElements;
-    for ( uint i = 0 ; i < randomSetSize ; i++ )
+    uint kappa = std::min ( randomSetSize, elementsN );
+    for ( uint i = 0 ; i < kappa ; i++ )
     {
       int selectedElement;
       
       do {
-        selectedElement = rand() % n;
+        selectedElement = candidates[ rand() % numCandidates ];
       } while ( // I have selected this element as the optimal element in a previous step
-                !N[selectedElement] || 
-                // I selected this element already for the set O
-                (selectedElements.find(selectedElement) != selectedElements.end()) );
+                // or I selected this element already for the set O
+                status[selectedElement] != 1 );
 
       //if ( verbose )
       //  cerr << "GBCDSolver: selecting " << selectedElement << " for the set O" << endl;
-      selectedElements.insert( selectedElement );
+      status[selectedElement] = 2;
 
       O.push_back ( selectedElement );
     }
+    for ( PartialGenericMatrix::SetType::const_iterator i = O.begin(); i != O.end(); i++ )
+      status[*i] = 1;
 
-    Vector eSub;
-    gm.multiply ( O, B, eSub, deltaAlphaTmp );
+    // e(O) = A(O,B) * deltaAlpha + grad(O), deltaAlpha currently contains t elements
+    gm.multiply ( O, B, eSub, deltaAlpha.getRangeRef ( 0, t - 1 ) );
     if ( eSub.size() != O.size() )
       fthrow(Exception, "The matrix interface did not return a vector of a proper size!");
 
-    uint ii = 0;
+    ii = 0;
     for ( PartialGenericMatrix::SetType::const_iterator i = O.begin(); i != O.end(); i++,ii++ )
       e[ *i ] = eSub[ ii ] + grad[ *i ];
 
-    // increment our iteration counter
-    t++;
-
-  } while ( t < this->stepComponents );
+  } while ( true );
 
-  delete [] N;
+  // only keep the updates of the selected coordinates
+  deltaAlpha.resize ( B.size() );
 }
 
 int GBCDSolver::solveLin ( const PartialGenericMatrix & gm, const Vector & b, Vector & x )
 {
-  // FIXME: check for quadratic matrix
+  NICE_PROFILE_ZONE ( "GBCDSolver::solveLin" );
+  if ( gm.rows() != gm.cols() )
+    fthrow(Exception, "GBCDSolver: the matrix has to be quadratic (" << gm.rows() << " x " << gm.cols() << ").");
+  if ( b.size() != gm.rows() )
+    fthrow(Exception, "Size of vector b (" << b.size() << ") mismatches with the size of the given PartialGenericMatrix (" << gm.rows() << ").");
 
   uint iteration = 0;
+  uint n = b.size();
 
   Vector grad;
   Vector Ax;
@@ -198,10 +269,23 @@ int GBCDSolver::solveLin ( const PartialGenericMatrix & gm, const Vector & b, Ve
     grad = Ax - b;
   }
 
+  // the diagonal elements are needed in every greedy step
+  Vector diagonal ( n );
+  for ( uint i = 0 ; i < n ; i++ )
+    diagonal[i] = gm.getDiagonalElement ( i );
+
   PartialGenericMatrix::SetType wholeSet;
-  for ( uint i = 0 ; i < b.size() ; i++ )
+  for ( uint i = 0 ; i < n ; i++ )
     wholeSet.push_back(i);
 
+  // memory used in all iterations
+  uint numComponents = std::min ( stepComponents, n );
+  Matrix R ( numComponents, numComponents, 0.0 );
+  Vector deltaAlpha;
+  Vector A_deltaAlpha;
+  PartialGenericMatrix::SetType B;
+  PartialGenericMatrix::SetType candidates;
+
   Timer t;
 
   if ( timeAnalysis )
@@ -214,19 +298,16 @@ int GBCDSolver::solveLin ( const PartialGenericMatrix & gm, const Vector & b, Ve
     // this is not necessarily true for the residual. We know that at the bottom we get a zero
     // gradient (and a residual) but we can not prove anything about the development of it during
     // optimization. 
-    double residualNorm = grad.normInf();
     if ( verbose )
-      cerr << "GBCDSolver: [ " << iteration << " / " << maxIterations << " ] " << residualNorm << endl;
-
-    Vector deltaAlpha;
-    PartialGenericMatrix::SetType B;
+      NICE_LOG_DEBUG ( "GBCDSolver: [ " << iteration << " / " << maxIterations << " ] " << grad.normInf() );
 
     // -------- the main part: solve the sub-problem of finding a good search direction 
-    greedyApproximation ( gm, b, grad, B, deltaAlpha );
+    selectCandidates ( diagonal, grad, candidates );
+    greedyApproximation ( gm, diagonal, grad, candidates, B, deltaAlpha, R );
 
     // --------
     if ( verbose && b.size() <= 10 )
-      cerr << "GBCDSolver: " << deltaAlpha << endl;
+      NICE_LOG_DEBUG ( "GBCDSolver: " << deltaAlpha );
 
     uint ii = 0;
     for ( PartialGenericMatrix::SetType::const_iterator i = B.begin(); i != B.end(); i++, ii++)
@@ -238,23 +319,22 @@ int GBCDSolver::solveLin ( const PartialGenericMatrix & gm, const Vector & b, Ve
 
     double deltaNorm = deltaAlpha.normL2();
     if ( verbose )
-      cerr << "GBCDSolver: delta = " << deltaNorm << endl;
+      NICE_LOG_DEBUG ( "GBCDSolver: delta = " << deltaNorm );
 
     if ( deltaNorm < minDelta ) {
       if ( verbose )
-        cerr << "GBCDSolver: minimum delta reached" << endl;
+        NICE_LOG_DEBUG ( "GBCDSolver: minimum delta reached" );
       return iteration;
     }
 
-    Vector A_deltaAlpha;
+    // incremental update of the gradient with the columns of the block: grad += A(:,B) * deltaAlpha
     gm.multiply ( wholeSet, B, A_deltaAlpha, deltaAlpha );
-
-    grad += A_deltaAlpha;
+    grad.axpy ( 1.0, A_deltaAlpha );
  
     if ( timeAnalysis ) 
     {
       t.stop();
-      cerr << "GBCDSolver: TIME " << t.getSum() << " " << grad.normL2() << " " << grad.normInf() << endl;
+      NICE_LOG_TIMING ( "GBCDSolver: TIME " << t.getSum() << " " << grad.normL2() << " " << grad.normInf() );
       t.start();
     }
    
@@ -7,6 +7,7 @@
 #ifndef _NICE_GBCDSOLVERINCLUDE
 #define _NICE_GBCDSOLVERINCLUDE
 
+#include "core/vector/MatrixT.h"
 #include "PartialGenericMatrix.h"
 
 namespace NICE {
@@ -42,8 +43,30 @@ class GBCDSolver
     //! detailed time analysis
     bool timeAnalysis;
 
-    void greedyApproximation ( const PartialGenericMatrix & gm, const Vector & b, const Vector & grad,
-                               PartialGenericMatrix::SetType & B, Vector & deltaAlpha );
+    //! number of coordinates with the largest gradient considered in each iteration (0: all coordinates)
+    uint candidatePoolSize;
+
+    /**
+    * @brief greedy selection of the block B and computation of the update of the
+    * corresponding coordinates (Algorithm 2 in the paper)
+    *
+    * @param gm system matrix
+    * @param diagonal diagonal elements of the system matrix
+    * @param grad current gradient A*x - b
+    * @param candidates coordinates which can be selected
+    * @param B selected block
+    * @param deltaAlpha update of the coordinates in B
+    * @param R work matrix (stepComponents x stepComponents) for the inverse of A(B,B)
+    */
+    void greedyApproximation ( const PartialGenericMatrix & gm, const Vector & diagonal, const Vector & grad,
+                               const PartialGenericMatrix::SetType & candidates,
+                               PartialGenericMatrix::SetType & B, Vector & deltaAlpha, Matrix & R );
+
+    /**
+    * @brief select the candidatePoolSize coordinates with the largest expected decrease
+    * grad_i^2 / (2*A_ii) of the objective with a partial selection (nth_element)
+    */
+    void selectCandidates ( const Vector & diagonal, const Vector & grad, PartialGenericMatrix::SetType & candidates ) const;
 
   public:
 
@@ -72,6 +95,18 @@ class GBCDSolver
     * @param timeAnalysis
     */
     void setTimeAnalysis(bool timeAnalysis);
+
+    /**
+    * @brief restrict the greedy selection in each iteration to the coordinates with
+    * the largest expected decrease of the objective, which avoids wasting random
+    * samples on already converged coordinates of large systems. Small pools
+    * slow down the convergence for strongly correlated coordinates (e.g. smooth
+    * kernels), because the random sampling of the paper diversifies the block.
+    *
+    * @param candidatePoolSize size of the pool (0 uses all coordinates as in the paper),
+    * values smaller than stepComponents + randomSetSize are increased to this value
+    */
+    void setCandidatePoolSize ( uint candidatePoolSize );
      
 };
 
@@ -0,0 +1,60 @@
+/**
+* @file GMHessian.h
+* @brief Hessian of an optimization problem as GenericMatrix (Hessian-vector products)
+* @date 10/19/2026
+*/
+#ifndef GMHESSIANINCLUDE
+#define GMHESSIANINCLUDE
+
+#include "GenericMatrix.h"
+#include "core/optimization/gradientBased/OptimizationProblemSecond.h"
+
+namespace NICE
+{
+
+/** Hessian of an OptimizationProblemSecond at its current position, the
+ * matrix is never formed: each multiplication is a call of
+ * OptimizationProblemSecond::hessianTimesVector() */
+class GMHessian : public GenericMatrix
+{
+  protected:
+    //! the problem (not owned)
+    OptimizationProblemSecond *problem;
+
+    //! number of multiplications
+    mutable uint numMultiplications;
+
+  public:
+    GMHessian ( OptimizationProblemSecond *_problem ) : problem ( _problem ), numMultiplications ( 0 )
+    {
+    };
+
+    /** get the number of rows in A */
+    uint rows () const
+    {
+      return problem->dimension();
+    };
+
+    /** get the number of columns in A */
+    uint cols () const
+    {
+      return problem->dimension();
+    };
+
+    /** multiply with a vector: A*x = y */
+    void multiply ( NICE::Vector & y, const NICE::Vector & x ) const
+    {
+      numMultiplications++;
+      problem->hessianTimesVector ( x, y );
+    };
+
+    /** number of multiplications since construction */
+    uint getNumMultiplications () const
+    {
+      return numMultiplications;
+    };
+};
+
+}
+
+#endif
@@ -0,0 +1,264 @@
+/**
+* @file GMKernel.cpp
+* @brief kernel matrix computed on the fly (matrix-free)
+* @date 10/19/2026
+
+*/
+#include <algorithm>
+#include <cstring>
+
+#ifdef NICE_USELIB_OPENMP
+#include <omp.h>
+#endif
+
+#include <core/basics/Exception.h>
+#include <core/vector/SimdKernels.h>
+
+#include "GMKernel.h"
+
+using namespace NICE;
+using namespace std;
+
+GMKernel::GMKernel ( const Matrix & features, const KernelFunction *kernel, double noise,
+                     uint tileSize, uint cacheSize )
+{
+  if ( kernel == NULL )
+    fthrow(Exception, "GMKernel: no kernel function given.");
+  if ( tileSize == 0 )
+    fthrow(Exception, "GMKernel: the tile size has to be positive.");
+
+  this->n = features.rows();
+  this->dimension = features.cols();
+  this->kernel = kernel;
+  this->noise = noise;
+  this->tileSize = tileSize;
+  this->cacheSize = cacheSize;
+  this->cacheHits = 0;
+  this->cacheMisses = 0;
+
+  // store the transposed matrix: due to the column-major order of NICE::Matrix,
+  // each feature vector is then a contiguous block of memory
+  data.resize ( dimension, n );
+  for ( uint i = 0 ; i < n ; i++ )
+    for ( uint k = 0 ; k < dimension ; k++ )
+      data(k, i) = features(i, k);
+}
+
+GMKernel::~GMKernel()
+{
+}
+
+void GMKernel::computeTile ( uint bi, uint bj, double *tile ) const
+{
+  uint i0 = bi * tileSize;
+  uint i1 = std::min ( n, i0 + tileSize );
+  uint j0 = bj * tileSize;
+  uint width = std::min ( n, j0 + tileSize ) - j0;
+
+  for ( uint i = i0 ; i < i1 ; i++ )
+    kernel->evaluateRow ( sample(i), sample(j0), width, dimension, tile + (size_t)(i - i0) * width );
+}
+
+const double *GMKernel::acquireTile ( uint bi, uint bj, double *buffer, bool & cached ) const
+{
+  cached = false;
+  if ( cacheSize == 0 )
+  {
+    computeTile ( bi, bj, buffer );
+    return buffer;
+  }
+
+  uint numBlocks = ( n + tileSize - 1 ) / tileSize;
+  uint key = bi * numBlocks + bj;
+  uint tileElements = ( std::min ( n, (bi+1) * tileSize ) - bi * tileSize ) * ( std::min ( n, (bj+1) * tileSize ) - bj * tileSize );
+
+  const double *tile = NULL;
+#pragma omp critical (GMKernelCache)
+  {
+    TileCache::iterator k = tileCache.find ( key );
+    if ( k != tileCache.end() )
+    {
+      // move the tile to the front of the LRU list, it is read in place
+      tileOrder.splice ( tileOrder.begin(), tileOrder, k->second.position );
+      k->second.users++;
+      tile = &(k->second.values[0]);
+      cacheHits++;
+    }
+  }
+  if ( tile != NULL )
+  {
+    cached = true;
+    return tile;
+  }
+
+  computeTile ( bi, bj, buffer );
+
+#pragma omp critical (GMKernelCache)
+  {
+    cacheMisses++;
+    // another thread might have inserted the tile in the meantime
+    if ( tileCache.find ( key ) == tileCache.end() )
+    {
+      if ( tileCache.size() >= cacheSize )
+      {
+        // remove the least recently used tile, which is not read at the moment
+        for ( TileList::iterator t = tileOrder.end(); t != tileOrder.begin(); )
+        {
+          --t;
+          TileCache::iterator k = tileCache.find ( *t );
+          if ( k->second.users == 0 )
+          {
+            tileCache.erase ( k );
+            tileOrder.erase ( t );
+            break;
+          }
+        }
+      }
+      tileOrder.push_front ( key );
+      CachedTile & entry = tileCache[key];
+      entry.position = tileOrder.begin();
+      entry.values.assign ( buffer, buffer + tileElements );
+      entry.users = 0;
+    }
+  }
+  return buffer;
+}
+
+void GMKernel::releaseTile ( uint bi, uint bj ) const
+{
+  uint numBlocks = ( n + tileSize - 1 ) / tileSize;
+  uint key = bi * numBlocks + bj;
+#pragma omp critical (GMKernelCache)
+  {
+    TileCache::iterator k = tileCache.find ( key );
+    if ( k != tileCache.end() && k->second.users > 0 )
+      k->second.users--;
+  }
+}
+
+void GMKernel::multiply ( Vector & y, const Vector & x ) const
+{
+  if ( x.size() != n )
+    fthrow(Exception, "GMKernel::multiply: size of the vector (" << x.size() << ") mismatches with the size of the matrix (" << n << ").");
+
+  y.resize ( n );
+  if ( n == 0 )
+    return;
+  int numBlocks = ( n + tileSize - 1 ) / tileSize;
+
+  int numThreads = 1;
+#ifdef NICE_USELIB_OPENMP
+  numThreads = omp_get_max_threads();
+#endif
+  // every thread accumulates its tiles in its own result vector,
+  // these are summed up in the order of the threads afterwards
+  std::vector<double> partialResults ( (size_t)numThreads * n, 0.0 );
+
+#pragma omp parallel num_threads(numThreads)
+  {
+    int thread = 0;
+#ifdef NICE_USELIB_OPENMP
+    thread = omp_get_thread_num();
+#endif
+    double *yLocal = &(partialResults[(size_t)thread * n]);
+
+    // thread-local tile buffer
+    std::vector<double> tileBuffer ( (size_t)tileSize * tileSize );
+
+    // the rows of the upper triangle have different lengths: interleaved assignment to the threads
+#pragma omp for schedule(static,1)
+    for ( int bi = 0 ; bi < numBlocks ; bi++ )
+    {
+      uint i0 = bi * tileSize;
+      uint i1 = std::min ( n, i0 + tileSize );
+
+      for ( int bj = bi ; bj < numBlocks ; bj++ )
+      {
+        uint j0 = bj * tileSize;
+        uint width = std::min ( n, j0 + tileSize ) - j0;
+        const double *xj = x.getDataPointer() + j0;
+
+        bool cached;
+        const double *tile = acquireTile ( bi, bj, &(tileBuffer[0]), cached );
+
+        const double *row = tile;
+        for ( uint i = i0 ; i < i1 ; i++, row += width )
+        {
+          // tile (bi,bj) and its mirrored counterpart (bj,bi)
+          yLocal[i] += SimdKernels::dot ( row, xj, width );
+          if ( bj != bi )
+            SimdKernels::addProductC ( row, x[i], yLocal + j0, width );
+        }
+
+        if ( cached )
+          releaseTile ( bi, bj );
+      }
+    }
+  }
+
+  for ( uint i = 0 ; i < n ; i++ )
+    y[i] = noise * x[i];
+  for ( int thread = 0 ; thread < numThreads ; thread++ )
+    SimdKernels::add ( y.getDataPointer(), &(partialResults[(size_t)thread * n]), y.getDataPointer(), n );
+}
+
+void GMKernel::multiply ( const SetType & rowSet, const SetType & columnSet, Vector & y, const Vector & x ) const
+{
+  if ( x.size() != columnSet.size() )
+    fthrow(Exception, "Size of the column set is different from the size of the given input vector: " << columnSet.size() << " vs " << x.size());
+
+  y.resize ( rowSet.size() );
+
+  // gather the feature vectors of the columns to access them contiguously
+  uint numColumns = columnSet.size();
+  std::vector<double> columnData ( (size_t)numColumns * dimension );
+  for ( uint jj = 0 ; jj < numColumns ; jj++ )
+  {
+    if ( (columnSet[jj] < 0) || ((uint)columnSet[jj] >= n) )
+      fthrow(Exception, "GMKernel::multiply: invalid column index " << columnSet[jj]);
+    memcpy ( &(columnData[(size_t)jj * dimension]), sample(columnSet[jj]), dimension * sizeof(double) );
+  }
+
+  int numRows = rowSet.size();
+  for ( int ii = 0 ; ii < numRows ; ii++ )
+    if ( (rowSet[ii] < 0) || ((uint)rowSet[ii] >= n) )
+      fthrow(Exception, "GMKernel::multiply: invalid row index " << rowSet[ii]);
+
+#pragma omp parallel
+  {
+    std::vector<double> k ( numColumns );
+
+#pragma omp for schedule(static)
+    for ( int ii = 0 ; ii < numRows ; ii++ )
+    {
+      int i = rowSet[ii];
+      if ( numColumns > 0 )
+        kernel->evaluateRow ( sample(i), &(columnData[0]), numColumns, dimension, &(k[0]) );
+
+      double s = 0.0;
+      for ( uint jj = 0 ; jj < numColumns ; jj++ )
+      {
+        s += k[jj] * x[jj];
+        if ( columnSet[jj] == i )
+          s += noise * x[jj];
+      }
+      y[ii] = s;
+    }
+  }
+}
+
+double GMKernel::getDiagonalElement ( uint i ) const
+{
+  if ( i >= n )
+    fthrow(Exception, "Invalid index to access diagonal element: " << i << " (" << n << " x " << n << ")" );
+
+  return kernel->evaluate ( sample(i), sample(i), dimension ) + noise;
+}
+
+void GMKernel::clearCache ()
+{
+  tileOrder.clear();
+  tileCache.clear();
+  cacheHits = 0;
+  cacheMisses = 0;
+}
@@ -0,0 +1,162 @@
+/**
+* @file GMKernel.h
+* @brief kernel matrix computed on the fly (matrix-free)
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_GMKERNELINCLUDE
+#define _NICE_GMKERNELINCLUDE
+
+#include <list>
+#include <map>
+#include <vector>
+
+#include "core/vector/MatrixT.h"
+#include "PartialGenericMatrix.h"
+#include "KernelFunction.h"
+
+namespace NICE {
+
+/** @class GMKernel
+ * Kernel matrix K + noise*I of a set of n feature vectors, which is never stored
+ * explicitly. Matrix-vector products are computed on the fly in tiles of
+ * tileSize x tileSize kernel values, such that the feature vectors of a tile stay
+ * in the cache. Since the kernel function is symmetric, only the tiles on and
+ * above the diagonal are computed; each of them contributes to the rows of both
+ * of its blocks. Row blocks are processed in parallel (OpenMP). Optionally, a
+ * least-recently-used cache keeps computed tiles for subsequent multiplications,
+ * which is useful for iterative solvers if enough memory is available. Since
+ * every multiplication sweeps over all tiles, the cache only pays off if it
+ * is able to hold (nearly) all b*(b+1)/2 upper tiles of the b x b tile grid.
+ * Memory requirements without a cache are O(n*d) for d-dimensional features
+ * and O(n) per thread.
+ */
+class GMKernel : public PartialGenericMatrix
+{
+  protected:
+    //! feature vectors stored contiguously: sample i starts at position i*dimension
+    NICE::Matrix data;
+
+    //! number of feature vectors
+    uint n;
+
+    //! dimension of the feature vectors
+    uint dimension;
+
+    //! kernel function (not owned)
+    const KernelFunction *kernel;
+
+    //! value added to the diagonal of the kernel matrix
+    double noise;
+
+    //! number of rows and columns of a tile
+    uint tileSize;
+
+    //! maximum number of cached tiles (0 disables the cache)
+    uint cacheSize;
+
+    //! LRU cache of tiles: the list is ordered by the time of the last access (most recent first)
+    typedef std::list<uint> TileList;
+    struct CachedTile
+    {
+      TileList::iterator position;
+      std::vector<double> values;
+      //! number of threads currently reading the tile, such tiles are not removed
+      uint users;
+    };
+    typedef std::map< uint, CachedTile > TileCache;
+    mutable TileList tileOrder;
+    mutable TileCache tileCache;
+    mutable uint cacheHits;
+    mutable uint cacheMisses;
+
+    /** pointer to the feature vector with index i */
+    const double *sample ( uint i ) const
+    {
+      return data.getDataPointer() + (size_t)i * dimension;
+    };
+
+    /** compute the kernel values of tile (bi,bj) in row-major order */
+    void computeTile ( uint bi, uint bj, double *tile ) const;
+
+    /**
+    * @brief get the kernel values of tile (bi,bj) from the cache or compute them
+    *
+    * @param buffer memory for a tile, used if the tile is not taken from the cache
+    * @param cached true if the result points into the cache, the tile then has to be released with releaseTile()
+    * @return pointer to the kernel values (row-major order)
+    */
+    const double *acquireTile ( uint bi, uint bj, double *buffer, bool & cached ) const;
+
+    /** allow to remove a tile of the cache obtained by acquireTile() again */
+    void releaseTile ( uint bi, uint bj ) const;
+
+  public:
+
+    /**
+    * @brief constructor, the feature vectors are copied and the kernel function is only referenced
+    *
+    * @param features feature vectors given as rows of a matrix (n x d)
+    * @param kernel kernel function, which has to be valid during the lifetime of the matrix
+    * @param noise value added to the diagonal of the kernel matrix
+    * @param tileSize number of rows and columns of a tile
+    * @param cacheSize maximum number of tiles kept in memory (0 disables the cache)
+    */
+    GMKernel ( const NICE::Matrix & features, const KernelFunction *kernel, double noise = 0.0,
+               uint tileSize = 128, uint cacheSize = 0 );
+
+    /** simple destructor */
+    virtual ~GMKernel ();
+
+    /** get the number of rows in A */
+    uint rows () const
+    {
+      return n;
+    };
+
+    /** get the number of columns in A */
+    uint cols () const
+    {
+      return n;
+    };
+
+    /** multiply with a vector: A*x = y */
+    virtual void multiply ( NICE::Vector & y, const NICE::Vector & x ) const;
+
+    /** multiply a sub-matrix with a given vector: Asub * xsub = ysub */
+    virtual void multiply ( const PartialGenericMatrix::SetType & rowSet, const PartialGenericMatrix::SetType & columnSet, NICE::Vector & y, const NICE::Vector & x ) const;
+
+    /** get the diagonal element k(x_i,x_i) + noise */
+    virtual double getDiagonalElement ( uint i ) const;
+
+    /** set the value added to the diagonal of the kernel matrix */
+    void setNoise ( double noise )
+    {
+      this->noise = noise;
+    };
+
+    /** get the value added to the diagonal of the kernel matrix */
+    double getNoise () const
+    {
+      return noise;
+    };
+
+    /** release all cached tiles and reset the cache statistics */
+    void clearCache ();
+
+    /** number of tiles found in the cache */
+    uint getCacheHits () const
+    {
+      return cacheHits;
+    };
+
+    /** number of tiles computed, although the cache was enabled */
+    uint getCacheMisses () const
+    {
+      return cacheMisses;
+    };
+};
+
+}
+
+#endif
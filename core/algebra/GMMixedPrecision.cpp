@@ -0,0 +1,206 @@
+/**
+* @file GMMixedPrecision.cpp
+* @brief generic matrices with single precision storage and double precision accumulation
+* @date 10/19/2026
+
+*/
+#include <algorithm>
+#include <cmath>
+
+#include <core/basics/Exception.h>
+
+#include "GMMixedPrecision.h"
+
+using namespace NICE;
+using namespace std;
+
+GMStandardFloat::GMStandardFloat ( const Matrix & A )
+{
+  At.resize ( A.cols(), A.rows() );
+  for ( uint i = 0 ; i < A.rows() ; i++ )
+    for ( uint j = 0 ; j < A.cols() ; j++ )
+      At(j, i) = (float)A(i, j);
+}
+
+void GMStandardFloat::multiply ( Vector & y, const Vector & x ) const
+{
+  uint m = rows();
+  uint n = cols();
+  if ( x.size() != n )
+    fthrow(Exception, "GMStandardFloat::multiply: vector and matrix size do not match!");
+
+  y.resize ( m );
+  const float *a = At.getDataPointer();
+  const double *xp = x.getDataPointer();
+
+#pragma omp parallel for schedule(static)
+  for ( int i = 0 ; i < (int)m ; i++ )
+  {
+    const float *row = a + (size_t)i * n;
+    double s = 0.0;
+    for ( uint j = 0 ; j < n ; j++ )
+      s += (double)row[j] * xp[j];
+    y[i] = s;
+  }
+}
+
+void GMStandardFloat::multiply ( const SetType & rowSet, const SetType & columnSet, Vector & y, const Vector & x ) const
+{
+  if ( x.size() != columnSet.size() )
+    fthrow(Exception, "Size of the column set is different from the size of the given input vector: " << columnSet.size() << " vs " << x.size());
+
+  y.resize ( rowSet.size() );
+
+  int ii = 0;
+  for ( SetType::const_iterator i = rowSet.begin(); i != rowSet.end(); i++, ii++ )
+  {
+    double s = 0.0;
+    int jj = 0;
+    for ( SetType::const_iterator j = columnSet.begin(); j != columnSet.end(); j++, jj++ )
+      s += (double)At(*j, *i) * x[jj];
+    y[ii] = s;
+  }
+}
+
+double GMStandardFloat::getDiagonalElement ( uint i ) const
+{
+  if ( (i >= At.rows()) || (i >= At.cols()) )
+    fthrow(Exception, "Invalid index to access diagonal element: " << i << " (" << rows() << " x " << cols() << ")" );
+
+  return At(i, i);
+}
+
+GMSparseFloat::GMSparseFloat ( const GMSparse & A )
+{
+  m_rows = A.rows();
+  m_cols = A.cols();
+  init ( A.getEntries() );
+}
+
+GMSparseFloat::GMSparseFloat ( const Matrix & A, double epsilon )
+{
+  m_rows = A.rows();
+  m_cols = A.cols();
+  vector < triplet < int, int, double > > entries;
+  for ( uint i = 0; i < m_rows; i++ )
+    for ( uint j = 0; j < m_cols; j++ )
+      if ( fabs ( A ( i, j ) ) > epsilon )
+        entries.push_back ( triplet < int, int, double > ( i, j, A ( i, j ) ) );
+  init ( entries );
+}
+
+void GMSparseFloat::init ( const vector < triplet < int, int, double > > & entries )
+{
+  // counting sort of the entries by rows
+  rowStart.assign ( m_rows + 1, 0 );
+  for ( vector < triplet < int, int, double > >::const_iterator k = entries.begin(); k != entries.end(); k++ )
+  {
+    if ( (k->first < 0) || ((uint)k->first >= m_rows) || (k->second < 0) || ((uint)k->second >= m_cols) )
+      fthrow(Exception, "GMSparseFloat: invalid entry (" << k->first << ", " << k->second << ")");
+    rowStart[ k->first + 1 ]++;
+  }
+  for ( uint i = 0 ; i < m_rows ; i++ )
+    rowStart[i+1] += rowStart[i];
+
+  vector<uint> position ( rowStart.begin(), rowStart.end() - 1 );
+  vector<double> unsortedValues ( entries.size() );
+  vector<uint> unsortedColumns ( entries.size() );
+  for ( vector < triplet < int, int, double > >::const_iterator k = entries.begin(); k != entries.end(); k++ )
+  {
+    uint p = position[ k->first ]++;
+    unsortedColumns[p] = k->second;
+    unsortedValues[p] = k->third;
+  }
+
+  // sort each row by the column index and merge duplicate entries in double precision
+  columns.clear();
+  values.clear();
+  columns.reserve ( entries.size() );
+  values.reserve ( entries.size() );
+  vector< pair<uint, double> > row;
+  uint start = 0;
+  for ( uint i = 0 ; i < m_rows ; i++ )
+  {
+    row.clear();
+    for ( uint p = rowStart[i] ; p < rowStart[i+1] ; p++ )
+      row.push_back ( pair<uint, double> ( unsortedColumns[p], unsortedValues[p] ) );
+    sort ( row.begin(), row.end() );
+
+    rowStart[i] = start;
+    for ( uint p = 0 ; p < row.size() ; p++ )
+    {
+      if ( (p > 0) && (row[p].first == row[p-1].first) )
+      {
+        values.back() = (float)( (double)values.back() + row[p].second );
+      } else {
+        columns.push_back ( row[p].first );
+        values.push_back ( (float)row[p].second );
+      }
+    }
+    start = columns.size();
+  }
+  rowStart[m_rows] = start;
+}
+
+void GMSparseFloat::multiply ( Vector & y, const Vector & x ) const
+{
+  if ( x.size() != m_cols )
+    fthrow(Exception, "GMSparseFloat::multiply: vector and matrix size do not match!");
+
+  y.resize ( m_rows );
+  const double *xp = x.getDataPointer();
+
+#pragma omp parallel for schedule(static)
+  for ( int i = 0 ; i < (int)m_rows ; i++ )
+  {
+    double s = 0.0;
+    for ( uint p = rowStart[i] ; p < rowStart[i+1] ; p++ )
+      s += (double)values[p] * xp[ columns[p] ];
+    y[i] = s;
+  }
+}
+
+GMCovarianceFloat::GMCovarianceFloat ( const Matrix & data )
+{
+  this->data.resize ( data.rows(), data.cols() );
+  for ( uint k = 0 ; k < data.cols() ; k++ )
+    for ( uint d = 0 ; d < data.rows() ; d++ )
+      this->data(d, k) = (float)data(d, k);
+}
+
+void GMCovarianceFloat::multiply ( Vector & y, const Vector & x ) const
+{
+  if ( x.size() != data.rows() )
+    fthrow ( Exception, "GMCovarianceFloat::multiply: vector and matrix size do not match!" );
+
+  // see GMCovariance::multiply: Sx = 1/N \sum_k d_k ( f_k - fSum/N ) with f_k = d_k^T x,
+  // the data vectors d_k are the (contiguous) columns of the data matrix
+  uint D = data.rows();
+  int N = data.cols();
+  const float *dp = data.getDataPointer();
+  const double *xp = x.getDataPointer();
+
+  Vector f ( N );
+  double fSum = 0.0;
+#pragma omp parallel for schedule(static) reduction(+:fSum)
+  for ( int k = 0; k < N; k++ )
+  {
+    const float *dk = dp + (size_t)k * D;
+    double s = 0.0;
+    for ( uint d = 0; d < D; d++ )
+      s += (double)dk[d] * xp[d];
+    f[k] = s;
+    fSum += s;
+  }
+
+  y.resize ( D );
+  y.set ( 0.0 );
+  double *yp = y.getDataPointer();
+  for ( int k = 0; k < N; k++ )
+  {
+    const float *dk = dp + (size_t)k * D;
+    double w = ( f[k] - fSum / N ) / N;
+    for ( uint d = 0; d < D; d++ )
+      yp[d] += w * (double)dk[d];
+  }
+}
@@ -0,0 +1,145 @@
+/**
+* @file GMMixedPrecision.h
+* @brief generic matrices with single precision storage and double precision accumulation
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_GMMIXEDPRECISIONINCLUDE
+#define _NICE_GMMIXEDPRECISIONINCLUDE
+
+#include <vector>
+
+#include "core/vector/MatrixT.h"
+#include "GenericMatrix.h"
+#include "PartialGenericMatrix.h"
+
+namespace NICE {
+
+/** @class GMStandardFloat
+ * Dense matrix stored in single precision, which halves the memory traffic of a
+ * matrix-vector multiplication compared to GMStandard. Input and output vectors
+ * are double precision and all sums are accumulated in double precision, the
+ * only loss of accuracy is the rounding of the matrix elements. Rows are
+ * processed in parallel (OpenMP).
+ */
+class GMStandardFloat : public PartialGenericMatrix
+{
+  protected:
+    //! transposed matrix, such that each row of A is contiguous in memory
+    NICE::FloatMatrix At;
+
+  public:
+    /** convert a double precision matrix */
+    GMStandardFloat ( const NICE::Matrix & A );
+
+    /** get the number of rows in A */
+    uint rows () const
+    {
+      return At.cols();
+    };
+
+    /** get the number of columns in A */
+    uint cols () const
+    {
+      return At.rows();
+    };
+
+    /** multiply with a vector: A*x = y */
+    virtual void multiply ( NICE::Vector & y, const NICE::Vector & x ) const;
+
+    /** multiply a sub-matrix with a given vector: Asub * xsub = ysub */
+    virtual void multiply ( const PartialGenericMatrix::SetType & rowSet, const PartialGenericMatrix::SetType & columnSet, NICE::Vector & y, const NICE::Vector & x ) const;
+
+    virtual double getDiagonalElement ( uint i ) const;
+};
+
+/** @class GMSparseFloat
+ * Sparse matrix in compressed row storage with single precision values and
+ * double precision accumulation. Rows are processed in parallel (OpenMP).
+ */
+class GMSparseFloat : public GenericMatrix
+{
+  protected:
+    //! start of each row in columns and values (rows+1 elements)
+    std::vector<uint> rowStart;
+
+    //! column indices of the non-zero elements
+    std::vector<uint> columns;
+
+    //! values of the non-zero elements
+    std::vector<float> values;
+
+    uint m_rows;
+    uint m_cols;
+
+    /** build the compressed row storage from (row, column, value) triplets */
+    void init ( const std::vector < NICE::triplet < int, int, double > > & entries );
+
+  public:
+    /** convert a GMSparse matrix, duplicate entries are summed up */
+    GMSparseFloat ( const GMSparse & A );
+
+    /**
+    * @brief initialize the sparse structure with a dense matrix and a given
+    * sparseness threshold
+    *
+    * @param A input matrix
+    * @param epsilon if fabs(x) < epsilon, x is considered as zero
+    */
+    GMSparseFloat ( const NICE::Matrix & A, double epsilon = 1e-9 );
+
+    /** get the number of rows in A */
+    uint rows () const
+    {
+      return m_rows;
+    };
+
+    /** get the number of columns in A */
+    uint cols () const
+    {
+      return m_cols;
+    };
+
+    /** multiply with a vector: A*x = y */
+    void multiply ( NICE::Vector & y, const NICE::Vector & x ) const;
+
+    /** get the number of non-zero elements */
+    uint getNumEntries () const
+    {
+      return values.size();
+    };
+};
+
+/** @class GMCovarianceFloat
+ * Implicit representation of a covariance matrix (see GMCovariance) with the
+ * data vectors stored in single precision.
+ */
+class GMCovarianceFloat : public GenericMatrix
+{
+  protected:
+    //! data vectors stored as columns
+    NICE::FloatMatrix data;
+
+  public:
+    /** copy the data vectors given as columns of a matrix */
+    GMCovarianceFloat ( const NICE::Matrix & data );
+
+    /** get the number of rows in A */
+    uint rows () const
+    {
+      return data.rows();
+    };
+
+    /** get the number of columns in A */
+    uint cols () const
+    {
+      return data.rows();
+    };
+
+    /** multiply with a vector: A*x = y */
+    void multiply ( NICE::Vector & y, const NICE::Vector & x ) const;
+};
+
+}
+
+#endif
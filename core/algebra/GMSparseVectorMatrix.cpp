@@ -1,5 +1,6 @@
 #include "GMSparseVectorMatrix.h"
 #include <assert.h>
+#include "core/basics/Log.h"
 
 using namespace NICE;
 using namespace NICE;
@@ -107,7 +108,7 @@ GMSparseVectorMatrix::mult2 (GMSparseVectorMatrix & y, GMSparseVectorMatrix & ou
 
 	if (rowsy != colsx)
 	{
-		cout << "GMSparse::mult matrix sizes missmatched" << endl;
+		NICE_LOG_ERROR ( "GMSparse::mult matrix sizes missmatched" );
 		exit (1);
 	}
 
@@ -171,7 +172,7 @@ GMSparseVectorMatrix::mult (GMSparseVectorMatrix & y, GMSparseVectorMatrix & out
 
 	if (rowsy != colsx)
 	{
-		cout << "GMSparse::mult matrix sizes missmatched" << endl;
+		NICE_LOG_ERROR ( "GMSparse::mult matrix sizes missmatched" );
 		exit (1);
 	}
 
@@ -204,7 +205,7 @@ GMSparseVectorMatrix::mult (GMSparseVectorMatrix & y, GMSparseVectorMatrix & out
 
 			if (!NICE::isFinite (val * val))
 			{
-				cout << "val " << val << endl;
+				NICE_LOG_ERROR ( "GMSparse::mult non-finite value " << val );
 				for (int i = 0; i < rowsy; i++)
 				{
 					if (transpx)
@@ -218,7 +219,7 @@ GMSparseVectorMatrix::mult (GMSparseVectorMatrix & y, GMSparseVectorMatrix & out
 						yval = y[i].get (c);
 
 					val += xval * yval;
-					cout << " xval: " << xval << " yval " << yval << endl;
+					NICE_LOG_ERROR ( " xval: " << xval << " yval " << yval );
 				}
 				getchar ();
 			}
@@ -84,6 +84,12 @@ class GMSparse : public GenericMatrix
     /** multiply with a vector: A*x = y */
     void multiply ( NICE::Vector & y, const NICE::Vector & x ) const;
 
+    /** get all non-zero elements of A as (row, column, value) triplets */
+    const std::vector < NICE::triplet < int, int, double > > & getEntries () const
+    {
+      return A;
+    };
+
 };
 
 /** implicit representation of a covariance matrix */
@@ -9,6 +9,8 @@
 
 #include <core/basics/Timer.h>
 #include "ILSConjugateGradients.h"
+#include "core/basics/Profiler.h"
+#include "core/basics/Log.h"
 
 using namespace NICE;
 using namespace std;
@@ -40,102 +42,111 @@ void ILSConjugateGradients::setJacobiPreconditioner ( const Vector & jacobiPreco
     
 int ILSConjugateGradients::solveLin ( const GenericMatrix & gm, const Vector & b, Vector & x )
 {
+  NICE_PROFILE_ZONE ( "ILSConjugateGradients::solveLin" );
   Timer t;
 
   if ( timeAnalysis )
     t.start();
 
-  if ( b.size() != gm.rows() ) {
-    fthrow(Exception, "Size of vector b (" << b.size() << ") mismatches with the size of the given GenericMatrix (" << gm.rows() << ").");
-  }
-
-  if ( x.size() != gm.cols() )
-  {
-    x.resize(gm.cols());
-    x.set(0.0); // bad initial solution, but whatever
-  }
-
+  bool nonZeroInitialization = initSolution ( gm, b, x );
 
   // CG-Method: http://www.netlib.org/templates/templates.pdf
   //
+  // All vectors are taken from the workspace of the solver and all updates are
+  // done in-place, such that no memory is allocated within the iterations.
 
-  Vector a;
+  uint n = b.size();
+  Vector & r = workspace.getVector ( 0, n );
+  Vector & z = workspace.getVector ( 1, n );
+  Vector & p = workspace.getVector ( 2, n );
+  Vector & q = workspace.getVector ( 3, n );
+  Vector & current_x = workspace.getVector ( 4, n );
+  Vector & rold = workspace.getVector ( 5, useFlexibleVersion ? n : 0 );
+
+  bool useJacobi = ( jacobiPreconditioner.size() == n );
+  // without a preconditioner z = r and we do not need a copy
+  const Vector & zr = ( useJacobi || (preconditioner != NULL) ) ? z : r;
 
   // compute r^0 = b - A*x^0
-  gm.multiply( a, x ); 
-  Vector r = b - a;
+  r = b;
+  if ( nonZeroInitialization ) {
+    gm.multiply( q, x ); 
+    r.axpy ( -1.0, q );
+  }
   
+  // store optimal values 
+  double res_min = r.scalarProduct(r);
+  double res = res_min;
+  current_x = x;
+
   if ( timeAnalysis ) {
     t.stop();
-    cerr << "ILSConjugateGradients: TIME " << t.getSum() << " " << r.normL2() << " " << r.normInf() << endl;
+    NICE_LOG_TIMING ( "ILSConjugateGradients: TIME " << t.getSum() << " " << sqrt(res) << " " << r.normInf() );
     t.start();
   }
-
-  Vector rold ( r.size(), 0.0 );
-
-  // store optimal values 
-  double res_min = r.scalarProduct(r);
-  Vector current_x = x;
   
   double rhoold = 0.0;
-  Vector z ( r.size() );
-  Vector p ( z.size() );
 
   uint i = 1;
   while ( i <= maxIterations )
   {
-    // pre-conditioned vector, currently M=I, i.e. no pre-condition
-    // otherwise set z = M * r
-    if ( jacobiPreconditioner.size() != r.size() ) {
-      z = r;
-    } else {
+    // pre-conditioned vector z = M^{-1} * r, M=I if no preconditioner is given
+    double rho;
+    if ( useJacobi ) {
       // use simple Jacobi pre-conditioning
-      for ( uint jj = 0 ; jj < z.size() ; jj++ )
+      for ( uint jj = 0 ; jj < n ; jj++ )
         z[jj] = r[jj] / jacobiPreconditioner[jj];
+      rho = z.scalarProduct( r );
+    } else if ( preconditioner != NULL ) {
+      preconditioner->apply ( z, r );
+      rho = z.scalarProduct( r );
+    } else {
+      // we already know r^T r
+      rho = res;
     }
 
-    double rho = z.scalarProduct( r );
-
     if ( verbose ) {
-      cerr << "ILSConjugateGradients: iteration " << i << " / " << maxIterations << endl;
+      NICE_LOG_DEBUG ( "ILSConjugateGradients: iteration " << i << " / " << maxIterations );
       if ( current_x.size() <= 20 )
-        cerr << "ILSConjugateGradients: current solution " << current_x << endl;
+        NICE_LOG_DEBUG ( "ILSConjugateGradients: current solution " << current_x );
     }
 
     if ( i == 1 ) {
-      p = z;
+      p = zr;
     } else {
       double beta;
       if ( useFlexibleVersion ) {
-        beta = ( rho - z.scalarProduct(rold) ) / rhoold;
+        beta = ( rho - zr.scalarProduct(rold) ) / rhoold;
       } else {
         beta = rho / rhoold;
       }
-      p = z + beta * p;
+      // p = z + beta * p
+      p.axpby ( 1.0, zr, beta );
     }
-    Vector q ( gm.rows() );
     // q = A*p
     gm.multiply ( q, p );
 
-    // sp = p^T A p
+    // sp = p^T A p, computed together with the squared norm of p
     // if A is next to zero this gets nasty, because we divide by sp
     // later on
-    double sp = p.scalarProduct(q);
+    double pp;
+    double sp = p.scalarProductAndSquaredNorm ( q, pp );
     if ( fabs(sp) < 1e-20 ) {
       // we achieved some kind of convergence, at least this
       // is a termination condition used in the wiki article
       if ( verbose )
-        cerr << "ILSConjugateGradients: p^T*q is quite small" << endl;
+        NICE_LOG_DEBUG ( "ILSConjugateGradients: p^T*q is quite small" );
       break;
     }
     double alpha = rho / sp;
   
-    current_x = current_x + alpha * p;
+    current_x.axpy ( alpha, p );
 
-    rold = r;
-    r = r - alpha * q;
+    if ( useFlexibleVersion )
+      rold = r;
+    r.axpy ( -alpha, q );
     
-    double res = r.scalarProduct(r);
+    res = r.scalarProduct(r);
     double resMax = r.normInf();
 
     // store optimal x that produces smallest residual
@@ -146,28 +157,28 @@ int ILSConjugateGradients::solveLin ( const GenericMatrix & gm, const Vector & b
     }
     
     // check convergence
-    double delta = fabs(alpha) * p.normL2();
+    double delta = fabs(alpha) * sqrt(pp);
     if ( verbose ) {
-      cerr << "ILSConjugateGradients: delta = " << delta << " lower bound = " << minDelta << endl;
-      cerr << "ILSConjugateGradients: residual = " << res << endl;
-      cerr << "ILSConjugateGradients: L_inf residual = " << resMax << " lower bound = " << minResidual << endl;      
+      NICE_LOG_DEBUG ( "ILSConjugateGradients: delta = " << delta << " lower bound = " << minDelta );
+      NICE_LOG_DEBUG ( "ILSConjugateGradients: residual = " << res );
+      NICE_LOG_DEBUG ( "ILSConjugateGradients: L_inf residual = " << resMax << " lower bound = " << minResidual );
       if (resMax < 0)
       {
-        std::cerr << "WARNING: resMax is smaller than zero! " << std::endl;
-        std::cerr << "ILSConjugateGradients: vector r: " << r << std::endl;
+        NICE_LOG_WARNING ( "WARNING: resMax is smaller than zero! " );
+        NICE_LOG_DEBUG ( "ILSConjugateGradients: vector r: " << r );
       }
     }
  
     if ( timeAnalysis ) {
       t.stop();
-      cerr << "ILSConjugateGradients: TIME " << t.getSum() << " " << res << " " << resMax << endl;
+      NICE_LOG_TIMING ( "ILSConjugateGradients: TIME " << t.getSum() << " " << res << " " << resMax );
       t.start();
     }
 
    
     if ( delta < minDelta ) {
       if ( verbose )
-        cerr << "ILSConjugateGradients: small delta" << endl;
+        NICE_LOG_DEBUG ( "ILSConjugateGradients: small delta" );
       break;
     }
 
@@ -176,7 +187,7 @@ int ILSConjugateGradients::solveLin ( const GenericMatrix & gm, const Vector & b
     if ( resMax < minResidual ) {      
       if ( verbose )
       {
-        cerr << "ILSConjugateGradients: small residual -- resMax: "<< resMax << " minRes: " << minResidual << endl;
+        NICE_LOG_DEBUG ( "ILSConjugateGradients: small residual -- resMax: "<< resMax << " minRes: " << minResidual );
       }
       break;
     }
@@ -187,14 +198,16 @@ int ILSConjugateGradients::solveLin ( const GenericMatrix & gm, const Vector & b
   
   if (verbose)
   {
-    cerr << "ILSConjugateGradients: iterations needed: " << std::min<uint>(i,maxIterations) << endl;
-    cerr << "ILSConjugateGradients: minimal residual achieved: " << res_min << endl;
+    NICE_LOG_DEBUG ( "ILSConjugateGradients: iterations needed: " << std::min<uint>(i,maxIterations) );
+    NICE_LOG_DEBUG ( "ILSConjugateGradients: minimal residual achieved: " << res_min );
   }
   if (verbose)
   {    
     if ( x.size() <= 20 )
-      cerr << "ILSConjugateGradients: optimal solution: " << x << endl;
+      NICE_LOG_DEBUG ( "ILSConjugateGradients: optimal solution: " << x );
   }
+
+  finishSolution ( x );
   
   return 0;
 }
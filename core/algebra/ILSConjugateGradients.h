@@ -47,7 +47,9 @@ class ILSConjugateGradients : public IterativeLinearSolver
 		virtual ~ILSConjugateGradients();
 
     /**
-    * @brief set a vector of diagonal elements for the jacobi preconditioner
+    * @brief set a vector of diagonal elements for the jacobi preconditioner,
+    * this is a shortcut for setPreconditioner with a PCJacobi object and
+    * takes precedence over the generic preconditioner
     *
     * @param jacobiPreconditioner
     */
@@ -6,8 +6,11 @@
 
 */
 #include <iostream>
+#include <algorithm>
 
 #include "ILSConjugateGradientsLanczos.h"
+#include "core/basics/Profiler.h"
+#include "core/basics/Log.h"
 
 using namespace NICE;
 using namespace std;
@@ -32,15 +35,8 @@ ILSConjugateGradientsLanczos::~ILSConjugateGradientsLanczos()
     
 int ILSConjugateGradientsLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vector & x )
 {
-  if ( b.size() != gm.rows() ) {
-    fthrow(Exception, "Size of vector b (" << b.size() << ") mismatches with the size of the given GenericMatrix (" << gm.rows() << ").");
-  }
-
-  if ( x.size() != gm.cols() )
-  {
-    x.resize(gm.cols());
-    x.set(0.0); // bad initial solution, but whatever
-  }
+  NICE_PROFILE_ZONE ( "ILSConjugateGradientsLanczos::solveLin" );
+  bool nonZeroInitialization = initSolution ( gm, b, x );
 
 //   if ( verbose ) cerr << "initial solution: " << x << endl;
 
@@ -51,15 +47,22 @@ int ILSConjugateGradientsLanczos::solveLin ( const GenericMatrix & gm, const Vec
   // http://www.netlib.org/templates/templates.pdf
   //
 
-  // init some helping vectors
-  Vector Av(b.size(),0.0); // Av = A * v_j
-  Vector Ac(b.size(),0.0); // Ac = A * c_j
-  Vector r(b.size(),0.0); // current residual
-  Vector *v_new = new Vector(x.size(),0.0); // new Lanczos vector v_j
-  Vector *v_old = new Vector(x.size(),0.0); // Lanczos vector v_{j-1} of the iteration before 
-  Vector *v_older = 0; // Lanczos vector v_{j-2} of the iteration before 
-  Vector *c_new = new Vector(x.size(),0.0); // current update vector c_j for the solution x
-  Vector *c_old = 0; // update vector of iteration before
+  uint n = b.size();
+  bool usePreconditioner = ( preconditioner != NULL );
+
+  // init some helping vectors, all of them are taken from the workspace of the solver
+  // and updated in-place, such that no memory is allocated within the iterations
+  Vector & Av = workspace.getVector ( 0, n ); // Av = A * v_j
+  Vector & Ac = workspace.getVector ( 1, n ); // Ac = A * c_j
+  Vector & r = workspace.getVector ( 2, n ); // current residual
+  Vector & c = workspace.getVector ( 3, n ); // current update vector c_j for the solution x
+  Vector & current_x = workspace.getVector ( 4, n ); // current solution
+  // Lanczos vectors q_j = M * v_j of the preconditioned process (q_j = v_j without a preconditioner),
+  // the three-term recurrence only needs two of them
+  Vector *q_new = &workspace.getVector ( 5, n ); // q_j
+  Vector *q_old = &workspace.getVector ( 6, n ); // q_{j-1}
+  // new Lanczos vector v_j = M^{-1} q_j (we use the memory of q_j without a preconditioner)
+  Vector *v_new = usePreconditioner ? &workspace.getVector ( 7, n ) : q_new;
 
   // declare some helpers
   double d_new = 0; // current element of diagonal matrix D normally obtained from Cholesky factorization of tridiagonal matrix T, where T consists alpha and beta as below
@@ -68,23 +71,50 @@ int ILSConjugateGradientsLanczos::solveLin ( const GenericMatrix & gm, const Vec
   double p_new = 0; // current element of vector p, where p is the solution of the modified linear system
   double p_old = 0; // corresponding element of the iteration before
   double alpha = 0; // alpha_j = v_j^T * A * v_j for new Lanczos vector v_j
-  double beta = b.normL2(); // beta_1 = norm(b), in general beta_j = norm(v_j) for new Lanczos vector v_j
-  
-  // first iteration + initialization, where b will be used as the first Lanczos vector
-  *v_new = (1/beta)*b; // init v_1, v_1 = b / norm(b)
+  double beta = 0; // beta_1 is the M^{-1}-norm of the initial residual, in general beta_j is the M^{-1}-norm of the unnormalized q_j
+
+  // the Lanczos process starts with the initial residual r_0 = b - A * x_0 (r_0 = b for x_0 = 0)
+  r = b;
+  if ( nonZeroInitialization )
+  {
+    gm.multiply ( Av, x );
+    r.axpy ( -1.0, Av );
+  }
+  current_x = x;
+
+  // first iteration + initialization, where r_0 will be used as the first Lanczos vector
+  *q_new = r;
+  if ( usePreconditioner ) {
+    preconditioner->apply ( *v_new, *q_new );
+    beta = sqrt( q_new->scalarProduct(*v_new) ); // beta_1 = sqrt(r_0^T M^{-1} r_0)
+    *v_new *= (1/beta); // init v_1 = M^{-1} r_0 / beta_1 
+  } else {
+    beta = q_new->normL2(); // beta_1 = norm(r_0)
+  }
+
+  if ( beta == 0.0 )
+  {
+    // the initial solution already solves the system
+    finishSolution ( x );
+    return 0;
+  }
+
+  *q_new *= (1/beta); // init q_1 = r_0 / beta_1 (v_1 = q_1 without a preconditioner)
+  q_old->set(0.0); // q_0 = 0
+
   gm.multiply(Av,*v_new); // Av = A * v_1
   alpha = v_new->scalarProduct(Av); // alpha_1 = v_1^T * A * v_1
   d_new=alpha; // d_1 = alpha_1, d_1 is the first element of diagonal matrix D
   p_new = beta/d_new; // p_1 = beta_1 / d_1
   
-  *c_new = *v_new; // c_1 = v_1
+  c = *v_new; // c_1 = v_1
   Ac = Av; // A*c_1 = A*v_1
   
-  // store current solution
-  Vector current_x = (p_new*(*c_new)); // first approx. of x: x_1 = p_1 * c_1
+  // first approx. of x: x_1 = x_0 + p_1 * c_1
+  current_x.axpy ( p_new, c );
 
   // calculate current residual
-  r = b - (p_new*Ac);
+  r.axpy ( -p_new, Ac );
   double res = r.scalarProduct(r);
   
   // store minimal residual
@@ -93,13 +123,13 @@ int ILSConjugateGradientsLanczos::solveLin ( const GenericMatrix & gm, const Vec
   // store optimal solution in output variable x
   x = current_x;
   
-  double delta_x = fabs(p_new) * c_new->normL2();
+  double delta_x = fabs(p_new) * c.normL2();
   if ( verbose ) {
-    cerr << "ILSConjugateGradientsLanczos: iteration 1 / " << maxIterations << endl;
+    NICE_LOG_DEBUG ( "ILSConjugateGradientsLanczos: iteration 1 / " << maxIterations );
     if ( current_x.size() <= 20 )
-      cerr << "ILSConjugateGradientsLanczos: current solution " << current_x << endl;
-    cerr << "ILSConjugateGradientsLanczos: delta_x = " << delta_x << endl;
-    cerr << "ILSConjugateGradientsLanczos: residual = " << r.scalarProduct(r) << endl;
+      NICE_LOG_DEBUG ( "ILSConjugateGradientsLanczos: current solution " << current_x );
+    NICE_LOG_DEBUG ( "ILSConjugateGradientsLanczos: delta_x = " << delta_x );
+    NICE_LOG_DEBUG ( "ILSConjugateGradientsLanczos: residual = " << res );
   }  
   
   // start with second iteration
@@ -110,32 +140,23 @@ int ILSConjugateGradientsLanczos::solveLin ( const GenericMatrix & gm, const Vec
     d_old = d_new;
     p_old = p_new;
     
-    // prepare vectors v_older, v_old, v_new for next iteration
-    if ( v_older == 0) v_older = v_old;
-    else {
-      
-      delete v_older;
-      v_older = v_old;
-    }
-    v_old = v_new;
-    v_new = new Vector(v_old->size(),0.0);
-    
-    // prepare vectors c_old, c_new for next iteration
-    if ( c_old == 0 ) c_old = c_new;
-    else {
-      
-      delete c_old;
-      c_old = c_new;
-    }
-    c_new = new Vector(c_old->size(),0.0);
-    
     //start next iteration:
-    // calulate new Lanczos vector v_j based on older ones
-    *v_new = Av - (alpha*(*v_old)) - (beta*(*v_older)); // unnormalized v_j = ( A * v_{j-1} ) - ( alpha_{j-1} * v_{j-1} ) - ( beta_{j-1} * v_{j-2} )
-
-    // calculate new weight beta_j and normalize v_j
-    beta = v_new->normL2(); // beta_j = norm(v_j) 
-    v_new->normalizeL2(); // normalize v_j 
+    // calulate new Lanczos vector q_j based on older ones, the memory of q_{j-2} is reused:
+    // unnormalized q_j = ( A * v_{j-1} ) - ( alpha_{j-1} * q_{j-1} ) - ( beta_{j-1} * q_{j-2} )
+    q_old->axpby ( 1.0, Av, -beta );
+    q_old->axpy ( -alpha, *q_new );
+    std::swap ( q_new, q_old );
+
+    // calculate new weight beta_j and normalize q_j and v_j = M^{-1} q_j
+    if ( usePreconditioner ) {
+      preconditioner->apply ( *v_new, *q_new );
+      beta = sqrt( q_new->scalarProduct(*v_new) ); // beta_j = sqrt( q_j^T M^{-1} q_j )
+      *v_new *= (1/beta);
+    } else {
+      v_new = q_new;
+      beta = q_new->normL2(); // beta_j = norm(q_j) 
+    }
+    *q_new *= (1/beta); // normalize q_j 
 
     // calculate new weight alpha_j
     gm.multiply(Av,*v_new); // Av = A * v_j
@@ -151,21 +172,21 @@ int ILSConjugateGradientsLanczos::solveLin ( const GenericMatrix & gm, const Vec
     // calculate the new weight p_j of the new update vector c_j for the solution x
     p_new = -p_old*l_new*d_old/d_new; 
 
-    // calculate the new update vector c_j for the solution x
-    *c_new = *v_new - (l_new*(*c_old));
+    // calculate the new update vector c_j = v_j - l_j * c_{j-1} for the solution x (in-place)
+    c.axpby ( 1.0, *v_new, -l_new );
 
     // calculate new residual vector
-    Ac = Av - (l_new*Ac);
-    r-=p_new*Ac;
+    Ac.axpby ( 1.0, Av, -l_new );
+    r.axpy ( -p_new, Ac );
     res = r.scalarProduct(r);
     
     // update solution x
-    current_x+=(p_new*(*c_new)); 
+    current_x.axpy ( p_new, c );
     
     if ( verbose ) {
-      cerr << "ILSConjugateGradientsLanczos: iteration " << j << " / " << maxIterations << endl;
+      NICE_LOG_DEBUG ( "ILSConjugateGradientsLanczos: iteration " << j << " / " << maxIterations );
       if ( current_x.size() <= 20 )
-        cerr << "ILSConjugateGradientsLanczos: current solution " << current_x << endl;
+        NICE_LOG_DEBUG ( "ILSConjugateGradientsLanczos: current solution " << current_x );
     }
     
     // store optimal x that produces smallest residual
@@ -176,15 +197,15 @@ int ILSConjugateGradientsLanczos::solveLin ( const GenericMatrix & gm, const Vec
     }     
 
     // check convergence
-    delta_x = fabs(p_new) * c_new->normL2();
+    delta_x = fabs(p_new) * c.normL2();
     if ( verbose ) {
-      cerr << "ILSConjugateGradientsLanczos: delta_x = " << delta_x << endl;
-      cerr << "ILSConjugateGradientsLanczos: residual = " << r.scalarProduct(r) << endl;
+      NICE_LOG_DEBUG ( "ILSConjugateGradientsLanczos: delta_x = " << delta_x );
+      NICE_LOG_DEBUG ( "ILSConjugateGradientsLanczos: residual = " << res );
     }  
 
     if ( delta_x < minDelta ) {
       if ( verbose )
-        cerr << "ILSConjugateGradientsLanczos: small delta_x" << endl;
+        NICE_LOG_DEBUG ( "ILSConjugateGradientsLanczos: small delta_x" );
       break;
     } 
     
@@ -192,18 +213,13 @@ int ILSConjugateGradientsLanczos::solveLin ( const GenericMatrix & gm, const Vec
   }
   
 //   if ( verbose ) {
-    cerr << "ILSConjugateGradientsLanczos: iterations needed: " << std::min<uint>(j,maxIterations) << endl;
-    cerr << "ILSConjugateGradientsLanczos: minimal residual achieved: " << res_min << endl;
+    NICE_LOG_DEBUG ( "ILSConjugateGradientsLanczos: iterations needed: " << std::min<uint>(j,maxIterations) );
+    NICE_LOG_DEBUG ( "ILSConjugateGradientsLanczos: minimal residual achieved: " << res_min );
     if ( x.size() <= 20 )
-      cerr << "ILSConjugateGradientsLanczos: optimal solution: " << x << endl;
+      NICE_LOG_DEBUG ( "ILSConjugateGradientsLanczos: optimal solution: " << x );
 //   }  
-   
-  delete v_new;
-  delete v_old;
-  delete v_older;
-  delete c_new;
-  delete c_old;
+
+  finishSolution ( x );
 
   return 0;
 }
-
@@ -0,0 +1,180 @@
+/** 
+* @file ILSConjugateGradientsSteihaug.cpp
+* @brief truncated conjugate gradients for trust region subproblems (Steihaug-Toint)
+* @date 10/19/2026
+
+*/
+#include <cmath>
+#include <limits>
+
+#include "ILSConjugateGradientsSteihaug.h"
+#include "core/basics/Exception.h"
+#include "core/basics/Profiler.h"
+#include "core/basics/Log.h"
+
+using namespace NICE;
+using namespace std;
+
+namespace {
+
+/** positive tau with ||x + tau*d||_M = radius, given x^T M x, x^T M d and d^T M d */
+double boundaryStep ( double xMx, double xMd, double dMd, double radius )
+{
+  const double discriminant = xMd * xMd + dMd * ( radius * radius - xMx );
+  return ( -xMd + sqrt ( std::max ( 0.0, discriminant ) ) ) / dMd;
+}
+
+}
+
+ILSConjugateGradientsSteihaug::ILSConjugateGradientsSteihaug( bool verbose, uint maxIterations, double relativeTolerance )
+{
+  this->verbose = verbose;
+  this->maxIterations = maxIterations;
+  this->relativeTolerance = relativeTolerance;
+  this->radius = std::numeric_limits<double>::infinity();
+  this->status = CONVERGED;
+  this->iterations = 0;
+  this->solutionNorm = 0.0;
+  this->modelValue = 0.0;
+}
+
+ILSConjugateGradientsSteihaug::~ILSConjugateGradientsSteihaug()
+{
+}
+
+void ILSConjugateGradientsSteihaug::setTrustRegionRadius ( double radius )
+{
+  if ( !( radius > 0.0 ) )
+    fthrow(Exception, "ILSConjugateGradientsSteihaug: the radius has to be positive");
+  this->radius = radius;
+}
+
+void ILSConjugateGradientsSteihaug::setRelativeTolerance ( double relativeTolerance )
+{
+  this->relativeTolerance = relativeTolerance;
+}
+
+void ILSConjugateGradientsSteihaug::setMaxIterations ( uint maxIterations )
+{
+  this->maxIterations = maxIterations;
+}
+
+int ILSConjugateGradientsSteihaug::solveLin ( const GenericMatrix & gm, const Vector & b, Vector & x )
+{
+  NICE_PROFILE_ZONE ( "ILSConjugateGradientsSteihaug::solveLin" );
+
+  if ( b.size() != gm.rows() ) {
+    fthrow(Exception, "Size of vector b (" << b.size() << ") mismatches with the size of the given GenericMatrix (" << gm.rows() << ").");
+  }
+
+  // Nocedal and Wright, Numerical Optimization, Algorithm 7.2, with the
+  // preconditioned norm of Conn, Gould and Toint, Trust-Region Methods, 7.5.1:
+  // x^T M x, x^T M d and d^T M d are updated by recurrences, such that M
+  // itself is never needed.
+  //
+  // All vectors are taken from the workspace of the solver and all updates are
+  // done in-place, such that no memory is allocated within the iterations.
+
+  uint n = b.size();
+  x.resize ( n );
+  x.set ( 0.0 );
+  Vector & r = workspace.getVector ( 0, n );
+  Vector & z = workspace.getVector ( 1, preconditioner != NULL ? n : 0 );
+  Vector & d = workspace.getVector ( 2, n );
+  Vector & q = workspace.getVector ( 3, n );
+
+  // without a preconditioner z = r and we do not need a copy
+  const Vector & zr = ( preconditioner != NULL ) ? z : r;
+
+  r = b;
+  if ( preconditioner != NULL )
+    applyPreconditioner ( z, r );
+  double rz = r.scalarProduct ( zr );
+  const double tolerance = relativeTolerance * b.normL2();
+
+  d = zr;
+  double xMx = 0.0;
+  double xMd = 0.0;
+  double dMd = rz;
+
+  status = MAX_ITERATIONS;
+  iterations = 0;
+
+  if ( b.normL2() == 0.0 )
+    status = CONVERGED;
+
+  while ( status == MAX_ITERATIONS && iterations < maxIterations )
+  {
+    iterations++;
+
+    // q = A*d
+    gm.multiply ( q, d );
+    const double dq = d.scalarProduct ( q );
+
+    if ( dq <= 0.0 )
+    {
+      // the model is unbounded along d, go to the boundary
+      const double tau = ( radius < std::numeric_limits<double>::infinity() ) ? boundaryStep ( xMx, xMd, dMd, radius ) : 1.0;
+      x.axpy ( tau, d );
+      r.axpy ( -tau, q );
+      xMx += 2.0 * tau * xMd + tau * tau * dMd;
+      status = NEGATIVE_CURVATURE;
+      if ( verbose )
+        NICE_LOG_DEBUG ( "ILSConjugateGradientsSteihaug: negative curvature " << dq );
+      break;
+    }
+
+    const double alpha = rz / dq;
+    const double xMxNew = xMx + 2.0 * alpha * xMd + alpha * alpha * dMd;
+    if ( xMxNew >= radius * radius )
+    {
+      const double tau = boundaryStep ( xMx, xMd, dMd, radius );
+      x.axpy ( tau, d );
+      r.axpy ( -tau, q );
+      xMx = radius * radius;
+      status = BOUNDARY;
+      if ( verbose )
+        NICE_LOG_DEBUG ( "ILSConjugateGradientsSteihaug: step reaches the boundary" );
+      break;
+    }
+
+    x.axpy ( alpha, d );
+    r.axpy ( -alpha, q );
+    xMx = xMxNew;
+
+    const double res = r.normL2();
+    if ( verbose )
+      NICE_LOG_DEBUG ( "ILSConjugateGradientsSteihaug: iteration " << iterations << " residual = " << res );
+    if ( res <= tolerance )
+    {
+      status = CONVERGED;
+      break;
+    }
+
+    if ( preconditioner != NULL )
+      applyPreconditioner ( z, r );
+    const double rzNew = r.scalarProduct ( zr );
+    const double beta = rzNew / rz;
+    xMd = beta * ( xMd + alpha * dMd );
+    dMd = rzNew + beta * beta * dMd;
+    // d = z + beta * d
+    d.axpby ( 1.0, zr, beta );
+    rz = rzNew;
+  }
+
+  solutionNorm = sqrt ( xMx );
+  // 0.5 x^T A x - b^T x = -0.5 x^T (b + r) with r = b - A x
+  modelValue = -0.5 * ( x.scalarProduct ( b ) + x.scalarProduct ( r ) );
+
+  if ( verbose )
+    NICE_LOG_DEBUG ( "ILSConjugateGradientsSteihaug: status " << status << " after " << iterations << " iterations, norm " << solutionNorm );
+
+  finishSolution ( x );
+
+  return status;
+}
+
+void ILSConjugateGradientsSteihaug::setVerbose(const bool& _verbose)
+{
+  this->verbose = _verbose;
+}
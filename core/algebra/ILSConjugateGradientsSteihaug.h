@@ -0,0 +1,112 @@
+/** 
+* @file ILSConjugateGradientsSteihaug.h
+* @brief truncated conjugate gradients for trust region subproblems (Steihaug-Toint)
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_ILSConjugateGradientsSteihaug_INCLUDE
+#define _NICE_ILSConjugateGradientsSteihaug_INCLUDE
+
+#include "core/vector/VectorT.h"
+#include "GenericMatrix.h"
+#include "IterativeLinearSolver.h"
+
+namespace NICE {
+  
+/** @class ILSConjugateGradientsSteihaug
+ * Truncated (preconditioned) conjugate gradients of Steihaug and Toint for
+ * the trust region subproblem min_x 0.5 x^T A x - b^T x s.t. ||x||_M <= radius,
+ * where A is symmetric but not necessarily positive definite and M is the
+ * preconditioner (M = I without preconditioner).
+ *
+ * The iteration starts at x = 0 and stops with the usual CG solution if the
+ * residual is small enough, or on the boundary of the trust region if a
+ * step leaves it or a direction of negative curvature is found. The norm of
+ * the iterates increases monotonically, therefore the initial estimate and
+ * warm starts are not used.
+ */
+class ILSConjugateGradientsSteihaug : public IterativeLinearSolver
+{
+  public:
+
+    /** reason for the termination of solveLin() */
+    enum Status {
+      //! relative residual below the tolerance
+      CONVERGED = 0,
+      //! the solution is on the boundary of the trust region
+      BOUNDARY,
+      //! direction of negative (or zero) curvature, the solution is on the boundary
+      NEGATIVE_CURVATURE,
+      //! maximum number of iterations
+      MAX_ITERATIONS
+    };
+
+  protected:
+      bool verbose;
+      uint maxIterations;
+      double relativeTolerance;
+      double radius;
+
+      // results of the last call
+      Status status;
+      uint iterations;
+      double solutionNorm;
+      double modelValue;
+
+  public:
+
+    /**
+    * @brief constructor 
+    *
+    * @param verbose output the residual and some debug information for each iteration
+    * @param maxIterations maximum number of iterations
+    * @param relativeTolerance stop if ||b - A*x|| <= relativeTolerance * ||b||
+    */
+    ILSConjugateGradientsSteihaug( bool verbose = false, uint maxIterations = 10000, double relativeTolerance = 1e-6 );
+		  
+		/** simple destructor */
+		virtual ~ILSConjugateGradientsSteihaug();
+
+    /** radius of the trust region (in the norm of the preconditioner), infinity: no constraint */
+    void setTrustRegionRadius ( double radius );
+
+    /** stop if ||b - A*x|| <= relativeTolerance * ||b|| */
+    void setRelativeTolerance ( double relativeTolerance );
+
+    void setMaxIterations ( uint maxIterations );
+
+    /**
+    * @brief Solve the trust region subproblem of A and b, where A is indirectly presented
+    * by the GenericMatrix gm
+    *
+    * @param gm GenericMatrix providing matrix-vector multiplications
+    * @param b Vector on the right hand side of the system
+    * @param x solution (the initial estimate is ignored)
+    *
+    * @return termination reason (Status)
+    */
+    int solveLin ( const GenericMatrix & gm, const Vector & b, Vector & x );
+
+    /** termination reason of the last call */
+    Status getStatus () const { return status; };
+
+    /** number of iterations (multiplications with A) of the last call */
+    uint getIterations () const { return iterations; };
+
+    /** norm ||x||_M of the last solution */
+    double getSolutionNorm () const { return solutionNorm; };
+
+    /** value of the model 0.5 x^T A x - b^T x of the last solution (computed without additional multiplications) */
+    double getModelValue () const { return modelValue; };
+
+    /**
+    * @brief Enable or disable output
+    *
+    * @param _verbose
+    */    
+    void setVerbose( const bool & _verbose );
+};
+
+}
+
+#endif
@@ -0,0 +1,95 @@
+/**
+* @file ILSIterativeRefinement.cpp
+* @brief mixed precision iterative refinement around an iterative linear solver
+* @date 10/19/2026
+
+*/
+#include <iostream>
+
+#include <core/basics/Exception.h>
+
+#include "ILSIterativeRefinement.h"
+#include "core/basics/Profiler.h"
+#include "core/basics/Log.h"
+
+using namespace NICE;
+using namespace std;
+
+ILSIterativeRefinement::ILSIterativeRefinement( IterativeLinearSolver *innerSolver, const GenericMatrix *lowPrecisionMatrix,
+                                                bool verbose, uint maxIterations, double minRelativeResidual )
+{
+  if ( innerSolver == NULL )
+    fthrow(Exception, "ILSIterativeRefinement: no inner solver given.");
+
+  this->innerSolver = innerSolver;
+  this->lowPrecisionMatrix = lowPrecisionMatrix;
+  this->verbose = verbose;
+  this->maxIterations = maxIterations;
+  this->minRelativeResidual = minRelativeResidual;
+}
+
+ILSIterativeRefinement::~ILSIterativeRefinement()
+{
+}
+
+int ILSIterativeRefinement::solveLin ( const GenericMatrix & gm, const Vector & b, Vector & x )
+{
+  NICE_PROFILE_ZONE ( "ILSIterativeRefinement::solveLin" );
+  const GenericMatrix & inner = ( lowPrecisionMatrix != NULL ) ? *lowPrecisionMatrix : gm;
+  if ( (inner.rows() != gm.rows()) || (inner.cols() != gm.cols()) )
+    fthrow(Exception, "ILSIterativeRefinement: size of the low precision matrix (" << inner.rows() << " x " << inner.cols()
+           << ") mismatches with the size of the system (" << gm.rows() << " x " << gm.cols() << ").");
+
+  initSolution ( gm, b, x );
+
+  uint n = b.size();
+  Vector & r = workspace.getVector ( 0, n ); // residual in full precision
+  Vector & Ax = workspace.getVector ( 1, n );
+  Vector & d = workspace.getVector ( 2, n ); // correction of the current solution
+
+  double bNorm = b.normL2();
+  double tolerance = minRelativeResidual * bNorm;
+
+  uint iteration = 0;
+  double rNormOld = 0.0;
+  while ( true )
+  {
+    // r = b - A*x
+    gm.multiply ( Ax, x );
+    r = b;
+    r.axpy ( -1.0, Ax );
+    double rNorm = r.normL2();
+
+    if ( verbose )
+      NICE_LOG_DEBUG ( "ILSIterativeRefinement: step " << iteration << " / " << maxIterations << " residual = " << rNorm );
+
+    if ( (rNorm <= tolerance) || (iteration >= maxIterations) )
+      break;
+
+    // the low precision matrix limits the accuracy of the corrections,
+    // the last correction did not improve the solution and is undone
+    if ( (iteration > 0) && (rNorm >= rNormOld) )
+    {
+      if ( verbose )
+        NICE_LOG_DEBUG ( "ILSIterativeRefinement: stagnation of the residual" );
+      x.axpy ( -rNormOld, d );
+      iteration--;
+      break;
+    }
+    rNormOld = rNorm;
+
+    // approximately solve A*d = r with the inner solver and correct the solution,
+    // the right hand side is normalized, such that the (often absolute) stopping
+    // criteria of the inner solver are relative to the current residual
+    r *= ( 1.0 / rNorm );
+    d.set ( 0.0 );
+    innerSolver->solveLin ( inner, r, d );
+    x.axpy ( rNorm, d );
+
+    iteration++;
+  }
+
+  finishSolution ( x );
+
+  return iteration;
+}
@@ -0,0 +1,71 @@
+/**
+* @file ILSIterativeRefinement.h
+* @brief mixed precision iterative refinement around an iterative linear solver
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_ILSIterativeRefinement_INCLUDE
+#define _NICE_ILSIterativeRefinement_INCLUDE
+
+#include "core/vector/VectorT.h"
+#include "GenericMatrix.h"
+#include "IterativeLinearSolver.h"
+
+namespace NICE {
+
+/** @class ILSIterativeRefinement
+ * Iterative refinement: the correction equation A*d = r is solved approximately
+ * with an inner solver on a low precision version of A (e.g. GMStandardFloat
+ * or GMSparseFloat), whereas the residual r = b - A*x and the solution x are
+ * updated with the full precision matrix given to solveLin. The cheap inner
+ * solves dominate the runtime and the accuracy of the final solution is only
+ * limited by the full precision residual.
+ */
+class ILSIterativeRefinement : public IterativeLinearSolver
+{
+
+    protected:
+      //! solver for the correction equations (not owned)
+      IterativeLinearSolver *innerSolver;
+
+      //! low precision matrix used by the inner solver (not owned)
+      const GenericMatrix *lowPrecisionMatrix;
+
+      bool verbose;
+      uint maxIterations;
+      double minRelativeResidual;
+
+    public:
+
+    /**
+    * @brief constructor
+    *
+    * @param innerSolver solver for the correction equations, a moderate accuracy of this solver is sufficient
+    * @param lowPrecisionMatrix low precision approximation of the system matrix used by the inner solver
+    * (NULL: the inner solver uses the full precision matrix)
+    * @param verbose output the residual of each refinement step
+    * @param maxIterations maximum number of refinement steps
+    * @param minRelativeResidual stop if norm(b - A*x) <= minRelativeResidual * norm(b)
+    */
+    ILSIterativeRefinement( IterativeLinearSolver *innerSolver, const GenericMatrix *lowPrecisionMatrix = NULL,
+                            bool verbose = false, uint maxIterations = 20, double minRelativeResidual = 1e-10 );
+
+    /** simple destructor */
+    virtual ~ILSIterativeRefinement();
+
+    /**
+    * @brief Solve the linear System A*x = b, where A is indirectly presented
+    * by the GenericMatrix gm
+    *
+    * @param gm full precision GenericMatrix used to compute the residuals
+    * @param b Vector on the right hand side of the system
+    * @param x initial and final estimate
+    *
+    * @return number of refinement steps
+    */
+    int solveLin ( const GenericMatrix & gm, const Vector & b, Vector & x );
+};
+
+}
+
+#endif
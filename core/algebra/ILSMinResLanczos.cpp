@@ -6,8 +6,11 @@
 
 */
 #include <iostream>
+#include <algorithm>
 
 #include "ILSMinResLanczos.h"
+#include "core/basics/Profiler.h"
+#include "core/basics/Log.h"
 
 using namespace NICE;
 using namespace std;
@@ -32,15 +35,8 @@ ILSMinResLanczos::~ILSMinResLanczos()
     
 int ILSMinResLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vector & x )
 {
-  if ( b.size() != gm.rows() ) {
-    fthrow(Exception, "Size of vector b (" << b.size() << ") mismatches with the size of the given GenericMatrix (" << gm.rows() << ").");
-  }
-
-  if ( x.size() != gm.cols() )
-  {
-    x.resize(gm.cols());
-    x.set(0.0); // bad initial solution, but whatever
-  }
+  NICE_PROFILE_ZONE ( "ILSMinResLanczos::solveLin" );
+  bool nonZeroInitialization = initSolution ( gm, b, x );
 
 //   if ( verbose ) cerr << "initial solution: " << x << endl;
 
@@ -50,12 +46,29 @@ int ILSMinResLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   // 
   // http://www.netlib.org/templates/templates.pdf
   //
+
+  uint n = b.size();
+  bool usePreconditioner = ( preconditioner != NULL );
+
+  // init some helping vectors, all of them are taken from the workspace of the solver
+  // and updated in-place, such that no memory is allocated within the iterations
+  Vector & Av = workspace.getVector ( 0, n ); // Av = A * v_j
+  // Lanczos vectors q_j = M * v_j of the preconditioned process (q_j = v_j without a preconditioner),
+  // the memory of q_{j-1} is reused for q_{j+1}
+  Vector *q_new = &workspace.getVector ( 1, n ); // q_j
+  Vector *q_next = &workspace.getVector ( 2, n ); // q_{j+1}
+  // Lanczos vectors v_j = M^{-1} q_j (we use the memory of q_j without a preconditioner)
+  Vector *v_new = usePreconditioner ? &workspace.getVector ( 3, n ) : q_new; // new Lanczos vector v_j
+  Vector *v_next = usePreconditioner ? &workspace.getVector ( 4, n ) : q_next; // Lanczos vector of the next iteration: v_{j+1}
+  // update vectors for the solution x, the memory of m_{j-2} is reused for m_j
+  Vector *m_new = &workspace.getVector ( 5, n ); // current update vector m_j for the solution x
+  Vector *m_old = &workspace.getVector ( 6, n ); // update vector m_{j-1} of iteration before
   
   // declare some helpers
   double gamma = 0.0;
   double gamma_bar = 0.0;
   double alpha = 0.0; // alpha_j = v_j^T * A * v_j for new Lanczos vector v_j
-  double beta = b.normL2(); // beta_1 = norm(b), in general beta_j = norm(v_j) for new Lanczos vector v_j
+  double beta = 0.0; // beta_1 = sqrt(r_0^T M^{-1} r_0), i.e. norm(r_0) without a preconditioner
   double beta_next = 0.0; // beta_{j+1}
   double c_new = 0.0;
   double c_old = -1.0;
@@ -65,24 +78,44 @@ int ILSMinResLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   double epsilon_next = 0.0;
   double t_new = 0.0;
 
-  // init some helping vectors
-  Vector Av(b.size(),0.0); // Av = A * v_j
-  Vector Ac(b.size(),0.0); // Ac = A * c_j
-  Vector *v_new = new Vector(b.size(),0.0); // new Lanczos vector v_j
-  Vector *v_old = 0; // Lanczos vector of the iteration before: v_{j-1}
-  Vector *v_next = new Vector(b.size(),0.0); // Lanczos vector of the next iteration: v_{j+1}
-  Vector *m_new = new Vector(x.size(),0.0); // current update vector m_j for the solution x
-  Vector *m_old = new Vector(x.size(),0.0); // update vector m_{j-1} of iteration before
-  Vector *m_older = 0; // update vector m_{j-2} of iteration before
-  
-  // first iteration + initialization, where b will be used as the first Lanczos vector
-  *v_new = (1/beta)*b; // init v_1, v_1 = b / norm(b)
+  // the Lanczos process starts with the initial residual r_0 = b - A * x_0 (r_0 = b for x_0 = 0)
+  *q_new = b;
+  if ( nonZeroInitialization )
+  {
+    gm.multiply ( Av, x );
+    q_new->axpy ( -1.0, Av );
+  }
+
+  // first iteration + initialization, where r_0 will be used as the first Lanczos vector
+  if ( usePreconditioner ) {
+    preconditioner->apply ( *v_new, *q_new );
+    beta = sqrt( q_new->scalarProduct(*v_new) );
+    *v_new *= (1/beta); // init v_1 = M^{-1} r_0 / beta_1
+  } else {
+    beta = q_new->normL2();
+  }
+
+  if ( beta == 0.0 )
+  {
+    // the initial solution already solves the system
+    finishSolution ( x );
+    return 0;
+  }
+
+  *q_new *= (1/beta); // init q_1 = M v_1 (v_1 = r_0 / norm(r_0) without a preconditioner)
   gm.multiply(Av,*v_new); // Av = A * v_1
   alpha = v_new->scalarProduct(Av); // alpha_1 = v_1^T * A * v_1  
   gamma_bar = alpha; // (gamma_bar_1 is equal to alpha_1 in ILSConjugateGradientsLanczos)
-  *v_next = Av - (alpha*(*v_new));
-  beta_next = v_next->normL2();
-  v_next->normalizeL2();
+  *q_next = Av;
+  q_next->axpy ( -alpha, *q_new );
+  if ( usePreconditioner ) {
+    preconditioner->apply ( *v_next, *q_next );
+    beta_next = sqrt( q_next->scalarProduct(*v_next) );
+    *v_next *= (1/beta_next);
+  } else {
+    beta_next = q_next->normL2();
+  }
+  *q_next *= (1/beta_next);
   
   // calculate helpers (equation 5.6 in the paper mentioned above)
   gamma = sqrt( (gamma_bar*gamma_bar) + (beta_next*beta_next) );
@@ -90,9 +123,11 @@ int ILSMinResLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   s_new = beta_next/gamma;
 
   t_new = beta*c_new; // t_1 = beta_1 * c_1
-  *m_new = (1/gamma)*(*v_new); // m_1 = ( 1 / gamma_1 ) * v_1
+  *m_new = *v_new;
+  *m_new *= (1/gamma); // m_1 = ( 1 / gamma_1 ) * v_1
+  m_old->set(0.0); // m_0 = 0
   
-  x = t_new*(*m_new); // first approximation of x
+  x.axpy ( t_new, *m_new ); // first approximation of x
   
   // calculate current residual of x
   double res = (beta*beta)*(s_new*s_new);
@@ -100,10 +135,10 @@ int ILSMinResLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   // calculate delta of x_L
   double delta_x = fabs(t_new) * m_new->normL2();
   if ( verbose ) {
-    cerr << "ILSMinResLanczos: iteration 1 / " << maxIterations << endl;
+    NICE_LOG_DEBUG ( "ILSMinResLanczos: iteration 1 / " << maxIterations );
     if ( x.size() <= 20 )
-      cerr << "ILSMinResLanczos: current solution x: " << x << endl;
-    cerr << "ILSMinResLanczos: delta_x = " << delta_x << endl;
+      NICE_LOG_DEBUG ( "ILSMinResLanczos: current solution x: " << x );
+    NICE_LOG_DEBUG ( "ILSMinResLanczos: delta_x = " << delta_x );
   }
   
   // start with second iteration
@@ -111,24 +146,14 @@ int ILSMinResLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   while (j <= maxIterations )
   {
   
-    // prepare next iteration
-    if ( v_old == 0 ) v_old = v_new;
+    // prepare next iteration: v_{j+1} becomes v_j and the memory of v_{j-1} is used for v_{j+2}
+    std::swap ( q_new, q_next );
+    if ( usePreconditioner )
+      std::swap ( v_new, v_next );
     else {
-      
-      delete v_old;
-      v_old = v_new;
+      v_new = q_new;
+      v_next = q_next;
     }
-    v_new = v_next;
-    v_next = new Vector(b.size(),0.0);
-
-    if ( m_older == 0 ) m_older = m_old;
-    else {
-      
-      delete m_older;
-      m_older = m_old;
-    }     
-    m_old = m_new;
-    m_new = new Vector(x.size(),0.0);
 
     beta = beta_next;
     s_old = s_new;
@@ -138,9 +163,17 @@ int ILSMinResLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
     // calculate next Lanczos vector v_ {j+1} based on older ones
     gm.multiply(Av,*v_new);
     alpha = v_new->scalarProduct(Av);
-    *v_next = Av - (alpha*(*v_new)) - (beta*(*v_old)); // calculate v_{j+1} 
-    beta_next = v_next->normL2(); // calculate beta_{j+1} 
-    v_next->normalizeL2(); // normalize v_{j+1}  
+    // calculate unnormalized q_{j+1} = Av - alpha_j q_j - beta_j q_{j-1} in the memory of q_{j-1}
+    q_next->axpby ( 1.0, Av, -beta );
+    q_next->axpy ( -alpha, *q_new );
+    if ( usePreconditioner ) {
+      preconditioner->apply ( *v_next, *q_next ); // calculate v_{j+1} = M^{-1} q_{j+1}
+      beta_next = sqrt( q_next->scalarProduct(*v_next) ); // calculate beta_{j+1} 
+      *v_next *= (1/beta_next);
+    } else {
+      beta_next = q_next->normL2(); // calculate beta_{j+1} 
+    }
+    *q_next *= (1/beta_next); // normalize q_{j+1}
     
     // calculate elements of matrix L_bar_{j}
     gamma_bar = -c_old*s_new*beta - c_new*alpha; // calculate gamma_bar_{j} 
@@ -157,34 +190,36 @@ int ILSMinResLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
     // calculate t_{j} according to equation 6.7 of the paper mentioned above
     t_new *= s_old*c_new;
     
-    // calculate m_{j}
-    *m_new = (1/gamma)*(*v_new - (delta_new*(*m_old)) - (epsilon_next*(*m_older)) );
+    // calculate m_{j} = ( v_j - delta_j * m_{j-1} - epsilon_j * m_{j-2} ) / gamma_j in the memory of m_{j-2}
+    m_old->axpby ( 1/gamma, *v_new, -epsilon_next/gamma );
+    m_old->axpy ( -delta_new/gamma, *m_new );
+    std::swap ( m_new, m_old );
        
     epsilon_next = s_old*beta_next; // calculate epsilon_{j+1} of matrix L_bar_{j+1}
       
-    x += t_new*(*m_new); // update x
+    x.axpy ( t_new, *m_new ); // update x
 
     // calculate residual of current solution x 
     res *= (s_new*s_new);
     
     if ( verbose ) {
-      cerr << "ILSMinResLanczos: iteration " << j << " / " << maxIterations << endl;
+      NICE_LOG_DEBUG ( "ILSMinResLanczos: iteration " << j << " / " << maxIterations );
       if ( x.size() <= 20 )
       {
-        cerr << "ILSMinResLanczos: current solution x: " << x << endl;
+        NICE_LOG_DEBUG ( "ILSMinResLanczos: current solution x: " << x );
       }
     }
 
     // check convergence
     delta_x = fabs(t_new) * m_new->normL2();
     if ( verbose ) {
-      cerr << "ILSMinResLanczos: delta_x = " << delta_x << endl;
-      cerr << "ILSMinResLanczos: residual = " << res << endl;
+      NICE_LOG_DEBUG ( "ILSMinResLanczos: delta_x = " << delta_x );
+      NICE_LOG_DEBUG ( "ILSMinResLanczos: residual = " << res );
     }  
 
     if ( delta_x < minDelta ) {
       if ( verbose )
-        cerr << "ILSMinResLanczos: small delta_x" << endl;
+        NICE_LOG_DEBUG ( "ILSMinResLanczos: small delta_x" );
       break;
     } 
     
@@ -194,19 +229,13 @@ int ILSMinResLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   // Normally, we do not need this, because the last iteration produces the optimal solution with minimal residual. 
   // However, we will have this outputs equally to the other ILS methods.
 //   if ( verbose ) {
-    cerr << "ILSMinResLanczos: iterations needed: " << std::min<uint>(j,maxIterations) << endl;
-    cerr << "ILSMinResLanczos: minimal residual achieved: " << res << endl;
+    NICE_LOG_DEBUG ( "ILSMinResLanczos: iterations needed: " << std::min<uint>(j,maxIterations) );
+    NICE_LOG_DEBUG ( "ILSMinResLanczos: minimal residual achieved: " << res );
     if ( x.size() <= 20 )
-      cerr << "ILSMinResLanczos: optimal solution: " << x << endl;
+      NICE_LOG_DEBUG ( "ILSMinResLanczos: optimal solution: " << x );
 //   }
   
-  delete v_new;
-  delete v_old;
-  delete v_next;
-  delete m_new;
-  delete m_old;
-  delete m_older;
-  
+  finishSolution ( x );
+
   return 0;
 }
-
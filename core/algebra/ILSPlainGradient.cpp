@@ -10,6 +10,7 @@
 #include "core/optimization/gradientBased/FirstOrderRasmussen.h"
 #include "core/optimization/gradientBased/FirstOrderTrustRegion.h"
 #include "ILSPlainGradient.h"
+#include "core/basics/Profiler.h"
 
 using namespace NICE;
 using namespace std;
@@ -37,6 +38,7 @@ ILSPlainGradient::~ILSPlainGradient()
 
 int ILSPlainGradient::solveLin ( const GenericMatrix & gm, const Vector & b, Vector & x )
 {
+  NICE_PROFILE_ZONE ( "ILSPlainGradient::solveLin" );
   if ( b.size() != gm.rows() ) {
     fthrow(Exception, "Size of vector b mismatches with the size of the given GenericMatrix.");
   }
@@ -48,7 +50,7 @@ int ILSPlainGradient::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   }
 
   // use x as an initial solution
-  ILSPlainGradientOptimizationProblem op ( &gm, b, x, this->minResidual );
+  ILSPlainGradientOptimizationProblem op ( &gm, b, x, this->minResidual, this->preconditioner );
 
   optimizer->optimizeFirst(op);
 
@@ -56,9 +58,10 @@ int ILSPlainGradient::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   return 0;
 }
     
-ILSPlainGradientOptimizationProblem::ILSPlainGradientOptimizationProblem( const GenericMatrix *gm, const Vector & b, const Vector & x0, bool minResidual ) : OptimizationProblemFirst(gm->cols())
+ILSPlainGradientOptimizationProblem::ILSPlainGradientOptimizationProblem( const GenericMatrix *gm, const Vector & b, const Vector & x0, bool minResidual, const Preconditioner *preconditioner ) : OptimizationProblemFirst(gm->cols())
 {
   this->m_gm = gm;
+  this->m_preconditioner = preconditioner;
   this->m_b = b;
   this->parameters() = x0;
   this->minResidual = minResidual;
@@ -75,6 +78,14 @@ double ILSPlainGradientOptimizationProblem::computeObjective()
     // we need to compute A*x-b
     Vector diff ( v_Ax - m_b );
 
+    // ... optionally preconditioned: M^{-1}*(A*x-b)
+    if ( m_preconditioner != NULL )
+    {
+      Vector pdiff;
+      m_preconditioner->apply ( pdiff, diff );
+      diff = pdiff;
+    }
+
     // ... and the quadratic norm
     return 0.5 * diff.scalarProduct(diff);
   } else {
@@ -97,6 +108,15 @@ void ILSPlainGradientOptimizationProblem::computeGradient(Vector& newGradient)
   newGradient.resize ( m_gm->cols() );
   if ( minResidual ) 
   {
+    // computing M^{-1}*M^{-1}*(Ax - b) with a preconditioner
+    // (M is assumed to be symmetric)
+    if ( m_preconditioner != NULL )
+    {
+      Vector pdiff;
+      m_preconditioner->apply ( pdiff, diff );
+      m_preconditioner->apply ( diff, pdiff );
+    }
+
     // computing A*(Ax - b)
     m_gm->multiply ( newGradient, diff );
   } else {
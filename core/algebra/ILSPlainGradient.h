@@ -64,6 +64,9 @@ class ILSPlainGradientOptimizationProblem : public OptimizationProblemFirst
     const GenericMatrix *m_gm;
     Vector m_b;
 
+    //! optional preconditioner (not owned)
+    const Preconditioner *m_preconditioner;
+
     bool minResidual;
 
   public:
@@ -72,8 +75,11 @@ class ILSPlainGradientOptimizationProblem : public OptimizationProblemFirst
     * @brief Constructor
     *
     * @param gm input generic matrix object
+    * @param preconditioner optional preconditioner M, the residual objective is then
+    * changed to $0.5 * \| M^{-1} (A x - b) \|^2$, which has the same minimum. It is
+    * ignored if minResidual is false.
     */
-    ILSPlainGradientOptimizationProblem( const GenericMatrix *gm, const Vector & b, const Vector & x0, bool minResidual = true );
+    ILSPlainGradientOptimizationProblem( const GenericMatrix *gm, const Vector & b, const Vector & x0, bool minResidual = true, const Preconditioner *preconditioner = NULL );
 
     /**
     * @brief Compute the objective
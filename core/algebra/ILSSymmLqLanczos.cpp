@@ -6,8 +6,11 @@
 
 */
 #include <iostream>
+#include <algorithm>
 
 #include "ILSSymmLqLanczos.h"
+#include "core/basics/Profiler.h"
+#include "core/basics/Log.h"
 
 using namespace NICE;
 using namespace std;
@@ -32,15 +35,8 @@ ILSSymmLqLanczos::~ILSSymmLqLanczos()
     
 int ILSSymmLqLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vector & x )
 {
-  if ( b.size() != gm.rows() ) {
-    fthrow(Exception, "Size of vector b (" << b.size() << ") mismatches with the size of the given GenericMatrix (" << gm.rows() << ").");
-  }
-
-  if ( x.size() != gm.cols() )
-  {
-    x.resize(gm.cols());
-    x.set(0.0); // bad initial solution, but whatever
-  }
+  NICE_PROFILE_ZONE ( "ILSSymmLqLanczos::solveLin" );
+  bool nonZeroInitialization = initSolution ( gm, b, x );
 
 //   if ( verbose ) cerr << "initial solution: " << x << endl;
 
@@ -50,12 +46,31 @@ int ILSSymmLqLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   // 
   // http://www.netlib.org/templates/templates.pdf
   //
+
+  uint n = b.size();
+  bool usePreconditioner = ( preconditioner != NULL );
+
+  // init some helping vectors, all of them are taken from the workspace of the solver
+  // and updated in-place, such that no memory is allocated within the iterations
+  Vector & Av = workspace.getVector ( 0, n ); // Av = A * v_j
+  // Lanczos vectors q_j = M * v_j of the preconditioned process (q_j = v_j without a preconditioner),
+  // the memory of q_{j-1} is reused for q_{j+1}
+  Vector *q_new = &workspace.getVector ( 1, n ); // q_j
+  Vector *q_next = &workspace.getVector ( 2, n ); // q_{j+1}
+  // Lanczos vectors v_j = M^{-1} q_j (we use the memory of q_j without a preconditioner)
+  Vector *v_new = usePreconditioner ? &workspace.getVector ( 3, n ) : q_new; // new Lanczos vector v_j
+  Vector *v_next = usePreconditioner ? &workspace.getVector ( 4, n ) : q_next; // Lanczos vector of the next iteration: v_{j+1}
+  Vector & w_new = workspace.getVector ( 5, n ); 
+  Vector & w_bar = workspace.getVector ( 6, n ); 
+  Vector & x_L = workspace.getVector ( 7, n ); 
+//   Vector x_C (b.size(),0.0); // x_C is a much better approximation than x_L (according to the paper mentioned above)
+// NOTE we store x_C in output variable x and only update this solution if the residual decreases (we are able to calculate the residual of x_C without calculating x_C)
   
   // declare some helpers
   double gamma = 0.0;
   double gamma_bar = 0.0;
   double alpha = 0.0; // alpha_j = v_j^T * A * v_j for new Lanczos vector v_j
-  double beta = b.normL2(); // beta_1 = norm(b), in general beta_j = norm(v_j) for new Lanczos vector v_j
+  double beta = 0.0; // beta_1 = sqrt(r_0^T M^{-1} r_0), i.e. norm(r_0) without a preconditioner
   double beta_next = 0.0; // beta_{j+1}
   double c_new = 0.0;
   double c_old = -1.0;
@@ -67,26 +82,44 @@ int ILSSymmLqLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   double delta_new = 0.0;
   double epsilon_next = 0.0;
 
-  // init some helping vectors
-  Vector Av(b.size(),0.0); // Av = A * v_j
-  Vector Ac(b.size(),0.0); // Ac = A * c_j
-  Vector *v_new = new Vector(b.size(),0.0); // new Lanczos vector v_j
-  Vector *v_old = 0; // Lanczos vector of the iteration before: v_{j-1}
-  Vector *v_next = new Vector(b.size(),0.0); // Lanczos vector of the next iteration: v_{j+1}
-  Vector *w_new = new Vector(b.size(),0.0); 
-  Vector *w_bar = new Vector(b.size(),0.0); 
-  Vector x_L (b.size(),0.0); 
-//   Vector x_C (b.size(),0.0); // x_C is a much better approximation than x_L (according to the paper mentioned above)
-// NOTE we store x_C in output variable x and only update this solution if the residual decreases (we are able to calculate the residual of x_C without calculating x_C)
-  
-  // first iteration + initialization, where b will be used as the first Lanczos vector
-  *v_new = (1/beta)*b; // init v_1, v_1 = b / norm(b)
+  // the Lanczos process starts with the initial residual r_0 = b - A * x_0 (r_0 = b for x_0 = 0)
+  *q_new = b;
+  if ( nonZeroInitialization )
+  {
+    gm.multiply ( Av, x );
+    q_new->axpy ( -1.0, Av );
+  }
+
+  // first iteration + initialization, where r_0 will be used as the first Lanczos vector
+  if ( usePreconditioner ) {
+    preconditioner->apply ( *v_new, *q_new );
+    beta = sqrt( q_new->scalarProduct(*v_new) );
+    *v_new *= (1/beta); // init v_1 = M^{-1} r_0 / beta_1
+  } else {
+    beta = q_new->normL2();
+  }
+
+  if ( beta == 0.0 )
+  {
+    // the initial solution already solves the system
+    finishSolution ( x );
+    return 0;
+  }
+
+  *q_new *= (1/beta); // init q_1 = M v_1 (v_1 = r_0 / norm(r_0) without a preconditioner)
   gm.multiply(Av,*v_new); // Av = A * v_1
   alpha = v_new->scalarProduct(Av); // alpha_1 = v_1^T * A * v_1  
   gamma_bar = alpha; // (gamma_bar_1 is equal to alpha_1 in ILSConjugateGradientsLanczos)
-  *v_next = Av - (alpha*(*v_new));
-  beta_next = v_next->normL2();
-  v_next->normalizeL2();
+  *q_next = Av;
+  q_next->axpy ( -alpha, *q_new );
+  if ( usePreconditioner ) {
+    preconditioner->apply ( *v_next, *q_next );
+    beta_next = sqrt( q_next->scalarProduct(*v_next) );
+    *v_next *= (1/beta_next);
+  } else {
+    beta_next = q_next->normL2();
+  }
+  *q_next *= (1/beta_next);
   
   gamma = sqrt( (gamma_bar*gamma_bar) + (beta_next*beta_next) );
   c_new = gamma_bar/gamma;
@@ -94,12 +127,15 @@ int ILSSymmLqLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   
   z_new = beta/gamma;
   
-  *w_bar = *v_new;
+  // w_1 = c_1 * w_bar_1 + s_1 * v_2 and w_bar_2 = s_1 * w_bar_1 - c_1 * v_2 with w_bar_1 = v_1
+  w_new = *v_next;
+  w_new.axpby ( c_new, *v_new, s_new );
+  w_bar = *v_new;
+  w_bar.axpby ( -c_new, *v_next, s_new );
   
-  *w_new = c_new*(*w_bar) + s_new*(*v_next);
-  *w_bar = s_new*(*w_bar) - c_new*(*v_next);
-  
-  x_L = z_new*(*w_new); // first approximation of x
+  // first approximation of x
+  x_L = x;
+  x_L.axpy ( z_new, w_new );
   
   // calculate current residual of x_C
   double res_x_C = (beta*beta)*(s_new*s_new)/(c_new*c_new);
@@ -108,15 +144,16 @@ int ILSSymmLqLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   double res_x_C_min = res_x_C;
   
   // store optimal solution x_C in output variable x instead of additional variable x_C
-  x = x_L + (z_new/c_new)*(*w_bar); // x_C = x_L + (z_new/c_new)*(*w_bar); 
+  x = x_L;
+  x.axpy ( z_new/c_new, w_bar ); // x_C = x_L + (z_new/c_new)*w_bar; 
   
   // calculate delta of x_L
-  double delta_x_L = fabs(z_new) * w_new->normL2();
+  double delta_x_L = fabs(z_new) * w_new.normL2();
   if ( verbose ) {
-    cerr << "ILSSymmLqLanczos: iteration 1 / " << maxIterations << endl;
+    NICE_LOG_DEBUG ( "ILSSymmLqLanczos: iteration 1 / " << maxIterations );
     if ( x.size() <= 20 )
-      cerr << "ILSSymmLqLanczos: current solution x_L: " << x_L << endl;
-    cerr << "ILSSymmLqLanczos: delta_x_L = " << delta_x_L << endl;
+      NICE_LOG_DEBUG ( "ILSSymmLqLanczos: current solution x_L: " << x_L );
+    NICE_LOG_DEBUG ( "ILSSymmLqLanczos: delta_x_L = " << delta_x_L );
   }
   
   // start with second iteration
@@ -124,15 +161,15 @@ int ILSSymmLqLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   while (j <= maxIterations )
   {
   
-    // prepare next iteration
-    if ( v_old == 0 ) v_old = v_new;
+    // prepare next iteration: v_{j+1} becomes v_j and the memory of v_{j-1} is used for v_{j+2}
+    std::swap ( q_new, q_next );
+    if ( usePreconditioner )
+      std::swap ( v_new, v_next );
     else {
-      
-      delete v_old;
-      v_old = v_new;
+      v_new = q_new;
+      v_next = q_next;
     }
-    v_new = v_next;
-    v_next = new Vector(b.size(),0.0);
+
     beta = beta_next;
     z_older = z_old;
     z_old = z_new;
@@ -143,9 +180,17 @@ int ILSSymmLqLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
     // calculate next Lanczos vector v_ {j+1} based on older ones
     gm.multiply(Av,*v_new);
     alpha = v_new->scalarProduct(Av);
-    *v_next = Av - (alpha*(*v_new)) - (beta*(*v_old)); // calculate v_{j+1} 
-    beta_next = v_next->normL2(); // calculate beta_{j+1} 
-    v_next->normalizeL2(); // normalize v_{j+1}  
+    // calculate unnormalized q_{j+1} = Av - alpha_j q_j - beta_j q_{j-1} in the memory of q_{j-1}
+    q_next->axpby ( 1.0, Av, -beta );
+    q_next->axpy ( -alpha, *q_new );
+    if ( usePreconditioner ) {
+      preconditioner->apply ( *v_next, *q_next ); // calculate v_{j+1} = M^{-1} q_{j+1}
+      beta_next = sqrt( q_next->scalarProduct(*v_next) ); // calculate beta_{j+1} 
+      *v_next *= (1/beta_next);
+    } else {
+      beta_next = q_next->normL2(); // calculate beta_{j+1} 
+    }
+    *q_next *= (1/beta_next); // normalize q_{j+1}
     
     // calculate elements of matrix L_bar_{j}
     gamma_bar = -c_old*s_new*beta - c_new*alpha; // calculate gamma_bar_{j} 
@@ -171,32 +216,34 @@ int ILSSymmLqLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
     // we only update our solution x (originally x_C ) if the residual is smaller
     if ( res_x_C < res_x_C_min ) 
     {
-      x = x_L + (z_new/c_new)*(*w_bar);  // x_C = x_L + (z_new/c_new)*(*w_bar); // update x
+      x = x_L;
+      x.axpy ( z_new/c_new, w_bar );  // x_C = x_L + (z_new/c_new)*w_bar; // update x
       res_x_C_min = res_x_C;
     }
         
     // calculate new vectors w_{j} and w_bar_{j+1} according to equation 5.9 of the paper mentioned above
-    *w_new = c_new*(*w_bar) + s_new*(*v_next);
-    *w_bar = s_new*(*w_bar) - c_new*(*v_next);
+    w_new = *v_next;
+    w_new.axpby ( c_new, w_bar, s_new ); // w_j = c_j * w_bar_j + s_j * v_{j+1}
+    w_bar.axpby ( -c_new, *v_next, s_new ); // w_bar_{j+1} = s_j * w_bar_j - c_j * v_{j+1}
    
-    x_L += z_new*(*w_new); // update x_L
+    x_L.axpy ( z_new, w_new ); // update x_L
         
     if ( verbose ) {
-      cerr << "ILSSymmLqLanczos: iteration " << j << " / " << maxIterations << endl;
+      NICE_LOG_DEBUG ( "ILSSymmLqLanczos: iteration " << j << " / " << maxIterations );
       if ( x.size() <= 20 )
-        cerr << "ILSSymmLqLanczos: current solution x_L: " << x_L << endl;
+        NICE_LOG_DEBUG ( "ILSSymmLqLanczos: current solution x_L: " << x_L );
     }
 
     // check convergence
-    delta_x_L = fabs(z_new) * w_new->normL2();
+    delta_x_L = fabs(z_new) * w_new.normL2();
     if ( verbose ) {
-      cerr << "ILSSymmLqLanczos: delta_x_L = " << delta_x_L << endl;
-      cerr << "ILSSymmLqLanczos: residual = " << res_x_C << endl;
+      NICE_LOG_DEBUG ( "ILSSymmLqLanczos: delta_x_L = " << delta_x_L );
+      NICE_LOG_DEBUG ( "ILSSymmLqLanczos: residual = " << res_x_C );
     }  
 
     if ( delta_x_L < minDelta ) {
       if ( verbose )
-        cerr << "ILSSymmLqLanczos: small delta_x_L" << endl;
+        NICE_LOG_DEBUG ( "ILSSymmLqLanczos: small delta_x_L" );
       break;
     } 
     
@@ -204,10 +251,10 @@ int ILSSymmLqLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
   }
   
 //   if ( verbose ) {
-    cerr << "ILSSymmLqLanczos: iterations needed: " << std::min<uint>(j,maxIterations) << endl;
-    cerr << "ILSSymmLqLanczos: minimal residual achieved: " << res_x_C_min << endl;
+    NICE_LOG_DEBUG ( "ILSSymmLqLanczos: iterations needed: " << std::min<uint>(j,maxIterations) );
+    NICE_LOG_DEBUG ( "ILSSymmLqLanczos: minimal residual achieved: " << res_x_C_min );
     if ( x.size() <= 20 )
-      cerr << "ILSSymmLqLanczos: optimal solution: " << x << endl;
+      NICE_LOG_DEBUG ( "ILSSymmLqLanczos: optimal solution: " << x );
 //   }
   
 //  WE DO NOT WANT TO CALCULATE THE RESIDUAL EXPLICITLY  
@@ -236,12 +283,7 @@ int ILSSymmLqLanczos::solveLin ( const GenericMatrix & gm, const Vector & b, Vec
 //     
 //   }
    
-  delete v_new;
-  delete v_old;
-  delete v_next;
-  delete w_new;
-  delete w_bar;
-  
+  finishSolution ( x );
+
   return 0;
 }
-
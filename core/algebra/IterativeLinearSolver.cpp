@@ -14,9 +14,65 @@ using namespace NICE;
 
 IterativeLinearSolver::IterativeLinearSolver()
 {
+  this->preconditioner = NULL;
+  this->warmStart = false;
 }
 
 IterativeLinearSolver::~IterativeLinearSolver()
 {
 }
 
+
+void IterativeLinearSolver::setPreconditioner ( const Preconditioner *preconditioner )
+{
+  this->preconditioner = preconditioner;
+}
+
+void IterativeLinearSolver::applyPreconditioner ( Vector & z, const Vector & r ) const
+{
+  if ( preconditioner == NULL )
+  {
+    z.resize ( r.size() );
+    z = r;
+  } else {
+    if ( preconditioner->size() != r.size() )
+      fthrow(Exception, "Size of the preconditioner (" << preconditioner->size() << ") mismatches with the size of the system (" << r.size() << ").");
+    preconditioner->apply ( z, r );
+  }
+}
+
+void IterativeLinearSolver::setWarmStart ( bool warmStart )
+{
+  this->warmStart = warmStart;
+}
+
+void IterativeLinearSolver::clearWorkspace ()
+{
+  workspace.clear();
+}
+
+bool IterativeLinearSolver::initSolution ( const GenericMatrix & gm, const Vector & b, Vector & x )
+{
+  if ( b.size() != gm.rows() ) {
+    fthrow(Exception, "Size of vector b (" << b.size() << ") mismatches with the size of the given GenericMatrix (" << gm.rows() << ").");
+  }
+
+  if ( x.size() == gm.cols() )
+    return ( x.normInf() > 0.0 );
+
+  x.resize ( gm.cols() );
+  if ( warmStart && ( workspace.getLastSolution().size() == gm.cols() ) )
+  {
+    x = workspace.getLastSolution();
+    return true;
+  }
+
+  x.set(0.0); // bad initial solution, but whatever
+  return false;
+}
+
+void IterativeLinearSolver::finishSolution ( const Vector & x )
+{
+  if ( warmStart )
+    workspace.setLastSolution ( x );
+}
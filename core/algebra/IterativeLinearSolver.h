@@ -9,6 +9,8 @@
 
 #include "core/vector/VectorT.h"
 #include "GenericMatrix.h"
+#include "Preconditioner.h"
+#include "SolverWorkspace.h"
 
 namespace NICE {
   
@@ -22,6 +24,39 @@ class IterativeLinearSolver
 
     protected:
 
+    //! preconditioner M used by the solver (not owned), NULL means M = I
+    const Preconditioner *preconditioner;
+
+    /**
+    * @brief apply the preconditioner: z = M^{-1} * r (or z = r without a preconditioner)
+    *
+    * @param z output vector
+    * @param r input vector
+    */
+    void applyPreconditioner ( Vector & z, const Vector & r ) const;
+
+    //! work vectors reused across calls of solveLin
+    SolverWorkspace workspace;
+
+    //! use the last solution as initial estimate if no estimate is given
+    bool warmStart;
+
+    /**
+    * @brief check the sizes of the system and prepare the initial estimate:
+    * x is kept if its size is correct, otherwise the last solution is used
+    * (warm start enabled) or x is set to zero
+    *
+    * @param gm GenericMatrix of the system
+    * @param b right hand side of the system
+    * @param x initial estimate
+    *
+    * @return true if x is non-zero and the initial residual has to be computed
+    */
+    bool initSolution ( const GenericMatrix & gm, const Vector & b, Vector & x );
+
+    /** remember the solution for the next call if warm start is enabled */
+    void finishSolution ( const Vector & x );
+
     public:
 
 		/** simple constructor */
@@ -41,6 +76,33 @@ class IterativeLinearSolver
     * @return method specific status information
     */
     virtual int solveLin ( const GenericMatrix & gm, const Vector & b, Vector & x ) = 0;
+
+    /**
+    * @brief set a preconditioner M, which should approximate A and has to be
+    * symmetric and positive definite. The object is not copied and has to be
+    * available during all subsequent calls of solveLin.
+    *
+    * @param preconditioner preconditioner object or NULL to disable preconditioning
+    */
+    virtual void setPreconditioner ( const Preconditioner *preconditioner );
+
+    /**
+    * @brief enable or disable warm starts: if enabled, the solution of the last
+    * call is used as initial estimate whenever solveLin is called with an
+    * x of improper size (e.g. an empty vector)
+    *
+    * @param warmStart
+    */
+    void setWarmStart ( bool warmStart = true );
+
+    /** release the memory of all work vectors and the stored solution */
+    void clearWorkspace ();
+
+    /** get the current preconditioner (NULL if none is used) */
+    const Preconditioner *getPreconditioner () const
+    {
+      return preconditioner;
+    };
 };
 
 }
@@ -0,0 +1,87 @@
+/**
+* @file KernelFunction.cpp
+* @brief kernel functions evaluated on raw feature vectors
+* @date 10/19/2026
+
+*/
+#include <cmath>
+#include <algorithm>
+
+#include <core/vector/SimdKernels.h>
+
+#include "KernelFunction.h"
+
+using namespace NICE;
+using namespace std;
+
+double KFLinear::evaluate ( const double *x, const double *y, uint d ) const
+{
+  double s = 0.0;
+  for ( uint i = 0 ; i < d ; i++ )
+    s += x[i] * y[i];
+  return s;
+}
+
+void KFLinear::evaluateRow ( const double *x, const double *Y, uint ny, uint d, double *k ) const
+{
+  for ( uint j = 0 ; j < ny ; j++, Y += d )
+    k[j] = SimdKernels::dot ( x, Y, d );
+}
+
+double KFRBF::evaluate ( const double *x, const double *y, uint d ) const
+{
+  double s = 0.0;
+  for ( uint i = 0 ; i < d ; i++ )
+  {
+    double diff = x[i] - y[i];
+    s += diff * diff;
+  }
+  return exp ( - gamma * s );
+}
+
+void KFRBF::evaluateRow ( const double *x, const double *Y, uint ny, uint d, double *k ) const
+{
+  // the difference is computed explicitly to avoid the cancellation
+  // of |x|^2 + |y|^2 - 2 x^T y, and accumulated without a temporary
+  for ( uint j = 0 ; j < ny ; j++, Y += d )
+  {
+    double s = 0.0;
+    for ( uint i = 0 ; i < d ; i++ )
+    {
+      double diff = x[i] - Y[i];
+      s += diff * diff;
+    }
+    k[j] = exp ( - gamma * s );
+  }
+}
+
+double KFChi2::evaluate ( const double *x, const double *y, uint d ) const
+{
+  double s = 0.0;
+  for ( uint i = 0 ; i < d ; i++ )
+  {
+    double sum = x[i] + y[i];
+    if ( sum > 0.0 )
+      s += 2.0 * x[i] * y[i] / sum;
+  }
+  return s;
+}
+
+double KFIntersection::evaluate ( const double *x, const double *y, uint d ) const
+{
+  double s = 0.0;
+  for ( uint i = 0 ; i < d ; i++ )
+    s += std::min ( x[i], y[i] );
+  return s;
+}
+
+void KFIntersection::evaluateRow ( const double *x, const double *Y, uint ny, uint d, double *k ) const
+{
+  for ( uint j = 0 ; j < ny ; j++, Y += d )
+  {
+    double s = 0.0;
+    for ( uint i = 0 ; i < d ; i++ )
+      s += ( x[i] < Y[i] ) ? x[i] : Y[i];
+    k[j] = s;
+  }
+}
@@ -0,0 +1,87 @@
+/**
+* @file KernelFunction.h
+* @brief kernel functions evaluated on raw feature vectors
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_KERNELFUNCTIONINCLUDE
+#define _NICE_KERNELFUNCTIONINCLUDE
+
+#include "core/basics/types.h"
+
+namespace NICE {
+
+/** @class KernelFunction
+ * Abstract kernel function k(x,y) of two feature vectors given as plain arrays
+ * of length d. Kernel matrices computed on the fly (e.g. GMKernel) call
+ * evaluateRow for a whole row of a tile, such that the implementations work on
+ * contiguous memory and can use the vectorized reductions of SimdKernels.
+ * Kernel functions have to be symmetric, k(x,y) = k(y,x).
+ */
+class KernelFunction
+{
+  public:
+
+    /** simple destructor */
+    virtual ~KernelFunction () {};
+
+    /** evaluate the kernel function k(x,y) */
+    virtual double evaluate ( const double *x, const double *y, uint d ) const = 0;
+
+    /**
+    * @brief evaluate a row of the kernel matrix: k[j] = k(x, Y_j) for j = 0, ..., ny-1
+    *
+    * @param x first feature vector
+    * @param Y ny feature vectors stored contiguously, i.e. Y_j = Y + j*d
+    * @param ny number of feature vectors in Y
+    * @param d dimension of the feature vectors
+    * @param k resulting kernel values (ny elements)
+    */
+    virtual void evaluateRow ( const double *x, const double *Y, uint ny, uint d, double *k ) const
+    {
+      for ( uint j = 0 ; j < ny ; j++ )
+        k[j] = evaluate ( x, Y + j * d, d );
+    };
+};
+
+/** linear kernel k(x,y) = x^T y */
+class KFLinear : public KernelFunction
+{
+  public:
+    virtual double evaluate ( const double *x, const double *y, uint d ) const;
+    virtual void evaluateRow ( const double *x, const double *Y, uint ny, uint d, double *k ) const;
+};
+
+/** Gaussian RBF kernel k(x,y) = exp( - gamma * ||x-y||^2 ) */
+class KFRBF : public KernelFunction
+{
+  protected:
+    double gamma;
+
+  public:
+    KFRBF ( double gamma = 1.0 ) : gamma ( gamma ) {};
+
+    double getGamma () const { return gamma; };
+
+    virtual double evaluate ( const double *x, const double *y, uint d ) const;
+    virtual void evaluateRow ( const double *x, const double *Y, uint ny, uint d, double *k ) const;
+};
+
+/** additive chi^2 kernel k(x,y) = \sum_i 2 x_i y_i / ( x_i + y_i ) for non-negative features (histograms) */
+class KFChi2 : public KernelFunction
+{
+  public:
+    virtual double evaluate ( const double *x, const double *y, uint d ) const;
+};
+
+/** histogram intersection kernel k(x,y) = \sum_i min( x_i, y_i ) */
+class KFIntersection : public KernelFunction
+{
+  public:
+    virtual double evaluate ( const double *x, const double *y, uint d ) const;
+    virtual void evaluateRow ( const double *x, const double *Y, uint ny, uint d, double *k ) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,82 @@
+/**
+* @file PCBlockJacobi.cpp
+* @brief block-Jacobi preconditioner using Cholesky factors of the diagonal blocks
+* @date 10/19/2026
+
+*/
+#include <core/basics/Exception.h>
+#include "core/vector/Algorithms.h"
+
+#include "CholeskyRobustAuto.h"
+#include "PCBlockJacobi.h"
+
+using namespace NICE;
+using namespace std;
+
+PCBlockJacobi::PCBlockJacobi ( const PartialGenericMatrix & gm, uint blockSize )
+{
+  if ( gm.rows() != gm.cols() )
+    fthrow(Exception, "PCBlockJacobi: the matrix has to be quadratic (" << gm.rows() << " x " << gm.cols() << ").");
+  if ( blockSize == 0 )
+    fthrow(Exception, "PCBlockJacobi: the block size has to be positive.");
+
+  m_size = gm.rows();
+  m_blockSize = blockSize;
+
+  CholeskyRobustAuto cra ( false /*verbose*/ );
+
+  for ( uint start = 0 ; start < m_size ; start += m_blockSize )
+  {
+    uint n = std::min ( m_blockSize, m_size - start );
+
+    PartialGenericMatrix::SetType block;
+    for ( uint i = 0 ; i < n ; i++ )
+      block.push_back ( start + i );
+
+    // extract the diagonal block column by column
+    Matrix Ablock ( n, n );
+    Vector e ( n, 0.0 );
+    Vector column;
+    for ( uint j = 0 ; j < n ; j++ )
+    {
+      e[j] = 1.0;
+      gm.multiply ( block, block, column, e );
+      e[j] = 0.0;
+      for ( uint i = 0 ; i < n ; i++ )
+        Ablock(i, j) = column[i];
+    }
+
+    m_choleskyFactors.push_back ( Matrix() );
+    cra.robustChol ( Ablock, m_choleskyFactors.back() );
+  }
+}
+
+PCBlockJacobi::~PCBlockJacobi()
+{
+}
+
+void PCBlockJacobi::apply ( Vector & y, const Vector & x ) const
+{
+  if ( x.size() != m_size )
+    fthrow(Exception, "PCBlockJacobi::apply: size of the vector (" << x.size() << ") mismatches with the size of the preconditioner (" << m_size << ").");
+
+  y.resize ( m_size );
+
+  Vector xBlock;
+  Vector yBlock;
+  uint start = 0;
+  for ( vector<Matrix>::const_iterator G = m_choleskyFactors.begin(); G != m_choleskyFactors.end(); G++ )
+  {
+    uint n = G->rows();
+    xBlock.resize ( n );
+    for ( uint i = 0 ; i < n ; i++ )
+      xBlock[i] = x[start + i];
+
+    choleskySolveLargeScale ( *G, xBlock, yBlock );
+
+    for ( uint i = 0 ; i < n ; i++ )
+      y[start + i] = yBlock[i];
+
+    start += n;
+  }
+}
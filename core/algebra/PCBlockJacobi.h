@@ -0,0 +1,60 @@
+/**
+* @file PCBlockJacobi.h
+* @brief block-Jacobi preconditioner using Cholesky factors of the diagonal blocks
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_PCBLOCKJACOBIINCLUDE
+#define _NICE_PCBLOCKJACOBIINCLUDE
+
+#include <vector>
+
+#include "core/vector/MatrixT.h"
+#include "Preconditioner.h"
+
+namespace NICE {
+
+/** @class PCBlockJacobi
+ * Block-Jacobi preconditioner: M consists of the diagonal blocks of A, which
+ * are factorized once with CholeskyRobustAuto. The diagonal blocks are
+ * extracted with the sub-matrix multiplication of PartialGenericMatrix, therefore
+ * the full matrix is never needed.
+ */
+class PCBlockJacobi : public Preconditioner
+{
+  protected:
+    //! size of the system
+    uint m_size;
+
+    //! maximum size of a single block
+    uint m_blockSize;
+
+    //! Cholesky factors (lower triangle) of all diagonal blocks
+    std::vector<NICE::Matrix> m_choleskyFactors;
+
+  public:
+
+    /**
+    * @brief constructor computing the Cholesky factors of all diagonal blocks
+    *
+    * @param gm symmetric and positive definite matrix
+    * @param blockSize size of the diagonal blocks (the last block might be smaller)
+    */
+    PCBlockJacobi ( const PartialGenericMatrix & gm, uint blockSize = 50 );
+
+    /** simple destructor */
+    virtual ~PCBlockJacobi ();
+
+    /** y = M^{-1} * x */
+    virtual void apply ( NICE::Vector & y, const NICE::Vector & x ) const;
+
+    /** get the number of rows (and columns) of M */
+    virtual uint size () const
+    {
+      return m_size;
+    };
+};
+
+}
+
+#endif
@@ -0,0 +1,141 @@
+/**
+* @file PCIncompleteCholesky.cpp
+* @brief incomplete Cholesky preconditioner for sparse matrices
+* @date 10/19/2026
+
+*/
+#include <algorithm>
+#include <cmath>
+
+#include <core/basics/Exception.h>
+
+#include "PCIncompleteCholesky.h"
+
+using namespace NICE;
+using namespace std;
+
+PCIncompleteCholesky::PCIncompleteCholesky ( const GMSparse & gm, double initialShift )
+{
+  if ( gm.rows() != gm.cols() )
+    fthrow(Exception, "PCIncompleteCholesky: the matrix has to be quadratic (" << gm.rows() << " x " << gm.cols() << ").");
+
+  uint n = gm.rows();
+
+  // collect the strictly lower triangle row-wise and the diagonal separately
+  vector<SparseRow> lowerA ( n );
+  Vector diagA ( n, 0.0 );
+  const vector< triplet<int, int, double> > & entries = gm.getEntries();
+  for ( vector< triplet<int, int, double> >::const_iterator k = entries.begin(); k != entries.end(); k++ )
+  {
+    if ( k->first == k->second )
+      diagA[ k->first ] += k->third;
+    else if ( k->second < k->first )
+      lowerA[ k->first ].push_back ( pair<int, double> ( k->second, k->third ) );
+  }
+
+  // sort all rows and merge duplicate entries
+  for ( uint i = 0 ; i < n ; i++ )
+  {
+    SparseRow & row = lowerA[i];
+    sort ( row.begin(), row.end() );
+    SparseRow merged;
+    for ( SparseRow::const_iterator j = row.begin(); j != row.end(); j++ )
+    {
+      if ( !merged.empty() && merged.back().first == j->first )
+        merged.back().second += j->second;
+      else
+        merged.push_back ( *j );
+    }
+    row.swap ( merged );
+  }
+
+  double maxDiag = ( n > 0 ) ? diagA.Max() : 0.0;
+  if ( maxDiag <= 0.0 )
+    maxDiag = 1.0;
+
+  m_shift = 0.0;
+  while ( !factorize ( lowerA, diagA, m_shift ) )
+  {
+    m_shift = ( m_shift == 0.0 ) ? initialShift * maxDiag : 10.0 * m_shift;
+    if ( m_shift > 1e10 * maxDiag )
+      fthrow(Exception, "PCIncompleteCholesky: unable to compute a stable factorization.");
+  }
+}
+
+PCIncompleteCholesky::~PCIncompleteCholesky()
+{
+}
+
+bool PCIncompleteCholesky::factorize ( const vector<SparseRow> & lowerA, const Vector & diagA, double shift )
+{
+  uint n = diagA.size();
+  m_L.assign ( n, SparseRow() );
+  m_diagonal.resize ( n );
+
+  for ( uint i = 0 ; i < n ; i++ )
+  {
+    SparseRow & Li = m_L[i];
+    Li.reserve ( lowerA[i].size() );
+
+    double d = diagA[i] + shift;
+    for ( SparseRow::const_iterator a = lowerA[i].begin(); a != lowerA[i].end(); a++ )
+    {
+      const int k = a->first;
+      const SparseRow & Lk = m_L[k];
+
+      // s = a_ik - sum_{j<k} L_ij * L_kj restricted to the sparsity pattern,
+      // the already computed part of row i only contains columns < k
+      double s = a->second;
+      SparseRow::const_iterator p = Li.begin();
+      SparseRow::const_iterator q = Lk.begin();
+      while ( p != Li.end() && q != Lk.end() )
+      {
+        if ( p->first < q->first ) p++;
+        else if ( q->first < p->first ) q++;
+        else {
+          s -= p->second * q->second;
+          p++;
+          q++;
+        }
+      }
+
+      double lik = s / m_diagonal[k];
+      Li.push_back ( pair<int, double> ( k, lik ) );
+      d -= lik * lik;
+    }
+
+    if ( !(d > 0.0) )
+      return false;
+
+    m_diagonal[i] = sqrt ( d );
+  }
+
+  return true;
+}
+
+void PCIncompleteCholesky::apply ( Vector & y, const Vector & x ) const
+{
+  uint n = m_diagonal.size();
+  if ( x.size() != n )
+    fthrow(Exception, "PCIncompleteCholesky::apply: size of the vector (" << x.size() << ") mismatches with the size of the preconditioner (" << n << ").");
+
+  y.resize ( n );
+
+  // forward substitution: L * z = x
+  for ( uint i = 0 ; i < n ; i++ )
+  {
+    double s = x[i];
+    for ( SparseRow::const_iterator k = m_L[i].begin(); k != m_L[i].end(); k++ )
+      s -= k->second * y[ k->first ];
+    y[i] = s / m_diagonal[i];
+  }
+
+  // backward substitution: L^T * y = z, we use the rows of L as columns of L^T
+  for ( int i = (int)n - 1 ; i >= 0 ; i-- )
+  {
+    y[i] /= m_diagonal[i];
+    const double yi = y[i];
+    for ( SparseRow::const_iterator k = m_L[i].begin(); k != m_L[i].end(); k++ )
+      y[ k->first ] -= k->second * yi;
+  }
+}
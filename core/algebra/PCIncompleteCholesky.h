@@ -0,0 +1,71 @@
+/**
+* @file PCIncompleteCholesky.h
+* @brief incomplete Cholesky preconditioner for sparse matrices
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_PCINCOMPLETECHOLESKYINCLUDE
+#define _NICE_PCINCOMPLETECHOLESKYINCLUDE
+
+#include <vector>
+#include <utility>
+
+#include "GenericMatrix.h"
+#include "Preconditioner.h"
+
+namespace NICE {
+
+/** @class PCIncompleteCholesky
+ * Incomplete Cholesky preconditioner IC(0) for a symmetric sparse matrix A:
+ * M = L*L^T, where L has the same sparsity pattern as the lower triangle of A.
+ * If the factorization breaks down (non-positive pivot), a multiple of the
+ * identity is added to A and the factorization is repeated with an increasing shift.
+ */
+class PCIncompleteCholesky : public Preconditioner
+{
+  protected:
+    typedef std::vector< std::pair<int, double> > SparseRow;
+
+    //! strictly lower triangle of L stored row-wise with increasing column indices
+    std::vector<SparseRow> m_L;
+
+    //! diagonal elements of L
+    NICE::Vector m_diagonal;
+
+    //! shift finally added to the diagonal of A
+    double m_shift;
+
+    bool factorize ( const std::vector<SparseRow> & lowerA, const NICE::Vector & diagA, double shift );
+
+  public:
+
+    /**
+    * @brief constructor computing the incomplete factorization
+    *
+    * @param gm symmetric sparse matrix (only the lower triangle is used)
+    * @param initialShift relative shift (w.r.t. the largest diagonal element) used after a first breakdown
+    */
+    PCIncompleteCholesky ( const GMSparse & gm, double initialShift = 1e-3 );
+
+    /** simple destructor */
+    virtual ~PCIncompleteCholesky ();
+
+    /** y = M^{-1} * x = L^{-T} L^{-1} x */
+    virtual void apply ( NICE::Vector & y, const NICE::Vector & x ) const;
+
+    /** get the number of rows (and columns) of M */
+    virtual uint size () const
+    {
+      return m_diagonal.size();
+    };
+
+    /** get the shift added to the diagonal to obtain a stable factorization */
+    double getShift () const
+    {
+      return m_shift;
+    };
+};
+
+}
+
+#endif
@@ -0,0 +1,119 @@
+/**
+* @file PCNystroem.cpp
+* @brief low-rank Nystroem preconditioner for dense kernel matrices
+* @date 10/19/2026
+
+*/
+#include <cmath>
+
+#include <core/basics/Exception.h>
+#include "core/vector/Algorithms.h"
+
+#include "PCNystroem.h"
+
+using namespace NICE;
+using namespace std;
+
+PCNystroem::PCNystroem ( const PartialGenericMatrix & gm, uint rank, double lambda, double tolerance )
+{
+  if ( gm.rows() != gm.cols() )
+    fthrow(Exception, "PCNystroem: the matrix has to be quadratic (" << gm.rows() << " x " << gm.cols() << ").");
+
+  uint n = gm.rows();
+  rank = std::min ( rank, n );
+
+  // remaining diagonal of A - G*G^T
+  Vector d ( n );
+  for ( uint i = 0 ; i < n ; i++ )
+    d[i] = gm.getDiagonalElement ( i );
+  double trace = d.Sum();
+
+  PartialGenericMatrix::SetType wholeSet;
+  for ( uint i = 0 ; i < n ; i++ )
+    wholeSet.push_back ( i );
+
+  Matrix G ( n, rank, 0.0 );
+  PartialGenericMatrix::SetType pivotSet ( 1 );
+  Vector one ( 1, 1.0 );
+  Vector column;
+  uint k = 0;
+  for ( ; k < rank ; k++ )
+  {
+    // greedy selection of the next landmark
+    int pivot = d.MaxIndex();
+    double dpivot = d[pivot];
+    if ( (dpivot <= 0.0) || (d.Sum() <= tolerance * trace) )
+      break;
+
+    // column of A corresponding to the pivot
+    pivotSet[0] = pivot;
+    gm.multiply ( wholeSet, pivotSet, column, one );
+
+    // g_k = ( A(:,pivot) - G(:,0:k-1) * G(pivot,0:k-1)^T ) / sqrt(d_pivot)
+    for ( uint j = 0 ; j < k ; j++ )
+    {
+      double gpj = G(pivot, j);
+      for ( uint i = 0 ; i < n ; i++ )
+        column[i] -= G(i, j) * gpj;
+    }
+    double scale = 1.0 / sqrt ( dpivot );
+    for ( uint i = 0 ; i < n ; i++ )
+    {
+      G(i, k) = column[i] * scale;
+      d[i] -= G(i, k) * G(i, k);
+    }
+    // avoid selecting the same element twice due to round-off errors
+    d[pivot] = 0.0;
+  }
+
+  // keep only the columns we computed
+  m_G.resize ( n, k );
+  for ( uint j = 0 ; j < k ; j++ )
+    for ( uint i = 0 ; i < n ; i++ )
+      m_G(i, j) = G(i, j);
+
+  if ( lambda > 0.0 )
+  {
+    m_lambda = lambda;
+  } else {
+    double remaining = 0.0;
+    for ( uint i = 0 ; i < n ; i++ )
+      remaining += std::max ( d[i], 0.0 );
+    m_lambda = std::max ( remaining / n, 1e-10 * trace / n );
+  }
+
+  if ( k > 0 )
+  {
+    // Cholesky factor of lambda*I + G^T*G for the Woodbury identity
+    Matrix inner ( k, k );
+    inner.multiply ( m_G, m_G, true /*transpose*/, false );
+    inner.addIdentity ( m_lambda );
+    choleskyDecompLargeScale ( inner, m_choleskyInner );
+  }
+}
+
+PCNystroem::~PCNystroem()
+{
+}
+
+void PCNystroem::apply ( Vector & y, const Vector & x ) const
+{
+  if ( x.size() != m_G.rows() )
+    fthrow(Exception, "PCNystroem::apply: size of the vector (" << x.size() << ") mismatches with the size of the preconditioner (" << m_G.rows() << ").");
+
+  // M^{-1} x = ( x - G * (lambda*I + G^T*G)^{-1} * G^T * x ) / lambda
+  y.resize ( x.size() );
+  if ( m_G.cols() == 0 )
+  {
+    y = x;
+  } else {
+    Vector t;
+    t.multiply ( m_G, x, true /*transpose*/ );
+    Vector u;
+    choleskySolveLargeScale ( m_choleskyInner, t, u );
+    y.multiply ( m_G, u );
+    for ( uint i = 0 ; i < x.size() ; i++ )
+      y[i] = x[i] - y[i];
+  }
+  y /= m_lambda;
+}
@@ -0,0 +1,75 @@
+/**
+* @file PCNystroem.h
+* @brief low-rank Nystroem preconditioner for dense kernel matrices
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_PCNYSTROEMINCLUDE
+#define _NICE_PCNYSTROEMINCLUDE
+
+#include "core/vector/MatrixT.h"
+#include "Preconditioner.h"
+
+namespace NICE {
+
+/** @class PCNystroem
+ * Low-rank Nystroem preconditioner for (regularized) kernel matrices:
+ * M = G*G^T + lambda*I, where G (n x rank) is obtained by a pivoted partial
+ * Cholesky decomposition of A. The pivots are chosen greedily by the largest
+ * remaining diagonal element, which is the Nystroem approximation with the
+ * pivots used as landmarks. Only the diagonal and rank columns of A are accessed.
+ * M^{-1} is applied with the Woodbury identity in O(n*rank).
+ */
+class PCNystroem : public Preconditioner
+{
+  protected:
+    //! low-rank factor of the Nystroem approximation (n x rank)
+    NICE::Matrix m_G;
+
+    //! Cholesky factor of lambda*I + G^T*G (rank x rank)
+    NICE::Matrix m_choleskyInner;
+
+    //! regularization lambda
+    double m_lambda;
+
+  public:
+
+    /**
+    * @brief constructor computing the low-rank approximation
+    *
+    * @param gm symmetric and positive definite (kernel) matrix
+    * @param rank maximum number of landmarks
+    * @param lambda regularization added to the low-rank approximation, if lambda <= 0
+    * the mean of the diagonal not explained by the low-rank approximation is used
+    * @param tolerance stop selecting landmarks if the remaining trace falls below tolerance times the trace of A
+    */
+    PCNystroem ( const PartialGenericMatrix & gm, uint rank = 100, double lambda = 0.0, double tolerance = 1e-10 );
+
+    /** simple destructor */
+    virtual ~PCNystroem ();
+
+    /** y = M^{-1} * x */
+    virtual void apply ( NICE::Vector & y, const NICE::Vector & x ) const;
+
+    /** get the number of rows (and columns) of M */
+    virtual uint size () const
+    {
+      return m_G.rows();
+    };
+
+    /** get the rank of the low-rank approximation */
+    uint getRank () const
+    {
+      return m_G.cols();
+    };
+
+    /** get the regularization used */
+    double getLambda () const
+    {
+      return m_lambda;
+    };
+};
+
+}
+
+#endif
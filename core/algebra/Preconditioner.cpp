@@ -0,0 +1,49 @@
+/**
+* @file Preconditioner.cpp
+* @brief interface for preconditioners used by iterative linear solvers
+* @date 10/19/2026
+
+*/
+#include <core/basics/Exception.h>
+
+#include "Preconditioner.h"
+
+using namespace NICE;
+using namespace std;
+
+PCJacobi::PCJacobi ( const Vector & diagonal )
+{
+  m_invDiagonal.resize ( diagonal.size() );
+  for ( uint i = 0 ; i < diagonal.size() ; i++ )
+  {
+    if ( diagonal[i] == 0.0 )
+      fthrow(Exception, "PCJacobi: diagonal element " << i << " is zero.");
+    m_invDiagonal[i] = 1.0 / diagonal[i];
+  }
+}
+
+PCJacobi::PCJacobi ( const PartialGenericMatrix & gm )
+{
+  m_invDiagonal.resize ( gm.rows() );
+  for ( uint i = 0 ; i < gm.rows() ; i++ )
+  {
+    double d = gm.getDiagonalElement ( i );
+    if ( d == 0.0 )
+      fthrow(Exception, "PCJacobi: diagonal element " << i << " is zero.");
+    m_invDiagonal[i] = 1.0 / d;
+  }
+}
+
+PCJacobi::~PCJacobi()
+{
+}
+
+void PCJacobi::apply ( Vector & y, const Vector & x ) const
+{
+  if ( x.size() != m_invDiagonal.size() )
+    fthrow(Exception, "PCJacobi::apply: size of the vector (" << x.size() << ") mismatches with the size of the preconditioner (" << m_invDiagonal.size() << ").");
+
+  y.resize ( x.size() );
+  for ( uint i = 0 ; i < x.size() ; i++ )
+    y[i] = x[i] * m_invDiagonal[i];
+}
@@ -0,0 +1,81 @@
+/**
+* @file Preconditioner.h
+* @brief interface for preconditioners used by iterative linear solvers
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_PRECONDITIONERINCLUDE
+#define _NICE_PRECONDITIONERINCLUDE
+
+#include "core/vector/VectorT.h"
+#include "PartialGenericMatrix.h"
+
+namespace NICE {
+
+/** @class Preconditioner
+ * abstract interface for preconditioners M of a linear system A*x = b.
+ * A preconditioner approximates A and provides a cheap way to apply M^{-1}.
+ * All iterative linear solvers assume M to be symmetric and positive definite.
+ */
+class Preconditioner
+{
+  public:
+
+    /**
+    * @brief apply the inverse of the preconditioning matrix: y = M^{-1} * x
+    *
+    * @param y output vector (resized if necessary)
+    * @param x input vector
+    */
+    virtual void apply ( NICE::Vector & y, const NICE::Vector & x ) const = 0;
+
+    /** get the number of rows (and columns) of M */
+    virtual uint size () const = 0;
+
+    /** simple destructor */
+    virtual ~Preconditioner ()
+    {
+    };
+};
+
+/** @class PCJacobi
+ * Jacobi preconditioner, i.e. M is the main diagonal of A
+ */
+class PCJacobi : public Preconditioner
+{
+  protected:
+    //! inverse diagonal elements of A
+    NICE::Vector m_invDiagonal;
+
+  public:
+
+    /**
+    * @brief constructor using a vector of diagonal elements
+    *
+    * @param diagonal diagonal elements of A (all of them have to be non-zero)
+    */
+    PCJacobi ( const NICE::Vector & diagonal );
+
+    /**
+    * @brief constructor using the diagonal elements of a PartialGenericMatrix
+    *
+    * @param gm matrix interface providing access to the diagonal elements
+    */
+    PCJacobi ( const PartialGenericMatrix & gm );
+
+    /** simple destructor */
+    virtual ~PCJacobi ();
+
+    /** y = M^{-1} * x */
+    virtual void apply ( NICE::Vector & y, const NICE::Vector & x ) const;
+
+    /** get the number of rows (and columns) of M */
+    virtual uint size () const
+    {
+      return m_invDiagonal.size();
+    };
+};
+
+}
+
+#endif
@@ -0,0 +1,115 @@
+/** 
+* @file SecondOrderTrustRegionCG.cpp
+* @brief Hessian-free trust region Newton method with truncated conjugate gradients
+* @date 10/19/2026
+
+*/
+#include <algorithm>
+#include <cmath>
+
+#include "SecondOrderTrustRegionCG.h"
+#include "GMHessian.h"
+
+#include "core/basics/Log.h"
+#include "core/basics/Profiler.h"
+
+using namespace NICE;
+using namespace std;
+
+SecondOrderTrustRegionCG::SecondOrderTrustRegionCG ( double typicalGradient )
+  : TrustRegionBase ( typicalGradient )
+{
+  initialDelta = 0.0;
+  numIterations = 0;
+  numCGIterations = 0;
+  numHessianProducts = 0;
+}
+
+SecondOrderTrustRegionCG::~SecondOrderTrustRegionCG ()
+{
+}
+
+void SecondOrderTrustRegionCG::doOptimize ( OptimizationProblemSecond & problem )
+{
+  NICE_PROFILE_ZONE ( "SecondOrderTrustRegionCG::doOptimize" );
+
+  GMHessian hessian ( &problem );
+  numIterations = 0;
+  numCGIterations = 0;
+
+  double previousError = problem.objective();
+  // only the gradient, computeGradientAndHessian() would form the Hessian
+  problem.gradientCurrent();
+  double delta = ( initialDelta > 0.0 ) ? initialDelta : problem.gradientNormCached();
+  bool previousStepSuccessful = true;
+  double normOldPosition = 0.0;
+
+  for ( int iteration = 0; iteration < maxIterations; iteration++ )
+  {
+    // gradient-norm stopping condition
+    const double gradientNorm = problem.gradientNormCached();
+    if ( gradientNorm < epsilonG ) {
+      NICE_LOG_DEBUG ( "SecondOrderTrustRegionCG stopped: gradientNorm " << iteration );
+      break;
+    }
+
+    negativeGradient = problem.gradientCached();
+    negativeGradient *= -1.0;
+
+    // truncated CG within the trust region, inexact Newton forcing term
+    solver.setTrustRegionRadius ( delta );
+    solver.setRelativeTolerance ( std::min ( 0.5, sqrt ( gradientNorm ) ) );
+    solver.solveLin ( hessian, negativeGradient, step );
+    numCGIterations += solver.getIterations();
+    numIterations++;
+
+    // psi = g^T s + 0.5 s^T H s, known from the CG iteration
+    const double psi = solver.getModelValue();
+    const double normStep = solver.getSolutionNorm();
+
+    // minimal change stopping condition
+    if ( changeIsMinimal ( step, problem.position() ) ) {
+      NICE_LOG_DEBUG ( "SecondOrderTrustRegionCG stopped: change is minimal " << iteration );
+      break;
+    }
+
+    if ( previousStepSuccessful ) {
+      normOldPosition = problem.position().normL2();
+    }
+
+    problem.applyStep ( step );
+
+    // compute reduction rate
+    const double newError = problem.objective();
+    const double errorReduction = newError - previousError;
+    double rho;
+    if ( std::fabs ( psi ) <= epsilonRho
+         && std::fabs ( errorReduction ) <= epsilonRho ) {
+      rho = 1.0;
+    } else {
+      rho = errorReduction / psi;
+    }
+
+    if ( rho < eta1 || psi >= 0.0 || errorReduction > 0.0 ) {
+      previousStepSuccessful = false;
+      problem.unapplyStep ( step );
+      delta = alpha2 * normStep;
+    } else {
+      previousStepSuccessful = true;
+      previousError = newError;
+      // not recomputed if the objective already computed it
+      problem.gradientCurrent();
+      if ( rho >= eta2 ) {
+        delta = std::max ( delta, alpha1 * normStep );
+      } // else: don't change delta
+    }
+
+    // delta stopping condition
+    if ( delta < epsilonDelta * std::max ( normOldPosition, 1.0 ) ) {
+      NICE_LOG_DEBUG ( "SecondOrderTrustRegionCG stopped: delta too small " << iteration );
+      break;
+    }
+  }
+
+  numHessianProducts = hessian.getNumMultiplications();
+}
@@ -0,0 +1,88 @@
+/** 
+* @file SecondOrderTrustRegionCG.h
+* @brief Hessian-free trust region Newton method with truncated conjugate gradients
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_SECONDORDERTRUSTREGIONCGINCLUDE
+#define _NICE_SECONDORDERTRUSTREGIONCGINCLUDE
+
+#include "core/optimization/gradientBased/OptimizationAlgorithmSecond.h"
+#include "core/optimization/gradientBased/TrustRegionBase.h"
+#include "ILSConjugateGradientsSteihaug.h"
+
+namespace NICE {
+
+/** @class SecondOrderTrustRegionCG
+ * Trust region Newton method for large problems (Newton-CG, Steihaug 1983).
+ *
+ * In contrast to SecondOrderTrustRegion, the Hessian is never formed or
+ * factorized: the trust region subproblem is solved approximately with
+ * ILSConjugateGradientsSteihaug, which only needs Hessian-vector products
+ * (OptimizationProblemSecond::hessianTimesVector(), presented to the solver
+ * as GMHessian). The costs per iteration are a few products and O(n)
+ * memory. Problems should override computeGradient() and
+ * computeHessianTimesVector(); otherwise the default implementations
+ * compute the full Hessian.
+ *
+ * The CG iteration of each step stops at a relative residual of
+ * min(0.5, sqrt(||g||)) (superlinear convergence), at the boundary of the
+ * trust region or at a direction of negative curvature. The update of the
+ * radius and the stopping conditions are those of TrustRegionBase. With a
+ * preconditioner, the trust region is measured in its norm.
+ *
+ * \ingroup optimization_algorithms
+ */
+class SecondOrderTrustRegionCG : public OptimizationAlgorithmSecond,
+                                 public TrustRegionBase
+{
+  protected:
+    //! solver of the trust region subproblems
+    ILSConjugateGradientsSteihaug solver;
+
+    //! initial radius, <= 0: norm of the initial gradient
+    double initialDelta;
+
+    // statistics of the last optimization
+    uint numIterations;
+    uint numCGIterations;
+    uint numHessianProducts;
+
+    // work vectors
+    Vector negativeGradient;
+    Vector step;
+
+    virtual void doOptimize ( OptimizationProblemSecond & problem );
+
+  public:
+    /** simple constructor */
+    SecondOrderTrustRegionCG ( double typicalGradient = 0.1 );
+
+    /** simple destructor */
+    virtual ~SecondOrderTrustRegionCG ();
+
+    /** initial trust region radius, <= 0: norm of the initial gradient (default) */
+    void setInitialDelta ( double delta ) { initialDelta = delta; };
+
+    /**
+    * @brief preconditioner for the CG iterations, approximating the Hessian
+    * (not copied, NULL: no preconditioner)
+    */
+    void setPreconditioner ( const Preconditioner *preconditioner ) { solver.setPreconditioner ( preconditioner ); };
+
+    /** maximum number of CG iterations per step */
+    void setMaxCGIterations ( uint maxCGIterations ) { solver.setMaxIterations ( maxCGIterations ); };
+
+    /** number of iterations (accepted and rejected steps) of the last optimization */
+    uint getNumIterations () const { return numIterations; };
+
+    /** number of CG iterations of the last optimization */
+    uint getNumCGIterations () const { return numCGIterations; };
+
+    /** number of Hessian-vector products of the last optimization */
+    uint getNumHessianProducts () const { return numHessianProducts; };
+};
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+/**
+* @file SolverWorkspace.cpp
+* @brief reusable memory for the work vectors of iterative linear solvers
+* @date 10/19/2026
+
+*/
+#include "SolverWorkspace.h"
+
+using namespace NICE;
+using namespace std;
+
+SolverWorkspace::SolverWorkspace()
+{
+}
+
+SolverWorkspace::~SolverWorkspace()
+{
+  clear();
+}
+
+Vector & SolverWorkspace::getVector ( uint index, uint size )
+{
+  if ( index >= m_vectors.size() )
+    m_vectors.resize ( index + 1, NULL );
+
+  if ( m_vectors[index] == NULL )
+    m_vectors[index] = new Vector ( size );
+  else
+    m_vectors[index]->resize ( size );
+
+  return *m_vectors[index];
+}
+
+void SolverWorkspace::setLastSolution ( const Vector & x )
+{
+  m_lastSolution.resize ( x.size() );
+  m_lastSolution = x;
+}
+
+void SolverWorkspace::clear ()
+{
+  for ( vector<Vector *>::iterator i = m_vectors.begin(); i != m_vectors.end(); i++ )
+    delete *i;
+  m_vectors.clear();
+  m_lastSolution.clear();
+}
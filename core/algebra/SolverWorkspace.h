@@ -0,0 +1,70 @@
+/**
+* @file SolverWorkspace.h
+* @brief reusable memory for the work vectors of iterative linear solvers
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_SOLVERWORKSPACEINCLUDE
+#define _NICE_SOLVERWORKSPACEINCLUDE
+
+#include <vector>
+
+#include "core/vector/VectorT.h"
+
+namespace NICE {
+
+/** @class SolverWorkspace
+ * Persistent set of work vectors of an iterative linear solver. Memory is only
+ * (re-)allocated if the size of the system changes, therefore subsequent calls
+ * of a solver with systems of the same size do not allocate any memory. The
+ * workspace additionally keeps the last solution, which can be used as an
+ * initial estimate of the next call (warm start).
+ */
+class SolverWorkspace
+{
+  protected:
+    //! work vectors (pointers, because VectorT objects are not safely copyable within STL containers)
+    std::vector< NICE::Vector * > m_vectors;
+
+    //! last solution computed by the solver
+    NICE::Vector m_lastSolution;
+
+  private:
+    // no copies of the workspace
+    SolverWorkspace ( const SolverWorkspace & );
+    SolverWorkspace & operator= ( const SolverWorkspace & );
+
+  public:
+
+    /** simple constructor */
+    SolverWorkspace ();
+
+    /** simple destructor, releases all work vectors */
+    ~SolverWorkspace ();
+
+    /**
+    * @brief get a work vector, its content is undefined
+    *
+    * @param index index of the work vector
+    * @param size required size of the vector (memory is only allocated if the size changes)
+    *
+    * @return reference to the work vector, which is valid until clear() is called
+    */
+    NICE::Vector & getVector ( uint index, uint size );
+
+    /** store the solution of the last call */
+    void setLastSolution ( const NICE::Vector & x );
+
+    /** get the solution of the last call (empty if there is none) */
+    const NICE::Vector & getLastSolution () const
+    {
+      return m_lastSolution;
+    };
+
+    /** release all memory */
+    void clear ();
+};
+
+}
+
+#endif
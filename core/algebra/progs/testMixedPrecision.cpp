@@ -0,0 +1,73 @@
+/**
+* @file testMixedPrecision.cpp
+* @date 10/19/2026
+* @brief benchmark: time-to-tolerance of mixed precision iterative refinement vs. double precision CG
+*/
+
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+
+#include "core/vector/MatrixT.h"
+#include "core/vector/VectorT.h"
+#include "core/basics/Timer.h"
+#include "core/algebra/GMStandard.h"
+#include "core/algebra/GMMixedPrecision.h"
+#include "core/algebra/ILSConjugateGradients.h"
+#include "core/algebra/ILSIterativeRefinement.h"
+
+using namespace std;
+using namespace NICE;
+
+int main(int argc, char* argv[])
+{
+  int mySize = ( argc > 1 ) ? atoi ( argv[1] ) : 4000; // number of equations
+  double tolerance = ( argc > 2 ) ? atof ( argv[2] ) : 1e-10; // relative residual
+
+  // kernel matrix of a Gaussian kernel with a noise term
+  Matrix K ( mySize, mySize );
+  for ( int i = 0; i < mySize; i++ )
+    for ( int j = 0; j < mySize; j++ )
+    {
+      double d = ( double(i) - double(j) ) / mySize;
+      K(i, j) = exp ( - 200.0 * d * d );
+    }
+  K.addIdentity ( 1e-2 );
+
+  Vector b = Vector::UniformRandom ( mySize, 0.0, 1.0, 0 );
+
+  Timer timer ( "testMixedPrecision", false );
+
+  GMStandard Kd ( K );
+  timer.start();
+  GMStandardFloat Kf ( K );
+  timer.stop();
+  cerr << "Time for the conversion to single precision: " << timer.getLastAbsolute() << endl;
+
+  // double precision: the stopping criterion of CG is the squared residual
+  ILSConjugateGradients cgDouble ( false, mySize, 0.0, pow ( tolerance * b.normL2(), 2 ) / mySize );
+  Vector x ( mySize, 0.0 );
+  timer.start();
+  cgDouble.solveLin ( Kd, b, x );
+  timer.stop();
+  double timeDouble = timer.getLastAbsolute();
+
+  Vector Kx;
+  Kd.multiply ( Kx, x );
+  cerr << "Double precision CG: time " << timeDouble << " relative residual " << ( b - Kx ).normL2() / b.normL2() << endl;
+
+  // mixed precision: inner CG on the single precision matrix with moderate accuracy
+  ILSConjugateGradients cgInner ( false, mySize, 0.0, 1e-12 / mySize );
+  ILSIterativeRefinement refinement ( &cgInner, &Kf, false, 20, tolerance );
+  Vector xm ( mySize, 0.0 );
+  timer.start();
+  int steps = refinement.solveLin ( Kd, b, xm );
+  timer.stop();
+  double timeMixed = timer.getLastAbsolute();
+
+  Kd.multiply ( Kx, xm );
+  cerr << "Mixed precision refinement (" << steps << " steps): time " << timeMixed << " relative residual " << ( b - Kx ).normL2() / b.normL2() << endl;
+  cerr << "Speedup: " << timeDouble / timeMixed << endl;
+
+  return 0;
+}
@@ -17,6 +17,25 @@
 using namespace std;
 using namespace NICE;
 
+namespace {
+
+// gaussian kernel matrix of random points, the eigenvalues decay quickly
+Matrix kernelMatrix ( uint n )
+{
+    srand48(2);
+    Vector x ( n );
+    for (uint i = 0 ; i < n ; i++)
+        x[i] = drand48();
+
+    Matrix K ( n, n );
+    for (uint i = 0 ; i < n ; i++)
+        for (uint j = 0 ; j < n ; j++)
+            K(i, j) = exp( -10.0 * (x[i] - x[j]) * (x[i] - x[j]) );
+    return K;
+}
+
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(TestDiagApprox);
 
 void TestDiagApprox::setUp()
@@ -95,3 +114,78 @@ void TestDiagApprox::TestDiagApproxComputation()
 
 
 }
+
+void TestDiagApprox::TestDiagApproxGradient()
+{
+    uint n = 12;
+    Matrix K = kernelMatrix ( n );
+    Vector D0 ( n );
+    for (uint i = 0 ; i < n ; i++)
+        D0[i] = 0.5 + 0.05 * i;
+
+    DiagonalMatrixApproxOptimizationProblem opt ( &K, D0, 0.3 );
+    OptimizationProblemFirst & problem = opt;
+
+    // objective and gradient of one decomposition
+    double f = problem.computeObjectiveAndGradient();
+    Vector gradient = problem.gradientCached();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( f, opt.computeObjective(), 1e-12 );
+
+    // central differences
+    double h = 1e-6;
+    for (uint i = 0 ; i < n ; i++)
+    {
+        Vector step ( n, 0.0 );
+        step[i] = h;
+        problem.applyStep ( step );
+        double fplus = problem.objective();
+        problem.unapplyStep ( step );
+        problem.unapplyStep ( step );
+        double fminus = problem.objective();
+        problem.applyStep ( step );
+
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( (fplus - fminus) / (2 * h), gradient[i], 1e-6 );
+    }
+}
+
+void TestDiagApprox::TestDiagApproxPartial()
+{
+    uint n = 60;
+    Matrix K = kernelMatrix ( n );
+    Vector D0 ( n, 0.1 );
+    double epsilon = 0.05;
+
+    DiagonalMatrixApproxOptimizationProblem full ( &K, D0, epsilon );
+    DiagonalMatrixApproxOptimizationProblem partial ( &K, D0, epsilon, false, 30 );
+    OptimizationProblemFirst & fullProblem = full;
+    OptimizationProblemFirst & partialProblem = partial;
+
+    double f = fullProblem.computeObjectiveAndGradient();
+    double fPartial = partialProblem.computeObjectiveAndGradient();
+    CPPUNIT_ASSERT ( partial.getNumEigenvalues() < n );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( f, fPartial, 1e-8 );
+    for (uint i = 0 ; i < n ; i++)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( fullProblem.gradientCached()[i], partialProblem.gradientCached()[i], 1e-6 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( full.getSmallestEigenvalue(), partial.getSmallestEigenvalue(), 1e-6 );
+
+    // the partial decomposition is warm started at the next position
+    Vector step ( n, 0.01 );
+    fullProblem.applyStep ( step );
+    partialProblem.applyStep ( step );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( fullProblem.computeObjectiveAndGradient(),
+                                           partialProblem.computeObjectiveAndGradient(), 1e-8 );
+
+    // both variants of the approximation agree (A - diag(D) stays positive definite)
+    K.addIdentity ( 5.0 );
+    DiagonalMatrixApprox diagApprox;
+    Vector D ( n, 0.0 );
+    diagApprox.approx ( K, D );
+    CPPUNIT_ASSERT ( D.normInf() > 0.0 );
+
+    DiagonalMatrixApprox diagApproxPartial;
+    diagApproxPartial.setPartialEigenDecomposition ( 10, 30 );
+    Vector DPartial ( n, 0.0 );
+    diagApproxPartial.approx ( K, DPartial );
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( 0.0, (D - DPartial).normInf(), 1e-6 );
+}
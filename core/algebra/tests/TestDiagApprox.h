@@ -22,6 +22,8 @@ class TestDiagApprox : public CppUnit::TestFixture
 
     
      CPPUNIT_TEST( TestDiagApproxComputation );
+     CPPUNIT_TEST( TestDiagApproxGradient );
+     CPPUNIT_TEST( TestDiagApproxPartial );
 
      CPPUNIT_TEST_SUITE_END();
 
@@ -31,6 +33,8 @@ class TestDiagApprox : public CppUnit::TestFixture
           void setUp();
           void tearDown();
           void TestDiagApproxComputation();
+          void TestDiagApproxGradient();
+          void TestDiagApproxPartial();
        
 };
 
@@ -16,6 +16,7 @@
 #include "core/algebra/EigValuesTRLAN.h"
 #include "core/algebra/GenericMatrix.h"
 #include "core/algebra/GMStandard.h"
+#include "core/vector/Eigen.h"
 
 using namespace std;
 using namespace NICE;
@@ -137,3 +138,60 @@ void TestEigenValue::TestEigenValueComputation()
         }
     }
 }
+
+void TestEigenValue::TestLanczos()
+{
+    // symmetric indefinite matrix: the largest eigenvalues are not the ones with largest magnitude
+    uint rows = 80;
+    uint k = 6;
+
+    srand48(1);
+    NICE::Matrix T(rows, rows, 0.0);
+    for (uint i = 0 ; i < rows ; i++)
+        for (uint j = i ; j < rows ; j++)
+        {
+            T(i, j) = drand48() - 0.5;
+            T(j, i) = T(i, j);
+        }
+
+    NICE::Matrix V;
+    NICE::Vector lambda;
+    eigenvectorvalues(T, V, lambda);
+
+    GMStandard Tg(T);
+    EVLanczos lanczos(false, 200, 1e-10);
+    NICE::Vector eigvalues;
+    NICE::Matrix eigvect;
+    lanczos.getEigenvalues(Tg, eigvalues, eigvect, k);
+    const uint coldMultiplications = lanczos.getNumMultiplications();
+
+    CPPUNIT_ASSERT_EQUAL(k, (uint)eigvalues.size());
+    CPPUNIT_ASSERT_EQUAL(k, (uint)eigvect.cols());
+    for (uint i = 0 ; i < k ; i++)
+    {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(lambda[i], eigvalues[i], 1e-8);
+        NICE::Vector Tv;
+        Tv.multiply(T, eigvect.getColumn(i));
+        Tv -= eigvalues[i] * eigvect.getColumn(i);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, Tv.normL2(), 1e-7);
+    }
+
+    // smallest eigenvalues in increasing order
+    EVLanczos lanczosSmallest(false, 200, 1e-10);
+    lanczosSmallest.setSmallest(true);
+    NICE::Vector smallestvalues;
+    NICE::Matrix smallestvect;
+    lanczosSmallest.getEigenvalues(Tg, smallestvalues, smallestvect, 2);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(lambda[rows - 1], smallestvalues[0], 1e-8);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(lambda[rows - 2], smallestvalues[1], 1e-8);
+
+    // warm start for a slightly changed matrix
+    for (uint i = 0 ; i < rows ; i++)
+        T(i, i) += 1e-4 * i;
+    eigenvectorvalues(T, V, lambda);
+    GMStandard Tg2(T);
+    lanczos.getEigenvalues(Tg2, eigvalues, eigvect, k);
+    for (uint i = 0 ; i < k ; i++)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(lambda[i], eigvalues[i], 1e-8);
+    CPPUNIT_ASSERT(lanczos.getNumMultiplications() < coldMultiplications);
+}
@@ -22,6 +22,7 @@ class TestEigenValue : public CppUnit::TestFixture
 
     
      CPPUNIT_TEST( TestEigenValueComputation );
+     CPPUNIT_TEST( TestLanczos );
 
      CPPUNIT_TEST_SUITE_END();
 
@@ -31,6 +32,7 @@ class TestEigenValue : public CppUnit::TestFixture
           void setUp();
           void tearDown();
           void TestEigenValueComputation();
+          void TestLanczos();
        
 };
 
@@ -20,6 +20,12 @@
 #include "core/algebra/ILSSymmLqLanczos.h"
 #include "core/algebra/ILSMinResLanczos.h"
 #include "core/algebra/GMStandard.h"
+#include "core/algebra/GMKernel.h"
+#include "core/algebra/GMMixedPrecision.h"
+#include "core/algebra/ILSIterativeRefinement.h"
+#include "core/algebra/PCBlockJacobi.h"
+#include "core/algebra/PCIncompleteCholesky.h"
+#include "core/algebra/PCNystroem.h"
 
 #include "core/algebra/GBCDSolver.h"
 
@@ -28,6 +34,27 @@ using namespace NICE;
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestLinearSolve);
 
+/** matrix wrapper counting the number of matrix-vector multiplications */
+class GMCounting : public GenericMatrix
+{
+  protected:
+    const GenericMatrix *gm;
+
+  public:
+    mutable uint numMultiplications;
+
+    GMCounting ( const GenericMatrix *gm ) : gm(gm), numMultiplications(0) {};
+
+    uint rows () const { return gm->rows(); };
+    uint cols () const { return gm->cols(); };
+
+    void multiply ( NICE::Vector & y, const NICE::Vector & x ) const
+    {
+      numMultiplications++;
+      gm->multiply ( y, x );
+    };
+};
+
 void TestLinearSolve::setUp()
 {
 }
@@ -166,3 +193,337 @@ void TestLinearSolve::TestLinearSolveComputation()
     double err_dense = ( b - bg ).normL2();
     CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0,err_dense,1e-4);
 }
+
+void TestLinearSolve::TestPreconditioning()
+{
+    bool verbose = false;
+    uint n = 100;
+
+    // ill-conditioned kernel matrix of a Gaussian kernel with a small noise term
+    NICE::Matrix K ( n, n );
+    for ( uint i = 0 ; i < n ; i++ )
+      for ( uint j = 0 ; j < n ; j++ )
+      {
+        double d = ( double(i) - double(j) ) / n;
+        K(i, j) = exp ( - 50.0 * d * d );
+      }
+    K.addIdentity ( 1e-3 );
+    NICE::Vector b = Vector::UniformRandom( n, 0.0, 1.0, 0 );
+
+    GMStandard Kg ( K );
+    GMCounting Kc ( &Kg );
+
+    PCJacobi jacobi ( Kg );
+    PCBlockJacobi blockJacobi ( Kg, 10 );
+    PCNystroem nystroem ( Kg, 30, 1e-3 );
+
+    CPPUNIT_ASSERT_EQUAL ( n, nystroem.size() );
+    CPPUNIT_ASSERT_EQUAL ( n, blockJacobi.size() );
+
+    CPPUNIT_ASSERT ( nystroem.getRank() <= 30 );
+
+    vector< IterativeLinearSolver * > methods;
+    uint max_iterations = 2*n;
+    methods.push_back ( new ILSConjugateGradients(verbose, max_iterations, 1e-10, 1e-8) );
+    methods.push_back ( new ILSConjugateGradientsLanczos(verbose, max_iterations, 1e-10) );
+    methods.push_back ( new ILSSymmLqLanczos(verbose, max_iterations, 1e-10) );
+    methods.push_back ( new ILSMinResLanczos(verbose, max_iterations, 1e-10) );
+
+    vector< Preconditioner * > preconditioners;
+    preconditioners.push_back ( &jacobi );
+    preconditioners.push_back ( &blockJacobi );
+    preconditioners.push_back ( &nystroem );
+
+    for ( vector< IterativeLinearSolver * >::const_iterator i = methods.begin();
+        i != methods.end(); i++ )
+    {
+      IterativeLinearSolver *method = *i;
+
+      Vector x (n, 0.0);
+      Kc.numMultiplications = 0;
+      method->solveLin ( Kc, b, x );
+      uint numPlain = Kc.numMultiplications;
+
+      for ( vector< Preconditioner * >::const_iterator p = preconditioners.begin();
+          p != preconditioners.end(); p++ )
+      {
+        method->setPreconditioner ( *p );
+        Vector xp (n, 0.0);
+        Kc.numMultiplications = 0;
+        method->solveLin ( Kc, b, xp );
+        uint numPreconditioned = Kc.numMultiplications;
+
+        Vector Kx;
+        Kg.multiply ( Kx, xp );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (b - Kx).normL2() / b.normL2(), 1e-4);
+
+        // the Nystroem preconditioner captures the spectrum of the kernel matrix
+        if ( *p == &nystroem )
+          CPPUNIT_ASSERT ( 2 * numPreconditioned < numPlain );
+      }
+      method->setPreconditioner ( NULL );
+      delete method;
+    }
+
+    // incomplete Cholesky for a sparse matrix (2D Laplacian plus a small diagonal term)
+    uint gridSize = 10;
+    uint m = gridSize * gridSize;
+    NICE::Matrix L ( m, m, 0.0 );
+    for ( uint i = 0 ; i < gridSize ; i++ )
+      for ( uint j = 0 ; j < gridSize ; j++ )
+      {
+        uint k = i * gridSize + j;
+        L(k, k) = 4.01;
+        if ( i > 0 ) { L(k, k - gridSize) = -1.0; L(k - gridSize, k) = -1.0; }
+        if ( j > 0 ) { L(k, k - 1) = -1.0; L(k - 1, k) = -1.0; }
+      }
+    GMSparse Ls ( L );
+    GMCounting Lc ( &Ls );
+    PCIncompleteCholesky ic ( Ls );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL ( 0.0, ic.getShift(), 1e-12 );
+
+    NICE::Vector c = Vector::UniformRandom( m, 0.0, 1.0, 0 );
+    ILSConjugateGradients cg ( verbose, 2*m, 1e-10, 1e-8 );
+
+    Vector y ( m, 0.0 );
+    cg.solveLin ( Lc, c, y );
+    uint numPlain = Lc.numMultiplications;
+
+    cg.setPreconditioner ( &ic );
+    Vector yp ( m, 0.0 );
+    Lc.numMultiplications = 0;
+    cg.solveLin ( Lc, c, yp );
+    uint numPreconditioned = Lc.numMultiplications;
+
+    Vector Ly;
+    Ls.multiply ( Ly, yp );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (c - Ly).normL2(), 1e-6);
+    CPPUNIT_ASSERT ( numPreconditioned < numPlain );
+}
+
+void TestLinearSolve::TestWarmStart()
+{
+    bool verbose = false;
+    uint n = 50;
+
+    NICE::Matrix K ( n, n );
+    for ( uint i = 0 ; i < n ; i++ )
+      for ( uint j = 0 ; j < n ; j++ )
+      {
+        double d = ( double(i) - double(j) ) / n;
+        K(i, j) = exp ( - 20.0 * d * d );
+      }
+    K.addIdentity ( 1e-2 );
+    NICE::Vector b = Vector::UniformRandom( n, 0.0, 1.0, 0 );
+
+    GMStandard Kg ( K );
+    GMCounting Kc ( &Kg );
+
+    vector< IterativeLinearSolver * > methods;
+    methods.push_back ( new ILSConjugateGradients(verbose, 2*n, 1e-10, 1e-8) );
+    methods.push_back ( new ILSConjugateGradientsLanczos(verbose, 2*n, 1e-10) );
+    methods.push_back ( new ILSSymmLqLanczos(verbose, 2*n, 1e-10) );
+    methods.push_back ( new ILSMinResLanczos(verbose, 2*n, 1e-10) );
+
+    for ( vector< IterativeLinearSolver * >::const_iterator i = methods.begin();
+        i != methods.end(); i++ )
+    {
+      IterativeLinearSolver *method = *i;
+      method->setWarmStart ( true );
+
+      // cold start
+      Vector x;
+      Kc.numMultiplications = 0;
+      method->solveLin ( Kc, b, x );
+      uint numCold = Kc.numMultiplications;
+
+      // the same system with a slightly perturbed right hand side starts from the last solution
+      Vector b2 ( b );
+      b2[0] += 1e-3;
+      Vector x2;
+      Kc.numMultiplications = 0;
+      method->solveLin ( Kc, b2, x2 );
+      uint numWarm = Kc.numMultiplications;
+
+      Vector Kx;
+      Kg.multiply ( Kx, x2 );
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (b2 - Kx).normL2() / b2.normL2(), 1e-4);
+      CPPUNIT_ASSERT ( numWarm < numCold );
+
+      // an initial estimate given by the caller is used as well
+      Vector x3 ( x2 );
+      Kc.numMultiplications = 0;
+      method->setWarmStart ( false );
+      method->solveLin ( Kc, b2, x3 );
+      CPPUNIT_ASSERT ( Kc.numMultiplications <= numWarm );
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (x3 - x2).normL2(), 1e-4 * x2.normL2());
+
+      delete method;
+    }
+}
+
+void TestLinearSolve::TestKernelMatrix()
+{
+    bool verbose = false;
+    uint n = 150;
+    uint d = 7;
+
+    // non-negative random features, such that all kernels are valid
+    NICE::Matrix X ( n, d );
+    for ( uint i = 0 ; i < n ; i++ )
+    {
+      NICE::Vector xi = Vector::UniformRandom( d, 0.0, 1.0, i );
+      for ( uint k = 0 ; k < d ; k++ )
+        X(i, k) = xi[k];
+    }
+
+    KFLinear linear;
+    KFRBF rbf ( 2.0 );
+    KFChi2 chi2;
+    KFIntersection intersection;
+    vector< KernelFunction * > kernels;
+    kernels.push_back ( &linear );
+    kernels.push_back ( &rbf );
+    kernels.push_back ( &chi2 );
+    kernels.push_back ( &intersection );
+
+    NICE::Vector x = Vector::UniformRandom( n, -1.0, 1.0, 0 );
+    double noise = 0.1;
+
+    for ( vector< KernelFunction * >::const_iterator k = kernels.begin(); k != kernels.end(); k++ )
+    {
+      // explicit kernel matrix
+      NICE::Matrix K ( n, n );
+      for ( uint i = 0 ; i < n ; i++ )
+        for ( uint j = 0 ; j < n ; j++ )
+          K(i, j) = (*k)->evaluate ( X.getRow(i).getDataPointer(), X.getRow(j).getDataPointer(), d );
+      K.addIdentity ( noise );
+      GMStandard Kg ( K );
+
+      // tiles which do not divide n, without a cache, with a cache for all 15 upper tiles
+      // of the 5 x 5 grid and with a small cache
+      GMKernel Kf ( X, *k, noise, 32 );
+      GMKernel Kc ( X, *k, noise, 32, 15 );
+      GMKernel Ks ( X, *k, noise, 32, 10 );
+
+      Vector yg, yf, yc, ys;
+      Kg.multiply ( yg, x );
+      Kf.multiply ( yf, x );
+      Kc.multiply ( yc, x );
+      Kc.multiply ( yc, x );
+      Ks.multiply ( ys, x );
+      Ks.multiply ( ys, x );
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (yg - yf).normL2(), 1e-10 * yg.normL2());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (yg - yc).normL2(), 1e-10 * yg.normL2());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (yg - ys).normL2(), 1e-10 * yg.normL2());
+      CPPUNIT_ASSERT_EQUAL ( 15u, Kc.getCacheHits() );
+      CPPUNIT_ASSERT_EQUAL ( 15u, Kc.getCacheMisses() );
+
+      for ( uint i = 0 ; i < n ; i += 10 )
+        CPPUNIT_ASSERT_DOUBLES_EQUAL ( K(i, i), Kf.getDiagonalElement(i), 1e-10 );
+
+      PartialGenericMatrix::SetType rowSet, columnSet;
+      for ( uint i = 0 ; i < n ; i += 3 )
+        rowSet.push_back ( i );
+      for ( uint i = 1 ; i < n ; i += 4 )
+        columnSet.push_back ( i );
+      Vector xsub ( columnSet.size() );
+      for ( uint i = 0 ; i < xsub.size() ; i++ )
+        xsub[i] = x[i];
+      Vector ysubg, ysubf;
+      Kg.multiply ( rowSet, columnSet, ysubg, xsub );
+      Kf.multiply ( rowSet, columnSet, ysubf, xsub );
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (ysubg - ysubf).normL2(), 1e-10 * ysubg.normL2());
+    }
+
+    // solve a kernel system without the explicit kernel matrix
+    GMKernel Kf ( X, &rbf, noise, 64 );
+    NICE::Vector b = Vector::UniformRandom( n, 0.0, 1.0, 0 );
+
+    ILSConjugateGradients cg ( verbose, n, 1e-10, 1e-8 );
+    Vector alpha;
+    cg.solveLin ( Kf, b, alpha );
+    Vector Ka;
+    Kf.multiply ( Ka, alpha );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (b - Ka).normL2() / b.normL2(), 1e-4);
+
+    GBCDSolver gbcd ( 5, 10, verbose, 100 );
+    Vector alphaGBCD;
+    gbcd.solveLin ( Kf, b, alphaGBCD );
+    Kf.multiply ( Ka, alphaGBCD );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (b - Ka).normL2() / b.normL2(), 1e-2);
+
+    // restrict the greedy selection to the coordinates with the largest gradient
+    GBCDSolver gbcdPool ( 5, 10, verbose, 100 );
+    gbcdPool.setCandidatePoolSize ( 80 );
+    Vector alphaPool;
+    gbcdPool.solveLin ( Kf, b, alphaPool );
+    Kf.multiply ( Ka, alphaPool );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (b - Ka).normL2() / b.normL2(), 1e-2);
+}
+
+void TestLinearSolve::TestMixedPrecision()
+{
+    bool verbose = false;
+    uint n = 80;
+
+    NICE::Matrix K ( n, n );
+    for ( uint i = 0 ; i < n ; i++ )
+      for ( uint j = 0 ; j < n ; j++ )
+      {
+        double d = ( double(i) - double(j) ) / n;
+        K(i, j) = exp ( - 20.0 * d * d );
+      }
+    K.addIdentity ( 1e-1 );
+    NICE::Vector b = Vector::UniformRandom( n, 0.0, 1.0, 0 );
+    NICE::Vector x = Vector::UniformRandom( n, -1.0, 1.0, 1 );
+
+    GMStandard Kg ( K );
+    GMSparse Ks ( K, 1e-3 );
+    GMStandardFloat Kf ( K );
+    GMSparseFloat Ksf ( Ks );
+
+    // single precision storage only introduces rounding errors of the matrix elements
+    Vector yg, yf, ys, ysf;
+    Kg.multiply ( yg, x );
+    Kf.multiply ( yf, x );
+    Ks.multiply ( ys, x );
+    Ksf.multiply ( ysf, x );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (yg - yf).normL2(), 1e-6 * yg.normL2());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (ys - ysf).normL2(), 1e-6 * ys.normL2());
+    CPPUNIT_ASSERT_EQUAL ( (uint)Ks.getEntries().size(), Ksf.getNumEntries() );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL ( K(3, 3), Kf.getDiagonalElement(3), 1e-6 );
+
+    NICE::Matrix data ( 5, 20 );
+    for ( uint k = 0 ; k < data.cols() ; k++ )
+      for ( uint d = 0 ; d < data.rows() ; d++ )
+        data(d, k) = sin ( 1.0 + k * data.rows() + d );
+    GMCovariance C ( &data );
+    GMCovarianceFloat Cf ( data );
+    Vector xc = Vector::UniformRandom( 5, -1.0, 1.0, 2 );
+    Vector yc, ycf;
+    C.multiply ( yc, xc );
+    Cf.multiply ( ycf, xc );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (yc - ycf).normL2(), 1e-6 * yc.normL2());
+
+    // iterative refinement reaches double precision accuracy although the inner
+    // solver only works with the single precision matrix
+    ILSConjugateGradients cg ( verbose, n, 1e-10, 1e-10 );
+    ILSIterativeRefinement refinement ( &cg, &Kf, verbose, 20, 1e-12 );
+    Vector sol;
+    refinement.solveLin ( Kg, b, sol );
+    Vector Ksol;
+    Kg.multiply ( Ksol, sol );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (b - Ksol).normL2() / b.normL2(), 1e-11);
+
+    // a much too small inner matrix overshoots, such that the first correction
+    // increases the residual: it is undone and not counted
+    NICE::Matrix Kbad ( K );
+    Kbad *= 0.4;
+    GMStandard Kb ( Kbad );
+    ILSIterativeRefinement badRefinement ( &cg, &Kb, verbose, 20, 1e-12 );
+    Vector solBad ( n, 0.0 );
+    int steps = badRefinement.solveLin ( Kg, b, solBad );
+    CPPUNIT_ASSERT_EQUAL ( 0, steps );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL ( 0.0, solBad.normInf(), 1e-12 );
+}
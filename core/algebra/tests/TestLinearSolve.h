@@ -22,6 +22,10 @@ class TestLinearSolve : public CppUnit::TestFixture
 
     
      CPPUNIT_TEST( TestLinearSolveComputation );
+     CPPUNIT_TEST( TestPreconditioning );
+     CPPUNIT_TEST( TestWarmStart );
+     CPPUNIT_TEST( TestKernelMatrix );
+     CPPUNIT_TEST( TestMixedPrecision );
 
      CPPUNIT_TEST_SUITE_END();
 
@@ -31,6 +35,10 @@ class TestLinearSolve : public CppUnit::TestFixture
           void setUp();
           void tearDown();
           void TestLinearSolveComputation();
+          void TestPreconditioning();
+          void TestWarmStart();
+          void TestKernelMatrix();
+          void TestMixedPrecision();
        
 };
 
@@ -0,0 +1,219 @@
+/**
+ * @file TestTrustRegionCG.cpp
+ * @brief TestTrustRegionCG
+ * @date 10/19/2026
+ */
+
+#include "TestTrustRegionCG.h"
+
+#include <limits>
+
+#include "core/basics/cppunitex.h"
+#include "core/basics/numerictools.h"
+
+#include "core/algebra/ILSConjugateGradientsSteihaug.h"
+#include "core/algebra/SecondOrderTrustRegionCG.h"
+#include "core/algebra/GMStandard.h"
+#include "core/algebra/GMHessian.h"
+
+using namespace std;
+using namespace NICE;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestTrustRegionCG);
+
+void TestTrustRegionCG::setUp()
+{
+}
+
+void TestTrustRegionCG::tearDown()
+{
+}
+
+/** 0.5 x^T A x - b^T x */
+static double quadraticModel ( const Matrix & A, const Vector & b, const Vector & x )
+{
+  Vector Ax ( x.size() );
+  Ax.multiply ( A, x );
+  return 0.5 * x.scalarProduct ( Ax ) - b.scalarProduct ( x );
+}
+
+void TestTrustRegionCG::TestSteihaugSolver()
+{
+  const uint n = 20;
+  Matrix A ( n, n, 0.0 );
+  Vector b ( n );
+  for ( uint i = 0 ; i < n ; i++ )
+  {
+    A ( i, i ) = 2.0 + i;
+    if ( i > 0 )
+    {
+      A ( i, i - 1 ) = -1.0;
+      A ( i - 1, i ) = -1.0;
+    }
+    b[i] = 1.0 + 0.1 * i;
+  }
+  GMStandard gm ( A );
+
+  // unconstrained: the solution of A x = b
+  ILSConjugateGradientsSteihaug solver ( false, 100, 1e-12 );
+  Vector x;
+  CPPUNIT_ASSERT_EQUAL ( ( int ) ILSConjugateGradientsSteihaug::CONVERGED, solver.solveLin ( gm, b, x ) );
+  Vector Ax ( n );
+  Ax.multiply ( A, x );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( 0.0, ( Ax - b ).normL2(), 1e-10 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( x.normL2(), solver.getSolutionNorm(), 1e-10 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( quadraticModel ( A, b, x ), solver.getModelValue(), 1e-10 );
+
+  // the trust region is active
+  const double radius = 0.5 * x.normL2();
+  solver.setTrustRegionRadius ( radius );
+  CPPUNIT_ASSERT_EQUAL ( ( int ) ILSConjugateGradientsSteihaug::BOUNDARY, solver.solveLin ( gm, b, x ) );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( radius, x.normL2(), 1e-10 );
+  CPPUNIT_ASSERT ( solver.getModelValue() < 0.0 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( quadraticModel ( A, b, x ), solver.getModelValue(), 1e-10 );
+
+  // with a preconditioner, the radius is measured in its norm
+  PCJacobi jacobi ( gm );
+  solver.setPreconditioner ( &jacobi );
+  solver.setTrustRegionRadius ( std::numeric_limits<double>::infinity() );
+  Vector xp;
+  CPPUNIT_ASSERT_EQUAL ( ( int ) ILSConjugateGradientsSteihaug::CONVERGED, solver.solveLin ( gm, b, xp ) );
+  Ax.multiply ( A, xp );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( 0.0, ( Ax - b ).normL2(), 1e-10 );
+  double xMx = 0.0;
+  for ( uint i = 0 ; i < n ; i++ )
+    xMx += A ( i, i ) * xp[i] * xp[i];
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( sqrt ( xMx ), solver.getSolutionNorm(), 1e-8 );
+  solver.setTrustRegionRadius ( 0.5 * sqrt ( xMx ) );
+  CPPUNIT_ASSERT_EQUAL ( ( int ) ILSConjugateGradientsSteihaug::BOUNDARY, solver.solveLin ( gm, b, xp ) );
+  xMx = 0.0;
+  for ( uint i = 0 ; i < n ; i++ )
+    xMx += A ( i, i ) * xp[i] * xp[i];
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( 0.5 * solver.getSolutionNorm(), 0.5 * sqrt ( xMx ), 1e-8 );
+  solver.setPreconditioner ( NULL );
+
+  // indefinite matrix: negative curvature, the solution is on the boundary
+  Matrix B ( A );
+  B ( 0, 0 ) = -5.0;
+  GMStandard gmIndefinite ( B );
+  solver.setTrustRegionRadius ( 100.0 );
+  CPPUNIT_ASSERT_EQUAL ( ( int ) ILSConjugateGradientsSteihaug::NEGATIVE_CURVATURE, solver.solveLin ( gmIndefinite, b, x ) );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( 100.0, x.normL2(), 1e-8 );
+  CPPUNIT_ASSERT ( solver.getModelValue() < 0.0 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( quadraticModel ( B, b, x ), solver.getModelValue(), 1e-6 );
+
+  CPPUNIT_ASSERT_THROW ( solver.setTrustRegionRadius ( 0.0 ), Exception );
+  Vector wrongSize ( n + 1 );
+  CPPUNIT_ASSERT_THROW ( solver.solveLin ( gm, wrongSize, x ), Exception );
+}
+
+/** extended Rosenbrock function with Hessian-vector products, the Hessian is never formed */
+class MyRosenbrockProblem : public OptimizationProblemSecond
+{
+  public:
+    mutable uint numGradients;
+
+    MyRosenbrockProblem ( uint n ) : OptimizationProblemSecond ( n ), numGradients ( 0 )
+    {
+      for ( uint i = 0 ; i < n ; i += 2 )
+      {
+        parameters()[i] = -1.2;
+        parameters()[i + 1] = 1.0;
+      }
+    }
+
+  protected:
+    double computeObjective ()
+    {
+      const Vector & x = parameters();
+      double sum = 0.0;
+      for ( uint i = 0 ; i < x.size() ; i += 2 )
+        sum += 100.0 * square ( x[i + 1] - x[i] * x[i] ) + square ( 1.0 - x[i] );
+      return sum;
+    }
+
+    void computeGradient ( Vector & newGradient )
+    {
+      numGradients++;
+      const Vector & x = parameters();
+      for ( uint i = 0 ; i < x.size() ; i += 2 )
+      {
+        const double t = x[i + 1] - x[i] * x[i];
+        newGradient[i] = -400.0 * x[i] * t - 2.0 * ( 1.0 - x[i] );
+        newGradient[i + 1] = 200.0 * t;
+      }
+    }
+
+    void computeHessianTimesVector ( const Vector & v, Vector & result )
+    {
+      const Vector & x = parameters();
+      result.resize ( x.size() );
+      for ( uint i = 0 ; i < x.size() ; i += 2 )
+      {
+        const double haa = 1200.0 * x[i] * x[i] - 400.0 * x[i + 1] + 2.0;
+        const double hab = -400.0 * x[i];
+        result[i] = haa * v[i] + hab * v[i + 1];
+        result[i + 1] = hab * v[i] + 200.0 * v[i + 1];
+      }
+    }
+
+    void computeGradientAndHessian ( Vector &, Matrix & )
+    {
+      fthrow ( Exception, "MyRosenbrockProblem: the Hessian is not available" );
+    }
+};
+
+/** a quadratic problem with a dense Hessian (default Hessian-vector product) */
+class MyDenseQuadraticProblem : public OptimizationProblemSecond
+{
+  public:
+    MyDenseQuadraticProblem () : OptimizationProblemSecond ( 2 )
+    {
+      parameters()[0] = 1.0;
+      parameters()[1] = 1.0;
+    }
+
+  protected:
+    double computeObjective ()
+    {
+      return 0.7 * square ( parameters()[0] + 0.6 ) + 0.4 * square ( parameters()[1] - 0.3 )
+             + 0.2 * ( parameters()[0] + 0.6 ) * ( parameters()[1] - 0.3 );
+    }
+
+    void computeGradientAndHessian ( Vector & newGradient, Matrix & newHessian )
+    {
+      newGradient[0] = 1.4 * ( parameters()[0] + 0.6 ) + 0.2 * ( parameters()[1] - 0.3 );
+      newGradient[1] = 0.8 * ( parameters()[1] - 0.3 ) + 0.2 * ( parameters()[0] + 0.6 );
+      newHessian ( 0, 0 ) = 1.4;
+      newHessian ( 0, 1 ) = 0.2;
+      newHessian ( 1, 0 ) = 0.2;
+      newHessian ( 1, 1 ) = 0.8;
+    }
+};
+
+void TestTrustRegionCG::TestHessianFreeOptimization()
+{
+  {
+    const uint n = 10000;
+    MyRosenbrockProblem problem ( n );
+    SecondOrderTrustRegionCG optimizer;
+    optimizer.setEpsilonG ( 1e-8 );
+    optimizer.optimize ( problem );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( 0.0, problem.objective(), 1e-12 );
+    for ( uint i = 0 ; i < n ; i++ )
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( 1.0, problem.position()[i], 1e-6 );
+    // the blocks are independent, so the number of iterations is that of n = 2
+    CPPUNIT_ASSERT ( optimizer.getNumIterations() < 100 );
+    CPPUNIT_ASSERT ( optimizer.getNumHessianProducts() >= optimizer.getNumCGIterations() );
+    CPPUNIT_ASSERT ( problem.numGradients <= optimizer.getNumIterations() + 1 );
+  }
+
+  {
+    MyDenseQuadraticProblem problem;
+    SecondOrderTrustRegionCG optimizer;
+    optimizer.setEpsilonG ( 1e-10 );
+    optimizer.optimize ( problem );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( -0.6, problem.position()[0], 1e-9 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN ( 0.3, problem.position()[1], 1e-9 );
+  }
+}
@@ -0,0 +1,36 @@
+/** 
+ * @file TestTrustRegionCG.h
+ * @brief TestTrustRegionCG
+ * @date 10/19/2026
+ */
+ 
+
+#ifndef OBJREC_TestTrustRegionCG_H
+#define OBJREC_TestTrustRegionCG_H
+
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * CppUnit-Testcase. 
+ * Tests for the Steihaug CG solver and the Hessian-free trust region method
+ */
+class TestTrustRegionCG : public CppUnit::TestFixture
+{
+     CPPUNIT_TEST_SUITE( TestTrustRegionCG );
+
+     CPPUNIT_TEST( TestSteihaugSolver );
+     CPPUNIT_TEST( TestHessianFreeOptimization );
+
+     CPPUNIT_TEST_SUITE_END();
+
+     private:
+
+     public:
+          void setUp();
+          void tearDown();
+          void TestSteihaugSolver();
+          void TestHessianFreeOptimization();
+};
+
+#endif // _TestTrustRegionCG_H_
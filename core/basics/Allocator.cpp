@@ -0,0 +1,529 @@
+/**
+* @file Allocator.cpp
+* @brief aligned and pooled allocation of the data of vectors, matrices and images
+* @date 10/19/2026
+
+*/
+#include <cstdlib>
+#include <cstring>
+
+#ifdef WIN32
+#include <malloc.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "core/basics/Allocator.h"
+
+using namespace NICE;
+using namespace std;
+
+namespace {
+
+/** @brief stored in front of every block of Allocator */
+struct BlockHeader
+{
+  AllocatorBase *allocator;
+  size_t bytes;
+  size_t count;
+};
+
+inline BlockHeader *header ( const void *p )
+{
+  return (BlockHeader *) ( (char *)p - Allocator::ALIGNMENT );
+}
+
+#if defined(__GNUC__)
+inline void atomicAdd ( size_t & value, size_t delta )
+{
+  __sync_fetch_and_add ( &value, delta );
+}
+
+inline void atomicSub ( size_t & value, size_t delta )
+{
+  __sync_fetch_and_sub ( &value, delta );
+}
+
+inline size_t atomicRead ( const size_t & value )
+{
+  return __sync_fetch_and_add ( const_cast<size_t *> ( &value ), 0 );
+}
+
+inline void atomicMax ( size_t & value, size_t candidate )
+{
+  size_t current = value;
+  while ( current < candidate )
+  {
+    size_t previous = __sync_val_compare_and_swap ( &value, current, candidate );
+    if ( previous == current )
+      break;
+    current = previous;
+  }
+}
+#else
+inline void atomicAdd ( size_t & value, size_t delta )
+{
+#pragma omp critical(NiceAllocatorStatistics)
+  value += delta;
+}
+
+inline void atomicSub ( size_t & value, size_t delta )
+{
+#pragma omp critical(NiceAllocatorStatistics)
+  value -= delta;
+}
+
+inline size_t atomicRead ( const size_t & value )
+{
+  size_t result;
+#pragma omp critical(NiceAllocatorStatistics)
+  result = value;
+  return result;
+}
+
+inline void atomicMax ( size_t & value, size_t candidate )
+{
+#pragma omp critical(NiceAllocatorStatistics)
+  if ( value < candidate )
+    value = candidate;
+}
+#endif
+
+void *systemAllocate ( size_t bytes )
+{
+  void *p = NULL;
+#ifdef WIN32
+  p = _aligned_malloc ( bytes, Allocator::ALIGNMENT );
+#else
+  if ( posix_memalign ( &p, Allocator::ALIGNMENT, bytes ) != 0 )
+    p = NULL;
+#endif
+  if ( p == NULL )
+    throw std::bad_alloc();
+  return p;
+}
+
+void systemDeallocate ( void *p )
+{
+#ifdef WIN32
+  _aligned_free ( p );
+#else
+  free ( p );
+#endif
+}
+
+inline void *&nextBlock ( void *block )
+{
+  return *(void **)block;
+}
+
+//! statistics of Allocator
+size_t bytesLive = 0;
+size_t bytesPeak = 0;
+size_t allocations = 0;
+size_t deallocations = 0;
+
+AllocatorBase * volatile currentAllocator = NULL;
+AllocatorBase *defaultAllocator = NULL;
+
+void createDefaultAllocator ()
+{
+  // never deleted: vectors of static objects may be released after exit()
+  const char *name = getenv ( "NICE_ALLOCATOR" );
+  if ( ( name != NULL ) && ( strcmp ( name, "aligned" ) == 0 ) )
+    defaultAllocator = new AlignedAllocator();
+  else
+    defaultAllocator = new PoolAllocator();
+  if ( currentAllocator == NULL )
+    currentAllocator = defaultAllocator;
+}
+
+#ifndef WIN32
+pthread_once_t defaultAllocatorOnce = PTHREAD_ONCE_INIT;
+#endif
+
+AllocatorBase *getDefaultAllocator ()
+{
+#ifdef WIN32
+#pragma omp critical(NiceAllocatorDefault)
+  if ( defaultAllocator == NULL )
+    createDefaultAllocator();
+#else
+  pthread_once ( &defaultAllocatorOnce, createDefaultAllocator );
+#endif
+  return defaultAllocator;
+}
+
+}
+
+AllocatorStatistics::AllocatorStatistics ()
+  : bytesLive ( 0 ), bytesPeak ( 0 ), allocations ( 0 ), deallocations ( 0 ),
+    poolHits ( 0 ), poolMisses ( 0 ), bytesCached ( 0 )
+{
+}
+
+AllocatorBase::~AllocatorBase ()
+{
+}
+
+void AllocatorBase::addStatistics ( AllocatorStatistics & statistics ) const
+{
+}
+
+void *AlignedAllocator::allocate ( size_t bytes )
+{
+  return systemAllocate ( bytes );
+}
+
+void AlignedAllocator::deallocate ( void *p, size_t bytes )
+{
+  systemDeallocate ( p );
+}
+
+struct PoolAllocator::ThreadCache
+{
+  PoolAllocator *owner;
+  void *lists[NUM_CLASSES];
+  size_t bytes;
+};
+
+PoolAllocator::PoolAllocator ( size_t maxPooledBytes, size_t threadCacheBytes, size_t sharedCacheBytes )
+  : maxPooledBytes ( maxPooledBytes ), threadCacheBytes ( threadCacheBytes ),
+    sharedCacheBytes ( sharedCacheBytes ), sharedBytes ( 0 ), sharedMutex ( NULL ),
+    cacheKey ( NULL ), hits ( 0 ), misses ( 0 ), cachedBytes ( 0 )
+{
+  maxClass = sizeClass ( maxPooledBytes );
+  if ( maxClass < 0 )
+    maxClass = NUM_CLASSES - 1;
+  for ( int c = 0 ; c < NUM_CLASSES ; c++ )
+    shared[c] = NULL;
+#ifndef WIN32
+  pthread_mutex_t *mutex = new pthread_mutex_t;
+  pthread_mutex_init ( mutex, NULL );
+  sharedMutex = mutex;
+  pthread_key_t *key = new pthread_key_t;
+  if ( pthread_key_create ( key, releaseThreadCache ) == 0 )
+    cacheKey = key;
+  else
+    delete key;
+#endif
+}
+
+PoolAllocator::~PoolAllocator ()
+{
+#ifndef WIN32
+  if ( cacheKey != NULL )
+  {
+    pthread_key_t *key = (pthread_key_t *)cacheKey;
+    ThreadCache *cache = (ThreadCache *)pthread_getspecific ( *key );
+    if ( cache != NULL )
+    {
+      pthread_setspecific ( *key, NULL );
+      release ( cache );
+    }
+    pthread_key_delete ( *key );
+    delete key;
+  }
+#endif
+  trim();
+#ifndef WIN32
+  pthread_mutex_t *mutex = (pthread_mutex_t *)sharedMutex;
+  pthread_mutex_destroy ( mutex );
+  delete mutex;
+#endif
+}
+
+int PoolAllocator::sizeClass ( size_t bytes )
+{
+  if ( bytes <= 128 )
+    return 0;
+  size_t base = 128;
+  int group = 0;
+  while ( bytes > 2 * base )
+  {
+    base *= 2;
+    group++;
+    if ( 4 * group >= NUM_CLASSES )
+      return -1;
+  }
+  // base < bytes <= 2*base, classes in quarter steps of base
+  size_t step = base / 4;
+  int c = 4 * group + (int) ( ( bytes - base + step - 1 ) / step );
+  return ( c < NUM_CLASSES ) ? c : -1;
+}
+
+size_t PoolAllocator::classSize ( int c )
+{
+  size_t base = (size_t)128 << ( c / 4 );
+  return base + ( c % 4 ) * ( base / 4 );
+}
+
+PoolAllocator::ThreadCache *PoolAllocator::getThreadCache ()
+{
+#ifdef WIN32
+  return NULL;
+#else
+  if ( cacheKey == NULL )
+    return NULL;
+  pthread_key_t *key = (pthread_key_t *)cacheKey;
+  ThreadCache *cache = (ThreadCache *)pthread_getspecific ( *key );
+  if ( cache == NULL )
+  {
+    cache = new ThreadCache;
+    cache->owner = this;
+    for ( int c = 0 ; c < NUM_CLASSES ; c++ )
+      cache->lists[c] = NULL;
+    cache->bytes = 0;
+    pthread_setspecific ( *key, cache );
+  }
+  return cache;
+#endif
+}
+
+void *PoolAllocator::takeShared ( int c )
+{
+  void *block = NULL;
+#ifdef WIN32
+#pragma omp critical(NiceAllocatorPool)
+#else
+  pthread_mutex_lock ( (pthread_mutex_t *)sharedMutex );
+#endif
+  {
+    block = shared[c];
+    if ( block != NULL )
+    {
+      shared[c] = nextBlock ( block );
+      sharedBytes -= classSize ( c );
+    }
+  }
+#ifndef WIN32
+  pthread_mutex_unlock ( (pthread_mutex_t *)sharedMutex );
+#endif
+  return block;
+}
+
+bool PoolAllocator::putShared ( int c, void *block )
+{
+  bool stored = false;
+#ifdef WIN32
+#pragma omp critical(NiceAllocatorPool)
+#else
+  pthread_mutex_lock ( (pthread_mutex_t *)sharedMutex );
+#endif
+  {
+    if ( sharedBytes + classSize ( c ) <= sharedCacheBytes )
+    {
+      nextBlock ( block ) = shared[c];
+      shared[c] = block;
+      sharedBytes += classSize ( c );
+      stored = true;
+    }
+  }
+#ifndef WIN32
+  pthread_mutex_unlock ( (pthread_mutex_t *)sharedMutex );
+#endif
+  return stored;
+}
+
+void *PoolAllocator::allocate ( size_t bytes )
+{
+  int c = ( bytes <= maxPooledBytes ) ? sizeClass ( bytes ) : -1;
+  if ( ( c < 0 ) || ( c > maxClass ) )
+    return systemAllocate ( bytes );
+
+  ThreadCache *cache = getThreadCache();
+  void *block = NULL;
+  if ( ( cache != NULL ) && ( cache->lists[c] != NULL ) )
+  {
+    block = cache->lists[c];
+    cache->lists[c] = nextBlock ( block );
+    cache->bytes -= classSize ( c );
+  } else {
+    block = takeShared ( c );
+  }
+
+  if ( block != NULL )
+  {
+    atomicAdd ( hits, 1 );
+    atomicSub ( cachedBytes, classSize ( c ) );
+    return block;
+  }
+  atomicAdd ( misses, 1 );
+  return systemAllocate ( classSize ( c ) );
+}
+
+void PoolAllocator::deallocate ( void *p, size_t bytes )
+{
+  int c = ( bytes <= maxPooledBytes ) ? sizeClass ( bytes ) : -1;
+  if ( ( c < 0 ) || ( c > maxClass ) )
+  {
+    systemDeallocate ( p );
+    return;
+  }
+
+  size_t size = classSize ( c );
+  ThreadCache *cache = getThreadCache();
+  if ( ( cache != NULL ) && ( cache->bytes + size <= threadCacheBytes ) )
+  {
+    nextBlock ( p ) = cache->lists[c];
+    cache->lists[c] = p;
+    cache->bytes += size;
+  } else if ( !putShared ( c, p ) ) {
+    systemDeallocate ( p );
+    return;
+  }
+  atomicAdd ( cachedBytes, size );
+}
+
+void PoolAllocator::release ( ThreadCache *cache )
+{
+  for ( int c = 0 ; c < NUM_CLASSES ; c++ )
+  {
+    while ( cache->lists[c] != NULL )
+    {
+      void *block = cache->lists[c];
+      cache->lists[c] = nextBlock ( block );
+      if ( !putShared ( c, block ) )
+      {
+        systemDeallocate ( block );
+        atomicSub ( cachedBytes, classSize ( c ) );
+      }
+    }
+  }
+  delete cache;
+}
+
+void PoolAllocator::releaseThreadCache ( void *cache )
+{
+  ThreadCache *threadCache = (ThreadCache *)cache;
+  threadCache->owner->release ( threadCache );
+}
+
+void PoolAllocator::trim ()
+{
+  ThreadCache *cache = getThreadCache();
+  for ( int c = 0 ; c < NUM_CLASSES ; c++ )
+  {
+    void *block = takeShared ( c );
+    while ( block != NULL )
+    {
+      systemDeallocate ( block );
+      atomicSub ( cachedBytes, classSize ( c ) );
+      block = takeShared ( c );
+    }
+    if ( cache == NULL )
+      continue;
+    while ( cache->lists[c] != NULL )
+    {
+      block = cache->lists[c];
+      cache->lists[c] = nextBlock ( block );
+      cache->bytes -= classSize ( c );
+      systemDeallocate ( block );
+      atomicSub ( cachedBytes, classSize ( c ) );
+    }
+  }
+}
+
+void PoolAllocator::addStatistics ( AllocatorStatistics & statistics ) const
+{
+  statistics.poolHits += atomicRead ( hits );
+  statistics.poolMisses += atomicRead ( misses );
+  statistics.bytesCached += atomicRead ( cachedBytes );
+}
+
+void *Allocator::allocate ( size_t bytes )
+{
+  AllocatorBase *allocator = currentAllocator;
+  if ( allocator == NULL )
+  {
+    getDefaultAllocator();
+    allocator = currentAllocator;
+  }
+
+  if ( bytes > (size_t)-1 - ALIGNMENT )
+    throw std::bad_alloc();
+  char *block = (char *) allocator->allocate ( bytes + ALIGNMENT );
+  BlockHeader *h = (BlockHeader *)block;
+  h->allocator = allocator;
+  h->bytes = bytes;
+  h->count = 0;
+
+  atomicAdd ( allocations, 1 );
+  atomicAdd ( bytesLive, bytes );
+  atomicMax ( bytesPeak, atomicRead ( bytesLive ) );
+  return block + ALIGNMENT;
+}
+
+void Allocator::deallocate ( void *p )
+{
+  if ( p == NULL )
+    return;
+  BlockHeader *h = header ( p );
+  size_t bytes = h->bytes;
+  h->allocator->deallocate ( h, bytes + ALIGNMENT );
+
+  atomicAdd ( deallocations, 1 );
+  atomicSub ( bytesLive, bytes );
+}
+
+size_t Allocator::getSize ( const void *p )
+{
+  return header ( p )->bytes;
+}
+
+size_t &Allocator::count ( void *p )
+{
+  return header ( p )->count;
+}
+
+void Allocator::setAllocator ( AllocatorBase *allocator )
+{
+  if ( allocator == NULL )
+    allocator = getDefaultAllocator();
+  currentAllocator = allocator;
+}
+
+AllocatorBase *Allocator::getAllocator ()
+{
+  if ( currentAllocator == NULL )
+    getDefaultAllocator();
+  return currentAllocator;
+}
+
+void Allocator::getStatistics ( AllocatorStatistics & statistics )
+{
+  statistics = AllocatorStatistics();
+  statistics.bytesLive = atomicRead ( bytesLive );
+  statistics.bytesPeak = atomicRead ( bytesPeak );
+  statistics.allocations = atomicRead ( allocations );
+  statistics.deallocations = atomicRead ( deallocations );
+  getAllocator()->addStatistics ( statistics );
+}
+
+void Allocator::resetPeak ()
+{
+#if defined(__GNUC__)
+  __sync_lock_test_and_set ( &bytesPeak, atomicRead ( bytesLive ) );
+#else
+#pragma omp critical(NiceAllocatorStatistics)
+  bytesPeak = bytesLive;
+#endif
+}
+
+void Allocator::trim ()
+{
+  getAllocator()->trim();
+}
+
+void Allocator::writeStatistics ( std::ostream & os )
+{
+  AllocatorStatistics s;
+  getStatistics ( s );
+  os << "allocator " << getAllocator()->getName()
+     << ": live " << s.bytesLive << " bytes, peak " << s.bytesPeak << " bytes, "
+     << s.allocations << " allocations, " << s.deallocations << " deallocations";
+  if ( s.poolHits + s.poolMisses > 0 )
+    os << ", pool hits " << s.poolHits << ", misses " << s.poolMisses
+       << ", cached " << s.bytesCached << " bytes";
+  os << std::endl;
+}
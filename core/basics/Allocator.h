@@ -0,0 +1,258 @@
+/**
+* @file Allocator.h
+* @brief aligned and pooled allocation of the data of vectors, matrices and images
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_ALLOCATORINCLUDE
+#define _NICE_ALLOCATORINCLUDE
+
+#include <cstddef>
+#include <iostream>
+#include <new>
+
+namespace NICE {
+
+/** @brief statistics of the memory allocated through Allocator */
+struct AllocatorStatistics
+{
+  //! bytes currently allocated (without block headers and pool overhead)
+  size_t bytesLive;
+  //! maximum of bytesLive since the start or the last resetPeak()
+  size_t bytesPeak;
+  //! number of allocations
+  size_t allocations;
+  //! number of deallocations
+  size_t deallocations;
+  //! allocations served from a pool without asking the system
+  size_t poolHits;
+  //! allocations of the pool which had to ask the system
+  size_t poolMisses;
+  //! bytes of free blocks kept by the pool
+  size_t bytesCached;
+
+  AllocatorStatistics ();
+};
+
+/**
+ * @class AllocatorBase
+ * @brief Interface of the memory source of Allocator. Implementations have to
+ * return memory aligned to Allocator::ALIGNMENT and have to be thread-safe.
+ */
+class AllocatorBase
+{
+  public:
+    virtual ~AllocatorBase ();
+
+    /** allocate bytes aligned to Allocator::ALIGNMENT, throws std::bad_alloc */
+    virtual void *allocate ( size_t bytes ) = 0;
+
+    /** release memory of allocate(), bytes is the size given to allocate() */
+    virtual void deallocate ( void *p, size_t bytes ) = 0;
+
+    /** return cached memory to the system */
+    virtual void trim () {};
+
+    /** add the pool statistics (poolHits, poolMisses, bytesCached) */
+    virtual void addStatistics ( AllocatorStatistics & statistics ) const;
+
+    virtual const char *getName () const = 0;
+};
+
+/**
+ * @class AlignedAllocator
+ * @brief Every allocation is passed to the aligned allocation of the system.
+ */
+class AlignedAllocator : public AllocatorBase
+{
+  public:
+    virtual void *allocate ( size_t bytes );
+
+    virtual void deallocate ( void *p, size_t bytes );
+
+    virtual const char *getName () const { return "aligned"; };
+};
+
+/**
+ * @class PoolAllocator
+ * @brief Size-class pool for the short-lived temporaries of arithmetic
+ * operators. Block sizes grow in quarter steps between powers of two, so at
+ * most 25% of a block is wasted. Free blocks are kept in a cache of the
+ * deallocating thread; if it is full, they are moved to a shared cache, and
+ * if that is full as well, they are returned to the system. Blocks larger
+ * than the maximum pooled size are always taken from and returned to the
+ * system.
+ *
+ * The thread caches of a pool are only released at the exit of their
+ * threads, so a pool has to outlive all threads which used it.
+ */
+class PoolAllocator : public AllocatorBase
+{
+  public:
+    /**
+    * @param maxPooledBytes largest block which is pooled
+    * @param threadCacheBytes maximum size of the free blocks of a thread
+    * @param sharedCacheBytes maximum size of the free blocks shared by all threads
+    */
+    PoolAllocator ( size_t maxPooledBytes = 1 << 20,
+                    size_t threadCacheBytes = 4 << 20,
+                    size_t sharedCacheBytes = 64 << 20 );
+
+    /** releases the shared cache and the cache of the calling thread */
+    virtual ~PoolAllocator ();
+
+    virtual void *allocate ( size_t bytes );
+
+    virtual void deallocate ( void *p, size_t bytes );
+
+    /** release the shared cache and the cache of the calling thread */
+    virtual void trim ();
+
+    virtual void addStatistics ( AllocatorStatistics & statistics ) const;
+
+    virtual const char *getName () const { return "pool"; };
+
+    /** number of size classes */
+    static const int NUM_CLASSES = 64;
+
+    /** size class of a block, -1 if it is too large for any class */
+    static int sizeClass ( size_t bytes );
+
+    /** size of the blocks of a class */
+    static size_t classSize ( int c );
+
+  private:
+    //! free lists of a thread
+    struct ThreadCache;
+
+    size_t maxPooledBytes;
+    int maxClass;
+    size_t threadCacheBytes;
+    size_t sharedCacheBytes;
+
+    //! free blocks shared by all threads, linked through their first word
+    void *shared[NUM_CLASSES];
+    size_t sharedBytes;
+    void *sharedMutex;
+    void *cacheKey;
+
+    size_t hits;
+    size_t misses;
+    size_t cachedBytes;
+
+    ThreadCache *getThreadCache ();
+    void *takeShared ( int c );
+    bool putShared ( int c, void *block );
+    void release ( ThreadCache *cache );
+
+    static void releaseThreadCache ( void *cache );
+
+    PoolAllocator ( const PoolAllocator & );
+    PoolAllocator & operator= ( const PoolAllocator & );
+};
+
+/**
+ * @class Allocator
+ * @brief Library-wide allocation hook for the data of VectorT, MatrixT, ImageT
+ * and ColorImageT.
+ *
+ * All memory is aligned to ALIGNMENT bytes such that SIMD kernels can use
+ * aligned loads on the first element. Each block starts with a header which
+ * stores the allocator and the size of the block, so blocks can be released
+ * after setAllocator() installed another memory source.
+ *
+ * The default memory source is a PoolAllocator. The environment variable
+ * NICE_ALLOCATOR selects "pool" or "aligned" (no pooling, useful for memory
+ * checkers) at the first allocation.
+ */
+class Allocator
+{
+  public:
+    /** alignment of all blocks in bytes */
+    static const size_t ALIGNMENT = 64;
+
+    /** allocate bytes aligned to ALIGNMENT, throws std::bad_alloc */
+    static void *allocate ( size_t bytes );
+
+    /** release memory of allocate(), NULL is ignored */
+    static void deallocate ( void *p );
+
+    /** size given to allocate() */
+    static size_t getSize ( const void *p );
+
+    /**
+    * @brief allocate and default-initialize n objects (like new T[n])
+    */
+    template<class T>
+    static T *newArray ( size_t n );
+
+    /**
+    * @brief destroy and release an array of newArray() (like delete[]), NULL is ignored
+    */
+    template<class T>
+    static void deleteArray ( T *p );
+
+    /**
+    * @brief install the memory source of future allocations
+    *
+    * The allocator is not deleted and has to outlive all blocks allocated with it.
+    * NULL restores the default allocator.
+    */
+    static void setAllocator ( AllocatorBase *allocator );
+
+    /** the memory source of future allocations */
+    static AllocatorBase *getAllocator ();
+
+    /** statistics of all allocations and of the pool of the current allocator */
+    static void getStatistics ( AllocatorStatistics & statistics );
+
+    /** set the peak to the bytes currently allocated */
+    static void resetPeak ();
+
+    /** return the cached memory of the current allocator to the system */
+    static void trim ();
+
+    /** write the statistics in a human readable form */
+    static void writeStatistics ( std::ostream & os );
+
+    /** true if p is aligned to ALIGNMENT */
+    static bool isAligned ( const void *p ) { return ( (size_t)p & ( ALIGNMENT - 1 ) ) == 0; };
+
+  private:
+    //! number of objects of a block of newArray()
+    static size_t &count ( void *p );
+};
+
+template<class T>
+T *Allocator::newArray ( size_t n )
+{
+  if ( n > ( (size_t)-1 - ALIGNMENT ) / sizeof ( T ) )
+    throw std::bad_alloc();
+  T *p = static_cast<T *> ( allocate ( n * sizeof ( T ) ) );
+  size_t i = 0;
+  try {
+    for ( ; i < n ; i++ )
+      new ( p + i ) T;
+  } catch ( ... ) {
+    while ( i > 0 )
+      p[--i].~T();
+    deallocate ( p );
+    throw;
+  }
+  count ( p ) = n;
+  return p;
+}
+
+template<class T>
+void Allocator::deleteArray ( T *p )
+{
+  if ( p == NULL )
+    return;
+  for ( size_t i = count ( p ) ; i > 0 ; i-- )
+    p[i-1].~T();
+  deallocate ( p );
+}
+
+} // namespace
+
+#endif
@@ -0,0 +1,435 @@
+/**
+* @file Benchmark.cpp
+* @brief micro-benchmark harness: warmup, repetitions, robust statistics, JSON/CSV output and baseline comparison
+* @date 10/19/2026
+
+*/
+#include <cstdlib>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <map>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "core/basics/Exception.h"
+#include "core/basics/Profiler.h"
+#include "core/basics/HardwareCounters.h"
+#include "Benchmark.h"
+
+using namespace NICE;
+using namespace std;
+
+namespace {
+
+volatile double keptValue = 0.0;
+
+double seconds ( unsigned long long ticks )
+{
+  return ticks * 1e-9;
+}
+
+void writeJSONString ( std::ostream & os, const std::string & s )
+{
+  os << '"';
+  for ( size_t i = 0 ; i < s.size() ; i++ )
+  {
+    if ( ( s[i] == '"' ) || ( s[i] == '\\' ) )
+      os << '\\';
+    os << s[i];
+  }
+  os << '"';
+}
+
+/** value of a field of a JSON object written by writeJSON */
+bool findJSONField ( const std::string & line, const std::string & key, std::string & value )
+{
+  std::string pattern = "\"" + key + "\":";
+  size_t pos = line.find ( pattern );
+  if ( pos == std::string::npos )
+    return false;
+  pos += pattern.size();
+
+  if ( ( pos < line.size() ) && ( line[pos] == '"' ) )
+  {
+    value.clear();
+    for ( pos++ ; ( pos < line.size() ) && ( line[pos] != '"' ) ; pos++ )
+    {
+      if ( ( line[pos] == '\\' ) && ( pos + 1 < line.size() ) )
+        pos++;
+      value += line[pos];
+    }
+  } else {
+    size_t end = line.find_first_of ( ",}", pos );
+    value = line.substr ( pos, end - pos );
+  }
+  return true;
+}
+
+double toDouble ( const std::string & s )
+{
+  return strtod ( s.c_str(), NULL );
+}
+
+/** quote a CSV field if it contains a separator or a quote */
+void writeCSVString ( std::ostream & os, const std::string & s )
+{
+  if ( s.find_first_of ( ",\"\n" ) == std::string::npos )
+  {
+    os << s;
+    return;
+  }
+  os << '"';
+  for ( size_t i = 0 ; i < s.size() ; i++ )
+  {
+    if ( s[i] == '"' )
+      os << '"';
+    os << s[i];
+  }
+  os << '"';
+}
+
+void splitCSV ( const std::string & line, std::vector<std::string> & fields )
+{
+  fields.clear();
+  std::string field;
+  bool quoted = false;
+  for ( size_t i = 0 ; i < line.size() ; i++ )
+  {
+    if ( quoted )
+    {
+      if ( line[i] != '"' )
+        field += line[i];
+      else if ( ( i + 1 < line.size() ) && ( line[i+1] == '"' ) )
+        field += line[++i];
+      else
+        quoted = false;
+    } else if ( line[i] == '"' ) {
+      quoted = true;
+    } else if ( line[i] == ',' ) {
+      fields.push_back ( field );
+      field.clear();
+    } else {
+      field += line[i];
+    }
+  }
+  fields.push_back ( field );
+}
+
+}
+
+BenchmarkCase::BenchmarkCase ( const std::string & suite, const std::string & name )
+  : suite ( suite ), name ( name )
+{
+}
+
+BenchmarkCase::~BenchmarkCase ()
+{
+}
+
+void BenchmarkCase::keep ( double value )
+{
+  keptValue = keptValue + value;
+}
+
+BenchmarkResult::BenchmarkResult ()
+  : repetitions ( 0 ), iterations ( 0 ), median ( 0.0 ), mad ( 0.0 ), minimum ( 0.0 ), mean ( 0.0 ),
+    instructionsPerCycle ( -1.0 ), cacheMissesPerKiloInstruction ( -1.0 )
+{
+}
+
+BenchmarkRunner::BenchmarkRunner ()
+  : warmupRepetitions ( 2 ), repetitions ( 15 ), minimumTime ( 0.05 ), cpu ( -1 ), useHardwareCounters ( false )
+{
+}
+
+BenchmarkRunner::~BenchmarkRunner ()
+{
+  for ( size_t i = 0 ; i < cases.size() ; i++ )
+    delete cases[i];
+}
+
+void BenchmarkRunner::add ( BenchmarkCase *benchmark )
+{
+  cases.push_back ( benchmark );
+}
+
+bool BenchmarkRunner::pinToCpu ( int cpu )
+{
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO ( &set );
+  CPU_SET ( cpu, &set );
+  return ( sched_setaffinity ( 0, sizeof(set), &set ) == 0 );
+#else
+  return false;
+#endif
+}
+
+double BenchmarkRunner::median ( std::vector<double> values )
+{
+  if ( values.empty() )
+    return 0.0;
+  size_t n = values.size();
+  std::nth_element ( values.begin(), values.begin() + n / 2, values.end() );
+  double m = values[n / 2];
+  if ( n % 2 == 0 )
+  {
+    std::nth_element ( values.begin(), values.begin() + n / 2 - 1, values.end() );
+    m = 0.5 * ( m + values[n / 2 - 1] );
+  }
+  return m;
+}
+
+double BenchmarkRunner::medianAbsoluteDeviation ( const std::vector<double> & values )
+{
+  double m = median ( values );
+  std::vector<double> deviations ( values.size() );
+  for ( size_t i = 0 ; i < values.size() ; i++ )
+    deviations[i] = fabs ( values[i] - m );
+  return median ( deviations );
+}
+
+void BenchmarkRunner::run ( std::ostream & progress )
+{
+  if ( ( cpu >= 0 ) && !pinToCpu ( cpu ) )
+    progress << "BenchmarkRunner: unable to pin the process to cpu " << cpu << std::endl;
+
+  std::ios::fmtflags flags = progress.flags();
+  std::streamsize precision = progress.precision();
+  results.clear();
+  HardwareCounters *counters = useHardwareCounters ? new HardwareCounters : NULL;
+
+  for ( size_t c = 0 ; c < cases.size() ; c++ )
+  {
+    BenchmarkCase & benchmark = *cases[c];
+    std::string fullName = benchmark.getSuite() + "/" + benchmark.getName();
+    if ( !filter.empty() && ( fullName.find ( filter ) == std::string::npos ) )
+      continue;
+
+    benchmark.setUp();
+
+    // calibrate the number of calls per repetition
+    size_t iterations = 1;
+    while ( true )
+    {
+      unsigned long long start = Profiler::ticks();
+      for ( size_t i = 0 ; i < iterations ; i++ )
+        benchmark.run();
+      double elapsed = seconds ( Profiler::ticks() - start );
+      if ( ( elapsed >= minimumTime ) || ( iterations >= ( 1u << 30 ) ) )
+        break;
+      // aim slightly above the minimum time, but grow at most by a factor of ten
+      double factor = ( elapsed > 0.0 ) ? std::min ( 10.0, 1.2 * minimumTime / elapsed ) : 10.0;
+      iterations = std::max ( iterations + 1, (size_t) ( iterations * factor ) );
+    }
+
+    for ( int r = 0 ; r < warmupRepetitions ; r++ )
+      for ( size_t i = 0 ; i < iterations ; i++ )
+        benchmark.run();
+
+    unsigned long long countersBefore[HardwareCounters::NUM_COUNTERS];
+    unsigned long long countersAfter[HardwareCounters::NUM_COUNTERS];
+    if ( counters != NULL )
+      counters->read ( countersBefore );
+
+    std::vector<double> times ( repetitions );
+    for ( int r = 0 ; r < repetitions ; r++ )
+    {
+      unsigned long long start = Profiler::ticks();
+      for ( size_t i = 0 ; i < iterations ; i++ )
+        benchmark.run();
+      times[r] = seconds ( Profiler::ticks() - start ) / iterations;
+    }
+
+    BenchmarkResult result;
+    if ( counters != NULL )
+    {
+      counters->read ( countersAfter );
+      double cycles = (double) ( countersAfter[HardwareCounters::CYCLES] - countersBefore[HardwareCounters::CYCLES] );
+      double instructions = (double) ( countersAfter[HardwareCounters::INSTRUCTIONS] - countersBefore[HardwareCounters::INSTRUCTIONS] );
+      double misses = (double) ( countersAfter[HardwareCounters::CACHE_MISSES] - countersBefore[HardwareCounters::CACHE_MISSES] );
+      if ( counters->isAvailable ( HardwareCounters::CYCLES ) && counters->isAvailable ( HardwareCounters::INSTRUCTIONS ) && ( cycles > 0 ) )
+        result.instructionsPerCycle = instructions / cycles;
+      if ( counters->isAvailable ( HardwareCounters::CACHE_MISSES ) && ( instructions > 0 ) )
+        result.cacheMissesPerKiloInstruction = 1000.0 * misses / instructions;
+    }
+
+    benchmark.tearDown();
+
+    result.suite = benchmark.getSuite();
+    result.name = benchmark.getName();
+    result.repetitions = repetitions;
+    result.iterations = iterations;
+    result.median = median ( times );
+    result.mad = medianAbsoluteDeviation ( times );
+    result.minimum = times.empty() ? 0.0 : *std::min_element ( times.begin(), times.end() );
+    result.mean = 0.0;
+    for ( size_t r = 0 ; r < times.size() ; r++ )
+      result.mean += times[r];
+    if ( !times.empty() )
+      result.mean /= times.size();
+    results.push_back ( result );
+
+    progress << std::left << std::setw ( 52 ) << fullName << std::right << std::fixed
+             << std::setw ( 14 ) << std::setprecision ( 2 ) << result.median * 1e6 << " us +- "
+             << std::setw ( 10 ) << result.mad * 1e6 << " us";
+    if ( result.instructionsPerCycle >= 0.0 )
+      progress << "  IPC " << result.instructionsPerCycle;
+    progress << std::endl;
+  }
+
+  if ( counters != NULL )
+    delete counters;
+  progress.flags ( flags );
+  progress.precision ( precision );
+}
+
+void BenchmarkRunner::writeJSON ( std::ostream & os ) const
+{
+  std::streamsize precision = os.precision();
+  os << std::setprecision ( 10 );
+  os << "[" << std::endl;
+  for ( size_t i = 0 ; i < results.size() ; i++ )
+  {
+    const BenchmarkResult & r = results[i];
+    os << "{\"suite\":";
+    writeJSONString ( os, r.suite );
+    os << ",\"name\":";
+    writeJSONString ( os, r.name );
+    os << ",\"repetitions\":" << r.repetitions << ",\"iterations\":" << r.iterations
+       << ",\"median\":" << r.median << ",\"mad\":" << r.mad
+       << ",\"minimum\":" << r.minimum << ",\"mean\":" << r.mean
+       << ",\"ipc\":" << r.instructionsPerCycle
+       << ",\"cacheMissesPerKiloInstruction\":" << r.cacheMissesPerKiloInstruction << "}";
+    if ( i + 1 < results.size() )
+      os << ",";
+    os << std::endl;
+  }
+  os << "]" << std::endl;
+  os.precision ( precision );
+}
+
+void BenchmarkRunner::writeCSV ( std::ostream & os ) const
+{
+  std::streamsize precision = os.precision();
+  os << std::setprecision ( 10 );
+  os << "suite,name,repetitions,iterations,median,mad,minimum,mean,ipc,cacheMissesPerKiloInstruction" << std::endl;
+  for ( size_t i = 0 ; i < results.size() ; i++ )
+  {
+    const BenchmarkResult & r = results[i];
+    writeCSVString ( os, r.suite );
+    os << ",";
+    writeCSVString ( os, r.name );
+    os << "," << r.repetitions << "," << r.iterations << ","
+       << r.median << "," << r.mad << "," << r.minimum << "," << r.mean << ","
+       << r.instructionsPerCycle << "," << r.cacheMissesPerKiloInstruction << std::endl;
+  }
+  os.precision ( precision );
+}
+
+void BenchmarkRunner::readResults ( const std::string & filename, std::vector<BenchmarkResult> & results )
+{
+  std::ifstream ifs ( filename.c_str() );
+  if ( !ifs.good() )
+    fthrow ( Exception, "BenchmarkRunner: unable to read " << filename );
+
+  results.clear();
+  std::string line;
+  bool csvHeader = false;
+  std::vector<std::string> fields;
+  while ( std::getline ( ifs, line ) )
+  {
+    size_t first = line.find_first_not_of ( " \t" );
+    if ( ( first != std::string::npos ) && ( line[first] == '{' ) )
+    {
+      BenchmarkResult r;
+      std::string value;
+      if ( !findJSONField ( line, "suite", r.suite ) || !findJSONField ( line, "name", r.name ) )
+        fthrow ( Exception, "BenchmarkRunner: invalid result in " << filename << ": " << line );
+      if ( findJSONField ( line, "repetitions", value ) ) r.repetitions = (size_t) toDouble ( value );
+      if ( findJSONField ( line, "iterations", value ) ) r.iterations = (size_t) toDouble ( value );
+      if ( findJSONField ( line, "median", value ) ) r.median = toDouble ( value );
+      if ( findJSONField ( line, "mad", value ) ) r.mad = toDouble ( value );
+      if ( findJSONField ( line, "minimum", value ) ) r.minimum = toDouble ( value );
+      if ( findJSONField ( line, "mean", value ) ) r.mean = toDouble ( value );
+      if ( findJSONField ( line, "ipc", value ) ) r.instructionsPerCycle = toDouble ( value );
+      if ( findJSONField ( line, "cacheMissesPerKiloInstruction", value ) ) r.cacheMissesPerKiloInstruction = toDouble ( value );
+      results.push_back ( r );
+    } else if ( line.compare ( 0, 11, "suite,name," ) == 0 ) {
+      csvHeader = true;
+    } else if ( csvHeader && !line.empty() ) {
+      splitCSV ( line, fields );
+      if ( fields.size() < 8 )
+        fthrow ( Exception, "BenchmarkRunner: invalid result in " << filename << ": " << line );
+      BenchmarkResult r;
+      r.suite = fields[0];
+      r.name = fields[1];
+      r.repetitions = (size_t) toDouble ( fields[2] );
+      r.iterations = (size_t) toDouble ( fields[3] );
+      r.median = toDouble ( fields[4] );
+      r.mad = toDouble ( fields[5] );
+      r.minimum = toDouble ( fields[6] );
+      r.mean = toDouble ( fields[7] );
+      if ( fields.size() >= 10 )
+      {
+        r.instructionsPerCycle = toDouble ( fields[8] );
+        r.cacheMissesPerKiloInstruction = toDouble ( fields[9] );
+      }
+      results.push_back ( r );
+    }
+  }
+}
+
+size_t BenchmarkRunner::compare ( const std::vector<BenchmarkResult> & baseline, double threshold, std::ostream & os ) const
+{
+  return compare ( results, baseline, threshold, os );
+}
+
+size_t BenchmarkRunner::compare ( const std::vector<BenchmarkResult> & results,
+                                  const std::vector<BenchmarkResult> & baseline, double threshold, std::ostream & os )
+{
+  std::map<std::string, const BenchmarkResult *> base;
+  for ( size_t i = 0 ; i < baseline.size() ; i++ )
+    base[ baseline[i].suite + "/" + baseline[i].name ] = &(baseline[i]);
+
+  std::ios::fmtflags flags = os.flags();
+  std::streamsize precision = os.precision();
+  os << std::left << std::setw ( 48 ) << "benchmark" << std::right
+     << std::setw ( 14 ) << "baseline[us]" << std::setw ( 14 ) << "current[us]" << std::setw ( 10 ) << "change" << std::endl;
+  os << std::fixed;
+
+  size_t regressions = 0;
+  for ( size_t i = 0 ; i < results.size() ; i++ )
+  {
+    const BenchmarkResult & r = results[i];
+    std::string fullName = r.suite + "/" + r.name;
+    std::map<std::string, const BenchmarkResult *>::const_iterator b = base.find ( fullName );
+    os << std::left << std::setw ( 48 ) << fullName << std::right;
+    if ( b == base.end() )
+    {
+      os << std::setw ( 14 ) << "-" << std::setprecision ( 3 ) << std::setw ( 14 ) << r.median * 1e6 << std::setw ( 10 ) << "new" << std::endl;
+      continue;
+    }
+
+    const BenchmarkResult & old = *(b->second);
+    double change = ( old.median > 0.0 ) ? ( r.median - old.median ) / old.median : 0.0;
+    bool regression = ( change > threshold ) && ( r.median - old.median > 2.0 * ( r.mad + old.mad ) );
+    os << std::setprecision ( 3 ) << std::setw ( 14 ) << old.median * 1e6 << std::setw ( 14 ) << r.median * 1e6
+       << std::setprecision ( 1 ) << std::setw ( 9 ) << change * 100.0 << "%";
+    if ( regression )
+    {
+      os << "  REGRESSION";
+      regressions++;
+    }
+    os << std::endl;
+  }
+
+  os.flags ( flags );
+  os.precision ( precision );
+  return regressions;
+}
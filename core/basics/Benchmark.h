@@ -0,0 +1,168 @@
+/**
+* @file Benchmark.h
+* @brief micro-benchmark harness: warmup, repetitions, robust statistics, JSON/CSV output and baseline comparison
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_BENCHMARKINCLUDE
+#define _NICE_BENCHMARKINCLUDE
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace NICE {
+
+/**
+ * @class BenchmarkCase
+ * @brief A single benchmark: setUp() prepares the data, run() is the measured
+ * operation and tearDown() releases the data. run() is called many times
+ * after a single setUp().
+ */
+class BenchmarkCase
+{
+  public:
+    BenchmarkCase ( const std::string & suite, const std::string & name );
+
+    virtual ~BenchmarkCase ();
+
+    /** prepare the data of the benchmark */
+    virtual void setUp () {};
+
+    /** the measured operation */
+    virtual void run () = 0;
+
+    /** release the data of the benchmark */
+    virtual void tearDown () {};
+
+    const std::string & getSuite () const { return suite; };
+
+    const std::string & getName () const { return name; };
+
+    /** keep a result such that the compiler can not remove its computation */
+    static void keep ( double value );
+
+  private:
+    std::string suite;
+    std::string name;
+};
+
+/** @brief timing of a benchmark, all times are seconds per call of run() */
+struct BenchmarkResult
+{
+  std::string suite;
+  std::string name;
+  //! number of measured repetitions
+  size_t repetitions;
+  //! calls of run() per repetition
+  size_t iterations;
+  //! median time
+  double median;
+  //! median absolute deviation of the times
+  double mad;
+  //! minimum time
+  double minimum;
+  //! mean time
+  double mean;
+  //! instructions per cycle, negative if hardware counters are not available
+  double instructionsPerCycle;
+  //! cache misses per 1000 instructions, negative if not available
+  double cacheMissesPerKiloInstruction;
+
+  BenchmarkResult ();
+};
+
+/**
+ * @class BenchmarkRunner
+ * @brief Runs benchmark cases: after warmup repetitions, the number of calls
+ * per repetition is calibrated such that a repetition takes at least the
+ * minimum time, and each repetition is timed with a monotonic clock. Median and
+ * median absolute deviation are robust against outliers caused by other
+ * processes. Optionally, the process is pinned to a cpu and the hardware
+ * counters (see HardwareCounters) are read during the repetitions.
+ *
+ * Results can be written as JSON or CSV and compared against a baseline file
+ * written by a previous run.
+ */
+class BenchmarkRunner
+{
+  public:
+    BenchmarkRunner ();
+
+    /** deletes all cases */
+    ~BenchmarkRunner ();
+
+    /** add a case (the runner takes ownership) */
+    void add ( BenchmarkCase *benchmark );
+
+    /** number of repetitions which are not measured (default 2) */
+    void setWarmupRepetitions ( int repetitions ) { warmupRepetitions = repetitions; };
+
+    /** number of measured repetitions (default 15) */
+    void setRepetitions ( int repetitions ) { this->repetitions = repetitions; };
+
+    /** minimum time of a repetition in seconds (default 0.05) */
+    void setMinimumTime ( double seconds ) { minimumTime = seconds; };
+
+    /** only run cases whose "suite/name" contains the filter */
+    void setFilter ( const std::string & filter ) { this->filter = filter; };
+
+    /** pin the process to a cpu before running (-1: no pinning, the default) */
+    void setCpu ( int cpu ) { this->cpu = cpu; };
+
+    /** read the hardware counters during the repetitions (default false) */
+    void setUseHardwareCounters ( bool use ) { useHardwareCounters = use; };
+
+    /** run all cases, progress is written to the given stream */
+    void run ( std::ostream & progress );
+
+    const std::vector<BenchmarkResult> & getResults () const { return results; };
+
+    /** write the results as a JSON array (one result per line) */
+    void writeJSON ( std::ostream & os ) const;
+
+    /** write the results as CSV with a header line */
+    void writeCSV ( std::ostream & os ) const;
+
+    /**
+    * @brief compare the results with a baseline and write a table of the changes
+    *
+    * A case regressed if its median is more than threshold (relative) slower
+    * than the baseline and the difference exceeds twice the sum of both MADs.
+    * @return number of regressions
+    */
+    size_t compare ( const std::vector<BenchmarkResult> & baseline, double threshold, std::ostream & os ) const;
+
+    /** compare arbitrary results with a baseline, see compare() */
+    static size_t compare ( const std::vector<BenchmarkResult> & current,
+                            const std::vector<BenchmarkResult> & baseline, double threshold, std::ostream & os );
+
+    /** read results written by writeJSON or writeCSV */
+    static void readResults ( const std::string & filename, std::vector<BenchmarkResult> & results );
+
+    /** pin the calling process to a cpu, returns false if not supported */
+    static bool pinToCpu ( int cpu );
+
+    /** median of the values */
+    static double median ( std::vector<double> values );
+
+    /** median absolute deviation of the values from their median */
+    static double medianAbsoluteDeviation ( const std::vector<double> & values );
+
+  private:
+    std::vector<BenchmarkCase *> cases;
+    std::vector<BenchmarkResult> results;
+    int warmupRepetitions;
+    int repetitions;
+    double minimumTime;
+    std::string filter;
+    int cpu;
+    bool useHardwareCounters;
+
+    BenchmarkRunner ( const BenchmarkRunner & );
+    BenchmarkRunner & operator= ( const BenchmarkRunner & );
+};
+
+} // namespace
+
+#endif
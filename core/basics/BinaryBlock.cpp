@@ -0,0 +1,111 @@
+/**
+* @file BinaryBlock.cpp
+* @brief versioned binary serialization of contiguous arrays of trivially copyable elements
+* @date 10/19/2026
+
+*/
+#include <cstring>
+#include <algorithm>
+
+#include "BinaryBlock.h"
+
+using namespace NICE;
+using namespace std;
+
+namespace {
+
+const char blockMagic[4] = { 'N', 'B', 'L', 'K' };
+
+/** lookup table of the CRC-32 polynomial 0xEDB88320, initialized on first use */
+const unsigned int *crcTable ()
+{
+  static unsigned int table[256];
+  static bool initialized = false;
+  if ( ! initialized )
+  {
+    for ( unsigned int n = 0 ; n < 256 ; n++ )
+    {
+      unsigned int c = n;
+      for ( int k = 0 ; k < 8 ; k++ )
+        c = ( c & 1 ) ? ( 0xEDB88320u ^ ( c >> 1 ) ) : ( c >> 1 );
+      table[n] = c;
+    }
+    initialized = true;
+  }
+  return table;
+}
+
+}
+
+// the table is filled during static initialization, such that crc32Checksum
+// can be used from several threads
+static const unsigned int *crcTableInit = crcTable();
+
+bool NICE::isBigEndianMachine ()
+{
+  unsigned int one = 1;
+  return *( (unsigned char *) &one ) == 0;
+}
+
+unsigned int NICE::crc32Checksum ( const void *data, size_t length, unsigned int crc )
+{
+  const unsigned int *table = crcTable();
+  const unsigned char *p = (const unsigned char *) data;
+  crc = ~crc;
+  for ( size_t i = 0 ; i < length ; i++ )
+    crc = table[ ( crc ^ p[i] ) & 0xFF ] ^ ( crc >> 8 );
+  return ~crc;
+}
+
+void NICE::swapByteOrder ( void *data, size_t n, size_t elementSize )
+{
+  if ( elementSize <= 1 )
+    return;
+
+  unsigned char *p = (unsigned char *) data;
+  for ( size_t i = 0 ; i < n ; i++, p += elementSize )
+    std::reverse ( p, p + elementSize );
+}
+
+BinaryBlockHeader::BinaryBlockHeader ()
+{
+  memcpy ( magic, blockMagic, sizeof(magic) );
+  version = currentVersion;
+  elementType = 0;
+  elementSize = 0;
+  flags = isBigEndianMachine() ? flagBigEndian : 0;
+  rows = 0;
+  cols = 0;
+  checksum = 0;
+  reserved = 0;
+}
+
+bool BinaryBlockHeader::needsByteSwap () const
+{
+  return ( ( flags & flagBigEndian ) != 0 ) != isBigEndianMachine();
+}
+
+void BinaryBlockHeader::write ( obinstream & s ) const
+{
+  s.writeBlock ( magic, sizeof(magic) );
+  s << version << elementType << elementSize << flags << rows << cols << checksum << reserved;
+}
+
+void BinaryBlockHeader::read ( ibinstream & s )
+{
+  s.readBlock ( magic, sizeof(magic) );
+  if ( memcmp ( magic, blockMagic, sizeof(magic) ) != 0 )
+    fthrow ( Exception, "BinaryBlockHeader: invalid magic number, this is not a binary block" );
+
+  s >> version >> elementType >> elementSize >> flags >> rows >> cols >> checksum >> reserved;
+  if ( version > currentVersion )
+    fthrow ( Exception, "BinaryBlockHeader: unsupported version " << (int)version << " (current version is " << (int)currentVersion << ")" );
+
+  if ( needsByteSwap() )
+  {
+    swapByteOrder ( &rows, 1, sizeof(rows) );
+    swapByteOrder ( &cols, 1, sizeof(cols) );
+    swapByteOrder ( &checksum, 1, sizeof(checksum) );
+    swapByteOrder ( &reserved, 1, sizeof(reserved) );
+  }
+}
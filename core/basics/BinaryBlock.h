@@ -0,0 +1,144 @@
+/**
+* @file BinaryBlock.h
+* @brief versioned binary serialization of contiguous arrays of trivially copyable elements
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_BINARYBLOCKINCLUDE
+#define _NICE_BINARYBLOCKINCLUDE
+
+#include <cstddef>
+
+#include "core/basics/binstream.h"
+#include "core/basics/Exception.h"
+
+namespace NICE {
+
+/**
+ * @brief Identification of element types which can be serialized as a
+ * contiguous block of memory. Types with id 0 are serialized element by element.
+ */
+template<class T>
+struct BinaryElementType { enum { id = 0 }; };
+
+template<> struct BinaryElementType<bool> { enum { id = 1 }; };
+template<> struct BinaryElementType<char> { enum { id = 2 }; };
+template<> struct BinaryElementType<signed char> { enum { id = 3 }; };
+template<> struct BinaryElementType<unsigned char> { enum { id = 4 }; };
+template<> struct BinaryElementType<short> { enum { id = 5 }; };
+template<> struct BinaryElementType<unsigned short> { enum { id = 6 }; };
+template<> struct BinaryElementType<int> { enum { id = 7 }; };
+template<> struct BinaryElementType<unsigned int> { enum { id = 8 }; };
+template<> struct BinaryElementType<long> { enum { id = 9 }; };
+template<> struct BinaryElementType<unsigned long> { enum { id = 10 }; };
+template<> struct BinaryElementType<long long> { enum { id = 11 }; };
+template<> struct BinaryElementType<unsigned long long> { enum { id = 12 }; };
+template<> struct BinaryElementType<float> { enum { id = 13 }; };
+template<> struct BinaryElementType<double> { enum { id = 14 }; };
+
+/**
+ * @class BinaryBlockHeader
+ * @brief Header (32 bytes) preceding a block of elements: magic "NBLK",
+ * format version, element type and size, byte order, optional CRC-32 checksum
+ * of the data and up to two dimensions.
+ *
+ * Blocks written on a machine with a different byte order are converted while
+ * reading. The checksum is computed on the data as stored in the file.
+ */
+struct BinaryBlockHeader
+{
+  //! current version of the format
+  static const unsigned char currentVersion = 1;
+
+  //! flag: data is stored in big endian byte order
+  static const unsigned char flagBigEndian = 1;
+  //! flag: the checksum field is valid
+  static const unsigned char flagChecksum = 2;
+
+  char magic[4];
+  unsigned char version;
+  unsigned char elementType;
+  unsigned char elementSize;
+  unsigned char flags;
+  unsigned long long rows;
+  unsigned long long cols;
+  unsigned int checksum;
+  unsigned int reserved;
+
+  /** empty header of the current version for the native byte order */
+  BinaryBlockHeader ();
+
+  /** number of elements of the block */
+  inline size_t numElements () const { return (size_t) ( rows * cols ); };
+
+  /** write the header */
+  void write ( obinstream & s ) const;
+
+  /** read and check the header, multi-byte fields are converted to the native byte order */
+  void read ( ibinstream & s );
+
+  /** true if the data has to be converted to the native byte order */
+  bool needsByteSwap () const;
+};
+
+/** true if this machine uses the big endian byte order */
+bool isBigEndianMachine ();
+
+/** CRC-32 (IEEE 802.3) of a block of memory, continuing a previous checksum crc */
+unsigned int crc32Checksum ( const void *data, size_t length, unsigned int crc = 0 );
+
+/** reverse the byte order of n elements of the given size */
+void swapByteOrder ( void *data, size_t n, size_t elementSize );
+
+/**
+* @brief write a header and a block of n = rows*cols elements with a single
+* write call (in chunks of at most 1GB)
+* @param checksum store a CRC-32 checksum of the data
+*/
+template<class T>
+void writeBinaryBlock ( obinstream & s, const T *data, size_t rows, size_t cols, bool checksum = false )
+{
+  if ( BinaryElementType<T>::id == 0 )
+    fthrow ( Exception, "writeBinaryBlock: element type is not trivially copyable" );
+
+  BinaryBlockHeader header;
+  header.elementType = BinaryElementType<T>::id;
+  header.elementSize = sizeof(T);
+  header.rows = rows;
+  header.cols = cols;
+  size_t bytes = rows * cols * sizeof(T);
+  if ( checksum )
+  {
+    header.flags |= BinaryBlockHeader::flagChecksum;
+    header.checksum = crc32Checksum ( data, bytes );
+  }
+  header.write ( s );
+  s.writeBlock ( (const char *) data, bytes );
+}
+
+/**
+* @brief read the data of a block, the header has to be read before with
+* BinaryBlockHeader::read and the memory for header.numElements() elements
+* has to be allocated
+*/
+template<class T>
+void readBinaryBlockData ( ibinstream & s, const BinaryBlockHeader & header, T *data )
+{
+  if ( ( header.elementType != BinaryElementType<T>::id ) || ( header.elementSize != sizeof(T) ) )
+    fthrow ( Exception, "readBinaryBlockData: stored element type " << (int)header.elementType
+             << " (" << (int)header.elementSize << " bytes) differs from the requested type "
+             << (int)BinaryElementType<T>::id << " (" << sizeof(T) << " bytes)" );
+
+  size_t bytes = header.numElements() * sizeof(T);
+  s.readBlock ( (char *) data, bytes );
+
+  if ( ( header.flags & BinaryBlockHeader::flagChecksum ) && ( crc32Checksum ( data, bytes ) != header.checksum ) )
+    fthrow ( Exception, "readBinaryBlockData: checksum mismatch, the data is corrupted" );
+
+  if ( header.needsByteSwap() )
+    swapByteOrder ( data, header.numElements(), sizeof(T) );
+}
+
+} // namespace
+
+#endif
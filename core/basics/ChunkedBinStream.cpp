@@ -0,0 +1,201 @@
+/**
+* @file ChunkedBinStream.cpp
+* @brief binary streams compressing the data in independent chunks
+* @date 10/19/2026
+
+*/
+#include <cstring>
+#include <algorithm>
+
+#ifdef NICE_USELIB_ZLIB
+#include <zlib.h>
+#endif
+
+#include "core/basics/Exception.h"
+#include "ChunkedBinStream.h"
+
+using namespace NICE;
+using namespace std;
+
+namespace {
+
+const char streamMagic[8] = { 'N', 'I', 'C', 'E', 'C', 'H', 'K', '1' };
+
+}
+
+ochunkedbinstream::ochunkedbinstream ( const char *name, size_t chunkSize, int compressionLevel )
+  : stream ( name, ios::out | ios::binary ), used ( 0 ), chunkSize ( chunkSize ), compressionLevel ( compressionLevel )
+{
+  if ( chunkSize == 0 || chunkSize > ( 1u << 30 ) )
+    fthrow ( Exception, "ochunkedbinstream: invalid chunk size " << chunkSize );
+  if ( ! stream.is_open() )
+    fthrow ( Exception, "ochunkedbinstream: unable to open " << name );
+
+  buffer.resize ( chunkSize );
+  stream.write ( streamMagic, sizeof(streamMagic) );
+  unsigned int size = (unsigned int) chunkSize;
+  stream.write ( (const char *) &size, sizeof(size) );
+}
+
+ochunkedbinstream::~ochunkedbinstream ()
+{
+  if ( stream.is_open() )
+    close();
+}
+
+void ochunkedbinstream::writeChunk ( const char *data, size_t length )
+{
+  unsigned int sizes[2];
+  sizes[0] = (unsigned int) length;
+  sizes[1] = (unsigned int) length;
+  const char *stored = data;
+
+#ifdef NICE_USELIB_ZLIB
+  if ( compressionLevel > 0 )
+  {
+    uLongf compressedLength = compressBound ( length );
+    compressed.resize ( compressedLength );
+    if ( ( compress2 ( (Bytef *) &(compressed[0]), &compressedLength, (const Bytef *) data, length, compressionLevel ) == Z_OK )
+         && ( compressedLength < length ) )
+    {
+      sizes[1] = (unsigned int) compressedLength;
+      stored = &(compressed[0]);
+    }
+  }
+#endif
+
+  stream.write ( (const char *) sizes, sizeof(sizes) );
+  stream.write ( stored, sizes[1] );
+}
+
+void ochunkedbinstream::write ( char *data, unsigned int length )
+{
+  while ( length > 0 )
+  {
+    // complete chunks are compressed without copying
+    if ( ( used == 0 ) && ( length >= chunkSize ) )
+    {
+      writeChunk ( data, chunkSize );
+      data += chunkSize;
+      length -= chunkSize;
+      continue;
+    }
+
+    size_t n = std::min ( (size_t) length, chunkSize - used );
+    memcpy ( &(buffer[used]), data, n );
+    used += n;
+    data += n;
+    length -= n;
+
+    if ( used == chunkSize )
+    {
+      writeChunk ( &(buffer[0]), used );
+      used = 0;
+    }
+  }
+}
+
+void ochunkedbinstream::close ()
+{
+  if ( used > 0 )
+    writeChunk ( &(buffer[0]), used );
+  used = 0;
+
+  // a chunk of size zero marks the end of the stream
+  unsigned int sizes[2] = { 0, 0 };
+  stream.write ( (const char *) sizes, sizeof(sizes) );
+  stream.close();
+}
+
+ichunkedbinstream::ichunkedbinstream ( const char *name )
+  : stream ( name, ios::in | ios::binary ), position ( 0 ), available ( 0 ), finished ( false )
+{
+  if ( ! stream.is_open() )
+    fthrow ( Exception, "ichunkedbinstream: unable to open " << name );
+
+  char magic[sizeof(streamMagic)];
+  unsigned int size;
+  stream.read ( magic, sizeof(magic) );
+  stream.read ( (char *) &size, sizeof(size) );
+  if ( ! stream.good() || memcmp ( magic, streamMagic, sizeof(magic) ) != 0 )
+    fthrow ( Exception, "ichunkedbinstream: " << name << " is not a chunked binary stream" );
+}
+
+ichunkedbinstream::~ichunkedbinstream ()
+{
+}
+
+bool ichunkedbinstream::readChunkHeader ( unsigned int & rawSize, unsigned int & storedSize )
+{
+  if ( finished )
+    return false;
+
+  unsigned int sizes[2];
+  stream.read ( (char *) sizes, sizeof(sizes) );
+  if ( stream.gcount() != (streamsize) sizeof(sizes) )
+    fthrow ( Exception, "ichunkedbinstream: unexpected end of the file" );
+
+  rawSize = sizes[0];
+  storedSize = sizes[1];
+  if ( rawSize == 0 )
+    finished = true;
+
+  return ! finished;
+}
+
+void ichunkedbinstream::readChunkData ( char *dst, unsigned int rawSize, unsigned int storedSize )
+{
+  if ( storedSize == rawSize )
+  {
+    stream.read ( dst, rawSize );
+    if ( stream.gcount() != (streamsize) rawSize )
+      fthrow ( Exception, "ichunkedbinstream: unexpected end of the file" );
+    return;
+  }
+
+#ifdef NICE_USELIB_ZLIB
+  compressed.resize ( storedSize );
+  stream.read ( &(compressed[0]), storedSize );
+  if ( stream.gcount() != (streamsize) storedSize )
+    fthrow ( Exception, "ichunkedbinstream: unexpected end of the file" );
+
+  uLongf length = rawSize;
+  if ( ( uncompress ( (Bytef *) dst, &length, (const Bytef *) &(compressed[0]), storedSize ) != Z_OK ) || ( length != rawSize ) )
+    fthrow ( Exception, "ichunkedbinstream: corrupted chunk" );
+#else
+  fthrow ( Exception, "ichunkedbinstream: the file contains compressed chunks, but zlib is not available (NICE_USELIB_ZLIB)" );
+#endif
+}
+
+void ichunkedbinstream::read ( char *data, unsigned int length )
+{
+  while ( length > 0 )
+  {
+    if ( position < available )
+    {
+      size_t n = std::min ( (size_t) length, available - position );
+      memcpy ( data, &(buffer[position]), n );
+      position += n;
+      data += n;
+      length -= n;
+      continue;
+    }
+
+    unsigned int rawSize, storedSize;
+    if ( ! readChunkHeader ( rawSize, storedSize ) )
+      fthrow ( Exception, "ichunkedbinstream: read beyond the end of the stream" );
+
+    if ( rawSize <= length )
+    {
+      // the whole chunk is requested: decompress directly into the destination
+      readChunkData ( data, rawSize, storedSize );
+      data += rawSize;
+      length -= rawSize;
+    } else {
+      buffer.resize ( rawSize );
+      readChunkData ( &(buffer[0]), rawSize, storedSize );
+      position = 0;
+      available = rawSize;
+    }
+  }
+}
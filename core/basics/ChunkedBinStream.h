@@ -0,0 +1,101 @@
+/**
+* @file ChunkedBinStream.h
+* @brief binary streams compressing the data in independent chunks
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_CHUNKEDBINSTREAMINCLUDE
+#define _NICE_CHUNKEDBINSTREAMINCLUDE
+
+#include <fstream>
+#include <vector>
+
+#include "core/basics/binstream.h"
+
+namespace NICE {
+
+/**
+ * @class ochunkedbinstream
+ * @brief Output binary stream, which collects the data in chunks (default 4MB)
+ * and compresses each chunk with a single zlib call.
+ *
+ * In contrast to ogzbinstream, large blocks (see obinstream::writeBlock) are
+ * compressed directly from the memory of the caller and small writes only
+ * copy into the chunk buffer, such that writing is bounded by the speed of
+ * zlib instead of the overhead of the calls. Each chunk is preceded by its
+ * raw and compressed size; incompressible chunks and all chunks of a build
+ * without zlib (NICE_USELIB_ZLIB) are stored uncompressed.
+ */
+class ochunkedbinstream : public obinstream
+{
+  private:
+    std::ofstream stream;
+    std::vector<char> buffer;
+    std::vector<char> compressed;
+    size_t used;
+    size_t chunkSize;
+    int compressionLevel;
+
+    /** compress and write a chunk */
+    void writeChunk ( const char *data, size_t length );
+
+  public:
+    /**
+    * @brief open a file for writing
+    * @param name file name
+    * @param chunkSize number of uncompressed bytes of a chunk
+    * @param compressionLevel zlib compression level (0-9)
+    */
+    ochunkedbinstream ( const char *name, size_t chunkSize = 4*1024*1024, int compressionLevel = 6 );
+
+    /** the stream is closed */
+    virtual ~ochunkedbinstream ();
+
+    virtual void write ( char *data, unsigned int length );
+
+    /** write the remaining data and close the file */
+    void close ();
+
+    inline bool good () const { return stream.good(); };
+    inline bool fail () const { return stream.fail(); };
+};
+
+/**
+ * @class ichunkedbinstream
+ * @brief Input binary stream reading files of ochunkedbinstream. Chunks which
+ * are read completely by a single call are decompressed directly into the
+ * memory of the caller.
+ */
+class ichunkedbinstream : public ibinstream
+{
+  private:
+    std::ifstream stream;
+    std::vector<char> buffer;
+    std::vector<char> compressed;
+    size_t position;
+    size_t available;
+    bool finished;
+
+    /** read the sizes of the next chunk, returns false at the end of the stream */
+    bool readChunkHeader ( unsigned int & rawSize, unsigned int & storedSize );
+
+    /** read and decompress the data of a chunk */
+    void readChunkData ( char *dst, unsigned int rawSize, unsigned int storedSize );
+
+  public:
+    /** open a file for reading */
+    ichunkedbinstream ( const char *name );
+
+    virtual ~ichunkedbinstream ();
+
+    /** read length bytes, throws an exception at the end of the stream */
+    virtual void read ( char *data, unsigned int length );
+
+    inline void close () { stream.close(); };
+    inline bool good () const { return stream.good(); };
+    inline bool fail () const { return stream.fail(); };
+};
+
+} // namespace
+
+#endif
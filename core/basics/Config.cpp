@@ -15,6 +15,7 @@
 #include "core/basics/ossettings.h"
 #include "core/basics/StringTools.h"
 #include "core/basics/FileName.h"
+#include "core/basics/Log.h"
 
 using ::std::endl;
 using ::std::vector;
@@ -25,17 +26,75 @@ using ::std::ios;
 using ::std::map;
 
 #undef DEBUGCONFIG
-#define DEBUGPRINT printf
+
+namespace {
+
+inline bool isDigit ( char c ) { return ( c >= '0' ) && ( c <= '9' ); }
+inline bool isAlpha ( char c ) { return ( ( c >= 'a' ) && ( c <= 'z' ) ) || ( ( c >= 'A' ) && ( c <= 'Z' ) ); }
+inline bool isNameChar ( char c ) { return isAlpha ( c ) || isDigit ( c ) || ( c == '_' ) || ( c == '-' ); }
+inline bool isIntegerChar ( char c ) { return isDigit ( c ) || ( c == '-' ); }
+inline bool isDoubleChar ( char c ) { return isDigit ( c ) || ( c == '-' ) || ( c == 'e' ) || ( c == '.' ); }
+
+/** tokenizer for " *([allowed characters]+) *;?" covering the whole value */
+bool matchNumber ( const std::string & value, bool (*allowed)(char), std::string & token )
+{
+  size_t len = value.size();
+  size_t i = 0;
+  while ( ( i < len ) && ( value[i] == ' ' ) ) i++;
+  size_t start = i;
+  while ( ( i < len ) && allowed ( value[i] ) ) i++;
+  if ( i == start )
+    return false;
+  token = value.substr ( start, i - start );
+  while ( ( i < len ) && ( value[i] == ' ' ) ) i++;
+  if ( ( i < len ) && ( value[i] == ';' ) ) i++;
+  return ( i == len );
+}
+
+/**
+* tokenizer for command line options "--?section:key" and "--?key", where
+* section starts with a letter and consists of letters, digits, '_' and '-'
+* @return 0 if arg is not an option, 1 for key only and 2 for section and key
+*/
+int matchOption ( const std::string & arg, std::string & section, std::string & key )
+{
+  size_t len = arg.size();
+  size_t i = 0;
+  if ( ( i < len ) && ( arg[i] == '-' ) ) i++; else return 0;
+  if ( ( i < len ) && ( arg[i] == '-' ) ) i++;
+  if ( ( i >= len ) || !isAlpha ( arg[i] ) )
+    return 0;
+
+  size_t start = i;
+  while ( ( i < len ) && isNameChar ( arg[i] ) ) i++;
+  std::string name = arg.substr ( start, i - start );
+
+  if ( ( i + 1 < len ) && ( arg[i] == ':' ) && isNameChar ( arg[i+1] ) )
+  {
+    size_t keyStart = ++i;
+    while ( ( i < len ) && isNameChar ( arg[i] ) ) i++;
+    section = name;
+    key = arg.substr ( keyStart, i - keyStart );
+    return 2;
+  }
+
+  key = name;
+  return 1;
+}
+
+}
 
 namespace NICE {
 
 Config::Config ()
 {
   ioUntilEndOfFile = true;
+  generation = 1;
 }
 
 Config::Config ( const std::string & configfn )
 {
+  generation = 1;
   if ( configfn.size() >0 ) {
     read(configfn);
   }
@@ -46,6 +105,7 @@ Config::Config ( const std::string & configfn )
 Config::Config ( int argc, 
          char **argv )
 {
+  generation = 1;
   readFromArguments ( argc, argv );
   std::string configfile = gS("main", "config", "" );
 
@@ -63,7 +123,7 @@ Config::Config ( int argc,
       configfile = t_ConfigFilename.str();
   }
   m_sConfigFilename = configfile;
-  std::cerr << "configfile: " << configfile << std::endl;
+  NICE_LOG_DEBUG ( "configfile: " << configfile );
   ioUntilEndOfFile = gB("main", "ioUntilEndOfFile", true );
   if ( configfile.size() > 0 )
     readWithoutOverwrite ( configfile.c_str(), CONFIG_DO_NOT_OVERWRITE_VALUES /*do not overwrite values*/ );
@@ -72,6 +132,7 @@ Config::Config ( int argc,
 Config::Config ( const Config & conf ) : Persistent()
 {
   ioUntilEndOfFile = true;
+  generation = 1;
   m_sConfigFilename = conf.m_sConfigFilename;
 	confB.copyFrom ( conf.confB );
 	confD.copyFrom ( conf.confD );
@@ -79,6 +140,23 @@ Config::Config ( const Config & conf ) : Persistent()
 	confS.copyFrom ( conf.confS );
 }
 
+Config & Config::operator= ( const Config & conf )
+{
+  if ( this == &conf )
+    return *this;
+
+  confD = conf.confD;
+  confI = conf.confI;
+  confB = conf.confB;
+  confS = conf.confS;
+  helpTexts = conf.helpTexts;
+  moreOptions = conf.moreOptions;
+  ioUntilEndOfFile = conf.ioUntilEndOfFile;
+  m_sConfigFilename = conf.m_sConfigFilename;
+  generation++;
+  return *this;
+}
+
 Config::~Config()
 {
 }
@@ -86,56 +164,49 @@ Config::~Config()
 void Config::clear()
 {
 #if defined DEBUGCONFIG
-	DEBUGPRINT( "Config: clear ...\n" );
+	NICE_LOG_DEBUG ( "Config: clear ..." );
 #endif
   confB.clear();
   confD.clear();
   confI.clear();
 	confS.clear();
+  generation++;
 }
 
 void Config::addKeyValuePair ( const std::string & block,
 			       const std::string & key, 
 			       const std::string & value )
 {
-    vector<string> submatches;
+    std::string token;
+    double v;
+    generation++;
 #if defined DEBUGCONFIG
-	DEBUGPRINT( "Config: analyzing value %s\n", value.c_str() );
+	NICE_LOG_DEBUG ( "Config: analyzing value " << value );
 #endif
-    if ( StringTools::regexMatch ( value, "^ *([-[:digit:]]+) *;?$", submatches ) &&
-	     (submatches.size() == 2) ) {
+    if ( matchNumber ( value, isIntegerChar, token ) ) {
 #if defined DEBUGCONFIG
-	    DEBUGPRINT ( "Config: integer value\n");
+	    NICE_LOG_DEBUG ( "Config: integer value" );
 #endif
-	    int v;
-	    v = StringTools::convert<int> ( submatches[1] );
-	    confI.store ( block, key, v );
+	    confI.store ( block, key, StringTools::convert<int> ( token ) );
     } else if ( value.compare("true") == 0 ) {
 #if defined DEBUGCONFIG
-	    DEBUGPRINT( "Config: boolean value\n");
+	    NICE_LOG_DEBUG ( "Config: boolean value" );
 #endif
 		confB.store ( block, key, true );
     } else if ( value.compare("false") == 0 ) {	    
 #if defined DEBUGCONFIG
-	    DEBUGPRINT ( "Config: boolean value\n");
+	    NICE_LOG_DEBUG ( "Config: boolean value" );
 #endif
 		confB.store ( block, key, false );
-    } else if ( StringTools::regexMatch ( value, "^ *([-e.[:digit:]]+) *;?$", submatches ) &&
-	     (submatches.size() == 2) ) 
+    } else if ( matchNumber ( value, isDoubleChar, token ) && StringTools::convert<double> ( token, v ) )
     {
-	double v;
-	if ( ! StringTools::convert<double> ( submatches[1], v )  ) 
-	{
-	    DEBUGPRINT ( "Config: please ask Erik to debug this part of Config.cpp\n");
-	    exit(-1);
-	}
 	#if defined DEBUGCONFIG
-	    DEBUGPRINT ( "Config: double value\n");
+	    NICE_LOG_DEBUG ( "Config: double value" );
 	#endif
 	confD.store ( block, key, v );
     } else {
 #if defined DEBUGCONFIG
-	    DEBUGPRINT ( "Config: string value\n");
+	    NICE_LOG_DEBUG ( "Config: string value" );
 #endif
 		string trimValue = value;
 	    StringTools::trimbounds ( trimValue, '\"' );
@@ -156,27 +227,15 @@ void Config::readFromArguments ( int argc, char **argv )
       if ( argv[i] == NULL ) break;
       std::string arg ( argv[i] );
 
-      vector<string> submatches;
-      bool match = false;
-
-      match = StringTools::regexMatch ( arg, "^--?([[:alpha:]][[:alpha:][:digit:]_-]*):([[:alpha:][:digit:]_-]+)", submatches );
-      if ( (match) && (submatches.size() == 3) ) {
+      std::string newSection;
+      std::string newKey;
+      int match = matchOption ( arg, newSection, newKey );
+      if ( match > 0 ) {
         if ( key.size() > 0 ) {
           addArgBoolean ( section, key );
         }
-        section = submatches[1];
-        key     = submatches[2];
-        continue;
-      }
-
-      match = StringTools::regexMatch ( arg, "^--?([[:alpha:]][[:alpha:][:digit:]_-]*)", submatches );
-      if ( (match) && (submatches.size() == 2) ) {
-        if ( key.size() > 0 )	
-        {
-          addArgBoolean ( section, key );
-        }
-        section = "main";
-        key = submatches[1];
+        section = ( match == 2 ) ? newSection : "main";
+        key     = newKey;
         continue;
       }
 
@@ -190,7 +249,7 @@ void Config::readFromArguments ( int argc, char **argv )
       }
 
   #if defined DEBUGCONFIG
-      cout << "Config: add command line option: " << section << ":" << key << " = " << value << endl;
+      NICE_LOG_DEBUG ( "Config: add command line option: " << section << ":" << key << " = " << value );
   #endif
       addKeyValuePair ( section, key, value );
 
@@ -203,11 +262,10 @@ void Config::readFromArguments ( int argc, char **argv )
 
 void Config::addArgBoolean ( const std::string & section, const std::string & key )
 {
-    vector<string> submatches;
-    if ( StringTools::regexMatch ( key, "^no-(.*)$", submatches )
-		&& (submatches.size() == 2) )
+    generation++;
+    if ( key.compare ( 0, 3, "no-" ) == 0 )
     {
-		confB.store ( section, submatches[1], false );
+		confB.store ( section, key.substr(3), false );
     } else {
 		confB.store ( section, key, true );
     }
@@ -264,8 +322,7 @@ void Config::restore (istream & is, int format)
       len = line.size();
 
   #if defined DEBUGCONFIG
-      DEBUGPRINT ("Config: (%d) '%s' (len = %d) / %s\n", static_cast<int>(count), line.c_str(), static_cast<int>(len),
-        block.c_str());
+      NICE_LOG_DEBUG ( "Config: (" << count << ") '" << line << "' (len = " << len << ") / " << block );
   #endif
 
       while ( ( (line[i] == '\t') || (line[i]==' ') ) && (i<len)) i++;
@@ -278,7 +335,7 @@ void Config::restore (istream & is, int format)
 
         block = line.substr( i+1, j-i-1 );
   #if defined DEBUGCONFIG
-        DEBUGPRINT ("Config: reading block %s\n", block.c_str());
+        NICE_LOG_DEBUG ( "Config: reading block " << block );
   #endif
         StringTools::normalize_string(block);
         continue;
@@ -292,7 +349,7 @@ void Config::restore (istream & is, int format)
         std::string includefile = line.substr( i+1, j-i-1 );
 
   #if defined DEBUGCONFIG
-        DEBUGPRINT ("Config: including config file %s\n", includefile.c_str());
+        NICE_LOG_DEBUG ( "Config: including config file " << includefile );
   #endif
         StringTools::normalize_string ( includefile );
 
@@ -311,8 +368,7 @@ void Config::restore (istream & is, int format)
     //	transform(key.begin(), key.end(), key.begin(), ::tolower);
 
   #if defined DEBUGCONFIG
-      DEBUGPRINT ("Config: found key value pair (%s,%s) in section %s\n", 
-        key.c_str(), value.c_str(), block.c_str());
+      NICE_LOG_DEBUG ( "Config: found key value pair (" << key << "," << value << ") in section " << block );
   #endif
 
       if ( (format == CONFIG_OVERWRITE_VALUES) || ( !keyExists(block, key) ) )
@@ -321,11 +377,9 @@ void Config::restore (istream & is, int format)
     }
 
 #if defined DEBUGCONFIG
-    DEBUGPRINT ("Config: successfully loaded.\n" );
-    DEBUGPRINT ("Config: %d double values\n", static_cast<int>(confD.size()) );
-    DEBUGPRINT ("Config: %d integer values\n", static_cast<int>(confI.size()) );
-    DEBUGPRINT ("Config: %d bool values\n", static_cast<int>(confB.size()) );
-    DEBUGPRINT ("Config: %d std::string values\n", static_cast<int>(confS.size()) );
+    NICE_LOG_DEBUG ( "Config: successfully loaded: " << confD.size() << " double values, "
+                     << confI.size() << " integer values, " << confB.size() << " bool values, "
+                     << confS.size() << " std::string values" );
 #endif
 }
       
@@ -382,7 +436,7 @@ std::string Config::gS(const std::string & block, const std::string & key, const
 		return v;
     } else {
 #if defined DEBUGCONFIG
-		DEBUGPRINT("Config: Setting %s::%s not found using default value %s\n", block.c_str(), key.c_str(), defv.c_str() );
+		NICE_LOG_DEBUG ( "Config: Setting " << block << "::" << key << " not found using default value " << defv );
 #endif
 		return defv;
     }
@@ -396,17 +450,17 @@ double Config::gD(const std::string & key) const
 
 double Config::gD(const std::string & block, const std::string & key) const
 {
-    double v = 0.0;
-    if ( confD.find(block, key, v) ) {
-		return v;
+    const double *v = confD.lookup ( block, key );
+    if ( v != NULL ) {
+		return *v;
     } else {
-		int vi;
-		if ( confI.find(block, key, vi) ) {
-			DEBUGPRINT("Config: Setting %s::%s should be double (please change in the config)\n", block.c_str(), key.c_str() );
-			return static_cast<int>(vi);
+		const int *vi = confI.lookup ( block, key );
+		if ( vi != NULL ) {
+			NICE_LOG_WARNING ( "Config: Setting " << block << "::" << key << " should be double (please change in the config)" );
+			return static_cast<int>(*vi);
 		}
-		fprintf (stderr, "Config: setting %s::%s not found !\n", block.c_str(), key.c_str() );
-		fprintf (stderr, "Config: %s\n", help(block, key).c_str() );
+		NICE_LOG_ERROR ( "Config: setting " << block << "::" << key << " not found !" );
+		NICE_LOG_ERROR ( "Config: " << help(block, key) );
 		exit(-1);
 		return -1.0; // never reached
     }
@@ -414,17 +468,17 @@ double Config::gD(const std::string & block, const std::string & key) const
 
 double Config::gD(const std::string & block, const std::string & key, const double defv) const
 {
-    double v = 0.0;
-    if ( confD.find(block, key,  v) ) {
-		return v;
+    const double *v = confD.lookup ( block, key );
+    if ( v != NULL ) {
+		return *v;
     } else {
-		int vi;
-		if ( confI.find(block, key, vi) ) {
-			DEBUGPRINT("Config: Setting %s::%s should be double (please change in the config)\n", block.c_str(), key.c_str() );
-			return static_cast<int>(vi);
+		const int *vi = confI.lookup ( block, key );
+		if ( vi != NULL ) {
+			NICE_LOG_WARNING ( "Config: Setting " << block << "::" << key << " should be double (please change in the config)" );
+			return static_cast<int>(*vi);
 		}
 #if defined DEBUGCONFIG
-		DEBUGPRINT("Config: Setting %s::%s not found using default value %f\n", block.c_str(), key.c_str(), defv );
+		NICE_LOG_DEBUG ( "Config: Setting " << block << "::" << key << " not found using default value " << defv );
 #endif
 		return defv;
     }
@@ -442,8 +496,8 @@ int Config::gI(const std::string & block, const std::string & key) const
     if ( confI.find(block, key, v) ) {
 		return v;
     } else {
-		fprintf (stderr, "Config: setting %s::%s not found !\n", block.c_str(), key.c_str() );
-		fprintf (stderr, "Config: %s\n", help(block, key).c_str() );
+		NICE_LOG_ERROR ( "Config: setting " << block << "::" << key << " not found !" );
+		NICE_LOG_ERROR ( "Config: " << help(block, key) );
 		exit(-1);
 		return 1; // never reached
     }
@@ -457,7 +511,7 @@ int Config::gI(const std::string & block, const std::string & key, int defv) con
 		return v;
     } else {
 #if defined DEBUGCONFIG
-		DEBUGPRINT("Config: Setting %s::%s not found using default value %d\n", block.c_str(), key.c_str(), defv );
+		NICE_LOG_DEBUG ( "Config: Setting " << block << "::" << key << " not found using default value " << defv );
 #endif
 		return defv;
     }
@@ -474,8 +528,8 @@ bool Config::gB(const std::string & block, const std::string & key) const
     if ( confB.find(block, key, v) ) {
 		return v;
     } else {
-		fprintf (stderr, "Config: setting %s::%s not found !\n", block.c_str(), key.c_str() );
-		fprintf (stderr, "Config: %s\n", help(block, key).c_str() );
+		NICE_LOG_ERROR ( "Config: setting " << block << "::" << key << " not found !" );
+		NICE_LOG_ERROR ( "Config: " << help(block, key) );
 		exit(-1);
 		return true; // never reached
     }
@@ -489,7 +543,7 @@ bool Config::gB(const std::string & block, const std::string & key, bool defv) c
 		return v;
     } else {
 #if defined DEBUGCONFIG
-		DEBUGPRINT("Config: Setting %s::%s not found using default value %d\n", block.c_str(), key.c_str(), defv );
+		NICE_LOG_DEBUG ( "Config: Setting " << block << "::" << key << " not found using default value " << defv );
 #endif
 		return defv;
     }
@@ -518,21 +572,25 @@ void Config::getAllB ( const std::string & block, std::map< string, bool > & lis
 void Config::sD(const std::string & block, const std::string & key, const double defv)
 {
     confD.store ( block, key, defv );
+    generation++;
 }
 
 void Config::sI(const std::string & block, const std::string & key, const int defv)
 {
 	confI.store ( block, key, defv );
+	generation++;
 }
 
 void Config::sB(const std::string & block, const std::string & key, const bool defv)
 {
 	confB.store ( block, key, defv );
+	generation++;
 }
 
 void Config::sS(const std::string & block, const std::string & key, const std::string & defv)
 {
 	confS.store ( block, key, defv );
+	generation++;
 }
 
 void Config::store (ostream & os, int format) const 
@@ -56,8 +56,80 @@ class Config : public NICE::Persistent
 
     /** stores filename the config was created from*/
     std::string m_sConfigFilename;
+
+    /** incremented whenever values are added, changed or removed (see Handle) */
+    unsigned int generation;
+
+    /** typed access used by Handle */
+    void lookupValue ( const std::string & block, const std::string & key, const double *defv, double & v ) const
+      { v = ( defv == NULL ) ? gD ( block, key ) : gD ( block, key, *defv ); };
+    void lookupValue ( const std::string & block, const std::string & key, const int *defv, int & v ) const
+      { v = ( defv == NULL ) ? gI ( block, key ) : gI ( block, key, *defv ); };
+    void lookupValue ( const std::string & block, const std::string & key, const bool *defv, bool & v ) const
+      { v = ( defv == NULL ) ? gB ( block, key ) : gB ( block, key, *defv ); };
+    void lookupValue ( const std::string & block, const std::string & key, const std::string *defv, std::string & v ) const
+      { v = ( defv == NULL ) ? gS ( block, key ) : gS ( block, key, *defv ); };
+
   public:
 
+      /**
+       * @brief Typed handle of a config value (double, int, bool or std::string).
+       *
+       * The value is looked up once with the same rules as gD/gI/gB/gS (including
+       * the default value) and cached in the handle. Reading the value only
+       * compares a generation counter of the config and takes O(1); the lookup is
+       * repeated automatically after the config was modified. Use handles for
+       * values which are read in inner loops:
+       * <code>
+       * Config::Handle<double> sigma ( conf, "Kernel", "sigma", 1.0 );
+       * for ( ... ) d = exp ( - x / sigma() );
+       * </code>
+       * The config has to exist as long as the handle is used.
+       */
+      template<class T>
+      class Handle
+      {
+        protected:
+          const Config *config;
+          std::string block;
+          std::string key;
+          bool hasDefault;
+          T defaultValue;
+          mutable T value;
+          mutable unsigned int generation;
+
+          void resolve () const
+          {
+            config->lookupValue ( block, key, hasDefault ? &defaultValue : NULL, value );
+            generation = config->generation;
+          }
+
+        public:
+          /** empty handle, a handle has to be assigned before it is used */
+          Handle () : config ( NULL ), hasDefault ( false ), defaultValue(), value(), generation ( 0 ) {};
+
+          /** handle of a required value, the value is looked up immediately */
+          Handle ( const Config & conf, const std::string & block, const std::string & key )
+            : config ( &conf ), block ( block ), key ( key ), hasDefault ( false ), defaultValue(), value(), generation ( 0 )
+          { resolve(); };
+
+          /** handle of a value with a default value, the value is looked up immediately */
+          Handle ( const Config & conf, const std::string & block, const std::string & key, const T & defv )
+            : config ( &conf ), block ( block ), key ( key ), hasDefault ( true ), defaultValue ( defv ), value(), generation ( 0 )
+          { resolve(); };
+
+          /** current value */
+          inline const T & get () const
+          {
+            if ( generation != config->generation )
+              resolve();
+            return value;
+          };
+
+          /** current value */
+          inline const T & operator() () const { return get(); };
+      };
+
       /** simplest constructor, create an empty config */
       Config ();
 
@@ -74,6 +146,10 @@ class Config : public NICE::Persistent
 	  /** copy constructor */
 	  Config ( const Config & conf );
 
+      /** assignment operator, the generation of this config is incremented
+       * (and not copied) such that existing handles notice the new values */
+      Config & operator= ( const Config & conf );
+
       /** simple destructor */
       virtual ~Config();
 
@@ -47,5 +47,20 @@ inline float roundf(float r)
 }
 #endif
 
+/////////////////////////////////////////////////////////////////////
+// thread local storage of POD types (C++98 compilers only offer extensions)
+#ifdef _MSC_VER
+#   define NICE_THREAD_LOCAL __declspec(thread)
+#else
+#   define NICE_THREAD_LOCAL __thread
+#endif
+
+/////////////////////////////////////////////////////////////////////
+// move constructors and move assignments are only compiled if the compiler
+// supports rvalue references, the library itself stays C++98
+#if __cplusplus >= 201103L || ( defined(_MSC_VER) && _MSC_VER >= 1600 )
+#   define NICE_HAS_RVALUE_REFERENCES
+#endif
+
 
 #endif //CROSSPLATFORMDEFINES_H
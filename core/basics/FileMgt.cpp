@@ -27,6 +27,7 @@ i*/
 
 #include <errno.h>
 #include <string.h>
+#include "core/basics/Log.h"
 
 using namespace NICE;
 
@@ -44,8 +45,8 @@ void FileMgt::DirectoryRecursive ( std::vector<string> & files, const std::strin
 	//cerr << "FileMgt::DirectoryRecursive: popen issued !" << endl;
 	if ( pipe == NULL ) {
     int errsv = errno; //just to be sure that the writing on std::cerr does not change the errno
-		cerr << "FileMgt::DirectoryRecursive: find command failed (" << command << ")" << endl;
-    std::cerr << "FileMgt::DirectoryRecursive: popen error message is " << strerror(errsv) << std::endl;
+		NICE_LOG_ERROR ( "FileMgt::DirectoryRecursive: find command failed (" << command << ")" );
+    NICE_LOG_ERROR ( "FileMgt::DirectoryRecursive: popen error message is " << strerror(errsv) );
 		return;
 	}
 	char line[MAXLINESIZE];
@@ -102,8 +103,8 @@ std::string FileMgt::createTempFile ( const std::string & templatefn )
 
 	if ( fd < 0 ) 
 	{
-		string errormessage = "FileMgt::createTempFile: FATAL ERROR unable to create temporary filename with template "+templatefn+".\n";
-		fprintf (stderr,"%s", errormessage.c_str());
+		string errormessage = "FileMgt::createTempFile: FATAL ERROR unable to create temporary filename with template "+templatefn+".";
+		NICE_LOG_ERROR ( errormessage );
 		throw (errormessage.c_str());
 	}
 
@@ -122,8 +123,8 @@ void FileMgt::deleteTempFile ( const std::string & tempfile )
 	if ( unlink(tempfile.c_str()) != 0 )
 #endif
     {
-		string errormessage = "FileMgt::deleteTempFile: FATAL ERROR removing "+tempfile+".\n";
-		fprintf (stderr,"%s", errormessage.c_str());
+		string errormessage = "FileMgt::deleteTempFile: FATAL ERROR removing "+tempfile+".";
+		NICE_LOG_ERROR ( errormessage );
 		throw (errormessage.c_str());
     }
 }
@@ -0,0 +1,120 @@
+/**
+* @file HardwareCounters.cpp
+* @brief hardware performance counters (cycles, instructions, cache and branch misses) of the calling thread
+* @date 10/19/2026
+
+*/
+#ifdef __linux__
+#include <cstring>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "HardwareCounters.h"
+
+using namespace NICE;
+using namespace std;
+
+#ifdef __linux__
+
+namespace {
+
+int openCounter ( unsigned long long config )
+{
+  struct perf_event_attr attr;
+  memset ( &attr, 0, sizeof(attr) );
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // pid 0 and cpu -1: the calling thread on any cpu
+  return (int) syscall ( __NR_perf_event_open, &attr, 0, -1, -1, 0 );
+}
+
+}
+
+HardwareCounters::HardwareCounters ()
+{
+  const unsigned long long configs[NUM_COUNTERS] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES
+  };
+  for ( int i = 0 ; i < NUM_COUNTERS ; i++ )
+    fd[i] = openCounter ( configs[i] );
+}
+
+HardwareCounters::~HardwareCounters ()
+{
+  for ( int i = 0 ; i < NUM_COUNTERS ; i++ )
+    if ( fd[i] >= 0 )
+      close ( fd[i] );
+}
+
+void HardwareCounters::read ( unsigned long long *values ) const
+{
+  for ( int i = 0 ; i < NUM_COUNTERS ; i++ )
+  {
+    values[i] = 0;
+    if ( fd[i] < 0 )
+      continue;
+
+    // value, time enabled, time running
+    unsigned long long data[3];
+    if ( ::read ( fd[i], data, sizeof(data) ) != (ssize_t) sizeof(data) )
+      continue;
+    if ( ( data[2] > 0 ) && ( data[2] < data[1] ) )
+      values[i] = (unsigned long long) ( (double) data[0] * data[1] / data[2] );
+    else
+      values[i] = data[0];
+  }
+}
+
+#else
+
+HardwareCounters::HardwareCounters ()
+{
+  for ( int i = 0 ; i < NUM_COUNTERS ; i++ )
+    fd[i] = -1;
+}
+
+HardwareCounters::~HardwareCounters ()
+{
+}
+
+void HardwareCounters::read ( unsigned long long *values ) const
+{
+  for ( int i = 0 ; i < NUM_COUNTERS ; i++ )
+    values[i] = 0;
+}
+
+#endif
+
+bool HardwareCounters::isAvailable () const
+{
+  for ( int i = 0 ; i < NUM_COUNTERS ; i++ )
+    if ( fd[i] >= 0 )
+      return true;
+  return false;
+}
+
+bool HardwareCounters::isAvailable ( int counter ) const
+{
+  return ( counter >= 0 ) && ( counter < NUM_COUNTERS ) && ( fd[counter] >= 0 );
+}
+
+const char *HardwareCounters::getName ( int counter )
+{
+  switch ( counter )
+  {
+    case CYCLES: return "cycles";
+    case INSTRUCTIONS: return "instructions";
+    case CACHE_MISSES: return "cache-misses";
+    case BRANCH_MISSES: return "branch-misses";
+    default: return "unknown";
+  }
+}
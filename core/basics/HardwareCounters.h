@@ -0,0 +1,61 @@
+/**
+* @file HardwareCounters.h
+* @brief hardware performance counters (cycles, instructions, cache and branch misses) of the calling thread
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_HARDWARECOUNTERSINCLUDE
+#define _NICE_HARDWARECOUNTERSINCLUDE
+
+namespace NICE {
+
+/**
+ * @class HardwareCounters
+ * @brief Counts hardware events of the calling thread with perf_event_open (Linux).
+ *
+ * The counters are opened and started by the constructor and count only
+ * the thread which created the object, in user space. Counters which are
+ * not supported by the machine (e.g. in virtual machines) or not permitted
+ * (see /proc/sys/kernel/perf_event_paranoid) are not available and read as
+ * zero. If the kernel multiplexes the counters, the values are scaled
+ * to the full running time.
+ */
+class HardwareCounters
+{
+  public:
+    enum Counter {
+      CYCLES = 0,
+      INSTRUCTIONS,
+      CACHE_MISSES,
+      BRANCH_MISSES,
+      NUM_COUNTERS
+    };
+
+    /** open and start the counters of the calling thread */
+    HardwareCounters ();
+
+    /** close the counters */
+    ~HardwareCounters ();
+
+    /** true if at least one counter is available */
+    bool isAvailable () const;
+
+    /** true if the given counter is available */
+    bool isAvailable ( int counter ) const;
+
+    /** read the events counted since the construction (NUM_COUNTERS values) */
+    void read ( unsigned long long *values ) const;
+
+    /** name of a counter */
+    static const char *getName ( int counter );
+
+  private:
+    int fd[NUM_COUNTERS];
+
+    HardwareCounters ( const HardwareCounters & );
+    HardwareCounters & operator= ( const HardwareCounters & );
+};
+
+} // namespace
+
+#endif
@@ -3,10 +3,19 @@
  *  - libfbasics - library of some basic tools
  * See file License for license information.
  */
+#include <cstdlib>
+#include <deque>
+#include <utility>
+
+#ifndef WIN32
+#include <pthread.h>
+#endif
+
+#include "core/basics/CrossplatformDefines.h"
 #include "Log.h"
 
 namespace NICE {
-  
+
 Log Log::_debugLog(std::cerr);
 Log Log::_errorLog(std::cerr);
 Log Log::_timingLog(std::cerr);
@@ -14,8 +23,218 @@ Log Log::_detailLog(std::cerr);
 Log Log::_resultLog(std::cout);
 
 std::stringstream Log::dummy;
-  
+
+int Log::minimumLevel = Log::LEVEL_DEBUG;
+
 Log::~Log() {
 }
 
+namespace {
+
+typedef std::pair<int, std::string> QueuedLine;
+
+//! buffer of the records of the current thread
+NICE_THREAD_LOCAL std::ostringstream* localBuffer = NULL;
+//! true while a record of the current thread uses localBuffer
+NICE_THREAD_LOCAL bool localBufferInUse = false;
+
+#ifndef WIN32
+pthread_mutex_t writeMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_mutex_t queueMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t queueNotEmpty = PTHREAD_COND_INITIALIZER;
+pthread_cond_t queueNotFull = PTHREAD_COND_INITIALIZER;
+pthread_cond_t queueEmpty = PTHREAD_COND_INITIALIZER;
+pthread_t writerThread;
+
+std::deque<QueuedLine> queue;
+size_t queueCapacity = 0;
+bool dropWhenFull = false;
+bool asyncActive = false;
+bool stopRequested = false;
+//! true while the writer thread writes lines taken from the queue
+bool writerBusy = false;
+bool atexitRegistered = false;
+size_t dropped = 0;
+
+void stopAsyncAtExit() {
+  Log::stopAsync();
+}
+
+/** append a line to the queue, returns false if the writer thread is not running */
+bool enqueue(int level, const std::string& line) {
+  pthread_mutex_lock(&queueMutex);
+  if (!asyncActive) {
+    pthread_mutex_unlock(&queueMutex);
+    return false;
+  }
+  while (queue.size() >= queueCapacity && !dropWhenFull && asyncActive)
+    pthread_cond_wait(&queueNotFull, &queueMutex);
+  if (queue.size() >= queueCapacity) {
+    dropped++;
+  } else {
+    queue.push_back(QueuedLine(level, line));
+    pthread_cond_signal(&queueNotEmpty);
+  }
+  pthread_mutex_unlock(&queueMutex);
+  return true;
+}
+#endif
+
+} // namespace
+
+void Log::setLevel(int level) {
+  minimumLevel = level;
+}
+
+void Log::writeLine(int level, const std::string& line) {
+  Log* log;
+  switch (level) {
+    case LEVEL_DEBUG: log = &_debugLog; break;
+    case LEVEL_DETAIL: log = &_detailLog; break;
+    case LEVEL_TIMING: log = &_timingLog; break;
+    case LEVEL_RESULT: log = &_resultLog; break;
+    default: log = &_errorLog; break;
+  }
+  if (!log->quiet) {
+    // a single write, such that other writers to the same stream do not interleave with the line
+    *(log->target) << line << std::endl;
+  }
+}
+
+void Log::write(int level, const std::string& line) {
+#ifdef WIN32
+#pragma omp critical(NiceLog)
+  writeLine(level, line);
+#else
+  if (enqueue(level, line))
+    return;
+  pthread_mutex_lock(&writeMutex);
+  writeLine(level, line);
+  pthread_mutex_unlock(&writeMutex);
+#endif
+}
+
+#ifndef WIN32
+void* Log::writerMain(void*) {
+  std::deque<QueuedLine> lines;
+  pthread_mutex_lock(&queueMutex);
+  while (true) {
+    while (queue.empty() && !stopRequested)
+      pthread_cond_wait(&queueNotEmpty, &queueMutex);
+    if (queue.empty() && stopRequested)
+      break;
+
+    // write all waiting lines at once without holding the queue
+    lines.swap(queue);
+    writerBusy = true;
+    pthread_cond_broadcast(&queueNotFull);
+    pthread_mutex_unlock(&queueMutex);
+
+    pthread_mutex_lock(&writeMutex);
+    for (size_t i = 0; i < lines.size(); i++)
+      writeLine(lines[i].first, lines[i].second);
+    pthread_mutex_unlock(&writeMutex);
+    lines.clear();
+
+    pthread_mutex_lock(&queueMutex);
+    writerBusy = false;
+    if (queue.empty())
+      pthread_cond_broadcast(&queueEmpty);
+  }
+  pthread_cond_broadcast(&queueEmpty);
+  pthread_mutex_unlock(&queueMutex);
+  return NULL;
+}
+
+#endif
+
+void Log::startAsync(size_t capacity, bool drop) {
+#ifndef WIN32
+  pthread_mutex_lock(&queueMutex);
+  queueCapacity = (capacity > 0) ? capacity : 1;
+  dropWhenFull = drop;
+  if (asyncActive) {
+    pthread_mutex_unlock(&queueMutex);
+    return;
+  }
+  stopRequested = false;
+  if (pthread_create(&writerThread, NULL, writerMain, NULL) != 0) {
+    pthread_mutex_unlock(&queueMutex);
+    return;
+  }
+  asyncActive = true;
+  if (!atexitRegistered) {
+    atexit(stopAsyncAtExit);
+    atexitRegistered = true;
+  }
+  pthread_mutex_unlock(&queueMutex);
+#endif
+}
+
+void Log::stopAsync() {
+#ifndef WIN32
+  pthread_mutex_lock(&queueMutex);
+  if (!asyncActive) {
+    pthread_mutex_unlock(&queueMutex);
+    return;
+  }
+  stopRequested = true;
+  pthread_cond_signal(&queueNotEmpty);
+  pthread_mutex_unlock(&queueMutex);
+
+  // the writer writes all waiting lines before it terminates
+  pthread_join(writerThread, NULL);
+
+  pthread_mutex_lock(&queueMutex);
+  asyncActive = false;
+  pthread_cond_broadcast(&queueNotFull);
+  pthread_mutex_unlock(&queueMutex);
+#endif
+}
+
+void Log::flush() {
+#ifndef WIN32
+  pthread_mutex_lock(&queueMutex);
+  while (asyncActive && (!queue.empty() || writerBusy))
+    pthread_cond_wait(&queueEmpty, &queueMutex);
+  pthread_mutex_unlock(&queueMutex);
+#endif
+}
+
+size_t Log::numDropped() {
+#ifdef WIN32
+  return 0;
+#else
+  pthread_mutex_lock(&queueMutex);
+  size_t n = dropped;
+  pthread_mutex_unlock(&queueMutex);
+  return n;
+#endif
+}
+
+LogRecord::LogRecord(int _level) : level(_level) {
+  if (!localBufferInUse) {
+    // reuse the buffer of the thread, such that a record does not allocate
+    if (localBuffer == NULL)
+      localBuffer = new std::ostringstream;
+    localBuffer->str(std::string());
+    localBuffer->clear();
+    localBufferInUse = true;
+    buffer = localBuffer;
+    ownBuffer = false;
+  } else {
+    // a record is formatted while formatting another record
+    buffer = new std::ostringstream;
+    ownBuffer = true;
+  }
+}
+
+LogRecord::~LogRecord() {
+  Log::write(level, buffer->str());
+  if (ownBuffer)
+    delete buffer;
+  else
+    localBufferInUse = false;
+}
+
 } // namespace
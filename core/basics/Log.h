@@ -8,15 +8,40 @@
 
 #include <iostream>
 #include <sstream>
+#include <string>
 
 namespace NICE {
 
 /**
  * A simple Logging mechanism.
+ *
+ * Besides the streams debug(), error(), timing(), detail() and result(),
+ * messages can be written as records with the macros NICE_LOG_DEBUG,
+ * NICE_LOG_DETAIL, NICE_LOG_TIMING, NICE_LOG_WARNING and NICE_LOG_ERROR:
+ * <code>
+ * NICE_LOG_DEBUG ( "ILSConjugateGradients: iteration " << i << logField ( "residual", res ) );
+ * </code>
+ * A record is only formatted if its level passes the compile-time filter
+ * NICE_LOG_MIN_LEVEL and the runtime filter setLevel(). It is formatted in a
+ * buffer of the calling thread and written as a whole line, such that
+ * messages of different threads never interleave. After startAsync(), lines
+ * are written by a separate thread and the caller only appends the line to a
+ * bounded queue.
  * \note Interface might change in future versions!
  */
 class Log { //: public std::ostream<char> {
 public:
+  /** levels of log records, each level is written to the target of the corresponding Log */
+  enum Level {
+    LEVEL_DEBUG = 0,   //!< debugLog()
+    LEVEL_DETAIL,      //!< detailLog()
+    LEVEL_TIMING,      //!< timingLog()
+    LEVEL_RESULT,      //!< resultLog()
+    LEVEL_WARNING,     //!< errorLog()
+    LEVEL_ERROR,       //!< errorLog()
+    LEVEL_NONE         //!< used with setLevel to disable all records
+  };
+
 	inline Log(std::ostream& _target = std::cerr)
          : target(&_target), quiet(false) {}
 	virtual ~Log();
@@ -71,6 +96,40 @@ public:
     quiet = _quiet;
   }
 
+  //! change the stream the messages are written to
+  inline void setTarget(std::ostream& _target) {
+    target = &_target;
+  }
+
+  /** records below this level are discarded without formatting them (default: LEVEL_DEBUG) */
+  static void setLevel(int level);
+
+  //! current runtime level
+  inline static int getLevel() { return minimumLevel; }
+
+  //! true if records of the given level are written
+  inline static bool isEnabled(int level) { return level >= minimumLevel; }
+
+  /** write a complete line to the target of the level (thread-safe) */
+  static void write(int level, const std::string& line);
+
+  /**
+   * Write all records with a separate thread (not available on Windows).
+   * @param queueCapacity maximum number of lines waiting to be written
+   * @param dropWhenFull if true, lines are dropped when the queue is full,
+   *        otherwise the writing thread waits
+   */
+  static void startAsync(size_t queueCapacity = 4096, bool dropWhenFull = false);
+
+  /** write all waiting lines and stop the writer thread (called at exit) */
+  static void stopAsync();
+
+  /** wait until all waiting lines are written */
+  static void flush();
+
+  /** number of lines dropped because the queue was full */
+  static size_t numDropped();
+
 private:
   static Log _debugLog;
   static Log _errorLog;
@@ -78,10 +137,79 @@ private:
   static Log _detailLog;
   static Log _resultLog;
   static std::stringstream dummy;
+  static int minimumLevel;
 
   std::ostream* target;
   bool quiet;
+
+  /** write a line to the target of the level without locking */
+  static void writeLine(int level, const std::string& line);
+
+  /** main function of the writer thread */
+  static void* writerMain(void*);
+};
+
+/**
+ * A single log record, the message is formatted into a buffer of the current
+ * thread and written when the record is destroyed. Use the NICE_LOG macros,
+ * which only create a record if the level is enabled.
+ */
+class LogRecord {
+public:
+  explicit LogRecord(int level);
+  ~LogRecord();
+
+  //! stream to format the message
+  inline std::ostream& stream() { return *buffer; }
+
+private:
+  int level;
+  std::ostringstream* buffer;
+  bool ownBuffer;
+
+  LogRecord(const LogRecord&);
+  LogRecord& operator=(const LogRecord&);
+};
+
+/** key/value pair of a structured log record, written as " key=value" */
+template<class T>
+struct LogField {
+  const char* key;
+  const T& value;
+  LogField(const char* _key, const T& _value) : key(_key), value(_value) {}
 };
 
+//! create a key/value pair of a structured log record
+template<class T>
+inline LogField<T> logField(const char* key, const T& value) {
+  return LogField<T>(key, value);
+}
+
+template<class T>
+inline std::ostream& operator<<(std::ostream& os, const LogField<T>& field) {
+  return os << ' ' << field.key << '=' << field.value;
+}
+
 } // namespace
+
+/** records below this level are removed at compile time */
+#ifndef NICE_LOG_MIN_LEVEL
+#define NICE_LOG_MIN_LEVEL 0
+#endif
+
+/** write a record, the message is only formatted if the level is enabled */
+#define NICE_LOG(level, message) \
+  do { \
+    if ( ( (level) >= NICE_LOG_MIN_LEVEL ) && NICE::Log::isEnabled ( level ) ) { \
+      NICE::LogRecord niceLogRecord ( level ); \
+      niceLogRecord.stream() << message; \
+    } \
+  } while ( 0 )
+
+#define NICE_LOG_DEBUG(message) NICE_LOG ( NICE::Log::LEVEL_DEBUG, message )
+#define NICE_LOG_DETAIL(message) NICE_LOG ( NICE::Log::LEVEL_DETAIL, message )
+#define NICE_LOG_TIMING(message) NICE_LOG ( NICE::Log::LEVEL_TIMING, message )
+#define NICE_LOG_WARNING(message) NICE_LOG ( NICE::Log::LEVEL_WARNING, message )
+#define NICE_LOG_ERROR(message) NICE_LOG ( NICE::Log::LEVEL_ERROR, message )
+
 #endif //_LOG_H_
@@ -0,0 +1,389 @@
+/**
+* @file Profiler.cpp
+* @brief hierarchical profiling of scoped zones with per-zone statistics and Chrome trace export
+* @date 10/19/2026
+
+*/
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include <map>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#include <pthread.h>
+#endif
+
+#include "core/basics/CrossplatformDefines.h"
+#include "core/basics/Exception.h"
+#include "core/basics/Log.h"
+#include "Profiler.h"
+
+using namespace NICE;
+using namespace std;
+
+namespace {
+
+/** a finished zone */
+struct Event
+{
+  const char *name;
+  unsigned long long start;
+  unsigned long long duration;
+  unsigned int depth;
+};
+
+/** a zone which is still active */
+struct OpenZone
+{
+  const char *name;
+  unsigned long long start;
+};
+
+/** zones of a single thread, only this thread appends to the buffer */
+struct ThreadBuffer
+{
+  unsigned int id;
+  std::vector<Event> events;
+  std::vector<OpenZone> stack;
+  size_t dropped;
+};
+
+/** aggregated statistics of a zone */
+struct ZoneStatistics
+{
+  std::vector<unsigned long long> durations;
+  unsigned long long total;
+  unsigned long long self;
+  ZoneStatistics () : total ( 0 ), self ( 0 ) {}
+};
+
+//! buffers of all threads which ever recorded a zone (never deleted, threads may end before the report)
+std::vector<ThreadBuffer *> threadBuffers;
+
+//! protects threadBuffers, buffers are registered by OpenMP threads as well as by other threads
+#ifdef WIN32
+SRWLOCK registryMutex = SRWLOCK_INIT;
+#else
+pthread_mutex_t registryMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/** locks the buffer registry for the lifetime of the object */
+class RegistryLock
+{
+  public:
+    RegistryLock ()
+    {
+#ifdef WIN32
+      AcquireSRWLockExclusive ( &registryMutex );
+#else
+      pthread_mutex_lock ( &registryMutex );
+#endif
+    }
+
+    ~RegistryLock ()
+    {
+#ifdef WIN32
+      ReleaseSRWLockExclusive ( &registryMutex );
+#else
+      pthread_mutex_unlock ( &registryMutex );
+#endif
+    }
+};
+
+size_t maxEventsPerThread = 1 << 20;
+
+NICE_THREAD_LOCAL ThreadBuffer *localBuffer = NULL;
+
+ThreadBuffer *getLocalBuffer ()
+{
+  if ( localBuffer == NULL )
+  {
+    ThreadBuffer *buffer = new ThreadBuffer;
+    buffer->dropped = 0;
+    buffer->events.reserve ( 4096 );
+    {
+      RegistryLock lock;
+      buffer->id = threadBuffers.size();
+      threadBuffers.push_back ( buffer );
+    }
+    localBuffer = buffer;
+  }
+  return localBuffer;
+}
+
+double toMilliseconds ( unsigned long long t )
+{
+  return t * 1e-6;
+}
+
+/** quantile of sorted durations */
+unsigned long long quantile ( const std::vector<unsigned long long> & sorted, double q )
+{
+  size_t i = (size_t) ( q * ( sorted.size() - 1 ) + 0.5 );
+  return sorted[ std::min ( i, sorted.size() - 1 ) ];
+}
+
+void writeJSONString ( std::ostream & os, const char *s )
+{
+  os << '"';
+  for ( ; *s != 0 ; s++ )
+  {
+    if ( ( *s == '"' ) || ( *s == '\\' ) )
+      os << '\\';
+    if ( (unsigned char)*s >= 0x20 )
+      os << *s;
+  }
+  os << '"';
+}
+
+typedef std::pair<unsigned long long, std::string> TotalAndName;
+
+bool greaterTotal ( const TotalAndName & a, const TotalAndName & b )
+{
+  return a.first > b.first;
+}
+
+/** enables the profiler if the environment variable NICE_PROFILE is set and writes the results at exit */
+struct EnvironmentProfiler
+{
+  bool active;
+
+  EnvironmentProfiler ()
+  {
+    active = ( getenv ( "NICE_PROFILE" ) != NULL );
+    if ( active )
+      Profiler::enable();
+  }
+
+  ~EnvironmentProfiler ()
+  {
+    if ( !active )
+      return;
+    Profiler::writeReport ( Log::timing() );
+    const char *traceFile = getenv ( "NICE_PROFILE_TRACE" );
+    if ( traceFile != NULL )
+      Profiler::writeChromeTrace ( std::string ( traceFile ) );
+  }
+};
+
+}
+
+bool Profiler::enabled = false;
+
+// has to be defined after Profiler::enabled
+static EnvironmentProfiler environmentProfiler;
+
+void Profiler::enable ( bool enabled )
+{
+  Profiler::enabled = enabled;
+}
+
+void Profiler::setMaxEventsPerThread ( size_t maxEvents )
+{
+  maxEventsPerThread = maxEvents;
+}
+
+unsigned long long Profiler::ticks ()
+{
+#ifdef WIN32
+  static LARGE_INTEGER frequency = { 0 };
+  if ( frequency.QuadPart == 0 )
+    QueryPerformanceFrequency ( &frequency );
+  LARGE_INTEGER counter;
+  QueryPerformanceCounter ( &counter );
+  return (unsigned long long) ( counter.QuadPart * ( 1e9 / frequency.QuadPart ) );
+#else
+  struct timespec t;
+  clock_gettime ( CLOCK_MONOTONIC, &t );
+  return (unsigned long long) t.tv_sec * 1000000000ull + t.tv_nsec;
+#endif
+}
+
+void Profiler::beginZone ( const char *name )
+{
+  ThreadBuffer *buffer = getLocalBuffer();
+  OpenZone zone;
+  zone.name = name;
+  zone.start = ticks();
+  buffer->stack.push_back ( zone );
+}
+
+void Profiler::endZone ()
+{
+  unsigned long long end = ticks();
+  ThreadBuffer *buffer = getLocalBuffer();
+  if ( buffer->stack.empty() )
+    return;
+
+  const OpenZone & zone = buffer->stack.back();
+  if ( buffer->events.size() < maxEventsPerThread )
+  {
+    Event event;
+    event.name = zone.name;
+    event.start = zone.start;
+    event.duration = end - zone.start;
+    event.depth = buffer->stack.size() - 1;
+    buffer->events.push_back ( event );
+  } else {
+    buffer->dropped++;
+  }
+  buffer->stack.pop_back();
+}
+
+void Profiler::reset ()
+{
+  {
+    RegistryLock lock;
+    for ( size_t i = 0 ; i < threadBuffers.size() ; i++ )
+    {
+      threadBuffers[i]->events.clear();
+      threadBuffers[i]->dropped = 0;
+    }
+  }
+}
+
+size_t Profiler::numEvents ()
+{
+  size_t n = 0;
+  {
+    RegistryLock lock;
+    for ( size_t i = 0 ; i < threadBuffers.size() ; i++ )
+      n += threadBuffers[i]->events.size();
+  }
+  return n;
+}
+
+size_t Profiler::numDroppedEvents ()
+{
+  size_t n = 0;
+  {
+    RegistryLock lock;
+    for ( size_t i = 0 ; i < threadBuffers.size() ; i++ )
+      n += threadBuffers[i]->dropped;
+  }
+  return n;
+}
+
+void Profiler::writeReport ( std::ostream & os )
+{
+  std::map<std::string, ZoneStatistics> zones;
+  size_t dropped = 0;
+
+  {
+    RegistryLock lock;
+    for ( size_t t = 0 ; t < threadBuffers.size() ; t++ )
+    {
+      const ThreadBuffer & buffer = *threadBuffers[t];
+      dropped += buffer.dropped;
+
+      // zones are recorded when they end, i.e. nested zones before the enclosing
+      // zone: childTime[d] accumulates the time of the finished zones of depth d
+      std::vector<unsigned long long> childTime;
+      for ( size_t i = 0 ; i < buffer.events.size() ; i++ )
+      {
+        const Event & e = buffer.events[i];
+        if ( childTime.size() < e.depth + 2 )
+          childTime.resize ( e.depth + 2, 0 );
+
+        unsigned long long nested = std::min ( childTime[e.depth + 1], e.duration );
+        childTime[e.depth + 1] = 0;
+        childTime[e.depth] += e.duration;
+
+        ZoneStatistics & z = zones[e.name];
+        z.durations.push_back ( e.duration );
+        z.total += e.duration;
+        z.self += e.duration - nested;
+      }
+    }
+  }
+
+  std::vector<TotalAndName> order;
+  for ( std::map<std::string, ZoneStatistics>::const_iterator i = zones.begin(); i != zones.end(); i++ )
+    order.push_back ( TotalAndName ( i->second.total, i->first ) );
+  std::sort ( order.begin(), order.end(), greaterTotal );
+
+  std::ios::fmtflags flags = os.flags();
+  std::streamsize precision = os.precision();
+  os << "Profiler: " << zones.size() << " zones";
+  if ( dropped > 0 )
+    os << " (" << dropped << " dropped events)";
+  os << std::endl;
+  os << std::left << std::setw ( 48 ) << "zone" << std::right
+     << std::setw ( 10 ) << "calls" << std::setw ( 12 ) << "total[ms]" << std::setw ( 12 ) << "self[ms]"
+     << std::setw ( 12 ) << "mean[ms]" << std::setw ( 12 ) << "p50[ms]" << std::setw ( 12 ) << "p99[ms]"
+     << std::setw ( 12 ) << "max[ms]" << std::endl;
+  os << std::fixed << std::setprecision ( 3 );
+
+  for ( size_t i = 0 ; i < order.size() ; i++ )
+  {
+    ZoneStatistics & z = zones[ order[i].second ];
+    std::sort ( z.durations.begin(), z.durations.end() );
+    os << std::left << std::setw ( 48 ) << order[i].second << std::right
+       << std::setw ( 10 ) << z.durations.size()
+       << std::setw ( 12 ) << toMilliseconds ( z.total )
+       << std::setw ( 12 ) << toMilliseconds ( z.self )
+       << std::setw ( 12 ) << toMilliseconds ( z.total ) / z.durations.size()
+       << std::setw ( 12 ) << toMilliseconds ( quantile ( z.durations, 0.5 ) )
+       << std::setw ( 12 ) << toMilliseconds ( quantile ( z.durations, 0.99 ) )
+       << std::setw ( 12 ) << toMilliseconds ( z.durations.back() ) << std::endl;
+  }
+
+  os.flags ( flags );
+  os.precision ( precision );
+}
+
+void Profiler::writeChromeTrace ( std::ostream & os )
+{
+  {
+    RegistryLock lock;
+    unsigned long long origin = 0;
+    bool first = true;
+    for ( size_t t = 0 ; t < threadBuffers.size() ; t++ )
+      for ( size_t i = 0 ; i < threadBuffers[t]->events.size() ; i++ )
+        if ( first || ( threadBuffers[t]->events[i].start < origin ) )
+        {
+          origin = threadBuffers[t]->events[i].start;
+          first = false;
+        }
+
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision ( 3 );
+    os << "{\"traceEvents\":[" << std::endl;
+
+    first = true;
+    for ( size_t t = 0 ; t < threadBuffers.size() ; t++ )
+    {
+      const ThreadBuffer & buffer = *threadBuffers[t];
+      for ( size_t i = 0 ; i < buffer.events.size() ; i++ )
+      {
+        const Event & e = buffer.events[i];
+        if ( !first )
+          os << "," << std::endl;
+        first = false;
+        os << "{\"name\":";
+        writeJSONString ( os, e.name );
+        os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.id
+           << ",\"ts\":" << ( e.start - origin ) * 1e-3
+           << ",\"dur\":" << e.duration * 1e-3 << "}";
+      }
+    }
+    os << std::endl << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+
+    os.flags ( flags );
+    os.precision ( precision );
+  }
+}
+
+void Profiler::writeChromeTrace ( const std::string & filename )
+{
+  std::ofstream ofs ( filename.c_str() );
+  if ( !ofs.is_open() )
+    fthrow ( Exception, "Profiler: unable to write the trace file " << filename );
+  writeChromeTrace ( ofs );
+}
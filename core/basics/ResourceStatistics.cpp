@@ -1,18 +1,65 @@
 /** 
 * @file ResourceStatistics.cpp
-* @brief Iteratively solving linear equation systems with the symmetric LQ (SYMMLQ) method using Lanczos process
+* @brief statistics for runtime and memory usage
 * @author Paul Bodesheim
 * @date 03/02/2012 (dd/mm/yyyy)
 
 */
 
+#include <cstdio>
+#include <cstring>
+
 #include "ResourceStatistics.h"
 
+#ifndef WIN32
+#include <time.h>
+#endif
+
 using namespace NICE;
 using namespace std;
 
 #ifndef WIN32
 
+namespace {
+
+/** value of a field of /proc/self/status in KB, -1 if it is not available */
+long readProcStatus ( const char *key )
+{
+  FILE *f = fopen ( "/proc/self/status", "r" );
+  if ( f == NULL )
+    return -1;
+
+  long value = -1;
+  size_t keyLength = strlen ( key );
+  char line[256];
+  while ( fgets ( line, sizeof(line), f ) != NULL )
+  {
+    if ( ( strncmp ( line, key, keyLength ) == 0 ) && ( line[keyLength] == ':' ) )
+    {
+      if ( sscanf ( line + keyLength + 1, "%ld", &value ) != 1 )
+        value = -1;
+      break;
+    }
+  }
+  fclose ( f );
+  return value;
+}
+
+double toSeconds ( const struct timeval & t )
+{
+  return (double) t.tv_sec + ( (double) t.tv_usec / 1e6 );
+}
+
+double clockSeconds ( clockid_t clock )
+{
+  struct timespec t;
+  if ( clock_gettime ( clock, &t ) != 0 )
+    return 0.0;
+  return (double) t.tv_sec + ( (double) t.tv_nsec / 1e9 );
+}
+
+}
+
 ResourceStatistics::ResourceStatistics(int _mode)
 {
   mode = _mode;
@@ -135,6 +182,69 @@ void ResourceStatistics::getStatistics(long & memory, double & userCpuTime, doub
   
 }
 
+void ResourceStatistics::getCurrentMemory(long & memory)
+{
+  memory = readProcStatus ( "VmRSS" );
+  if ( memory < 0 )
+    fthrow(Exception, "ResourceStatistics::getCurrentMemory:  /proc/self/status is not available");
+}
+
+void ResourceStatistics::getPeakMemory(long & memory)
+{
+  memory = readProcStatus ( "VmHWM" );
+  if ( memory < 0 )
+    getMaximumMemory ( memory );
+}
+
+void ResourceStatistics::getPageFaults(long & minorFaults, long & majorFaults)
+{
+  if ( getrusage(mode,&memoryStatistics) != 0 )
+    fthrow(Exception, "ResourceStatistics::getPageFaults:  getrusage failed");
+
+  minorFaults = memoryStatistics.ru_minflt;
+  majorFaults = memoryStatistics.ru_majflt;
+}
+
+void ResourceStatistics::getContextSwitches(long & voluntary, long & involuntary)
+{
+  if ( getrusage(mode,&memoryStatistics) != 0 )
+    fthrow(Exception, "ResourceStatistics::getContextSwitches:  getrusage failed");
+
+  voluntary = memoryStatistics.ru_nvcsw;
+  involuntary = memoryStatistics.ru_nivcsw;
+}
+
+void ResourceStatistics::getThreadCpuTime(double & time)
+{
+  struct timespec t;
+  if ( clock_gettime ( CLOCK_THREAD_CPUTIME_ID, &t ) != 0 )
+    fthrow(Exception, "ResourceStatistics::getThreadCpuTime:  clock_gettime failed");
+
+  time = (double) t.tv_sec + ( (double) t.tv_nsec / 1e9 );
+}
+
+void ResourceStatistics::getSample(ResourceSample & sample)
+{
+  sample.wallTime = clockSeconds ( CLOCK_MONOTONIC );
+  sample.threadCpuTime = clockSeconds ( CLOCK_THREAD_CPUTIME_ID );
+
+  if ( getrusage(mode,&memoryStatistics) != 0 )
+    fthrow(Exception, "ResourceStatistics::getSample:  getrusage failed");
+
+  sample.userCpuTime = toSeconds ( memoryStatistics.ru_utime );
+  sample.systemCpuTime = toSeconds ( memoryStatistics.ru_stime );
+  sample.minorPageFaults = memoryStatistics.ru_minflt;
+  sample.majorPageFaults = memoryStatistics.ru_majflt;
+  sample.voluntaryContextSwitches = memoryStatistics.ru_nvcsw;
+  sample.involuntaryContextSwitches = memoryStatistics.ru_nivcsw;
+
+  // /proc only describes the whole process
+  sample.currentMemory = readProcStatus ( "VmRSS" );
+  sample.peakMemory = readProcStatus ( "VmHWM" );
+  if ( sample.peakMemory < 0 )
+    sample.peakMemory = memoryStatistics.ru_maxrss;
+}
+
 #else 
 /// WIN32 PORT following here
 #include "CrossplatformDefines.h"
@@ -172,4 +282,34 @@ void ResourceStatistics::getStatistics(long & memory, double & userCpuTime, doub
 	fthrow ( Exception, "ResourceStatistics class : not yet ported to WIN32 plattform");
 }
 
-#endif
\ No newline at end of file
+void ResourceStatistics::getCurrentMemory(long & memory)
+{
+	fthrow ( Exception, "ResourceStatistics class : not yet ported to WIN32 plattform");
+}
+
+void ResourceStatistics::getPeakMemory(long & memory)
+{
+	fthrow ( Exception, "ResourceStatistics class : not yet ported to WIN32 plattform");
+}
+
+void ResourceStatistics::getPageFaults(long & minorFaults, long & majorFaults)
+{
+	fthrow ( Exception, "ResourceStatistics class : not yet ported to WIN32 plattform");
+}
+
+void ResourceStatistics::getContextSwitches(long & voluntary, long & involuntary)
+{
+	fthrow ( Exception, "ResourceStatistics class : not yet ported to WIN32 plattform");
+}
+
+void ResourceStatistics::getThreadCpuTime(double & time)
+{
+	fthrow ( Exception, "ResourceStatistics class : not yet ported to WIN32 plattform");
+}
+
+void ResourceStatistics::getSample(ResourceSample & sample)
+{
+	fthrow ( Exception, "ResourceStatistics class : not yet ported to WIN32 plattform");
+}
+
+#endif
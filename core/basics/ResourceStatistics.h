@@ -17,6 +17,31 @@
 #include <core/basics/Exception.h>
 
 namespace NICE {
+
+/** @brief a single sample of the resources used by the process and the calling thread */
+struct ResourceSample
+{
+  //! monotonic wall clock time in seconds
+  double wallTime;
+  //! user CPU time in seconds (of the process or the children, see ResourceStatistics)
+  double userCpuTime;
+  //! system CPU time in seconds
+  double systemCpuTime;
+  //! CPU time of the calling thread in seconds
+  double threadCpuTime;
+  //! current resident set size in KB (VmRSS), -1 if not available
+  long currentMemory;
+  //! peak resident set size in KB (VmHWM or ru_maxrss)
+  long peakMemory;
+  //! page faults served without I/O
+  long minorPageFaults;
+  //! page faults which required I/O
+  long majorPageFaults;
+  //! voluntary context switches (e.g. waiting for I/O or a lock)
+  long voluntaryContextSwitches;
+  //! involuntary context switches (preemption)
+  long involuntaryContextSwitches;
+};
   
 /** @class ResourceStatistics
  * Interface that provides statistics for runtime and memory usage based on the function "getrusage" of <sys/resource.h>
@@ -81,6 +106,50 @@ class ResourceStatistics
      * @param systemCpuTime system cpu time measured in seconds
      **/
     void getStatistics(long & memory, double & userCpuTime, double & systemCpuTime);
+
+    /**
+     * @brief get the current memory (resident set size VmRSS of /proc/self/status) measured in kilo-bytes
+     *
+     * @param memory current memory measured in KB
+     **/
+    void getCurrentMemory(long & memory);
+
+    /**
+     * @brief get the peak memory (VmHWM of /proc/self/status, ru_maxrss if not available) measured in kilo-bytes
+     *
+     * @param memory peak memory measured in KB
+     **/
+    void getPeakMemory(long & memory);
+
+    /**
+     * @brief get the number of page faults
+     *
+     * @param minorFaults page faults served without I/O
+     * @param majorFaults page faults which required I/O
+     **/
+    void getPageFaults(long & minorFaults, long & majorFaults);
+
+    /**
+     * @brief get the number of context switches
+     *
+     * @param voluntary voluntary context switches
+     * @param involuntary involuntary context switches
+     **/
+    void getContextSwitches(long & voluntary, long & involuntary);
+
+    /**
+     * @brief get the CPU time used by the calling thread (seconds)
+     *
+     * @param time thread cpu time measured in seconds
+     **/
+    void getThreadCpuTime(double & time);
+
+    /**
+     * @brief sample all statistics at once (a single call of getrusage)
+     *
+     * @param sample resources used so far
+     **/
+    void getSample(ResourceSample & sample);
 };
 
 }
@@ -0,0 +1,266 @@
+/**
+* @file ResourceZone.cpp
+* @brief CPU time, page faults, context switches and hardware counters of scoped zones
+* @date 10/19/2026
+
+*/
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+
+#ifndef WIN32
+#include <pthread.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+#include "core/basics/CrossplatformDefines.h"
+#include "core/basics/Log.h"
+#include "core/basics/ResourceStatistics.h"
+#include "ResourceZone.h"
+
+using namespace NICE;
+using namespace std;
+
+namespace {
+
+std::map<std::string, ResourceZoneStatistics> zoneStatistics;
+
+#ifdef WIN32
+//! without perf events the counters are stateless and shared by all threads
+HardwareCounters sharedCounters;
+
+HardwareCounters *getLocalCounters ()
+{
+  return &sharedCounters;
+}
+#else
+//! counters of the calling thread, opened by the first zone of the thread
+NICE_THREAD_LOCAL HardwareCounters *localCounters = NULL;
+
+//! closes the counters of a thread at its exit (short-lived and pool threads)
+pthread_key_t countersKey;
+pthread_once_t countersKeyOnce = PTHREAD_ONCE_INIT;
+
+void deleteCounters ( void *counters )
+{
+  delete static_cast<HardwareCounters *> ( counters );
+  localCounters = NULL;
+}
+
+void createCountersKey ()
+{
+  pthread_key_create ( &countersKey, deleteCounters );
+}
+
+HardwareCounters *getLocalCounters ()
+{
+  if ( localCounters == NULL )
+  {
+    pthread_once ( &countersKeyOnce, createCountersKey );
+    localCounters = new HardwareCounters;
+    pthread_setspecific ( countersKey, localCounters );
+  }
+  return localCounters;
+}
+#endif
+
+/** enables resource zones if the environment variable NICE_PROFILE_RESOURCES is set and writes the report at exit */
+struct EnvironmentResourceZones
+{
+  bool active;
+
+  EnvironmentResourceZones ()
+  {
+    active = ( getenv ( "NICE_PROFILE_RESOURCES" ) != NULL );
+    if ( active )
+      ResourceZone::enable();
+  }
+
+  ~EnvironmentResourceZones ()
+  {
+    if ( active )
+      ResourceZone::writeReport ( Log::timing() );
+  }
+};
+
+}
+
+ResourceZoneStatistics::ResourceZoneStatistics ()
+  : calls ( 0 ), wallTime ( 0.0 ), threadCpuTime ( 0.0 ), minorPageFaults ( 0 ), majorPageFaults ( 0 ),
+    voluntaryContextSwitches ( 0 ), involuntaryContextSwitches ( 0 ), maximumMemoryGrowth ( 0 ),
+    countersAvailable ( false )
+{
+  for ( int i = 0 ; i < HardwareCounters::NUM_COUNTERS ; i++ )
+    counters[i] = 0;
+}
+
+double ResourceZoneStatistics::getInstructionsPerCycle () const
+{
+  if ( counters[HardwareCounters::CYCLES] == 0 )
+    return 0.0;
+  return (double) counters[HardwareCounters::INSTRUCTIONS] / counters[HardwareCounters::CYCLES];
+}
+
+bool ResourceZone::enabled = false;
+bool ResourceZone::useHardwareCounters = true;
+
+// has to be defined after ResourceZone::enabled
+static EnvironmentResourceZones environmentResourceZones;
+
+void ResourceZone::enable ( bool enabled, bool useHardwareCounters )
+{
+  ResourceZone::enabled = enabled;
+  ResourceZone::useHardwareCounters = useHardwareCounters;
+}
+
+void ResourceZone::reset ()
+{
+#pragma omp critical(NiceResourceZone)
+  zoneStatistics.clear();
+}
+
+bool ResourceZone::getStatistics ( const std::string & name, ResourceZoneStatistics & statistics )
+{
+  bool found = false;
+#pragma omp critical(NiceResourceZone)
+  {
+    std::map<std::string, ResourceZoneStatistics>::const_iterator i = zoneStatistics.find ( name );
+    if ( i != zoneStatistics.end() )
+    {
+      statistics = i->second;
+      found = true;
+    }
+  }
+  return found;
+}
+
+void ResourceZone::takeSample ( Sample & sample )
+{
+#ifndef WIN32
+  struct timespec t;
+  clock_gettime ( CLOCK_MONOTONIC, &t );
+  sample.wallTime = (double) t.tv_sec + t.tv_nsec / 1e9;
+  clock_gettime ( CLOCK_THREAD_CPUTIME_ID, &t );
+  sample.threadCpuTime = (double) t.tv_sec + t.tv_nsec / 1e9;
+
+  struct rusage usage;
+#ifdef RUSAGE_THREAD
+  getrusage ( RUSAGE_THREAD, &usage );
+#else
+  getrusage ( RUSAGE_SELF, &usage );
+#endif
+  sample.minorPageFaults = usage.ru_minflt;
+  sample.majorPageFaults = usage.ru_majflt;
+  sample.voluntaryContextSwitches = usage.ru_nvcsw;
+  sample.involuntaryContextSwitches = usage.ru_nivcsw;
+
+  ResourceStatistics resources;
+  try {
+    resources.getCurrentMemory ( sample.memory );
+  } catch ( Exception & ) {
+    sample.memory = 0;
+  }
+#else
+  sample.wallTime = Profiler::ticks() / 1e9;
+  sample.threadCpuTime = 0.0;
+  sample.minorPageFaults = 0;
+  sample.majorPageFaults = 0;
+  sample.voluntaryContextSwitches = 0;
+  sample.involuntaryContextSwitches = 0;
+  sample.memory = 0;
+#endif
+
+  sample.countersAvailable = false;
+  if ( useHardwareCounters )
+  {
+    HardwareCounters *counters = getLocalCounters();
+    sample.countersAvailable = counters->isAvailable();
+    counters->read ( sample.counters );
+  } else {
+    for ( int i = 0 ; i < HardwareCounters::NUM_COUNTERS ; i++ )
+      sample.counters[i] = 0;
+  }
+}
+
+ResourceZone::ResourceZone ( const char *name )
+  : profileZone ( name ), name ( name ), active ( enabled )
+{
+  if ( active )
+    takeSample ( start );
+}
+
+ResourceZone::~ResourceZone ()
+{
+  if ( !active )
+    return;
+
+  Sample end;
+  takeSample ( end );
+
+#pragma omp critical(NiceResourceZone)
+  {
+    ResourceZoneStatistics & z = zoneStatistics[name];
+    z.calls++;
+    z.wallTime += end.wallTime - start.wallTime;
+    z.threadCpuTime += end.threadCpuTime - start.threadCpuTime;
+    z.minorPageFaults += end.minorPageFaults - start.minorPageFaults;
+    z.majorPageFaults += end.majorPageFaults - start.majorPageFaults;
+    z.voluntaryContextSwitches += end.voluntaryContextSwitches - start.voluntaryContextSwitches;
+    z.involuntaryContextSwitches += end.involuntaryContextSwitches - start.involuntaryContextSwitches;
+    if ( end.memory - start.memory > z.maximumMemoryGrowth )
+      z.maximumMemoryGrowth = end.memory - start.memory;
+    if ( start.countersAvailable && end.countersAvailable )
+    {
+      z.countersAvailable = true;
+      for ( int i = 0 ; i < HardwareCounters::NUM_COUNTERS ; i++ )
+        if ( end.counters[i] > start.counters[i] )
+          z.counters[i] += end.counters[i] - start.counters[i];
+    }
+  }
+}
+
+void ResourceZone::writeReport ( std::ostream & os )
+{
+  std::map<std::string, ResourceZoneStatistics> zones;
+#pragma omp critical(NiceResourceZone)
+  zones = zoneStatistics;
+
+  std::ios::fmtflags flags = os.flags();
+  std::streamsize precision = os.precision();
+  os << "ResourceZone: " << zones.size() << " zones" << std::endl;
+  os << std::left << std::setw ( 40 ) << "zone" << std::right
+     << std::setw ( 8 ) << "calls" << std::setw ( 12 ) << "wall[ms]" << std::setw ( 12 ) << "cpu[ms]"
+     << std::setw ( 10 ) << "minflt" << std::setw ( 8 ) << "majflt" << std::setw ( 8 ) << "ctxsw"
+     << std::setw ( 12 ) << "rss+[KB]" << std::setw ( 8 ) << "IPC"
+     << std::setw ( 16 ) << "cache-miss/ki" << std::setw ( 16 ) << "branch-miss/ki" << std::endl;
+  os << std::fixed;
+
+  for ( std::map<std::string, ResourceZoneStatistics>::const_iterator i = zones.begin(); i != zones.end(); i++ )
+  {
+    const ResourceZoneStatistics & z = i->second;
+    os << std::left << std::setw ( 40 ) << i->first << std::right
+       << std::setw ( 8 ) << z.calls
+       << std::setprecision ( 3 ) << std::setw ( 12 ) << z.wallTime * 1e3
+       << std::setw ( 12 ) << z.threadCpuTime * 1e3
+       << std::setw ( 10 ) << z.minorPageFaults
+       << std::setw ( 8 ) << z.majorPageFaults
+       << std::setw ( 8 ) << z.voluntaryContextSwitches + z.involuntaryContextSwitches
+       << std::setw ( 12 ) << z.maximumMemoryGrowth;
+
+    unsigned long long instructions = z.counters[HardwareCounters::INSTRUCTIONS];
+    if ( z.countersAvailable && ( instructions > 0 ) )
+    {
+      os << std::setprecision ( 2 ) << std::setw ( 8 ) << z.getInstructionsPerCycle()
+         << std::setw ( 16 ) << 1000.0 * z.counters[HardwareCounters::CACHE_MISSES] / instructions
+         << std::setw ( 16 ) << 1000.0 * z.counters[HardwareCounters::BRANCH_MISSES] / instructions;
+    } else {
+      os << std::setw ( 8 ) << "-" << std::setw ( 16 ) << "-" << std::setw ( 16 ) << "-";
+    }
+    os << std::endl;
+  }
+
+  os.flags ( flags );
+  os.precision ( precision );
+}
@@ -0,0 +1,124 @@
+/**
+* @file ResourceZone.h
+* @brief CPU time, page faults, context switches and hardware counters of scoped zones
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_RESOURCEZONEINCLUDE
+#define _NICE_RESOURCEZONEINCLUDE
+
+#include <iostream>
+#include <string>
+
+#include "core/basics/Profiler.h"
+#include "core/basics/HardwareCounters.h"
+
+namespace NICE {
+
+/** @brief accumulated resources of all calls of a zone */
+struct ResourceZoneStatistics
+{
+  //! number of calls
+  size_t calls;
+  //! wall clock time in seconds
+  double wallTime;
+  //! CPU time of the executing threads in seconds
+  double threadCpuTime;
+  //! page faults served without I/O
+  long minorPageFaults;
+  //! page faults which required I/O
+  long majorPageFaults;
+  //! voluntary context switches
+  long voluntaryContextSwitches;
+  //! involuntary context switches
+  long involuntaryContextSwitches;
+  //! maximum growth of the resident set size during a call in KB
+  long maximumMemoryGrowth;
+  //! hardware events, see HardwareCounters
+  unsigned long long counters[HardwareCounters::NUM_COUNTERS];
+  //! true if the hardware counters were available
+  bool countersAvailable;
+
+  ResourceZoneStatistics ();
+
+  /** instructions per cycle, 0 if not available */
+  double getInstructionsPerCycle () const;
+};
+
+/**
+ * @class ResourceZone
+ * @brief Measures the resources used between its construction and its destruction
+ * by the calling thread: wall clock and thread CPU time, page faults, context
+ * switches, growth of the resident set size and, if available, hardware
+ * counters (see HardwareCounters). The statistics are accumulated per zone
+ * name. Each resource zone is also a zone of the Profiler.
+ *
+ * Resource zones are disabled by default, they are enabled by enable() or
+ * the environment variable NICE_PROFILE_RESOURCES (the report is then
+ * written to Log::timing() at exit). An enabled zone reads /proc and the
+ * counters twice, therefore resource zones should only enclose whole
+ * kernels (e.g. in benchmark programs). The name has to be a string literal.
+ */
+class ResourceZone
+{
+  public:
+    /** enable or disable resource zones, hardware counters are only opened if requested */
+    static void enable ( bool enabled = true, bool useHardwareCounters = true );
+
+    /** true if resource zones are measured */
+    static inline bool isEnabled () { return enabled; };
+
+    /** remove all statistics */
+    static void reset ();
+
+    /** statistics of a zone, returns false if the zone was never measured */
+    static bool getStatistics ( const std::string & name, ResourceZoneStatistics & statistics );
+
+    /**
+    * @brief report: for each zone the number of calls, wall clock and CPU time, page
+    * faults, context switches, memory growth and, if available, instructions per
+    * cycle, cache and branch misses per 1000 instructions
+    */
+    static void writeReport ( std::ostream & os );
+
+    explicit ResourceZone ( const char *name );
+
+    ~ResourceZone ();
+
+  private:
+    /** resources of the calling thread at the beginning of the zone */
+    struct Sample
+    {
+      double wallTime;
+      double threadCpuTime;
+      long minorPageFaults;
+      long majorPageFaults;
+      long voluntaryContextSwitches;
+      long involuntaryContextSwitches;
+      long memory;
+      unsigned long long counters[HardwareCounters::NUM_COUNTERS];
+      bool countersAvailable;
+    };
+
+    static bool enabled;
+    static bool useHardwareCounters;
+
+    static void takeSample ( Sample & sample );
+
+    ProfileZone profileZone;
+    const char *name;
+    bool active;
+    Sample start;
+};
+
+} // namespace
+
+/** measure the resources of the enclosing scope as a zone with the given name (a string literal),
+ * compiling with NICE_NO_PROFILING removes all zones */
+#ifdef NICE_NO_PROFILING
+#define NICE_RESOURCE_ZONE(name)
+#else
+#define NICE_RESOURCE_ZONE(name) NICE::ResourceZone NICE_PROFILE_CONCAT(niceResourceZone, __LINE__) ( name )
+#endif
+
+#endif
@@ -1,4 +1,4 @@
-/** 
+/**
 * @file Config.h
 * @brief configuration mgt
 * @author Erik Rodner
@@ -11,6 +11,7 @@
 #include <map>
 
 #include <string>
+#include <vector>
 #include <algorithm>
 #include <functional>
 #include <cctype>
@@ -19,76 +20,181 @@
 #include <math.h>
 
 #include "core/basics/Persistent.h"
-  
+
 
 
 namespace NICE {
 
 template<class ValueType>
-/** This class provides a structured map. */
-class StructuredMap : public NICE::Persistent 
+/** This class provides a structured map.
+ *
+ * Values are stored in one map per block, such that all values of a block can
+ * be enumerated in O(block size). Additionally, an open addressing hash table
+ * over the pairs (block, key) points to the stored values, a lookup neither
+ * concatenates strings nor traverses a tree and takes O(1) on average.
+ */
+class StructuredMap : public NICE::Persistent
 {
     protected:
       typedef typename std::map<std::string, ValueType> MapValueType;
       typedef typename std::map<std::string, ValueType>::const_iterator MapValueTypeCIterator;
+      typedef typename std::map<std::string, ValueType>::iterator MapValueTypeIterator;
+      typedef typename std::map<std::string, MapValueType> BlockMapType;
+      typedef typename std::map<std::string, MapValueType>::const_iterator BlockMapTypeCIterator;
+
+      /** entry of the hash table (the strings and values belong to the maps and never move) */
+      struct Slot {
+        size_t hash;
+        const std::string *block;
+        const std::string *key;
+        ValueType *value;
+      };
+
+      //! all values of each block
+      BlockMapType conf;
+
+      //! hash table with a power of two size (empty slots have value == NULL)
+      std::vector<Slot> index;
+
+      //! number of values
+      size_t numValues;
 
-      MapValueType conf;
+      /** FNV-1a hash of the pair (block, key) */
+      static size_t hashKey ( const std::string & block, const std::string & key )
+      {
+        size_t h = 2166136261u;
+        for ( size_t i = 0 ; i < block.size() ; i++ )
+          h = ( h ^ (unsigned char)block[i] ) * 16777619u;
+        h = ( h ^ 0xFF ) * 16777619u;
+        for ( size_t i = 0 ; i < key.size() ; i++ )
+          h = ( h ^ (unsigned char)key[i] ) * 16777619u;
+        return h;
+      }
+
+      /** slot of the pair (block, key) or the empty slot where it has to be inserted */
+      size_t findSlot ( size_t h, const std::string & block, const std::string & key ) const
+      {
+        size_t mask = index.size() - 1;
+        size_t i = h & mask;
+        while ( index[i].value != NULL )
+        {
+          const Slot & s = index[i];
+          if ( ( s.hash == h ) && ( *s.key == key ) && ( *s.block == block ) )
+            return i;
+          i = ( i + 1 ) & mask;
+        }
+        return i;
+      }
+
+      /** insert a value into the hash table (the pair must not be in the table) */
+      void insertSlot ( size_t h, const std::string & block, const std::string & key, ValueType *value )
+      {
+        // keep the load factor below 0.5
+        if ( 2 * ( numValues + 1 ) > index.size() )
+          rebuildIndex ( std::max<size_t> ( 16, 2 * index.size() ) );
+        size_t i = findSlot ( h, block, key );
+        index[i].hash = h;
+        index[i].block = &block;
+        index[i].key = &key;
+        index[i].value = value;
+        numValues++;
+      }
+
+      /** rebuild the hash table from the maps */
+      void rebuildIndex ( size_t size )
+      {
+        Slot empty;
+        empty.hash = 0;
+        empty.block = NULL;
+        empty.key = NULL;
+        empty.value = NULL;
+        index.assign ( size, empty );
+        numValues = 0;
+        for ( typename BlockMapType::iterator b = conf.begin(); b != conf.end(); b++ )
+          for ( MapValueTypeIterator k = b->second.begin(); k != b->second.end(); k++ )
+          {
+            size_t h = hashKey ( b->first, k->first );
+            size_t i = findSlot ( h, b->first, k->first );
+            index[i].hash = h;
+            index[i].block = &(b->first);
+            index[i].key = &(k->first);
+            index[i].value = &(k->second);
+            numValues++;
+          }
+      }
 
     public:
-    
+
+      StructuredMap () : numValues ( 0 ) {}
+
+      StructuredMap ( const StructuredMap & map ) : Persistent(), numValues ( 0 )
+      {
+        copyFrom ( map );
+      }
+
+      StructuredMap & operator= ( const StructuredMap & map )
+      {
+        if ( this != &map )
+          copyFrom ( map );
+        return *this;
+      }
+
+      /** pointer to the stored value or NULL if the key does not exist, the
+       * pointer remains valid until clear() or copyFrom() is called */
+      const ValueType *lookup ( const std::string & block, const std::string & key ) const
+      {
+        if ( numValues == 0 )
+          return NULL;
+        size_t i = findSlot ( hashKey ( block, key ), block, key );
+        return index[i].value;
+      }
+
       bool keyExists ( const std::string & block, const std::string & key ) const
       {
-		  std::string newkey = block + "::" + key;
-		  MapValueTypeCIterator map_i = conf.find(newkey);
-		  return ( map_i != conf.end() );
+		  return ( lookup ( block, key ) != NULL );
       }
 
       bool find ( const std::string & block, const std::string & key, ValueType & value ) const
       {
-		  std::string newkey = block + "::" + key;
-		  MapValueTypeCIterator map_i = conf.find(newkey);
-		  if ( map_i == conf.end() ) return false;
-		  value = map_i->second;
+		  const ValueType *v = lookup ( block, key );
+		  if ( v == NULL ) return false;
+		  value = *v;
 		  return true;
       }
 
       void store ( const std::string & block, const std::string & key, const ValueType & value )
       {
-		  std::string newkey = block + "::" + key;
-		  conf[newkey] = value;
+		  size_t h = hashKey ( block, key );
+		  if ( numValues > 0 )
+		  {
+			  size_t i = findSlot ( h, block, key );
+			  if ( index[i].value != NULL ) {
+				  *(index[i].value) = value;
+				  return;
+			  }
+		  }
+		  typename BlockMapType::iterator b = conf.insert ( std::make_pair ( block, MapValueType() ) ).first;
+		  MapValueTypeIterator k = b->second.insert ( std::make_pair ( key, value ) ).first;
+		  insertSlot ( h, b->first, k->first, &(k->second) );
       }
 
       void getAll ( const std::string & block, std::map<std::string, ValueType> & list ) const
       {
-		  // FIXME: optimize this !
-		  for ( MapValueTypeCIterator map_i = conf.begin(); map_i != conf.end() ; map_i++ )
-		  {
-			  std::string key = map_i->first;
-			  ValueType val = map_i->second;
-			  if ( key.find (block + "::") == 0 ) 
-			  {
-			  size_t dpos = key.find_first_of(':', 0);
-			  size_t dend = key.find_first_not_of(':', dpos);
-			  list[key.substr(dend)] = val;
-			  }
-		  }
+		  BlockMapTypeCIterator b = conf.find ( block );
+		  if ( b == conf.end() ) return;
+		  for ( MapValueTypeCIterator map_i = b->second.begin(); map_i != b->second.end() ; map_i++ )
+			  list[map_i->first] = map_i->second;
       }
 
       void getAllBlocks ( std::set<std::string> & blocks ) const
       {
-		  for ( MapValueTypeCIterator map_i = conf.begin(); map_i != conf.end() ; map_i++ )
-		  {
-			  std::string key = map_i->first;
-			  size_t dpos = key.find_first_of(':', 0);
-			  std::string block = key.substr(0,dpos);
-			  if ( blocks.find(block) == blocks.end() )
-			  blocks.insert(block);
-		  }
+		  for ( BlockMapTypeCIterator b = conf.begin(); b != conf.end() ; b++ )
+			  blocks.insert ( b->first );
       }
 
       size_t size () const
       {
-		  return conf.size();
+		  return numValues;
       }
 
 	  void restore (std::istream & is, int format = 0)
@@ -99,35 +205,25 @@ class StructuredMap : public NICE::Persistent
       void clear()
       {
 		  conf.clear();
+		  index.clear();
+		  numValues = 0;
       }
 
       void store ( std::ostream & os, int format = 0 ) const
       {
-		  std::string lastblock = "";
-		  for ( MapValueTypeCIterator i = conf.begin();
-			i != conf.end();
-			i++ ) 
+		  for ( BlockMapTypeCIterator b = conf.begin(); b != conf.end() ; b++ )
 		  {
-			  std::string k = i->first;
-			  size_t dpos = k.find_first_of(':', 0);
-			  size_t dend = k.find_first_not_of(':', dpos);
-			  std::string block = k.substr(0,dpos);
-			  std::string key = k.substr(dend);
-			  ValueType value = i->second;
-
-			  if ( block.compare(lastblock) != 0 ) {
-				  os << std::endl << "[" << block << "]" << std::endl;
-			  }
-			  os << key << " = " << value << std::endl;
-
-			  lastblock = block;
+			  os << std::endl << "[" << b->first << "]" << std::endl;
+			  for ( MapValueTypeCIterator i = b->second.begin(); i != b->second.end(); i++ )
+				  os << i->first << " = " << i->second << std::endl;
 		  }
       }
 
 	  void copyFrom ( const StructuredMap & map )
 	  {
-		  conf.clear();
-		  conf = map.conf;		  
+		  conf = map.conf;
+		  // the hash table has to point to the new maps
+		  rebuildIndex ( map.index.size() );
 	  }
 };
 
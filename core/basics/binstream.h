@@ -57,6 +57,21 @@ class ibinstream {
 public:
   virtual void read(char* data, unsigned int length) = 0;
   virtual ~ibinstream() {}
+
+  /**
+   * Read a contiguous block of arbitrary size with as few calls of read()
+   * as possible (use this for arrays of trivially copyable elements instead
+   * of reading them one by one).
+   */
+  void readBlock(char* data, size_t length) {
+    const size_t maxLength = 1u << 30;
+    while ( length > 0 ) {
+      size_t n = ( length < maxLength ) ? length : maxLength;
+      read(data, (unsigned int) n);
+      data += n;
+      length -= n;
+    }
+  }
   
   ibinstream &operator>>(bool &n) { 
     read((char*) &n, sizeof(bool)); return *this;
@@ -142,6 +157,20 @@ class obinstream {
 public:
   virtual void write(char* data, unsigned int length) = 0;
   virtual ~obinstream() {}
+
+  /**
+   * Write a contiguous block of arbitrary size with as few calls of write()
+   * as possible (see ibinstream::readBlock).
+   */
+  void writeBlock(const char* data, size_t length) {
+    const size_t maxLength = 1u << 30;
+    while ( length > 0 ) {
+      size_t n = ( length < maxLength ) ? length : maxLength;
+      write(const_cast<char*>(data), (unsigned int) n);
+      data += n;
+      length -= n;
+    }
+  }
   
   obinstream &operator<<(bool n) { 
     write((char*) &n, sizeof(bool)); return *this; 
@@ -47,6 +47,13 @@ int main(int argc, char* argv[])
   std::cerr << "memory:" << memory << std::endl;
   std::cerr << "user cpu time:" << userCpuTime << std::endl;
   std::cerr << "system cpu time:" << systemCpuTime << std::endl;
+
+  ResourceSample sample;
+  resources.getSample(sample);
+  std::cerr << "current memory:" << sample.currentMemory << std::endl;
+  std::cerr << "peak memory:" << sample.peakMemory << std::endl;
+  std::cerr << "page faults (minor/major):" << sample.minorPageFaults << " " << sample.majorPageFaults << std::endl;
+  std::cerr << "context switches (voluntary/involuntary):" << sample.voluntaryContextSwitches << " " << sample.involuntaryContextSwitches << std::endl;
   
   return 0;
 }
@@ -0,0 +1,227 @@
+#include "AllocatorTest.h"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace NICE;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( AllocatorTest );
+
+namespace {
+
+int constructed = 0;
+int destroyed = 0;
+
+struct Counted
+{
+  int value;
+  Counted () : value ( 7 ) { constructed++; };
+  ~Counted () { destroyed++; };
+};
+
+struct Throwing
+{
+  Throwing ()
+  {
+    if ( constructed == 3 )
+      throw std::bad_alloc();
+    constructed++;
+  };
+  ~Throwing () { destroyed++; };
+};
+
+//! counts the blocks it passes to an AlignedAllocator
+class CountingAllocator : public AlignedAllocator
+{
+  public:
+    int blocks;
+
+    CountingAllocator () : blocks ( 0 ) {};
+
+    void *allocate ( size_t bytes )
+    {
+      blocks++;
+      return AlignedAllocator::allocate ( bytes );
+    };
+
+    void deallocate ( void *p, size_t bytes )
+    {
+      blocks--;
+      AlignedAllocator::deallocate ( p, bytes );
+    };
+};
+
+}
+
+void AllocatorTest::setUp() {
+  constructed = 0;
+  destroyed = 0;
+}
+
+void AllocatorTest::tearDown() {
+  Allocator::setAllocator ( NULL );
+}
+
+void AllocatorTest::testSizeClasses() {
+  CPPUNIT_ASSERT_EQUAL ( 0, PoolAllocator::sizeClass ( 1 ) );
+  CPPUNIT_ASSERT_EQUAL ( 0, PoolAllocator::sizeClass ( 128 ) );
+  CPPUNIT_ASSERT_EQUAL ( 1, PoolAllocator::sizeClass ( 129 ) );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)160, PoolAllocator::classSize ( 1 ) );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)256, PoolAllocator::classSize ( 4 ) );
+
+  // every size fits into its class and wastes at most 25%
+  for ( size_t bytes = 129 ; bytes < ( 1 << 22 ) ; bytes = bytes * 9 / 8 + 1 )
+  {
+    int c = PoolAllocator::sizeClass ( bytes );
+    CPPUNIT_ASSERT ( c > 0 );
+    CPPUNIT_ASSERT ( PoolAllocator::classSize ( c ) >= bytes );
+    CPPUNIT_ASSERT ( PoolAllocator::classSize ( c - 1 ) < bytes );
+    CPPUNIT_ASSERT ( PoolAllocator::classSize ( c ) <= bytes + bytes / 4 );
+  }
+  CPPUNIT_ASSERT_EQUAL ( -1, PoolAllocator::sizeClass ( (size_t)1 << 40 ) );
+}
+
+void AllocatorTest::testAlignment() {
+  AlignedAllocator aligned;
+  PoolAllocator pool;
+  AllocatorBase *allocators[] = { &aligned, &pool };
+  for ( int a = 0 ; a < 2 ; a++ )
+  {
+    Allocator::setAllocator ( allocators[a] );
+    vector<void *> blocks;
+    for ( size_t bytes = 0 ; bytes < 100000 ; bytes = 2 * bytes + 3 )
+    {
+      void *p = Allocator::allocate ( bytes );
+      CPPUNIT_ASSERT ( Allocator::isAligned ( p ) );
+      CPPUNIT_ASSERT_EQUAL ( bytes, Allocator::getSize ( p ) );
+      memset ( p, 0xab, bytes );
+      blocks.push_back ( p );
+    }
+    for ( size_t i = 0 ; i < blocks.size() ; i++ )
+      Allocator::deallocate ( blocks[i] );
+    Allocator::deallocate ( NULL );
+  }
+  Allocator::setAllocator ( NULL );
+}
+
+void AllocatorTest::testArrays() {
+  Counted *counted = Allocator::newArray<Counted> ( 5 );
+  CPPUNIT_ASSERT_EQUAL ( 5, constructed );
+  CPPUNIT_ASSERT_EQUAL ( 7, counted[4].value );
+  Allocator::deleteArray ( counted );
+  CPPUNIT_ASSERT_EQUAL ( 5, destroyed );
+  Allocator::deleteArray ( (Counted *)NULL );
+
+  string *strings = Allocator::newArray<string> ( 3 );
+  strings[2] = "a string which is too long for the small string optimization";
+  Allocator::deleteArray ( strings );
+
+  double *empty = Allocator::newArray<double> ( 0 );
+  CPPUNIT_ASSERT ( empty != NULL );
+  Allocator::deleteArray ( empty );
+
+  // objects constructed before an exception are destroyed
+  constructed = 0;
+  destroyed = 0;
+  CPPUNIT_ASSERT_THROW ( Allocator::newArray<Throwing> ( 5 ), std::bad_alloc );
+  CPPUNIT_ASSERT_EQUAL ( 3, destroyed );
+}
+
+void AllocatorTest::testStatistics() {
+  PoolAllocator pool;
+  Allocator::setAllocator ( &pool );
+
+  AllocatorStatistics before, after;
+  Allocator::getStatistics ( before );
+  Allocator::resetPeak();
+
+  double *a = Allocator::newArray<double> ( 1000 );
+  double *b = Allocator::newArray<double> ( 1000 );
+  Allocator::getStatistics ( after );
+  CPPUNIT_ASSERT_EQUAL ( before.bytesLive + 16000, after.bytesLive );
+  CPPUNIT_ASSERT ( after.bytesPeak >= after.bytesLive );
+  CPPUNIT_ASSERT_EQUAL ( before.allocations + 2, after.allocations );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)2, after.poolMisses );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)0, after.poolHits );
+
+  Allocator::deleteArray ( a );
+  Allocator::deleteArray ( b );
+  Allocator::getStatistics ( after );
+  CPPUNIT_ASSERT_EQUAL ( before.bytesLive, after.bytesLive );
+  CPPUNIT_ASSERT_EQUAL ( before.deallocations + 2, after.deallocations );
+  CPPUNIT_ASSERT ( after.bytesCached >= 16000 );
+
+  // temporaries of the same size are served by the pool
+  for ( int i = 0 ; i < 10 ; i++ )
+    Allocator::deleteArray ( Allocator::newArray<double> ( 1000 ) );
+  Allocator::getStatistics ( after );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)10, after.poolHits );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)2, after.poolMisses );
+
+  // large blocks are not pooled
+  Allocator::deleteArray ( Allocator::newArray<double> ( 1 << 20 ) );
+  Allocator::getStatistics ( after );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)10, after.poolHits );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)2, after.poolMisses );
+
+  Allocator::trim();
+  Allocator::getStatistics ( after );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)0, after.bytesCached );
+
+  ostringstream os;
+  Allocator::writeStatistics ( os );
+  CPPUNIT_ASSERT ( os.str().find ( "pool hits 10" ) != string::npos );
+  Allocator::setAllocator ( NULL );
+}
+
+void AllocatorTest::testSetAllocator() {
+  CountingAllocator counting;
+  double *before = Allocator::newArray<double> ( 10 );
+
+  Allocator::setAllocator ( &counting );
+  CPPUNIT_ASSERT ( Allocator::getAllocator() == &counting );
+  double *during = Allocator::newArray<double> ( 10 );
+  CPPUNIT_ASSERT_EQUAL ( 1, counting.blocks );
+  // blocks are returned to the allocator which created them
+  Allocator::deleteArray ( before );
+  CPPUNIT_ASSERT_EQUAL ( 1, counting.blocks );
+
+  Allocator::setAllocator ( NULL );
+  CPPUNIT_ASSERT ( Allocator::getAllocator() != &counting );
+  Allocator::deleteArray ( during );
+  CPPUNIT_ASSERT_EQUAL ( 0, counting.blocks );
+}
+
+void AllocatorTest::testThreads() {
+  AllocatorStatistics before, after;
+  Allocator::getStatistics ( before );
+
+  // blocks allocated by one thread may be released by another one
+  const int n = 2000;
+  vector<double *> blocks ( n );
+#pragma omp parallel for
+  for ( int i = 0 ; i < n ; i++ )
+  {
+    blocks[i] = Allocator::newArray<double> ( 1 + i % 300 );
+    blocks[i][0] = i;
+  }
+  int errors = 0;
+#pragma omp parallel for reduction(+:errors)
+  for ( int i = n - 1 ; i >= 0 ; i-- )
+  {
+    if ( !Allocator::isAligned ( blocks[i] ) || ( blocks[i][0] != i ) )
+      errors++;
+    double *tmp = Allocator::newArray<double> ( 100 );
+    Allocator::deleteArray ( tmp );
+    Allocator::deleteArray ( blocks[i] );
+  }
+
+  CPPUNIT_ASSERT_EQUAL ( 0, errors );
+
+  Allocator::getStatistics ( after );
+  CPPUNIT_ASSERT_EQUAL ( before.bytesLive, after.bytesLive );
+  CPPUNIT_ASSERT_EQUAL ( after.allocations - before.allocations, after.deallocations - before.deallocations );
+}
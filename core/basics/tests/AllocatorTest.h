@@ -0,0 +1,36 @@
+#ifndef ALLOCATORTEST_H
+#define ALLOCATORTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "core/basics/Allocator.h"
+
+/**
+ * CppUnit-Testcase. 
+ * Tests for Allocator, AlignedAllocator and PoolAllocator.
+ */
+class AllocatorTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE( AllocatorTest );
+  CPPUNIT_TEST( testSizeClasses );
+  CPPUNIT_TEST( testAlignment );
+  CPPUNIT_TEST( testArrays );
+  CPPUNIT_TEST( testStatistics );
+  CPPUNIT_TEST( testSetAllocator );
+  CPPUNIT_TEST( testThreads );
+  CPPUNIT_TEST_SUITE_END();
+  
+ private:
+ 
+ public:
+  void setUp();
+  void tearDown();
+
+  void testSizeClasses();
+  void testAlignment();
+  void testArrays();
+  void testStatistics();
+  void testSetAllocator();
+  void testThreads();
+
+};
+
+#endif // ALLOCATORTEST_H
@@ -0,0 +1,161 @@
+#include "BenchmarkTest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+using namespace NICE;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( BenchmarkTest );
+
+namespace {
+
+class CountingCase : public BenchmarkCase
+{
+  public:
+    int setUpCalls;
+    int runCalls;
+    int tearDownCalls;
+
+    CountingCase ( const string & name ) : BenchmarkCase ( "test", name ),
+      setUpCalls ( 0 ), runCalls ( 0 ), tearDownCalls ( 0 ) {};
+
+    void setUp () { setUpCalls++; };
+
+    void run ()
+    {
+      runCalls++;
+      double sum = 0.0;
+      for ( int i = 1 ; i <= 1000 ; i++ )
+        sum += 1.0 / i;
+      keep ( sum );
+    };
+
+    void tearDown () { tearDownCalls++; };
+};
+
+BenchmarkResult makeResult ( const string & name, double median, double mad )
+{
+  BenchmarkResult r;
+  r.suite = "test";
+  r.name = name;
+  r.repetitions = 5;
+  r.iterations = 10;
+  r.median = median;
+  r.mad = mad;
+  r.minimum = median - mad;
+  r.mean = median;
+  return r;
+}
+
+}
+
+void BenchmarkTest::setUp() {
+}
+
+void BenchmarkTest::tearDown() {
+}
+
+void BenchmarkTest::testStatistics() {
+  vector<double> values;
+  values.push_back ( 3.0 );
+  values.push_back ( 1.0 );
+  values.push_back ( 100.0 );
+  values.push_back ( 2.0 );
+  values.push_back ( 4.0 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 3.0, BenchmarkRunner::median ( values ), 1e-12 );
+  // deviations 0, 2, 97, 1, 1
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 1.0, BenchmarkRunner::medianAbsoluteDeviation ( values ), 1e-12 );
+  values.pop_back();
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 2.5, BenchmarkRunner::median ( values ), 1e-12 );
+}
+
+void BenchmarkTest::testRun() {
+  BenchmarkRunner runner;
+  CountingCase *selected = new CountingCase ( "selected" );
+  CountingCase *skipped = new CountingCase ( "skipped" );
+  runner.add ( selected );
+  runner.add ( skipped );
+  runner.setWarmupRepetitions ( 1 );
+  runner.setRepetitions ( 3 );
+  runner.setMinimumTime ( 0.001 );
+  runner.setFilter ( "test/sel" );
+
+  ostringstream progress;
+  runner.run ( progress );
+
+  CPPUNIT_ASSERT_EQUAL ( (size_t)1, runner.getResults().size() );
+  const BenchmarkResult & r = runner.getResults()[0];
+  CPPUNIT_ASSERT_EQUAL ( string ( "selected" ), r.name );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)3, r.repetitions );
+  CPPUNIT_ASSERT ( r.iterations >= 1 );
+  CPPUNIT_ASSERT ( r.median > 0.0 );
+  CPPUNIT_ASSERT ( r.minimum <= r.median );
+  CPPUNIT_ASSERT ( r.mad >= 0.0 );
+
+  CPPUNIT_ASSERT_EQUAL ( 1, selected->setUpCalls );
+  CPPUNIT_ASSERT_EQUAL ( 1, selected->tearDownCalls );
+  CPPUNIT_ASSERT ( selected->runCalls >= (int)( 3 * r.iterations ) );
+  CPPUNIT_ASSERT_EQUAL ( 0, skipped->setUpCalls );
+  CPPUNIT_ASSERT_EQUAL ( 0, skipped->runCalls );
+  CPPUNIT_ASSERT ( progress.str().find ( "test/selected" ) != string::npos );
+}
+
+void BenchmarkTest::testFiles() {
+  BenchmarkRunner runner;
+  runner.add ( new CountingCase ( "a, \"quoted\"" ) );
+  runner.add ( new CountingCase ( "b" ) );
+  runner.setWarmupRepetitions ( 0 );
+  runner.setRepetitions ( 2 );
+  runner.setMinimumTime ( 0.001 );
+  ostringstream progress;
+  runner.run ( progress );
+
+  const char *formats[] = { "BenchmarkTest.json", "BenchmarkTest.csv" };
+  for ( int f = 0 ; f < 2 ; f++ )
+  {
+    {
+      ofstream ofs ( formats[f] );
+      if ( f == 0 )
+        runner.writeJSON ( ofs );
+      else
+        runner.writeCSV ( ofs );
+    }
+    vector<BenchmarkResult> results;
+    BenchmarkRunner::readResults ( formats[f], results );
+    remove ( formats[f] );
+
+    CPPUNIT_ASSERT_EQUAL ( runner.getResults().size(), results.size() );
+    for ( size_t i = 0 ; i < results.size() ; i++ )
+    {
+      const BenchmarkResult & expected = runner.getResults()[i];
+      CPPUNIT_ASSERT_EQUAL ( expected.suite, results[i].suite );
+      CPPUNIT_ASSERT_EQUAL ( expected.name, results[i].name );
+      CPPUNIT_ASSERT_EQUAL ( expected.iterations, results[i].iterations );
+      CPPUNIT_ASSERT_DOUBLES_EQUAL ( expected.median, results[i].median, 1e-6 * expected.median );
+      CPPUNIT_ASSERT_DOUBLES_EQUAL ( expected.mad, results[i].mad, 1e-6 * expected.median );
+    }
+  }
+}
+
+void BenchmarkTest::testCompare() {
+  vector<BenchmarkResult> baseline;
+  baseline.push_back ( makeResult ( "faster", 1.0, 0.01 ) );
+  baseline.push_back ( makeResult ( "noisy", 1.0, 0.2 ) );
+  baseline.push_back ( makeResult ( "slower", 1.0, 0.01 ) );
+  baseline.push_back ( makeResult ( "removed", 1.0, 0.01 ) );
+
+  vector<BenchmarkResult> current;
+  current.push_back ( makeResult ( "faster", 0.5, 0.01 ) );
+  current.push_back ( makeResult ( "noisy", 1.3, 0.2 ) );
+  current.push_back ( makeResult ( "slower", 1.3, 0.01 ) );
+  current.push_back ( makeResult ( "added", 1.0, 0.01 ) );
+
+  ostringstream table;
+  // only "slower" is slower than the threshold and outside of the noise
+  CPPUNIT_ASSERT_EQUAL ( (size_t)1, BenchmarkRunner::compare ( current, baseline, 0.1, table ) );
+  CPPUNIT_ASSERT ( table.str().find ( "REGRESSION" ) != string::npos );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)0, BenchmarkRunner::compare ( current, baseline, 0.5, table ) );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)0, BenchmarkRunner::compare ( baseline, baseline, 0.0, table ) );
+}
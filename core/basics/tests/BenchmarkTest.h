@@ -0,0 +1,32 @@
+#ifndef BENCHMARKTEST_H
+#define BENCHMARKTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "core/basics/Benchmark.h"
+
+/**
+ * CppUnit-Testcase. 
+ * Tests for BenchmarkRunner.
+ */
+class BenchmarkTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE( BenchmarkTest );
+  CPPUNIT_TEST( testStatistics );
+  CPPUNIT_TEST( testRun );
+  CPPUNIT_TEST( testFiles );
+  CPPUNIT_TEST( testCompare );
+  CPPUNIT_TEST_SUITE_END();
+  
+ private:
+ 
+ public:
+  void setUp();
+  void tearDown();
+
+  void testStatistics();
+  void testRun();
+  void testFiles();
+  void testCompare();
+
+};
+
+#endif // BENCHMARKTEST_H
@@ -0,0 +1,141 @@
+#include "ConfigTest.h"
+
+#include <sstream>
+
+using namespace std;
+using namespace NICE;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ConfigTest );
+
+
+void ConfigTest::setUp() {
+}
+
+void ConfigTest::tearDown() {
+}
+
+void ConfigTest::testParsing() {
+  stringstream ss;
+  ss << "# comment" << endl
+     << "[main]" << endl
+     << "count = 42" << endl
+     << "negative = -7 ;" << endl
+     << "sigma = 2.5e-3" << endl
+     << "flag = true" << endl
+     << "other = false" << endl
+     << "name = \"some file.txt\"" << endl
+     << "letter = e" << endl
+     << "  [ Kernel ]  " << endl
+     << "  gamma=0.5" << endl;
+
+  Config conf;
+  conf.restore ( ss );
+
+  CPPUNIT_ASSERT_EQUAL ( 42, conf.gI ( "main", "count" ) );
+  CPPUNIT_ASSERT_EQUAL ( -7, conf.gI ( "main", "negative" ) );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 2.5e-3, conf.gD ( "main", "sigma" ), 1e-15 );
+  CPPUNIT_ASSERT_EQUAL ( true, conf.gB ( "main", "flag" ) );
+  CPPUNIT_ASSERT_EQUAL ( false, conf.gB ( "main", "other" ) );
+  CPPUNIT_ASSERT_EQUAL ( string ( "some file.txt" ), conf.gS ( "main", "name" ) );
+  CPPUNIT_ASSERT_EQUAL ( string ( "e" ), conf.gS ( "main", "letter" ) );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 0.5, conf.gD ( "Kernel", "gamma" ), 0.0 );
+
+  // integers are accepted as double values
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 42.0, conf.gD ( "main", "count" ), 0.0 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 1.0, conf.gD ( "main", "missing", 1.0 ), 0.0 );
+  CPPUNIT_ASSERT ( conf.keyExists ( "Kernel", "gamma" ) );
+  CPPUNIT_ASSERT ( ! conf.keyExists ( "Kernel", "sigma" ) );
+
+  // store and restore
+  stringstream ss2;
+  conf.store ( ss2 );
+  Config conf2;
+  conf2.restore ( ss2 );
+  CPPUNIT_ASSERT_EQUAL ( 42, conf2.gI ( "main", "count" ) );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 0.5, conf2.gD ( "Kernel", "gamma" ), 0.0 );
+  CPPUNIT_ASSERT_EQUAL ( string ( "some file.txt" ), conf2.gS ( "main", "name" ) );
+}
+
+void ConfigTest::testArguments() {
+  const char *args[] = { "prog", "--verbose", "-Kernel:gamma", "0.25", "--no-cache", "-n", "-5", "input.txt", NULL };
+  Config conf ( 8, const_cast<char **> ( args ) );
+
+  CPPUNIT_ASSERT_EQUAL ( true, conf.gB ( "main", "verbose" ) );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 0.25, conf.gD ( "Kernel", "gamma" ), 0.0 );
+  CPPUNIT_ASSERT_EQUAL ( false, conf.gB ( "main", "cache" ) );
+  CPPUNIT_ASSERT_EQUAL ( -5, conf.gI ( "main", "n" ) );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)1, conf.getMoreOptions().size() );
+  CPPUNIT_ASSERT_EQUAL ( string ( "input.txt" ), conf.getMoreOptions()[0] );
+}
+
+void ConfigTest::testHandles() {
+  Config conf;
+  conf.sD ( "Kernel", "gamma", 0.5 );
+  conf.sI ( "Kernel", "degree", 3 );
+
+  Config::Handle<double> gamma ( conf, "Kernel", "gamma" );
+  Config::Handle<double> degreeAsDouble ( conf, "Kernel", "degree" );
+  Config::Handle<int> iterations ( conf, "Solver", "iterations", 100 );
+  Config::Handle<std::string> method ( conf, "Solver", "method", "cg" );
+
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 0.5, gamma(), 0.0 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 3.0, degreeAsDouble(), 0.0 );
+  CPPUNIT_ASSERT_EQUAL ( 100, iterations() );
+  CPPUNIT_ASSERT_EQUAL ( string ( "cg" ), method.get() );
+
+  // handles follow modifications of the config
+  conf.sD ( "Kernel", "gamma", 0.125 );
+  conf.sI ( "Solver", "iterations", 7 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 0.125, gamma(), 0.0 );
+  CPPUNIT_ASSERT_EQUAL ( 7, iterations() );
+
+  conf.clear();
+  CPPUNIT_ASSERT_EQUAL ( 100, iterations() );
+  CPPUNIT_ASSERT_EQUAL ( string ( "cg" ), method() );
+
+  // handles follow an assignment, even from a config with the same generation
+  Config other;
+  other.sI ( "Solver", "iterations", 42 );
+  Config fresh;
+  fresh.sI ( "Solver", "restarts", 1 );
+  Config::Handle<int> freshIterations ( fresh, "Solver", "iterations", 100 );
+  CPPUNIT_ASSERT_EQUAL ( 100, freshIterations() );
+  fresh = other;
+  CPPUNIT_ASSERT_EQUAL ( 42, freshIterations() );
+  conf = other;
+  CPPUNIT_ASSERT_EQUAL ( 42, iterations() );
+}
+
+void ConfigTest::testBlocks() {
+  Config conf;
+  for ( int i = 0 ; i < 1000 ; i++ )
+  {
+    ostringstream key;
+    key << "key" << i;
+    conf.sI ( ( i % 2 == 0 ) ? "even" : "odd", key.str(), i );
+  }
+  conf.sD ( "a", "x", 1.0 );
+  conf.sD ( "a0", "x", 2.0 );
+
+  map<string, int> even;
+  conf.getAllI ( "even", even );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)500, even.size() );
+  CPPUNIT_ASSERT_EQUAL ( 998, even["key998"] );
+
+  // blocks which are prefixes of other blocks
+  map<string, double> a;
+  conf.getAllD ( "a", a );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)1, a.size() );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 1.0, a["x"], 0.0 );
+
+  set<string> blocks;
+  conf.getAllBlocks ( blocks );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)4, blocks.size() );
+
+  // copies have their own index
+  Config copy ( conf );
+  conf.sI ( "odd", "key1", -1 );
+  CPPUNIT_ASSERT_EQUAL ( 1, copy.gI ( "odd", "key1" ) );
+  CPPUNIT_ASSERT_EQUAL ( -1, conf.gI ( "odd", "key1" ) );
+  CPPUNIT_ASSERT_EQUAL ( 999, copy.gI ( "odd", "key999" ) );
+}
@@ -0,0 +1,32 @@
+#ifndef CONFIGTEST_H
+#define CONFIGTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "core/basics/Config.h"
+
+/**
+ * CppUnit-Testcase. 
+ * Tests for Config.
+ */
+class ConfigTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE( ConfigTest );
+  CPPUNIT_TEST( testParsing );
+  CPPUNIT_TEST( testArguments );
+  CPPUNIT_TEST( testHandles );
+  CPPUNIT_TEST( testBlocks );
+  CPPUNIT_TEST_SUITE_END();
+  
+ private:
+ 
+ public:
+  void setUp();
+  void tearDown();
+
+  void testParsing();
+  void testArguments();
+  void testHandles();
+  void testBlocks();
+
+};
+
+#endif // CONFIGTEST_H
@@ -0,0 +1,129 @@
+#include "LogTest.h"
+
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace NICE;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( LogTest );
+
+namespace {
+
+int numFormatted = 0;
+
+//! counts how often a message is formatted
+int formatted ( int value )
+{
+  numFormatted++;
+  return value;
+}
+
+stringstream debugTarget;
+stringstream errorTarget;
+
+}
+
+void LogTest::setUp() {
+  debugTarget.clear();
+  debugTarget.str ( "" );
+  errorTarget.clear();
+  errorTarget.str ( "" );
+  Log::debugLog().setTarget ( debugTarget );
+  Log::errorLog().setTarget ( errorTarget );
+  Log::setLevel ( Log::LEVEL_DEBUG );
+}
+
+void LogTest::tearDown() {
+  Log::stopAsync();
+  Log::setLevel ( Log::LEVEL_DEBUG );
+  Log::debugLog().setTarget ( std::cerr );
+  Log::errorLog().setTarget ( std::cerr );
+}
+
+void LogTest::testLevels() {
+  numFormatted = 0;
+  NICE_LOG_DEBUG ( "value " << formatted ( 1 ) );
+  NICE_LOG_ERROR ( "error " << formatted ( 2 ) );
+  CPPUNIT_ASSERT_EQUAL ( 2, numFormatted );
+  CPPUNIT_ASSERT_EQUAL ( string ( "value 1\n" ), debugTarget.str() );
+  CPPUNIT_ASSERT_EQUAL ( string ( "error 2\n" ), errorTarget.str() );
+
+  // disabled records are not formatted
+  Log::setLevel ( Log::LEVEL_WARNING );
+  CPPUNIT_ASSERT ( !Log::isEnabled ( Log::LEVEL_DEBUG ) );
+  CPPUNIT_ASSERT ( Log::isEnabled ( Log::LEVEL_ERROR ) );
+  NICE_LOG_DEBUG ( "value " << formatted ( 3 ) );
+  NICE_LOG_WARNING ( "warning " << formatted ( 4 ) );
+  CPPUNIT_ASSERT_EQUAL ( 3, numFormatted );
+  CPPUNIT_ASSERT_EQUAL ( string ( "value 1\n" ), debugTarget.str() );
+  CPPUNIT_ASSERT_EQUAL ( string ( "error 2\nwarning 4\n" ), errorTarget.str() );
+
+  Log::setLevel ( Log::LEVEL_NONE );
+  NICE_LOG_ERROR ( "error " << formatted ( 5 ) );
+  CPPUNIT_ASSERT_EQUAL ( 3, numFormatted );
+
+  // quiet logs discard the records
+  Log::setLevel ( Log::LEVEL_DEBUG );
+  Log::debugLog().setQuiet ( true );
+  NICE_LOG_DEBUG ( "quiet" );
+  Log::debugLog().setQuiet ( false );
+  CPPUNIT_ASSERT_EQUAL ( string ( "value 1\n" ), debugTarget.str() );
+}
+
+void LogTest::testFields() {
+  NICE_LOG_DEBUG ( "GBCDSolver: iteration" << logField ( "iteration", 3 ) << logField ( "delta", 0.5 ) );
+  CPPUNIT_ASSERT_EQUAL ( string ( "GBCDSolver: iteration iteration=3 delta=0.5\n" ), debugTarget.str() );
+}
+
+void LogTest::testThreads() {
+  const int n = 1000;
+#pragma omp parallel for
+  for ( int i = 0 ; i < n ; i++ )
+    NICE_LOG_DEBUG ( "line" << logField ( "i", i ) << " end" );
+
+  // each line has to be complete
+  string line;
+  int numLines = 0;
+  while ( getline ( debugTarget, line ) )
+  {
+    CPPUNIT_ASSERT_EQUAL ( string ( "line i=" ), line.substr ( 0, 7 ) );
+    CPPUNIT_ASSERT_EQUAL ( string ( " end" ), line.substr ( line.size() - 4 ) );
+    numLines++;
+  }
+  CPPUNIT_ASSERT_EQUAL ( n, numLines );
+}
+
+void LogTest::testAsync() {
+#ifndef WIN32
+  Log::startAsync ( 16 );
+  for ( int i = 0 ; i < 100 ; i++ )
+    NICE_LOG_DEBUG ( "async " << i );
+  Log::flush();
+
+  string line;
+  int numLines = 0;
+  while ( getline ( debugTarget, line ) )
+  {
+    ostringstream expected;
+    expected << "async " << numLines;
+    CPPUNIT_ASSERT_EQUAL ( expected.str(), line );
+    numLines++;
+  }
+  CPPUNIT_ASSERT_EQUAL ( 100, numLines );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)0, Log::numDropped() );
+  Log::stopAsync();
+
+  // a full queue drops lines instead of waiting
+  debugTarget.clear();
+  debugTarget.str ( "" );
+  Log::startAsync ( 1, true );
+  for ( int i = 0 ; i < 1000 ; i++ )
+    NICE_LOG_DEBUG ( "dropped " << i );
+  Log::stopAsync();
+  int written = 0;
+  while ( getline ( debugTarget, line ) )
+    written++;
+  CPPUNIT_ASSERT_EQUAL ( (size_t)1000, written + Log::numDropped() );
+#endif
+}
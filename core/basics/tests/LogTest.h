@@ -0,0 +1,32 @@
+#ifndef LOGTEST_H
+#define LOGTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "core/basics/Log.h"
+
+/**
+ * CppUnit-Testcase. 
+ * Tests for Log.
+ */
+class LogTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE( LogTest );
+  CPPUNIT_TEST( testLevels );
+  CPPUNIT_TEST( testFields );
+  CPPUNIT_TEST( testThreads );
+  CPPUNIT_TEST( testAsync );
+  CPPUNIT_TEST_SUITE_END();
+  
+ private:
+ 
+ public:
+  void setUp();
+  void tearDown();
+
+  void testLevels();
+  void testFields();
+  void testThreads();
+  void testAsync();
+
+};
+
+#endif // LOGTEST_H
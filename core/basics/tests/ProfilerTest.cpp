@@ -0,0 +1,125 @@
+#include "ProfilerTest.h"
+
+#include <unistd.h>
+#include <pthread.h>
+#include <sstream>
+
+using namespace std;
+using namespace NICE;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ProfilerTest );
+
+namespace {
+
+void inner ()
+{
+  NICE_PROFILE_ZONE ( "ProfilerTest::inner" );
+  usleep ( 2000 );
+}
+
+void outer ()
+{
+  NICE_PROFILE_ZONE ( "ProfilerTest::outer" );
+  inner();
+  inner();
+  usleep ( 1000 );
+}
+
+void *recordZones ( void * )
+{
+  for ( int i = 0 ; i < 50 ; i++ )
+  {
+    NICE_PROFILE_ZONE ( "ProfilerTest::thread" );
+  }
+  return NULL;
+}
+
+}
+
+void ProfilerTest::setUp() {
+  Profiler::reset();
+}
+
+void ProfilerTest::tearDown() {
+  Profiler::enable ( false );
+  Profiler::setMaxEventsPerThread ( 1 << 20 );
+  Profiler::reset();
+}
+
+void ProfilerTest::testZones() {
+  // nothing is recorded by a disabled profiler
+  Profiler::enable ( false );
+  outer();
+  CPPUNIT_ASSERT_EQUAL ( (size_t)0, Profiler::numEvents() );
+
+  Profiler::enable();
+  outer();
+  CPPUNIT_ASSERT_EQUAL ( (size_t)3, Profiler::numEvents() );
+
+  unsigned long long t0 = Profiler::ticks();
+  usleep ( 1000 );
+  CPPUNIT_ASSERT ( Profiler::ticks() - t0 >= 1000000ull );
+
+  // full buffers drop zones
+  Profiler::reset();
+  Profiler::setMaxEventsPerThread ( 2 );
+  outer();
+  CPPUNIT_ASSERT_EQUAL ( (size_t)2, Profiler::numEvents() );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)1, Profiler::numDroppedEvents() );
+}
+
+void ProfilerTest::testReports() {
+  Profiler::enable();
+#pragma omp parallel for
+  for ( int i = 0 ; i < 4 ; i++ )
+    outer();
+
+  stringstream report;
+  Profiler::writeReport ( report );
+  string line;
+  bool foundInner = false;
+  bool foundOuter = false;
+  while ( getline ( report, line ) )
+  {
+    istringstream ss ( line );
+    string name;
+    size_t calls;
+    double total, self;
+    if ( ! ( ss >> name >> calls >> total >> self ) )
+      continue;
+    if ( name == "ProfilerTest::inner" ) {
+      foundInner = true;
+      CPPUNIT_ASSERT_EQUAL ( (size_t)8, calls );
+      CPPUNIT_ASSERT_DOUBLES_EQUAL ( total, self, 1e-9 );
+    } else if ( name == "ProfilerTest::outer" ) {
+      foundOuter = true;
+      CPPUNIT_ASSERT_EQUAL ( (size_t)4, calls );
+      // the self time excludes the nested zones (2 x 2ms per call)
+      CPPUNIT_ASSERT ( self < total - 4 * 3.5 );
+      CPPUNIT_ASSERT ( self >= 4 * 0.9 );
+    }
+  }
+  CPPUNIT_ASSERT ( foundInner );
+  CPPUNIT_ASSERT ( foundOuter );
+
+  stringstream trace;
+  Profiler::writeChromeTrace ( trace );
+  string json = trace.str();
+  CPPUNIT_ASSERT ( json.find ( "{\"traceEvents\":[" ) == 0 );
+  CPPUNIT_ASSERT ( json.find ( "\"name\":\"ProfilerTest::outer\",\"ph\":\"X\"" ) != string::npos );
+  CPPUNIT_ASSERT ( json.find ( "\"displayTimeUnit\":\"ms\"}" ) != string::npos );
+}
+
+void ProfilerTest::testThreads() {
+  // threads which are not started by OpenMP register their buffers concurrently
+  Profiler::enable();
+  pthread_t threads[8];
+  for ( int i = 0 ; i < 8 ; i++ )
+    CPPUNIT_ASSERT_EQUAL ( 0, pthread_create ( &threads[i], NULL, recordZones, NULL ) );
+  for ( int i = 0 ; i < 8 ; i++ )
+    Profiler::numEvents();
+  for ( int i = 0 ; i < 8 ; i++ )
+    pthread_join ( threads[i], NULL );
+
+  CPPUNIT_ASSERT_EQUAL ( (size_t)400, Profiler::numEvents() );
+}
@@ -0,0 +1,30 @@
+#ifndef PROFILERTEST_H
+#define PROFILERTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "core/basics/Profiler.h"
+
+/**
+ * CppUnit-Testcase. 
+ * Tests for Profiler.
+ */
+class ProfilerTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE( ProfilerTest );
+  CPPUNIT_TEST( testZones );
+  CPPUNIT_TEST( testReports );
+  CPPUNIT_TEST( testThreads );
+  CPPUNIT_TEST_SUITE_END();
+  
+ private:
+ 
+ public:
+  void setUp();
+  void tearDown();
+
+  void testZones();
+  void testReports();
+  void testThreads();
+
+};
+
+#endif // PROFILERTEST_H
@@ -0,0 +1,180 @@
+#include "ResourceStatisticsTest.h"
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#endif
+
+using namespace std;
+using namespace NICE;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ResourceStatisticsTest );
+
+namespace {
+
+//! touch 32 MB such that the resident set size grows
+double touchMemory ()
+{
+  std::vector<char> buffer ( 32 << 20 );
+  memset ( &(buffer[0]), 1, buffer.size() );
+  double sum = 0.0;
+  for ( size_t i = 0 ; i < buffer.size() ; i += 4096 )
+    sum += buffer[i];
+  return sum;
+}
+
+double compute ( int n )
+{
+  double sum = 0.0;
+  for ( int i = 1 ; i <= n ; i++ )
+    sum += 1.0 / i;
+  return sum;
+}
+
+#ifdef __linux__
+//! number of open file descriptors of the process
+int countOpenFiles ()
+{
+  DIR *dir = opendir ( "/proc/self/fd" );
+  if ( dir == NULL )
+    return -1;
+  int n = 0;
+  while ( readdir ( dir ) != NULL )
+    n++;
+  closedir ( dir );
+  return n;
+}
+
+void *shortZone ( void * )
+{
+  NICE_RESOURCE_ZONE ( "ResourceStatisticsTest::thread" );
+  compute ( 1000 );
+  return NULL;
+}
+#endif
+
+}
+
+void ResourceStatisticsTest::setUp() {
+  ResourceZone::reset();
+}
+
+void ResourceStatisticsTest::tearDown() {
+  ResourceZone::enable ( false );
+  ResourceZone::reset();
+}
+
+void ResourceStatisticsTest::testSample() {
+#ifndef WIN32
+  ResourceStatistics resources;
+  ResourceSample before, after;
+  resources.getSample ( before );
+  CPPUNIT_ASSERT ( before.currentMemory > 0 );
+  CPPUNIT_ASSERT ( before.peakMemory >= before.currentMemory );
+
+  long memory;
+  resources.getCurrentMemory ( memory );
+  CPPUNIT_ASSERT ( memory > 0 );
+
+  double sum = touchMemory() + compute ( 20000000 );
+  CPPUNIT_ASSERT ( sum > 0.0 );
+  resources.getSample ( after );
+
+  CPPUNIT_ASSERT ( after.wallTime > before.wallTime );
+  CPPUNIT_ASSERT ( after.threadCpuTime > before.threadCpuTime );
+  CPPUNIT_ASSERT ( after.userCpuTime + after.systemCpuTime > before.userCpuTime + before.systemCpuTime );
+  // 32 MB are at least 8192 pages (or a few huge pages)
+  CPPUNIT_ASSERT ( after.minorPageFaults > before.minorPageFaults );
+  CPPUNIT_ASSERT ( after.peakMemory >= before.peakMemory + 16 * 1024 );
+
+  long minorFaults, majorFaults;
+  resources.getPageFaults ( minorFaults, majorFaults );
+  CPPUNIT_ASSERT ( minorFaults >= after.minorPageFaults );
+  long voluntary, involuntary;
+  resources.getContextSwitches ( voluntary, involuntary );
+  CPPUNIT_ASSERT ( voluntary >= 0 && involuntary >= 0 );
+#endif
+}
+
+void ResourceStatisticsTest::testHardwareCounters() {
+  // counters are not available on every machine, they have to be zero then
+  HardwareCounters counters;
+  unsigned long long before[HardwareCounters::NUM_COUNTERS];
+  unsigned long long after[HardwareCounters::NUM_COUNTERS];
+  counters.read ( before );
+  double sum = compute ( 1000000 );
+  CPPUNIT_ASSERT ( sum > 0.0 );
+  counters.read ( after );
+
+  for ( int i = 0 ; i < HardwareCounters::NUM_COUNTERS ; i++ )
+  {
+    if ( counters.isAvailable ( i ) )
+      CPPUNIT_ASSERT ( after[i] >= before[i] );
+    else
+      CPPUNIT_ASSERT ( after[i] == 0 );
+  }
+  if ( counters.isAvailable ( HardwareCounters::INSTRUCTIONS ) )
+    CPPUNIT_ASSERT ( after[HardwareCounters::INSTRUCTIONS] - before[HardwareCounters::INSTRUCTIONS] > 1000000 );
+  CPPUNIT_ASSERT_EQUAL ( string ( "cycles" ), string ( HardwareCounters::getName ( HardwareCounters::CYCLES ) ) );
+}
+
+void ResourceStatisticsTest::testZones() {
+  ResourceZoneStatistics statistics;
+
+  // disabled zones are not measured
+  {
+    NICE_RESOURCE_ZONE ( "ResourceStatisticsTest::disabled" );
+  }
+  CPPUNIT_ASSERT ( !ResourceZone::getStatistics ( "ResourceStatisticsTest::disabled", statistics ) );
+
+  ResourceZone::enable();
+  for ( int i = 0 ; i < 3 ; i++ )
+  {
+    NICE_RESOURCE_ZONE ( "ResourceStatisticsTest::compute" );
+    CPPUNIT_ASSERT ( compute ( 2000000 ) > 0.0 );
+  }
+  {
+    NICE_RESOURCE_ZONE ( "ResourceStatisticsTest::memory" );
+    CPPUNIT_ASSERT ( touchMemory() > 0.0 );
+  }
+
+  CPPUNIT_ASSERT ( ResourceZone::getStatistics ( "ResourceStatisticsTest::compute", statistics ) );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)3, statistics.calls );
+  CPPUNIT_ASSERT ( statistics.wallTime > 0.0 );
+  CPPUNIT_ASSERT ( statistics.threadCpuTime > 0.0 );
+  if ( statistics.countersAvailable && statistics.counters[HardwareCounters::CYCLES] > 0 )
+    CPPUNIT_ASSERT ( statistics.getInstructionsPerCycle() > 0.0 );
+
+  CPPUNIT_ASSERT ( ResourceZone::getStatistics ( "ResourceStatisticsTest::memory", statistics ) );
+#ifndef WIN32
+  CPPUNIT_ASSERT ( statistics.minorPageFaults > 1000 );
+#endif
+
+  ostringstream report;
+  ResourceZone::writeReport ( report );
+  CPPUNIT_ASSERT ( report.str().find ( "ResourceStatisticsTest::compute" ) != string::npos );
+  CPPUNIT_ASSERT ( report.str().find ( "ResourceStatisticsTest::memory" ) != string::npos );
+}
+
+void ResourceStatisticsTest::testThreadExit() {
+#ifdef __linux__
+  // the counters of a thread are closed at its exit
+  ResourceZone::enable();
+  int before = countOpenFiles();
+  for ( int i = 0 ; i < 50 ; i++ )
+  {
+    pthread_t thread;
+    CPPUNIT_ASSERT_EQUAL ( 0, pthread_create ( &thread, NULL, shortZone, NULL ) );
+    pthread_join ( thread, NULL );
+  }
+  CPPUNIT_ASSERT_EQUAL ( before, countOpenFiles() );
+
+  ResourceZoneStatistics statistics;
+  CPPUNIT_ASSERT ( ResourceZone::getStatistics ( "ResourceStatisticsTest::thread", statistics ) );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)50, statistics.calls );
+#endif
+}
@@ -0,0 +1,33 @@
+#ifndef RESOURCESTATISTICSTEST_H
+#define RESOURCESTATISTICSTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "core/basics/ResourceStatistics.h"
+#include "core/basics/ResourceZone.h"
+
+/**
+ * CppUnit-Testcase. 
+ * Tests for ResourceStatistics, HardwareCounters and ResourceZone.
+ */
+class ResourceStatisticsTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE( ResourceStatisticsTest );
+  CPPUNIT_TEST( testSample );
+  CPPUNIT_TEST( testHardwareCounters );
+  CPPUNIT_TEST( testZones );
+  CPPUNIT_TEST( testThreadExit );
+  CPPUNIT_TEST_SUITE_END();
+  
+ private:
+ 
+ public:
+  void setUp();
+  void tearDown();
+
+  void testSample();
+  void testHardwareCounters();
+  void testZones();
+  void testThreadExit();
+
+};
+
+#endif // RESOURCESTATISTICSTEST_H
@@ -17,6 +17,7 @@ namespace NICE {
 
 
 #include "core/image/ippwrapper.h"
+#include "core/basics/CrossplatformDefines.h"
 
 #include "core/image/Drawable.h"
 #include "core/image/CoordT.h"
@@ -66,6 +67,14 @@ public:
     ColorImageT(const ColorImageT<P>& orig,
                 const GrayColorImageCommonImplementation::MemoryLayout copyMode = GrayColorImageCommonImplementation::originalAlignment);
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+    /**
+    * Move constructor: takes the pixel memory of \c orig, which is empty afterwards.
+    * The pixels of an \c orig with foreign pixel memory are copied.
+    */
+    ColorImageT(ColorImageT<P>&& orig);
+#endif
+
     /**
     * Create a shallow copy of \c orig directly using orig's pixel memory.
     * Pixels are not copied, onwership of pixel memory is not taken.
@@ -743,6 +752,19 @@ public:
     */
     ColorImageT<P>& operator=(const ColorImageT<P>& orig);
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+    /**
+    * Move assignment: takes the pixel memory of \c orig if neither image uses
+    * foreign pixel memory, and copies the pixels otherwise.
+    */
+    ColorImageT<P>& operator=(ColorImageT<P>&& orig);
+#endif
+
+    /**
+    * Exchange the pixel memory of both images without copying pixels.
+    */
+    void swap(ColorImageT<P>& orig);
+
     /**
     * Copy \c image to this (external pointers to image become invalid)
     * @param image Original ColorImageT
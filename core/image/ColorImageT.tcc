@@ -86,6 +86,39 @@ ColorImageT<P>& ColorImageT<P>::operator=(const ColorImageT<P>& orig) {
   return *this;
 }
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+template <class P>
+ColorImageT<P>::ColorImageT(ColorImageT<P>&& orig) : GrayColorImageCommonImplementationT<P>(),
+                     ColorImageAccess() {
+  this->m_columnStepsize = this->channels() * sizeof(P);
+  this->m_memoryLayout = GrayColorImageCommonImplementation::noAlignment;
+  if (orig.getMemoryLayout() == GrayColorImageCommonImplementation::internal__foreignPointer) {
+    fromRaw(orig.getPixelPointer(), orig.width(), orig.height(),
+            orig.getStepsize(), this->toCopyLayout(GrayColorImageCommonImplementation::originalAlignment, orig));
+  } else {
+    this->swapPixel(orig);
+  }
+}
+
+template <class P>
+ColorImageT<P>& ColorImageT<P>::operator=(ColorImageT<P>&& orig) {
+  if (this->getMemoryLayout() == GrayColorImageCommonImplementation::internal__foreignPointer
+      || orig.getMemoryLayout() == GrayColorImageCommonImplementation::internal__foreignPointer) {
+    return operator=(static_cast<const ColorImageT<P>&>(orig));
+  }
+  if (this != &orig) {
+    this->deallocPixel();
+    this->swapPixel(orig);
+  }
+  return *this;
+}
+#endif
+
+template <class P>
+void ColorImageT<P>::swap(ColorImageT<P>& orig) {
+  this->swapPixel(orig);
+}
+
 template <class P>
 ColorImageT<P>::ColorImageT(ColorImageT<P>& orig,
                             const GrayColorImageCommonImplementation::ShallowCopyMode shallow) {
@@ -198,7 +231,7 @@ template <class P>
 void ColorImageT<P>::doAllocPixelNoAlignment() {
   this->m_columnStepsize = this->channels() * sizeof(P);
   this->m_rowStepsize = sizeof(P) * this->m_xsize * this->channels();
-  this->setPixelPointer(new P[this->m_xsize * this->m_ysize * this->channels()]);
+  this->setPixelPointer(Allocator::newArray<P>(this->m_xsize * this->m_ysize * this->channels()));
 }
 
 template <class P>
@@ -211,6 +211,12 @@ FloatImage* grayToFloat(const ImageT<P>& src, FloatImage* dst)
                     fthrow(ImageException, ippGetStatusString(ret));
 
     #else
+        // native kernels for Ipp8u, ippStsDataTypeErr for the other types
+        if(ippiConvert_C1R(src.getPixelPointer(), src.getStepsize(),
+                           result->getPixelPointer(), result->getStepsize(),
+                           makeROIFullImage(src)) == ippStsNoErr)
+            return result;
+
         const P* pSrcStart = src.getPixelPointer();
         Ipp32f*  pDstStart = result->getPixelPointer();
 
@@ -248,6 +254,12 @@ ImageT<P>* floatToGray(const FloatImage& src, ImageT<P>* dst, IppRoundMode round
                     fthrow(ImageException, ippGetStatusString(ret));
 
     #else
+        // native kernels for Ipp8u, ippStsDataTypeErr for the other types
+        if(ippiConvert_C1R(src.getPixelPointer(), src.getStepsize(),
+                           result->getPixelPointer(), result->getStepsize(),
+                           makeROIFullImage(src), roundMode) == ippStsNoErr)
+            return result;
+
         const Ipp32f* pSrcStart = src.getPixelPointer();
         P*  pDstStart           = result->getPixelPointer();
 
@@ -295,10 +295,10 @@ Image* DeprecatedConverter::nonMaximumSuppression(const GrayImage16s& dx, const
 #else
     {
             if(x==17 && y==17) {
-                cout << mag.getPixelQuick(x,y) << " " << dx.getPixelQuick(x,y) << " " << dy.getPixelQuick(x,y) << endl;
-                cout << mag.getPixelQuick(x-1,y-1) << " " << mag.getPixelQuick(x,y-1) << " " << mag.getPixelQuick(x+1,y-1) << endl;
-                cout << mag.getPixelQuick(x-1,y) << " " << mag.getPixelQuick(x,y) << " " << mag.getPixelQuick(x+1,y) << endl;
-                cout << mag.getPixelQuick(x-1,y+1) << " " << mag.getPixelQuick(x,y+1) << " " << mag.getPixelQuick(x+1,y+1) << endl;
+                NICE_LOG_DEBUG ( mag.getPixelQuick(x,y) << " " << dx.getPixelQuick(x,y) << " " << dy.getPixelQuick(x,y) );
+                NICE_LOG_DEBUG ( mag.getPixelQuick(x-1,y-1) << " " << mag.getPixelQuick(x,y-1) << " " << mag.getPixelQuick(x+1,y-1) );
+                NICE_LOG_DEBUG ( mag.getPixelQuick(x-1,y) << " " << mag.getPixelQuick(x,y) << " " << mag.getPixelQuick(x+1,y) );
+                NICE_LOG_DEBUG ( mag.getPixelQuick(x-1,y+1) << " " << mag.getPixelQuick(x,y+1) << " " << mag.getPixelQuick(x+1,y+1) );
              }
             float m=mag.getPixelQuick(x,y);
             if(isZero(m)) {
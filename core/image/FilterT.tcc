@@ -1,12 +1,14 @@
 #include <iostream>
 #include "ImageT.h"
 #include <core/image/FilterT.h>
+#include "core/basics/Profiler.h"
 
 namespace NICE {
  
 template<class SrcType, class CalcType, class DstType>
 void FilterT<SrcType, CalcType, DstType>::filterX ( const ImageT<SrcType>& src, const VectorT<CalcType>& kernel, ImageT<DstType> &result, const int& anchor )
 {
+  NICE_PROFILE_ZONE ( "FilterT::filterX" );
   if(result.width() != src.width() || result.height() != src.height())
   {
     result.resize(src.width(), src.height());
@@ -46,6 +48,7 @@ void FilterT<SrcType, CalcType, DstType>::filterX ( const ImageT<SrcType>& src,
 template<class SrcType, class CalcType, class DstType>
 void FilterT<SrcType, CalcType, DstType>::filterY ( const ImageT<SrcType>& src, const VectorT<CalcType>& kernel, ImageT<DstType>& result, const int& anchor )
 {
+  NICE_PROFILE_ZONE ( "FilterT::filterY" );
   if(result.width() != src.width() || result.height() != src.height())
   {
     result.resize(src.width(), src.height());
@@ -76,6 +79,7 @@ template<class SrcType, class CalcType, class DstType>
 void FilterT<SrcType, CalcType, DstType>::filter(const ImageT<SrcType>& src,
 		const MatrixT<CalcType>& kernel, ImageT<DstType>& result,
 		const int& anchorx, const int& anchory) {
+	NICE_PROFILE_ZONE ( "FilterT::filter" );
 
 	if (result.width() != src.width() || result.height() != src.height()) {
 		result.resize(src.width(), src.height());
@@ -115,6 +119,7 @@ void FilterT<SrcType, CalcType, DstType>::filter(const ImageT<SrcType>& src,
 template<class SrcType, class CalcType, class DstType>
 void FilterT<SrcType, CalcType, DstType>::sobelX ( const NICE::ImageT<SrcType> &src, NICE::ImageT<DstType> &dst)
 {
+  NICE_PROFILE_ZONE ( "FilterT::sobelX" );
   if(dst.width() != src.width() || dst.height() != src.height() )
   {
     dst.resize(src.width(), src.height());
@@ -138,6 +143,7 @@ void FilterT<SrcType, CalcType, DstType>::sobelX ( const NICE::ImageT<SrcType> &
 template<class SrcType, class CalcType, class DstType>
 void FilterT<SrcType, CalcType, DstType>::sobelY ( const NICE::ImageT<SrcType> &src, NICE::ImageT<DstType> &dst)
 {
+  NICE_PROFILE_ZONE ( "FilterT::sobelY" );
   if(dst.width() != src.width() || dst.height() != src.height() )
   {
     dst.resize (src.width(), src.height());
@@ -161,6 +167,7 @@ void FilterT<SrcType, CalcType, DstType>::sobelY ( const NICE::ImageT<SrcType> &
 template<class SrcType, class CalcType, class DstType>
 void FilterT<SrcType, CalcType, DstType>::gradientStrength ( const NICE::ImageT<SrcType> &src, NICE::ImageT<DstType> &dst)
 {
+  NICE_PROFILE_ZONE ( "FilterT::gradientStrength" );
   
   if(dst.width() != src.width() || dst.height() != src.height() )
   {
@@ -189,6 +196,7 @@ void FilterT<SrcType, CalcType, DstType>::gradientStrength ( const NICE::ImageT<
 template<class SrcType, class CalcType, class DstType>
 ImageT<DstType> * FilterT<SrcType, CalcType, DstType>::filterMean ( const NICE::ImageT<SrcType>& src, const uint& size, ImageT<DstType>* dst )
 {
+  NICE_PROFILE_ZONE ( "FilterT::filterMean" );
   ImageT<DstType>* result = createResultBuffer ( src, dst );
 
   int isize = size;
@@ -229,6 +237,7 @@ ImageT<DstType> * FilterT<SrcType, CalcType, DstType>::filterMean ( const NICE::
 template<class SrcType, class CalcType, class DstType>
 ImageT<DstType> * FilterT<SrcType, CalcType, DstType>::filterMeanLargeFS ( const ImageT<SrcType>& src, const uint& size, ImageT<DstType>* dst )
 {
+  NICE_PROFILE_ZONE ( "FilterT::filterMeanLargeFS" );
   ImageT<DstType>* result = createResultBuffer ( src, dst );
   ImageT<CalcType> tmp ( src.width(), src.height() );
 
@@ -321,6 +330,7 @@ template<class SrcType, class CalcType, class DstType>
 ImageT<DstType> * FilterT<SrcType, CalcType, DstType>::filterGaussSigmaApproximate ( const NICE::ImageT<SrcType> &src, double sigma, NICE::ImageT<DstType> *dst,
     bool use_filtersize_independent_implementation )
 {
+  NICE_PROFILE_ZONE ( "FilterT::filterGaussSigmaApproximate" );
   // We use the idea of Wells 1986
   // Efficient Synthesis of Gaussian Filters by Cascaded Uniform Filters
   // http://ieeexplore.ieee.org/stamp/stamp.jsp?arnumber=04767776
@@ -20,6 +20,7 @@
 
 //normal includes
 #include "Fourier.h"
+#include "core/basics/Log.h"
 
 //IF ICE is available TODO REPLACE BY FFTW DIRECTLY
 #ifdef NICE_USELIB_ICE 
@@ -65,7 +66,7 @@ void Fourier::FourierTransformInverse(NICE::FloatImage &freq_real, NICE::FloatIm
 #ifdef NICE_USELIB_ICE 
      if (freq_real.width() != freq_imag.width() || freq_real.height() != freq_imag.height())
      {
-          fprintf(stderr, "Fourier_FourierTransformInverse: Image Dimension must agree!\n");
+          NICE_LOG_ERROR ( "Fourier_FourierTransformInverse: Image Dimension must agree!" );
           fthrow(ImageException, "Fourier_FourierTransformInverse: Image Dimension do not agree.");
      }
      else
@@ -96,7 +97,7 @@ void Fourier::CrossCorrelation(const NICE::FloatImage &img1, const NICE::FloatIm
 #ifdef NICE_USELIB_ICE 
      if (img1.width() != img2.width() || img1.height() != img2.height())
      {
-          fprintf(stderr, "Fourier_CrossCorrelation: Image Dimension must agree!\n");
+          NICE_LOG_ERROR ( "Fourier_CrossCorrelation: Image Dimension must agree!" );
           fthrow(ImageException, "Fourier_CrossCorrelation: Image Dimension do not agree.");
      }
      else
@@ -41,7 +41,8 @@ public:
    * \c ippAlignment Use IPP alignment
    *    (if IPP is not available, this is currently the same as \c noAlignment)
    * \c noAlignment There must not be any alignment
-   *    (may cost performance when using IPP)
+   *    (may cost performance when using IPP); the first pixel is
+   *    still aligned to \c Allocator::ALIGNMENT bytes
    * \c originalAlignment Only valid when copying: use the same alignment
    * \c internal__foreignPointer internal usage only (do not free such memory)
    */
@@ -9,6 +9,8 @@ namespace NICE {
   class ImageFile;
 }
 
+#include "core/basics/Allocator.h"
+#include "core/basics/CrossplatformDefines.h"
 #include "core/image/ippwrapper.h"
 #include "core/image/pointerArithmetic.h"
 #include "core/image/ImageException.h"
@@ -250,6 +252,12 @@ protected:
    */
   void deallocPixel();
 
+  /**
+   * Exchange pixel memory, size, step sizes and memory layout with \c other.
+   * No pixels are copied.
+   */
+  void swapPixel(GrayColorImageCommonImplementationT<P>& other);
+
   /**
    * Allocate memory for pixel data.
    * Deallocate existing data before allocating.
@@ -3,6 +3,7 @@
  *  - libimage - An ImageT library
  * See file License for license information.
  */
+#include <algorithm>
 #include <fstream>
 #include <cmath>
 #include "core/image/GrayColorImageCommonImplementationT.h"
@@ -78,7 +79,7 @@ void GrayColorImageCommonImplementationT<P>::deallocPixel() {
       break;
 #endif
     case noAlignment:
-      delete[] getPixelPointer();
+      Allocator::deleteArray ( getPixelPointer() );
       break;
     case internal__foreignPointer:
       // nothing to do
@@ -90,6 +91,17 @@ void GrayColorImageCommonImplementationT<P>::deallocPixel() {
   }
 }
 
+template <class P>
+void GrayColorImageCommonImplementationT<P>::swapPixel(GrayColorImageCommonImplementationT<P>& other) {
+  std::swap(m_pixel, other.m_pixel);
+  std::swap(m_pixelConst, other.m_pixelConst);
+  std::swap(m_xsize, other.m_xsize);
+  std::swap(m_ysize, other.m_ysize);
+  std::swap(m_rowStepsize, other.m_rowStepsize);
+  std::swap(m_columnStepsize, other.m_columnStepsize);
+  std::swap(m_memoryLayout, other.m_memoryLayout);
+}
+
 template <class P>
 GrayColorImageCommonImplementationT<P>::~GrayColorImageCommonImplementationT() {
   deallocPixel();
@@ -18,6 +18,7 @@
 #include <sstream>
 #include "core/image/ImageFile.h"
 #include "core/image/Convert.h"
+#include "core/basics/Log.h"
 
 #ifdef NICE_USELIB_LIMUN_IOCOMPRESSION
     #include "iocompression/pipestream.h"
@@ -116,7 +117,7 @@ void ImageFile::readerPNG(GrayColorImageCommonImplementationT<Ipp32f> *image)
 		try {
         	magick_image.read ( filename );
 		} catch ( Magick::Warning &error) {
-			std::cerr << "libMagick++ warning: " << error.what() << std::endl;
+			NICE_LOG_WARNING ( "libMagick++ warning: " << error.what() );
 		}
 	// FIXME: maybe we should provide the possibility to read images with arbitary memory alignment
         if(image->widthInline()!=(int)magick_image.baseColumns() || image->heightInline()!=(int)magick_image.baseRows()
@@ -1,5 +1,6 @@
 #include <core/image/ImageFile.h>
 #include <core/image/ImageT.h>
+#include <core/basics/Profiler.h>
 #include <core/image/ColorImageT.h>
 #include <core/image/Convert.h>
 #include <core/basics/stringutils.h>
@@ -34,6 +35,7 @@ void ImageFile::writerMagick ( const GrayColorImageCommonImplementationT<unsigne
 template<class P>
 void ImageFile::reader ( GrayColorImageCommonImplementationT<P> *image )
 {
+  NICE_PROFILE_ZONE ( "ImageFile::reader" );
   switch ( fileType() )
   {
 
@@ -69,6 +71,7 @@ void ImageFile::reader ( GrayColorImageCommonImplementationT<P> *image )
 template<class P>
 void ImageFile::writer ( const GrayColorImageCommonImplementationT<P> *image ) const
 {
+  NICE_PROFILE_ZONE ( "ImageFile::writer" );
   switch ( fileType() )
   {
     case ImageFile::PNG:
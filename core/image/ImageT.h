@@ -8,6 +8,7 @@
 #define _LIMUN_GRAYIMAGET_H
 
 #include <core/image/ippwrapper.h>
+#include <core/basics/CrossplatformDefines.h>
 
 #include <core/image/CoordT.h>
 #include <core/image/ColorT.h>
@@ -64,6 +65,14 @@ class ImageT: public BlockImageAccessT<P> {
     ImageT ( const ImageT<P>& orig, const GrayColorImageCommonImplementation::MemoryLayout copyMode =
                GrayColorImageCommonImplementation::originalAlignment );
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+    /**
+     * Move constructor: takes the pixel memory of \c orig, which is empty afterwards.
+     * The pixels of an \c orig with foreign pixel memory are copied.
+     */
+    ImageT ( ImageT<P>&& orig );
+#endif
+
     /**
      * Create a shallow copy of \c orig directly using orig's pixel memory.
      * Pixels are not copied, onwership of pixel memory is not taken.
@@ -676,6 +685,19 @@ class ImageT: public BlockImageAccessT<P> {
      */
     ImageT<P>& operator= ( const ImageT<P>& orig );
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+    /**
+     * Move assignment: takes the pixel memory of \c orig if neither image uses
+     * foreign pixel memory, and copies the pixels otherwise.
+     */
+    ImageT<P>& operator= ( ImageT<P>&& orig );
+#endif
+
+    /**
+     * Exchange the pixel memory of both images without copying pixels.
+     */
+    void swap ( ImageT<P>& orig );
+
     /**
      * Copy \c image to this (external pointers to image become invalid)
      * @param image Original ColorImageT
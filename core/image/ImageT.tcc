@@ -56,6 +56,37 @@ ImageT<P>& ImageT<P>::operator= ( const ImageT<P>& orig ) {
   return *this;
 }
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+template<class P>
+ImageT<P>::ImageT ( ImageT<P>&& orig ) : BlockImageAccessT<P> () {
+  this->m_memoryLayout = GrayColorImageCommonImplementation::noAlignment;
+  if ( orig.getMemoryLayout() == GrayColorImageCommonImplementation::internal__foreignPointer ) {
+    this->fromRaw ( orig.getPixelPointer(), orig.width(), orig.height(), orig.rowStepsize(), this->toCopyLayout (
+                      GrayColorImageCommonImplementation::originalAlignment, orig ) );
+  } else {
+    this->swapPixel ( orig );
+  }
+}
+
+template<class P>
+ImageT<P>& ImageT<P>::operator= ( ImageT<P>&& orig ) {
+  if ( this->getMemoryLayout() == GrayColorImageCommonImplementation::internal__foreignPointer
+       || orig.getMemoryLayout() == GrayColorImageCommonImplementation::internal__foreignPointer ) {
+    return operator= ( static_cast<const ImageT<P>&> ( orig ) );
+  }
+  if ( this != &orig ) {
+    this->deallocPixel();
+    this->swapPixel ( orig );
+  }
+  return *this;
+}
+#endif
+
+template<class P>
+void ImageT<P>::swap ( ImageT<P>& orig ) {
+  this->swapPixel ( orig );
+}
+
 template<class P>
 ImageT<P>::ImageT ( ImageT<P>& orig, const GrayColorImageCommonImplementation::ShallowCopyMode shallow ) {
   UNUSED_PARAMETER ( shallow );
@@ -114,7 +145,7 @@ ImageT<P>::ImageT ( const std::string& FileName, const GrayColorImageCommonImple
 
 template<class P>
 void ImageT<P>::doAllocPixelNoAlignment() {
-  this->setPixelPointer ( new P[this->m_xsize * this->m_ysize] );
+  this->setPixelPointer ( Allocator::newArray<P> ( this->m_xsize * this->m_ysize ) );
   this->m_rowStepsize = sizeof ( P ) * this->m_xsize;
 }
 
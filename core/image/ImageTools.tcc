@@ -1,6 +1,7 @@
 
 #include <core/image/ImageTools.h>
 #include <core/image/ippwrapper.h>
+#include <core/basics/Log.h>
 
 namespace NICE {
 
@@ -155,7 +156,7 @@ void normalizeToRange(ImageT<P> &src, P min, P max)
                }
           }
           
-          fprintf(stderr,"normalizeToRange: Input-Image max value = min value");
+          NICE_LOG_WARNING ( "normalizeToRange: Input-Image max value = min value" );
      }
      
 }
@@ -5,6 +5,7 @@
 #include <limits>
 
 #include <iostream>
+#include "core/basics/Profiler.h"
 using namespace std;
 
 namespace NICE {
@@ -128,6 +129,7 @@ namespace NICE {
 
 Image* rank(const Image& src, const uint& size, const uint& rank, Image* dst)
 {
+    NICE_PROFILE_ZONE ( "Morph::rank" );
     if( rank>((2*size+1)*(2*size+1)) || rank<1 )
         fthrow(ImageException,"Rank smaller 1 or bigger than (2*size+1)x(2*size+1) not allowed.");
 
@@ -171,6 +173,7 @@ Image* rank(const Image& src, const uint& size, const uint& rank, Image* dst)
 
 Image* erode(const Image& src, Image* dst, const size_t& size)
 {
+    NICE_PROFILE_ZONE ( "Morph::erode" );
     Image* result = createResultBuffer(src, dst);
     copyBorder ( src, size, size, dst );
 
@@ -238,6 +241,7 @@ Image* erode(const Image& src, Image* dst, const size_t& size)
 
 Image* median(const Image& src, Image* dst, const size_t& size)
 {
+    NICE_PROFILE_ZONE ( "Morph::median" );
     Image* result = createResultBuffer(src, dst);
     copyBorder ( src, size, size, dst );
 
@@ -294,6 +298,7 @@ Image* median(const Image& src, Image* dst, const size_t& size)
 
 Image* dilate(const Image& src, Image* dst, const size_t& size)
 {
+    NICE_PROFILE_ZONE ( "Morph::dilate" );
     Image* result = createResultBuffer(src, dst);
     copyBorder ( src, size, size, dst );
 
@@ -362,6 +367,7 @@ Image* dilate(const Image& src, Image* dst, const size_t& size)
 
 Image* opening(const Image& src, Image* dst, const size_t& size)
 {
+    NICE_PROFILE_ZONE ( "Morph::opening" );
     Image* temp   = new Image(src.width(), src.height());
     temp              = erode(src, temp, size);
 
@@ -376,6 +382,7 @@ Image* opening(const Image& src, Image* dst, const size_t& size)
 
 Image* closing(const Image& src, Image* dst, const size_t& size)
 {
+    NICE_PROFILE_ZONE ( "Morph::closing" );
     Image* temp   = new Image(src.width(), src.height());
     temp              = dilate(src, temp, size);
 
@@ -435,6 +442,7 @@ Image* closing(const Image& src, Image* dst, const size_t& size)
 
 Image* rank(const Image& src, const CharMatrix& structureElement, const size_t& rank, Image* dst)
 {
+    NICE_PROFILE_ZONE ( "Morph::rank" );
     Image* result   = createResultBuffer(src, dst);
     copyBorder ( src, structureElement.cols()/2, structureElement.rows()/2, dst );
     size_t entries      = getNonZeroElements(structureElement);
@@ -477,6 +485,7 @@ Image* rank(const Image& src, const CharMatrix& structureElement, const size_t&
 
 Image* median(const Image& src, const CharMatrix& structureElement, Image* dst)
 {
+    NICE_PROFILE_ZONE ( "Morph::median" );
     Image* result = createResultBuffer(src, dst);
     size_t nonZero    = getNonZeroElements(structureElement);
 
@@ -485,6 +494,7 @@ Image* median(const Image& src, const CharMatrix& structureElement, Image* dst)
 
 Image* erode(const Image& src, const CharMatrix& structureElement, Image* dst)
 {
+    NICE_PROFILE_ZONE ( "Morph::erode" );
      Image* result = createResultBuffer(src, dst);
      copyBorder ( src, structureElement.cols()/2, structureElement.rows()/2, dst );
 
@@ -522,6 +532,7 @@ Image* erode(const Image& src, const CharMatrix& structureElement, Image* dst)
 
 Image* dilate(const Image& src, const CharMatrix& structureElement, Image* dst)
 {
+    NICE_PROFILE_ZONE ( "Morph::dilate" );
     Image* result = createResultBuffer(src, dst);
     copyBorder ( src, structureElement.cols()/2,  structureElement.rows()/2, dst );
 
@@ -559,6 +570,7 @@ Image* dilate(const Image& src, const CharMatrix& structureElement, Image* dst)
 
 Image* opening(const Image& src, const CharMatrix& structureElement, Image* dst)
 {
+    NICE_PROFILE_ZONE ( "Morph::opening" );
     Image* temp   = new Image(src.width(), src.height());
     temp              = erode(src, structureElement, temp);
 
@@ -573,6 +585,7 @@ Image* opening(const Image& src, const CharMatrix& structureElement, Image* dst)
 
 Image* closing(const Image& src, const CharMatrix& structureElement, Image* dst)
 {
+    NICE_PROFILE_ZONE ( "Morph::closing" );
     Image* temp   = new Image(src.width(), src.height());
     temp              = dilate(src, structureElement, temp);
 
@@ -593,6 +606,7 @@ Image* closing(const Image& src, const CharMatrix& structureElement, Image* dst)
 
 void rankingIP(Image& src, const uint& rank)
 {
+    NICE_PROFILE_ZONE ( "Morph::rankingIP" );
     if( rank>9 || rank<1 )
         fthrow(ImageException,"Rank is out of range.");
 
@@ -661,6 +675,7 @@ void rankingIP(Image& src, const uint& rank)
 
 void erodeIP(Image& src)
 {
+    NICE_PROFILE_ZONE ( "Morph::erodeIP" );
     #ifdef NICE_USELIB_IPP
         IppiSize ROIsize = {src.width()-2, src.height()-2};
         IppStatus ret    = ippiErode3x3_8u_C1IR(src.getPixelPointerXY(1,1), src.getStepsize(), ROIsize);
@@ -736,6 +751,7 @@ void erodeIP(Image& src)
 }
 
 void medianIP(Image& src) {
+    NICE_PROFILE_ZONE ( "Morph::medianIP" );
     Histogram hist(256);
     int  hist_med, hist_temp;
     uint hist_lower = 0;
@@ -808,6 +824,7 @@ void medianIP(Image& src) {
 
 void dilateIP(Image& src)
 {
+    NICE_PROFILE_ZONE ( "Morph::dilateIP" );
     #ifdef NICE_USELIB_IPP
         IppiSize ROIsize = {src.width()-2, src.height()-2};
         IppStatus ret    = ippiDilate3x3_8u_C1IR(src.getPixelPointerXY(1,1), src.getStepsize(), ROIsize);
@@ -885,12 +902,14 @@ void dilateIP(Image& src)
 
 void openingIP(Image& src)
 {
+    NICE_PROFILE_ZONE ( "Morph::openingIP" );
     erodeIP(src);
     dilateIP(src);
 }
 
 void closingIP(Image& src)
 {
+    NICE_PROFILE_ZONE ( "Morph::closingIP" );
     dilateIP(src);
     erodeIP(src);
 }
@@ -903,6 +922,7 @@ void closingIP(Image& src)
 
 Image* hitAndMiss(const Image& src, const CharMatrix& structureElement, Image* dst)
 {
+    NICE_PROFILE_ZONE ( "Morph::hitAndMiss" );
     Image* result = createResultBuffer(src, dst);
     Image* temp   = erode(src, structureElement);
 
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <assert.h>
 #include <stdio.h>
+#include "core/basics/Log.h"
 #include <vector>
 
 namespace NICE {
@@ -501,10 +502,10 @@ void MultiChannelImage3DT<P>::convertToGrey( NICE::Image & img, int z, uint chan
   if ( normalize )
     if ( max - min < std::numeric_limits<double>::min() )
     {
-      fprintf( stderr, "MultiChannelImage3DT<>::showChannel: max %f min %f\n", ( double )max, ( double )min );
+      NICE_LOG_DEBUG ( "MultiChannelImage3DT<>::showChannel: max " << ( double )max << " min " << ( double )min );
       img.set( max );
       skip_assignment = true;
-      fprintf( stderr, "MultiChannelImage3DT<>::showChannel: image is uniform! (%f)\n", ( double )max );
+      NICE_LOG_WARNING ( "MultiChannelImage3DT<>::showChannel: image is uniform! (" << ( double )max << ")" );
     }
 
 
@@ -822,7 +823,7 @@ void MultiChannelImage3DT<P>::store( std::string filename ) const
   FILE *f = fopen( filename.c_str(), "w" );
 
   if ( f == NULL ) {
-    fprintf( stderr, "MultiChannelImage3DT::store: error writing to %s\n", filename.c_str() );
+    NICE_LOG_ERROR ( "MultiChannelImage3DT::store: error writing to " << filename );
     exit( -1 );
   }
 
@@ -847,7 +848,7 @@ void MultiChannelImage3DT<P>::restore( std::string filename )
   FILE *f = fopen( filename.c_str(), "r" );
 
   if ( f == NULL ) {
-    fprintf( stderr, "MultiChannelImage3DT::store: error reading from %s\n", filename.c_str() );
+    NICE_LOG_ERROR ( "MultiChannelImage3DT::store: error reading from " << filename );
     exit( -1 );
   }
 
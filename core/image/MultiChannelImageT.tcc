@@ -1,6 +1,7 @@
 #include <iostream>
 #include <assert.h>
 #include <stdio.h>
+#include "core/basics/Log.h"
 
 namespace NICE {
 template<class P>
@@ -347,7 +348,7 @@ void MultiChannelImageT<P>::convertToGrey( NICE::Image & img, uint channel, bool
 
   if ( normalize ) {
     statistics( min, max, channel );
-    fprintf( stderr, "MultiChannelImageT<>::showChannel: max %f min %f\n", ( double )max, ( double )min );
+    NICE_LOG_DEBUG ( "MultiChannelImageT<>::showChannel: max " << ( double )max << " min " << ( double )min );
   }
 
   bool skip_assignment = false;
@@ -359,7 +360,7 @@ void MultiChannelImageT<P>::convertToGrey( NICE::Image & img, uint channel, bool
     {
       img.set( max );
       skip_assignment = true;
-      fprintf( stderr, "MultiChannelImageT::showChannel: image is uniform! (%f)\n", ( double )max );
+      NICE_LOG_WARNING ( "MultiChannelImageT::showChannel: image is uniform! (" << ( double )max << ")" );
     }
 
 
@@ -486,7 +487,7 @@ void MultiChannelImageT<P>::store( std::string filename ) const
   FILE *f = fopen( filename.c_str(), "w" );
 
   if ( f == NULL ) {
-    fprintf( stderr, "MultiChannelImageT::store: error writing to %s\n", filename.c_str() );
+    NICE_LOG_ERROR ( "MultiChannelImageT::store: error writing to " << filename );
     exit( -1 );
   }
 
@@ -511,7 +512,7 @@ void MultiChannelImageT<P>::restore( std::string filename )
   FILE *f = fopen( filename.c_str(), "r" );
 
   if ( f == NULL ) {
-    fprintf( stderr, "MultiChannelImageT::store: error reading from %s\n", filename.c_str() );
+    NICE_LOG_ERROR ( "MultiChannelImageT::store: error reading from " << filename );
     exit( -1 );
   }
 
@@ -1,4 +1,5 @@
 #include "ippwrapper.h"
+#include <core/vector/SimdKernels.h>
 #include <algorithm>
 
 template<class P>
@@ -23306,8 +23307,7 @@ inline IppStatus ippiSub_C1IR(const Ipp32f* pSrc, int srcStep,
         {
             pS = pSrc + y*sStep;
             pD = pDst + y*dStep;
-            for(int x=0; x<roiSize.width; ++x,++pS,++pD)
-                *pD -= *pS;
+            NICE::SimdKernels::sub(pD,pS,pD,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23331,8 +23331,7 @@ inline IppStatus ippiSub_C1R(const Ipp32f* pSrc1, int src1Step,
             pS1 = pSrc1 + y*s1Step;
             pS2 = pSrc2 + y*s2Step;
             pD  = pDst  + y*dStep;
-            for(int x=0; x<roiSize.width; ++x,++pS1,++pS2,++pD)
-                *pD = *pS2-*pS1;
+            NICE::SimdKernels::sub(pS2,pS1,pD,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23348,8 +23347,7 @@ inline IppStatus ippiSubC_C1IR(Ipp32f value, Ipp32f* pSrc, int srcStep, IppiSize
         for(int y=0; y<roiSize.height; ++y)
         {
             pS = pSrc + y*sStep;
-            for(int x=0; x<roiSize.width; ++x,++pS)
-                *pS -= value;
+            NICE::SimdKernels::subC(pS,value,pS,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23369,8 +23367,7 @@ inline IppStatus ippiSubC_C1R(const Ipp32f* pSrc, int srcStep, Ipp32f value,
         {
             pS = pSrc + y*sStep;
             pD = pDst + y*dStep;
-            for(int x=0; x<roiSize.width; ++x,++pS,++pD)
-                *pD = *pS - value;
+            NICE::SimdKernels::subC(pS,value,pD,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23390,8 +23387,7 @@ inline IppStatus ippiAdd_C1IR(const Ipp32f* pSrc, int srcStep,
         {
             pS = pSrc + y*sStep;
             pD = pDst + y*dStep;
-            for(int x=0; x<roiSize.width; ++x,++pS,++pD)
-                *pD += *pS;
+            NICE::SimdKernels::add(pD,pS,pD,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23414,8 +23410,7 @@ inline IppStatus ippiAdd_C1R(const Ipp32f* pSrc1, int src1Step,
             pS1 = pSrc1 + y*s1Step;
             pS2 = pSrc2 + y*s2Step;
             pD  = pDst  + y*dStep;
-            for(int x=0; x<roiSize.width; ++x,++pS1,++pS2,++pD)
-                *pD = *pS1+*pS2;
+            NICE::SimdKernels::add(pS1,pS2,pD,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23431,8 +23426,7 @@ inline IppStatus ippiAddC_C1IR(Ipp32f value, Ipp32f* pSrc, int srcStep, IppiSize
         for(int y=0; y<roiSize.height; ++y)
         {
             pS = pSrc + y*sStep;
-            for(int x=0; x<roiSize.width; ++x,++pS)
-                *pS += value;
+            NICE::SimdKernels::addC(pS,value,pS,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23452,8 +23446,7 @@ inline IppStatus ippiAddC_C1R(const Ipp32f* pSrc, int srcStep, Ipp32f value,
         {
             pS = pSrc + y*sStep;
             pD = pDst + y*dStep;
-            for(int x=0; x<roiSize.width; ++x,++pS,++pD)
-                *pD = *pS + value;
+            NICE::SimdKernels::addC(pS,value,pD,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23473,8 +23466,7 @@ inline IppStatus ippiMul_C1IR(const Ipp32f* pSrc, int srcStep,
         {
             pS = pSrc + y*sStep;
             pD = pDst + y*dStep;
-            for(int x=0; x<roiSize.width; ++x,++pS,++pD)
-                *pD *= *pS;
+            NICE::SimdKernels::mul(pD,pS,pD,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23496,8 +23488,7 @@ inline IppStatus ippiMul_C1R(const Ipp32f* pSrc1, int src1Step,
             pS1 = pSrc1 + y*s1Step;
             pS2 = pSrc2 + y*s2Step;
             pD  = pDst  + y*dStep;
-            for(int x=0; x<roiSize.width; ++x,++pS1,++pS2,++pD)
-                *pD = *pS1 * *pS2;
+            NICE::SimdKernels::mul(pS1,pS2,pD,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23513,8 +23504,7 @@ inline IppStatus ippiMulC_C1IR(Ipp32f value, Ipp32f* pSrc, int srcStep, IppiSize
         for(int y=0; y<roiSize.height; ++y)
         {
             pS = pSrc + y*sStep;
-            for(int x=0; x<roiSize.width; ++x,++pS)
-                *pS *= value;
+            NICE::SimdKernels::mulC(pS,value,pS,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23553,8 +23543,7 @@ inline IppStatus ippiMulC_C1R(const Ipp32f* pSrc, int srcStep, Ipp32f value,
         {
             pS = pSrc + y*sStep;
             pD = pDst + y*dStep;
-            for(int x=0; x<roiSize.width; ++x,++pS,++pD)
-                *pD = *pS * value;
+            NICE::SimdKernels::mulC(pS,value,pD,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23597,8 +23586,7 @@ inline IppStatus ippiDiv_C1IR(const Ipp32f* pSrc, int srcStep,
         {
             pS = pSrc + y*sStep;
             pD = pDst + y*dStep;
-            for(int x=0; x<roiSize.width; ++x,++pS,++pD)
-                *pD /= *pS;
+            NICE::SimdKernels::div(pD,pS,pD,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23621,8 +23609,7 @@ inline IppStatus ippiDiv_C1R(const Ipp32f* pSrc1, int src1Step,
             pS1 = pSrc1 + y*s1Step;
             pS2 = pSrc2 + y*s2Step;
             pD  = pDst + y*dStep;
-            for(int x=0; x<roiSize.width; ++x,++pS1,++pS2,++pD)
-                *pD = *pS2 / *pS1;
+            NICE::SimdKernels::div(pS2,pS1,pD,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23638,8 +23625,7 @@ inline IppStatus ippiDivC_C1IR(Ipp32f value, Ipp32f* pSrc, int srcStep, IppiSize
         for(int y=0; y<roiSize.height; ++y)
         {
             pS = pSrc + y*sStep;
-            for(int x=0; x<roiSize.width; ++x,++pS)
-                *pS /= value;
+            NICE::SimdKernels::divC(pS,value,pS,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23659,8 +23645,7 @@ inline IppStatus ippiDivC_C1R(const Ipp32f* pSrc, int srcStep, Ipp32f value,
         {
             pS = pSrc + y*sStep;
             pD = pDst + y*dStep;
-            for(int x=0; x<roiSize.width; ++x,++pS,++pD)
-                *pD = *pS / value;
+            NICE::SimdKernels::divC(pS,value,pD,roiSize.width);
         }
         return ippStsNoErr;
     #endif
@@ -23687,3 +23672,27 @@ inline IppStatus ippiAddC_C1IRSfs(Ipp16s value, Ipp16s* pSrc, int srcStep,
         return ippStsNoErr;
     #endif
 }
+
+#ifndef NICE_USELIB_IPP
+// conversions between Ipp8u and Ipp32f on the kernels of SimdKernels, the
+// generic templates of the other types return ippStsDataTypeErr
+
+inline IppStatus ippiConvert_C1R(const Ipp8u* pSrc, int srcStep, Ipp32f* pDst, int dstStep,
+                                 IppiSize roiSize)
+{
+    for(int y=0; y<roiSize.height; ++y)
+        NICE::SimdKernels::convert(pSrc + y*srcStep,
+                                   reinterpret_cast<Ipp32f*>(reinterpret_cast<Ipp8u*>(pDst) + y*dstStep),
+                                   roiSize.width);
+    return ippStsNoErr;
+}
+
+inline IppStatus ippiConvert_C1R(const Ipp32f* pSrc, int srcStep, Ipp8u* pDst, int dstStep,
+                                 IppiSize roiSize, IppRoundMode roundMode)
+{
+    for(int y=0; y<roiSize.height; ++y)
+        NICE::SimdKernels::convert(reinterpret_cast<const Ipp32f*>(reinterpret_cast<const Ipp8u*>(pSrc) + y*srcStep),
+                                   pDst + y*dstStep, roiSize.width, roundMode == ippRndNear);
+    return ippStsNoErr;
+}
+#endif // NICE_USELIB_IPP
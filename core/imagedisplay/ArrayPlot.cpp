@@ -11,6 +11,7 @@
 //
 
 #include "core/basics/Exception.h"
+#include "core/basics/Log.h"
 #include "ArrayPlot.h"
 #include <iostream>
 #include <core/basics/numerictools.h>
@@ -39,7 +40,7 @@ ArrayPlot::ArrayPlot ( std::vector<double> probs,
     m_invertColors ( invertColors )
 {
   if ( ( m_width * m_height ) != m_probs.size() )
-    std::cerr << "MProbDisplay: INCONSISTENT SIZES!" << std::endl;
+    NICE_LOG_ERROR ( "MProbDisplay: INCONSISTENT SIZES!" );
 
   for ( unsigned int i = 0 ; i < m_probs.size(); ++i ) {
     if ( m_probs[i] > m_maxProb )
@@ -9,6 +9,7 @@
 #endif
 
 #include "core/imagedisplay/ImageDisplaySDL.h"
+#include "core/basics/Log.h"
 
 using namespace std;
 
@@ -46,7 +47,7 @@ void ImageDisplaySDL::resizeEvent(QResizeEvent *) {
   sprintf(variable, "SDL_WINDOWID=0x%lx", winId());
   putenv(variable);
   if (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0) {
-    cerr << "Unable to init SDL: " << SDL_GetError() << endl;
+    NICE_LOG_ERROR ( "Unable to init SDL: " << SDL_GetError() );
     return;
   }
 
@@ -58,7 +59,7 @@ void ImageDisplaySDL::resizeEvent(QResizeEvent *) {
   int bitDepth = 0;
   if (videoInfo == NULL) {
     // FIXME throw an exception
-    cerr << "Video query failed: " << SDL_GetError() << endl;
+    NICE_LOG_ERROR ( "Video query failed: " << SDL_GetError() );
   } else {
     videoFlags = SDL_GL_DOUBLEBUFFER;
 
@@ -90,13 +91,13 @@ void ImageDisplaySDL::resizeEvent(QResizeEvent *) {
     // This checks if hardware blits can be done
     if (videoInfo->blit_hw) {
       videoFlags |= SDL_HWACCEL;
-      cerr << "SDL: blit_hw" << endl;
+      NICE_LOG_DEBUG ( "SDL: blit_hw" );
     }
 
     // This checks to see if surfaces can be stored in memory
     if (videoInfo->hw_available) {
       videoFlags |= SDL_HWSURFACE;
-      cerr << "SDL: hw_available" << endl;
+      NICE_LOG_DEBUG ( "SDL: hw_available" );
     } else {
       videoFlags |= SDL_SWSURFACE;
     }
@@ -107,13 +108,13 @@ void ImageDisplaySDL::resizeEvent(QResizeEvent *) {
   screen = SDL_SetVideoMode(width(), height(),
                             bitDepth, videoFlags);
   if (screen == NULL) {
-    cerr << "Unable to set video mode: " << SDL_GetError() << endl;
+    NICE_LOG_ERROR ( "Unable to set video mode: " << SDL_GetError() );
     return;
   } else {
     sdlDisplayActive = true;
   }
   if (!SDL_WM_ToggleFullScreen(screen)) {
-    cerr << "SDL: SDL_WM_ToggleFullScreen(screen) failed." << endl;
+    NICE_LOG_WARNING ( "SDL: SDL_WM_ToggleFullScreen(screen) failed." );
   }
 }
 
@@ -177,6 +178,7 @@ void ImageDisplaySDL::setImage(image::ColorImage* _image,
 #else // NICE_USELIB_SDL
 
 #include "core/imagedisplay/ImageDisplaySDL.h"
+#include "core/basics/Log.h"
 namespace NICE {
 bool ImageDisplaySDL::sdlDisplayActive = false;
 ImageDisplaySDL::ImageDisplaySDL(QWidget */*parent*/, const char */*name*/) {}
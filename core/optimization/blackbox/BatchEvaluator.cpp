@@ -0,0 +1,94 @@
+/**
+* @file BatchEvaluator.cpp
+* @brief evaluation of an Optimizable for a set of parameter vectors, optionally in parallel
+* @date 10/19/2026
+
+*/
+#include <exception>
+#include <string>
+
+#ifdef NICE_USELIB_OPENMP
+#include <omp.h>
+#endif
+
+#include "core/basics/Exception.h"
+#include "core/optimization/blackbox/BatchEvaluator.h"
+
+using namespace OPTIMIZATION;
+
+void BatchEvaluator::evaluate(Optimizable &function, const matrix_type &parameterSet,
+                              matrix_type &result, int numThreads)
+{
+  const int n = parameterSet.cols();
+  const size_t rows = parameterSet.rows();
+  result.resize(n, 1);
+
+  // the columns are contiguous, evaluate() gets views on them
+  double *data = const_cast<double *>(parameterSet.getDataPointer());
+
+#ifdef NICE_USELIB_OPENMP
+  if (numThreads <= 0)
+    numThreads = omp_get_max_threads();
+#else
+  numThreads = 1;
+#endif
+  if (numThreads < 1 || n < 2)
+    numThreads = 1;
+
+  // serial evaluation: exceptions of the function propagate unchanged
+  if (numThreads == 1)
+  {
+    for (int i = 0; i < n; i++)
+    {
+      const matrix_type column(data + i * rows, rows, 1, NICE::MatrixBase::external);
+      result(i, 0) = function.evaluate(column);
+    }
+    return;
+  }
+
+  // exceptions must not leave the parallel region, the first one is rethrown
+  // as NICE::Exception after all threads have finished
+  volatile bool failed = false;
+  int failedColumn = -1;
+  std::string message;
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(numThreads)
+  for (int i = 0; i < n; i++)
+  {
+    if (failed)
+      continue;
+
+    const matrix_type column(data + i * rows, rows, 1, NICE::MatrixBase::external);
+    try {
+      result(i, 0) = function.evaluate(column);
+    } catch (std::exception &e) {
+#pragma omp critical (BatchEvaluatorError)
+      if (!failed || i < failedColumn)
+      {
+        failed = true;
+        failedColumn = i;
+        message = e.what();
+      }
+    } catch (...) {
+#pragma omp critical (BatchEvaluatorError)
+      if (!failed || i < failedColumn)
+      {
+        failed = true;
+        failedColumn = i;
+        message = "unknown exception";
+      }
+    }
+  }
+
+  if (failed)
+    fthrow(NICE::Exception, "BatchEvaluator: evaluation of column " << failedColumn
+           << " failed: " << message);
+}
+
+matrix_type BatchEvaluator::evaluate(Optimizable &function, const matrix_type &parameterSet,
+                                     int numThreads)
+{
+  matrix_type result;
+  evaluate(function, parameterSet, result, numThreads);
+  return result;
+}
@@ -0,0 +1,56 @@
+/**
+* @file BatchEvaluator.h
+* @brief evaluation of an Optimizable for a set of parameter vectors, optionally in parallel
+* @date 10/19/2026
+
+*/
+#ifndef _BATCH_EVALUATOR_H_
+#define _BATCH_EVALUATOR_H_
+
+#include "core/optimization/blackbox/Optimizable.h"
+#include "core/optimization/blackbox/Definitions_core_opt.h"
+
+namespace OPTIMIZATION {
+
+  /*!
+      class BatchEvaluator
+
+      Evaluates an Optimizable for every column of a parameter set.
+      The columns are passed to evaluate() as views on the parameter set
+      (no copies). With OpenMP, the columns are distributed dynamically
+      over the threads of the OpenMP pool, one column at a time, since a
+      single evaluation is usually expensive.
+
+      If an evaluation throws in the serial case, the exception propagates
+      unchanged. In parallel, the remaining columns are skipped and a
+      NICE::Exception with the column and the message of the first error
+      is thrown after all threads have finished.
+  */
+  class BatchEvaluator
+  {
+    public:
+
+      /*!
+        evaluate all columns of parameterSet
+        \param function function to evaluate, evaluate() has to be thread-safe if numThreads != 1
+        \param parameterSet [x_1, x_2, ..., x_n]
+        \param result is resized to (n X 1) and gets [f(x_1), ..., f(x_n)]
+        \param numThreads 1: serial evaluation, 0: all OpenMP threads
+      */
+      static void evaluate(Optimizable &function,
+                           const OPTIMIZATION::matrix_type &parameterSet,
+                           OPTIMIZATION::matrix_type &result,
+                           int numThreads = 0);
+
+      /*!
+        evaluate all columns of parameterSet
+        \return [f(x_1), ..., f(x_n)] as (n X 1) matrix
+      */
+      static OPTIMIZATION::matrix_type evaluate(Optimizable &function,
+                                                const OPTIMIZATION::matrix_type &parameterSet,
+                                                int numThreads = 0);
+  };
+
+} // namespace
+
+#endif
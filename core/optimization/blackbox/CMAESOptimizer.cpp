@@ -0,0 +1,508 @@
+/**
+*
+* @file CMAESOptimizer.cpp: implementation of the CMA-ES optimizer
+*
+* @date 10/19/2026
+*
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "core/optimization/blackbox/CMAESOptimizer.h"
+#include "core/optimization/blackbox/Definitions_core_opt.h"
+#include "core/basics/Exception.h"
+#include "core/basics/Profiler.h"
+#include "core/basics/numerictools.h"
+#include "core/basics/Timer.h"
+#include "core/vector/Eigen.h"
+
+using namespace OPTIMIZATION;
+
+namespace {
+
+  //! orders indices by the values of a vector
+  class FitnessOrder
+  {
+    public:
+      FitnessOrder(const std::vector<double> &fitness) : m_fitness(fitness) {}
+      bool operator()(unsigned int a, unsigned int b) const { return m_fitness[a] < m_fitness[b]; }
+    private:
+      const std::vector<double> &m_fitness;
+  };
+
+}
+
+CMAESOptimizer::CMAESOptimizer(OptLogBase *loger): SuperClass(loger)
+{
+  m_initialLambda = 0;
+  m_initialSigma = 0.3;
+  m_maxRestarts = 0;
+  m_populationFactor = 2.0;
+  m_fixedSeed = false;
+  m_seed = 0;
+  m_randomState = 1;
+  m_lambda = 0;
+  m_mu = 0;
+  m_numEvaluations = 0;
+  m_numRestarts = 0;
+}
+
+CMAESOptimizer::CMAESOptimizer(const CMAESOptimizer &opt) : SuperClass(opt)
+{
+  m_initialLambda = opt.m_initialLambda;
+  m_initialSigma = opt.m_initialSigma;
+  m_maxRestarts = opt.m_maxRestarts;
+  m_populationFactor = opt.m_populationFactor;
+  m_fixedSeed = opt.m_fixedSeed;
+  m_seed = opt.m_seed;
+  m_randomState = 1;
+  m_lambda = 0;
+  m_mu = 0;
+  m_numEvaluations = 0;
+  m_numRestarts = 0;
+}
+
+CMAESOptimizer::~CMAESOptimizer()
+{
+}
+
+SimpleOptimizer *CMAESOptimizer::clone() const
+{
+  return new CMAESOptimizer(*this);
+}
+
+void CMAESOptimizer::setPopulationSize(unsigned int lambda)
+{
+  if (lambda == 1)
+    fthrow(NICE::Exception, "CMAESOptimizer: the population size has to be at least 2");
+  m_initialLambda = lambda;
+}
+
+void CMAESOptimizer::setInitialSigma(double sigma)
+{
+  if (!(sigma > 0.0))
+    fthrow(NICE::Exception, "CMAESOptimizer: the initial sigma has to be positive");
+  m_initialSigma = sigma;
+}
+
+void CMAESOptimizer::setRestarts(unsigned int maxRestarts, double populationFactor)
+{
+  if (populationFactor < 1.0)
+    fthrow(NICE::Exception, "CMAESOptimizer: the population factor has to be at least 1");
+  m_maxRestarts = maxRestarts;
+  m_populationFactor = populationFactor;
+}
+
+void CMAESOptimizer::setRandomSeed(bool fixedSeed, unsigned int seed)
+{
+  m_fixedSeed = fixedSeed;
+  m_seed = seed;
+}
+
+void CMAESOptimizer::init()
+{
+  SuperClass::init();
+
+  const unsigned int n = m_numberOfParameters;
+  if (m_scales.rows() != n)
+    m_scales = matrix_type(n, 1, 1.0);
+  for (unsigned int i = 0; i < n; i++)
+    if (m_scales(i,0) == 0.0)
+      fthrow(NICE::Exception, "CMAESOptimizer: the scales have to be nonzero");
+
+  m_startParameters = m_parameters;
+  m_numEvaluations = 0;
+  m_numRestarts = 0;
+}
+
+void CMAESOptimizer::setStrategyParameters(unsigned int lambda)
+{
+  const double n = m_numberOfParameters;
+
+  m_lambda = lambda;
+  m_mu = lambda / 2;
+
+  // positive recombination weights, log-linearly decreasing
+  m_weights.resize(m_mu);
+  double sum = 0.0;
+  for (unsigned int i = 0; i < m_mu; i++)
+  {
+    m_weights[i] = log(0.5 * (lambda + 1)) - log((double)(i + 1));
+    sum += m_weights[i];
+  }
+  double sumSquares = 0.0;
+  for (unsigned int i = 0; i < m_mu; i++)
+  {
+    m_weights[i] /= sum;
+    sumSquares += m_weights[i] * m_weights[i];
+  }
+  m_mueff = 1.0 / sumSquares;
+
+  // learning rates of the default strategy
+  m_cc = (4.0 + m_mueff / n) / (n + 4.0 + 2.0 * m_mueff / n);
+  m_cs = (m_mueff + 2.0) / (n + m_mueff + 5.0);
+  m_c1 = 2.0 / ((n + 1.3) * (n + 1.3) + m_mueff);
+  m_cmu = std::min(1.0 - m_c1, 2.0 * (m_mueff - 2.0 + 1.0 / m_mueff) / ((n + 2.0) * (n + 2.0) + m_mueff));
+  m_damps = 1.0 + 2.0 * std::max(0.0, sqrt((m_mueff - 1.0) / (n + 1.0)) - 1.0) + m_cs;
+  m_chiN = sqrt(n) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+
+  // the eigen decomposition is O(n^3), C changes by (c1 + cmu) per generation
+  m_eigenInterval = std::max(1, (int)(1.0 / ((m_c1 + m_cmu) * n * 10.0)));
+}
+
+void CMAESOptimizer::startRun()
+{
+  const unsigned int n = m_numberOfParameters;
+
+  m_mean.resize(n);
+  for (unsigned int i = 0; i < n; i++)
+    m_mean[i] = m_startParameters(i,0);
+  m_sigma = m_initialSigma;
+
+  m_C = NICE::MatrixT<double>(n, n, 0.0);
+  m_B = NICE::MatrixT<double>(n, n, 0.0);
+  m_D.resize(n);
+  for (unsigned int i = 0; i < n; i++)
+  {
+    m_C(i,i) = m_scales(i,0) * m_scales(i,0);
+    m_B(i,i) = 1.0;
+    m_D[i] = fabs(m_scales(i,0));
+  }
+  m_pc = NICE::VectorT<double>(n, 0.0);
+  m_ps = NICE::VectorT<double>(n, 0.0);
+
+  m_generation = 0;
+  m_lastEigenUpdate = 0;
+  m_history.clear();
+}
+
+bool CMAESOptimizer::updateEigenSystem()
+{
+  const unsigned int n = m_numberOfParameters;
+
+  // enforce symmetry
+  for (unsigned int j = 0; j < n; j++)
+    for (unsigned int i = j + 1; i < n; i++)
+      m_C(j,i) = m_C(i,j);
+
+  NICE::VectorT<double> eigenvalues;
+  NICE::eigenvectorvalues(m_C, m_B, eigenvalues);
+  m_lastEigenUpdate = m_generation;
+
+  // eigenvalues are sorted in decreasing order
+  const double largest = eigenvalues[0];
+  const double smallest = eigenvalues[n - 1];
+  if (!(smallest > 0.0) || !NICE::isFinite(largest) || largest > 1e14 * smallest)
+    return false;
+
+  for (unsigned int i = 0; i < n; i++)
+    m_D[i] = sqrt(eigenvalues[i]);
+  return true;
+}
+
+void CMAESOptimizer::repair(const matrix_type &x, matrix_type &xRepaired, std::vector<double> &distance) const
+{
+  xRepaired = x;
+  distance.assign(x.cols(), 0.0);
+  if (!m_lowerParameterBoundActive && !m_upperParameterBoundActive)
+    return;
+
+  for (unsigned int k = 0; k < x.cols(); k++)
+    for (unsigned int i = 0; i < x.rows(); i++)
+    {
+      double &v = xRepaired(i,k);
+      if (m_lowerParameterBoundActive && v < m_lowerParameterBound(i,0))
+        v = m_lowerParameterBound(i,0);
+      if (m_upperParameterBoundActive && v > m_upperParameterBound(i,0))
+        v = m_upperParameterBound(i,0);
+      const double d = x(i,k) - v;
+      distance[k] += d * d;
+    }
+}
+
+double CMAESOptimizer::randomUniform()
+{
+  m_randomState ^= m_randomState >> 12;
+  m_randomState ^= m_randomState << 25;
+  m_randomState ^= m_randomState >> 27;
+  // upper 53 bits of the scrambled state
+  return ((m_randomState * 2685821657736338717ull) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double CMAESOptimizer::randomGauss()
+{
+  // polar method as NICE::randGaussDouble()
+  double r1, r2, d;
+  do {
+    r1 = 2.0 * randomUniform() - 1.0;
+    r2 = 2.0 * randomUniform() - 1.0;
+    d = r1 * r1 + r2 * r2;
+  } while (d >= 1.0 || d == 0.0);
+  return r1 * sqrt(-2.0 * log(d) / d);
+}
+
+CMAESOptimizer::RunStatus CMAESOptimizer::generation()
+{
+  const unsigned int n = m_numberOfParameters;
+  const unsigned int lambda = m_lambda;
+
+  // sample: x_k = m + sigma * B * D * z_k
+  matrix_type x(n, lambda);
+  NICE::VectorT<double> z(n);
+  for (unsigned int k = 0; k < lambda; k++)
+  {
+    for (unsigned int j = 0; j < n; j++)
+      z[j] = m_D[j] * randomGauss();
+    for (unsigned int i = 0; i < n; i++)
+    {
+      double sum = 0.0;
+      for (unsigned int j = 0; j < n; j++)
+        sum += m_B(i,j) * z[j];
+      x(i,k) = m_mean[i] + m_sigma * sum;
+    }
+  }
+
+  // evaluate the whole generation as one batch
+  matrix_type xRepaired;
+  std::vector<double> distance;
+  repair(x, xRepaired, distance);
+  const matrix_type values = evaluateSetCostFunction(xRepaired);
+  m_numEvaluations += lambda;
+
+  std::vector<double> fitness(lambda);
+  double fmin = std::numeric_limits<double>::infinity();
+  double fmax = -std::numeric_limits<double>::infinity();
+  unsigned int best = 0;
+  for (unsigned int k = 0; k < lambda; k++)
+  {
+    fitness[k] = values(k,0);
+    if (NICE::isNaN(fitness[k]))
+      fitness[k] = std::numeric_limits<double>::infinity();
+    if (fitness[k] < fitness[best])
+      best = k;
+    if (NICE::isFinite(fitness[k]))
+    {
+      fmin = std::min(fmin, fitness[k]);
+      fmax = std::max(fmax, fitness[k]);
+    }
+  }
+
+  if (fitness[best] < m_currentCostFunctionValue)
+  {
+    m_currentCostFunctionValue = fitness[best];
+    for (unsigned int i = 0; i < n; i++)
+      m_parameters(i,0) = xRepaired(i,best);
+  }
+
+  // penalty for points outside of the bounds, relative to the spread of the
+  // values and the size of the distribution
+  if (m_lowerParameterBoundActive || m_upperParameterBoundActive)
+  {
+    double meanVariance = 0.0;
+    for (unsigned int i = 0; i < n; i++)
+      meanVariance += m_C(i,i);
+    meanVariance *= m_sigma * m_sigma / n;
+    const double weight = (fmax > fmin ? fmax - fmin : 0.0) + 1e-12 * (1.0 + fabs(fmin));
+    for (unsigned int k = 0; k < lambda; k++)
+      if (distance[k] > 0.0)
+        fitness[k] += weight * distance[k] / meanVariance;
+  }
+
+  std::vector<unsigned int> order(lambda);
+  for (unsigned int k = 0; k < lambda; k++)
+    order[k] = k;
+  std::sort(order.begin(), order.end(), FitnessOrder(fitness));
+
+  // recombination
+  const NICE::VectorT<double> oldMean(m_mean);
+  m_mean.set(0.0);
+  for (unsigned int r = 0; r < m_mu; r++)
+    for (unsigned int i = 0; i < n; i++)
+      m_mean[i] += m_weights[r] * x(i, order[r]);
+
+  NICE::VectorT<double> yw(n);
+  for (unsigned int i = 0; i < n; i++)
+    yw[i] = (m_mean[i] - oldMean[i]) / m_sigma;
+
+  // evolution path of sigma with C^-1/2 * yw = B * D^-1 * B^T * yw
+  NICE::VectorT<double> t(n);
+  for (unsigned int j = 0; j < n; j++)
+  {
+    double sum = 0.0;
+    for (unsigned int i = 0; i < n; i++)
+      sum += m_B(i,j) * yw[i];
+    t[j] = sum / m_D[j];
+  }
+  const double cs = sqrt(m_cs * (2.0 - m_cs) * m_mueff);
+  for (unsigned int i = 0; i < n; i++)
+  {
+    double sum = 0.0;
+    for (unsigned int j = 0; j < n; j++)
+      sum += m_B(i,j) * t[j];
+    m_ps[i] = (1.0 - m_cs) * m_ps[i] + cs * sum;
+  }
+  const double psNorm = m_ps.normL2();
+
+  // evolution path of C, stalled if ps is large
+  m_generation++;
+  const bool hsig = psNorm / sqrt(1.0 - pow(1.0 - m_cs, 2.0 * m_generation)) / m_chiN
+                    < 1.4 + 2.0 / (n + 1.0);
+  const double cc = hsig ? sqrt(m_cc * (2.0 - m_cc) * m_mueff) : 0.0;
+  for (unsigned int i = 0; i < n; i++)
+    m_pc[i] = (1.0 - m_cc) * m_pc[i] + cc * yw[i];
+
+  // rank-one and rank-mu update
+  const double decay = 1.0 - m_c1 - m_cmu + (hsig ? 0.0 : m_c1 * m_cc * (2.0 - m_cc));
+  matrix_type y(n, m_mu);
+  for (unsigned int r = 0; r < m_mu; r++)
+    for (unsigned int i = 0; i < n; i++)
+      y(i,r) = (x(i, order[r]) - oldMean[i]) / m_sigma;
+  for (unsigned int j = 0; j < n; j++)
+    for (unsigned int i = j; i < n; i++)
+    {
+      double rankMu = 0.0;
+      for (unsigned int r = 0; r < m_mu; r++)
+        rankMu += m_weights[r] * y(i,r) * y(j,r);
+      m_C(i,j) = decay * m_C(i,j) + m_c1 * m_pc[i] * m_pc[j] + m_cmu * rankMu;
+    }
+
+  // cumulative step-size adaptation
+  m_sigma *= exp(std::min(1.0, (m_cs / m_damps) * (psNorm / m_chiN - 1.0)));
+
+  if (!NICE::isFinite(m_sigma) || !(m_sigma > 0.0))
+    return RUN_DEGENERATE;
+  if (m_generation - m_lastEigenUpdate >= m_eigenInterval)
+    if (!updateEigenSystem())
+      return RUN_DEGENERATE;
+
+  // stopping criteria of this run
+  const unsigned int historyLength = 10 + (unsigned int)ceil(30.0 * n / lambda);
+  m_history.push_back(fitness[order[0]]);
+  if (m_history.size() > historyLength)
+    m_history.erase(m_history.begin());
+
+  const double funcTol = m_funcTolActive ? m_funcTol : 1e-12;
+  if (m_history.size() == historyLength && fmax - fmin < funcTol)
+  {
+    const double hmin = *std::min_element(m_history.begin(), m_history.end());
+    const double hmax = *std::max_element(m_history.begin(), m_history.end());
+    if (hmax - hmin < funcTol)
+      return RUN_FUNCTOL;
+  }
+
+  const double paramTol = m_paramTolActive ? m_paramTol : 1e-11 * m_initialSigma;
+  bool small = true;
+  for (unsigned int i = 0; i < n && small; i++)
+    small = m_sigma * sqrt(m_C(i,i)) < paramTol && m_sigma * fabs(m_pc[i]) < paramTol;
+  if (small)
+    return RUN_PARAMTOL;
+
+  // no effect of a step of 0.1 standard deviations along a principal axis
+  const unsigned int axis = m_generation % n;
+  bool noEffect = true;
+  for (unsigned int i = 0; i < n && noEffect; i++)
+    noEffect = (m_mean[i] == m_mean[i] + 0.1 * m_sigma * m_D[axis] * m_B(i,axis));
+  if (noEffect)
+    return RUN_NOEFFECT;
+
+  return RUN_CONTINUE;
+}
+
+int CMAESOptimizer::optimize()
+{
+  NICE_PROFILE_ZONE ( "CMAESOptimizer::optimize" );
+
+  this->init();
+
+  if(m_loger)
+    m_loger->logTrace("Starting CMA-ES Optimization\n");
+
+  // splitmix64 of the seed, the state of xorshift has to be nonzero
+  unsigned long long state = m_fixedSeed ? m_seed : (unsigned long long)NICE::Timer::getMicroseconds();
+  state += 0x9E3779B97F4A7C15ull;
+  state = (state ^ (state >> 30)) * 0xBF58476D1CE4E5B9ull;
+  state = (state ^ (state >> 27)) * 0x94D049BB133111EBull;
+  m_randomState = (state ^ (state >> 31)) | 1ull;
+
+  //start time criteria
+  m_startTime = clock();
+
+  const unsigned int n = m_numberOfParameters;
+  unsigned int lambda = m_initialLambda;
+  if (lambda == 0)
+    lambda = 4 + (unsigned int)floor(3.0 * log((double)n));
+
+  // the start point is the best point so far
+  m_currentCostFunctionValue = evaluateCostFunction(m_parameters);
+  if (NICE::isNaN(m_currentCostFunctionValue))
+    m_currentCostFunctionValue = std::numeric_limits<double>::infinity();
+  m_numEvaluations = 1;
+
+  setStrategyParameters(lambda);
+  startRun();
+
+  for (;;)
+  {
+    const RunStatus status = generation();
+    m_numIter++;
+
+    if(m_loger)
+    {
+      m_loger->logTrace("CMA-ES generation %d (run %d, lambda %d): best %g, sigma %g\n",
+                        (int)m_numIter, (int)m_numRestarts, (int)m_lambda,
+                        m_maximize ? -m_currentCostFunctionValue : m_currentCostFunctionValue, m_sigma);
+      // log parameters if parameter logger is given (does nothing for other loggers!)
+      matrix_type fullparams = m_costFunction->getFullParamsFromSubParams(m_parameters);
+      m_loger->writeParamsToFile(fullparams);
+    }
+
+    //Check time criterion
+    if(m_maxSecondsActive)
+    {
+      m_currentTime = clock();
+      if(((float)(m_currentTime - m_startTime )/CLOCKS_PER_SEC) >= m_maxSeconds )
+      {
+        m_returnReason = SUCCESS_TIMELIMIT;
+        break;
+      }
+    }
+
+    //check max num iter criterion
+    if(m_maxNumIterActive && m_numIter >= m_maxNumIter)
+    {
+      m_returnReason = SUCCESS_MAXITER;
+      break;
+    }
+
+    if (status == RUN_CONTINUE)
+      continue;
+
+    // IPOP: restart with a larger population
+    if (m_numRestarts < m_maxRestarts)
+    {
+      m_numRestarts++;
+      lambda = std::max(lambda + 1, (unsigned int)ceil(lambda * m_populationFactor));
+      if(m_loger)
+        m_loger->logTrace("CMA-ES restart %d with lambda %d\n", (int)m_numRestarts, (int)lambda);
+      setStrategyParameters(lambda);
+      startRun();
+      continue;
+    }
+
+    if (status == RUN_FUNCTOL)
+      m_returnReason = SUCCESS_FUNCTOL;
+    else if (status == RUN_DEGENERATE)
+    {
+      if(m_loger)
+        m_loger->logError("CMA-ES: the covariance matrix is degenerated\n");
+      m_returnReason = ERROR_COMPUTATION_UNSTABLE;
+    }
+    else
+      m_returnReason = SUCCESS_PARAMTOL;
+    break;
+  }
+
+  return m_returnReason;
+}
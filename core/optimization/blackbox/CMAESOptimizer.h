@@ -0,0 +1,253 @@
+///
+///
+/// @file CMAESOptimizer.h: interface of the CMA-ES optimizer
+/// @brief covariance matrix adaptation evolution strategy with IPOP restarts
+/// @date 10/19/2026
+///
+///
+
+#ifndef _CMAES_OPTIMIZER_H_
+#define _CMAES_OPTIMIZER_H_
+
+#include <vector>
+
+#include "core/vector/VectorT.h"
+#include "core/vector/MatrixT.h"
+#include "core/optimization/blackbox/SimpleOptimizer.h"
+
+
+namespace OPTIMIZATION {
+
+  ///
+  /// @class CMAESOptimizer
+  ///
+  ///  Covariance matrix adaptation evolution strategy (Hansen and Ostermeier
+  ///  2001, "The CMA Evolution Strategy: A Tutorial", Hansen 2016) with
+  ///  weighted recombination, cumulative step-size adaptation and rank-one
+  ///  plus rank-mu update of the covariance matrix.
+  ///
+  ///  Every generation samples lambda points from N(m, sigma^2 C). All of
+  ///  them are evaluated as one batch with evaluateSet(), i.e., in parallel
+  ///  if the cost function is declared thread-safe
+  ///  (CostFunction::setThreadSafe()). Unlike DownhillSimplexOptimizer, the
+  ///  number of evaluations per iteration is large and independent.
+  ///
+  ///  The eigen decomposition C = B D^2 B^T, needed for sampling, is
+  ///  computed with NICE::eigenvectorvalues() every few generations only
+  ///  (lazy update, O(n^2) amortized per evaluation).
+  ///
+  ///  HowToUse:
+  ///
+  ///  * set the start point, the scales (initial standard deviation per
+  ///    parameter, multiplied by the initial sigma) and optional bounds
+  ///    in a SimpleOptProblem
+  ///  * use setPopulationSize() to change the default 4 + 3 ln(n)
+  ///  * use setRestarts() for IPOP restarts: the run is restarted from the
+  ///    start point with a larger population when it stagnates
+  ///  * call optimizeProb()
+  ///
+  ///  Bounds: sampled points outside of the bounds are projected onto the
+  ///  box before the evaluation. The selection uses the value at the
+  ///  projected point plus a penalty growing with the squared distance of
+  ///  the projection, the distribution is updated with the unprojected
+  ///  points. The result is always within the (closed) box.
+  ///
+  ///  Implemented Abort criteria:
+  ///
+  ///  * maximum number of iterations, i.e., generations of all runs
+  ///  * time limit exceeded
+  ///  * function value tolerance: range of the values of the recent
+  ///    generations is below funcTol (default: 1e-6)
+  ///  * parameter tolerance: standard deviation of the distribution in
+  ///    all coordinates is below paramTol
+  ///
+  ///  The function and parameter tolerance end a single run even if they
+  ///  are not activated (with the tolerances 1e-12 and 1e-11 * sigma
+  ///  instead), a restart follows if restarts are left. Runs are also
+  ///  restarted if adding a step of 0.1 standard deviations does not change
+  ///  the mean.
+  ///
+  ///  Additional return reason:
+  ///     - ERROR_COMPUTATION_UNSTABLE if the covariance matrix degenerates
+  ///       (condition number > 1e14) in the last run
+  ///
+  class CMAESOptimizer : public SimpleOptimizer
+  {
+    public:
+
+      typedef SimpleOptimizer SuperClass;
+      typedef SuperClass::matrix_type matrix_type;
+
+      ///
+      /// Constructor
+      /// @param loger : OptLogBase * to existing log class or NULL
+      ///
+      CMAESOptimizer(OptLogBase *loger=NULL);
+
+      ///
+      /// CopyConstructor
+      /// @param opt : CMAESOptimizer to copy
+      ///
+      CMAESOptimizer(const CMAESOptimizer &opt);
+
+      ///
+      ///
+      ///
+      ~CMAESOptimizer();
+
+      ///
+      /// population size (lambda) of the first run
+      /// @param lambda number of points per generation, 0: 4 + floor(3 ln(n)) (default)
+      ///
+      void setPopulationSize(unsigned int lambda);
+
+      ///
+      /// initial step size, the initial standard deviation of parameter i is sigma * scale_i
+      /// @param sigma (default: 0.3)
+      ///
+      void setInitialSigma(double sigma);
+
+      ///
+      /// IPOP restarts
+      /// @param maxRestarts maximum number of restarts (default: 0)
+      /// @param populationFactor factor of the population size per restart (default: 2)
+      ///
+      void setRestarts(unsigned int maxRestarts, double populationFactor = 2.0);
+
+      ///
+      /// seed of the random number generator, the generator is seeded at the
+      /// start of each optimization; every optimizer has its own generator
+      /// (not the global one of initRand()), such that copies can run concurrently
+      /// @param fixedSeed false: seeded with the time (default)
+      ///
+      virtual void setRandomSeed(bool fixedSeed, unsigned int seed = 0);
+
+      ///
+      /// do internal initializations
+      ///
+      void init();
+
+      ///
+      /// copy with all settings
+      ///
+      virtual SimpleOptimizer *clone() const;
+
+      ///
+      /// number of evaluations of the cost function of the last optimization
+      ///
+      inline unsigned int getNumberOfEvaluations() const {return m_numEvaluations;};
+
+      ///
+      /// number of restarts of the last optimization
+      ///
+      inline unsigned int getNumberOfRestarts() const {return m_numRestarts;};
+
+      ///
+      /// population size of the last run
+      ///
+      inline unsigned int getPopulationSize() const {return m_lambda;};
+
+    protected:
+
+      ///
+      /// do the optimization
+      ///
+      virtual int optimize();
+
+    private:
+
+      /// reason for the end of a single run
+      enum RunStatus
+      {
+        RUN_CONTINUE,
+        RUN_FUNCTOL,
+        RUN_PARAMTOL,
+        RUN_NOEFFECT,
+        RUN_DEGENERATE
+      };
+
+      ///
+      /// set the strategy parameters for the population size lambda
+      ///
+      void setStrategyParameters(unsigned int lambda);
+
+      ///
+      /// start a run at the start point
+      ///
+      void startRun();
+
+      ///
+      /// one generation: sample, evaluate, update
+      /// @return status of the run
+      ///
+      RunStatus generation();
+
+      ///
+      /// eigen decomposition of m_C into m_B and m_D
+      /// @return false if C is degenerated
+      ///
+      bool updateEigenSystem();
+
+      ///
+      /// projection of the columns of x onto the bounds
+      ///
+      void repair(const matrix_type &x, matrix_type &xRepaired, std::vector<double> &distance) const;
+
+      ///
+      /// uniform random number in [0,1) of the generator of this optimizer
+      ///
+      double randomUniform();
+
+      ///
+      /// standard normal random number of the generator of this optimizer
+      ///
+      double randomGauss();
+
+      /// settings
+      unsigned int m_initialLambda;
+      double m_initialSigma;
+      unsigned int m_maxRestarts;
+      double m_populationFactor;
+      bool m_fixedSeed;
+      unsigned int m_seed;
+
+      /// strategy parameters of the current run
+      unsigned int m_lambda;
+      unsigned int m_mu;
+      std::vector<double> m_weights;
+      double m_mueff;
+      double m_cc;
+      double m_cs;
+      double m_c1;
+      double m_cmu;
+      double m_damps;
+      double m_chiN;
+      unsigned int m_eigenInterval;
+
+      /// state of the current run
+      NICE::VectorT<double> m_mean;
+      double m_sigma;
+      NICE::MatrixT<double> m_C;
+      NICE::MatrixT<double> m_B;
+      NICE::VectorT<double> m_D;
+      NICE::VectorT<double> m_pc;
+      NICE::VectorT<double> m_ps;
+      unsigned int m_generation;
+      unsigned int m_lastEigenUpdate;
+      /// best values of the recent generations
+      std::vector<double> m_history;
+
+      /// start point of all runs
+      matrix_type m_startParameters;
+
+      /// state of the random number generator (xorshift64*)
+      unsigned long long m_randomState;
+
+      /// statistics
+      unsigned int m_numEvaluations;
+      unsigned int m_numRestarts;
+  };
+
+} // namespace
+
+#endif
@@ -0,0 +1,457 @@
+/**
+* @file CachedCostFunction.cpp
+* @brief memoizing wrapper around an expensive CostFunction
+* @date 10/19/2026
+
+*/
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#ifdef WIN32
+#ifdef NICE_USELIB_OPENMP
+#include <omp.h>
+#endif
+#else
+#include <pthread.h>
+#endif
+
+#include "core/basics/Exception.h"
+#include "core/optimization/blackbox/CachedCostFunction.h"
+
+using namespace OPTIMIZATION;
+
+namespace {
+
+const char *fileHeader = "# NICE CachedCostFunction";
+
+} // namespace
+
+CachedCostFunction::CachedCostFunction(CostFunction *orig, double tolerance, unsigned int capacity)
+  : SuperClass(orig != NULL ? orig->getNumOfParameters() : 0),
+    m_pOrigCostFunc(orig), m_tolerance(tolerance), m_capacity(capacity), m_hits(0), m_mutex(NULL)
+{
+  if (orig == NULL)
+    fthrow(NICE::Exception, "CachedCostFunction: no cost function");
+  if (tolerance < 0.0)
+    fthrow(NICE::Exception, "CachedCostFunction: the tolerance has to be non-negative");
+
+  m_hasAnalyticGradient = orig->hasAnalyticGradient();
+  m_hasAnalyticHessian = orig->hasAnalyticHessian();
+  setThreadSafe(orig->isThreadSafe(), orig->getNumThreads());
+
+#ifdef WIN32
+#ifdef NICE_USELIB_OPENMP
+  omp_lock_t *mutex = new omp_lock_t;
+  omp_init_lock(mutex);
+  m_mutex = mutex;
+#endif
+#else
+  pthread_mutex_t *mutex = new pthread_mutex_t;
+  pthread_mutex_init(mutex, NULL);
+  m_mutex = mutex;
+#endif
+}
+
+CachedCostFunction::~CachedCostFunction()
+{
+#ifdef WIN32
+#ifdef NICE_USELIB_OPENMP
+  omp_lock_t *mutex = (omp_lock_t *)m_mutex;
+  omp_destroy_lock(mutex);
+  delete mutex;
+#endif
+#else
+  pthread_mutex_t *mutex = (pthread_mutex_t *)m_mutex;
+  pthread_mutex_destroy(mutex);
+  delete mutex;
+#endif
+}
+
+void CachedCostFunction::lock() const
+{
+#ifdef WIN32
+#ifdef NICE_USELIB_OPENMP
+  omp_set_lock((omp_lock_t *)m_mutex);
+#endif
+#else
+  pthread_mutex_lock((pthread_mutex_t *)m_mutex);
+#endif
+}
+
+void CachedCostFunction::unlock() const
+{
+#ifdef WIN32
+#ifdef NICE_USELIB_OPENMP
+  omp_unset_lock((omp_lock_t *)m_mutex);
+#endif
+#else
+  pthread_mutex_unlock((pthread_mutex_t *)m_mutex);
+#endif
+}
+
+void CachedCostFunction::init()
+{
+  m_pOrigCostFunc->init();
+}
+
+void CachedCostFunction::quantize(const double *x, Key &key, unsigned long long &hash) const
+{
+  key.resize(m_numOfParameters);
+  // FNV-1a over the cells
+  hash = 14695981039346656037ULL;
+  for (unsigned int i = 0; i < m_numOfParameters; i++)
+  {
+    long long cell;
+    if (m_tolerance > 0.0)
+    {
+      cell = (long long)floor(x[i] / m_tolerance + 0.5);
+    }
+    else
+    {
+      // -0 and 0 are the same point
+      const double v = (x[i] == 0.0) ? 0.0 : x[i];
+      memcpy(&cell, &v, sizeof(cell));
+    }
+    key[i] = cell;
+
+    unsigned long long bits = (unsigned long long)cell;
+    for (int b = 0; b < 8; b++)
+    {
+      hash ^= (bits >> (8 * b)) & 0xff;
+      hash *= 1099511628211ULL;
+    }
+  }
+}
+
+bool CachedCostFunction::find(const Key &key, unsigned long long hash, double &value)
+{
+  std::pair<Index::iterator, Index::iterator> range = m_index.equal_range(hash);
+  for (Index::iterator i = range.first; i != range.second; i++)
+  {
+    if (i->second->key == key)
+    {
+      // most recently used
+      m_entries.splice(m_entries.begin(), m_entries, i->second);
+      value = i->second->value;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CachedCostFunction::add(const Key &key, unsigned long long hash, const double *x, double value)
+{
+  double cached;
+  if (m_capacity == 0 || find(key, hash, cached))
+    return false;
+
+  m_entries.push_front(Entry());
+  Entry &entry = m_entries.front();
+  entry.hash = hash;
+  entry.key = key;
+  entry.x.assign(x, x + m_numOfParameters);
+  entry.value = value;
+  m_index.insert(std::make_pair(hash, m_entries.begin()));
+  evict();
+  return true;
+}
+
+void CachedCostFunction::insert(const Key &key, unsigned long long hash, const double *x, double value)
+{
+  if (!add(key, hash, x, value) || !m_journal.is_open())
+    return;
+
+  m_journal << std::setprecision(17) << value;
+  for (unsigned int i = 0; i < m_numOfParameters; i++)
+    m_journal << " " << x[i];
+  // flushed, so an interruption loses at most the line being written
+  m_journal << std::endl;
+}
+
+void CachedCostFunction::evict()
+{
+  while (m_entries.size() > m_capacity)
+  {
+    EntryList::iterator last = m_entries.end();
+    last--;
+    std::pair<Index::iterator, Index::iterator> range = m_index.equal_range(last->hash);
+    for (Index::iterator i = range.first; i != range.second; i++)
+    {
+      if (i->second == last)
+      {
+        m_index.erase(i);
+        break;
+      }
+    }
+    m_entries.erase(last);
+  }
+}
+
+double CachedCostFunction::evaluate(const matrix_type &parameter)
+{
+  if (parameter.rows() != m_numOfParameters || parameter.cols() != 1)
+    fthrow(NICE::Exception, "CachedCostFunction: the parameters have to be a column vector of size "
+           << m_numOfParameters);
+
+  Key key;
+  unsigned long long hash;
+  quantize(parameter.getDataPointer(), key, hash);
+
+  double value;
+  lock();
+  bool hit = find(key, hash, value);
+  if (hit)
+    m_hits++;
+  unlock();
+  if (hit)
+    return value;
+
+  // evaluate without holding the lock, other threads may use the cache meanwhile
+  value = m_pOrigCostFunc->evaluate(parameter);
+
+  lock();
+  m_numEval++;
+  insert(key, hash, parameter.getDataPointer(), value);
+  unlock();
+  return value;
+}
+
+matrix_type CachedCostFunction::evaluateSet(const matrix_type &parameterSet)
+{
+  const unsigned int n = parameterSet.cols();
+  const unsigned int rows = parameterSet.rows();
+  if (rows != m_numOfParameters && n > 0)
+    fthrow(NICE::Exception, "CachedCostFunction: the parameters have to be column vectors of size "
+           << m_numOfParameters);
+
+  matrix_type result(n, 1);
+  std::vector<Key> keys(n);
+  std::vector<unsigned long long> hashes(n);
+  // column of the batch of missing values which gives the value of a column
+  std::vector<int> missing(n, -1);
+  std::vector<unsigned int> batchColumns;
+  std::map<Key, int> batchCells;
+
+  for (unsigned int j = 0; j < n; j++)
+    quantize(parameterSet.getDataPointer() + j * rows, keys[j], hashes[j]);
+
+  lock();
+  for (unsigned int j = 0; j < n; j++)
+  {
+    double value;
+    if (find(keys[j], hashes[j], value))
+    {
+      result(j,0) = value;
+      m_hits++;
+      continue;
+    }
+
+    // each cell is evaluated only once per batch
+    std::map<Key, int>::const_iterator cell = batchCells.find(keys[j]);
+    if (cell != batchCells.end())
+    {
+      missing[j] = cell->second;
+      m_hits++;
+    }
+    else
+    {
+      missing[j] = batchColumns.size();
+      batchCells[keys[j]] = missing[j];
+      batchColumns.push_back(j);
+    }
+  }
+  unlock();
+
+  if (batchColumns.empty())
+    return result;
+
+  matrix_type batch(rows, batchColumns.size());
+  for (unsigned int k = 0; k < batchColumns.size(); k++)
+    for (unsigned int i = 0; i < rows; i++)
+      batch(i,k) = parameterSet(i, batchColumns[k]);
+
+  const matrix_type values = m_pOrigCostFunc->evaluateSet(batch);
+
+  lock();
+  m_numEval += batchColumns.size();
+  for (unsigned int k = 0; k < batchColumns.size(); k++)
+  {
+    const unsigned int j = batchColumns[k];
+    insert(keys[j], hashes[j], parameterSet.getDataPointer() + j * rows, values(k,0));
+  }
+  unlock();
+
+  for (unsigned int j = 0; j < n; j++)
+    if (missing[j] >= 0)
+      result(j,0) = values(missing[j],0);
+
+  return result;
+}
+
+const matrix_type CachedCostFunction::getAnalyticGradient(const matrix_type &x)
+{
+  return m_pOrigCostFunc->getAnalyticGradient(x);
+}
+
+const matrix_type CachedCostFunction::getAnalyticHessian(const matrix_type &x)
+{
+  return m_pOrigCostFunc->getAnalyticHessian(x);
+}
+
+matrix_type CachedCostFunction::getFullParamsFromSubParams(const matrix_type &x)
+{
+  return m_pOrigCostFunc->getFullParamsFromSubParams(x);
+}
+
+void CachedCostFunction::setTolerance(double tolerance)
+{
+  if (tolerance < 0.0)
+    fthrow(NICE::Exception, "CachedCostFunction: the tolerance has to be non-negative");
+
+  lock();
+  m_tolerance = tolerance;
+  // hash the cached points again, from the least recently used to keep the order
+  EntryList entries;
+  entries.swap(m_entries);
+  m_index.clear();
+  for (EntryList::reverse_iterator e = entries.rbegin(); e != entries.rend(); e++)
+  {
+    Key key;
+    unsigned long long hash;
+    quantize(&e->x[0], key, hash);
+    double cached;
+    if (find(key, hash, cached))
+      continue;
+    m_entries.push_front(*e);
+    m_entries.front().key = key;
+    m_entries.front().hash = hash;
+    m_index.insert(std::make_pair(hash, m_entries.begin()));
+  }
+  unlock();
+}
+
+void CachedCostFunction::setCapacity(unsigned int capacity)
+{
+  lock();
+  m_capacity = capacity;
+  evict();
+  unlock();
+}
+
+unsigned int CachedCostFunction::size() const
+{
+  lock();
+  unsigned int result = m_entries.size();
+  unlock();
+  return result;
+}
+
+void CachedCostFunction::clear()
+{
+  lock();
+  m_entries.clear();
+  m_index.clear();
+  unlock();
+}
+
+void CachedCostFunction::resetStatistics()
+{
+  lock();
+  m_hits = 0;
+  m_numEval = 0;
+  unlock();
+}
+
+void CachedCostFunction::save(const std::string &filename) const
+{
+  std::ofstream file(filename.c_str());
+  if (!file.good())
+    fthrow(NICE::Exception, "CachedCostFunction: unable to write " << filename);
+
+  file << fileHeader << " " << m_numOfParameters << std::endl;
+  file << std::setprecision(17);
+  lock();
+  // least recently used first, so loading restores the order
+  for (EntryList::const_reverse_iterator e = m_entries.rbegin(); e != m_entries.rend(); e++)
+  {
+    file << e->value;
+    for (unsigned int i = 0; i < m_numOfParameters; i++)
+      file << " " << e->x[i];
+    file << std::endl;
+  }
+  unlock();
+
+  if (!file.good())
+    fthrow(NICE::Exception, "CachedCostFunction: unable to write " << filename);
+}
+
+unsigned int CachedCostFunction::load(const std::string &filename)
+{
+  std::ifstream file(filename.c_str());
+  if (!file.good())
+    fthrow(NICE::Exception, "CachedCostFunction: unable to read " << filename);
+
+  std::string line;
+  std::getline(file, line);
+  std::stringstream header;
+  header << fileHeader << " " << m_numOfParameters;
+  if (line != header.str())
+    fthrow(NICE::Exception, "CachedCostFunction: " << filename
+           << " is no cache of a cost function with " << m_numOfParameters << " parameters");
+
+  unsigned int count = 0;
+  std::vector<double> x(m_numOfParameters);
+  Key key;
+  unsigned long long hash;
+  // a value is only inserted if the line is complete, an interrupted write is skipped
+  while (std::getline(file, line))
+  {
+    std::istringstream values(line);
+    double value;
+    values >> value;
+    for (unsigned int i = 0; i < m_numOfParameters; i++)
+      values >> x[i];
+    if (values.fail())
+      continue;
+
+    quantize(&x[0], key, hash);
+    lock();
+    add(key, hash, &x[0], value);
+    unlock();
+    count++;
+  }
+  return count;
+}
+
+unsigned int CachedCostFunction::setJournal(const std::string &filename)
+{
+  lock();
+  if (m_journal.is_open())
+    m_journal.close();
+  unlock();
+
+  if (filename.empty())
+    return 0;
+
+  unsigned int count = 0;
+  bool exists;
+  {
+    std::ifstream test(filename.c_str());
+    exists = test.good();
+  }
+  if (exists)
+    count = load(filename);
+
+  lock();
+  m_journal.open(filename.c_str(), std::ios::out | std::ios::app);
+  if (m_journal.good() && !exists)
+    m_journal << fileHeader << " " << m_numOfParameters << std::endl;
+  const bool good = m_journal.good();
+  unlock();
+
+  if (!good)
+    fthrow(NICE::Exception, "CachedCostFunction: unable to write " << filename);
+  return count;
+}
@@ -0,0 +1,185 @@
+/**
+* @file CachedCostFunction.h
+* @brief memoizing wrapper around an expensive CostFunction
+* @date 10/19/2026
+
+*/
+#ifndef _CACHED_COST_FUNCTION_H_
+#define _CACHED_COST_FUNCTION_H_
+
+#include <fstream>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "core/optimization/blackbox/CostFunction.h"
+#include "core/optimization/blackbox/Definitions_core_opt.h"
+
+namespace OPTIMIZATION {
+
+  /*!
+      class CachedCostFunction
+
+      Opt-in cache of the values of an expensive cost function. Optimizers
+      often evaluate points again (simplex vertices after a shrink step,
+      brackets of line searches, restarts); with the wrapper, these points
+      are looked up instead of evaluated.
+
+      Parameters are quantized to a grid of width tolerance (tolerance 0:
+      exact bit patterns), and the cache is keyed by a hash of the grid
+      cell. A point gets the value of the first point evaluated in its cell.
+      At most capacity values are kept, the least recently used one is
+      dropped first.
+
+      The wrapper is thread-safe and has the thread-safety setting of the
+      original function. evaluateSet() looks up all columns first and
+      passes the missing ones (each distinct cell once) as one batch to the
+      original function.
+
+      With setJournal(), every new value is appended to a file, and the
+      values of an earlier run are loaded from it, so an interrupted
+      optimization can be resumed without evaluating the same points again.
+
+      getNumberOfEvaluations() counts the evaluations of the original
+      function, i.e., the misses.
+  */
+  class CachedCostFunction : public CostFunction
+  {
+    public:
+
+      typedef CostFunction SuperClass;
+
+      /*!
+        Constructor.
+        \param orig the original cost function (not deleted)
+        \param tolerance width of the grid of the parameters, 0: exact matches only
+        \param capacity maximum number of cached values
+      */
+      CachedCostFunction(CostFunction *orig, double tolerance = 0.0, unsigned int capacity = 100000);
+
+      /*!
+        Destructor.
+      */
+      virtual ~CachedCostFunction();
+
+      /*!
+        Initialization of the original cost function, the cache is kept
+      */
+      virtual void init();
+
+      virtual double evaluate(const OPTIMIZATION::matrix_type &parameter);
+
+      virtual OPTIMIZATION::matrix_type evaluateSet(const OPTIMIZATION::matrix_type &parameterSet);
+
+      virtual const OPTIMIZATION::matrix_type getAnalyticGradient(const OPTIMIZATION::matrix_type &x);
+
+      virtual const OPTIMIZATION::matrix_type getAnalyticHessian(const OPTIMIZATION::matrix_type &x);
+
+      virtual OPTIMIZATION::matrix_type getFullParamsFromSubParams(const OPTIMIZATION::matrix_type &x);
+
+      /*!
+        change the tolerance, the cached values are kept and hashed again
+      */
+      void setTolerance(double tolerance);
+
+      inline double getTolerance() const {return m_tolerance;};
+
+      /*!
+        change the capacity, the least recently used values are dropped if necessary
+      */
+      void setCapacity(unsigned int capacity);
+
+      inline unsigned int getCapacity() const {return m_capacity;};
+
+      /*!
+        number of cached values
+      */
+      unsigned int size() const;
+
+      /*!
+        remove all values (the journal file is not changed)
+      */
+      void clear();
+
+      //! number of values taken from the cache
+      inline unsigned int getNumberOfHits() const {return m_hits;};
+
+      //! number of values not in the cache (evaluations of the original function)
+      inline unsigned int getNumberOfMisses() const {return m_numEval;};
+
+      //! reset hits and misses
+      void resetStatistics();
+
+      /*!
+        write all cached values to a file (text, full precision)
+      */
+      void save(const std::string &filename) const;
+
+      /*!
+        add the values of a file written by save() or setJournal()
+        \return number of values read
+      */
+      unsigned int load(const std::string &filename);
+
+      /*!
+        load the values of an existing journal file and append every new
+        value to it, an empty filename closes the journal
+        \return number of values loaded
+      */
+      unsigned int setJournal(const std::string &filename);
+
+    private:
+
+      //! quantized parameters
+      typedef std::vector<long long> Key;
+
+      struct Entry
+      {
+        unsigned long long hash;
+        Key key;
+        //! the point which was evaluated
+        std::vector<double> x;
+        double value;
+      };
+
+      typedef std::list<Entry> EntryList;
+      typedef std::multimap<unsigned long long, EntryList::iterator> Index;
+
+      void quantize(const double *x, Key &key, unsigned long long &hash) const;
+
+      //! lookup with the lock held, moves a hit to the front
+      bool find(const Key &key, unsigned long long hash, double &value);
+
+      //! insert with the lock held (if not present), drops old values
+      bool add(const Key &key, unsigned long long hash, const double *x, double value);
+
+      //! add() and write the journal
+      void insert(const Key &key, unsigned long long hash, const double *x, double value);
+
+      void evict();
+
+      void lock() const;
+      void unlock() const;
+
+      CachedCostFunction(const CachedCostFunction &);
+      CachedCostFunction &operator=(const CachedCostFunction &);
+
+      CostFunction *m_pOrigCostFunc;
+      double m_tolerance;
+      unsigned int m_capacity;
+
+      //! most recently used first
+      EntryList m_entries;
+      Index m_index;
+
+      unsigned int m_hits;
+
+      std::ofstream m_journal;
+
+      void *m_mutex;
+  };
+
+} // namespace
+
+#endif
@@ -7,6 +7,7 @@
 //////////////////////////////////////////////////////////////////////
 
 #include "core/optimization/blackbox/CostFunction.h"
+#include "core/optimization/blackbox/BatchEvaluator.h"
 
 using namespace OPTIMIZATION;
 
@@ -15,6 +16,8 @@ CostFunction::CostFunction() : SuperClass()
   m_hasAnalyticGradient = false;
   m_hasAnalyticHessian = false;
   m_numEval = 0;
+  m_threadSafe = false;
+  m_numThreads = 0;
 
 }
 
@@ -23,6 +26,8 @@ CostFunction::CostFunction(unsigned int numOfParameters) : SuperClass(numOfParam
   m_hasAnalyticGradient = false;
   m_hasAnalyticHessian = false;
   m_numEval = 0;
+  m_threadSafe = false;
+  m_numThreads = 0;
 }
 
 
@@ -31,6 +36,8 @@ CostFunction::CostFunction(const CostFunction &func) : SuperClass(func)
   m_hasAnalyticGradient = func.m_hasAnalyticGradient;
   m_hasAnalyticHessian = func.m_hasAnalyticHessian;
   m_numEval = func.m_numEval;
+  m_threadSafe = func.m_threadSafe;
+  m_numThreads = func.m_numThreads;
 }
 
 CostFunction::~CostFunction()
@@ -57,6 +64,8 @@ CostFunction &CostFunction::operator=(const CostFunction &func)
     m_hasAnalyticGradient = func.m_hasAnalyticGradient;
     m_hasAnalyticHessian = func.m_hasAnalyticHessian;
     m_numEval = func.m_numEval;
+  m_threadSafe = func.m_threadSafe;
+  m_numThreads = func.m_numThreads;
   
   }
 
@@ -64,6 +73,11 @@ CostFunction &CostFunction::operator=(const CostFunction &func)
 }
 
 
+CostFunction *CostFunction::clone() const
+{
+  return NULL;
+}
+
 const matrix_type CostFunction::getAnalyticGradient(const matrix_type &x)
 {
   /*
@@ -78,6 +92,17 @@ void CostFunction::init()
 {
 }
 
+void CostFunction::setThreadSafe(bool threadSafe, int numThreads)
+{
+  m_threadSafe = threadSafe;
+  m_numThreads = numThreads;
+}
+
+matrix_type CostFunction::evaluateSet(const matrix_type &parameterSet)
+{
+  return BatchEvaluator::evaluate(*this, parameterSet, m_threadSafe ? m_numThreads : 1);
+}
+
 const matrix_type CostFunction::getAnalyticHessian(const matrix_type &x)
 {
   /*
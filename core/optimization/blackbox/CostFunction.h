@@ -78,11 +78,46 @@ namespace OPTIMIZATION {
       */
       inline void resetNumberOfEvaluations(){m_numEval = 0;};
 
+      /*!
+        declare evaluate() thread-safe (opt-in, default: false)
+
+        If set, evaluateSet() evaluates the columns in parallel, so
+        evaluate() must not modify members of the cost function
+        (including m_numEval) without synchronization.
+        \param threadSafe evaluate() may be called concurrently
+        \param numThreads number of threads, 0: all OpenMP threads
+      */
+      void setThreadSafe(bool threadSafe, int numThreads = 0);
+
+      /*!
+        is evaluate() thread-safe ?
+      */
+      inline bool isThreadSafe(){return m_threadSafe;};
+
+      /*!
+        number of threads of evaluateSet(), 0: all OpenMP threads
+      */
+      inline int getNumThreads(){return m_numThreads;};
+
+      /*!
+        Evaluation of a set of parameter vectors, in parallel if the cost
+        function is thread-safe
+        \param parameterSet [x_1, x_2, x_3, .... ,x_n]
+        \return [evaluate(x_1), .... evaluate(x_n)]
+      */
+      virtual OPTIMIZATION::matrix_type evaluateSet(const OPTIMIZATION::matrix_type &parameterSet);
+
       /*!
         Initialization for the cost function
       */
       virtual void init();
 
+      /*!
+        independent copy for concurrent optimizations (see MultiStartOptimizer)
+        \return new cost function (delete it), NULL if the cost function can not be copied (default)
+      */
+      virtual CostFunction *clone() const;
+
       /*!
         set an x0 for 1dim line search
       */
@@ -137,6 +172,16 @@ namespace OPTIMIZATION {
         number of evaluations
       */
       unsigned int m_numEval;
+
+      /*!
+        may evaluate() be called concurrently ?
+      */
+      bool m_threadSafe;
+
+      /*!
+        number of threads of evaluateSet(), 0: all OpenMP threads
+      */
+      int m_numThreads;
   };
   
 } // namespace  
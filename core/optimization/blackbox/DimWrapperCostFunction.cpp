@@ -8,6 +8,7 @@
 
 #include <iostream>
 #include "DimWrapperCostFunction.h"
+#include "core/basics/Log.h"
 
 using namespace OPTIMIZATION;
 
@@ -35,7 +36,7 @@ DimWrapperCostFunction::DimWrapperCostFunction(CostFunction *orig, const matrix_
 {
   if(orig == NULL)
   {
-    std::cerr << "DimWrapperCostFunction::DimWrapperCostFunction NULL pointer error" << std::endl;
+    NICE_LOG_ERROR ( "DimWrapperCostFunction::DimWrapperCostFunction NULL pointer error" );
     exit(1);
   }
   m_pOrigCostFunc = orig;
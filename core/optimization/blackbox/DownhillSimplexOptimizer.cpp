@@ -12,6 +12,8 @@
 
 #include "core/optimization/blackbox/DownhillSimplexOptimizer.h"
 #include "core/optimization/blackbox/Definitions_core_opt.h"
+#include "core/basics/Profiler.h"
+#include "core/basics/Log.h"
 
 using namespace OPTIMIZATION;
 
@@ -45,6 +47,11 @@ DownhillSimplexOptimizer::~DownhillSimplexOptimizer()
 {
 }
 
+SimpleOptimizer *DownhillSimplexOptimizer::clone() const
+{
+  return new DownhillSimplexOptimizer(*this);
+}
+
 bool DownhillSimplexOptimizer::setWholeSimplex(const matrix_type &simplex)
 {
   if((int)simplex.rows() == static_cast<int>(m_numberOfParameters) && (int)simplex.cols() == static_cast<int>(m_numberOfParameters + 1))
@@ -67,10 +74,8 @@ bool DownhillSimplexOptimizer::setWholeSimplex(const matrix_type &simplex)
     m_vertices = simplex;
     m_simplexInitialized = true;
     
-    for (int k = 0; k < static_cast<int>(m_numberOfParameters +1); k++)
-    {
-        m_y(k,0) = evaluateCostFunction(m_vertices(0,k,m_numberOfParameters-1,k));
-    }
+    // evaluate all vertices as one batch (in parallel for thread-safe cost functions)
+    m_y = evaluateSetCostFunction(m_vertices);
         
     return true;
   }
@@ -142,16 +147,14 @@ void DownhillSimplexOptimizer::init()
   else
   {
     //compute the function values of the initial simplex points
-    for (int k = 0; k < static_cast<int>(m_numberOfParameters +1); k++)
-    {
-      m_y(k,0) = evaluateCostFunction(m_vertices(0,k,m_numberOfParameters-1,k));
-    }
+    m_y = evaluateSetCostFunction(m_vertices);
   }
 }
 
 
 int DownhillSimplexOptimizer::optimize()
 {
+  NICE_PROFILE_ZONE ( "DownhillSimplexOptimizer::optimize" );
   //before optimizing, we initialize our simplex in all cases
   // if you are pretty sure, that you already have a suitable initial
   // simplex, you can skip this part
@@ -168,8 +171,8 @@ int DownhillSimplexOptimizer::optimize()
   int tmp=amoeba();
   m_parameters = m_vertices(0,tmp,m_numberOfParameters-1,tmp);
 
-  //final evaluation of the cost function with our optimal parameter settings
-  m_currentCostFunctionValue = evaluateCostFunction(m_parameters);
+  //the function value of the best vertex is known, no final evaluation needed
+  m_currentCostFunctionValue = m_y(tmp,0);
   return m_returnReason;
 }
 
@@ -186,12 +189,12 @@ int DownhillSimplexOptimizer::amoeba()
   const int ndim=m_numberOfParameters;
   if (m_verbose)
   {
-    std::cerr << "ndim: " << ndim << std::endl;
+    NICE_LOG_DEBUG ( "ndim: " << ndim );
   }  
 
   // number of vertices
   const int spts=ndim+1;
-  int i,j, max_val;
+  int i,j,k, max_val;
     
   // index of worst (lowest) vertex-point
   int ilo;
@@ -220,12 +223,7 @@ int DownhillSimplexOptimizer::amoeba()
     
   if (m_verbose)
   {
-    std::cerr << "initial psum: ";
-    for (j=0;j<ndim;j++)
-    { 
-      std::cerr << psum(0,j) << " " ;
-    }
-    std::cerr << std::endl;    
+    NICE_LOG_DEBUG ( "initial psum: " << psum.getRow ( 0 ) );
   }
   
   // loop until terminating
@@ -237,13 +235,8 @@ int DownhillSimplexOptimizer::amoeba()
     {
       for(int u = 0; u < ndim+1; u++)
       {
-        for(int v = 0; v < ndim ; v++)
-        {
-          std::cerr << m_vertices(v,u) << " ";
-        }
-        std::cerr<< " " << m_y(u,0) << std::endl;
+        NICE_LOG_DEBUG ( m_vertices.getColumn ( u ) << " " << m_y(u,0) );
       }
-      std::cerr << std::endl;
     }
 
 
@@ -333,7 +326,7 @@ int DownhillSimplexOptimizer::amoeba()
       rtol=2.0*fabs(m_y(ihi,0)-m_y(ilo,0))/(fabs(m_y(ihi,0))+fabs(m_y(ilo,0))+1e-10);
       
       #ifdef OPT_DEBUG        
-        std::cout<<"rtol"<<"  "<<rtol<< std::endl;
+        NICE_LOG_DEBUG ( "rtol  " << rtol );
       #endif    
       
       // if the found solution is satisfactory, than terminate
@@ -380,7 +373,7 @@ int DownhillSimplexOptimizer::amoeba()
     //informative output
     if (m_verbose)
     {    
-      std::cerr << "start new iteration with amotry -alpha, i.e., reflect worst point through simplex" << std::endl;
+      NICE_LOG_DEBUG ( "start new iteration with amotry -alpha, i.e., reflect worst point through simplex" );
     }
 
     // Begin a new iteration. 
@@ -397,7 +390,7 @@ int DownhillSimplexOptimizer::amoeba()
       //informative output
       if (m_verbose)
       {
-        std::cerr << "reflected point is better than best point, perform further extrapolation with gamma" << std::endl;
+        NICE_LOG_DEBUG ( "reflected point is better than best point, perform further extrapolation with gamma" );
       }
 
       // result is better than best
@@ -406,7 +399,7 @@ int DownhillSimplexOptimizer::amoeba()
       ytry=amotry(psum,ihi,m_gamma);
       
       #ifdef OPT_DEBUG        
-        std::cout<<"Case one .. reflected highest through simplex" << std::endl;
+        NICE_LOG_DEBUG ( "Case one .. reflected highest through simplex" );
       #endif
     }
     //new point is not better as anything else
@@ -418,7 +411,7 @@ int DownhillSimplexOptimizer::amoeba()
         //informative output
         if (m_verbose)
         {
-          std::cerr << "reflected point is worse then second worst, looking for intermediate point with beta" << std::endl;
+          NICE_LOG_DEBUG ( "reflected point is worse then second worst, looking for intermediate point with beta" );
         }
 
         // The reflected point is worse
@@ -428,19 +421,19 @@ int DownhillSimplexOptimizer::amoeba()
         // let's  look for an intermediate lower point.
         ytry=amotry(psum,ihi,m_beta);
         #ifdef OPT_DEBUG        
-          std::cout<<"Case two .. looking for intermediate point" << std::endl;
+          NICE_LOG_DEBUG ( "Case two .. looking for intermediate point" );
         #endif   
         //unfortunately, the intermediate point is still worse
         //then the original one
         if (ytry >= ysave)
         {
           #ifdef OPT_DEBUG        
-            std::cout<<"Case three .. contract around lowest point" << std::endl;
+            NICE_LOG_DEBUG ( "Case three .. contract around lowest point" );
           #endif 
           //informative output
           if (m_verbose)
           {
-            std::cerr <<  "Intermediate point is also worse, contract around current best point with factor 0.5." << std::endl;
+            NICE_LOG_DEBUG ( "Intermediate point is also worse, contract around current best point with factor 0.5." );
           }
           // Since we can't get rid 
           // of that bad point, we better 
@@ -448,44 +441,54 @@ int DownhillSimplexOptimizer::amoeba()
           // note: contraction is performed by a factor of 0.5
           // as suggested in Numerical Recipes
           
-          //contract all points
-          for (i=0;i<spts;i++) 
+          //contract all points but the best one and evaluate them as one batch
+          matrix_type contracted(ndim,spts-1);
+          bool valid = true;
+          for (i=0,k=0;i<spts;i++) 
           {
-            // but the best point has not to be contracted
-            if (i!=ilo) 
+            if (i==ilo) 
+              continue;
+            //contract in every dimension
+            for (j=0;j<ndim;j++) 
             {
-              //contract in every dimension
-              for (j=0;j<ndim;j++) 
-              {
-                psum(0,j)=0.5*(m_vertices(j,i)+m_vertices(j,ilo) ); 
-                #ifdef OPT_DEBUG                    
-                printf( "psum(%d)=%f\n",j,psum(0,j) );
-                #endif                  
-                m_vertices(j,i)=psum(0,j);
-              }
-              //TODO what does this?
-              if (checkParameters(!psum)) 
-              {
-                m_y(i,0)=  evaluateCostFunction(!psum); 
-                // count function evaluations
-                //not needed in the current implementation
-                //eval_count++; 
-              }
-              else
-              {    
-                m_returnReason = ERROR_XOUTOFBOUNDS; // out of domain !!!
-                break;
-              }
+              psum(0,j)=0.5*(m_vertices(j,i)+m_vertices(j,ilo) ); 
+              #ifdef OPT_DEBUG                    
+              NICE_LOG_DEBUG ( "psum(" << j << ")=" << psum(0,j) );
+              #endif                  
+              contracted(j,k)=psum(0,j);
             }
-            // update psum: get sum of vertex-coordinates
-            for (j=0;j<ndim;j++)
+            valid = valid && checkParameters(!psum);
+            k++;
+          }
+
+          if (valid)
+          {
+            matrix_type ycontracted = evaluateSetCostFunction(contracted);
+            for (i=0,k=0;i<spts;i++) 
             {
-              double sum=0.0;
-              for (int ii=0;ii<spts;ii++)
-                sum += m_vertices(j,ii);
-              psum(0,j)=sum;
-            }//for
-              }//for-loop for contracting all points
+              if (i==ilo) 
+                continue;
+              for (j=0;j<ndim;j++) 
+                m_vertices(j,i)=contracted(j,k);
+              m_y(i,0)=ycontracted(k,0);
+              k++;
+            }
+          }
+          else
+          {    
+            // out of domain, keep the simplex and stop
+            m_returnReason = ERROR_XOUTOFBOUNDS;
+            m_abort = true;
+          }
+
+          // update psum: get sum of vertex-coordinates
+          for (j=0;j<ndim;j++)
+          {
+            double sum=0.0;
+            for (int ii=0;ii<spts;ii++)
+              sum += m_vertices(j,ii);
+            psum(0,j)=sum;
+          }//for
         }//if (ytry >= ysave)
       }//if (ytry >= m_y(inhi))
     }//else
@@ -520,14 +523,9 @@ double DownhillSimplexOptimizer::amotry(matrix_type & psum, int ihi, double fac)
     //informative output
     if (m_verbose)
     {
-      std::cerr << "amotry fac: " <<  fac << std::endl;
-      std::cerr << "fac1: " << fac1 << " fac2: " << fac2 << std::endl;
-      std::cerr << "ptry: ";
-      for (int j=0;j<ndim;j++) 
-      {
-        std::cerr << ptry(0,j) << " ";
-      }
-      std::cerr << std::endl;
+      NICE_LOG_DEBUG ( "amotry fac: " <<  fac );
+      NICE_LOG_DEBUG ( "fac1: " << fac1 << " fac2: " << fac2 );
+      NICE_LOG_DEBUG ( "ptry: " << ptry.getRow ( 0 ) );
       
     }
     
@@ -41,6 +41,10 @@ namespace OPTIMIZATION {
   ///  Additional return reason:
   ///     - none
   ///
+  ///  The initial vertices and the contracted vertices of a shrink step are
+  ///  evaluated as one batch with evaluateSet(), i.e., in parallel if the
+  ///  cost function is declared thread-safe (CostFunction::setThreadSafe()).
+  ///
   class DownhillSimplexOptimizer : public SimpleOptimizer
   {
     public:
@@ -119,6 +123,11 @@ namespace OPTIMIZATION {
       ///
       void init();
 
+      ///
+      /// copy with all settings
+      ///
+      virtual SimpleOptimizer *clone() const;
+
     protected:
       ///
       /// start optimization
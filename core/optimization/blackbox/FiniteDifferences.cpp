@@ -0,0 +1,296 @@
+/**
+* @file FiniteDifferences.cpp
+* @brief numerical gradients and Hessians of a CostFunction
+* @date 10/19/2026
+
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "core/basics/Exception.h"
+#include "core/optimization/blackbox/FiniteDifferences.h"
+
+using namespace OPTIMIZATION;
+
+ComplexStepFunction::~ComplexStepFunction()
+{
+}
+
+FiniteDifferences::FiniteDifferences(CostFunction *costFunction, Method method)
+  : m_costFunction(costFunction), m_method(method),
+    m_noise(std::numeric_limits<double>::epsilon()), m_numEval(0)
+{
+  if (m_costFunction == NULL)
+    fthrow(NICE::Exception, "FiniteDifferences: no cost function");
+}
+
+FiniteDifferences::~FiniteDifferences()
+{
+}
+
+void FiniteDifferences::setMethod(Method method)
+{
+  m_method = method;
+}
+
+void FiniteDifferences::setFunctionNoise(double noise)
+{
+  if (noise <= 0.0)
+    fthrow(NICE::Exception, "FiniteDifferences: the noise has to be positive");
+  m_noise = std::max(noise, std::numeric_limits<double>::epsilon());
+}
+
+void FiniteDifferences::setTypicalScales(const matrix_type &scales)
+{
+  m_scales = scales;
+}
+
+double FiniteDifferences::step(const matrix_type &x, unsigned int i, double r) const
+{
+  double scale = 1.0;
+  if (m_scales.rows() > i)
+    scale = fabs(m_scales(i,0));
+  double h = r * std::max(fabs(x(i,0)), scale);
+
+  // x + h - x has to be exactly h
+  volatile double t = x(i,0) + h;
+  h = t - x(i,0);
+  return h;
+}
+
+matrix_type FiniteDifferences::evaluateSet(const matrix_type &points)
+{
+  m_numEval += points.cols();
+  return m_costFunction->evaluateSet(points);
+}
+
+void FiniteDifferences::centralGradient(const matrix_type &values, unsigned int offset,
+                                        const std::vector<double> &h, matrix_type &gradient) const
+{
+  for (unsigned int i = 0; i < h.size(); i++)
+    gradient(i,0) = (values(offset + 2*i, 0) - values(offset + 2*i + 1, 0)) / (2.0 * h[i]);
+}
+
+void FiniteDifferences::gradient(const matrix_type &x, matrix_type &gradient, const double *fx)
+{
+  const unsigned int n = m_costFunction->getNumOfParameters();
+  if (x.rows() != n || x.cols() != 1)
+    fthrow(NICE::Exception, "FiniteDifferences: x has to be a column vector of size " << n);
+  gradient.resize(n, 1);
+
+  if (m_method == COMPLEX_STEP)
+  {
+    complexStepGradient(x, gradient);
+    return;
+  }
+
+  std::vector<double> h(n);
+  if (m_method == FORWARD)
+  {
+    const double r = sqrt(m_noise);
+    const unsigned int offset = (fx == NULL) ? 1 : 0;
+    matrix_type points(n, n + offset);
+    for (unsigned int j = 0; j < n + offset; j++)
+      for (unsigned int k = 0; k < n; k++)
+        points(k,j) = x(k,0);
+    for (unsigned int i = 0; i < n; i++)
+    {
+      h[i] = step(x, i, r);
+      points(i, i + offset) += h[i];
+    }
+
+    matrix_type values = evaluateSet(points);
+    const double f0 = (fx == NULL) ? values(0,0) : *fx;
+    for (unsigned int i = 0; i < n; i++)
+      gradient(i,0) = (values(i + offset, 0) - f0) / h[i];
+  }
+  else
+  {
+    const double r = pow(m_noise, 1.0 / 3.0);
+    matrix_type points(n, 2 * n);
+    for (unsigned int j = 0; j < 2 * n; j++)
+      for (unsigned int k = 0; k < n; k++)
+        points(k,j) = x(k,0);
+    for (unsigned int i = 0; i < n; i++)
+    {
+      h[i] = step(x, i, r);
+      points(i, 2*i) += h[i];
+      points(i, 2*i + 1) -= h[i];
+    }
+
+    matrix_type values = evaluateSet(points);
+    centralGradient(values, 0, h, gradient);
+  }
+}
+
+matrix_type FiniteDifferences::gradient(const matrix_type &x)
+{
+  matrix_type result;
+  gradient(x, result);
+  return result;
+}
+
+void FiniteDifferences::complexStepGradient(const matrix_type &x, matrix_type &gradient)
+{
+  ComplexStepFunction *function = dynamic_cast<ComplexStepFunction *>(m_costFunction);
+  if (function == NULL)
+    fthrow(NICE::Exception, "FiniteDifferences: COMPLEX_STEP needs a cost function implementing ComplexStepFunction");
+
+  const int n = x.rows();
+  // no cancellation, so the step can be tiny
+  const double r = 1e-20;
+  std::vector<double> h(n);
+  for (int i = 0; i < n; i++)
+    h[i] = r * std::max(fabs(x(i,0)), m_scales.rows() > (unsigned int)i ? fabs(m_scales(i,0)) : 1.0);
+
+  const bool parallel = m_costFunction->isThreadSafe();
+#pragma omp parallel for schedule(dynamic,1) if(parallel)
+  for (int i = 0; i < n; i++)
+  {
+    std::vector< std::complex<double> > z(n);
+    for (int k = 0; k < n; k++)
+      z[k] = x(k,0);
+    z[i] += std::complex<double>(0.0, h[i]);
+    gradient(i,0) = function->evaluateComplex(z).imag() / h[i];
+  }
+  m_numEval += n;
+}
+
+void FiniteDifferences::hessianFromGradients(const matrix_type &x, matrix_type &hessian)
+{
+  const int n = x.rows();
+  const double r = pow(m_noise, 1.0 / 3.0);
+  hessian.resize(n, n);
+
+  std::vector<double> h(n);
+  for (int j = 0; j < n; j++)
+    h[j] = step(x, j, r);
+
+  const bool parallel = m_costFunction->isThreadSafe();
+#pragma omp parallel for schedule(dynamic,1) if(parallel)
+  for (int j = 0; j < n; j++)
+  {
+    matrix_type xj(x);
+    xj(j,0) = x(j,0) + h[j];
+    const matrix_type gPlus = m_costFunction->getAnalyticGradient(xj);
+    xj(j,0) = x(j,0) - h[j];
+    const matrix_type gMinus = m_costFunction->getAnalyticGradient(xj);
+    for (int i = 0; i < n; i++)
+      hessian(i,j) = (gPlus(i,0) - gMinus(i,0)) / (2.0 * h[j]);
+  }
+  m_numEval += 2 * n;
+
+  for (int j = 0; j < n; j++)
+    for (int i = j + 1; i < n; i++)
+    {
+      const double mean = 0.5 * (hessian(i,j) + hessian(j,i));
+      hessian(i,j) = mean;
+      hessian(j,i) = mean;
+    }
+}
+
+void FiniteDifferences::hessian(const matrix_type &x, matrix_type &hessian)
+{
+  matrix_type gradient;
+  gradientAndHessian(x, gradient, hessian);
+}
+
+void FiniteDifferences::gradientAndHessian(const matrix_type &x, matrix_type &gradient,
+                                           matrix_type &hessian)
+{
+  const unsigned int n = m_costFunction->getNumOfParameters();
+  if (x.rows() != n || x.cols() != 1)
+    fthrow(NICE::Exception, "FiniteDifferences: x has to be a column vector of size " << n);
+
+  if (m_costFunction->hasAnalyticGradient())
+  {
+    gradient = m_costFunction->getAnalyticGradient(x);
+    if (m_costFunction->hasAnalyticHessian())
+      hessian = m_costFunction->getAnalyticHessian(x);
+    else
+      hessianFromGradients(x, hessian);
+    return;
+  }
+
+  gradient.resize(n, 1);
+  hessian.resize(n, n);
+
+  // one batch: x, x +- hh_i e_i, x +- hh_i e_i +- hh_j e_j (i < j) and the
+  // points of the gradient with its own (smaller) steps
+  const double rh = pow(m_noise, 0.25);
+  std::vector<double> hh(n), hg(n);
+  for (unsigned int i = 0; i < n; i++)
+    hh[i] = step(x, i, rh);
+
+  const unsigned int numHessian = 1 + 2 * n + 2 * n * (n - 1);
+  unsigned int numGradient = 0;
+  if (m_method == FORWARD)
+    numGradient = n;
+  else if (m_method == CENTRAL)
+    numGradient = 2 * n;
+
+  matrix_type points(n, numHessian + numGradient);
+  for (unsigned int j = 0; j < points.cols(); j++)
+    for (unsigned int k = 0; k < n; k++)
+      points(k,j) = x(k,0);
+
+  unsigned int c = 1;
+  for (unsigned int i = 0; i < n; i++, c += 2)
+  {
+    points(i, c) += hh[i];
+    points(i, c + 1) -= hh[i];
+  }
+  for (unsigned int i = 0; i < n; i++)
+    for (unsigned int j = i + 1; j < n; j++, c += 4)
+    {
+      points(i, c) += hh[i];     points(j, c) += hh[j];
+      points(i, c + 1) += hh[i]; points(j, c + 1) -= hh[j];
+      points(i, c + 2) -= hh[i]; points(j, c + 2) += hh[j];
+      points(i, c + 3) -= hh[i]; points(j, c + 3) -= hh[j];
+    }
+
+  if (m_method == FORWARD)
+  {
+    const double r = sqrt(m_noise);
+    for (unsigned int i = 0; i < n; i++)
+    {
+      hg[i] = step(x, i, r);
+      points(i, numHessian + i) += hg[i];
+    }
+  }
+  else if (m_method == CENTRAL)
+  {
+    const double r = pow(m_noise, 1.0 / 3.0);
+    for (unsigned int i = 0; i < n; i++)
+    {
+      hg[i] = step(x, i, r);
+      points(i, numHessian + 2*i) += hg[i];
+      points(i, numHessian + 2*i + 1) -= hg[i];
+    }
+  }
+
+  matrix_type values = evaluateSet(points);
+
+  const double f0 = values(0,0);
+  c = 1;
+  for (unsigned int i = 0; i < n; i++, c += 2)
+    hessian(i,i) = (values(c,0) - 2.0 * f0 + values(c + 1,0)) / (hh[i] * hh[i]);
+  for (unsigned int i = 0; i < n; i++)
+    for (unsigned int j = i + 1; j < n; j++, c += 4)
+    {
+      hessian(i,j) = (values(c,0) - values(c + 1,0) - values(c + 2,0) + values(c + 3,0))
+                     / (4.0 * hh[i] * hh[j]);
+      hessian(j,i) = hessian(i,j);
+    }
+
+  if (m_method == FORWARD)
+  {
+    for (unsigned int i = 0; i < n; i++)
+      gradient(i,0) = (values(numHessian + i, 0) - f0) / hg[i];
+  }
+  else if (m_method == CENTRAL)
+    centralGradient(values, numHessian, hg, gradient);
+  else
+    complexStepGradient(x, gradient);
+}
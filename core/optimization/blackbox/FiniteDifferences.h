@@ -0,0 +1,163 @@
+/**
+* @file FiniteDifferences.h
+* @brief numerical gradients and Hessians of a CostFunction
+* @date 10/19/2026
+
+*/
+#ifndef _FINITE_DIFFERENCES_H_
+#define _FINITE_DIFFERENCES_H_
+
+#include <complex>
+#include <vector>
+
+#include "core/optimization/blackbox/CostFunction.h"
+#include "core/optimization/blackbox/Definitions_core_opt.h"
+
+namespace OPTIMIZATION {
+
+  /*!
+      class ComplexStepFunction
+
+      Optional interface of cost functions which can be evaluated for complex
+      parameters (the code of evaluate() written for a generic scalar type).
+      A cost function deriving from CostFunction and ComplexStepFunction can
+      be differentiated with FiniteDifferences::COMPLEX_STEP, which has no
+      cancellation error.
+  */
+  class ComplexStepFunction
+  {
+    public:
+      virtual ~ComplexStepFunction();
+
+      /*!
+        evaluate the cost function for complex parameters
+        \param x column vector with numOfParameters complex elements
+      */
+      virtual std::complex<double> evaluateComplex(const std::vector< std::complex<double> > &x) = 0;
+  };
+
+  /*!
+      class FiniteDifferences
+
+      Numerical derivatives of a CostFunction without analytic gradient.
+
+      All function values needed for a gradient or a Hessian are collected
+      in one parameter set and evaluated with CostFunction::evaluateSet(),
+      so thread-safe cost functions (CostFunction::setThreadSafe()) are
+      differentiated in parallel.
+
+      The step of parameter i is h_i = r * max(|x_i|, s_i) with the typical
+      scale s_i of the parameter (default 1) and a relative step r adapted
+      to the relative noise e of the cost function: sqrt(e) for forward,
+      e^(1/3) for central differences and e^(1/4) for Hessians from function
+      values. h_i is rounded such that x_i + h_i - x_i is exact.
+
+      Evaluations:
+      - gradient: FORWARD n (+1 if f(x) is unknown), CENTRAL 2n, COMPLEX_STEP n
+      - Hessian: 2n^2 + 1 from function values, or 2n gradients if the cost
+        function has an analytic gradient
+  */
+  class FiniteDifferences
+  {
+    public:
+
+      enum Method
+      {
+        //! (f(x + h e_i) - f(x)) / h, error O(h)
+        FORWARD,
+        //! (f(x + h e_i) - f(x - h e_i)) / 2h, error O(h^2)
+        CENTRAL,
+        //! Im(f(x + i h e_i)) / h, needs a ComplexStepFunction
+        COMPLEX_STEP
+      };
+
+      /*!
+        Constructor.
+        \param costFunction function to differentiate (not deleted)
+        \param method method of the gradient
+      */
+      FiniteDifferences(CostFunction *costFunction, Method method = CENTRAL);
+
+      /*!
+        Destructor.
+      */
+      ~FiniteDifferences();
+
+      void setMethod(Method method);
+
+      inline Method getMethod() const {return m_method;};
+
+      /*!
+        relative noise of the function values (default: machine epsilon),
+        the steps are adapted to it
+      */
+      void setFunctionNoise(double noise);
+
+      /*!
+        typical magnitudes of the parameters (numOfParameters X 1),
+        an empty matrix restores the default 1
+      */
+      void setTypicalScales(const OPTIMIZATION::matrix_type &scales);
+
+      /*!
+        the gradient at x
+        \param x column vector (numOfParameters X 1)
+        \param gradient output (numOfParameters X 1)
+        \param fx f(x) if known (saves one evaluation of FORWARD), or NULL
+      */
+      void gradient(const OPTIMIZATION::matrix_type &x, OPTIMIZATION::matrix_type &gradient,
+                    const double *fx = NULL);
+
+      /*!
+        the gradient at x
+      */
+      OPTIMIZATION::matrix_type gradient(const OPTIMIZATION::matrix_type &x);
+
+      /*!
+        the Hessian at x (symmetric)
+        \param x column vector (numOfParameters X 1)
+        \param hessian output (numOfParameters X numOfParameters)
+      */
+      void hessian(const OPTIMIZATION::matrix_type &x, OPTIMIZATION::matrix_type &hessian);
+
+      /*!
+        the gradient and the Hessian at x with a single batch of evaluations
+        \param x column vector (numOfParameters X 1)
+        \param gradient output (numOfParameters X 1), from the analytic gradient if available
+        \param hessian output (numOfParameters X numOfParameters)
+      */
+      void gradientAndHessian(const OPTIMIZATION::matrix_type &x, OPTIMIZATION::matrix_type &gradient,
+                              OPTIMIZATION::matrix_type &hessian);
+
+      /*!
+        number of function (or gradient) evaluations since construction
+      */
+      inline unsigned int getNumberOfEvaluations() const {return m_numEval;};
+
+    private:
+
+      //! step of parameter i at x for the relative step r
+      double step(const OPTIMIZATION::matrix_type &x, unsigned int i, double r) const;
+
+      //! central gradient from the evaluations of x +- h_i e_i in columns offset ... offset + 2n - 1
+      void centralGradient(const OPTIMIZATION::matrix_type &values, unsigned int offset,
+                           const std::vector<double> &h, OPTIMIZATION::matrix_type &gradient) const;
+
+      void complexStepGradient(const OPTIMIZATION::matrix_type &x, OPTIMIZATION::matrix_type &gradient);
+
+      //! Hessian from 2n analytic gradients
+      void hessianFromGradients(const OPTIMIZATION::matrix_type &x, OPTIMIZATION::matrix_type &hessian);
+
+      //! evaluate all columns and count the evaluations
+      OPTIMIZATION::matrix_type evaluateSet(const OPTIMIZATION::matrix_type &points);
+
+      CostFunction *m_costFunction;
+      Method m_method;
+      double m_noise;
+      OPTIMIZATION::matrix_type m_scales;
+      unsigned int m_numEval;
+  };
+
+} // namespace
+
+#endif
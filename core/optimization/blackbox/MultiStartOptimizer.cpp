@@ -0,0 +1,572 @@
+/**
+*
+* @file MultiStartOptimizer.cpp: implementation of the multi-start driver
+*
+* @date 10/19/2026
+*
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+
+#ifdef NICE_USELIB_OPENMP
+#include <omp.h>
+#endif
+
+#include "core/optimization/blackbox/MultiStartOptimizer.h"
+#include "core/basics/Exception.h"
+#include "core/basics/Profiler.h"
+#include "core/basics/Timer.h"
+#include "core/basics/numerictools.h"
+
+using namespace OPTIMIZATION;
+
+namespace {
+
+  //! thrown by RunCostFunction to end a cancelled run
+  class RunCancelled : public std::exception
+  {
+    public:
+      virtual const char *what() const throw() { return "run cancelled"; }
+  };
+
+#ifdef NICE_USELIB_OPENMP
+  //! serializes the evaluations of shared cost functions which are not thread-safe
+  struct EvaluationMutex
+  {
+    omp_lock_t lock;
+    EvaluationMutex() { omp_init_lock(&lock); }
+    ~EvaluationMutex() { omp_destroy_lock(&lock); }
+  } evaluationMutex;
+#endif
+
+  //! holds the evaluation mutex in a scope, an evaluation may throw and must
+  //! not leave a critical section (the lock would never be released)
+  class EvaluationLock
+  {
+    public:
+      EvaluationLock()
+      {
+#ifdef NICE_USELIB_OPENMP
+        omp_set_lock(&evaluationMutex.lock);
+#endif
+      }
+
+      ~EvaluationLock()
+      {
+#ifdef NICE_USELIB_OPENMP
+        omp_unset_lock(&evaluationMutex.lock);
+#endif
+      }
+  };
+
+  //! primitive polynomials and initial direction numbers (Joe and Kuo) of
+  //! the Sobol sequence for the dimensions 2, 3, ...
+  struct SobolPolynomial
+  {
+    unsigned int degree;
+    unsigned int coefficients;
+    unsigned int m[7];
+  };
+
+  const SobolPolynomial sobolPolynomials[] = {
+    {1,  0, {1}},
+    {2,  1, {1, 3}},
+    {3,  1, {1, 3, 1}},
+    {3,  2, {1, 1, 1}},
+    {4,  1, {1, 1, 3, 3}},
+    {4,  4, {1, 3, 5, 13}},
+    {5,  2, {1, 1, 5, 5, 17}},
+    {5,  4, {1, 1, 5, 5, 5}},
+    {5,  7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6,  1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}},
+    {6, 19, {1, 1, 1, 15, 7, 5}},
+    {6, 22, {1, 3, 1, 15, 13, 25}},
+    {6, 25, {1, 1, 5, 5, 19, 61}},
+    {7,  1, {1, 3, 7, 11, 23, 15, 103}},
+    {7,  4, {1, 3, 7, 13, 13, 15, 69}}
+  };
+
+  const unsigned int sobolBits = 32;
+
+  //! direction numbers v_1, ..., v_32 of a dimension, scaled by 2^32
+  void sobolDirections(unsigned int dimension, std::vector<unsigned int> &v)
+  {
+    v.resize(sobolBits);
+    if (dimension == 0)
+    {
+      for (unsigned int k = 0; k < sobolBits; k++)
+        v[k] = 1u << (sobolBits - 1 - k);
+      return;
+    }
+
+    const SobolPolynomial &p = sobolPolynomials[dimension - 1];
+    const unsigned int s = p.degree;
+    for (unsigned int k = 0; k < s && k < sobolBits; k++)
+      v[k] = p.m[k] << (sobolBits - 1 - k);
+    for (unsigned int k = s; k < sobolBits; k++)
+    {
+      v[k] = v[k - s] ^ (v[k - s] >> s);
+      for (unsigned int j = 1; j < s; j++)
+        if ((p.coefficients >> (s - 1 - j)) & 1)
+          v[k] ^= v[k - j];
+    }
+  }
+
+  //! uniform random number in (0,1)
+  double openUniform()
+  {
+    return ((double)rand() + 0.5) / ((double)RAND_MAX + 1.0);
+  }
+
+}
+
+///
+/// Cost function of a run: evaluates the (cloned or shared) cost function,
+/// keeps the best point and cancels the run if it is behind the incumbent.
+///
+class MultiStartOptimizer::RunCostFunction : public CostFunction
+{
+  public:
+
+    RunCostFunction(MultiStartOptimizer *driver, CostFunction *function, bool owned, bool maximize)
+      : CostFunction(function->getNumOfParameters()), m_driver(driver), m_function(function),
+        m_owned(owned), m_maximize(maximize), m_best(std::numeric_limits<double>::infinity()),
+        m_numEvaluations(0), m_checkpoint(0), m_cancelled(false)
+    {
+      m_nextCheckpoint = driver->m_cancelMinEvaluations;
+    }
+
+    virtual ~RunCostFunction()
+    {
+      if (m_owned)
+        delete m_function;
+    }
+
+    virtual void init()
+    {
+      // a shared cost function is initialized once by the driver
+      if (m_owned)
+        m_function->init();
+    }
+
+    virtual double evaluate(const matrix_type &parameter)
+    {
+      double value;
+      if (m_owned || m_function->isThreadSafe())
+        value = m_function->evaluate(parameter);
+      else
+      {
+        EvaluationLock lock;
+        value = m_function->evaluate(parameter);
+      }
+      record(parameter, 0, value);
+      check();
+      return value;
+    }
+
+    virtual matrix_type evaluateSet(const matrix_type &parameterSet)
+    {
+      matrix_type values;
+      if (m_owned || m_function->isThreadSafe())
+        values = m_function->evaluateSet(parameterSet);
+      else
+      {
+        EvaluationLock lock;
+        values = m_function->evaluateSet(parameterSet);
+      }
+      for (unsigned int k = 0; k < parameterSet.cols(); k++)
+        record(parameterSet, k, values(k,0));
+      check();
+      return values;
+    }
+
+    virtual matrix_type getFullParamsFromSubParams(const matrix_type &x)
+    {
+      return m_function->getFullParamsFromSubParams(x);
+    }
+
+    //! best point and value (sign of the cost function)
+    inline const matrix_type &getBestParameters() const {return m_bestParameters;};
+    inline double getBestValue() const {return m_maximize ? -m_best : m_best;};
+    inline unsigned int getEvaluations() const {return m_numEvaluations;};
+    inline bool isCancelled() const {return m_cancelled;};
+
+  private:
+
+    void record(const matrix_type &x, unsigned int column, double value)
+    {
+      m_numEvaluations++;
+      const double v = m_maximize ? -value : value;
+      if (v < m_best || m_bestParameters.rows() == 0)
+      {
+        m_best = v;
+        m_bestParameters = x(0, column, x.rows() - 1, column);
+      }
+    }
+
+    void check()
+    {
+      if (!m_driver->m_cancelActive)
+        return;
+      while (m_numEvaluations >= m_nextCheckpoint)
+      {
+        if (m_driver->checkIncumbent(m_checkpoint, m_best))
+        {
+          m_cancelled = true;
+          throw RunCancelled();
+        }
+        m_checkpoint++;
+        if (m_nextCheckpoint > std::numeric_limits<unsigned int>::max() / 2)
+          m_nextCheckpoint = std::numeric_limits<unsigned int>::max();
+        else
+          m_nextCheckpoint *= 2;
+      }
+    }
+
+    MultiStartOptimizer *m_driver;
+    CostFunction *m_function;
+    bool m_owned;
+    bool m_maximize;
+
+    //! best value (sign of minimization) and point
+    double m_best;
+    matrix_type m_bestParameters;
+
+    unsigned int m_numEvaluations;
+    unsigned int m_checkpoint;
+    unsigned int m_nextCheckpoint;
+    bool m_cancelled;
+};
+
+const unsigned int MultiStartOptimizer::maxSobolDimension;
+
+MultiStartOptimizer::MultiStartOptimizer(const SimpleOptimizer &optimizer, OptLogBase *loger)
+  : m_prototype(&optimizer), m_loger(loger)
+{
+  m_numStarts = 16;
+  m_sampling = LATIN_HYPERCUBE;
+  m_includeInitial = true;
+  m_cancelActive = false;
+  m_cancelMinEvaluations = 100;
+  m_cancelTolerance = 0.1;
+  m_numThreads = 0;
+  m_fixedSeed = false;
+  m_seed = 0;
+  m_bestRun = 0;
+}
+
+MultiStartOptimizer::~MultiStartOptimizer()
+{
+}
+
+void MultiStartOptimizer::setNumberOfStarts(unsigned int numStarts)
+{
+  if (numStarts == 0)
+    fthrow(NICE::Exception, "MultiStartOptimizer: at least one start is needed");
+  m_numStarts = numStarts;
+}
+
+void MultiStartOptimizer::setSampling(StartSampling sampling)
+{
+  m_sampling = sampling;
+}
+
+void MultiStartOptimizer::setIncludeInitialParameters(bool include)
+{
+  m_includeInitial = include;
+}
+
+void MultiStartOptimizer::setSearchRegion(const matrix_type &lower, const matrix_type &upper)
+{
+  if (lower.rows() != upper.rows() || lower.cols() != 1 || upper.cols() != 1)
+    fthrow(NICE::Exception, "MultiStartOptimizer: the search region needs two column vectors of the same size");
+  for (unsigned int i = 0; i < lower.rows(); i++)
+    if (!(lower(i,0) < upper(i,0)))
+      fthrow(NICE::Exception, "MultiStartOptimizer: empty search region in parameter " << i);
+  m_regionLower = lower;
+  m_regionUpper = upper;
+}
+
+void MultiStartOptimizer::resetSearchRegion()
+{
+  m_regionLower = matrix_type();
+  m_regionUpper = matrix_type();
+}
+
+void MultiStartOptimizer::setEarlyCancel(bool active, unsigned int minEvaluations, double tolerance)
+{
+  if (active && (minEvaluations == 0 || tolerance < 0.0))
+    fthrow(NICE::Exception, "MultiStartOptimizer: early cancellation needs minEvaluations > 0 and tolerance >= 0");
+  m_cancelActive = active;
+  m_cancelMinEvaluations = minEvaluations;
+  m_cancelTolerance = tolerance;
+}
+
+void MultiStartOptimizer::setNumThreads(int numThreads)
+{
+  m_numThreads = numThreads;
+}
+
+void MultiStartOptimizer::setRandomSeed(bool fixedSeed, unsigned int seed)
+{
+  m_fixedSeed = fixedSeed;
+  m_seed = seed;
+}
+
+void MultiStartOptimizer::sampleUnitCube(StartSampling sampling, unsigned int numPoints,
+                                         unsigned int dimension, matrix_type &points)
+{
+  points.resize(dimension, numPoints);
+
+  if (sampling == LATIN_HYPERCUBE)
+  {
+    // one point in each of the numPoints strata of every coordinate
+    std::vector<unsigned int> permutation(numPoints);
+    for (unsigned int i = 0; i < dimension; i++)
+    {
+      for (unsigned int k = 0; k < numPoints; k++)
+        permutation[k] = k;
+      for (unsigned int k = numPoints; k > 1; k--)
+        std::swap(permutation[k - 1], permutation[NICE::randInt(k)]);
+      for (unsigned int k = 0; k < numPoints; k++)
+        points(i,k) = (permutation[k] + openUniform()) / numPoints;
+    }
+    return;
+  }
+
+  if (dimension > maxSobolDimension)
+    fthrow(NICE::Exception, "MultiStartOptimizer: the Sobol sequence supports up to "
+           << maxSobolDimension << " dimensions, not " << dimension);
+
+  // Gray code construction, the origin (index 0) is skipped
+  const double scale = 1.0 / 4294967296.0;
+  std::vector<unsigned int> v;
+  for (unsigned int i = 0; i < dimension; i++)
+  {
+    sobolDirections(i, v);
+    unsigned int x = 0;
+    for (unsigned int k = 0; k < numPoints; k++)
+    {
+      // position of the lowest zero bit of the index k
+      unsigned int c = 0;
+      while ((k >> c) & 1)
+        c++;
+      x ^= v[c];
+      points(i,k) = x * scale;
+    }
+  }
+}
+
+void MultiStartOptimizer::sampleStarts(SimpleOptProblem &optProb, std::vector<matrix_type> &starts) const
+{
+  const matrix_type x0 = optProb.getActiveCurrentParams();
+  const matrix_type scales = optProb.getActiveScales();
+  const unsigned int n = x0.rows();
+
+  matrix_type lower(n, 1), upper(n, 1);
+  const bool lowerActive = optProb.lowerBoundsActive();
+  const bool upperActive = optProb.upperBoundsActive();
+  const matrix_type lowerBounds = optProb.getActiveLowerBounds();
+  const matrix_type upperBounds = optProb.getActiveUpperBounds();
+  // unset bounds are +-DBL_MAX
+  const double unbounded = 0.5 * std::numeric_limits<double>::max();
+
+  for (unsigned int i = 0; i < n; i++)
+  {
+    const double lb = lowerActive ? lowerBounds(i,0) : -std::numeric_limits<double>::infinity();
+    const double ub = upperActive ? upperBounds(i,0) : std::numeric_limits<double>::infinity();
+    if (m_regionLower.rows() > 0)
+    {
+      if (m_regionLower.rows() != n)
+        fthrow(NICE::Exception, "MultiStartOptimizer: the search region has " << m_regionLower.rows()
+               << " parameters, the problem " << n);
+      lower(i,0) = std::max(lb, m_regionLower(i,0));
+      upper(i,0) = std::min(ub, m_regionUpper(i,0));
+    }
+    else if (fabs(lb) < unbounded && fabs(ub) < unbounded)
+    {
+      lower(i,0) = lb;
+      upper(i,0) = ub;
+    }
+    else
+    {
+      const double s = fabs(scales(i,0));
+      lower(i,0) = std::max(lb, x0(i,0) - s);
+      upper(i,0) = std::min(ub, x0(i,0) + s);
+    }
+    if (!(lower(i,0) < upper(i,0)))
+      fthrow(NICE::Exception, "MultiStartOptimizer: empty search region in parameter " << i);
+  }
+
+  starts.clear();
+  if (m_includeInitial)
+    starts.push_back(x0);
+
+  const unsigned int numSampled = m_numStarts - starts.size();
+  matrix_type u;
+  sampleUnitCube(m_sampling, numSampled, n, u);
+  for (unsigned int k = 0; k < numSampled; k++)
+  {
+    matrix_type x(n, 1);
+    for (unsigned int i = 0; i < n; i++)
+      x(i,0) = lower(i,0) + u(i,k) * (upper(i,0) - lower(i,0));
+    starts.push_back(x);
+  }
+}
+
+bool MultiStartOptimizer::checkIncumbent(unsigned int checkpoint, double value)
+{
+  bool cancel = false;
+#pragma omp critical (MultiStartOptimizerIncumbent)
+  {
+    if (checkpoint < m_incumbent.size())
+    {
+      const double incumbent = m_incumbent[checkpoint];
+      if (value > incumbent + m_cancelTolerance * std::max(1.0, fabs(incumbent)))
+        cancel = true;
+      else
+        m_incumbent[checkpoint] = std::min(incumbent, value);
+    }
+    else
+    {
+      // checkpoints are reached in order, the previous one exists
+      m_incumbent.push_back(value);
+    }
+  }
+  return cancel;
+}
+
+int MultiStartOptimizer::optimizeProb(SimpleOptProblem &optProb)
+{
+  NICE_PROFILE_ZONE ( "MultiStartOptimizer::optimizeProb" );
+
+  SimpleOptimizer *test = m_prototype->clone();
+  if (test == NULL)
+    fthrow(NICE::Exception, "MultiStartOptimizer: the optimizer does not implement clone()");
+  delete test;
+
+  NICE::initRand(m_fixedSeed, m_seed);
+  // run r of a randomized optimizer is seeded with baseSeed + r, the global
+  // generator of initRand() is not used in the parallel region
+  const unsigned int baseSeed = m_fixedSeed ? m_seed : (unsigned int)NICE::Timer::getMicroseconds();
+
+  std::vector<matrix_type> starts;
+  sampleStarts(optProb, starts);
+
+  CostFunction *function = optProb.getOriginalCostFunction();
+  const bool maximize = optProb.getMaximize();
+
+  // the copy for the first run tells whether the cost function can be cloned
+  CostFunction *firstClone = function->clone();
+  const bool cloneable = (firstClone != NULL);
+  if (!cloneable)
+    function->init();
+
+  const int numRuns = starts.size();
+  m_runs.assign(numRuns, RunStatistics());
+  m_incumbent.clear();
+
+  int numThreads = m_numThreads;
+#ifdef NICE_USELIB_OPENMP
+  if (numThreads <= 0)
+    numThreads = omp_get_max_threads();
+#endif
+  if (numThreads < 1 || numRuns < 2)
+    numThreads = 1;
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(numThreads) if(numThreads > 1)
+  for (int r = 0; r < numRuns; r++)
+  {
+    RunStatistics &run = m_runs[r];
+    const double startTime = NICE::Timer::getNow();
+
+    CostFunction *runFunction = function;
+    if (cloneable)
+      runFunction = (r == 0) ? firstClone : function->clone();
+    RunCostFunction wrapper(this, runFunction, cloneable, maximize);
+    SimpleOptimizer *optimizer = m_prototype->clone();
+    optimizer->setLoger(NULL);
+    optimizer->setRandomSeed(true, baseSeed + r);
+
+    SimpleOptProblem runProblem(optProb);
+    runProblem.changeCostFunc(&wrapper);
+    runProblem.setActiveCurrentParameters(starts[r]);
+    run.startParameters = runProblem.getAllCurrentParams();
+
+    run.returnReason = -1;
+    run.numIterations = 0;
+    run.cancelled = false;
+    run.failed = false;
+    try {
+      run.returnReason = optimizer->optimizeProb(runProblem);
+      run.numIterations = optimizer->getNumIter();
+    } catch (RunCancelled &) {
+      run.cancelled = true;
+    } catch (std::exception &e) {
+      // the cancellation may arrive wrapped by a batch evaluation
+      run.cancelled = wrapper.isCancelled();
+      run.failed = !run.cancelled;
+      run.error = e.what();
+    } catch (...) {
+      run.cancelled = wrapper.isCancelled();
+      run.failed = !run.cancelled;
+      run.error = "unknown exception";
+    }
+    if (run.cancelled)
+      run.error.clear();
+    delete optimizer;
+
+    run.numEvaluations = wrapper.getEvaluations();
+    run.value = wrapper.getBestValue();
+    run.parameters = wrapper.getBestParameters();
+    run.seconds = NICE::Timer::getNow() - startTime;
+
+    if (m_loger)
+    {
+#pragma omp critical (MultiStartOptimizerLog)
+      m_loger->logTrace("multi-start run %d: value %g after %d evaluations (%s)\n", r, run.value,
+                        (int)run.numEvaluations, run.cancelled ? "cancelled" : (run.failed ? "failed" : "finished"));
+    }
+  }
+
+  // best run with at least one evaluation
+  int best = -1;
+  double bestValue = 0.0;
+  for (int r = 0; r < numRuns; r++)
+  {
+    const RunStatistics &run = m_runs[r];
+    if (run.numEvaluations == 0 || NICE::isNaN(run.value))
+      continue;
+    const double v = maximize ? -run.value : run.value;
+    if (best < 0 || v < bestValue)
+    {
+      best = r;
+      bestValue = v;
+    }
+  }
+
+  if (best < 0)
+  {
+    for (int r = 0; r < numRuns; r++)
+      if (m_runs[r].failed)
+        fthrow(NICE::Exception, "MultiStartOptimizer: all runs failed, run " << r << ": " << m_runs[r].error);
+    fthrow(NICE::Exception, "MultiStartOptimizer: no run evaluated the cost function");
+  }
+
+  m_bestRun = best;
+  matrix_type result = m_runs[best].parameters;
+  optProb.setAllCurrentParameters(result);
+
+  if (m_loger)
+    m_loger->logTrace("multi-start: best run %d of %d, value %g\n", best, numRuns, m_runs[best].value);
+
+  return m_runs[best].returnReason;
+}
@@ -0,0 +1,227 @@
+///
+///
+/// @file MultiStartOptimizer.h: interface of the multi-start driver
+/// @brief concurrent runs of a SimpleOptimizer from sampled start points
+/// @date 10/19/2026
+///
+///
+
+#ifndef _MULTI_START_OPTIMIZER_H_
+#define _MULTI_START_OPTIMIZER_H_
+
+#include <string>
+#include <vector>
+
+#include "core/optimization/blackbox/SimpleOptimizer.h"
+#include "core/optimization/blackbox/SimpleOptProblem.h"
+#include "core/optimization/blackbox/OptLogBase.h"
+
+
+namespace OPTIMIZATION {
+
+  ///
+  /// @class MultiStartOptimizer
+  ///
+  ///  Runs a SimpleOptimizer from many start points and returns the best
+  ///  result, for multimodal cost functions.
+  ///
+  ///  The start points are sampled in a box (Latin hypercube or Sobol
+  ///  sequence). The runs are distributed over the OpenMP threads, one run
+  ///  at a time. Every run uses its own copy of the optimizer
+  ///  (SimpleOptimizer::clone()) and of the cost function
+  ///  (CostFunction::clone()). Cost functions without clone() are shared by
+  ///  all runs: they are called concurrently if they are thread-safe
+  ///  (CostFunction::setThreadSafe()), otherwise one evaluation at a time.
+  ///
+  ///  Early cancellation: after minEvaluations, 2 minEvaluations,
+  ///  4 minEvaluations, ... evaluations, the best value of a run is
+  ///  compared with the incumbent, i.e., the best value any run had reached
+  ///  after the same number of evaluations. Runs which are worse by more
+  ///  than tolerance * max(1, |incumbent|) are cancelled. The runs share the
+  ///  incumbent while they are running, so cancellations depend on the
+  ///  timing of the threads.
+  ///
+  ///  The result of a run is the best point it evaluated, the best result
+  ///  of all runs is stored in the optimization problem. The result and
+  ///  the statistics of every run are available with getRunStatistics().
+  ///
+  ///  HowToUse:
+  ///
+  ///  * configure an optimizer (tolerances, iterations) as prototype
+  ///  * set the start point, scales and bounds in a SimpleOptProblem
+  ///  * call optimizeProb() of the MultiStartOptimizer
+  ///
+  class MultiStartOptimizer
+  {
+    public:
+
+      typedef OPTIMIZATION::matrix_type matrix_type;
+
+      /// sampling of the start points
+      enum StartSampling
+      {
+        LATIN_HYPERCUBE,
+        SOBOL
+      };
+
+      /// result and statistics of one run
+      struct RunStatistics
+      {
+        /// start point (all parameters)
+        matrix_type startParameters;
+        /// best point of the run (all parameters)
+        matrix_type parameters;
+        /// cost function value at parameters
+        double value;
+        /// return reason of the optimizer, -1 if the run was cancelled or failed
+        int returnReason;
+        /// iterations of the optimizer (0 for cancelled or failed runs)
+        unsigned int numIterations;
+        /// evaluations of the cost function
+        unsigned int numEvaluations;
+        /// wall clock time in seconds
+        double seconds;
+        /// cancelled by the incumbent
+        bool cancelled;
+        /// terminated by an exception
+        bool failed;
+        /// message of the exception
+        std::string error;
+      };
+
+      ///
+      /// Constructor
+      /// @param optimizer prototype, cloned for every run
+      /// @param loger : OptLogBase * to existing log class or NULL (a summary of every run is logged)
+      ///
+      MultiStartOptimizer(const SimpleOptimizer &optimizer, OptLogBase *loger=NULL);
+
+      ///
+      ///
+      ///
+      ~MultiStartOptimizer();
+
+      ///
+      /// number of runs (default: 16)
+      ///
+      void setNumberOfStarts(unsigned int numStarts);
+
+      ///
+      /// sampling of the start points (default: LATIN_HYPERCUBE)
+      /// (SOBOL supports up to maxSobolDimension active parameters)
+      ///
+      void setSampling(StartSampling sampling);
+
+      ///
+      /// use the current parameters of the problem as the first start point (default: true)
+      ///
+      void setIncludeInitialParameters(bool include);
+
+      ///
+      /// box of the start points (active parameters). Default: the bounds of
+      /// the problem, parameters without both bounds are sampled in
+      /// [x_0 - scale, x_0 + scale] (within the bounds)
+      ///
+      void setSearchRegion(const matrix_type &lower, const matrix_type &upper);
+
+      ///
+      /// use the default search region
+      ///
+      void resetSearchRegion();
+
+      ///
+      /// early cancellation of runs which are behind the incumbent
+      /// @param active default: false
+      /// @param minEvaluations evaluations of the first comparison (default: 100)
+      /// @param tolerance relative distance to the incumbent (default: 0.1)
+      ///
+      void setEarlyCancel(bool active, unsigned int minEvaluations = 100, double tolerance = 0.1);
+
+      ///
+      /// number of concurrent runs, 0: all OpenMP threads (default)
+      ///
+      void setNumThreads(int numThreads);
+
+      ///
+      /// seed of the random number generator of the start points (initRand())
+      /// and of the runs: the copy of the optimizer of run r gets the seed
+      /// seed + r (SimpleOptimizer::setRandomSeed()), such that randomized
+      /// optimizers are reproducible independent of the scheduling of the runs
+      /// @param fixedSeed false: seeded with the time (default)
+      ///
+      void setRandomSeed(bool fixedSeed, unsigned int seed = 0);
+
+      ///
+      /// run the optimizer from all start points
+      /// @param optProb the optimization problem, gets the best result
+      /// @return return reason of the optimizer of the best run
+      ///
+      int optimizeProb(SimpleOptProblem &optProb);
+
+      ///
+      /// results of the runs of the last optimization, in the order of the start points
+      ///
+      inline const std::vector<RunStatistics> &getRunStatistics() const {return m_runs;};
+
+      ///
+      /// index of the best run of the last optimization
+      ///
+      inline unsigned int getBestRun() const {return m_bestRun;};
+
+      /// maximum number of dimensions of the Sobol sequence
+      static const unsigned int maxSobolDimension = 21;
+
+      ///
+      /// sample points in the open unit cube (0,1)^dimension
+      /// @param sampling Latin hypercube (random) or Sobol sequence (deterministic, without the origin)
+      /// @param numPoints number of points
+      /// @param dimension number of coordinates
+      /// @param points (dimension X numPoints) matrix
+      ///
+      static void sampleUnitCube(StartSampling sampling, unsigned int numPoints,
+                                 unsigned int dimension, matrix_type &points);
+
+    private:
+
+      class RunCostFunction;
+      friend class RunCostFunction;
+
+      ///
+      /// compare the best value of a run at checkpoint with the incumbent
+      /// @return true if the run should be cancelled
+      ///
+      bool checkIncumbent(unsigned int checkpoint, double value);
+
+      ///
+      /// search region and start points of optProb
+      ///
+      void sampleStarts(SimpleOptProblem &optProb, std::vector<matrix_type> &starts) const;
+
+      MultiStartOptimizer(const MultiStartOptimizer &);
+      MultiStartOptimizer &operator=(const MultiStartOptimizer &);
+
+      const SimpleOptimizer *m_prototype;
+      OptLogBase *m_loger;
+
+      unsigned int m_numStarts;
+      StartSampling m_sampling;
+      bool m_includeInitial;
+      matrix_type m_regionLower;
+      matrix_type m_regionUpper;
+      bool m_cancelActive;
+      unsigned int m_cancelMinEvaluations;
+      double m_cancelTolerance;
+      int m_numThreads;
+      bool m_fixedSeed;
+      unsigned int m_seed;
+
+      /// best value of all runs after minEvaluations * 2^i evaluations (sign of minimization)
+      std::vector<double> m_incumbent;
+
+      std::vector<RunStatistics> m_runs;
+      unsigned int m_bestRun;
+  };
+
+} // namespace
+
+#endif
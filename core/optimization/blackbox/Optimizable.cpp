@@ -7,6 +7,7 @@
 //////////////////////////////////////////////////////////////////////
 
 #include "core/optimization/blackbox/Optimizable.h"
+#include "core/optimization/blackbox/BatchEvaluator.h"
 
 using namespace OPTIMIZATION;
 
@@ -48,15 +49,5 @@ Optimizable &Optimizable::operator=(const Optimizable &opt)
 
 matrix_type Optimizable::evaluateSet(const matrix_type &parameterSet)
 {
-  unsigned int iMax = parameterSet.cols();
-  matrix_type result(parameterSet.cols(),1);
-
-  for(unsigned int i = 0; i < iMax; i++)
-  {
-    //result(i) = this->evaluate(parameterSet.Sub(m_numOfParameters,1,0,i));
-    result(i,0) = this->evaluate(parameterSet(0,i,m_numOfParameters-1,i));
-  }
-
-  return result;
+  return BatchEvaluator::evaluate(*this, parameterSet, 1);
 }
-
@@ -63,10 +63,12 @@
       \return doubleMatrix containing 
           [evaluate(x_1), .... evaluate(x_n)];
       
-      can be overloaded for parallel computation
+      can be overloaded for parallel computation, the default
+      implementation evaluates the columns one after another
+      (see BatchEvaluator)
 
     */
-    OPTIMIZATION::matrix_type evaluateSet(const OPTIMIZATION::matrix_type &parameterSet);
+    virtual OPTIMIZATION::matrix_type evaluateSet(const OPTIMIZATION::matrix_type &parameterSet);
 
     protected:
       
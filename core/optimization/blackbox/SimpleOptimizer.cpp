@@ -9,6 +9,7 @@
 #include <iostream>
 
 #include "core/optimization/blackbox/SimpleOptimizer.h"
+#include "core/basics/Profiler.h"
 
 using namespace OPTIMIZATION;
 
@@ -47,6 +48,16 @@ SimpleOptimizer::~SimpleOptimizer()
 }
 
 
+SimpleOptimizer *SimpleOptimizer::clone() const
+{
+  return NULL;
+}
+
+void SimpleOptimizer::setRandomSeed(bool /*fixedSeed*/, unsigned int /*seed*/)
+{
+}
+
+
 void SimpleOptimizer::init()
 {
   SuperClass::init();
@@ -55,6 +66,7 @@ void SimpleOptimizer::init()
 
 int SimpleOptimizer::optimizeProb(SimpleOptProblem &optProb)
 {
+  NICE_PROFILE_ZONE ( "SimpleOptimizer::optimizeProb" );
   // get settings
   getSettings(optProb);
 
@@ -53,6 +53,20 @@ namespace OPTIMIZATION {
       ///
       virtual int optimizeProb(SimpleOptProblem &optProb);
 
+      ///
+      /// copy of the optimizer with all settings (for concurrent runs, see
+      /// MultiStartOptimizer)
+      /// @return new optimizer (delete it), NULL if the optimizer can not be copied (default)
+      ///
+      virtual SimpleOptimizer *clone() const;
+
+      ///
+      /// seed of the random number generator of randomized optimizers, the
+      /// default implementation ignores it (deterministic optimizers)
+      /// @param fixedSeed false: seeded with the time
+      ///
+      virtual void setRandomSeed(bool fixedSeed, unsigned int seed = 0);
+
 
   protected:
       ///
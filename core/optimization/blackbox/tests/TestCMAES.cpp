@@ -0,0 +1,221 @@
+#ifdef NICE_USELIB_CPPUNIT
+
+#include <cmath>
+#include <vector>
+
+#include "TestCMAES.h"
+#include "core/basics/Exception.h"
+
+using namespace std;
+using namespace OPTIMIZATION;
+
+const bool verboseStartEnd = true;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TestCMAES );
+
+void TestCMAES::setUp() {
+}
+
+void TestCMAES::tearDown() {
+}
+
+//test functions of the CMA-ES literature, recording the sizes of the batches
+class MyCMAESCostFunction : public CostFunction
+{
+  public:
+
+   enum Type { ELLIPSOID, ROSENBROCK, SHIFTED_SPHERE, RASTRIGIN };
+
+   MyCMAESCostFunction(int dim, Type type) : CostFunction(dim), m_type(type)
+   {
+   }
+
+   virtual double evaluate(const OPTIMIZATION::matrix_type & x)
+   {
+     const int n = x.rows();
+     double f = 0.0;
+     for ( int i = 0; i < n; i++ )
+     {
+       switch ( m_type )
+       {
+         case ELLIPSOID:
+           f += pow( 10.0, 6.0 * i / ( n - 1 ) ) * pow( x(i,0) - 1.0, 2.0 );
+           break;
+         case ROSENBROCK:
+           if ( i + 1 < n )
+             f += 100.0 * pow( x(i+1,0) - x(i,0) * x(i,0), 2.0 ) + pow( 1.0 - x(i,0), 2.0 );
+           break;
+         case SHIFTED_SPHERE:
+           f += pow( x(i,0) - 2.0, 2.0 );
+           break;
+         case RASTRIGIN:
+           f += 10.0 + x(i,0) * x(i,0) - 10.0 * cos( 2.0 * M_PI * x(i,0) );
+           break;
+       }
+     }
+     return f;
+   }
+
+   virtual OPTIMIZATION::matrix_type evaluateSet(const OPTIMIZATION::matrix_type & parameterSet)
+   {
+     batchSizes.push_back ( parameterSet.cols() );
+     return CostFunction::evaluateSet ( parameterSet );
+   }
+
+   std::vector<unsigned int> batchSizes;
+
+  private:
+   Type m_type;
+};
+
+void TestCMAES::testEllipsoid()
+{
+  if (verboseStartEnd)
+    std::cerr << "================== TestCMAES::testEllipsoid ===================== " << std::endl;
+
+  const int dim = 10;
+  MyCMAESCostFunction func ( dim, MyCMAESCostFunction::ELLIPSOID );
+  func.setThreadSafe ( true );
+
+  OPTIMIZATION::matrix_type initialParams (dim, 1, 0.0);
+  OPTIMIZATION::matrix_type scales (dim, 1, 1.0);
+  SimpleOptProblem optProblem ( &func, initialParams, scales );
+
+  CMAESOptimizer optimizer;
+  optimizer.setInitialSigma ( 0.5 );
+  optimizer.setPopulationSize ( 32 );
+  optimizer.setRandomSeed ( true, 1 );
+  optimizer.setFuncTol ( true, 1e-14 );
+  optimizer.setMaxNumIter ( true, 5000 );
+  const int reason = optimizer.optimizeProb ( optProblem );
+  CPPUNIT_ASSERT_EQUAL ( (int)Optimizer::SUCCESS_FUNCTOL, reason );
+
+  OPTIMIZATION::matrix_type result (optProblem.getAllCurrentParams());
+  CPPUNIT_ASSERT ( func.evaluate ( result ) < 1e-10 );
+  for ( int i = 0; i < dim; i++ )
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( 1.0, result(i,0), 1e-4 );
+
+  // one batch of lambda points per generation
+  CPPUNIT_ASSERT_EQUAL ( (unsigned int)32, optimizer.getPopulationSize() );
+  CPPUNIT_ASSERT ( func.batchSizes.size() > 10 );
+  for ( size_t k = 0; k < func.batchSizes.size(); k++ )
+    CPPUNIT_ASSERT_EQUAL ( (unsigned int)32, func.batchSizes[k] );
+  CPPUNIT_ASSERT_EQUAL ( (unsigned int)(32 * func.batchSizes.size() + 1), optimizer.getNumberOfEvaluations() );
+
+  if (verboseStartEnd)
+    std::cerr << "================== TestCMAES::testEllipsoid done ===================== " << std::endl;
+}
+
+//negated Rosenbrock function for maximization
+class MyNegatedRosenbrock : public MyCMAESCostFunction
+{
+  public:
+   MyNegatedRosenbrock(int dim) : MyCMAESCostFunction(dim, ROSENBROCK) {}
+
+   virtual double evaluate(const OPTIMIZATION::matrix_type & x)
+   {
+     return -MyCMAESCostFunction::evaluate ( x );
+   }
+};
+
+void TestCMAES::testRosenbrock()
+{
+  if (verboseStartEnd)
+    std::cerr << "================== TestCMAES::testRosenbrock ===================== " << std::endl;
+
+  const int dim = 6;
+  MyNegatedRosenbrock func ( dim );
+
+  OPTIMIZATION::matrix_type initialParams (dim, 1, -1.0);
+  OPTIMIZATION::matrix_type scales (dim, 1, 1.0);
+  SimpleOptProblem optProblem ( &func, initialParams, scales );
+  optProblem.setMaximize ( true );
+
+  CMAESOptimizer optimizer;
+  optimizer.setInitialSigma ( 0.5 );
+  optimizer.setRandomSeed ( true, 3 );
+  optimizer.setMaxNumIter ( true, 20000 );
+  optimizer.optimizeProb ( optProblem );
+
+  // default population 4 + 3 ln(6)
+  CPPUNIT_ASSERT_EQUAL ( (unsigned int)9, optimizer.getPopulationSize() );
+
+  OPTIMIZATION::matrix_type result (optProblem.getAllCurrentParams());
+  CPPUNIT_ASSERT ( func.evaluate ( result ) > -1e-8 );
+  for ( int i = 0; i < dim; i++ )
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( 1.0, result(i,0), 1e-4 );
+
+  if (verboseStartEnd)
+    std::cerr << "================== TestCMAES::testRosenbrock done ===================== " << std::endl;
+}
+
+void TestCMAES::testBounds()
+{
+  if (verboseStartEnd)
+    std::cerr << "================== TestCMAES::testBounds ===================== " << std::endl;
+
+  const int dim = 5;
+  MyCMAESCostFunction func ( dim, MyCMAESCostFunction::SHIFTED_SPHERE );
+
+  OPTIMIZATION::matrix_type initialParams (dim, 1, 0.0);
+  OPTIMIZATION::matrix_type scales (dim, 1, 1.0);
+  SimpleOptProblem optProblem ( &func, initialParams, scales );
+  // the minimum (2, ..., 2) is outside of the box except for the last parameter
+  for ( int i = 0; i < dim; i++ )
+  {
+    optProblem.setLowerBound ( i, -1.0 );
+    optProblem.setUpperBound ( i, i + 1 < dim ? 1.0 : 4.0 );
+  }
+
+  CMAESOptimizer optimizer;
+  optimizer.setRandomSeed ( true, 5 );
+  optimizer.setMaxNumIter ( true, 5000 );
+  optimizer.optimizeProb ( optProblem );
+
+  OPTIMIZATION::matrix_type result (optProblem.getAllCurrentParams());
+  for ( int i = 0; i < dim; i++ )
+  {
+    CPPUNIT_ASSERT ( result(i,0) >= -1.0 );
+    CPPUNIT_ASSERT ( result(i,0) <= ( i + 1 < dim ? 1.0 : 4.0 ) );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( i + 1 < dim ? 1.0 : 2.0, result(i,0), 1e-5 );
+  }
+
+  if (verboseStartEnd)
+    std::cerr << "================== TestCMAES::testBounds done ===================== " << std::endl;
+}
+
+void TestCMAES::testRestarts()
+{
+  if (verboseStartEnd)
+    std::cerr << "================== TestCMAES::testRestarts ===================== " << std::endl;
+
+  const int dim = 5;
+  MyCMAESCostFunction func ( dim, MyCMAESCostFunction::RASTRIGIN );
+  func.setThreadSafe ( true );
+
+  OPTIMIZATION::matrix_type initialParams (dim, 1, 3.0);
+  OPTIMIZATION::matrix_type scales (dim, 1, 1.0);
+  SimpleOptProblem optProblem ( &func, initialParams, scales );
+
+  CMAESOptimizer optimizer;
+  optimizer.setInitialSigma ( 2.0 );
+  optimizer.setRandomSeed ( true, 7 );
+  optimizer.setRestarts ( 9 );
+  optimizer.setFuncTol ( true, 1e-10 );
+  optimizer.optimizeProb ( optProblem );
+
+  // the population is doubled for every restart
+  const unsigned int restarts = optimizer.getNumberOfRestarts();
+  CPPUNIT_ASSERT ( restarts > 0 );
+  CPPUNIT_ASSERT_EQUAL ( (unsigned int)( 8 << restarts ), optimizer.getPopulationSize() );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)( 8 << restarts ), (size_t)func.batchSizes.back() );
+
+  // global minimum at 0
+  OPTIMIZATION::matrix_type result (optProblem.getAllCurrentParams());
+  CPPUNIT_ASSERT ( func.evaluate ( result ) < 1e-8 );
+
+  if (verboseStartEnd)
+    std::cerr << "================== TestCMAES::testRestarts done ===================== " << std::endl;
+}
+
+#endif
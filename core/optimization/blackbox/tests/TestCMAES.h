@@ -0,0 +1,49 @@
+#ifndef _TESTCMAES_H
+#define _TESTCMAES_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "core/optimization/blackbox/CMAESOptimizer.h"
+
+/**
+ * @brief CppUnit-Testcase for the CMA-ES optimizer
+ */
+class TestCMAES : public CppUnit::TestFixture {
+
+    CPPUNIT_TEST_SUITE( TestCMAES );
+    
+    CPPUNIT_TEST(testEllipsoid);
+    CPPUNIT_TEST(testRosenbrock);
+    CPPUNIT_TEST(testBounds);
+    CPPUNIT_TEST(testRestarts);
+    
+    CPPUNIT_TEST_SUITE_END();
+  
+ private:
+ 
+ public:
+    void setUp();
+    void tearDown();
+
+    /**
+    * @brief Ill-conditioned ellipsoid, one batch of lambda points per generation
+    */
+    void testEllipsoid();
+
+    /**
+    * @brief Rosenbrock function, maximization of the negated function
+    */
+    void testRosenbrock();
+
+    /**
+    * @brief Minimum outside of the box, the result is on the bounds
+    */
+    void testBounds();
+
+    /**
+    * @brief IPOP restarts on the multimodal Rastrigin function
+    */
+    void testRestarts();
+
+};
+
+#endif // _TESTCMAES_H
@@ -0,0 +1,202 @@
+#ifdef NICE_USELIB_CPPUNIT
+
+#include <cstdio>
+#include <fstream>
+
+#include "TestCachedCostFunction.h"
+#include "core/basics/Exception.h"
+
+using namespace std;
+using namespace OPTIMIZATION;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TestCachedCostFunction );
+
+void TestCachedCostFunction::setUp() {
+}
+
+void TestCachedCostFunction::tearDown() {
+}
+
+//f(x,y) = x^2 + 2 y^2, counts its evaluations
+class MyCountingCostFunction : public CostFunction
+{
+  public:
+
+   int calls;
+
+   MyCountingCostFunction() : CostFunction(2), calls(0)
+   {
+   }
+
+   virtual double evaluate(const OPTIMIZATION::matrix_type & x)
+   {
+#pragma omp atomic
+     calls++;
+     return x(0,0) * x(0,0) + 2.0 * x(1,0) * x(1,0);
+   }
+};
+
+static OPTIMIZATION::matrix_type point(double x, double y)
+{
+  OPTIMIZATION::matrix_type p(2,1);
+  p(0,0) = x;
+  p(1,0) = y;
+  return p;
+}
+
+void TestCachedCostFunction::testLookup()
+{
+  MyCountingCostFunction func;
+  CachedCostFunction cached(&func);
+
+  CPPUNIT_ASSERT_EQUAL( 3.0, cached.evaluate ( point(1.0, 1.0) ) );
+  CPPUNIT_ASSERT_EQUAL( 3.0, cached.evaluate ( point(1.0, 1.0) ) );
+  CPPUNIT_ASSERT_EQUAL( 1, func.calls );
+  CPPUNIT_ASSERT_EQUAL( 1u, cached.getNumberOfHits() );
+  CPPUNIT_ASSERT_EQUAL( 1u, cached.getNumberOfMisses() );
+  CPPUNIT_ASSERT_EQUAL( 1u, cached.getNumberOfEvaluations() );
+
+  // exact matches only, but -0 is 0
+  cached.evaluate ( point(1.0 + 1e-15, 1.0) );
+  CPPUNIT_ASSERT_EQUAL( 2, func.calls );
+  cached.evaluate ( point(0.0, 0.0) );
+  cached.evaluate ( point(-0.0, 0.0) );
+  CPPUNIT_ASSERT_EQUAL( 3, func.calls );
+
+  // with a tolerance, close points share their value
+  cached.setTolerance ( 1e-6 );
+  CPPUNIT_ASSERT_EQUAL( 2u, cached.size() );
+  CPPUNIT_ASSERT_EQUAL( 3.0, cached.evaluate ( point(1.0 + 1e-8, 1.0 - 1e-8) ) );
+  CPPUNIT_ASSERT_EQUAL( 3, func.calls );
+  cached.evaluate ( point(1.0 + 1e-5, 1.0) );
+  CPPUNIT_ASSERT_EQUAL( 4, func.calls );
+
+  // the line search function of the wrapper uses the cache as well
+  cached.setX0 ( point(0.0, 0.0) );
+  cached.setH0 ( point(1.0, 1.0) );
+  CPPUNIT_ASSERT_EQUAL( 3.0, cached.evaluateSub ( 1.0 ) );
+  CPPUNIT_ASSERT_EQUAL( 4, func.calls );
+
+  cached.resetStatistics();
+  CPPUNIT_ASSERT_EQUAL( 0u, cached.getNumberOfHits() );
+  CPPUNIT_ASSERT_EQUAL( 0u, cached.getNumberOfMisses() );
+
+  CPPUNIT_ASSERT_THROW( cached.evaluate ( OPTIMIZATION::matrix_type(3,1) ), NICE::Exception );
+  CPPUNIT_ASSERT_THROW( CachedCostFunction ( &func, -1.0 ), NICE::Exception );
+}
+
+void TestCachedCostFunction::testCapacity()
+{
+  MyCountingCostFunction func;
+  CachedCostFunction cached(&func, 0.0, 2);
+
+  cached.evaluate ( point(1.0, 0.0) );
+  cached.evaluate ( point(2.0, 0.0) );
+  // (1,0) becomes the most recently used value
+  cached.evaluate ( point(1.0, 0.0) );
+  cached.evaluate ( point(3.0, 0.0) );
+  CPPUNIT_ASSERT_EQUAL( 2u, cached.size() );
+  CPPUNIT_ASSERT_EQUAL( 3, func.calls );
+
+  cached.evaluate ( point(1.0, 0.0) );
+  CPPUNIT_ASSERT_EQUAL( 3, func.calls );
+  cached.evaluate ( point(2.0, 0.0) );
+  CPPUNIT_ASSERT_EQUAL( 4, func.calls );
+
+  cached.setCapacity ( 1 );
+  CPPUNIT_ASSERT_EQUAL( 1u, cached.size() );
+  cached.clear();
+  CPPUNIT_ASSERT_EQUAL( 0u, cached.size() );
+}
+
+void TestCachedCostFunction::testEvaluateSet()
+{
+  for ( int parallel = 0; parallel < 2; parallel++ )
+  {
+    MyCountingCostFunction func;
+    func.setThreadSafe ( parallel == 1 );
+    CachedCostFunction cached(&func);
+    CPPUNIT_ASSERT_EQUAL( parallel == 1, cached.isThreadSafe() );
+
+    cached.evaluate ( point(0.5, 0.5) );
+
+    OPTIMIZATION::matrix_type set(2, 40);
+    for ( int j = 0; j < 40; j++ )
+    {
+      // columns 0, 10, 20, 30 are (0.5, 0.5), the others appear twice
+      set(0,j) = ( j % 10 == 0 ) ? 0.5 : ( j % 20 ) * 0.1;
+      set(1,j) = ( j % 10 == 0 ) ? 0.5 : ( j % 20 ) * 0.2;
+    }
+    OPTIMIZATION::matrix_type values = cached.evaluateSet ( set );
+    CPPUNIT_ASSERT_EQUAL( 1 + 18, func.calls );
+    for ( int j = 0; j < 40; j++ )
+      CPPUNIT_ASSERT_EQUAL( set(0,j) * set(0,j) + 2.0 * set(1,j) * set(1,j), values(j,0) );
+
+    // everything is cached now
+    values = cached.evaluateSet ( set );
+    CPPUNIT_ASSERT_EQUAL( 1 + 18, func.calls );
+    CPPUNIT_ASSERT_EQUAL( 19u, cached.getNumberOfMisses() );
+    CPPUNIT_ASSERT_EQUAL( 40u + 22u, cached.getNumberOfHits() );
+  }
+}
+
+void TestCachedCostFunction::testJournal()
+{
+  const std::string journal = "TestCachedCostFunction.journal";
+  const std::string saved = "TestCachedCostFunction.cache";
+  remove ( journal.c_str() );
+
+  {
+    MyCountingCostFunction func;
+    CachedCostFunction cached(&func);
+    CPPUNIT_ASSERT_EQUAL( 0u, cached.setJournal ( journal ) );
+    cached.evaluate ( point(1.0 / 3.0, 2.0) );
+    cached.evaluate ( point(4.0, 5.0) );
+    cached.evaluate ( point(4.0, 5.0) );
+    cached.save ( saved );
+  }
+
+  {
+    // an interrupted write leaves an incomplete line
+    std::ofstream file ( journal.c_str(), std::ios::app );
+    file << "17.0 1.0";
+  }
+
+  {
+    MyCountingCostFunction func;
+    CachedCostFunction cached(&func);
+    CPPUNIT_ASSERT_EQUAL( 2u, cached.setJournal ( journal ) );
+    CPPUNIT_ASSERT_EQUAL( 1.0 / 9.0 + 8.0, cached.evaluate ( point(1.0 / 3.0, 2.0) ) );
+    cached.evaluate ( point(4.0, 5.0) );
+    CPPUNIT_ASSERT_EQUAL( 0, func.calls );
+    cached.evaluate ( point(6.0, 7.0) );
+    CPPUNIT_ASSERT_EQUAL( 1, func.calls );
+    cached.setJournal ( "" );
+
+    CachedCostFunction other(&func);
+    CPPUNIT_ASSERT_EQUAL( 2u, other.load ( saved ) );
+    CPPUNIT_ASSERT_EQUAL( 41.0 + 25.0, other.evaluate ( point(4.0, 5.0) ) );
+    CPPUNIT_ASSERT_EQUAL( 1, func.calls );
+  }
+
+  {
+    MyCountingCostFunction func;
+    CachedCostFunction cached(&func);
+    CPPUNIT_ASSERT_EQUAL( 3u, cached.setJournal ( journal ) );
+  }
+
+  // files of other cost functions are rejected
+  {
+    MyCountingCostFunction func;
+    CachedCostFunction cached(&func);
+    std::ofstream file ( saved.c_str() );
+    file << "# NICE CachedCostFunction 3" << std::endl;
+    file.close();
+    CPPUNIT_ASSERT_THROW( cached.load ( saved ), NICE::Exception );
+  }
+
+  remove ( journal.c_str() );
+  remove ( saved.c_str() );
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef _TESTCACHEDCOSTFUNCTION_H
+#define _TESTCACHEDCOSTFUNCTION_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "core/optimization/blackbox/CachedCostFunction.h"
+
+/**
+ * @brief CppUnit-Testcase for the memoizing cost function wrapper
+ */
+class TestCachedCostFunction : public CppUnit::TestFixture {
+
+    CPPUNIT_TEST_SUITE( TestCachedCostFunction );
+    
+    CPPUNIT_TEST(testLookup);
+    CPPUNIT_TEST(testCapacity);
+    CPPUNIT_TEST(testEvaluateSet);
+    CPPUNIT_TEST(testJournal);
+    
+    CPPUNIT_TEST_SUITE_END();
+  
+ private:
+ 
+ public:
+    void setUp();
+    void tearDown();
+
+    /**
+    * @brief Exact and tolerance-keyed lookups, statistics
+    */
+    void testLookup();
+
+    /**
+    * @brief Least recently used values are dropped first
+    */
+    void testCapacity();
+
+    /**
+    * @brief Batches with cached and duplicate columns, serial and parallel
+    */
+    void testEvaluateSet();
+
+    /**
+    * @brief Resuming from a journal file, save and load
+    */
+    void testJournal();
+};
+
+#endif // _TESTCACHEDCOSTFUNCTION_H
@@ -2,9 +2,12 @@
 
 #include <string>
 #include <exception>
+#include <stdexcept>
 #include <map>
 
 #include "TestDownhillSimplex.h"
+#include "core/basics/Exception.h"
+#include "core/optimization/blackbox/BatchEvaluator.h"
 
 using namespace std;
 using namespace OPTIMIZATION;
@@ -146,4 +149,98 @@ void TestDownhillSimplex::testDHS_2Dim()
     std::cerr << "================== TestDownhillSimplex::testDHS_2Dim done ===================== " << std::endl;  
 }
 
-#endif
\ No newline at end of file
+//a 4-dimensional Rosenbrock-like function which throws for x(0) > 100
+class MyBatchCostFunction : public CostFunction
+{
+  public:
+
+   MyBatchCostFunction() : CostFunction(4)
+   {
+   }
+
+   virtual double evaluate(const OPTIMIZATION::matrix_type & x)
+   {
+     if ( x(0,0) > 100.0 )
+       fthrow ( NICE::Exception, "parameter out of range" );
+     if ( x(0,0) < -100.0 )
+       throw std::out_of_range ( "parameter out of range" );
+
+     double f = 0.0;
+     for ( int i = 0; i < 3; i++ )
+       f += 100.0 * pow( x(i+1,0) - x(i,0) * x(i,0), 2.0 ) + pow( 1.0 - x(i,0), 2.0 );
+     return f;
+   }
+};
+
+void TestDownhillSimplex::testDHS_ThreadSafe()
+{
+  if (verboseStartEnd)
+    std::cerr << "================== TestDownhillSimplex::testDHS_ThreadSafe ===================== " << std::endl;
+
+  OPTIMIZATION::matrix_type result[2];
+  for ( int parallel = 0; parallel < 2; parallel++ )
+  {
+    MyBatchCostFunction func;
+    func.setThreadSafe ( parallel == 1 );
+    CPPUNIT_ASSERT_EQUAL ( parallel == 1, func.isThreadSafe() );
+
+    OPTIMIZATION::matrix_type initialParams (4, 1, 0.5);
+    OPTIMIZATION::matrix_type scales (4, 1, 0.3);
+    SimpleOptProblem optProblem ( &func, initialParams, scales );
+
+    DownhillSimplexOptimizer optimizer;
+    optimizer.setMaxNumIter(true, 2000);
+    optimizer.optimizeProb ( optProblem );
+    result[parallel] = optProblem.getAllCurrentParams();
+  }
+
+  // the batches are evaluated in a fixed order, so the results are identical
+  for ( int i = 0; i < 4; i++ )
+    CPPUNIT_ASSERT_EQUAL( result[0](i,0), result[1](i,0) );
+
+  if (verboseStartEnd)
+    std::cerr << "================== TestDownhillSimplex::testDHS_ThreadSafe done ===================== " << std::endl;
+}
+
+void TestDownhillSimplex::testEvaluateSet()
+{
+  if (verboseStartEnd)
+    std::cerr << "================== TestDownhillSimplex::testEvaluateSet ===================== " << std::endl;
+
+  MyBatchCostFunction func;
+  OPTIMIZATION::matrix_type set (4, 37);
+  for ( int j = 0; j < 37; j++ )
+    for ( int i = 0; i < 4; i++ )
+      set(i,j) = 0.1 * ( i + 1 ) * ( j - 18 );
+
+  OPTIMIZATION::matrix_type serial = func.evaluateSet ( set );
+  func.setThreadSafe ( true, 4 );
+  OPTIMIZATION::matrix_type parallel = func.evaluateSet ( set );
+  CPPUNIT_ASSERT_EQUAL( (size_t)37, (size_t)serial.rows() );
+  CPPUNIT_ASSERT_EQUAL( (size_t)1, (size_t)serial.cols() );
+  for ( int j = 0; j < 37; j++ )
+  {
+    OPTIMIZATION::matrix_type x = set(0,j,3,j);
+    CPPUNIT_ASSERT_EQUAL( func.evaluate ( x ), serial(j,0) );
+    CPPUNIT_ASSERT_EQUAL( serial(j,0), parallel(j,0) );
+  }
+
+  // errors of single columns are reported after the batch
+  set(0,20) = 1000.0;
+  CPPUNIT_ASSERT_THROW( func.evaluateSet ( set ), NICE::Exception );
+  CPPUNIT_ASSERT_THROW( BatchEvaluator::evaluate ( func, set, 1 ), NICE::Exception );
+
+  // the serial evaluation does not change the type of the exception
+  set(0,20) = -1000.0;
+  CPPUNIT_ASSERT_THROW( BatchEvaluator::evaluate ( func, set, 1 ), std::out_of_range );
+  CPPUNIT_ASSERT_THROW( BatchEvaluator::evaluate ( func, set, 4 ), NICE::Exception );
+
+  // empty sets
+  OPTIMIZATION::matrix_type empty = BatchEvaluator::evaluate ( func, OPTIMIZATION::matrix_type ( 4, 0 ) );
+  CPPUNIT_ASSERT_EQUAL( (size_t)0, (size_t)empty.rows() );
+
+  if (verboseStartEnd)
+    std::cerr << "================== TestDownhillSimplex::testEvaluateSet done ===================== " << std::endl;
+}
+
+#endif
@@ -15,6 +15,8 @@ class TestDownhillSimplex : public CppUnit::TestFixture {
     
     CPPUNIT_TEST(testDHS_1Dim);
     CPPUNIT_TEST(testDHS_2Dim);
+    CPPUNIT_TEST(testDHS_ThreadSafe);
+    CPPUNIT_TEST(testEvaluateSet);
     
     CPPUNIT_TEST_SUITE_END();
   
@@ -38,6 +40,16 @@ class TestDownhillSimplex : public CppUnit::TestFixture {
     */    
     void testDHS_2Dim();
 
+    /**
+    * @brief Test that a thread-safe cost function (parallel batches) gives the serial result
+    */
+    void testDHS_ThreadSafe();
+
+    /**
+    * @brief Test of the serial and parallel batch evaluation and its error handling
+    */
+    void testEvaluateSet();
+
 };
 
 #endif // _TESTFASTHIK_H
@@ -0,0 +1,205 @@
+#ifdef NICE_USELIB_CPPUNIT
+
+#include <cmath>
+#include <complex>
+
+#include "TestFiniteDifferences.h"
+#include "core/basics/Exception.h"
+
+using namespace std;
+using namespace OPTIMIZATION;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TestFiniteDifferences );
+
+void TestFiniteDifferences::setUp() {
+}
+
+void TestFiniteDifferences::tearDown() {
+}
+
+//f(x) = exp(x0) * sin(x1) + x0 * x2^2 + 3 * x1 * x2, written for double and complex parameters
+class MySmoothFunction : public CostFunction, public ComplexStepFunction
+{
+  public:
+
+   MySmoothFunction() : CostFunction(3)
+   {
+   }
+
+   template<class T>
+   static T f(const T & x0, const T & x1, const T & x2)
+   {
+     return exp(x0) * sin(x1) + x0 * x2 * x2 + 3.0 * x1 * x2;
+   }
+
+   virtual double evaluate(const OPTIMIZATION::matrix_type & x)
+   {
+     return f(x(0,0), x(1,0), x(2,0));
+   }
+
+   virtual std::complex<double> evaluateComplex(const std::vector< std::complex<double> > & x)
+   {
+     return f(x[0], x[1], x[2]);
+   }
+
+   static void gradient(const OPTIMIZATION::matrix_type & x, OPTIMIZATION::matrix_type & g)
+   {
+     g.resize(3,1);
+     g(0,0) = exp(x(0,0)) * sin(x(1,0)) + x(2,0) * x(2,0);
+     g(1,0) = exp(x(0,0)) * cos(x(1,0)) + 3.0 * x(2,0);
+     g(2,0) = 2.0 * x(0,0) * x(2,0) + 3.0 * x(1,0);
+   }
+
+   static void hessian(const OPTIMIZATION::matrix_type & x, OPTIMIZATION::matrix_type & h)
+   {
+     h.resize(3,3);
+     h(0,0) = exp(x(0,0)) * sin(x(1,0));
+     h(1,1) = -exp(x(0,0)) * sin(x(1,0));
+     h(2,2) = 2.0 * x(0,0);
+     h(0,1) = h(1,0) = exp(x(0,0)) * cos(x(1,0));
+     h(0,2) = h(2,0) = 2.0 * x(2,0);
+     h(1,2) = h(2,1) = 3.0;
+   }
+};
+
+//the same function with analytic gradient
+class MyGradientFunction : public MySmoothFunction
+{
+  public:
+
+   MyGradientFunction()
+   {
+     m_hasAnalyticGradient = true;
+   }
+
+   virtual const OPTIMIZATION::matrix_type getAnalyticGradient(const OPTIMIZATION::matrix_type & x)
+   {
+     OPTIMIZATION::matrix_type g;
+     gradient(x, g);
+     return g;
+   }
+};
+
+static OPTIMIZATION::matrix_type testPoint()
+{
+  OPTIMIZATION::matrix_type x(3,1);
+  x(0,0) = 0.3;
+  x(1,0) = -1.2;
+  x(2,0) = 20.5;
+  return x;
+}
+
+void TestFiniteDifferences::testGradient()
+{
+  const OPTIMIZATION::matrix_type x = testPoint();
+  OPTIMIZATION::matrix_type expected;
+  MySmoothFunction::gradient(x, expected);
+
+  const FiniteDifferences::Method methods[3] = { FiniteDifferences::FORWARD, FiniteDifferences::CENTRAL, FiniteDifferences::COMPLEX_STEP };
+  const double tolerance[3] = { 1e-5, 1e-8, 1e-13 };
+  const unsigned int evaluations[3] = { 4, 6, 3 };
+
+  for ( int parallel = 0; parallel < 2; parallel++ )
+    for ( int m = 0; m < 3; m++ )
+    {
+      MySmoothFunction func;
+      func.setThreadSafe ( parallel == 1 );
+      FiniteDifferences fd ( &func, methods[m] );
+      OPTIMIZATION::matrix_type g = fd.gradient ( x );
+      CPPUNIT_ASSERT_EQUAL( evaluations[m], fd.getNumberOfEvaluations() );
+      for ( int i = 0; i < 3; i++ )
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( expected(i,0), g(i,0), tolerance[m] * std::max ( 1.0, fabs ( expected(i,0) ) ) );
+    }
+
+  // a known function value saves one evaluation of forward differences
+  MySmoothFunction func;
+  FiniteDifferences fd ( &func, FiniteDifferences::FORWARD );
+  const double fx = func.evaluate ( x );
+  OPTIMIZATION::matrix_type g;
+  fd.gradient ( x, g, &fx );
+  CPPUNIT_ASSERT_EQUAL( 3u, fd.getNumberOfEvaluations() );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL( expected(1,0), g(1,0), 1e-5 * fabs ( expected(1,0) ) );
+
+  // noisy functions need larger steps
+  fd.setMethod ( FiniteDifferences::CENTRAL );
+  fd.setFunctionNoise ( 1e-10 );
+  fd.gradient ( x, g );
+  for ( int i = 0; i < 3; i++ )
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( expected(i,0), g(i,0), 1e-5 * std::max ( 1.0, fabs ( expected(i,0) ) ) );
+}
+
+void TestFiniteDifferences::testHessian()
+{
+  const OPTIMIZATION::matrix_type x = testPoint();
+  OPTIMIZATION::matrix_type expectedGradient, expectedHessian;
+  MySmoothFunction::gradient(x, expectedGradient);
+  MySmoothFunction::hessian(x, expectedHessian);
+
+  for ( int parallel = 0; parallel < 2; parallel++ )
+  {
+    MySmoothFunction func;
+    func.setThreadSafe ( parallel == 1 );
+    FiniteDifferences fd ( &func );
+    OPTIMIZATION::matrix_type g, h;
+    fd.gradientAndHessian ( x, g, h );
+    // 1 + 2n + 2n(n-1) for the Hessian, 2n for the gradient
+    CPPUNIT_ASSERT_EQUAL( 25u, fd.getNumberOfEvaluations() );
+    for ( int i = 0; i < 3; i++ )
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL( expectedGradient(i,0), g(i,0), 1e-8 * std::max ( 1.0, fabs ( expectedGradient(i,0) ) ) );
+      for ( int j = 0; j < 3; j++ )
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL( expectedHessian(i,j), h(i,j), 1e-4 * std::max ( 1.0, fabs ( expectedHessian(i,j) ) ) );
+        CPPUNIT_ASSERT_EQUAL( h(i,j), h(j,i) );
+      }
+    }
+  }
+}
+
+void TestFiniteDifferences::testAnalyticGradient()
+{
+  const OPTIMIZATION::matrix_type x = testPoint();
+  OPTIMIZATION::matrix_type expectedHessian;
+  MySmoothFunction::hessian(x, expectedHessian);
+
+  MyGradientFunction func;
+  func.setThreadSafe ( true );
+  FiniteDifferences fd ( &func );
+  OPTIMIZATION::matrix_type h;
+  fd.hessian ( x, h );
+  CPPUNIT_ASSERT_EQUAL( 6u, fd.getNumberOfEvaluations() );
+  for ( int i = 0; i < 3; i++ )
+    for ( int j = 0; j < 3; j++ )
+      CPPUNIT_ASSERT_DOUBLES_EQUAL( expectedHessian(i,j), h(i,j), 1e-7 * std::max ( 1.0, fabs ( expectedHessian(i,j) ) ) );
+}
+
+//a function without complex evaluation
+class MyPlainFunction : public CostFunction
+{
+  public:
+
+   MyPlainFunction() : CostFunction(2)
+   {
+   }
+
+   virtual double evaluate(const OPTIMIZATION::matrix_type & x)
+   {
+     return x(0,0) * x(1,0);
+   }
+};
+
+void TestFiniteDifferences::testErrors()
+{
+  MyPlainFunction func;
+  FiniteDifferences fd ( &func, FiniteDifferences::COMPLEX_STEP );
+  OPTIMIZATION::matrix_type x(2, 1, 1.0);
+  CPPUNIT_ASSERT_THROW( fd.gradient ( x ), NICE::Exception );
+
+  fd.setMethod ( FiniteDifferences::CENTRAL );
+  OPTIMIZATION::matrix_type wrong(3, 1, 1.0);
+  CPPUNIT_ASSERT_THROW( fd.gradient ( wrong ), NICE::Exception );
+  CPPUNIT_ASSERT_THROW( fd.setFunctionNoise ( 0.0 ), NICE::Exception );
+  CPPUNIT_ASSERT_THROW( FiniteDifferences ( NULL ), NICE::Exception );
+}
+
+#endif
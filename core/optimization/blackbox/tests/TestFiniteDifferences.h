@@ -0,0 +1,48 @@
+#ifndef _TESTFINITEDIFFERENCES_H
+#define _TESTFINITEDIFFERENCES_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "core/optimization/blackbox/FiniteDifferences.h"
+
+/**
+ * @brief CppUnit-Testcase for numerical gradients and Hessians
+ */
+class TestFiniteDifferences : public CppUnit::TestFixture {
+
+    CPPUNIT_TEST_SUITE( TestFiniteDifferences );
+    
+    CPPUNIT_TEST(testGradient);
+    CPPUNIT_TEST(testHessian);
+    CPPUNIT_TEST(testAnalyticGradient);
+    CPPUNIT_TEST(testErrors);
+    
+    CPPUNIT_TEST_SUITE_END();
+  
+ private:
+ 
+ public:
+    void setUp();
+    void tearDown();
+
+    /**
+    * @brief Forward, central and complex-step gradients, serial and parallel
+    */
+    void testGradient();
+
+    /**
+    * @brief Hessian and gradient from a single batch of function values
+    */
+    void testHessian();
+
+    /**
+    * @brief Hessian from differences of analytic gradients
+    */
+    void testAnalyticGradient();
+
+    /**
+    * @brief Invalid arguments
+    */
+    void testErrors();
+};
+
+#endif // _TESTFINITEDIFFERENCES_H
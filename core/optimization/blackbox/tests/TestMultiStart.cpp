@@ -0,0 +1,391 @@
+#ifdef NICE_USELIB_CPPUNIT
+
+#include <cmath>
+#include <vector>
+
+#include "TestMultiStart.h"
+#include "core/basics/Exception.h"
+#include "core/optimization/blackbox/DownhillSimplexOptimizer.h"
+#include "core/optimization/blackbox/CMAESOptimizer.h"
+
+using namespace std;
+using namespace OPTIMIZATION;
+
+const bool verboseStartEnd = true;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TestMultiStart );
+
+void TestMultiStart::setUp() {
+}
+
+void TestMultiStart::tearDown() {
+}
+
+void TestMultiStart::testSampling()
+{
+  if (verboseStartEnd)
+    std::cerr << "================== TestMultiStart::testSampling ===================== " << std::endl;
+
+  // Latin hypercube: one point per stratum and coordinate
+  {
+    const unsigned int n = 37, dim = 5;
+    OPTIMIZATION::matrix_type points;
+    MultiStartOptimizer::sampleUnitCube ( MultiStartOptimizer::LATIN_HYPERCUBE, n, dim, points );
+    CPPUNIT_ASSERT_EQUAL ( (size_t)dim, (size_t)points.rows() );
+    CPPUNIT_ASSERT_EQUAL ( (size_t)n, (size_t)points.cols() );
+    for ( unsigned int i = 0; i < dim; i++ )
+    {
+      std::vector<int> count ( n, 0 );
+      for ( unsigned int k = 0; k < n; k++ )
+      {
+        CPPUNIT_ASSERT ( points(i,k) > 0.0 && points(i,k) < 1.0 );
+        count[ (int)floor ( points(i,k) * n ) ]++;
+      }
+      for ( unsigned int k = 0; k < n; k++ )
+        CPPUNIT_ASSERT_EQUAL ( 1, count[k] );
+    }
+  }
+
+  // Sobol: the first 2^m points without the origin, one point in each
+  // interval of width 2^-m except [0, 2^-m)
+  {
+    const unsigned int m = 7, n = ( 1 << m ) - 1, dim = MultiStartOptimizer::maxSobolDimension;
+    OPTIMIZATION::matrix_type points;
+    MultiStartOptimizer::sampleUnitCube ( MultiStartOptimizer::SOBOL, n, dim, points );
+    for ( unsigned int i = 0; i < dim; i++ )
+    {
+      std::vector<int> count ( n + 1, 0 );
+      for ( unsigned int k = 0; k < n; k++ )
+      {
+        CPPUNIT_ASSERT ( points(i,k) > 0.0 && points(i,k) < 1.0 );
+        count[ (int)floor ( points(i,k) * ( n + 1 ) ) ]++;
+      }
+      CPPUNIT_ASSERT_EQUAL ( 0, count[0] );
+      for ( unsigned int k = 1; k <= n; k++ )
+        CPPUNIT_ASSERT_EQUAL ( 1, count[k] );
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL ( 0.5, points(0,0), 0.0 );
+
+    // pairs of coordinates: one point in each square of width 2^-3 among the first 64
+    OPTIMIZATION::matrix_type pairs;
+    MultiStartOptimizer::sampleUnitCube ( MultiStartOptimizer::SOBOL, 64, 3, pairs );
+    for ( unsigned int i = 0; i < 3; i++ )
+      for ( unsigned int j = i + 1; j < 3; j++ )
+      {
+        std::vector<int> count ( 64, 0 );
+        for ( unsigned int k = 0; k < 63; k++ )
+          count[ 8 * (int)floor ( pairs(i,k) * 8 ) + (int)floor ( pairs(j,k) * 8 ) ]++;
+        for ( unsigned int c = 1; c < 64; c++ )
+          CPPUNIT_ASSERT ( count[c] <= 1 );
+      }
+
+    CPPUNIT_ASSERT_THROW ( MultiStartOptimizer::sampleUnitCube ( MultiStartOptimizer::SOBOL, 4, dim + 1, points ),
+                           NICE::Exception );
+  }
+
+  if (verboseStartEnd)
+    std::cerr << "================== TestMultiStart::testSampling done ===================== " << std::endl;
+}
+
+//Rastrigin function, counting the clones
+class MyMultiStartRastrigin : public CostFunction
+{
+  public:
+
+   MyMultiStartRastrigin(int dim, int *clones) : CostFunction(dim), m_dim(dim), m_clones(clones), numEvaluations(0)
+   {
+   }
+
+   virtual double evaluate(const OPTIMIZATION::matrix_type & x)
+   {
+     numEvaluations++;
+     double f = 0.0;
+     for ( unsigned int i = 0; i < x.rows(); i++ )
+       f += 10.0 + x(i,0) * x(i,0) - 10.0 * cos( 2.0 * M_PI * x(i,0) );
+     return f;
+   }
+
+   virtual CostFunction *clone() const
+   {
+     if ( m_clones == NULL )
+       return NULL;
+#pragma omp atomic
+     (*m_clones)++;
+     return new MyMultiStartRastrigin ( m_dim, m_clones );
+   }
+
+  private:
+   int m_dim;
+   int *m_clones;
+
+  public:
+   //! not synchronized, only for functions without clone()
+   unsigned int numEvaluations;
+};
+
+void TestMultiStart::testMultiStart()
+{
+  if (verboseStartEnd)
+    std::cerr << "================== TestMultiStart::testMultiStart ===================== " << std::endl;
+
+  const int dim = 2;
+  int clones = 0;
+  MyMultiStartRastrigin func ( dim, &clones );
+
+  // the local minimum at (2,2) is the start point
+  OPTIMIZATION::matrix_type initialParams (dim, 1, 2.0);
+  OPTIMIZATION::matrix_type scales (dim, 1, 0.3);
+  SimpleOptProblem optProblem ( &func, initialParams, scales );
+
+  DownhillSimplexOptimizer optimizer;
+  optimizer.setMaxNumIter ( true, 500 );
+
+  MultiStartOptimizer multiStart ( optimizer );
+  multiStart.setNumberOfStarts ( 25 );
+  multiStart.setRandomSeed ( true, 11 );
+  multiStart.setSearchRegion ( OPTIMIZATION::matrix_type ( dim, 1, -2.5 ), OPTIMIZATION::matrix_type ( dim, 1, 2.5 ) );
+  multiStart.optimizeProb ( optProblem );
+
+  // every run evaluates its own copy
+  CPPUNIT_ASSERT_EQUAL ( 25, clones );
+  CPPUNIT_ASSERT_EQUAL ( (unsigned int)0, func.numEvaluations );
+
+  // global minimum at 0
+  OPTIMIZATION::matrix_type result ( optProblem.getAllCurrentParams() );
+  CPPUNIT_ASSERT ( func.evaluate ( result ) < 1e-6 );
+
+  const std::vector<MultiStartOptimizer::RunStatistics> &runs = multiStart.getRunStatistics();
+  CPPUNIT_ASSERT_EQUAL ( (size_t)25, runs.size() );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 2.0, runs[0].startParameters(0,0), 0.0 );
+  for ( size_t r = 0; r < runs.size(); r++ )
+  {
+    CPPUNIT_ASSERT ( !runs[r].cancelled && !runs[r].failed );
+    CPPUNIT_ASSERT ( runs[r].returnReason >= 0 );
+    CPPUNIT_ASSERT ( runs[r].numEvaluations > 0 );
+    CPPUNIT_ASSERT ( runs[r].numIterations > 0 );
+    CPPUNIT_ASSERT ( runs[r].seconds >= 0.0 );
+    for ( int i = 0; i < dim; i++ )
+    {
+      CPPUNIT_ASSERT ( runs[r].startParameters(i,0) > -2.5 );
+      CPPUNIT_ASSERT ( runs[r].startParameters(i,0) < 2.5 );
+    }
+    CPPUNIT_ASSERT ( runs[r].value >= runs[multiStart.getBestRun()].value );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL ( runs[r].value, func.evaluate ( runs[r].parameters ), 0.0 );
+  }
+  // the start point stays in its local minimum
+  CPPUNIT_ASSERT ( runs[0].value > 1.0 );
+
+  if (verboseStartEnd)
+    std::cerr << "================== TestMultiStart::testMultiStart done ===================== " << std::endl;
+}
+
+void TestMultiStart::testEarlyCancel()
+{
+  if (verboseStartEnd)
+    std::cerr << "================== TestMultiStart::testEarlyCancel ===================== " << std::endl;
+
+  const int dim = 4;
+  int clones = 0;
+  MyMultiStartRastrigin func ( dim, &clones );
+
+  // the first run starts at the global minimum and sets the incumbent
+  OPTIMIZATION::matrix_type initialParams (dim, 1, 0.01);
+  OPTIMIZATION::matrix_type scales (dim, 1, 0.1);
+  SimpleOptProblem optProblem ( &func, initialParams, scales );
+
+  DownhillSimplexOptimizer optimizer;
+  optimizer.setMaxNumIter ( true, 2000 );
+  optimizer.setFuncTol ( true, 1e-12 );
+
+  MultiStartOptimizer multiStart ( optimizer );
+  multiStart.setNumberOfStarts ( 12 );
+  multiStart.setRandomSeed ( true, 3 );
+  multiStart.setNumThreads ( 1 );
+  multiStart.setEarlyCancel ( true, 20, 0.0 );
+  multiStart.setSearchRegion ( OPTIMIZATION::matrix_type ( dim, 1, -4.0 ), OPTIMIZATION::matrix_type ( dim, 1, 4.0 ) );
+  multiStart.optimizeProb ( optProblem );
+
+  const std::vector<MultiStartOptimizer::RunStatistics> &runs = multiStart.getRunStatistics();
+  CPPUNIT_ASSERT_EQUAL ( (unsigned int)0, multiStart.getBestRun() );
+  CPPUNIT_ASSERT ( !runs[0].cancelled );
+  unsigned int cancelled = 0;
+  for ( size_t r = 1; r < runs.size(); r++ )
+  {
+    if ( !runs[r].cancelled )
+      continue;
+    cancelled++;
+    CPPUNIT_ASSERT_EQUAL ( -1, runs[r].returnReason );
+    CPPUNIT_ASSERT ( !runs[r].failed );
+    CPPUNIT_ASSERT ( runs[r].numEvaluations >= 20 );
+    CPPUNIT_ASSERT ( runs[r].numEvaluations < runs[0].numEvaluations );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL ( runs[r].value, func.evaluate ( runs[r].parameters ), 0.0 );
+  }
+  CPPUNIT_ASSERT ( cancelled >= 9 );
+
+  if (verboseStartEnd)
+    std::cerr << "================== TestMultiStart::testEarlyCancel done ===================== " << std::endl;
+}
+
+//negated Rastrigin function for maximization
+class MyMultiStartNegatedRastrigin : public MyMultiStartRastrigin
+{
+  public:
+   MyMultiStartNegatedRastrigin(int dim) : MyMultiStartRastrigin(dim, NULL) {}
+
+   virtual double evaluate(const OPTIMIZATION::matrix_type & x)
+   {
+     return -MyMultiStartRastrigin::evaluate ( x );
+   }
+};
+
+void TestMultiStart::testSharedCostFunction()
+{
+  if (verboseStartEnd)
+    std::cerr << "================== TestMultiStart::testSharedCostFunction ===================== " << std::endl;
+
+  const int dim = 2;
+  MyMultiStartNegatedRastrigin func ( dim );
+
+  OPTIMIZATION::matrix_type initialParams (dim, 1, 0.5);
+  OPTIMIZATION::matrix_type scales (dim, 1, 0.3);
+  SimpleOptProblem optProblem ( &func, initialParams, scales );
+  optProblem.setMaximize ( true );
+  for ( int i = 0; i < dim; i++ )
+  {
+    optProblem.setLowerBound ( i, -2.5 );
+    optProblem.setUpperBound ( i, 2.5 );
+  }
+
+  DownhillSimplexOptimizer optimizer;
+  optimizer.setMaxNumIter ( true, 500 );
+
+  // the evaluations of the shared, not thread-safe cost function are serialized
+  MultiStartOptimizer multiStart ( optimizer );
+  multiStart.setNumberOfStarts ( 30 );
+  multiStart.setSampling ( MultiStartOptimizer::SOBOL );
+  multiStart.setIncludeInitialParameters ( false );
+  multiStart.setNumThreads ( 4 );
+  multiStart.optimizeProb ( optProblem );
+
+  const std::vector<MultiStartOptimizer::RunStatistics> &runs = multiStart.getRunStatistics();
+  unsigned int evaluations = 0;
+  for ( size_t r = 0; r < runs.size(); r++ )
+  {
+    evaluations += runs[r].numEvaluations;
+    // the search region are the bounds
+    for ( int i = 0; i < dim; i++ )
+      CPPUNIT_ASSERT ( fabs ( runs[r].startParameters(i,0) ) < 2.5 );
+    CPPUNIT_ASSERT ( runs[r].value <= runs[multiStart.getBestRun()].value );
+  }
+  CPPUNIT_ASSERT_EQUAL ( evaluations, func.numEvaluations );
+  // the first Sobol point is the center of the box
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 0.0, runs[0].startParameters(0,0), 0.0 );
+
+  OPTIMIZATION::matrix_type result ( optProblem.getAllCurrentParams() );
+  CPPUNIT_ASSERT ( func.evaluate ( result ) > -1e-6 );
+
+  if (verboseStartEnd)
+    std::cerr << "================== TestMultiStart::testSharedCostFunction done ===================== " << std::endl;
+}
+
+//Rastrigin function, which is not defined for x_0 > 1
+class MyMultiStartPartialRastrigin : public MyMultiStartRastrigin
+{
+  public:
+   MyMultiStartPartialRastrigin(int dim) : MyMultiStartRastrigin(dim, NULL) {}
+
+   virtual double evaluate(const OPTIMIZATION::matrix_type & x)
+   {
+     if ( x(0,0) > 1.0 )
+       fthrow ( NICE::Exception, "parameter out of range" );
+     return MyMultiStartRastrigin::evaluate ( x );
+   }
+};
+
+void TestMultiStart::testFailingRuns()
+{
+  if (verboseStartEnd)
+    std::cerr << "================== TestMultiStart::testFailingRuns ===================== " << std::endl;
+
+  const int dim = 2;
+  MyMultiStartPartialRastrigin func ( dim );
+
+  OPTIMIZATION::matrix_type initialParams (dim, 1, 0.5);
+  OPTIMIZATION::matrix_type scales (dim, 1, 0.3);
+  SimpleOptProblem optProblem ( &func, initialParams, scales );
+
+  DownhillSimplexOptimizer optimizer;
+  optimizer.setMaxNumIter ( true, 200 );
+
+  // throwing evaluations of the shared, not thread-safe cost function release
+  // the serialization, the other runs continue
+  MultiStartOptimizer multiStart ( optimizer );
+  multiStart.setNumberOfStarts ( 16 );
+  multiStart.setSampling ( MultiStartOptimizer::SOBOL );
+  multiStart.setIncludeInitialParameters ( false );
+  multiStart.setSearchRegion ( OPTIMIZATION::matrix_type ( dim, 1, -2.5 ), OPTIMIZATION::matrix_type ( dim, 1, 2.5 ) );
+  multiStart.setNumThreads ( 4 );
+  multiStart.optimizeProb ( optProblem );
+
+  const std::vector<MultiStartOptimizer::RunStatistics> &runs = multiStart.getRunStatistics();
+  CPPUNIT_ASSERT_EQUAL ( (size_t)16, runs.size() );
+  unsigned int failed = 0;
+  for ( size_t r = 0; r < runs.size(); r++ )
+  {
+    if ( runs[r].startParameters(0,0) > 1.0 )
+      CPPUNIT_ASSERT ( runs[r].failed );
+    if ( runs[r].failed )
+      failed++;
+  }
+  CPPUNIT_ASSERT ( failed > 0 );
+  CPPUNIT_ASSERT ( !runs[multiStart.getBestRun()].failed );
+
+  if (verboseStartEnd)
+    std::cerr << "================== TestMultiStart::testFailingRuns done ===================== " << std::endl;
+}
+
+void TestMultiStart::testReproducibleRuns()
+{
+  if (verboseStartEnd)
+    std::cerr << "================== TestMultiStart::testReproducibleRuns ===================== " << std::endl;
+
+  const int dim = 3;
+  CMAESOptimizer optimizer;
+  optimizer.setInitialSigma ( 0.5 );
+  optimizer.setPopulationSize ( 8 );
+  optimizer.setMaxNumIter ( true, 100 );
+
+  // randomized runs with a fixed seed do not depend on the number of threads
+  std::vector<MultiStartOptimizer::RunStatistics> runs[2];
+  for ( int k = 0; k < 2; k++ )
+  {
+    int clones = 0;
+    MyMultiStartRastrigin func ( dim, &clones );
+    OPTIMIZATION::matrix_type initialParams ( dim, 1, 1.0 );
+    OPTIMIZATION::matrix_type scales ( dim, 1, 1.0 );
+    SimpleOptProblem optProblem ( &func, initialParams, scales );
+
+    MultiStartOptimizer multiStart ( optimizer );
+    multiStart.setNumberOfStarts ( 8 );
+    multiStart.setRandomSeed ( true, 5 );
+    multiStart.setNumThreads ( k == 0 ? 4 : 1 );
+    multiStart.setSearchRegion ( OPTIMIZATION::matrix_type ( dim, 1, -3.0 ), OPTIMIZATION::matrix_type ( dim, 1, 3.0 ) );
+    multiStart.optimizeProb ( optProblem );
+    runs[k] = multiStart.getRunStatistics();
+  }
+
+  CPPUNIT_ASSERT_EQUAL ( (size_t)8, runs[0].size() );
+  CPPUNIT_ASSERT_EQUAL ( runs[0].size(), runs[1].size() );
+  for ( size_t r = 0; r < runs[0].size(); r++ )
+  {
+    CPPUNIT_ASSERT_EQUAL ( runs[0][r].numEvaluations, runs[1][r].numEvaluations );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL ( runs[0][r].value, runs[1][r].value, 0.0 );
+    for ( int i = 0; i < dim; i++ )
+      CPPUNIT_ASSERT_DOUBLES_EQUAL ( runs[0][r].parameters(i,0), runs[1][r].parameters(i,0), 0.0 );
+  }
+
+  if (verboseStartEnd)
+    std::cerr << "================== TestMultiStart::testReproducibleRuns done ===================== " << std::endl;
+}
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef _TESTMULTISTART_H
+#define _TESTMULTISTART_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "core/optimization/blackbox/MultiStartOptimizer.h"
+
+/**
+ * @brief CppUnit-Testcase for the multi-start driver
+ */
+class TestMultiStart : public CppUnit::TestFixture {
+
+    CPPUNIT_TEST_SUITE( TestMultiStart );
+    
+    CPPUNIT_TEST(testSampling);
+    CPPUNIT_TEST(testMultiStart);
+    CPPUNIT_TEST(testEarlyCancel);
+    CPPUNIT_TEST(testSharedCostFunction);
+    CPPUNIT_TEST(testFailingRuns);
+    CPPUNIT_TEST(testReproducibleRuns);
+    
+    CPPUNIT_TEST_SUITE_END();
+  
+ private:
+ 
+ public:
+    void setUp();
+    void tearDown();
+
+    /**
+    * @brief Stratification of the Latin hypercube and Sobol points
+    */
+    void testSampling();
+
+    /**
+    * @brief Concurrent downhill simplex runs with cloned cost functions on a multimodal function
+    */
+    void testMultiStart();
+
+    /**
+    * @brief Runs behind the incumbent are cancelled
+    */
+    void testEarlyCancel();
+
+    /**
+    * @brief Cost functions without clone() are shared, maximization
+    */
+    void testSharedCostFunction();
+
+    /**
+    * @brief Throwing evaluations of a shared cost function fail their runs only
+    */
+    void testFailingRuns();
+
+    /**
+    * @brief Concurrent CMA-ES runs with a fixed seed are reproducible
+    */
+    void testReproducibleRuns();
+
+};
+
+#endif // _TESTMULTISTART_H
@@ -0,0 +1,68 @@
+/*
+ * NICE-Core - efficient algebra and computer vision methods
+ *  - liboptimization - An optimization/template for new NICE libraries
+ * See file License for license information.
+ */
+/*****************************************************************************/
+#include "core/optimization/gradientBased/CostFunctionProblem.h"
+
+namespace NICE {
+
+CostFunctionProblem::CostFunctionProblem(
+    OPTIMIZATION::CostFunction* costFunction,
+    const Vector& initialParameters,
+    OPTIMIZATION::FiniteDifferences::Method method)
+    : OptimizationProblemSecond(initialParameters.size()),
+      m_costFunction(costFunction),
+      m_finiteDifferences(costFunction, method) {
+  if (costFunction->getNumOfParameters() != initialParameters.size()) {
+    fthrow(Exception, "CostFunctionProblem: the cost function has "
+           << costFunction->getNumOfParameters() << " parameters, not "
+           << initialParameters.size());
+  }
+  parameters() = initialParameters;
+}
+
+CostFunctionProblem::~CostFunctionProblem() {
+}
+
+double CostFunctionProblem::computeObjective() {
+  // the parameters as column vector without copying
+  const Matrix x(parameters().getDataPointer(), dimension(), 1,
+                 MatrixBase::external);
+  return m_costFunction->evaluate(x);
+}
+
+void CostFunctionProblem::computeGradient(Vector& newGradient) {
+  const Matrix x(parameters().getDataPointer(), dimension(), 1,
+                 MatrixBase::external);
+  Matrix gradient;
+  if (m_costFunction->hasAnalyticGradient()) {
+    gradient = m_costFunction->getAnalyticGradient(x);
+  } else if (m_finiteDifferences.getMethod()
+             == OPTIMIZATION::FiniteDifferences::FORWARD) {
+    // the objective is usually known already
+    const double fx = objective();
+    m_finiteDifferences.gradient(x, gradient, &fx);
+  } else {
+    m_finiteDifferences.gradient(x, gradient);
+  }
+
+  for (unsigned int i = 0; i < dimension(); i++) {
+    newGradient[i] = gradient(i, 0);
+  }
+}
+
+void CostFunctionProblem::computeGradientAndHessian(Vector& newGradient,
+                                                    Matrix& newHessian) {
+  const Matrix x(parameters().getDataPointer(), dimension(), 1,
+                 MatrixBase::external);
+  Matrix gradient;
+  m_finiteDifferences.gradientAndHessian(x, gradient, newHessian);
+
+  for (unsigned int i = 0; i < dimension(); i++) {
+    newGradient[i] = gradient(i, 0);
+  }
+}
+
+}; // namespace NICE
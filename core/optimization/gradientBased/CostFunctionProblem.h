@@ -0,0 +1,70 @@
+/*
+ * NICE-Core - efficient algebra and computer vision methods
+ *  - liboptimization - An optimization/template for new NICE libraries
+ * See file License for license information.
+ */
+/*****************************************************************************/
+#ifndef _COSTFUNCTIONPROBLEM_OPTIMIZATION_H
+#define _COSTFUNCTIONPROBLEM_OPTIMIZATION_H
+
+#include <core/optimization/gradientBased/OptimizationProblemSecond.h>
+#include <core/optimization/blackbox/CostFunction.h>
+#include <core/optimization/blackbox/FiniteDifferences.h>
+
+namespace NICE {
+
+/**
+ * Adapter which makes any (black box) \c OPTIMIZATION::CostFunction
+ * an \c OptimizationProblemSecond, so it can be minimized with
+ * \c FirstOrderTrustRegion, \c FirstOrderRasmussen
+ * or \c SecondOrderTrustRegion.
+ *
+ * Analytic gradients and Hessians of the cost function are used if
+ * available, otherwise they are computed with
+ * \c OPTIMIZATION::FiniteDifferences. Declare the cost function thread-safe
+ * (\c CostFunction::setThreadSafe()) to compute them on all cores.
+ *
+ * \ingroup optimization_problems
+ */
+class CostFunctionProblem : public OptimizationProblemSecond {
+public:
+  /**
+   * @param costFunction the objective function (not deleted)
+   * @param initialParameters start position
+   * @param method finite differences of the gradient if there is no
+   *        analytic gradient
+   */
+  CostFunctionProblem(OPTIMIZATION::CostFunction* costFunction,
+                      const Vector& initialParameters,
+                      OPTIMIZATION::FiniteDifferences::Method method
+                        = OPTIMIZATION::FiniteDifferences::CENTRAL);
+
+  virtual ~CostFunctionProblem();
+
+  /**
+   * The finite differences (to change the method, the noise or the scales).
+   */
+  inline OPTIMIZATION::FiniteDifferences& finiteDifferences() {
+    return m_finiteDifferences;
+  }
+
+  inline OPTIMIZATION::CostFunction* costFunction() {
+    return m_costFunction;
+  }
+
+protected:
+  virtual double computeObjective();
+
+  virtual void computeGradient(Vector& newGradient);
+
+  virtual void computeGradientAndHessian(Vector& newGradient,
+                                         Matrix& newHessian);
+
+private:
+  OPTIMIZATION::CostFunction* m_costFunction;
+  OPTIMIZATION::FiniteDifferences m_finiteDifferences;
+};
+
+}; // namespace NICE
+
+#endif /* _COSTFUNCTIONPROBLEM_OPTIMIZATION_H */
@@ -0,0 +1,75 @@
+/**
+* @file FirstOrderAdam.cpp
+* @brief Adam and AdamW for minibatch gradients
+* @date 10/19/2026
+
+*/
+#include <cmath>
+
+#include "FirstOrderAdam.h"
+
+#include "core/basics/Exception.h"
+
+using namespace std;
+using namespace NICE;
+
+FirstOrderAdam::FirstOrderAdam( double _learningRate, double _beta1, double _beta2, bool _verbose )
+	: FirstOrderStochastic ( _learningRate, _verbose ), epsilon(1e-8),
+	  weightDecay(0.0), decoupled(true)
+{
+	setLearningRate ( _learningRate );
+	setBetas ( _beta1, _beta2 );
+}
+
+FirstOrderAdam::~FirstOrderAdam()
+{
+}
+
+void FirstOrderAdam::setBetas ( double _beta1, double _beta2 )
+{
+	if ( _beta1 < 0.0 || _beta1 >= 1.0 || _beta2 < 0.0 || _beta2 >= 1.0 )
+		fthrow ( Exception, "FirstOrderAdam: the decay rates " << _beta1 << ", " << _beta2
+		         << " are not in [0,1)" );
+	beta1 = _beta1;
+	beta2 = _beta2;
+}
+
+void FirstOrderAdam::setWeightDecay ( double _weightDecay, bool _decoupled )
+{
+	if ( _weightDecay < 0.0 )
+		fthrow ( Exception, "FirstOrderAdam: negative weight decay " << _weightDecay );
+	weightDecay = _weightDecay;
+	decoupled = _decoupled;
+}
+
+void FirstOrderAdam::resetState ( uint n )
+{
+	m_m.resize ( n );
+	m_m.set ( 0.0 );
+	m_v.resize ( n );
+	m_v.set ( 0.0 );
+}
+
+void FirstOrderAdam::computeStep ( const Vector & gradient, const Vector & position,
+                                   double stepSize, uint t, Vector & step )
+{
+	const uint n = gradient.size();
+	const double *g = gradient.getDataPointer();
+	const double *x = position.getDataPointer();
+	double *m = m_m.getDataPointer();
+	double *v = m_v.getDataPointer();
+	double *s = step.getDataPointer();
+
+	// bias corrections of the moment estimates
+	const double c1 = 1.0 / ( 1.0 - pow ( beta1, (double)t ) );
+	const double c2 = 1.0 / ( 1.0 - pow ( beta2, (double)t ) );
+	const double l2 = decoupled ? 0.0 : weightDecay;
+	const double decay = decoupled ? weightDecay : 0.0;
+	for ( uint i = 0 ; i < n ; i++ )
+	{
+		const double gi = g[i] + l2 * x[i];
+		m[i] = beta1 * m[i] + ( 1.0 - beta1 ) * gi;
+		v[i] = beta2 * v[i] + ( 1.0 - beta2 ) * gi * gi;
+		s[i] = -stepSize * ( m[i] * c1 / ( sqrt ( v[i] * c2 ) + epsilon ) + decay * x[i] );
+	}
+}
@@ -0,0 +1,81 @@
+/**
+* @file FirstOrderAdam.h
+* @brief Adam and AdamW for minibatch gradients
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_FIRSTORDERADAMINCLUDE
+#define _NICE_FIRSTORDERADAMINCLUDE
+
+#include "core/optimization/gradientBased/FirstOrderStochastic.h"
+
+namespace NICE {
+
+/** @class FirstOrderAdam
+ * Adam (Kingma and Ba 2015): steps with the bias-corrected first and
+ * second moment estimates m and v of the minibatch gradients,
+ *   x = x - stepSize * m / (sqrt(v) + epsilon).
+ *
+ * Weight decay is either decoupled from the gradient (AdamW, Loshchilov
+ * and Hutter 2019), i.e., stepSize * weightDecay * x is subtracted in
+ * every step, or an L2 regularization added to the gradient (Adam).
+ * See \c FirstOrderStochastic for the minibatches and the step size.
+ *
+ * \ingroup optimization_algorithms
+ */
+class FirstOrderAdam : public NICE::FirstOrderStochastic
+{
+
+    protected:
+
+		/** decay rates of the moment estimates */
+		double beta1;
+		double beta2;
+
+		/** regularization of the denominator */
+		double epsilon;
+
+		/** weight decay, decoupled (AdamW) or added to the gradient */
+		double weightDecay;
+		bool decoupled;
+
+		void resetState ( uint n );
+
+		void computeStep ( const Vector & gradient, const Vector & position,
+		                   double stepSize, uint t, Vector & step );
+
+    private:
+
+		/** first and second moment estimates */
+		Vector m_m;
+		Vector m_v;
+
+    public:
+
+		/** simple constructor
+		 * @param learningRate step size
+		 * @param beta1 decay rate of the first moment
+		 * @param beta2 decay rate of the second moment
+		 */
+		FirstOrderAdam( double learningRate = 0.001, double beta1 = 0.9,
+		                double beta2 = 0.999, bool verbose = false );
+
+		/** simple destructor */
+		virtual ~FirstOrderAdam();
+
+		/** decay rates of the moment estimates, in [0,1) */
+		void setBetas ( double beta1, double beta2 );
+
+		/** regularization of the denominator (default: 1e-8) */
+		void setEpsilon ( double _epsilon ) { epsilon = _epsilon; };
+
+		/** weight decay (default: 0)
+		 * @param decoupled true: AdamW, false: L2 regularization weightDecay * |x|^2 / 2
+		 */
+		void setWeightDecay ( double weightDecay, bool decoupled = true );
+
+};
+
+}
+
+#endif
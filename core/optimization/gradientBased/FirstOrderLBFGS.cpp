@@ -0,0 +1,545 @@
+/**
+* @file FirstOrderLBFGS.cpp
+* @brief limited memory BFGS with More-Thuente line search and optional box constraints
+* @date 10/19/2026
+
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "FirstOrderLBFGS.h"
+
+#include <core/basics/Log.h>
+#include "core/basics/Exception.h"
+#include "core/basics/numerictools.h"
+#include "core/basics/Profiler.h"
+#include "core/vector/SimdKernels.h"
+
+using namespace std;
+using namespace NICE;
+
+namespace {
+
+/** minimizer of the cubic interpolating f and f' at u and v */
+double cubicMinimizer ( double u, double fu, double du, double v, double fv, double dv )
+{
+  const double d = v - u;
+  const double theta = ( fu - fv ) * 3.0 / d + du + dv;
+  const double s = std::max ( fabs(theta), std::max ( fabs(du), fabs(dv) ) );
+  const double a = theta / s;
+  double gamma = s * sqrt ( std::max ( 0.0, a * a - ( du / s ) * ( dv / s ) ) );
+  if ( v < u )
+    gamma = -gamma;
+  const double p = gamma - du + theta;
+  const double q = gamma - du + gamma + dv;
+  return u + p / q * d;
+}
+
+/** as cubicMinimizer(), but the minimizer may lie outside of [u,v], clipped to [tmin,tmax] */
+double cubicMinimizer2 ( double u, double fu, double du, double v, double fv, double dv,
+                         double tmin, double tmax )
+{
+  const double d = v - u;
+  const double theta = ( fu - fv ) * 3.0 / d + du + dv;
+  const double s = std::max ( fabs(theta), std::max ( fabs(du), fabs(dv) ) );
+  const double a = theta / s;
+  double gamma = s * sqrt ( std::max ( 0.0, a * a - ( du / s ) * ( dv / s ) ) );
+  if ( u < v )
+    gamma = -gamma;
+  const double p = gamma - dv + theta;
+  const double q = gamma - dv + gamma + du;
+  const double r = p / q;
+  if ( r < 0.0 && gamma != 0.0 )
+    return v - r * d;
+  else if ( a < 0.0 )
+    return tmax;
+  else
+    return tmin;
+}
+
+/** minimizer of the quadratic interpolating f(u), f'(u) and f(v) */
+double quadraticMinimizer ( double u, double fu, double du, double v, double fv )
+{
+  const double a = v - u;
+  return u + du / ( ( fu - fv ) / a + du ) / 2.0 * a;
+}
+
+/** minimizer of the quadratic interpolating f'(u) and f'(v) */
+double quadraticMinimizer2 ( double u, double du, double v, double dv )
+{
+  const double a = u - v;
+  return v + dv / ( dv - du ) * a;
+}
+
+/**
+ * Safeguarded step of More and Thuente (dcstep of MINPACK-2): updates the
+ * interval of uncertainty [x,y] with the trial t and computes the next trial.
+ * @return false if the arguments are inconsistent (rounding errors)
+ */
+bool updateInterval ( double & x, double & fx, double & dx,
+                      double & y, double & fy, double & dy,
+                      double & t, double ft, double dt,
+                      double tmin, double tmax, bool & brackt )
+{
+  const bool dsign = dt * ( dx / fabs(dx) ) < 0.0;
+  bool bound;
+  double newt;
+
+  if ( brackt )
+  {
+    if ( t <= std::min ( x, y ) || std::max ( x, y ) <= t )
+      return false;
+    if ( 0.0 <= dx * ( t - x ) )
+      return false;
+    if ( tmax < tmin )
+      return false;
+  }
+
+  if ( fx < ft )
+  {
+    // higher function value: the minimum is bracketed
+    brackt = true;
+    bound = true;
+    const double mc = cubicMinimizer ( x, fx, dx, t, ft, dt );
+    const double mq = quadraticMinimizer ( x, fx, dx, t, ft );
+    if ( fabs ( mc - x ) < fabs ( mq - x ) )
+      newt = mc;
+    else
+      newt = mc + 0.5 * ( mq - mc );
+  } else if ( dsign ) {
+    // lower function value, derivatives of opposite sign: bracketed
+    brackt = true;
+    bound = false;
+    const double mc = cubicMinimizer ( x, fx, dx, t, ft, dt );
+    const double mq = quadraticMinimizer2 ( x, dx, t, dt );
+    newt = ( fabs ( mc - t ) > fabs ( mq - t ) ) ? mc : mq;
+  } else if ( fabs ( dt ) < fabs ( dx ) ) {
+    // lower function value, same signs, the derivative decreases
+    bound = true;
+    const double mc = cubicMinimizer2 ( x, fx, dx, t, ft, dt, tmin, tmax );
+    const double mq = quadraticMinimizer2 ( x, dx, t, dt );
+    if ( brackt )
+      newt = ( fabs ( t - mc ) < fabs ( t - mq ) ) ? mc : mq;
+    else
+      newt = ( fabs ( t - mc ) > fabs ( t - mq ) ) ? mc : mq;
+  } else {
+    // lower function value, same signs, the derivative does not decrease
+    bound = false;
+    if ( brackt )
+      newt = cubicMinimizer ( t, ft, dt, y, fy, dy );
+    else if ( x < t )
+      newt = tmax;
+    else
+      newt = tmin;
+  }
+
+  if ( fx < ft )
+  {
+    y = t; fy = ft; dy = dt;
+  } else {
+    if ( dsign )
+    {
+      y = x; fy = fx; dy = dx;
+    }
+    x = t; fx = ft; dx = dt;
+  }
+
+  newt = std::min ( newt, tmax );
+  newt = std::max ( newt, tmin );
+
+  // stay away from the far end of the interval
+  if ( brackt && bound )
+  {
+    const double mq = x + 0.66 * ( y - x );
+    if ( x < y )
+      newt = std::min ( newt, mq );
+    else
+      newt = std::max ( newt, mq );
+  }
+
+  t = newt;
+  return true;
+}
+
+}
+
+FirstOrderLBFGS::FirstOrderLBFGS( uint memory, bool _verbose )
+	: verbose(_verbose)
+{
+	setMemory ( memory );
+	epsilonG = 1e-5;
+	epsilonF = 1e-12;
+	maxIterations = 1000;
+	ftol = 1e-4;
+	gtol = 0.9;
+	maxLineSearch = 40;
+	m_numIterations = 0;
+	m_numEvaluations = 0;
+	m_numPairs = 0;
+	m_newest = 0;
+	m_gamma = 1.0;
+}
+
+FirstOrderLBFGS::~FirstOrderLBFGS()
+{
+}
+
+void FirstOrderLBFGS::setMemory ( uint memory )
+{
+	if ( memory < 1 )
+		fthrow ( Exception, "FirstOrderLBFGS: the memory has to be at least 1" );
+	m_memory = memory;
+}
+
+void FirstOrderLBFGS::setWolfeParameters ( double _ftol, double _gtol )
+{
+	if ( !( 0.0 < _ftol && _ftol < _gtol && _gtol < 1.0 ) )
+		fthrow ( Exception, "FirstOrderLBFGS: 0 < ftol < gtol < 1 is required" );
+	ftol = _ftol;
+	gtol = _gtol;
+}
+
+void FirstOrderLBFGS::setBounds ( const Vector & lower, const Vector & upper )
+{
+	if ( lower.size() != upper.size() )
+		fthrow ( Exception, "FirstOrderLBFGS: the bounds have different sizes" );
+	for ( uint i = 0 ; i < lower.size() ; i++ )
+		if ( !( lower[i] <= upper[i] ) )
+			fthrow ( Exception, "FirstOrderLBFGS: lower bound " << i << " is greater than the upper bound" );
+	m_lower = lower;
+	m_upper = upper;
+}
+
+void FirstOrderLBFGS::clearBounds ()
+{
+	m_lower.resize(0);
+	m_upper.resize(0);
+}
+
+void FirstOrderLBFGS::allocate ( uint n )
+{
+	// kept between optimizations of problems of the same size
+	m_s.resize ( m_memory );
+	m_y.resize ( m_memory );
+	for ( uint i = 0 ; i < m_memory ; i++ )
+	{
+		m_s[i].resize ( n );
+		m_y[i].resize ( n );
+	}
+	m_rho.resize ( m_memory );
+	m_alpha.resize ( m_memory );
+	m_x.resize ( n );
+	m_g.resize ( n );
+	m_d.resize ( n );
+	m_step.resize ( n );
+	m_yNew.resize ( n );
+	m_numPairs = 0;
+	m_newest = m_memory - 1;
+	m_gamma = 1.0;
+}
+
+double FirstOrderLBFGS::freeGradient ()
+{
+	const uint n = m_g.size();
+	m_d = m_g;
+	if ( m_lower.size() > 0 )
+	{
+		for ( uint i = 0 ; i < n ; i++ )
+			if ( ( m_x[i] <= m_lower[i] && m_g[i] > 0.0 ) || ( m_x[i] >= m_upper[i] && m_g[i] < 0.0 ) )
+				m_d[i] = 0.0;
+	}
+	return SimdKernels::sumSquares ( m_d.getDataPointer(), n );
+}
+
+double FirstOrderLBFGS::direction ()
+{
+	const int n = m_d.size();
+	double *q = m_d.getDataPointer();
+
+	// two-loop recursion on the free gradient, newest pair first
+	for ( uint j = 0 ; j < m_numPairs ; j++ )
+	{
+		const uint i = ( m_newest + m_memory - j ) % m_memory;
+		m_alpha[i] = m_rho[i] * SimdKernels::dot ( m_s[i].getDataPointer(), q, n );
+		SimdKernels::addProductC ( m_y[i].getDataPointer(), -m_alpha[i], q, n );
+	}
+	SimdKernels::mulC ( q, -m_gamma, q, n );
+	// with negated signs, the result is the descent direction
+	for ( uint j = m_numPairs ; j > 0 ; j-- )
+	{
+		const uint i = ( m_newest + m_memory - j + 1 ) % m_memory;
+		const double beta = m_rho[i] * SimdKernels::dot ( m_y[i].getDataPointer(), q, n );
+		SimdKernels::addProductC ( m_s[i].getDataPointer(), - m_alpha[i] - beta, q, n );
+	}
+
+	if ( m_lower.size() > 0 )
+	{
+		// fixed variables and free variables at a bound moving outwards
+		for ( int i = 0 ; i < n ; i++ )
+			if ( ( m_x[i] <= m_lower[i] && ( m_g[i] > 0.0 || q[i] < 0.0 ) )
+			     || ( m_x[i] >= m_upper[i] && ( m_g[i] < 0.0 || q[i] > 0.0 ) ) )
+				q[i] = 0.0;
+	}
+
+	return SimdKernels::dot ( m_g.getDataPointer(), q, n );
+}
+
+double FirstOrderLBFGS::maxStep () const
+{
+	double stpmax = std::numeric_limits<double>::max();
+	if ( m_lower.size() == 0 )
+		return stpmax;
+	for ( uint i = 0 ; i < m_d.size() ; i++ )
+	{
+		if ( m_d[i] < 0.0 )
+			stpmax = std::min ( stpmax, ( m_lower[i] - m_x[i] ) / m_d[i] );
+		else if ( m_d[i] > 0.0 )
+			stpmax = std::min ( stpmax, ( m_upper[i] - m_x[i] ) / m_d[i] );
+	}
+	return stpmax;
+}
+
+void FirstOrderLBFGS::computeStep ( double stp )
+{
+	const uint n = m_d.size();
+	SimdKernels::mulC ( m_d.getDataPointer(), stp, m_step.getDataPointer(), n );
+	if ( m_lower.size() > 0 )
+	{
+		// only corrects rounding errors, as stp is at most maxStep()
+		for ( uint i = 0 ; i < n ; i++ )
+		{
+			const double xi = std::min ( std::max ( m_x[i] + m_step[i], m_lower[i] ), m_upper[i] );
+			m_step[i] = xi - m_x[i];
+		}
+	}
+}
+
+bool FirstOrderLBFGS::lineSearch ( OptimizationProblemFirst& problem, double & f, double dginit,
+                                   double stp, double stpmax )
+{
+	const double stpmin = 1e-20;
+	const double xtol = 1e-16;
+	const double finit = f;
+	const double dgtest = ftol * dginit;
+	const int n = m_d.size();
+
+	bool brackt = false;
+	bool stage1 = true;
+	bool consistent = true;
+	bool applied = false;
+	double width = stpmax - stpmin;
+	double prevWidth = 2.0 * width;
+	double stx = 0.0, fx = finit, dgx = dginit;
+	double sty = 0.0, fy = finit, dgy = dginit;
+	double stmin, stmax;
+	double dg = 0.0, ftest1 = finit;
+
+	for ( uint count = 0 ; ; )
+	{
+		if ( brackt )
+		{
+			stmin = std::min ( stx, sty );
+			stmax = std::max ( stx, sty );
+		} else {
+			stmin = stx;
+			stmax = stp + 4.0 * ( stp - stx );
+		}
+
+		stp = std::max ( stp, stpmin );
+		stp = std::min ( stp, stpmax );
+
+		// no progress possible: evaluate the best point so far
+		if ( brackt && ( stp <= stmin || stmax <= stp || maxLineSearch <= count + 1
+		                 || !consistent || stmax - stmin <= xtol * stmax ) )
+			stp = stx;
+
+		if ( applied )
+			problem.unapplyStep ( m_step );
+		computeStep ( stp );
+		problem.applyStep ( m_step );
+		applied = true;
+
+		f = problem.computeObjectiveAndGradient();
+		dg = SimdKernels::dot ( problem.gradientCached().getDataPointer(), m_d.getDataPointer(), n );
+		ftest1 = finit + stp * dgtest;
+		count++;
+		m_numEvaluations++;
+
+		if ( !isFinite ( f ) || !isFinite ( dg ) )
+		{
+			// outside of the domain of the objective: shorten the step
+			if ( maxLineSearch <= count || stp <= stpmin )
+				break;
+			stpmax = stp;
+			stp = stx + 0.5 * ( stp - stx );
+			continue;
+		}
+
+		if ( brackt && ( stp <= stmin || stmax <= stp || !consistent ) )
+			break;
+		if ( stp == stpmax && f <= ftest1 && dg <= dgtest )
+			return true;
+		if ( stp == stpmin && ( ftest1 < f || dgtest <= dg ) )
+			break;
+		if ( brackt && stmax - stmin <= xtol * stmax )
+			break;
+		if ( maxLineSearch <= count )
+			break;
+		// strong Wolfe conditions
+		if ( f <= ftest1 && fabs ( dg ) <= gtol * ( -dginit ) )
+			return true;
+
+		if ( stage1 && f <= ftest1 && std::min ( ftol, gtol ) * dginit <= dg )
+			stage1 = false;
+
+		if ( stage1 && ftest1 < f && f <= fx )
+		{
+			// modified function psi(stp) = f(stp) - f(0) - stp * dgtest
+			double fm = f - stp * dgtest;
+			double fxm = fx - stx * dgtest;
+			double fym = fy - sty * dgtest;
+			double dgm = dg - dgtest;
+			double dgxm = dgx - dgtest;
+			double dgym = dgy - dgtest;
+			consistent = updateInterval ( stx, fxm, dgxm, sty, fym, dgym, stp, fm, dgm, stmin, stmax, brackt );
+			fx = fxm + stx * dgtest;
+			fy = fym + sty * dgtest;
+			dgx = dgxm + dgtest;
+			dgy = dgym + dgtest;
+		} else {
+			consistent = updateInterval ( stx, fx, dgx, sty, fy, dgy, stp, f, dg, stmin, stmax, brackt );
+		}
+
+		if ( brackt )
+		{
+			if ( 0.66 * prevWidth <= fabs ( sty - stx ) )
+				stp = stx + 0.5 * ( sty - stx );
+			prevWidth = width;
+			width = fabs ( sty - stx );
+		}
+	}
+
+	// the line search failed, keep the last point if it decreases the objective sufficiently
+	if ( isFinite ( f ) && f <= ftest1 && f < finit )
+		return true;
+
+	problem.unapplyStep ( m_step );
+	f = finit;
+	return false;
+}
+
+void FirstOrderLBFGS::doOptimizeFirst(OptimizationProblemFirst& problem)
+{
+	NICE_PROFILE_ZONE ( "FirstOrderLBFGS::doOptimizeFirst" );
+
+	const uint n = problem.dimension();
+	const bool bounded = ( m_lower.size() > 0 );
+	if ( bounded && m_lower.size() != n )
+		fthrow ( Exception, "FirstOrderLBFGS: the bounds have size " << m_lower.size()
+		         << ", the problem has dimension " << n );
+
+	allocate ( n );
+	m_numIterations = 0;
+	m_numEvaluations = 0;
+
+	if ( bounded )
+	{
+		// start at a feasible point
+		m_x = problem.position();
+		bool feasible = true;
+		for ( uint i = 0 ; i < n ; i++ )
+		{
+			const double xi = std::min ( std::max ( m_x[i], m_lower[i] ), m_upper[i] );
+			m_step[i] = xi - m_x[i];
+			if ( xi != m_x[i] )
+				feasible = false;
+		}
+		if ( !feasible )
+			problem.applyStep ( m_step );
+	}
+
+	double f = problem.computeObjectiveAndGradient();
+	m_g = problem.gradientCached();
+	m_numEvaluations++;
+
+	if ( verbose )
+		NICE_LOG_DEBUG ( "FirstOrderLBFGS: initial value of the objective function is " << f );
+
+	while ( m_numIterations < maxIterations )
+	{
+		m_x = problem.position();
+
+		const double gnorm = sqrt ( freeGradient() );
+		if ( gnorm < epsilonG )
+		{
+			if ( verbose )
+				NICE_LOG_DEBUG ( "FirstOrderLBFGS: gradient norm " << gnorm << " below threshold" );
+			break;
+		}
+
+		double dginit = direction();
+		if ( !( dginit < 0.0 ) )
+		{
+			// no descent direction: restart with steepest descent
+			m_numPairs = 0;
+			m_gamma = 1.0;
+			freeGradient();
+			dginit = direction();
+			if ( !( dginit < 0.0 ) )
+				break;
+		}
+
+		const double stpmax = maxStep();
+		double stp = 1.0;
+		if ( m_numPairs == 0 )
+			stp = std::min ( 1.0, 1.0 / sqrt ( SimdKernels::sumSquares ( m_d.getDataPointer(), n ) ) );
+		stp = std::min ( stp, stpmax );
+
+		const double fOld = f;
+		if ( !lineSearch ( problem, f, dginit, stp, stpmax ) )
+		{
+			if ( m_numPairs == 0 )
+			{
+				if ( verbose )
+					NICE_LOG_DEBUG ( "FirstOrderLBFGS: line search failed" );
+				break;
+			}
+			// the quasi-Newton direction failed, discard the memory
+			m_numPairs = 0;
+			m_gamma = 1.0;
+			continue;
+		}
+		m_numIterations++;
+
+		// new correction pair (s in m_step, y in m_yNew), skipped if the curvature
+		// condition is violated; with a full memory, slot k holds the oldest pair,
+		// which is only replaced if the new pair is accepted
+		const Vector & g = problem.gradientCached();
+		SimdKernels::sub ( g.getDataPointer(), m_g.getDataPointer(), m_yNew.getDataPointer(), n );
+		const double sy = SimdKernels::dot ( m_step.getDataPointer(), m_yNew.getDataPointer(), n );
+		const double yy = SimdKernels::sumSquares ( m_yNew.getDataPointer(), n );
+		if ( sy > std::numeric_limits<double>::epsilon() * yy )
+		{
+			const uint k = ( m_newest + 1 ) % m_memory;
+			// m_step is recomputed by the next line search
+			m_s[k].swap ( m_step );
+			m_y[k].swap ( m_yNew );
+			m_rho[k] = 1.0 / sy;
+			m_gamma = sy / yy;
+			m_newest = k;
+			m_numPairs = std::min ( m_numPairs + 1, m_memory );
+		}
+		m_g = g;
+
+		if ( verbose )
+			NICE_LOG_DEBUG ( "FirstOrderLBFGS: iteration " << m_numIterations << " objective function = " << f );
+
+		if ( fOld - f <= epsilonF * std::max ( std::max ( fabs ( fOld ), fabs ( f ) ), 1.0 ) )
+		{
+			if ( verbose )
+				NICE_LOG_DEBUG ( "FirstOrderLBFGS: relative decrease below threshold" );
+			break;
+		}
+	}
+}
@@ -0,0 +1,162 @@
+/**
+* @file FirstOrderLBFGS.h
+* @brief limited memory BFGS with More-Thuente line search and optional box constraints
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_FIRSTORDERLBFGSINCLUDE
+#define _NICE_FIRSTORDERLBFGSINCLUDE
+
+#include <vector>
+
+#include "core/optimization/gradientBased/OptimizationAlgorithmFirst.h"
+#include "core/optimization/gradientBased/OptimizationProblemFirst.h"
+
+namespace NICE {
+
+/** @class FirstOrderLBFGS
+ * Limited memory BFGS (Nocedal 1980, Liu and Nocedal 1989) for large
+ * problems (10^5 - 10^6 parameters).
+ *
+ * The inverse Hessian is represented by the last m pairs of position and
+ * gradient differences, the search direction is computed with the two-loop
+ * recursion. The memory is O(m n); all vectors are allocated once per
+ * optimization, the iterations do not allocate. Dot products and updates
+ * use the vectorized kernels of \c SimdKernels.
+ *
+ * The step length is computed with the line search of More and Thuente
+ * (1994), which finds a point satisfying the strong Wolfe conditions
+ * with safeguarded cubic and quadratic interpolation.
+ *
+ * Optional box constraints lower <= x <= upper are handled with projected
+ * steps similar to L-BFGS-B: variables at a bound whose gradient points
+ * outwards are fixed, the direction is restricted to the free variables
+ * and the line search stops at the first bound along the direction.
+ * (The generalized Cauchy point and the subspace minimization of L-BFGS-B
+ * are not computed.)
+ *
+ * The optimization stops if the L2 norm of the (projected) gradient is
+ * lower than epsilonG, if the relative decrease of the objective is lower
+ * than epsilonF, or after the maximum number of iterations.
+ *
+ * \ingroup optimization_algorithms
+ */
+class FirstOrderLBFGS : public NICE::OptimizationAlgorithmFirst
+{
+
+    protected:
+
+		/** number of stored correction pairs */
+		uint m_memory;
+
+		/** Abort optimization if gradient norm (L2) is lower than this threshold */
+		double epsilonG;
+
+		/** Abort optimization if the relative decrease of the objective is lower than this threshold */
+		double epsilonF;
+
+		/** maximum number of iterations */
+		uint maxIterations;
+
+		/** parameters of the sufficient decrease and the curvature condition */
+		double ftol;
+		double gtol;
+
+		/** maximum number of function evaluations per line search */
+		uint maxLineSearch;
+
+		/** box constraints (empty: unconstrained) */
+		Vector m_lower;
+		Vector m_upper;
+
+		/** print debug information */
+		bool verbose;
+
+		/** statistics of the last optimization */
+		uint m_numIterations;
+		uint m_numEvaluations;
+
+		/** optimization algorithm */
+		void doOptimizeFirst(NICE::OptimizationProblemFirst& problem);
+
+    private:
+
+		/** ring buffer of the correction pairs s_k = x_k+1 - x_k, y_k = g_k+1 - g_k */
+		std::vector<Vector> m_s;
+		std::vector<Vector> m_y;
+		std::vector<double> m_rho;
+		std::vector<double> m_alpha;
+		uint m_numPairs;
+		uint m_newest;
+		/** scaling s'y / y'y of the initial inverse Hessian */
+		double m_gamma;
+
+		/** workspace: position at the start of the line search, gradient, direction, step
+		 * and gradient difference of a new correction pair */
+		Vector m_x;
+		Vector m_g;
+		Vector m_d;
+		Vector m_step;
+		Vector m_yNew;
+
+		/** allocate the workspace for n parameters */
+		void allocate ( uint n );
+
+		/** gradient restricted to the free variables (in m_d), returns its squared norm */
+		double freeGradient ();
+
+		/** search direction in m_d, returns the directional derivative */
+		double direction ();
+
+		/** largest step along m_d within the bounds */
+		double maxStep () const;
+
+		/** step stp * m_d in m_step (projected onto the bounds) */
+		void computeStep ( double stp );
+
+		/** line search along m_d, the problem is at the accepted point afterwards */
+		bool lineSearch ( NICE::OptimizationProblemFirst& problem, double & f, double dginit,
+		                  double stp, double stpmax );
+
+    public:
+
+		/** simple constructor
+		 * @param memory number of correction pairs (3 - 20 is typical)
+		 */
+		FirstOrderLBFGS( uint memory = 10, bool verbose = false );
+
+		/** simple destructor */
+		virtual ~FirstOrderLBFGS();
+
+		/** number of stored correction pairs */
+		void setMemory ( uint memory );
+
+		/** abort optimization if gradient norm (L2) is lower than this threshold */
+		void setEpsilonG ( double _epsilonG ) { epsilonG = _epsilonG; };
+
+		/** abort optimization if the relative decrease of the objective is lower than this threshold */
+		void setEpsilonF ( double _epsilonF ) { epsilonF = _epsilonF; };
+
+		/** maximum number of iterations */
+		void setMaxIterations ( uint _maxIterations ) { maxIterations = _maxIterations; };
+
+		/** parameters of the Wolfe conditions, 0 < ftol < gtol < 1 */
+		void setWolfeParameters ( double _ftol, double _gtol );
+
+		/** box constraints, use +-infinity for unbounded parameters */
+		void setBounds ( const Vector & lower, const Vector & upper );
+
+		/** remove the box constraints */
+		void clearBounds ();
+
+		/** number of iterations of the last optimization */
+		uint getNumIterations () const { return m_numIterations; };
+
+		/** number of evaluations of objective and gradient of the last optimization */
+		uint getNumEvaluations () const { return m_numEvaluations; };
+
+};
+
+}
+
+#endif
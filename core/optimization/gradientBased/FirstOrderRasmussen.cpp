@@ -10,6 +10,7 @@
 #include "FirstOrderRasmussen.h"
 
 #include <core/basics/Log.h>
+#include "core/basics/Profiler.h"
 
 using namespace std;
 using namespace NICE;
@@ -45,6 +46,7 @@ FirstOrderRasmussen::~FirstOrderRasmussen()
 
 void FirstOrderRasmussen::doOptimizeFirst(OptimizationProblemFirst& problem)
 {
+	NICE_PROFILE_ZONE ( "FirstOrderRasmussen::doOptimizeFirst" );
 	/** Comments of Carl Edward Rasmussen (2006-09-08).
 	 *
 	 * The code falls naturally into 3 parts, after the initial line search is
@@ -72,10 +74,9 @@ void FirstOrderRasmussen::doOptimizeFirst(OptimizationProblemFirst& problem)
 	bool ls_failed = false;
 	double f0 = problem.objective();
   if ( verbose )
-    cerr << "FirstOrderRasmussen: initial value of the objective function is " << f0 << endl;
+    NICE_LOG_DEBUG ( "FirstOrderRasmussen: initial value of the objective function is " << f0 );
 
-	problem.computeGradient();
-	Vector df0 = problem.gradientCached();
+	Vector df0 = problem.gradientCurrent();
 
 	if ( length < 0 ) i++;
 
@@ -95,11 +96,13 @@ void FirstOrderRasmussen::doOptimizeFirst(OptimizationProblemFirst& problem)
 	Vector dF0 (df0.size());
 	double F0;
 	Vector X0delta ( problem.position().size());
+	// current step x3*s, updated in place instead of temporaries
+	Vector step ( df0.size() );
 	
 	while ( i < (uint)abs(length) )
 	{
 		if ( verbose )
-			std::cerr << "Iteration " << i << " / " << abs(length) << " " << " objective function = " << f0 << std::endl;
+			NICE_LOG_DEBUG ( "Iteration " << i << " / " << abs(length) << " " << " objective function = " << f0 );
 		i = i + (length>0);
 
 		if ( df0.normL2() < epsilonG ) {
@@ -131,24 +134,26 @@ void FirstOrderRasmussen::doOptimizeFirst(OptimizationProblemFirst& problem)
 			{
 				M = M -1; i = i + (length<0);
 
-				problem.applyStep ( x3*s );
+				step = s;
+				step *= x3;
+				problem.applyStep ( step );
 				f3 = problem.objective();
 				if ( NICE::isFinite(f3) ) success = true;
 				
 				if ( !success && (M>0) ) 
-					problem.unapplyStep ( x3*s );
+					problem.unapplyStep ( step );
 
 				if ( !NICE::isFinite(f3) )
         {
 					x3 = (x2 + x3) / 2.0;
         }
 			}
-			problem.computeGradient();
+			problem.computeObjectiveAndGradient();
 			df3 = problem.gradientCached();
-			problem.unapplyStep ( x3 * s );
+			problem.unapplyStep ( step );
 
 			if ( f3 < F0 ) {
-				X0delta = x3 * s;
+				X0delta = step;
 				F0 = f3;
 				dF0 = df3;
 			}
@@ -200,14 +205,15 @@ void FirstOrderRasmussen::doOptimizeFirst(OptimizationProblemFirst& problem)
       }
 
 			x3 = std::max(std::min(x3, x4-c_int*(x4-x2)),x2+c_int*(x4-x2));
-			problem.applyStep ( x3*s );
-			f3 = problem.objective();
-			problem.computeGradient();
+			step = s;
+			step *= x3;
+			problem.applyStep ( step );
+			f3 = problem.computeObjectiveAndGradient();
 			df3 = problem.gradientCached();
-			problem.unapplyStep ( x3*s );
+			problem.unapplyStep ( step );
 
 			if ( f3 < F0 ) {
-				X0delta = x3 * s;
+				X0delta = step;
 				F0 = f3;
 				dF0 = df3;
 			}
@@ -218,17 +224,20 @@ void FirstOrderRasmussen::doOptimizeFirst(OptimizationProblemFirst& problem)
 
 		if ( (abs(d3) < - c_sig * d0) && (f3 < f0 + x3 * c_rho * d0) )
 		{
-			problem.applyStep ( x3 * s );
+			step = s;
+			step *= x3;
+			problem.applyStep ( step );
       if ( verbose )
-        cerr << "FirstOrderRasmussen: new objective value " << f3 << endl;
+        NICE_LOG_DEBUG ( "FirstOrderRasmussen: new objective value " << f3 );
 
 
 			f0 = f3;
-			s = ( df3.scalarProduct(df3) - df0.scalarProduct(df3))/(df0.scalarProduct(df0)) * s - df3;
+			s *= ( df3.scalarProduct(df3) - df0.scalarProduct(df3))/(df0.scalarProduct(df0));
+			s -= df3;
 			df0 = df3;
 			d3 = d0; d0 = df0.scalarProduct(s);
 			if ( d0 > 0 ) {
-				s = -1.0 * df0; d0 = - s.scalarProduct(s);
+				s = df0; s *= -1.0; d0 = - s.scalarProduct(s);
 			}
 
 			x3 = x3 * std::min(c_ratio, d3/(d0-std::numeric_limits<float>::min()) );
@@ -242,12 +251,13 @@ void FirstOrderRasmussen::doOptimizeFirst(OptimizationProblemFirst& problem)
 			if ( ls_failed || (i > (uint)abs(length) ) )
 			{
         if ( (i > (uint)abs(length)) && verbose )
-          cerr << "FirstOrderRasmussen: maximum number of iterations reached" << endl;
+          NICE_LOG_DEBUG ( "FirstOrderRasmussen: maximum number of iterations reached" );
         else if ( verbose )
-          cerr << "FirstOrderRasmussen: line search failed twice" << endl;
+          NICE_LOG_ERROR ( "FirstOrderRasmussen: line search failed twice" );
 				break;
 			}
-			s = - 1.0 * df0;
+			s = df0;
+			s *= -1.0;
 			d0 = - s.scalarProduct(s);
 			x3 = 1.0/(1.0 - d0);
 			ls_failed = true;
@@ -0,0 +1,62 @@
+/**
+* @file FirstOrderSGD.cpp
+* @brief stochastic gradient descent with momentum or Nesterov momentum
+* @date 10/19/2026
+
+*/
+#include "FirstOrderSGD.h"
+
+#include "core/basics/Exception.h"
+#include "core/basics/tools.h"
+
+using namespace std;
+using namespace NICE;
+
+FirstOrderSGD::FirstOrderSGD( double _learningRate, double _momentum, bool _nesterov, bool _verbose )
+	: FirstOrderStochastic ( _learningRate, _verbose ), weightDecay(0.0)
+{
+	setLearningRate ( _learningRate );
+	setMomentum ( _momentum, _nesterov );
+}
+
+FirstOrderSGD::~FirstOrderSGD()
+{
+}
+
+void FirstOrderSGD::setMomentum ( double _momentum, bool _nesterov )
+{
+	if ( _momentum < 0.0 || _momentum >= 1.0 )
+		fthrow ( Exception, "FirstOrderSGD: the momentum " << _momentum << " is not in [0,1)" );
+	momentum = _momentum;
+	nesterov = _nesterov;
+}
+
+void FirstOrderSGD::setWeightDecay ( double _weightDecay )
+{
+	if ( _weightDecay < 0.0 )
+		fthrow ( Exception, "FirstOrderSGD: negative weight decay " << _weightDecay );
+	weightDecay = _weightDecay;
+}
+
+void FirstOrderSGD::resetState ( uint n )
+{
+	m_velocity.resize ( n );
+	m_velocity.set ( 0.0 );
+}
+
+void FirstOrderSGD::computeStep ( const Vector & gradient, const Vector & position,
+                                  double stepSize, uint t, Vector & step )
+{
+	UNUSED_PARAMETER ( t );
+	const uint n = gradient.size();
+	const double *g = gradient.getDataPointer();
+	const double *x = position.getDataPointer();
+	double *v = m_velocity.getDataPointer();
+	double *s = step.getDataPointer();
+	for ( uint i = 0 ; i < n ; i++ )
+	{
+		const double gi = g[i] + weightDecay * x[i];
+		v[i] = momentum * v[i] + gi;
+		s[i] = -stepSize * ( nesterov ? gi + momentum * v[i] : v[i] );
+	}
+}
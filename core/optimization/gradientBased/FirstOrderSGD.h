@@ -0,0 +1,72 @@
+/**
+* @file FirstOrderSGD.h
+* @brief stochastic gradient descent with momentum or Nesterov momentum
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_FIRSTORDERSGDINCLUDE
+#define _NICE_FIRSTORDERSGDINCLUDE
+
+#include "core/optimization/gradientBased/FirstOrderStochastic.h"
+
+namespace NICE {
+
+/** @class FirstOrderSGD
+ * Minibatch stochastic gradient descent with momentum (heavy ball) or
+ * Nesterov momentum, in the formulation of Sutskever et al. (2013):
+ *   g = gradient + weightDecay * x
+ *   v = momentum * v + g
+ *   x = x - stepSize * v                      (momentum)
+ *   x = x - stepSize * (g + momentum * v)     (Nesterov)
+ * See \c FirstOrderStochastic for the minibatches and the step size.
+ *
+ * \ingroup optimization_algorithms
+ */
+class FirstOrderSGD : public NICE::FirstOrderStochastic
+{
+
+    protected:
+
+		/** momentum in [0,1) */
+		double momentum;
+
+		/** Nesterov momentum instead of the heavy ball */
+		bool nesterov;
+
+		/** L2 regularization, added to the gradient */
+		double weightDecay;
+
+		void resetState ( uint n );
+
+		void computeStep ( const Vector & gradient, const Vector & position,
+		                   double stepSize, uint t, Vector & step );
+
+    private:
+
+		/** velocity */
+		Vector m_velocity;
+
+    public:
+
+		/** simple constructor
+		 * @param learningRate step size
+		 * @param momentum momentum in [0,1), 0: plain SGD
+		 * @param nesterov Nesterov momentum
+		 */
+		FirstOrderSGD( double learningRate = 0.01, double momentum = 0.9,
+		               bool nesterov = false, bool verbose = false );
+
+		/** simple destructor */
+		virtual ~FirstOrderSGD();
+
+		/** momentum in [0,1) and its type */
+		void setMomentum ( double momentum, bool nesterov = false );
+
+		/** L2 regularization weightDecay * |x|^2 / 2 (default: 0) */
+		void setWeightDecay ( double weightDecay );
+
+};
+
+}
+
+#endif
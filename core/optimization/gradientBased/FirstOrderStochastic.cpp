@@ -0,0 +1,120 @@
+/**
+* @file FirstOrderStochastic.cpp
+* @brief base class of the minibatch gradient methods (SGD, Adam)
+* @date 10/19/2026
+
+*/
+#include <algorithm>
+#include <cmath>
+
+#include "FirstOrderStochastic.h"
+
+#include <core/basics/Log.h>
+#include "core/basics/Exception.h"
+#include "core/basics/numerictools.h"
+#include "core/basics/Profiler.h"
+
+using namespace std;
+using namespace NICE;
+
+FirstOrderStochastic::FirstOrderStochastic( double _learningRate, bool _verbose )
+	: batchSize(32), maxEpochs(100), learningRate(_learningRate), learningRateDecay(0.0),
+	  epsilonF(0.0), shuffle(true), fixedSeed(false), seed(0), verbose(_verbose),
+	  m_numIterations(0), m_numEpochs(0), m_numSampleGradients(0.0)
+{
+}
+
+FirstOrderStochastic::~FirstOrderStochastic()
+{
+}
+
+void FirstOrderStochastic::setLearningRate ( double _learningRate, double decay )
+{
+	if ( !( _learningRate > 0.0 ) || decay < 0.0 )
+		fthrow ( Exception, "FirstOrderStochastic: invalid learning rate " << _learningRate
+		         << " or decay " << decay );
+	learningRate = _learningRate;
+	learningRateDecay = decay;
+}
+
+void FirstOrderStochastic::doOptimizeFirst(OptimizationProblemFirst& problem)
+{
+	NICE_PROFILE_ZONE ( "FirstOrderStochastic::doOptimizeFirst" );
+
+	const uint n = problem.dimension();
+	StochasticOptimizationProblem *stochasticProblem = dynamic_cast<StochasticOptimizationProblem *> ( &problem );
+	const uint numSamples = ( stochasticProblem != NULL ) ? stochasticProblem->numSamples() : 1;
+	const uint numBatch = ( batchSize == 0 || batchSize > numSamples ) ? numSamples : batchSize;
+
+	m_numIterations = 0;
+	m_numEpochs = 0;
+	m_numSampleGradients = 0.0;
+	m_epochLosses.clear();
+
+	// workspace, allocated once per optimization
+	m_order.resize ( numSamples );
+	for ( uint i = 0 ; i < numSamples ; i++ )
+		m_order[i] = i;
+	m_gradient.resize ( n );
+	m_step.resize ( n );
+	resetState ( n );
+
+	const bool shuffled = shuffle && numBatch < numSamples;
+	if ( shuffled )
+		initRand ( fixedSeed, seed );
+
+	double previousLoss = 0.0;
+	for ( uint epoch = 0 ; epoch < maxEpochs ; epoch++ )
+	{
+		if ( shuffled )
+			for ( uint k = numSamples ; k > 1 ; k-- )
+				std::swap ( m_order[k - 1], m_order[randInt ( k )] );
+
+		double epochLoss = 0.0;
+		for ( uint begin = 0 ; begin < numSamples ; begin += numBatch )
+		{
+			const uint count = std::min ( numBatch, numSamples - begin );
+			double loss;
+			const Vector *gradient;
+			if ( stochasticProblem != NULL )
+			{
+				loss = stochasticProblem->batchObjectiveAndGradient ( &m_order[begin], count, m_gradient );
+				gradient = &m_gradient;
+			} else {
+				loss = problem.computeObjectiveAndGradient();
+				gradient = &problem.gradientCached();
+			}
+
+			if ( !isFinite ( loss ) )
+			{
+				NICE_LOG_ERROR ( "FirstOrderStochastic: the loss is not finite in iteration " << m_numIterations
+				                 << ", decrease the learning rate" );
+				return;
+			}
+
+			epochLoss += loss * count;
+			m_numSampleGradients += count;
+			m_numIterations++;
+
+			const double stepSize = learningRate / ( 1.0 + learningRateDecay * ( m_numIterations - 1 ) );
+			computeStep ( *gradient, problem.position(), stepSize, m_numIterations, m_step );
+			problem.applyStep ( m_step );
+		}
+
+		epochLoss /= numSamples;
+		m_epochLosses.push_back ( epochLoss );
+		m_numEpochs++;
+
+		if ( verbose )
+			NICE_LOG_DEBUG ( "FirstOrderStochastic: epoch " << m_numEpochs << " mean loss = " << epochLoss );
+
+		if ( epoch > 0 && epsilonF > 0.0
+		     && fabs ( previousLoss - epochLoss ) <= epsilonF * std::max ( fabs ( previousLoss ), 1.0 ) )
+		{
+			if ( verbose )
+				NICE_LOG_DEBUG ( "FirstOrderStochastic: relative change of the loss below threshold" );
+			break;
+		}
+		previousLoss = epochLoss;
+	}
+}
@@ -0,0 +1,141 @@
+/**
+* @file FirstOrderStochastic.h
+* @brief base class of the minibatch gradient methods (SGD, Adam)
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_FIRSTORDERSTOCHASTICINCLUDE
+#define _NICE_FIRSTORDERSTOCHASTICINCLUDE
+
+#include <vector>
+
+#include "core/optimization/gradientBased/OptimizationAlgorithmFirst.h"
+#include "core/optimization/gradientBased/StochasticOptimizationProblem.h"
+
+namespace NICE {
+
+/** @class FirstOrderStochastic
+ * Base class of first order methods using minibatch gradients of a
+ * \c StochasticOptimizationProblem.
+ *
+ * Every epoch visits all samples once, in minibatches of \c batchSize
+ * samples (in a random order if shuffling is active). After every
+ * minibatch, the subclass computes a step from the mean gradient of the
+ * batch and the step size
+ *   learningRate / (1 + learningRateDecay * (t - 1))
+ * of iteration t = 1, 2, ... . The data-parallel evaluation of the
+ * batches is configured in the problem
+ * (\c StochasticOptimizationProblem::setThreadSafe()).
+ *
+ * Other problems (\c OptimizationProblemFirst) are treated as a single
+ * sample, i.e., every iteration uses the full gradient.
+ *
+ * The optimization stops after \c maxEpochs epochs or if the relative
+ * change of the mean minibatch loss of an epoch is lower than epsilonF
+ * (not active by default). The mean minibatch losses of the epochs are
+ * available with \c getEpochLosses().
+ *
+ * \ingroup optimization_algorithms
+ */
+class FirstOrderStochastic : public NICE::OptimizationAlgorithmFirst
+{
+
+    protected:
+
+		/** number of samples per minibatch, 0: all samples */
+		uint batchSize;
+
+		/** maximum number of epochs */
+		uint maxEpochs;
+
+		/** step size and its decay */
+		double learningRate;
+		double learningRateDecay;
+
+		/** Abort optimization if the relative change of the epoch loss is lower than this threshold */
+		double epsilonF;
+
+		/** random order of the samples in every epoch */
+		bool shuffle;
+		bool fixedSeed;
+		uint seed;
+
+		/** print debug information */
+		bool verbose;
+
+		/** statistics of the last optimization */
+		uint m_numIterations;
+		uint m_numEpochs;
+		double m_numSampleGradients;
+		std::vector<double> m_epochLosses;
+
+		/** optimization algorithm */
+		void doOptimizeFirst(NICE::OptimizationProblemFirst& problem);
+
+		/** reset the state of the method (e.g. the momentum) for n parameters */
+		virtual void resetState ( uint n ) = 0;
+
+		/** step of iteration t (t = 1, 2, ...)
+		 * @param gradient mean gradient of the minibatch
+		 * @param position current position
+		 * @param stepSize learning rate of the iteration
+		 * @param t iteration
+		 * @param step output, has the size of the gradient
+		 */
+		virtual void computeStep ( const Vector & gradient, const Vector & position,
+		                           double stepSize, uint t, Vector & step ) = 0;
+
+    private:
+
+		/** workspace: order of the samples, step */
+		std::vector<unsigned int> m_order;
+		Vector m_gradient;
+		Vector m_step;
+
+    public:
+
+		/** simple constructor
+		 * @param learningRate initial step size
+		 */
+		FirstOrderStochastic( double learningRate, bool verbose = false );
+
+		/** simple destructor */
+		virtual ~FirstOrderStochastic();
+
+		/** number of samples per minibatch (default: 32), 0: all samples */
+		void setBatchSize ( uint _batchSize ) { batchSize = _batchSize; };
+
+		/** maximum number of epochs (default: 100) */
+		void setMaxEpochs ( uint _maxEpochs ) { maxEpochs = _maxEpochs; };
+
+		/** step size learningRate / (1 + decay * (t - 1)) of iteration t */
+		void setLearningRate ( double learningRate, double decay = 0.0 );
+
+		/** abort optimization if the relative change of the epoch loss is lower than this threshold */
+		void setEpsilonF ( double _epsilonF ) { epsilonF = _epsilonF; };
+
+		/** random order of the samples in every epoch (default: true) */
+		void setShuffle ( bool _shuffle ) { shuffle = _shuffle; };
+
+		/** seed of the random number generator (initRand()) of the sample order
+		 * @param fixedSeed false: seeded with the time (default)
+		 */
+		void setRandomSeed ( bool _fixedSeed, uint _seed = 0 ) { fixedSeed = _fixedSeed; seed = _seed; };
+
+		/** number of iterations (minibatches) of the last optimization */
+		uint getNumIterations () const { return m_numIterations; };
+
+		/** number of epochs of the last optimization */
+		uint getNumEpochs () const { return m_numEpochs; };
+
+		/** number of sample gradients of the last optimization */
+		double getNumSampleGradients () const { return m_numSampleGradients; };
+
+		/** mean minibatch loss of every epoch of the last optimization */
+		const std::vector<double> & getEpochLosses () const { return m_epochLosses; };
+
+};
+
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "core/optimization/gradientBased/FirstOrderTrustRegion.h"
 
 #include <core/basics/Log.h>
+#include "core/basics/Profiler.h"
 
 namespace NICE {
 
@@ -15,11 +16,14 @@ FirstOrderTrustRegion::~FirstOrderTrustRegion()
 }
 
 void FirstOrderTrustRegion::doOptimizeFirst(OptimizationProblemFirst& problem) {
+  NICE_PROFILE_ZONE ( "FirstOrderTrustRegion::doOptimizeFirst" );
   bool previousStepSuccessful = true;
   double previousError = problem.objective();
-  problem.computeGradient();
+  problem.gradientCurrent();
   double delta = computeInitialDelta(problem.gradientNormCached());
   double normOldPosition = 0.0;
+  // the step is updated in place in every iteration
+  Vector step(problem.dimension());
 
   if ( verbose )
      Log::debug() << "optimizeFirst(): "
@@ -32,9 +36,8 @@ void FirstOrderTrustRegion::doOptimizeFirst(OptimizationProblemFirst& problem) {
     	Log::debug() << "iteration, objective: " << iteration << ", "
                      << problem.objective() << std::endl;
 
-    if (previousStepSuccessful && iteration > 0) {
-      problem.computeGradient();
-    }
+    // computed after successful steps only, unapplyStep() restores it
+    problem.gradientCurrent();
 
     // gradient-norm stopping condition
     if (problem.gradientNormCached() < epsilonG) {
@@ -44,8 +47,12 @@ void FirstOrderTrustRegion::doOptimizeFirst(OptimizationProblemFirst& problem) {
     }
 
     // compute step
-    Vector step(problem.gradientCached());
-    step *= (-delta / problem.gradientNormCached());
+    const Vector& gradient = problem.gradientCached();
+    const double stepFactor = -delta / problem.gradientNormCached();
+    for (unsigned int i = 0; i < step.size(); i++) {
+      step[i] = stepFactor * gradient[i];
+    }
+    const double normStep = step.normL2();
 
     // minimal change stopping condition
     if (changeIsMinimal(step, problem.position())) {
@@ -58,6 +65,10 @@ void FirstOrderTrustRegion::doOptimizeFirst(OptimizationProblemFirst& problem) {
       normOldPosition = problem.position().normL2();
     }
 
+    // predicted reduction, uses the gradient before the objective is
+    // evaluated at the new position (which may also compute the gradient)
+    const double psi = gradient.scalarProduct(step);
+
     // set new position (to be verified later)
     problem.applyStep(step);
 
@@ -78,7 +89,6 @@ void FirstOrderTrustRegion::doOptimizeFirst(OptimizationProblemFirst& problem) {
 
 //Log::debug() << "newError: " << newError << std::endl;
     const double errorReduction = newError - previousError;
-    const double psi = problem.gradientCached().scalarProduct(step);
     double rho;
     if (std::fabs(psi) <= epsilonRho
         && std::fabs(errorReduction) <= epsilonRho) {
@@ -97,14 +107,14 @@ void FirstOrderTrustRegion::doOptimizeFirst(OptimizationProblemFirst& problem) {
 		  Log::debug() << iteration << " optimizeFirst(): step failed" << std::endl;
       previousStepSuccessful = false;
       problem.unapplyStep(step);
-      delta = alpha2 * step.normL2();
+      delta = alpha2 * normStep;
     } else {
 	  if ( verbose )
 		  Log::debug() << iteration << " optimizeFirst(): step accepted" << std::endl;
       previousStepSuccessful = true;
       previousError = newError;
       if (rho >= eta2) {
-        const double newDelta = alpha1 * step.normL2();
+        const double newDelta = alpha1 * normStep;
         if (newDelta > delta) {
           delta = newDelta;
         }
@@ -18,15 +18,53 @@ void OptimizationProblemFirst::computePosition(Vector& pos) {
 }
 
 void OptimizationProblemFirst::doApplyStep(const Vector& step) {
-  m_previousPosition = m_positionCache;
-  m_positionCache += step;
+  if (step.size() != m_positionCache.size()) {
+    fthrow(Exception, "doApplyStep(): the step has size " << step.size()
+           << ", the position " << m_positionCache.size());
+  }
+  // backup and update in one pass, the backup buffer is preallocated
+  m_previousPosition.resize(m_positionCache.size());
+  const double* s = step.getDataPointer();
+  double* x = m_positionCache.getDataPointer();
+  double* backup = m_previousPosition.getDataPointer();
+  for (unsigned int i = 0; i < m_positionCache.size(); i++) {
+    backup[i] = x[i];
+    x[i] += s[i];
+  }
+  m_previousPositionValid = true;
 }
 
 void OptimizationProblemFirst::doUnapplyStep(const Vector& step) {
-//   m_positionCache -= step;
+  // directly after applyStep(), the backup becomes the position, no copy needed
+  if (m_previousPositionValid) {
+    m_positionCache.swap(m_previousPosition);
+    m_previousPositionValid = false;
+  } else {
+    m_positionCache -= step;
+  }
+}
+
+double OptimizationProblemFirst::computeObjectiveAndGradient(
+                                   Vector& newGradient) {
+  // cache the objective first, computeGradient() may use objective()
+  m_objectiveCache = computeObjective();
+  m_objectiveCached = true;
+  computeGradient(newGradient);
+  return m_objectiveCache;
+}
 
-  UNUSED_PARAMETER(step);
-  m_positionCache = m_previousPosition;
+void OptimizationProblemFirst::restorePreviousCaches() {
+  m_objectiveCached = m_previousObjectiveCached;
+  m_objectiveCache = m_previousObjective;
+  if (m_previousGradientCached) {
+    if (m_gradientInPreviousBuffer) {
+      m_gradientCache.swap(m_previousGradient);
+      m_gradientInPreviousBuffer = false;
+    }
+    m_gradientCached = true;
+    m_gradientNormCached = m_previousGradientNormCached;
+    m_gradientNormCache = m_previousGradientNorm;
+  }
 }
 
 }; // namespace NICE
@@ -34,7 +34,10 @@ class OptimizationProblemFirst : private NonCopyable {
 public:
   //! Default constructor
   inline OptimizationProblemFirst(unsigned int dimension)
-      : m_gradientCache(dimension, 0), m_positionCache(dimension,0) {
+      : m_gradientWithObjective(false), m_objectiveCache(0.0),
+        m_positionCache(dimension, 0), m_gradientCache(dimension, 0),
+        m_gradientNormCache(0.0),
+        m_previousPosition(dimension, 0), m_previousGradient(dimension, 0) {
     init();
   }
 
@@ -48,6 +51,9 @@ public:
     m_positionCached = false;
     m_gradientCached = false;
     m_gradientNormCached = false;
+    m_stepApplied = false;
+    m_previousPositionValid = false;
+    m_gradientInPreviousBuffer = false;
   }
 
   /**
@@ -65,12 +71,59 @@ public:
    */
   inline double objective() {
     if (!m_objectiveCached) {
+      if (m_gradientWithObjective && !m_gradientCached) {
+        computeObjectiveAndGradient();
+      } else {
+        m_objectiveCache = computeObjective();
+        m_objectiveCached = true;
+      }
+    }
+    return m_objectiveCache;
+  }
+
+  /**
+   * Get the value of the objective function and make sure that
+   * \c gradientCached() is the gradient at the current position.
+   * Only the parts which are out of date are computed. If both are,
+   * they are computed together by \c computeObjectiveAndGradient(Vector&),
+   * which saves the duplicate forward pass of problems sharing
+   * intermediate results between objective and gradient.
+   * @return value of the objective function
+   */
+  inline double computeObjectiveAndGradient() {
+    if (m_objectiveCached) {
+      if (!m_gradientCached) {
+        computeGradient();
+      }
+    } else if (m_gradientCached) {
       m_objectiveCache = computeObjective();
       m_objectiveCached = true;
+    } else {
+      beginGradientUpdate();
+      m_objectiveCache = computeObjectiveAndGradient(m_gradientCache);
+      m_objectiveCached = true;
+      m_gradientCached = true;
     }
     return m_objectiveCache;
   }
 
+  /**
+   * Compute the gradient together with every evaluation of the objective
+   * function, i.e. \c objective() calls \c computeObjectiveAndGradient().
+   * Worthwhile if \c computeObjectiveAndGradient(Vector&) is hardly more
+   * expensive than \c computeObjective(). Note that \c gradientCached()
+   * is then the gradient at the last evaluated position, also after
+   * applying a test step.
+   * Default: false (the gradient is computed on demand only).
+   */
+  inline void setGradientWithObjective(bool gradientWithObjective) {
+    m_gradientWithObjective = gradientWithObjective;
+  }
+
+  inline bool gradientWithObjective() const {
+    return m_gradientWithObjective;
+  }
+
   /**
    * Get the current position.
    */
@@ -89,7 +142,7 @@ public:
    *       \c computeGradient(), unless you don't need the Hessian.
    */
   inline void computeGradient() {
-    m_gradientNormCached = false;
+    beginGradientUpdate();
     computeGradient(m_gradientCache);
     m_gradientCached = true;
   }
@@ -140,21 +193,39 @@ public:
 
   /**
    * Apply a step to the current position in parameter space.
+   * The objective and the gradient at the previous position are kept
+   * for \c unapplyStep().
    * @param step The change to be applied to the current position
    */
   inline void applyStep(const Vector& step) {
+    const bool objectiveCached = m_objectiveCached;
+    const bool gradientCached = m_gradientCached;
+    const bool gradientNormCached = m_gradientNormCached;
     invalidateCaches();
     doApplyStep(step);
+    m_stepApplied = true;
+    m_previousObjectiveCached = objectiveCached;
+    m_previousObjective = m_objectiveCache;
+    m_previousGradientCached = gradientCached;
+    m_previousGradientNormCached = gradientCached && gradientNormCached;
+    m_previousGradientNorm = m_gradientNormCache;
+    m_gradientInPreviousBuffer = false;
   }
 
   /**
    * Unapply a step to the current position in parameter space.
    * Is equivalent to \c apply(-step); .
+   * Directly after \c applyStep(), the objective and the gradient at the
+   * previous position are restored instead of being recomputed.
    * @param step The change to be unapplied to the current position
    */
   inline void unapplyStep(const Vector& step) {
+    const bool stepApplied = m_stepApplied;
     invalidateCaches();
     doUnapplyStep(step);
+    if (stepApplied) {
+      restorePreviousCaches();
+    }
   }
 
   /**
@@ -165,6 +236,7 @@ public:
     m_objectiveCached = false;
     m_positionCached = false;
     m_gradientCached = false;
+    m_stepApplied = false;
   }
 
 protected:
@@ -201,8 +273,9 @@ protected:
    * Compute the gradient of the objective function at the current position.
    * @param newGradient Output parameter for the gradient of the objective
    *        function. Be careful: \c newGradient is the <b>same</b> object
-   *        as \c gradient(). If you need to access (the old) \c gradient()
-   *        during the computation, first make a copy.
+   *        as \c gradientCached(). Its content is undefined on entry
+   *        (the buffers of the current and the previous gradient are
+   *        swapped by \c applyStep() and \c unapplyStep()).
    */
   virtual void computeGradient(Vector& newGradient) = 0;
 
@@ -238,22 +311,67 @@ protected:
    * Unapply a step to the current position in parameter space.
    * Only needs to be implemented in subclasses if \c parameters() is not used
    * in the subclass to store the position in parameter space.
+   * In this case, the position has to be the same as before the step,
+   * as the cached objective and gradient of that position are restored.
    * @param step The change to be applied to the current position
    */
   virtual void doUnapplyStep(const Vector& step);
 
+  /**
+   * Compute the value and the gradient of the objective function
+   * at the current position.
+   * @note The default implementation calls \c computeObjective() and
+   * \c computeGradient(). Override it if both share (expensive)
+   * intermediate results.
+   * @param newGradient Output parameter for the gradient, see
+   *        \c computeGradient(Vector&)
+   * @return value of the objective function
+   */
+  virtual double computeObjectiveAndGradient(Vector& newGradient);
+
 private:
+  /**
+   * Prepare \c m_gradientCache for a new gradient. The first gradient
+   * after \c applyStep() goes to the other buffer, so the gradient of the
+   * previous position survives for \c unapplyStep().
+   */
+  inline void beginGradientUpdate() {
+    if (m_stepApplied && m_previousGradientCached
+        && !m_gradientInPreviousBuffer) {
+      m_gradientCache.swap(m_previousGradient);
+      m_gradientInPreviousBuffer = true;
+    }
+    m_gradientNormCached = false;
+  }
+
+  /**
+   * Restore the caches of the position before the last \c applyStep().
+   */
+  void restorePreviousCaches();
+
   bool m_positionCached;
   bool m_objectiveCached;
   bool m_gradientCached;
   bool m_gradientNormCached;
+  bool m_gradientWithObjective;
 
   double m_objectiveCache;
   Vector m_positionCache;
-  Vector m_previousPosition;
   Vector m_gradientCache;
   double m_gradientNormCache;
 
+  //! state of the position before the last applyStep()
+  bool m_stepApplied;
+  bool m_previousPositionValid;
+  bool m_previousObjectiveCached;
+  bool m_previousGradientCached;
+  bool m_previousGradientNormCached;
+  bool m_gradientInPreviousBuffer;
+  double m_previousObjective;
+  double m_previousGradientNorm;
+  Vector m_previousPosition;
+  Vector m_previousGradient;
+
   friend class OptimizationProblemSecond;
 };
 
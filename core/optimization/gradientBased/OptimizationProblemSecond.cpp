@@ -12,8 +12,17 @@ OptimizationProblemSecond::~OptimizationProblemSecond() {
 }
 
 void OptimizationProblemSecond::computeGradient(Vector& newGradient) {
-  m_hessianCache.resize(dimension(), dimension());
-  computeGradientAndHessian(newGradient, m_hessianCache);
+  // the Hessian goes to scratch storage: gradients at test steps (e.g. with
+  // setGradientWithObjective()) must not replace hessianCached(), which
+  // unapplyStep() does not restore
+  m_hessianScratch.resize(dimension(), dimension());
+  computeGradientAndHessian(newGradient, m_hessianScratch);
+}
+
+void OptimizationProblemSecond::computeHessianTimesVector(const Vector& v,
+                                                          Vector& result) {
+  result.resize(dimension());
+  result.multiply(hessianCurrent(), v);
 }
 
 }; // namespace NICE 
@@ -49,6 +49,8 @@ namespace NICE {
  *   to implement <b>either</b> \c computeGradientAndHessian() <b>or</b>
  *   \c computeGradient() and \c computeHessian() (and a simple
  *   \c computeGradientAndHessian() which calls the other two).
+ * - Optionally, override \c computeObjectiveAndGradient(Vector&) if the
+ *   objective and the gradient share intermediate results.
  *
  * You also need to take care of how the current position in parameter space
  * is represented. There are two possibilities:
@@ -78,10 +80,20 @@ namespace NICE {
  * when the access method is called.
  * Derivatives are only computed by an explicit call to \c computeGradient()
  * (or \c computeGradientAndHessian() in the second order subclass)
- * and also by calling \c gradientCurrent(), \c gradientNormCurrent()
+ * and also by calling \c gradientCurrent(), \c gradientNormCurrent(),
+ * \c computeObjectiveAndGradient()
  * (or \c hessianCurrent() in the second order subclass).
  * This strategy allows keeping old derivatives without copying when applying
  * a test step. See \c FirstOrderTrustRegion for a quite simple example.
+ * If the problem computes the gradient together with the objective
+ * (\c setGradientWithObjective()), \c gradientCached() changes with every
+ * evaluation of \c objective(). Algorithms should therefore use the old
+ * gradient before evaluating the objective at a test step.
+ *
+ * \c applyStep() keeps the position, the objective and the gradient of the
+ * previous position in preallocated buffers, \c unapplyStep() restores
+ * them by swapping the buffers. Rejecting a test step therefore costs
+ * neither a copy nor a reevaluation.
  *
  * \ingroup optimization_problems
  */
@@ -94,7 +106,7 @@ public:
   virtual ~OptimizationProblemSecond();
 
   inline void computeGradientAndHessian() {
-    m_gradientNormCached = false;
+    beginGradientUpdate();
     m_hessianCache.resize(dimension(), dimension());
     computeGradientAndHessian(m_gradientCache, m_hessianCache);
     m_gradientCached = true;
@@ -104,6 +116,8 @@ public:
   /**
    * Get the Hessian of the objective function
    * as computed by the last call to \c computeGradientAndHessian().
+   * Gradient-only evaluations (\c computeGradient(), also by
+   * \c objective() with \c setGradientWithObjective()) do not change it.
    */
   inline const Matrix& hessianCached() {
     return m_hessianCache;
@@ -121,6 +135,18 @@ public:
     return m_hessianCache;
   }
 
+  /**
+   * Multiply the Hessian of the objective function at the current position
+   * with a vector: \c result = H * \c v.
+   * Hessian-free algorithms (e.g. \c SecondOrderTrustRegionCG) only use
+   * this method and \c computeGradient(), never \c hessianCached().
+   * @param v Vector to be multiplied
+   * @param result Output parameter for H * \c v (resized if necessary)
+   */
+  inline void hessianTimesVector(const Vector& v, Vector& result) {
+    computeHessianTimesVector(v, result);
+  }
+
   /**
    * See base class. Note: you probably don't want to override this
    * method in a subclass.
@@ -152,7 +178,8 @@ protected:
    * See baseclass for documentation.
    * @note
    * There is a default implementation for this method, which uses
-   * \c computeGradientAndHessian(). This works, but is not efficient for
+   * \c computeGradientAndHessian() and discards the Hessian
+   * (\c hessianCached() is not changed). This works, but is not efficient for
    * 1st order optimization algorithms. To improve this, provide an efficient
    * implementation of \c computeGradient(). Depending on your situation,
    * it may or may not be a good idea to have a method computeHessian() and
@@ -161,9 +188,22 @@ protected:
    */
   virtual void computeGradient(Vector& newGradient);
 
+  /**
+   * Compute H * \c v at the current position.
+   * @note
+   * The default implementation multiplies \c hessianCurrent() with \c v.
+   * For large problems, override this method with a matrix-free product
+   * (e.g. a directional derivative of the gradient) and also override
+   * \c computeGradient(). \c computeGradientAndHessian() is not called by
+   * Hessian-free algorithms and may throw an exception in this case.
+   */
+  virtual void computeHessianTimesVector(const Vector& v, Vector& result);
+
 private:
   bool m_hessianCached;
   Matrix m_hessianCache;
+  //! output of the default computeGradient(Vector&), discarded
+  Matrix m_hessianScratch;
 };
 
 }; // namespace NICE
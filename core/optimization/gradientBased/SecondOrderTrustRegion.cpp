@@ -13,6 +13,7 @@
 
 #include <core/basics/Exception.h>
 #include <core/basics/Log.h>
+#include "core/basics/Profiler.h"
 
 namespace NICE {
 
@@ -142,6 +143,7 @@ inline double productVMV(const Vector& v1,
 #endif
 
 void SecondOrderTrustRegion::doOptimize(OptimizationProblemSecond& problem) {
+  NICE_PROFILE_ZONE ( "SecondOrderTrustRegion::doOptimize" );
 #ifdef NICE_USELIB_LINAL
   bool previousStepSuccessful = true;
   double previousError = problem.objective();
@@ -361,6 +363,11 @@ void SecondOrderTrustRegion::doOptimize(OptimizationProblemSecond& problem) {
       normOldPosition = problem.position().normL2();
     }
 
+    // predicted reduction (before the objective at the new position
+    // is evaluated, which may also compute the gradient)
+    const double psi = problem.gradientCached().scalarProduct(stepLimun)
+                       + 0.5 * productVMV(step, hessian, step);
+
     // set new region parameters (to be verified later)
     problem.applyStep(stepLimun);
     
@@ -368,8 +375,6 @@ void SecondOrderTrustRegion::doOptimize(OptimizationProblemSecond& problem) {
     const double newError = problem.objective();
 //Log::debug() << "newError: " << newError << std::endl;
     const double errorReduction = newError - previousError;
-    const double psi = problem.gradientCached().scalarProduct(stepLimun)
-                       + 0.5 * productVMV(step, hessian, step);
     double rho;
     if (std::fabs(psi) <= epsilonRho
         && std::fabs(errorReduction) <= epsilonRho) {
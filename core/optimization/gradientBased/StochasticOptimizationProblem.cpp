@@ -0,0 +1,179 @@
+/*
+ * NICE-Core - efficient algebra and computer vision methods
+ *  - liboptimization - An optimization/template for new NICE libraries
+ * See file License for license information.
+ */
+/*****************************************************************************/
+#include "core/optimization/gradientBased/StochasticOptimizationProblem.h"
+
+#include <exception>
+#include <string>
+
+#ifdef NICE_USELIB_OPENMP
+#include <omp.h>
+#endif
+
+#include <core/basics/Exception.h>
+
+namespace NICE {
+
+StochasticOptimizationProblem::StochasticOptimizationProblem(
+    unsigned int dimension, unsigned int numSamples)
+    : OptimizationProblemFirst(dimension), m_numSamples(numSamples),
+      m_threadSafe(false), m_numThreads(0), m_minShardSize(1),
+      m_allSamples(numSamples) {
+  if (numSamples == 0) {
+    fthrow(Exception, "StochasticOptimizationProblem: no samples");
+  }
+  for (unsigned int i = 0; i < numSamples; i++) {
+    m_allSamples[i] = i;
+  }
+}
+
+StochasticOptimizationProblem::~StochasticOptimizationProblem() {
+}
+
+void StochasticOptimizationProblem::setThreadSafe(bool threadSafe,
+                                                  int numThreads) {
+  m_threadSafe = threadSafe;
+  m_numThreads = numThreads;
+}
+
+void StochasticOptimizationProblem::setMinShardSize(unsigned int minShardSize) {
+  m_minShardSize = (minShardSize > 0) ? minShardSize : 1;
+}
+
+double StochasticOptimizationProblem::batchObjectiveAndGradient(
+                                        const unsigned int* samples,
+                                        unsigned int count, Vector& gradient) {
+  const double loss = evaluateShards(samples, count, &gradient);
+  gradient *= 1.0 / count;
+  return loss / count;
+}
+
+double StochasticOptimizationProblem::batchObjective(
+                                        const unsigned int* samples,
+                                        unsigned int count) {
+  return evaluateShards(samples, count, NULL) / count;
+}
+
+double StochasticOptimizationProblem::computeBatchObjective(
+                                        const unsigned int* samples,
+                                        unsigned int count) {
+  Vector gradient(dimension());
+  return computeBatchObjectiveAndGradient(samples, count, gradient);
+}
+
+double StochasticOptimizationProblem::computeObjective() {
+  return evaluateShards(&m_allSamples[0], m_numSamples, NULL) / m_numSamples;
+}
+
+void StochasticOptimizationProblem::computeGradient(Vector& newGradient) {
+  computeObjectiveAndGradient(newGradient);
+}
+
+double StochasticOptimizationProblem::computeObjectiveAndGradient(
+                                        Vector& newGradient) {
+  return batchObjectiveAndGradient(&m_allSamples[0], m_numSamples,
+                                   newGradient);
+}
+
+double StochasticOptimizationProblem::evaluateShards(
+                                        const unsigned int* samples,
+                                        unsigned int count, Vector* gradient) {
+  if (count == 0) {
+    fthrow(Exception, "StochasticOptimizationProblem: empty batch");
+  }
+  for (unsigned int i = 0; i < count; i++) {
+    if (samples[i] >= m_numSamples) {
+      fthrow(Exception, "StochasticOptimizationProblem: sample " << samples[i]
+             << " of " << m_numSamples);
+    }
+  }
+  if (gradient != NULL) {
+    gradient->resize(dimension());
+  }
+
+  int numShards = 1;
+  if (m_threadSafe) {
+    int numThreads = m_numThreads;
+#ifdef NICE_USELIB_OPENMP
+    if (numThreads <= 0)
+      numThreads = omp_get_max_threads();
+#endif
+    if (numThreads > 1) {
+      const unsigned int maxShards = count / m_minShardSize;
+      numShards = ((unsigned int)numThreads < maxShards) ? numThreads : maxShards;
+    }
+    if (numShards < 1)
+      numShards = 1;
+  }
+
+  if (numShards == 1) {
+    if (gradient != NULL) {
+      return computeBatchObjectiveAndGradient(samples, count, *gradient);
+    }
+    return computeBatchObjective(samples, count);
+  }
+
+  // gradient sums of the shards 1, 2, ... (shard 0 uses the output), per
+  // call, such that batches may be evaluated concurrently
+  std::vector<Vector> shardGradients((gradient != NULL) ? numShards - 1 : 0);
+  std::vector<double> losses(numShards, 0.0);
+
+  volatile bool failed = false;
+  std::string message;
+
+#pragma omp parallel for schedule(static,1) num_threads(numShards)
+  for (int k = 0; k < numShards; k++) {
+    if (failed)
+      continue;
+
+    // contiguous shards of (almost) equal size
+    const unsigned int begin = (unsigned int)(((unsigned long long)count * k)
+                                              / numShards);
+    const unsigned int end = (unsigned int)(((unsigned long long)count * (k + 1))
+                                            / numShards);
+    try {
+      if (gradient != NULL) {
+        Vector& shardGradient = (k == 0) ? *gradient : shardGradients[k - 1];
+        // allocated by the thread which uses it
+        shardGradient.resize(dimension());
+        losses[k] = computeBatchObjectiveAndGradient(samples + begin,
+                                                     end - begin,
+                                                     shardGradient);
+      } else {
+        losses[k] = computeBatchObjective(samples + begin, end - begin);
+      }
+    } catch (std::exception& e) {
+#pragma omp critical (StochasticOptimizationProblemError)
+      {
+        failed = true;
+        message = e.what();
+      }
+    } catch (...) {
+#pragma omp critical (StochasticOptimizationProblemError)
+      {
+        failed = true;
+        message = "unknown exception";
+      }
+    }
+  }
+
+  if (failed) {
+    fthrow(Exception, "StochasticOptimizationProblem: evaluation of a shard failed: "
+           << message);
+  }
+
+  // reduction in shard order
+  double loss = losses[0];
+  for (int k = 1; k < numShards; k++) {
+    loss += losses[k];
+    if (gradient != NULL) {
+      *gradient += shardGradients[k - 1];
+    }
+  }
+  return loss;
+}
+
+}; // namespace NICE
@@ -0,0 +1,151 @@
+/*
+ * NICE-Core - efficient algebra and computer vision methods
+ *  - liboptimization - An optimization/template for new NICE libraries
+ * See file License for license information.
+ */
+/*****************************************************************************/
+#ifndef _STOCHASTICOPTIMIZATIONPROBLEM_OPTIMIZATION_H
+#define _STOCHASTICOPTIMIZATIONPROBLEM_OPTIMIZATION_H
+
+#include <vector>
+
+#include <core/optimization/gradientBased/OptimizationProblemFirst.h>
+
+namespace NICE {
+
+/**
+ * Base class for minimization problems whose objective is the mean of
+ * per-sample losses, f(x) = 1/N sum_i f_i(x), e.g. the training error
+ * of a model on N training samples.
+ *
+ * Subclasses implement \c computeBatchObjectiveAndGradient(), which sums
+ * the losses and the gradients of a subset of the samples (a minibatch).
+ * Stochastic algorithms (\c FirstOrderSGD, \c FirstOrderAdam) use
+ * \c batchObjectiveAndGradient() and touch only a minibatch per step.
+ * The full objective and gradient of \c OptimizationProblemFirst are the
+ * means over all samples, so every first order algorithm can solve the
+ * problem as well.
+ *
+ * Data-parallel evaluation: if the problem is declared thread-safe
+ * (\c setThreadSafe()), a batch is split into contiguous shards which are
+ * evaluated on the OpenMP threads. The shard results are reduced in a
+ * fixed order, so the results only depend on the number of threads.
+ * \c computeBatchObjectiveAndGradient() then has to be thread-safe: it may
+ * read the position (\c parametersConst()), but not change the problem.
+ * The batch functions keep no state of their own, so with a thread-safe
+ * problem several threads may also evaluate batches at the same position
+ * concurrently.
+ *
+ * \ingroup optimization_problems
+ */
+class StochasticOptimizationProblem : public OptimizationProblemFirst {
+public:
+  /**
+   * @param dimension dimension of the parameter space
+   * @param numSamples number of samples N
+   */
+  StochasticOptimizationProblem(unsigned int dimension,
+                                unsigned int numSamples);
+
+  virtual ~StochasticOptimizationProblem();
+
+  /**
+   * The number of samples N.
+   */
+  inline unsigned int numSamples() const {
+    return m_numSamples;
+  }
+
+  /**
+   * Declare \c computeBatchObjectiveAndGradient() (and
+   * \c computeBatchObjective()) thread-safe, batches are then evaluated
+   * in parallel shards.
+   * @param threadSafe default: false
+   * @param numThreads number of threads, 0: all OpenMP threads
+   */
+  void setThreadSafe(bool threadSafe, int numThreads = 0);
+
+  inline bool isThreadSafe() const {
+    return m_threadSafe;
+  }
+
+  inline int getNumThreads() const {
+    return m_numThreads;
+  }
+
+  /**
+   * Minimum number of samples per shard of the data-parallel evaluation
+   * (default: 1). Use larger values if a sample is cheap.
+   */
+  void setMinShardSize(unsigned int minShardSize);
+
+  /**
+   * Mean objective and mean gradient of a minibatch at the current position.
+   * The caches of \c OptimizationProblemFirst are not changed.
+   * @param samples indices of the samples (in [0, N))
+   * @param count number of samples of the batch (at least 1)
+   * @param gradient output: mean gradient (resized if necessary)
+   * @return mean objective of the batch
+   */
+  double batchObjectiveAndGradient(const unsigned int* samples,
+                                   unsigned int count, Vector& gradient);
+
+  /**
+   * Mean objective of a minibatch at the current position.
+   * @copydetails batchObjectiveAndGradient()
+   */
+  double batchObjective(const unsigned int* samples, unsigned int count);
+
+protected:
+  /**
+   * Compute the sum of the losses and the sum of the gradients of
+   * the samples \c samples[0], ..., \c samples[count-1] at the current
+   * position in parameter space.
+   * @param samples indices of the samples
+   * @param count number of samples (at least 1)
+   * @param gradient Output parameter for the sum of the gradients,
+   *        has size \c dimension(), its content is undefined on entry
+   * @return sum of the losses
+   */
+  virtual double computeBatchObjectiveAndGradient(const unsigned int* samples,
+                                                  unsigned int count,
+                                                  Vector& gradient) = 0;
+
+  /**
+   * Compute the sum of the losses of the samples.
+   * @note The default implementation calls
+   * \c computeBatchObjectiveAndGradient(). Override it if the loss alone
+   * is cheaper.
+   */
+  virtual double computeBatchObjective(const unsigned int* samples,
+                                       unsigned int count);
+
+  //! mean loss of all samples
+  virtual double computeObjective();
+
+  //! mean gradient of all samples
+  virtual void computeGradient(Vector& newGradient);
+
+  //! mean loss and gradient of all samples in one pass
+  virtual double computeObjectiveAndGradient(Vector& newGradient);
+
+private:
+  /**
+   * Sum of the losses (and the gradients if \c gradient != NULL)
+   * of a batch, split into shards if the problem is thread-safe.
+   */
+  double evaluateShards(const unsigned int* samples, unsigned int count,
+                        Vector* gradient);
+
+  unsigned int m_numSamples;
+  bool m_threadSafe;
+  int m_numThreads;
+  unsigned int m_minShardSize;
+
+  //! indices 0, ..., N-1 for the full batch
+  std::vector<unsigned int> m_allSamples;
+};
+
+}; // namespace NICE
+
+#endif /* _STOCHASTICOPTIMIZATIONPROBLEM_OPTIMIZATION_H */
@@ -0,0 +1,241 @@
+/*
+ * NICE-Core - efficient algebra and computer vision methods
+ *  - liboptimization - An optimization/template for new NICE libraries
+ * See file License for license information.
+ */
+
+#ifdef NICE_USELIB_CPPUNIT
+#include "TestStochastic.h"
+#include <vector>
+#include <core/basics/cppunitex.h>
+#include <core/optimization/gradientBased/FirstOrderLBFGS.h>
+#include <core/optimization/gradientBased/StochasticOptimizationProblem.h>
+#include <core/optimization/gradientBased/FirstOrderSGD.h>
+#include <core/optimization/gradientBased/FirstOrderAdam.h>
+
+using namespace NICE;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TestStochastic );
+
+void TestStochastic::setUp() {
+}
+
+void TestStochastic::tearDown() {
+}
+
+/** a quadratic problem without samples */
+class MyDeterministicProblem : public OptimizationProblemFirst {
+public:
+  inline MyDeterministicProblem() : OptimizationProblemFirst(2) {
+    parameters()[0] = 1.0;
+  }
+
+protected:
+  virtual double computeObjective() {
+    return 0.7 * square(parameters()[0] + 0.6)
+           + 0.4 * square(parameters()[1] - 0.3);
+  }
+
+  virtual void computeGradient(Vector& newGradient) {
+    newGradient[0] = 1.4 * (parameters()[0] + 0.6);
+    newGradient[1] = 0.8 * (parameters()[1] - 0.3);
+  }
+};
+
+/** linear least squares: loss_i = 0.5 (a_i^T x - b_i)^2 with b_i = a_i^T (1, 2, ..., d) */
+class MyRegressionProblem : public StochasticOptimizationProblem {
+public:
+  MyRegressionProblem(unsigned int dimension, unsigned int numSamples)
+      : StochasticOptimizationProblem(dimension, numSamples),
+        a(numSamples, dimension), b(numSamples) {
+    initRand(true, 7);
+    for (unsigned int i = 0; i < numSamples; i++) {
+      b[i] = 0.0;
+      for (unsigned int j = 0; j < dimension; j++) {
+        a(i, j) = randGaussDouble(1.0);
+        b[i] += a(i, j) * (j + 1);
+      }
+    }
+    parameters().set(0.0);
+  }
+
+  Matrix a;
+  Vector b;
+
+protected:
+  virtual double computeBatchObjectiveAndGradient(const unsigned int* samples,
+                                                  unsigned int count,
+                                                  Vector& gradient) {
+    const Vector& x = parametersConst();
+    gradient.set(0.0);
+    double loss = 0.0;
+    for (unsigned int k = 0; k < count; k++) {
+      const unsigned int i = samples[k];
+      double r = -b[i];
+      for (unsigned int j = 0; j < x.size(); j++) {
+        r += a(i, j) * x[j];
+      }
+      loss += 0.5 * r * r;
+      for (unsigned int j = 0; j < x.size(); j++) {
+        gradient[j] += r * a(i, j);
+      }
+    }
+    return loss;
+  }
+};
+
+void TestStochastic::testStochasticProblem() {
+  MyRegressionProblem problem(5, 1000);
+  Vector step(5, 0.5);
+  problem.applyStep(step);
+
+  // the full gradient is the mean of the batch gradients
+  std::vector<unsigned int> samples(1000);
+  for (unsigned int i = 0; i < samples.size(); i++) {
+    samples[i] = i;
+  }
+  Vector gradient1, gradient2;
+  const double loss1 = problem.batchObjectiveAndGradient(&samples[0], 300, gradient1);
+  const double loss2 = problem.batchObjectiveAndGradient(&samples[300], 700, gradient2);
+  const double fullLoss = problem.objective();
+  const Vector& fullGradient = problem.gradientCurrent();
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.3 * loss1 + 0.7 * loss2, fullLoss, 1E-10 * fullLoss);
+  for (unsigned int j = 0; j < 5; j++) {
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.3 * gradient1[j] + 0.7 * gradient2[j],
+                                 fullGradient[j], 1E-10);
+  }
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(loss1, problem.batchObjective(&samples[0], 300), 1E-12 * loss1);
+
+  // data-parallel shards
+  problem.setThreadSafe(true, 4);
+  Vector gradientParallel;
+  const double lossParallel = problem.batchObjectiveAndGradient(&samples[0], 300, gradientParallel);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(loss1, lossParallel, 1E-12 * loss1);
+  for (unsigned int j = 0; j < 5; j++) {
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(gradient1[j], gradientParallel[j], 1E-12);
+  }
+  // more shards than samples
+  Vector gradientSmall;
+  problem.batchObjectiveAndGradient(&samples[0], 2, gradientSmall);
+  problem.setThreadSafe(false);
+  Vector gradientSmallSerial;
+  problem.batchObjectiveAndGradient(&samples[0], 2, gradientSmallSerial);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(gradientSmallSerial[0], gradientSmall[0], 1E-12);
+
+  samples[0] = 1000;
+  CPPUNIT_ASSERT_THROW(problem.batchObjective(&samples[0], 1), Exception);
+
+  // full batch algorithms work as well
+  FirstOrderLBFGS optimizer;
+  optimizer.setEpsilonG(1E-8);
+  optimizer.optimizeFirst(problem);
+  for (unsigned int j = 0; j < 5; j++) {
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(j + 1.0, problem.position()[j], 1E-6);
+  }
+}
+
+void TestStochastic::testConcurrentBatches() {
+  MyRegressionProblem problem(5, 1000);
+  Vector step(5, 0.25);
+  problem.applyStep(step);
+  problem.setThreadSafe(true, 4);
+
+  std::vector<unsigned int> samples(1000);
+  for (unsigned int i = 0; i < samples.size(); i++) {
+    samples[i] = i;
+  }
+
+  // the batches of the threads are split into shards with their own buffers
+  const int numBatches = 8;
+  std::vector<Vector> gradients(numBatches);
+  std::vector<double> losses(numBatches);
+#pragma omp parallel for num_threads(4)
+  for (int k = 0; k < numBatches; k++) {
+    losses[k] = problem.batchObjectiveAndGradient(&samples[100 * k], 200, gradients[k]);
+  }
+
+  problem.setThreadSafe(false);
+  for (int k = 0; k < numBatches; k++) {
+    Vector gradient;
+    const double loss = problem.batchObjectiveAndGradient(&samples[100 * k], 200, gradient);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(loss, losses[k], 1E-12 * loss);
+    for (unsigned int j = 0; j < 5; j++) {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(gradient[j], gradients[k][j], 1E-12);
+    }
+  }
+}
+
+void TestStochastic::testStochasticOptimization() {
+  for (int nesterov = 0; nesterov < 2; nesterov++) {
+    MyRegressionProblem problem(5, 1000);
+    FirstOrderSGD optimizer(0.02, 0.9, nesterov == 1);
+    optimizer.setBatchSize(20);
+    optimizer.setMaxEpochs(20);
+    optimizer.setRandomSeed(true, 1);
+    optimizer.optimizeFirst(problem);
+    CPPUNIT_ASSERT_EQUAL(1000u, optimizer.getNumIterations());
+    CPPUNIT_ASSERT_EQUAL(20u, optimizer.getNumEpochs());
+    CPPUNIT_ASSERT_EQUAL(20000.0, optimizer.getNumSampleGradients());
+    const std::vector<double>& losses = optimizer.getEpochLosses();
+    CPPUNIT_ASSERT(losses.back() < 1E-6 * losses.front());
+    for (unsigned int j = 0; j < 5; j++) {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(j + 1.0, problem.position()[j], 1E-4);
+    }
+  }
+
+  {
+    // data-parallel evaluation, same sample order
+    MyRegressionProblem serial(5, 1000);
+    MyRegressionProblem parallel(5, 1000);
+    parallel.setThreadSafe(true, 4);
+    FirstOrderSGD optimizer(0.02, 0.9, true);
+    optimizer.setBatchSize(100);
+    optimizer.setMaxEpochs(3);
+    optimizer.setRandomSeed(true, 3);
+    optimizer.optimizeFirst(serial);
+    optimizer.optimizeFirst(parallel);
+    for (unsigned int j = 0; j < 5; j++) {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(serial.position()[j], parallel.position()[j], 1E-10);
+    }
+  }
+
+  Vector adamSolution(5);
+  for (int decay = 0; decay < 3; decay++) {
+    MyRegressionProblem problem(5, 1000);
+    FirstOrderAdam optimizer(0.05);
+    optimizer.setBatchSize(50);
+    optimizer.setMaxEpochs(100);
+    optimizer.setLearningRate(0.05, 0.01);
+    optimizer.setEpsilonF(1E-12);
+    optimizer.setRandomSeed(true, 2);
+    if (decay == 1) {
+      optimizer.setWeightDecay(0.1, true);
+    } else if (decay == 2) {
+      optimizer.setWeightDecay(0.1, false);
+    }
+    optimizer.optimizeFirst(problem);
+    if (decay == 0) {
+      for (unsigned int j = 0; j < 5; j++) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(j + 1.0, problem.position()[j], 1E-3);
+      }
+      adamSolution = problem.position();
+    } else {
+      // the weight decay shrinks the solution
+      CPPUNIT_ASSERT(problem.position().normL2() < adamSolution.normL2() - 0.1);
+    }
+  }
+
+  {
+    // a deterministic problem: full gradient in every iteration
+    MyDeterministicProblem problem;
+    FirstOrderAdam optimizer(0.05);
+    optimizer.setMaxEpochs(2000);
+    optimizer.setLearningRate(0.05, 0.01);
+    optimizer.optimizeFirst(problem);
+    CPPUNIT_ASSERT_EQUAL(2000u, optimizer.getNumIterations());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(-0.6, problem.position()[0], 1E-3);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.3, problem.position()[1], 1E-3);
+  }
+}
+
+#endif
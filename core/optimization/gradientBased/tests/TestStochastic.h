@@ -0,0 +1,44 @@
+/*
+ * NICE-Core - efficient algebra and computer vision methods
+ *  - liboptimization - An optimization/template for new NICE libraries
+ * See file License for license information.
+ */
+#ifndef _TESTSTOCHASTIC_OPTIMIZATION_H
+#define _TESTSTOCHASTIC_OPTIMIZATION_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * CppUnit-Testcase.
+ * Tests for StochasticOptimizationProblem, FirstOrderSGD and FirstOrderAdam.
+ */
+class TestStochastic : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE( TestStochastic );
+  CPPUNIT_TEST( testStochasticProblem );
+  CPPUNIT_TEST( testConcurrentBatches );
+  CPPUNIT_TEST( testStochasticOptimization );
+  CPPUNIT_TEST_SUITE_END();
+
+ private:
+
+ public:
+  void setUp();
+  void tearDown();
+
+  /**
+   * Test minibatch and data-parallel evaluation of a StochasticOptimizationProblem
+   */
+  void testStochasticProblem();
+
+  /**
+   * Test batches evaluated concurrently by several threads
+   */
+  void testConcurrentBatches();
+
+  /**
+   * Test SGD with momentum and Adam / AdamW
+   */
+  void testStochasticOptimization();
+};
+
+#endif // _TESTSTOCHASTIC_OPTIMIZATION_H
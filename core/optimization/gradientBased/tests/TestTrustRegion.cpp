@@ -8,10 +8,13 @@
 #include "TestTrustRegion.h"
 #include <string>
 #include <exception>
+#include <limits>
 #include <core/basics/cppunitex.h>
 #include <core/optimization/gradientBased/FirstOrderTrustRegion.h>
 #include <core/optimization/gradientBased/FirstOrderRasmussen.h>
+#include <core/optimization/gradientBased/FirstOrderLBFGS.h>
 #include <core/optimization/gradientBased/SecondOrderTrustRegion.h>
+#include <core/optimization/gradientBased/CostFunctionProblem.h>
 
 using namespace NICE;
 
@@ -176,4 +179,353 @@ void TestTrustRegion::testOptimization2() {
   CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.3, problem2.position()[1], 1E-16);
 }
 
+/** a large separable quadratic problem with condition number 10 */
+class MyProblemLarge : public OptimizationProblemFirst
+{
+    public:
+        MyProblemLarge (uint n) : OptimizationProblemFirst(n) {}
+        double computeObjective()
+        {
+            double sum = 0.0;
+            for ( uint i = 0 ; i < parameters().size() ; i++ )
+                sum += (i % 10 + 1) * square(parameters()[i] - 1.0);
+            return sum;
+        }
+
+        void computeGradient ( NICE::Vector &newGradient )
+        {
+            for ( uint i = 0 ; i < parameters().size() ; i++ )
+                newGradient[i] = 2.0 * (i % 10 + 1) * (parameters()[i] - 1.0);
+        }
+};
+
+void TestTrustRegion::testOptimizationLBFGS() {
+  {
+    MyProblem problem;
+    FirstOrderLBFGS optimizer;
+    optimizer.setEpsilonG(1E-6);
+    optimizer.optimizeFirst(problem);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, problem.objective(), 1E-10);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(-0.6, problem.position()[0], 1E-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.3, problem.position()[1], 1E-6);
+  }
+
+  {
+    MyProblem2 problem2;
+    FirstOrderLBFGS optimizer (3);
+    optimizer.setEpsilonG(1E-6);
+    optimizer.optimizeFirst(problem2);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(-0.6, problem2.position()[0], 1E-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.3, problem2.position()[1], 1E-6);
+  }
+
+  {
+    uint size = 100;
+    MyProblem3 problem3 (size);
+    FirstOrderLBFGS optimizer;
+    optimizer.setEpsilonG(1E-9);
+    optimizer.setEpsilonF(0.0);
+    optimizer.setMaxIterations(2000);
+    optimizer.optimizeFirst(problem3);
+    // stops at the limit of the double precision of the objective
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (problem3.position() - problem3.groundtruth()).normL2() / size, 1E-3);
+  }
+
+  {
+    uint size = 100000;
+    MyProblemLarge problem (size);
+    FirstOrderLBFGS optimizer (5);
+    optimizer.setEpsilonG(1E-6);
+    optimizer.optimizeFirst(problem);
+    CPPUNIT_ASSERT(optimizer.getNumIterations() < 100);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, (problem.position() - Vector(size, 1.0)).normInf(), 1E-6);
+  }
+}
+
+/** quadratic for x0 <= 5 and concave beyond, a step from the quadratic to
+ * the concave part violates the curvature condition */
+class MyConcaveProblem : public OptimizationProblemFirst {
+public:
+  inline MyConcaveProblem() : OptimizationProblemFirst(2) {}
+
+protected:
+  virtual double computeObjective() {
+    const double x = parameters()[0];
+    const double fx = ( x <= 5.0 ) ? 0.5 * square(x - 10.0) : 12.5 - 5.0 * (x - 5.0) - 1.5 * square(x - 5.0);
+    return fx + 0.5 * square(parameters()[1] - 2.0);
+  }
+
+  virtual void computeGradient(Vector& newGradient) {
+    const double x = parameters()[0];
+    newGradient[0] = ( x <= 5.0 ) ? x - 10.0 : -5.0 - 3.0 * (x - 5.0);
+    newGradient[1] = parameters()[1] - 2.0;
+  }
+};
+
+void TestTrustRegion::testOptimizationLBFGSBounds() {
+  {
+    // the minimum (-0.6, 0.3) is outside, the solution is on the bound x0 = 0
+    MyProblem problem;
+    FirstOrderLBFGS optimizer;
+    Vector lower(2), upper(2);
+    lower[0] = 0.0; upper[0] = 2.0;
+    lower[1] = -1.0; upper[1] = std::numeric_limits<double>::infinity();
+    optimizer.setBounds(lower, upper);
+    optimizer.setEpsilonG(1E-7);
+    optimizer.optimizeFirst(problem);
+    CPPUNIT_ASSERT_EQUAL(0.0, problem.position()[0]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.3, problem.position()[1], 1E-6);
+  }
+
+  {
+    // infeasible start, the box contains the minimum of some parameters only
+    uint size = 1000;
+    MyProblemLarge problem (size);
+    FirstOrderLBFGS optimizer;
+    Vector lower(size, -1.0), upper(size, 2.0);
+    for ( uint i = 0 ; i < size ; i += 3 )
+      upper[i] = 0.5;
+    optimizer.setBounds(lower, upper);
+    optimizer.setEpsilonG(1E-8);
+    optimizer.optimizeFirst(problem);
+    for ( uint i = 0 ; i < size ; i++ )
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(i % 3 == 0 ? 0.5 : 1.0, problem.position()[i], 1E-6);
+  }
+
+  {
+    // the first pair is accepted, the second step ends at the bound x0 = 8 in
+    // the concave part and its pair is rejected: with a memory of one pair
+    // (full) and of five pairs, the third iteration uses the same first pair
+    Vector lower(2, -100.0), upper(2, 100.0);
+    upper[0] = 8.0;
+    MyConcaveProblem problemFull, problemFree;
+    FirstOrderLBFGS optimizerFull (1), optimizerFree (5);
+    optimizerFull.setBounds(lower, upper);
+    optimizerFree.setBounds(lower, upper);
+    optimizerFull.setMaxIterations(3);
+    optimizerFree.setMaxIterations(3);
+    optimizerFull.optimizeFirst(problemFull);
+    optimizerFree.optimizeFirst(problemFree);
+    CPPUNIT_ASSERT_EQUAL(8.0, problemFull.position()[0]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(problemFree.position()[1], problemFull.position()[1], 1E-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(2.0, problemFull.position()[1], 1E-12);
+  }
+
+  CPPUNIT_ASSERT_THROW(FirstOrderLBFGS(0), Exception);
+  FirstOrderLBFGS optimizer;
+  CPPUNIT_ASSERT_THROW(optimizer.setBounds(Vector(2, 1.0), Vector(2, 0.0)), Exception);
+  optimizer.setBounds(Vector(3, 0.0), Vector(3, 1.0));
+  MyProblem problem;
+  CPPUNIT_ASSERT_THROW(optimizer.optimizeFirst(problem), Exception);
+}
+
+/** the objective of MyProblem2 as black box cost function */
+class MyQuadraticCostFunction : public OPTIMIZATION::CostFunction {
+public:
+  MyQuadraticCostFunction() : OPTIMIZATION::CostFunction(2) {}
+
+  virtual double evaluate(const OPTIMIZATION::matrix_type& x) {
+    return 0.7 * square(x(0,0) + 0.6) + 0.4 * square(x(1,0) - 0.3);
+  }
+};
+
+void TestTrustRegion::testCostFunctionProblem() {
+  const OPTIMIZATION::FiniteDifferences::Method methods[2]
+    = { OPTIMIZATION::FiniteDifferences::FORWARD,
+        OPTIMIZATION::FiniteDifferences::CENTRAL };
+#ifdef NICE_USELIB_LINAL
+  const int numAlgorithms = 3;
+#else
+  // SecondOrderTrustRegion needs LinAl
+  const int numAlgorithms = 2;
+#endif
+  for (int m = 0; m < 2; m++) {
+    for (int algorithm = 0; algorithm < numAlgorithms; algorithm++) {
+      MyQuadraticCostFunction costFunction;
+      costFunction.setThreadSafe(true);
+      CostFunctionProblem problem(&costFunction, Vector(2, 1.0), methods[m]);
+      if (algorithm == 0) {
+        FirstOrderTrustRegion optimizer;
+        optimizer.setEpsilonG(1E-4);
+        optimizer.optimizeFirst(problem);
+      } else if (algorithm == 1) {
+        FirstOrderRasmussen optimizer(false);
+        optimizer.setEpsilonG(1E-4);
+        optimizer.optimizeFirst(problem);
+      } else {
+        SecondOrderTrustRegion optimizer;
+        optimizer.setEpsilonG(1E-4);
+        optimizer.optimize(problem);
+      }
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, problem.objective(), 1E-8);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(-0.6, problem.position()[0], 1E-4);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.3, problem.position()[1], 1E-4);
+      CPPUNIT_ASSERT(problem.finiteDifferences().getNumberOfEvaluations() > 0);
+    }
+  }
+}
+
+/** MyProblem counting the evaluations, with combined objective and gradient */
+class MyCountingProblem : public OptimizationProblemFirst {
+public:
+  inline MyCountingProblem()
+      : OptimizationProblemFirst(2), numObjective(0), numGradient(0),
+        numCombined(0) {
+    parameters()[0] = 1.0;
+  }
+
+  int numObjective;
+  int numGradient;
+  int numCombined;
+
+protected:
+  virtual double computeObjective() {
+    numObjective++;
+    return 0.7 * square(parameters()[0] + 0.6)
+           + 0.4 * square(parameters()[1] - 0.3);
+  }
+
+  virtual void computeGradient(Vector& newGradient) {
+    numGradient++;
+    newGradient[0] = 1.4 * (parameters()[0] + 0.6);
+    newGradient[1] = 0.8 * (parameters()[1] - 0.3);
+  }
+
+  virtual double computeObjectiveAndGradient(Vector& newGradient) {
+    numCombined++;
+    const double d0 = parameters()[0] + 0.6;
+    const double d1 = parameters()[1] - 0.3;
+    newGradient[0] = 1.4 * d0;
+    newGradient[1] = 0.8 * d1;
+    return 0.7 * d0 * d0 + 0.4 * d1 * d1;
+  }
+};
+
+/** a quartic problem, the Hessian depends on the position */
+class MyQuarticProblem : public OptimizationProblemSecond {
+public:
+  inline MyQuarticProblem() : OptimizationProblemSecond(2) {
+    parameters()[0] = 1.0;
+    parameters()[1] = 1.0;
+  }
+
+protected:
+  virtual double computeObjective() {
+    return square(square(parameters()[0])) + square(parameters()[1]);
+  }
+
+  virtual void computeGradientAndHessian(Vector& newGradient,
+                                         Matrix& newHessian) {
+    newGradient[0] = 4.0 * parameters()[0] * square(parameters()[0]);
+    newGradient[1] = 2.0 * parameters()[1];
+    newHessian(0,0) = 12.0 * square(parameters()[0]);
+    newHessian(0,1) = 0.0;
+    newHessian(1,0) = 0.0;
+    newHessian(1,1) = 2.0;
+  }
+};
+
+void TestTrustRegion::testStepRollback() {
+  {
+    MyCountingProblem counting;
+    OptimizationProblemFirst& problem = counting;
+    const double f0 = problem.objective();
+    problem.computeGradient();
+    const Vector x0(problem.position());
+    const Vector g0(problem.gradientCached());
+    const double norm0 = problem.gradientNormCached();
+
+    Vector step(2);
+    step[0] = -0.25;
+    step[1] = 0.5;
+    problem.applyStep(step);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.75, problem.position()[0], 1E-15);
+    // the gradient of the previous position is still available
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(g0[0], problem.gradientCached()[0], 0.0);
+    CPPUNIT_ASSERT(problem.objective() < f0);
+    problem.computeGradient();
+    CPPUNIT_ASSERT_EQUAL(2, counting.numObjective);
+    CPPUNIT_ASSERT_EQUAL(2, counting.numGradient);
+
+    // rollback without reevaluation
+    problem.unapplyStep(step);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(x0[0], problem.position()[0], 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(x0[1], problem.position()[1], 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(f0, problem.objective(), 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(g0[0], problem.gradientCurrent()[0], 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(g0[1], problem.gradientCurrent()[1], 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(norm0, problem.gradientNormCurrent(), 0.0);
+    CPPUNIT_ASSERT_EQUAL(2, counting.numObjective);
+    CPPUNIT_ASSERT_EQUAL(2, counting.numGradient);
+
+    // a second unapplyStep() is a step in the opposite direction
+    problem.unapplyStep(step);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(x0[0] - step[0], problem.position()[0], 1E-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(x0[1] - step[1], problem.position()[1], 1E-15);
+    problem.applyStep(step);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(x0[0], problem.position()[0], 1E-15);
+
+    // combined evaluation, only the missing parts are computed
+    problem.applyStep(step);
+    const double f1 = problem.computeObjectiveAndGradient();
+    CPPUNIT_ASSERT_EQUAL(1, counting.numCombined);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(f1, problem.computeObjectiveAndGradient(), 0.0);
+    CPPUNIT_ASSERT_EQUAL(1, counting.numCombined);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.4 * 1.35, problem.gradientCached()[0], 1E-14);
+    CPPUNIT_ASSERT_EQUAL(2, counting.numObjective);
+    CPPUNIT_ASSERT_EQUAL(2, counting.numGradient);
+    problem.unapplyStep(step);
+    // recomputed, the caches at x0 were invalidated by the steps above
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(g0[0], problem.gradientCurrent()[0], 0.0);
+    CPPUNIT_ASSERT_EQUAL(3, counting.numGradient);
+
+    // gradient with every evaluation of the objective
+    problem.setGradientWithObjective(true);
+    problem.applyStep(step);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(f1, problem.objective(), 1E-15);
+    problem.gradientCurrent();
+    CPPUNIT_ASSERT_EQUAL(2, counting.numCombined);
+    CPPUNIT_ASSERT_EQUAL(3, counting.numGradient);
+  }
+
+  {
+    // gradients at a rejected test step keep the Hessian of the position
+    MyQuarticProblem quartic;
+    OptimizationProblemSecond& problem = quartic;
+    problem.setGradientWithObjective(true);
+    problem.computeGradientAndHessian();
+    const double g0 = problem.gradientCached()[0];
+    Vector step(2);
+    step[0] = 0.5;
+    step[1] = 0.0;
+    problem.applyStep(step);
+    problem.objective();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0 * 1.5 * 1.5 * 1.5, problem.gradientCached()[0], 1E-14);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(12.0, problem.hessianCached()(0,0), 0.0);
+    problem.unapplyStep(step);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(g0, problem.gradientCached()[0], 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(12.0, problem.hessianCached()(0,0), 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(12.0, problem.hessianCurrent()(0,0), 0.0);
+  }
+
+  {
+    // same iterates, but no separate gradient evaluations
+    MyCountingProblem separate;
+    MyCountingProblem combined;
+    combined.setGradientWithObjective(true);
+    FirstOrderTrustRegion optimizer;
+    optimizer.setEpsilonG(1E-4);
+    optimizer.optimizeFirst(separate);
+    optimizer.optimizeFirst(combined);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(-0.6, combined.position()[0], 2E-5);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.3, combined.position()[1], 5E-5);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(separate.position()[0], combined.position()[0], 1E-14);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(separate.position()[1], combined.position()[1], 1E-14);
+    CPPUNIT_ASSERT_EQUAL(0, combined.numObjective);
+    CPPUNIT_ASSERT_EQUAL(0, combined.numGradient);
+    CPPUNIT_ASSERT_EQUAL(separate.numObjective, combined.numCombined);
+    CPPUNIT_ASSERT(separate.numGradient < separate.numObjective);
+  }
+}
+
 #endif
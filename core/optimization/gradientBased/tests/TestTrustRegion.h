@@ -17,6 +17,10 @@ class TestTrustRegion : public CppUnit::TestFixture {
   CPPUNIT_TEST( testOptimization1 );
   CPPUNIT_TEST( testOptimization1Ras );
   CPPUNIT_TEST( testOptimization2 );
+  CPPUNIT_TEST( testOptimizationLBFGS );
+  CPPUNIT_TEST( testOptimizationLBFGSBounds );
+  CPPUNIT_TEST( testCostFunctionProblem );
+  CPPUNIT_TEST( testStepRollback );
   CPPUNIT_TEST_SUITE_END();
   
  private:
@@ -31,6 +35,23 @@ class TestTrustRegion : public CppUnit::TestFixture {
   void testOptimization1();
   void testOptimization1Ras();
   void testOptimization2();
+
+  /**
+   * Test L-BFGS, unconstrained and with box constraints
+   */
+  void testOptimizationLBFGS();
+  void testOptimizationLBFGSBounds();
+
+  /**
+   * Test optimization of a black box CostFunction with numerical derivatives
+   */
+  void testCostFunctionProblem();
+
+  /**
+   * Test the restored caches after unapplyStep() and the combined
+   * evaluation of objective and gradient
+   */
+  void testStepRollback();
 };
 
 #endif // _TESTTRUSTREGION_OPTIMIZATION_H
@@ -0,0 +1,374 @@
+/**
+* @file nice_core_bench.cpp
+* @brief micro-benchmarks of the hot paths of vector, algebra, image and optimization
+* @date 10/19/2026
+
+*/
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+#include "core/basics/Config.h"
+#include "core/basics/Log.h"
+#include "core/basics/Benchmark.h"
+#include "core/basics/numerictools.h"
+#include "core/basics/stringutils.h"
+#include "core/vector/MatrixT.h"
+#include "core/vector/VectorT.h"
+#include "core/vector/Algorithms.h"
+#include "core/algebra/GMStandard.h"
+#include "core/algebra/ILSConjugateGradients.h"
+#include "core/algebra/ILSMinResLanczos.h"
+#include "core/algebra/ILSSymmLqLanczos.h"
+#include "core/image/ImageT.h"
+#include "core/image/ColorImageT.h"
+#include "core/image/FilterT.h"
+#include "core/image/Morph.h"
+#include "core/image/Convert.h"
+#include "core/image/Histogram.h"
+#include "core/image/ImageFile.h"
+#include "core/optimization/blackbox/CostFunction.h"
+#include "core/optimization/blackbox/SimpleOptProblem.h"
+#include "core/optimization/blackbox/DownhillSimplexOptimizer.h"
+#include "core/optimization/gradientBased/OptimizationProblemFirst.h"
+#include "core/optimization/gradientBased/FirstOrderRasmussen.h"
+#include "core/optimization/gradientBased/FirstOrderTrustRegion.h"
+
+using namespace std;
+using namespace NICE;
+
+namespace {
+
+Matrix randomMatrix ( int rows, int cols )
+{
+  Matrix A ( rows, cols );
+  for ( int i = 0 ; i < rows ; i++ )
+    for ( int j = 0 ; j < cols ; j++ )
+      A(i,j) = randDouble();
+  return A;
+}
+
+/** random symmetric positive definite matrix */
+Matrix randomSPDMatrix ( int n )
+{
+  Matrix B = randomMatrix ( n, n );
+  Matrix A = B * B.transpose();
+  A.addIdentity ( n );
+  return A;
+}
+
+Image randomImage ( int width, int height )
+{
+  Image image ( width, height );
+  for ( int y = 0 ; y < height ; y++ )
+    for ( int x = 0 ; x < width ; x++ )
+      image.setPixelQuick ( x, y, (Ipp8u) ( ( x * 7 + y * 13 + ( x * y ) % 31 ) & 0xFF ) );
+  return image;
+}
+
+// ------------------------------------------------------------------ vector
+
+class GEMMBenchmark : public BenchmarkCase
+{
+    int n;
+    Matrix A, B, C;
+  public:
+    GEMMBenchmark ( int n ) : BenchmarkCase ( "vector", "GEMM " + itostr ( n ) ), n ( n ) {}
+    void setUp () { A = randomMatrix ( n, n ); B = randomMatrix ( n, n ); C.resize ( n, n ); }
+    void run () { C.multiply ( A, B ); keep ( C(0,0) ); }
+};
+
+class GEMVBenchmark : public BenchmarkCase
+{
+    int n;
+    Matrix A;
+    Vector x, y;
+  public:
+    GEMVBenchmark ( int n ) : BenchmarkCase ( "vector", "GEMV " + itostr ( n ) ), n ( n ) {}
+    void setUp () { A = randomMatrix ( n, n ); x = Vector ( n, 1.0 ); y.resize ( n ); }
+    void run () { y.multiply ( A, x ); keep ( y[0] ); }
+};
+
+class CholeskyBenchmark : public BenchmarkCase
+{
+    int n;
+    Matrix A, G;
+  public:
+    CholeskyBenchmark ( int n ) : BenchmarkCase ( "vector", "Cholesky " + itostr ( n ) ), n ( n ) {}
+    void setUp () { A = randomSPDMatrix ( n ); }
+    void run () { choleskyDecomp ( A, G ); keep ( G(0,0) ); }
+};
+
+// ------------------------------------------------------------------ algebra
+
+class ILSBenchmark : public BenchmarkCase
+{
+    int n;
+    IterativeLinearSolver *solver;
+    Matrix A;
+    GMStandard *gm;
+    Vector b, x;
+  public:
+    ILSBenchmark ( const std::string & name, IterativeLinearSolver *solver, int n )
+      : BenchmarkCase ( "algebra", name + " " + itostr ( n ) ), n ( n ), solver ( solver ), gm ( NULL ) {}
+    ~ILSBenchmark () { delete solver; }
+    void setUp () { A = randomSPDMatrix ( n ); gm = new GMStandard ( A ); b = Vector ( n, 1.0 ); }
+    void run () { x = Vector ( n, 0.0 ); solver->solveLin ( *gm, b, x ); keep ( x[0] ); }
+    void tearDown () { delete gm; gm = NULL; }
+};
+
+// ------------------------------------------------------------------ image
+
+class GaussFilterBenchmark : public BenchmarkCase
+{
+    ImageT<double> src, dst;
+  public:
+    GaussFilterBenchmark () : BenchmarkCase ( "image", "FilterT::filterGaussSigmaApproximate 640x480" ) {}
+    void setUp () {
+      Image image = randomImage ( 640, 480 );
+      src.resize ( 640, 480 );
+      for ( int y = 0 ; y < 480 ; y++ )
+        for ( int x = 0 ; x < 640 ; x++ )
+          src.setPixelQuick ( x, y, image.getPixelQuick ( x, y ) );
+      dst.resize ( 640, 480 );
+    }
+    void run () {
+      FilterT<double, double, double> filter;
+      filter.filterGaussSigmaApproximate ( src, 3.0, &dst );
+      keep ( dst.getPixelQuick ( 10, 10 ) );
+    }
+};
+
+class SobelBenchmark : public BenchmarkCase
+{
+    Image src;
+    ImageT<double> dst;
+  public:
+    SobelBenchmark () : BenchmarkCase ( "image", "FilterT::sobelX 640x480" ) {}
+    void setUp () { src = randomImage ( 640, 480 ); dst.resize ( 640, 480 ); }
+    void run () {
+      FilterT<unsigned char, double, double>::sobelX ( src, dst );
+      keep ( dst.getPixelQuick ( 10, 10 ) );
+    }
+};
+
+class MorphBenchmark : public BenchmarkCase
+{
+    Image src, dst;
+  public:
+    MorphBenchmark () : BenchmarkCase ( "image", "Morph::median 640x480" ) {}
+    void setUp () { src = randomImage ( 640, 480 ); dst.resize ( 640, 480 ); }
+    void run () { median ( src, &dst, 1 ); keep ( dst.getPixelQuick ( 10, 10 ) ); }
+};
+
+class ConvertBenchmark : public BenchmarkCase
+{
+    ColorImage src;
+    Image dst;
+  public:
+    ConvertBenchmark () : BenchmarkCase ( "image", "Convert::rgbToGray 640x480" ) {}
+    void setUp () {
+      src.resize ( 640, 480 );
+      for ( int y = 0 ; y < 480 ; y++ )
+        for ( int x = 0 ; x < 640 ; x++ )
+          src.setPixelQuick ( x, y, x & 0xFF, y & 0xFF, ( x + y ) & 0xFF );
+      dst.resize ( 640, 480 );
+    }
+    void run () { rgbToGray ( src, &dst ); keep ( dst.getPixelQuick ( 10, 10 ) ); }
+};
+
+class HistogramBenchmark : public BenchmarkCase
+{
+    Image src;
+  public:
+    HistogramBenchmark () : BenchmarkCase ( "image", "Histogram 640x480" ) {}
+    void setUp () { src = randomImage ( 640, 480 ); }
+    void run () { Histogram h ( src, 0, 256 ); keep ( h[0] ); }
+};
+
+class ImageFileBenchmark : public BenchmarkCase
+{
+    std::string filename;
+  public:
+    ImageFileBenchmark ( const std::string & extension )
+      : BenchmarkCase ( "image", "ImageFile::reader 640x480 " + extension ), filename ( "nice_core_bench." + extension ) {}
+    void setUp () { ColorImage c ( 640, 480 ); c.set ( 17, 42, 99 ); c.write ( ImageFile ( filename ) ); }
+    void run () { ColorImage c; c.read ( ImageFile ( filename ) ); keep ( c.getPixelQuick ( 1, 1, 0 ) ); }
+    void tearDown () { remove ( filename.c_str() ); }
+};
+
+// ------------------------------------------------------------------ optimization
+
+/** Rosenbrock function */
+class RosenbrockCostFunction : public OPTIMIZATION::CostFunction
+{
+  public:
+    RosenbrockCostFunction ( int dim ) : CostFunction ( dim ) {}
+    double evaluate ( const OPTIMIZATION::matrix_type & x )
+    {
+      double f = 0.0;
+      for ( unsigned int i = 0 ; i + 1 < x.rows() ; i++ )
+        f += 100.0 * square ( x(i+1,0) - square ( x(i,0) ) ) + square ( 1.0 - x(i,0) );
+      return f;
+    }
+};
+
+class DownhillSimplexBenchmark : public BenchmarkCase
+{
+    int dim;
+  public:
+    DownhillSimplexBenchmark ( int dim ) : BenchmarkCase ( "optimization", "DownhillSimplex Rosenbrock " + itostr ( dim ) ), dim ( dim ) {}
+    void run () {
+      RosenbrockCostFunction cost ( dim );
+      OPTIMIZATION::matrix_type initialParams ( dim, 1, 0.0 );
+      OPTIMIZATION::matrix_type scales ( dim, 1, 1.0 );
+      OPTIMIZATION::SimpleOptProblem problem ( &cost, initialParams, scales );
+      OPTIMIZATION::DownhillSimplexOptimizer optimizer;
+      optimizer.setMaxNumIter ( true, 2000 );
+      optimizer.optimizeProb ( problem );
+      keep ( problem.getAllCurrentParams()(0,0) );
+    }
+};
+
+/** ill-conditioned quadratic problem */
+class QuadraticProblem : public OptimizationProblemFirst
+{
+  public:
+    QuadraticProblem ( int dim ) : OptimizationProblemFirst ( dim ) { parameters().set ( 1.0 ); }
+  protected:
+    double computeObjective () {
+      double f = 0.0;
+      for ( unsigned int i = 0 ; i < parameters().size() ; i++ )
+        f += ( i + 1 ) * square ( parameters()[i] - 0.5 );
+      return f;
+    }
+    void computeGradient ( Vector & newGradient ) {
+      for ( unsigned int i = 0 ; i < parameters().size() ; i++ )
+        newGradient[i] = 2.0 * ( i + 1 ) * ( parameters()[i] - 0.5 );
+    }
+};
+
+class RasmussenBenchmark : public BenchmarkCase
+{
+    int dim;
+  public:
+    RasmussenBenchmark ( int dim ) : BenchmarkCase ( "optimization", "FirstOrderRasmussen quadratic " + itostr ( dim ) ), dim ( dim ) {}
+    void run () {
+      QuadraticProblem problem ( dim );
+      FirstOrderRasmussen optimizer ( false );
+      optimizer.setMaxIterations ( 200 );
+      optimizer.optimizeFirst ( problem );
+      keep ( problem.position()[0] );
+    }
+};
+
+/** small problem: the per-iteration overhead of the problem interface dominates */
+class TrustRegionBenchmark : public BenchmarkCase
+{
+    int dim;
+  public:
+    TrustRegionBenchmark ( int dim ) : BenchmarkCase ( "optimization", "FirstOrderTrustRegion quadratic " + itostr ( dim ) ), dim ( dim ) {}
+    void run () {
+      QuadraticProblem problem ( dim );
+      FirstOrderTrustRegion optimizer;
+      optimizer.setEpsilonG ( 1e-8 );
+      optimizer.setMaxIterations ( 2000 );
+      optimizer.optimizeFirst ( problem );
+      keep ( problem.position()[0] );
+    }
+};
+
+}
+
+/**
+  Runs the benchmarks of the core library.
+
+  options:
+  -filter substring    only run benchmarks whose "suite/name" contains the substring
+  -repetitions n       measured repetitions (default 15)
+  -warmup n            warmup repetitions (default 2)
+  -mintime seconds     minimum time of a repetition (default 0.05)
+  -cpu n               pin the process to cpu n
+  -counters            read hardware counters (IPC, cache misses)
+  -json file           write the results as JSON
+  -csv file            write the results as CSV
+  -baseline file       compare with results of a previous run (JSON or CSV)
+  -threshold t         relative slowdown reported as regression (default 0.1)
+
+  The exit code is 2 if a regression was detected.
+*/
+int main ( int argc, char **argv )
+{
+  Log::setLevel ( Log::LEVEL_TIMING );
+  Config conf ( argc, argv );
+
+  BenchmarkRunner runner;
+  runner.setFilter ( conf.gS ( "main", "filter", "" ) );
+  runner.setRepetitions ( conf.gI ( "main", "repetitions", 15 ) );
+  runner.setWarmupRepetitions ( conf.gI ( "main", "warmup", 2 ) );
+  runner.setMinimumTime ( conf.gD ( "main", "mintime", 0.05 ) );
+  runner.setCpu ( conf.gI ( "main", "cpu", -1 ) );
+  runner.setUseHardwareCounters ( conf.gB ( "main", "counters", false ) );
+
+  initRand ( false, 0 );
+
+  runner.add ( new GEMMBenchmark ( 64 ) );
+  runner.add ( new GEMMBenchmark ( 256 ) );
+  runner.add ( new GEMVBenchmark ( 256 ) );
+  runner.add ( new GEMVBenchmark ( 2048 ) );
+  runner.add ( new CholeskyBenchmark ( 128 ) );
+  runner.add ( new CholeskyBenchmark ( 512 ) );
+
+  runner.add ( new ILSBenchmark ( "ILSConjugateGradients", new ILSConjugateGradients ( false, 200 ), 500 ) );
+  runner.add ( new ILSBenchmark ( "ILSMinResLanczos", new ILSMinResLanczos ( false, 200 ), 500 ) );
+  runner.add ( new ILSBenchmark ( "ILSSymmLqLanczos", new ILSSymmLqLanczos ( false, 200 ), 500 ) );
+
+  runner.add ( new GaussFilterBenchmark() );
+  runner.add ( new SobelBenchmark() );
+  runner.add ( new MorphBenchmark() );
+  runner.add ( new ConvertBenchmark() );
+  runner.add ( new HistogramBenchmark() );
+  runner.add ( new ImageFileBenchmark ( "ppm" ) );
+#ifdef NICE_USELIB_PNG
+  runner.add ( new ImageFileBenchmark ( "png" ) );
+#endif
+#ifdef NICE_USELIB_JPEG
+  runner.add ( new ImageFileBenchmark ( "jpg" ) );
+#endif
+
+  runner.add ( new DownhillSimplexBenchmark ( 4 ) );
+  runner.add ( new RasmussenBenchmark ( 100 ) );
+  runner.add ( new TrustRegionBenchmark ( 10 ) );
+
+  runner.run ( cerr );
+
+  std::string jsonFile = conf.gS ( "main", "json", "" );
+  if ( !jsonFile.empty() )
+  {
+    ofstream ofs ( jsonFile.c_str() );
+    runner.writeJSON ( ofs );
+  }
+
+  std::string csvFile = conf.gS ( "main", "csv", "" );
+  if ( !csvFile.empty() )
+  {
+    ofstream ofs ( csvFile.c_str() );
+    runner.writeCSV ( ofs );
+  }
+
+  std::string baselineFile = conf.gS ( "main", "baseline", "" );
+  if ( !baselineFile.empty() )
+  {
+    std::vector<BenchmarkResult> baseline;
+    BenchmarkRunner::readResults ( baselineFile, baseline );
+    size_t regressions = runner.compare ( baseline, conf.gD ( "main", "threshold", 0.1 ), cout );
+    if ( regressions > 0 )
+    {
+      cerr << regressions << " regressions detected" << endl;
+      return 2;
+    }
+  }
+
+  return 0;
+}
@@ -48,6 +48,8 @@ VectorT<T> *eigenvalues(const RowMatrixT<T> &A, VectorT<T> *evals=NULL);
  * @param A symmetric matrix
  * @param evecs eigenvector matrix
  * @param evals vector of eigenvalues (decreasing order)
+ * @note Without IPP, the decomposition is computed by Householder
+ *       tridiagonalization and the implicit QL algorithm, O(n^3).
  */
 template<class T>
 void eigenvectorvalues(const MatrixT<T> &A, MatrixT<T> &evecs, VectorT<T> &evals);
@@ -5,8 +5,236 @@
  */
 #include "core/vector/Eigen.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 namespace NICE {
 
+/*
+ * Eigen decomposition of a symmetric matrix without IPP: Householder
+ * reduction to tridiagonal form and the implicit QL algorithm (tred2 and
+ * tql2 of EISPACK, as in JAMA). O(n^3), the computation is done in double.
+ * V is the row-major matrix (overwritten by the eigenvectors as columns),
+ * d receives the eigenvalues in decreasing order.
+ */
+inline double eigenHypot(double a, double b)
+{
+  a = fabs(a);
+  b = fabs(b);
+  if (a < b)
+    std::swap(a, b);
+  if (a == 0.0)
+    return 0.0;
+  const double r = b / a;
+  return a * sqrt(1.0 + r * r);
+}
+
+inline void eigenSymmetricTridiagonalQL(std::vector<double> &V, std::vector<double> &d,
+                                        size_t n, bool computeVectors)
+{
+  d.resize(n);
+  if (n == 0)
+    return;
+  std::vector<double> e(n, 0.0);
+#define V_(i,j) V[(i)*n+(j)]
+
+  // Householder reduction to tridiagonal form
+  for (size_t j = 0; j < n; j++)
+    d[j] = V_(n-1,j);
+
+  for (size_t i = n-1; i > 0; i--) {
+    double scale = 0.0;
+    double h = 0.0;
+    for (size_t k = 0; k < i; k++)
+      scale += fabs(d[k]);
+    if (scale == 0.0) {
+      e[i] = d[i-1];
+      for (size_t j = 0; j < i; j++) {
+        d[j] = V_(i-1,j);
+        V_(i,j) = 0.0;
+        V_(j,i) = 0.0;
+      }
+    } else {
+      for (size_t k = 0; k < i; k++) {
+        d[k] /= scale;
+        h += d[k] * d[k];
+      }
+      double f = d[i-1];
+      double g = sqrt(h);
+      if (f > 0)
+        g = -g;
+      e[i] = scale * g;
+      h = h - f * g;
+      d[i-1] = f - g;
+      for (size_t j = 0; j < i; j++)
+        e[j] = 0.0;
+
+      for (size_t j = 0; j < i; j++) {
+        f = d[j];
+        V_(j,i) = f;
+        g = e[j] + V_(j,j) * f;
+        for (size_t k = j+1; k <= i-1; k++) {
+          g += V_(k,j) * d[k];
+          e[k] += V_(k,j) * f;
+        }
+        e[j] = g;
+      }
+      f = 0.0;
+      for (size_t j = 0; j < i; j++) {
+        e[j] /= h;
+        f += e[j] * d[j];
+      }
+      const double hh = f / (h + h);
+      for (size_t j = 0; j < i; j++)
+        e[j] -= hh * d[j];
+      for (size_t j = 0; j < i; j++) {
+        f = d[j];
+        g = e[j];
+        for (size_t k = j; k <= i-1; k++)
+          V_(k,j) -= (f * e[k] + g * d[k]);
+        d[j] = V_(i-1,j);
+        V_(i,j) = 0.0;
+      }
+    }
+    d[i] = h;
+  }
+
+  // accumulate the transformations
+  for (size_t i = 0; i + 1 < n; i++) {
+    V_(n-1,i) = V_(i,i);
+    V_(i,i) = 1.0;
+    const double h = d[i+1];
+    if (h != 0.0) {
+      for (size_t k = 0; k <= i; k++)
+        d[k] = V_(k,i+1) / h;
+      for (size_t j = 0; j <= i; j++) {
+        double g = 0.0;
+        for (size_t k = 0; k <= i; k++)
+          g += V_(k,i+1) * V_(k,j);
+        for (size_t k = 0; k <= i; k++)
+          V_(k,j) -= g * d[k];
+      }
+    }
+    for (size_t k = 0; k <= i; k++)
+      V_(k,i+1) = 0.0;
+  }
+  for (size_t j = 0; j < n; j++) {
+    d[j] = V_(n-1,j);
+    V_(n-1,j) = 0.0;
+  }
+  V_(n-1,n-1) = 1.0;
+  e[0] = 0.0;
+
+  // implicit QL iterations on the tridiagonal matrix
+  for (size_t i = 1; i < n; i++)
+    e[i-1] = e[i];
+  e[n-1] = 0.0;
+
+  double f = 0.0;
+  double tst1 = 0.0;
+  const double eps = std::numeric_limits<double>::epsilon();
+  for (size_t l = 0; l < n; l++) {
+    tst1 = std::max(tst1, fabs(d[l]) + fabs(e[l]));
+    size_t m = l;
+    while (m < n-1 && fabs(e[m]) > eps * tst1)
+      m++;
+
+    if (m > l) {
+      int iter = 0;
+      do {
+        if (++iter > 60)
+          fthrow(Exception, "eigen decomposition: QL iteration does not converge.");
+
+        double g = d[l];
+        double p = (d[l+1] - g) / (2.0 * e[l]);
+        double r = eigenHypot(p, 1.0);
+        if (p < 0)
+          r = -r;
+        d[l] = e[l] / (p + r);
+        d[l+1] = e[l] * (p + r);
+        const double dl1 = d[l+1];
+        double h = g - d[l];
+        for (size_t i = l+2; i < n; i++)
+          d[i] -= h;
+        f += h;
+
+        p = d[m];
+        double c = 1.0;
+        double c2 = c;
+        double c3 = c;
+        const double el1 = e[l+1];
+        double s = 0.0;
+        double s2 = 0.0;
+        for (size_t i = m; i-- > l; ) {
+          c3 = c2;
+          c2 = c;
+          s2 = s;
+          g = c * e[i];
+          h = c * p;
+          r = eigenHypot(p, e[i]);
+          e[i+1] = s * r;
+          s = e[i] / r;
+          c = p / r;
+          p = c * d[i] - s * g;
+          d[i+1] = h + s * (c * g + s * d[i]);
+          if (computeVectors) {
+            for (size_t k = 0; k < n; k++) {
+              h = V_(k,i+1);
+              V_(k,i+1) = s * V_(k,i) + c * h;
+              V_(k,i) = c * V_(k,i) - s * h;
+            }
+          }
+        }
+        p = -s * s2 * c3 * el1 * e[l] / dl1;
+        e[l] = s * p;
+        d[l] = c * p;
+      } while (fabs(e[l]) > eps * tst1);
+    }
+    d[l] += f;
+    e[l] = 0.0;
+  }
+
+  // sort in decreasing order
+  for (size_t i = 0; i + 1 < n; i++) {
+    size_t k = i;
+    for (size_t j = i+1; j < n; j++)
+      if (d[j] > d[k])
+        k = j;
+    if (k != i) {
+      std::swap(d[i], d[k]);
+      if (computeVectors)
+        for (size_t j = 0; j < n; j++)
+          std::swap(V_(j,i), V_(j,k));
+    }
+  }
+#undef V_
+}
+
+/*
+ * Eigenvalues and (optionally) eigenvectors of a symmetric MatrixT or
+ * RowMatrixT with eigenSymmetricTridiagonalQL().
+ */
+template<class M, class T>
+void eigenSymmetricFallback(const M &A, M *evecs, VectorT<T> &evals)
+{
+  const size_t n = A.rows();
+  std::vector<double> V(n * n);
+  for (size_t i = 0; i < n; i++)
+    for (size_t j = 0; j < n; j++)
+      V[i*n+j] = static_cast<double>(A(i,j));
+
+  std::vector<double> d;
+  eigenSymmetricTridiagonalQL(V, d, n, evecs != NULL);
+
+  for (size_t i = 0; i < n; i++)
+    evals[i] = static_cast<T>(d[i]);
+  if (evecs != NULL)
+    for (size_t i = 0; i < n; i++)
+      for (size_t j = 0; j < n; j++)
+        (*evecs)(i,j) = static_cast<T>(V[i*n+j]);
+}
+
 template<class T>
 VectorT<T> maxEigenVector(const MatrixT<T>& a) {
   if (a.rows() != a.cols()) {
@@ -39,6 +267,7 @@ VectorT<T> *eigenvalues(const MatrixT<T> &A, VectorT<T> *evals)
         evals=new VectorT<T>(vsize);
     if(evals->size()!=vsize)
         fthrow(Exception,"vectorsize != vsize.");
+#ifdef NICE_USELIB_IPP
     T buffer[vsize*vsize];
     size_t tsize=sizeof(T);
     IppStatus ret = ippmEigenValuesSym_m(A.getDataPointer(), vsize*tsize, tsize, buffer, evals->getDataPointer(), vsize);
@@ -48,6 +277,9 @@ VectorT<T> *eigenvalues(const MatrixT<T> &A, VectorT<T> *evals)
 	*/
 	if(ret!=ippStsNoErr)
 	   _THROW_EVector(ippGetStatusString(ret));
+#else
+    eigenSymmetricFallback(A, static_cast<MatrixT<T>*>(NULL), *evals);
+#endif
     return evals;
 }
 
@@ -57,10 +289,11 @@ void eigenvectorvalues(const MatrixT<T> &A, MatrixT<T> &evecs,  VectorT<T> &eval
     size_t vsize=A.cols();
     if(A.rows()!=vsize)
         fthrow(Exception,"Matrix must be a squarematrix.");
-    if(evecs.rows() != vsize && evecs.cols() != vsize)
+    if(evecs.rows() != vsize || evecs.cols() != vsize)
         evecs.resize(vsize,vsize);
     if(evals.size()!=vsize)
         evals.resize(vsize);
+#ifdef NICE_USELIB_IPP
     T *buffer = new T[vsize*vsize];
     size_t tsize=sizeof(T);
     IppStatus ret = ippmEigenValuesVectorsSym_m(A.getDataPointer(), vsize*tsize, tsize, buffer,
@@ -69,6 +302,9 @@ void eigenvectorvalues(const MatrixT<T> &A, MatrixT<T> &evecs,  VectorT<T> &eval
 	delete [] buffer;
 	if(ret!=ippStsNoErr)
 	   _THROW_EVector(ippGetStatusString(ret));
+#else
+    eigenSymmetricFallback(A, &evecs, evals);
+#endif
 }
 
 template<class T>
@@ -81,6 +317,7 @@ VectorT<T> *eigenvalues(const RowMatrixT<T> &A, VectorT<T> *evals)
         evals=new VectorT<T>(vsize);
     if(evals->size()!=vsize)
         fthrow(Exception,"vectorsize != vsize.");
+#ifdef NICE_USELIB_IPP
     T buffer[vsize*vsize];
     size_t tsize=sizeof(T);
     IppStatus ret = ippmEigenValuesSym_m(A.getDataPointer(), vsize*tsize, tsize, buffer, evals->getDataPointer(), vsize);
@@ -90,6 +327,9 @@ VectorT<T> *eigenvalues(const RowMatrixT<T> &A, VectorT<T> *evals)
 	*/
 	if(ret!=ippStsNoErr)
 	   _THROW_EVector(ippGetStatusString(ret));
+#else
+    eigenSymmetricFallback(A, static_cast<RowMatrixT<T>*>(NULL), *evals);
+#endif
     return evals;
 }
 
@@ -99,16 +339,20 @@ void eigenvectorvalues(const RowMatrixT<T> &A, RowMatrixT<T> &evecs,  VectorT<T>
     size_t vsize=A.cols();
     if(A.rows()!=vsize)
         fthrow(Exception,"Matrix must be a squarematrix.");
-    if(evecs.rows() != vsize && evecs.cols() != vsize)
+    if(evecs.rows() != vsize || evecs.cols() != vsize)
         evecs.resize(vsize,vsize);
     if(evals.size()!=vsize)
         evals.resize(vsize);
+#ifdef NICE_USELIB_IPP
     T buffer[vsize*vsize];
     size_t tsize=sizeof(T);
     IppStatus ret = ippmEigenValuesVectorsSym_m(A.getDataPointer(), vsize*tsize, tsize, buffer,
                                                 evecs.getDataPointer(), vsize*tsize, tsize, evals.getDataPointer(), vsize);
 	if(ret!=ippStsNoErr)
 	   _THROW_EVector(ippGetStatusString(ret));
+#else
+    eigenSymmetricFallback(A, &evecs, evals);
+#endif
 }
 
 }
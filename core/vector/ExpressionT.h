@@ -0,0 +1,513 @@
+/**
+* @file ExpressionT.h
+* @brief lazy element-wise expressions of vectors and matrices, transposes as views
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_EXPRESSIONTINCLUDE
+#define _NICE_EXPRESSIONTINCLUDE
+
+#include <cstddef>
+
+#include "core/basics/Exception.h"
+
+namespace NICE {
+
+template<class ElementType>
+class VectorT;
+template<class ElementType>
+class MatrixT;
+
+/**
+ * @class VectorExpression
+ * @brief Base class (CRTP) of lazy element-wise vector expressions.
+ *
+ * The operators of VectorT return vectors and create one temporary per
+ * operation. Expressions are only built if at least one operand is wrapped
+ * by lazy(), and they are evaluated by the constructor or the assignment of
+ * VectorT in a single loop without any temporary:
+ * @code
+ *   x = lazy(b) + lazy(c) * s - lazy(d);
+ * @endcode
+ * Operands are referenced, so they must outlive the expression.
+ */
+template<class E>
+class VectorExpression
+{
+  public:
+    const E & derived () const { return static_cast<const E &> ( *this ); };
+
+    size_t size () const { return derived().size(); };
+
+    /** true if the expression reads memory of [begin,end) */
+    bool reads ( const void *begin, const void *end ) const { return derived().reads ( begin, end ); };
+
+    /**
+    * @brief true if writing the result to [begin,end) while evaluating
+    * overwrites elements which are read later
+    */
+    bool conflicts ( const void *begin, const void *end ) const { return derived().conflicts ( begin, end ); };
+
+    /** write all elements to dst */
+    template<class T>
+    void evaluateTo ( T *dst ) const
+    {
+      const E & e = derived();
+      const size_t n = e.size();
+      for ( size_t i = 0 ; i < n ; i++ )
+        dst[i] = e[i];
+    };
+};
+
+/** @brief leaf of a vector expression: the elements of a VectorT */
+template<class T>
+class VectorTerm : public VectorExpression< VectorTerm<T> >
+{
+  public:
+    typedef T value_type;
+
+    VectorTerm ( const VectorT<T> & v ) : data ( v.getDataPointer() ), n ( v.size() ) {};
+
+    size_t size () const { return n; };
+
+    T operator[] ( size_t i ) const { return data[i]; };
+
+    bool reads ( const void *begin, const void *end ) const
+    {
+      return ( n > 0 ) && ( (const void *)data < end ) && ( (const void *)( data + n ) > begin );
+    };
+
+    bool conflicts ( const void *begin, const void *end ) const
+    {
+      // element i is only read before element i is written
+      return ( begin != (const void *)data ) && reads ( begin, end );
+    };
+
+  private:
+    const T *data;
+    size_t n;
+};
+
+//! element-wise operations of the expressions
+struct ExpressionAdd
+{
+  template<class T>
+  static T apply ( const T & a, const T & b ) { return a + b; };
+};
+
+struct ExpressionSubtract
+{
+  template<class T>
+  static T apply ( const T & a, const T & b ) { return a - b; };
+};
+
+/** @brief element-wise binary operation of two vector expressions */
+template<class L, class R, class Op>
+class VectorBinary : public VectorExpression< VectorBinary<L, R, Op> >
+{
+  public:
+    typedef typename L::value_type value_type;
+
+    VectorBinary ( const L & l, const R & r ) : l ( l ), r ( r )
+    {
+      if ( l.size() != r.size() )
+        fthrow ( Exception, "VectorExpression: vectors have different sizes (" << l.size() << " != " << r.size() << ")" );
+    };
+
+    size_t size () const { return l.size(); };
+
+    value_type operator[] ( size_t i ) const { return Op::apply ( l[i], (value_type)r[i] ); };
+
+    bool reads ( const void *begin, const void *end ) const { return l.reads ( begin, end ) || r.reads ( begin, end ); };
+
+    bool conflicts ( const void *begin, const void *end ) const { return l.conflicts ( begin, end ) || r.conflicts ( begin, end ); };
+
+  private:
+    L l;
+    R r;
+};
+
+/** @brief vector expression multiplied with a scalar */
+template<class E>
+class VectorScaled : public VectorExpression< VectorScaled<E> >
+{
+  public:
+    typedef typename E::value_type value_type;
+
+    VectorScaled ( const E & e, double s ) : e ( e ), s ( s ) {};
+
+    size_t size () const { return e.size(); };
+
+    value_type operator[] ( size_t i ) const { return (value_type)( e[i] * s ); };
+
+    bool reads ( const void *begin, const void *end ) const { return e.reads ( begin, end ); };
+
+    bool conflicts ( const void *begin, const void *end ) const { return e.conflicts ( begin, end ); };
+
+  private:
+    E e;
+    double s;
+};
+
+/** @brief wrap a vector such that the following operators build a lazy expression */
+template<class T>
+inline VectorTerm<T> lazy ( const VectorT<T> & v )
+{
+  return VectorTerm<T> ( v );
+}
+
+template<class L, class R>
+inline VectorBinary<L, R, ExpressionAdd> operator+ ( const VectorExpression<L> & l, const VectorExpression<R> & r )
+{
+  return VectorBinary<L, R, ExpressionAdd> ( l.derived(), r.derived() );
+}
+
+template<class L, class T>
+inline VectorBinary<L, VectorTerm<T>, ExpressionAdd> operator+ ( const VectorExpression<L> & l, const VectorT<T> & r )
+{
+  return VectorBinary<L, VectorTerm<T>, ExpressionAdd> ( l.derived(), VectorTerm<T> ( r ) );
+}
+
+template<class T, class R>
+inline VectorBinary<VectorTerm<T>, R, ExpressionAdd> operator+ ( const VectorT<T> & l, const VectorExpression<R> & r )
+{
+  return VectorBinary<VectorTerm<T>, R, ExpressionAdd> ( VectorTerm<T> ( l ), r.derived() );
+}
+
+template<class L, class R>
+inline VectorBinary<L, R, ExpressionSubtract> operator- ( const VectorExpression<L> & l, const VectorExpression<R> & r )
+{
+  return VectorBinary<L, R, ExpressionSubtract> ( l.derived(), r.derived() );
+}
+
+template<class L, class T>
+inline VectorBinary<L, VectorTerm<T>, ExpressionSubtract> operator- ( const VectorExpression<L> & l, const VectorT<T> & r )
+{
+  return VectorBinary<L, VectorTerm<T>, ExpressionSubtract> ( l.derived(), VectorTerm<T> ( r ) );
+}
+
+template<class T, class R>
+inline VectorBinary<VectorTerm<T>, R, ExpressionSubtract> operator- ( const VectorT<T> & l, const VectorExpression<R> & r )
+{
+  return VectorBinary<VectorTerm<T>, R, ExpressionSubtract> ( VectorTerm<T> ( l ), r.derived() );
+}
+
+template<class E>
+inline VectorScaled<E> operator* ( const VectorExpression<E> & e, double s )
+{
+  return VectorScaled<E> ( e.derived(), s );
+}
+
+template<class E>
+inline VectorScaled<E> operator* ( double s, const VectorExpression<E> & e )
+{
+  return VectorScaled<E> ( e.derived(), s );
+}
+
+template<class E>
+inline VectorScaled<E> operator/ ( const VectorExpression<E> & e, double s )
+{
+  return VectorScaled<E> ( e.derived(), 1.0 / s );
+}
+
+template<class E>
+inline VectorScaled<E> operator- ( const VectorExpression<E> & e )
+{
+  return VectorScaled<E> ( e.derived(), -1.0 );
+}
+
+/**
+ * @class MatrixExpression
+ * @brief Base class (CRTP) of lazy element-wise matrix expressions.
+ *
+ * Works like VectorExpression. Additionally, transposed() is a view which does
+ * not copy the matrix. Expressions without transposes (LINEAR) are evaluated
+ * in a single loop over the column-major data, the others column by column.
+ * @code
+ *   C = lazy(A) + transposed(B) * 0.5;
+ *   y = transposed(A) * x;    // no copy of A, uses y.multiply(A, x, true)
+ * @endcode
+ */
+template<class E>
+class MatrixExpression
+{
+  public:
+    const E & derived () const { return static_cast<const E &> ( *this ); };
+
+    size_t rows () const { return derived().rows(); };
+
+    size_t cols () const { return derived().cols(); };
+
+    /** true if the expression reads memory of [begin,end) */
+    bool reads ( const void *begin, const void *end ) const { return derived().reads ( begin, end ); };
+
+    /**
+    * @brief true if writing the result to [begin,end) while evaluating
+    * overwrites elements which are read later
+    */
+    bool conflicts ( const void *begin, const void *end ) const { return derived().conflicts ( begin, end ); };
+
+    /** write all elements column-major to dst */
+    template<class T>
+    void evaluateTo ( T *dst ) const
+    {
+      const E & e = derived();
+      const size_t m = e.rows();
+      const size_t n = e.cols();
+      if ( E::LINEAR )
+      {
+        for ( size_t k = 0 ; k < m * n ; k++ )
+          dst[k] = e.linear ( k );
+      } else {
+        for ( size_t j = 0 ; j < n ; j++, dst += m )
+          for ( size_t i = 0 ; i < m ; i++ )
+            dst[i] = e ( i, j );
+      }
+    };
+};
+
+/** @brief leaf of a matrix expression: the elements of a MatrixT */
+template<class T>
+class MatrixTerm : public MatrixExpression< MatrixTerm<T> >
+{
+  public:
+    typedef T value_type;
+    enum { LINEAR = 1 };
+
+    MatrixTerm ( const MatrixT<T> & m ) : matrix ( &m ), data ( m.getDataPointer() ), m ( m.rows() ), n ( m.cols() ) {};
+
+    size_t rows () const { return m; };
+
+    size_t cols () const { return n; };
+
+    T operator() ( size_t i, size_t j ) const { return data[j * m + i]; };
+
+    T linear ( size_t k ) const { return data[k]; };
+
+    bool reads ( const void *begin, const void *end ) const
+    {
+      return ( m * n > 0 ) && ( (const void *)data < end ) && ( (const void *)( data + m * n ) > begin );
+    };
+
+    bool conflicts ( const void *begin, const void *end ) const
+    {
+      // element (i,j) is only read before (i,j) of the same layout is written
+      return ( begin != (const void *)data ) && reads ( begin, end );
+    };
+
+    const MatrixT<T> & getMatrix () const { return *matrix; };
+
+  private:
+    const MatrixT<T> *matrix;
+    const T *data;
+    size_t m;
+    size_t n;
+};
+
+/** @brief transposed view of a matrix expression */
+template<class E>
+class MatrixTransposed : public MatrixExpression< MatrixTransposed<E> >
+{
+  public:
+    typedef typename E::value_type value_type;
+    enum { LINEAR = 0 };
+
+    MatrixTransposed ( const E & e ) : e ( e ) {};
+
+    size_t rows () const { return e.cols(); };
+
+    size_t cols () const { return e.rows(); };
+
+    value_type operator() ( size_t i, size_t j ) const { return e ( j, i ); };
+
+    value_type linear ( size_t k ) const { return e ( k / rows(), k % rows() ); };
+
+    bool reads ( const void *begin, const void *end ) const { return e.reads ( begin, end ); };
+
+    bool conflicts ( const void *begin, const void *end ) const { return e.reads ( begin, end ); };
+
+    const E & getExpression () const { return e; };
+
+  private:
+    E e;
+};
+
+/** @brief element-wise binary operation of two matrix expressions */
+template<class L, class R, class Op>
+class MatrixBinary : public MatrixExpression< MatrixBinary<L, R, Op> >
+{
+  public:
+    typedef typename L::value_type value_type;
+    enum { LINEAR = L::LINEAR && R::LINEAR };
+
+    MatrixBinary ( const L & l, const R & r ) : l ( l ), r ( r )
+    {
+      if ( ( l.rows() != r.rows() ) || ( l.cols() != r.cols() ) )
+        fthrow ( Exception, "MatrixExpression: matrices have different sizes ("
+                 << l.rows() << "x" << l.cols() << " != " << r.rows() << "x" << r.cols() << ")" );
+    };
+
+    size_t rows () const { return l.rows(); };
+
+    size_t cols () const { return l.cols(); };
+
+    value_type operator() ( size_t i, size_t j ) const { return Op::apply ( l ( i, j ), (value_type)r ( i, j ) ); };
+
+    value_type linear ( size_t k ) const { return Op::apply ( l.linear ( k ), (value_type)r.linear ( k ) ); };
+
+    bool reads ( const void *begin, const void *end ) const { return l.reads ( begin, end ) || r.reads ( begin, end ); };
+
+    bool conflicts ( const void *begin, const void *end ) const { return l.conflicts ( begin, end ) || r.conflicts ( begin, end ); };
+
+  private:
+    L l;
+    R r;
+};
+
+/** @brief matrix expression multiplied with a scalar */
+template<class E>
+class MatrixScaled : public MatrixExpression< MatrixScaled<E> >
+{
+  public:
+    typedef typename E::value_type value_type;
+    enum { LINEAR = E::LINEAR };
+
+    MatrixScaled ( const E & e, double s ) : e ( e ), s ( s ) {};
+
+    size_t rows () const { return e.rows(); };
+
+    size_t cols () const { return e.cols(); };
+
+    value_type operator() ( size_t i, size_t j ) const { return (value_type)( e ( i, j ) * s ); };
+
+    value_type linear ( size_t k ) const { return (value_type)( e.linear ( k ) * s ); };
+
+    bool reads ( const void *begin, const void *end ) const { return e.reads ( begin, end ); };
+
+    bool conflicts ( const void *begin, const void *end ) const { return e.conflicts ( begin, end ); };
+
+  private:
+    E e;
+    double s;
+};
+
+/** @brief wrap a matrix such that the following operators build a lazy expression */
+template<class T>
+inline MatrixTerm<T> lazy ( const MatrixT<T> & m )
+{
+  return MatrixTerm<T> ( m );
+}
+
+/** @brief transposed view of a matrix (no copy, unlike MatrixT::transpose()) */
+template<class T>
+inline MatrixTransposed< MatrixTerm<T> > transposed ( const MatrixT<T> & m )
+{
+  return MatrixTransposed< MatrixTerm<T> > ( MatrixTerm<T> ( m ) );
+}
+
+/** @brief transposed view of a matrix expression */
+template<class E>
+inline MatrixTransposed<E> transposed ( const MatrixExpression<E> & e )
+{
+  return MatrixTransposed<E> ( e.derived() );
+}
+
+template<class L, class R>
+inline MatrixBinary<L, R, ExpressionAdd> operator+ ( const MatrixExpression<L> & l, const MatrixExpression<R> & r )
+{
+  return MatrixBinary<L, R, ExpressionAdd> ( l.derived(), r.derived() );
+}
+
+template<class L, class T>
+inline MatrixBinary<L, MatrixTerm<T>, ExpressionAdd> operator+ ( const MatrixExpression<L> & l, const MatrixT<T> & r )
+{
+  return MatrixBinary<L, MatrixTerm<T>, ExpressionAdd> ( l.derived(), MatrixTerm<T> ( r ) );
+}
+
+template<class T, class R>
+inline MatrixBinary<MatrixTerm<T>, R, ExpressionAdd> operator+ ( const MatrixT<T> & l, const MatrixExpression<R> & r )
+{
+  return MatrixBinary<MatrixTerm<T>, R, ExpressionAdd> ( MatrixTerm<T> ( l ), r.derived() );
+}
+
+template<class L, class R>
+inline MatrixBinary<L, R, ExpressionSubtract> operator- ( const MatrixExpression<L> & l, const MatrixExpression<R> & r )
+{
+  return MatrixBinary<L, R, ExpressionSubtract> ( l.derived(), r.derived() );
+}
+
+template<class L, class T>
+inline MatrixBinary<L, MatrixTerm<T>, ExpressionSubtract> operator- ( const MatrixExpression<L> & l, const MatrixT<T> & r )
+{
+  return MatrixBinary<L, MatrixTerm<T>, ExpressionSubtract> ( l.derived(), MatrixTerm<T> ( r ) );
+}
+
+template<class T, class R>
+inline MatrixBinary<MatrixTerm<T>, R, ExpressionSubtract> operator- ( const MatrixT<T> & l, const MatrixExpression<R> & r )
+{
+  return MatrixBinary<MatrixTerm<T>, R, ExpressionSubtract> ( MatrixTerm<T> ( l ), r.derived() );
+}
+
+template<class E>
+inline MatrixScaled<E> operator* ( const MatrixExpression<E> & e, double s )
+{
+  return MatrixScaled<E> ( e.derived(), s );
+}
+
+template<class E>
+inline MatrixScaled<E> operator* ( double s, const MatrixExpression<E> & e )
+{
+  return MatrixScaled<E> ( e.derived(), s );
+}
+
+template<class E>
+inline MatrixScaled<E> operator/ ( const MatrixExpression<E> & e, double s )
+{
+  return MatrixScaled<E> ( e.derived(), 1.0 / s );
+}
+
+template<class E>
+inline MatrixScaled<E> operator- ( const MatrixExpression<E> & e )
+{
+  return MatrixScaled<E> ( e.derived(), -1.0 );
+}
+
+/** transposed matrix times vector without copying the matrix */
+template<class T>
+inline VectorT<T> operator* ( const MatrixTransposed< MatrixTerm<T> > & a, const VectorT<T> & x )
+{
+  VectorT<T> y;
+  y.multiply ( a.getExpression().getMatrix(), x, true );
+  return y;
+}
+
+/** product with a transposed matrix without copying the matrix */
+template<class T>
+inline MatrixT<T> operator* ( const MatrixTransposed< MatrixTerm<T> > & a, const MatrixT<T> & b )
+{
+  MatrixT<T> c;
+  c.multiply ( a.getExpression().getMatrix(), b, true, false );
+  return c;
+}
+
+/** product with a transposed matrix without copying the matrix */
+template<class T>
+inline MatrixT<T> operator* ( const MatrixT<T> & a, const MatrixTransposed< MatrixTerm<T> > & b )
+{
+  MatrixT<T> c;
+  c.multiply ( a, b.getExpression().getMatrix(), false, true );
+  return c;
+}
+
+/** product of two transposed matrices without copying the matrices */
+template<class T>
+inline MatrixT<T> operator* ( const MatrixTransposed< MatrixTerm<T> > & a, const MatrixTransposed< MatrixTerm<T> > & b )
+{
+  MatrixT<T> c;
+  c.multiply ( a.getExpression().getMatrix(), b.getExpression().getMatrix(), true, true );
+  return c;
+}
+
+} // namespace
+
+#endif
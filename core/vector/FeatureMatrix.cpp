@@ -0,0 +1,440 @@
+/**
+* @file FeatureMatrix.cpp
+* @brief contiguous storage of a large set of feature vectors
+* @date 10/19/2026
+*/
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#ifdef WIN32
+#include <malloc.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "FeatureMatrix.h"
+
+using namespace std;
+using namespace NICE;
+
+namespace {
+
+//! alignment of the data in memory (cache line size)
+const size_t alignment = 64;
+
+//! identification of the binary file format
+const char magic[8] = { 'N', 'I', 'C', 'E', 'F', 'M', '0', '1' };
+
+/** header of the binary file format, padded to 64 bytes such that the data in a mapping is aligned */
+struct BinaryHeader
+{
+  char magic[8];
+  unsigned long long rows;
+  unsigned long long dimension;
+  unsigned int elementSize;
+  char padding[ 64 - 8 - 2*sizeof(unsigned long long) - sizeof(unsigned int) ];
+};
+
+double *allocateAligned ( size_t elements )
+{
+  if ( elements == 0 )
+    return NULL;
+#ifdef WIN32
+  void *p = _aligned_malloc ( elements * sizeof(double), alignment );
+  if ( p == NULL )
+    throw std::bad_alloc();
+#else
+  void *p = NULL;
+  if ( posix_memalign ( &p, alignment, elements * sizeof(double) ) != 0 )
+    throw std::bad_alloc();
+#endif
+  return static_cast<double *> ( p );
+}
+
+void freeAligned ( double *p )
+{
+#ifdef WIN32
+  _aligned_free ( p );
+#else
+  free ( p );
+#endif
+}
+
+void checkHeader ( const BinaryHeader & header )
+{
+  if ( memcmp ( header.magic, magic, sizeof(magic) ) != 0 )
+    fthrow ( IOException, "FeatureMatrix: invalid file format" );
+  if ( header.elementSize != sizeof(double) )
+    fthrow ( IOException, "FeatureMatrix: unsupported element size " << header.elementSize );
+}
+
+}
+
+FeatureMatrix::FeatureMatrix ()
+  : m_data ( NULL ), m_rows ( 0 ), m_dimension ( 0 ), m_capacity ( 0 ), m_mapping ( NULL ), m_mappingLength ( 0 )
+{
+}
+
+FeatureMatrix::FeatureMatrix ( size_t rows, size_t dimension )
+  : m_data ( NULL ), m_rows ( 0 ), m_dimension ( 0 ), m_capacity ( 0 ), m_mapping ( NULL ), m_mappingLength ( 0 )
+{
+  resize ( rows, dimension );
+}
+
+FeatureMatrix::FeatureMatrix ( const VVector & v )
+  : m_data ( NULL ), m_rows ( 0 ), m_dimension ( 0 ), m_capacity ( 0 ), m_mapping ( NULL ), m_mappingLength ( 0 )
+{
+  if ( v.empty() )
+    return;
+
+  m_dimension = v[0].size();
+  reserve ( v.size() );
+  for ( VVector::const_iterator i = v.begin(); i != v.end(); i++ )
+    appendRow ( *i );
+}
+
+FeatureMatrix::FeatureMatrix ( const Matrix & m )
+  : m_data ( NULL ), m_rows ( 0 ), m_dimension ( 0 ), m_capacity ( 0 ), m_mapping ( NULL ), m_mappingLength ( 0 )
+{
+  resize ( m.rows(), m.cols() );
+  for ( size_t i = 0 ; i < m_rows ; i++ )
+    for ( size_t k = 0 ; k < m_dimension ; k++ )
+      (*this)(i, k) = m(i, k);
+}
+
+FeatureMatrix::FeatureMatrix ( const FeatureMatrix & other )
+  : Persistent(), m_data ( NULL ), m_rows ( 0 ), m_dimension ( 0 ), m_capacity ( 0 ), m_mapping ( NULL ), m_mappingLength ( 0 )
+{
+  *this = other;
+}
+
+FeatureMatrix & FeatureMatrix::operator= ( const FeatureMatrix & other )
+{
+  if ( this == &other )
+    return *this;
+
+  release();
+  m_dimension = other.m_dimension;
+  reallocate ( other.m_rows );
+  m_rows = other.m_rows;
+  if ( m_rows > 0 )
+    memcpy ( m_data, other.m_data, m_rows * m_dimension * sizeof(double) );
+  return *this;
+}
+
+FeatureMatrix::~FeatureMatrix ()
+{
+  release();
+}
+
+void FeatureMatrix::release ()
+{
+#ifndef WIN32
+  if ( m_mapping != NULL )
+    munmap ( m_mapping, m_mappingLength );
+  else
+#endif
+  if ( m_data != NULL )
+    freeAligned ( m_data );
+
+  m_data = NULL;
+  m_mapping = NULL;
+  m_mappingLength = 0;
+  m_rows = 0;
+  m_capacity = 0;
+}
+
+void FeatureMatrix::reallocate ( size_t capacity )
+{
+  double *data = allocateAligned ( capacity * m_dimension );
+  size_t rows = std::min ( m_rows, capacity );
+  if ( rows > 0 )
+    memcpy ( data, m_data, rows * m_dimension * sizeof(double) );
+
+  size_t dimension = m_dimension;
+  release();
+  m_data = data;
+  m_rows = rows;
+  m_dimension = dimension;
+  m_capacity = capacity;
+}
+
+Vector FeatureMatrix::getRow ( size_t i )
+{
+  if ( i >= m_rows )
+    fthrow ( Exception, "FeatureMatrix::getRow: index " << i << " out of range (" << m_rows << " rows)" );
+  return Vector ( m_data + i * m_dimension, m_dimension, VectorBase::external );
+}
+
+const Vector FeatureMatrix::getRow ( size_t i ) const
+{
+  if ( i >= m_rows )
+    fthrow ( Exception, "FeatureMatrix::getRow: index " << i << " out of range (" << m_rows << " rows)" );
+  return Vector ( m_data + i * m_dimension, m_dimension, VectorBase::external );
+}
+
+Matrix FeatureMatrix::getTransposedMatrixView ()
+{
+  return Matrix ( m_data, m_dimension, m_rows, MatrixBase::external );
+}
+
+void FeatureMatrix::appendRow ( const Vector & v )
+{
+  if ( m_rows == 0 && m_dimension == 0 )
+  {
+    // the first vector defines the dimension of a matrix without a dimension
+    release();
+    m_dimension = v.size();
+  }
+  else if ( v.size() != m_dimension )
+    fthrow ( Exception, "FeatureMatrix::appendRow: dimension of the vector (" << v.size() << ") differs from the dimension of the feature matrix (" << m_dimension << ")" );
+
+  // the vector might be a row of this matrix (see getRow), which moves with
+  // a reallocation: remember its offset instead of the pointer
+  const double *src = v.getDataPointer();
+  bool isOwnRow = ( m_rows > 0 ) && ( src >= m_data ) && ( src < m_data + m_rows * m_dimension );
+  size_t offset = isOwnRow ? ( src - m_data ) : 0;
+
+  // geometric growth, a mapping is always copied into memory first
+  if ( ( m_rows >= m_capacity ) || isMapped() )
+    reallocate ( std::max<size_t> ( 16, 2 * m_capacity ) );
+
+  if ( isOwnRow )
+    src = m_data + offset;
+  memcpy ( m_data + m_rows * m_dimension, src, m_dimension * sizeof(double) );
+  m_rows++;
+}
+
+void FeatureMatrix::append ( const FeatureMatrix & other )
+{
+  if ( other.empty() )
+    return;
+  if ( m_rows == 0 && m_dimension == 0 )
+  {
+    release();
+    m_dimension = other.m_dimension;
+  }
+  else if ( other.m_dimension != m_dimension )
+    fthrow ( Exception, "FeatureMatrix::append: dimensions differ (" << other.m_dimension << " vs " << m_dimension << ")" );
+
+  size_t otherRows = other.m_rows;
+  if ( ( m_rows + otherRows > m_capacity ) || isMapped() )
+    reallocate ( std::max ( m_rows + otherRows, 2 * m_capacity ) );
+  // if the other matrix is this matrix, its rows moved with the reallocation
+  // and are copied behind themselves (no overlap)
+  const double *src = ( &other == this ) ? m_data : other.m_data;
+  memcpy ( m_data + m_rows * m_dimension, src, otherRows * m_dimension * sizeof(double) );
+  m_rows += otherRows;
+}
+
+void FeatureMatrix::reserve ( size_t rows )
+{
+  if ( rows > m_capacity || isMapped() )
+    reallocate ( std::max ( rows, m_rows ) );
+}
+
+void FeatureMatrix::resize ( size_t rows, size_t dimension )
+{
+  release();
+  m_dimension = dimension;
+  reallocate ( rows );
+  m_rows = rows;
+  if ( rows * dimension > 0 )
+    memset ( m_data, 0, rows * dimension * sizeof(double) );
+}
+
+void FeatureMatrix::toVVector ( VVector & v ) const
+{
+  v.clear();
+  v.reserve ( m_rows );
+  for ( size_t i = 0 ; i < m_rows ; i++ )
+    v.push_back ( Vector ( m_data + i * m_dimension, m_dimension ) );
+}
+
+void FeatureMatrix::toMatrix ( Matrix & dst, bool rowOriented ) const
+{
+  if ( rowOriented )
+  {
+    dst.resize ( m_rows, m_dimension );
+    for ( size_t i = 0 ; i < m_rows ; i++ )
+      for ( size_t k = 0 ; k < m_dimension ; k++ )
+        dst(i, k) = (*this)(i, k);
+  } else {
+    // the memory layout of a column-major (dimension x rows) matrix is identical
+    dst.resize ( m_dimension, m_rows );
+    if ( m_rows * m_dimension > 0 )
+      memcpy ( dst.getDataPointer(), m_data, m_rows * m_dimension * sizeof(double) );
+  }
+}
+
+void FeatureMatrix::writeBinary ( const std::string & filename, size_t chunkSize ) const
+{
+  ofstream ofs ( filename.c_str(), ios::out | ios::binary );
+  if ( ! ofs.is_open() )
+    fthrow ( IOException, "FeatureMatrix: unable to write data file " + filename );
+
+  BinaryHeader header;
+  memset ( &header, 0, sizeof(header) );
+  memcpy ( header.magic, magic, sizeof(magic) );
+  header.rows = m_rows;
+  header.dimension = m_dimension;
+  header.elementSize = sizeof(double);
+  ofs.write ( (const char *) &header, sizeof(header) );
+
+  const char *p = (const char *) m_data;
+  size_t remaining = m_rows * m_dimension * sizeof(double);
+  while ( remaining > 0 && ofs.good() )
+  {
+    size_t n = std::min ( remaining, chunkSize );
+    ofs.write ( p, n );
+    p += n;
+    remaining -= n;
+  }
+
+  if ( ! ofs.good() )
+    fthrow ( IOException, "FeatureMatrix: error while writing " + filename );
+}
+
+void FeatureMatrix::readBinary ( const std::string & filename, size_t chunkSize )
+{
+  ifstream ifs ( filename.c_str(), ios::in | ios::binary );
+  if ( ! ifs.is_open() )
+    fthrow ( IOException, "FeatureMatrix: unable to read data file " + filename );
+
+  BinaryHeader header;
+  ifs.read ( (char *) &header, sizeof(header) );
+  if ( ifs.gcount() != (streamsize) sizeof(header) )
+    fthrow ( IOException, "FeatureMatrix: unable to read the header of " + filename );
+  checkHeader ( header );
+
+  release();
+  m_dimension = header.dimension;
+  reallocate ( header.rows );
+
+  char *p = (char *) m_data;
+  size_t remaining = header.rows * header.dimension * sizeof(double);
+  while ( remaining > 0 )
+  {
+    size_t n = std::min ( remaining, chunkSize );
+    ifs.read ( p, n );
+    if ( ifs.gcount() != (streamsize) n )
+      fthrow ( IOException, "FeatureMatrix: unexpected end of file " + filename );
+    p += n;
+    remaining -= n;
+  }
+  m_rows = header.rows;
+}
+
+void FeatureMatrix::mapBinary ( const std::string & filename )
+{
+#ifdef WIN32
+  readBinary ( filename );
+#else
+  int fd = open ( filename.c_str(), O_RDONLY );
+  if ( fd < 0 )
+    fthrow ( IOException, "FeatureMatrix: unable to read data file " + filename );
+
+  struct stat st;
+  if ( fstat ( fd, &st ) != 0 || (size_t)st.st_size < sizeof(BinaryHeader) )
+  {
+    close ( fd );
+    fthrow ( IOException, "FeatureMatrix: unable to read the header of " + filename );
+  }
+
+  size_t length = st.st_size;
+  void *mapping = mmap ( NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+  close ( fd );
+  if ( mapping == MAP_FAILED )
+    fthrow ( IOException, "FeatureMatrix: unable to map " + filename );
+
+  const BinaryHeader & header = *(const BinaryHeader *) mapping;
+  if ( memcmp ( header.magic, magic, sizeof(magic) ) != 0 || header.elementSize != sizeof(double)
+       || length < sizeof(BinaryHeader) + header.rows * header.dimension * sizeof(double) )
+  {
+    munmap ( mapping, length );
+    fthrow ( IOException, "FeatureMatrix: invalid or truncated file " + filename );
+  }
+
+  release();
+  m_mapping = mapping;
+  m_mappingLength = length;
+  m_rows = header.rows;
+  m_dimension = header.dimension;
+  m_capacity = m_rows;
+  m_data = (double *) ( (char *) mapping + sizeof(BinaryHeader) );
+#endif
+}
+
+void FeatureMatrix::clear ()
+{
+  release();
+  m_dimension = 0;
+}
+
+void FeatureMatrix::restore ( std::istream & is, int format )
+{
+  if ( format == FILEFORMAT_BINARY )
+  {
+    BinaryHeader header;
+    is.read ( (char *) &header, sizeof(header) );
+    if ( is.gcount() != (streamsize) sizeof(header) )
+      fthrow ( IOException, "FeatureMatrix: unable to read the header" );
+    checkHeader ( header );
+
+    release();
+    m_dimension = header.dimension;
+    reallocate ( header.rows );
+    size_t bytes = header.rows * header.dimension * sizeof(double);
+    is.read ( (char *) m_data, bytes );
+    if ( is.gcount() != (streamsize) bytes )
+      fthrow ( IOException, "FeatureMatrix: unexpected end of the stream" );
+    m_rows = header.rows;
+  } else if ( format == FILEFORMAT_LINE ) {
+    clear();
+    string line;
+    vector<double> values;
+    while ( getline ( is, line ) )
+    {
+      istringstream ss ( line );
+      values.clear();
+      double val;
+      while ( ss >> val )
+        values.push_back ( val );
+      if ( values.empty() )
+        continue;
+      appendRow ( Vector ( &(values[0]), values.size() ) );
+    }
+  } else {
+    fthrow ( IOException, "FeatureMatrix: unknown file format " << format );
+  }
+}
+
+void FeatureMatrix::store ( std::ostream & os, int format ) const
+{
+  if ( format == FILEFORMAT_BINARY )
+  {
+    BinaryHeader header;
+    memset ( &header, 0, sizeof(header) );
+    memcpy ( header.magic, magic, sizeof(magic) );
+    header.rows = m_rows;
+    header.dimension = m_dimension;
+    header.elementSize = sizeof(double);
+    os.write ( (const char *) &header, sizeof(header) );
+    os.write ( (const char *) m_data, m_rows * m_dimension * sizeof(double) );
+  } else if ( format == FILEFORMAT_LINE ) {
+    for ( size_t i = 0 ; i < m_rows ; i++ )
+    {
+      for ( size_t k = 0 ; k < m_dimension ; k++ )
+        os << (*this)(i, k) << "\t";
+      os << "\n";
+    }
+  } else {
+    fthrow ( IOException, "FeatureMatrix: unknown file format " << format );
+  }
+}
@@ -0,0 +1,183 @@
+/**
+* @file FeatureMatrix.h
+* @brief contiguous storage of a large set of feature vectors
+* @date 10/19/2026
+*/
+#ifndef _NICE_FEATUREMATRIXINCLUDE
+#define _NICE_FEATUREMATRIXINCLUDE
+
+#include <string>
+
+#include "VectorT.h"
+#include "MatrixT.h"
+#include "VVector.h"
+#include "core/basics/Persistent.h"
+
+namespace NICE {
+
+/**
+ * @class FeatureMatrix
+ * @brief Set of feature vectors of equal dimension stored row by row in a single
+ * 64-byte aligned block of memory.
+ *
+ * In contrast to VVector, adding a feature vector does not allocate memory for
+ * each sample (the capacity grows geometrically) and all samples are contiguous.
+ * Rows are accessed as VectorT objects with external storage, and the whole set
+ * is available as a (dimension x rows) NICE::Matrix view without any copy, which
+ * can be directly used for matrix products.
+ *
+ * The binary file format consists of a 64 byte header followed by the row-major
+ * double values. Files are read and written with a single read()/write() call per
+ * chunk, or mapped into memory (mapBinary), such that large datasets are loaded
+ * at disk speed and only the pages actually used are read.
+ */
+class FeatureMatrix : virtual public Persistent
+{
+  protected:
+    //! row-major data
+    double *m_data;
+
+    //! number of feature vectors
+    size_t m_rows;
+
+    //! dimension of the feature vectors
+    size_t m_dimension;
+
+    //! number of feature vectors which fit into the allocated memory
+    size_t m_capacity;
+
+    //! start of the memory mapping (NULL if the data is not mapped)
+    void *m_mapping;
+
+    //! length of the memory mapping in bytes
+    size_t m_mappingLength;
+
+    /** release the memory (or the mapping) */
+    void release ();
+
+    /** move the data into a newly allocated block of memory with the given capacity */
+    void reallocate ( size_t capacity );
+
+  public:
+
+    /** possible file formats of restore and store */
+    enum {
+      /** binary format with header (see class description) */
+      FILEFORMAT_BINARY = 0,
+      /** one feature vector per line, values separated by whitespace */
+      FILEFORMAT_LINE
+    };
+
+    /** empty feature matrix */
+    FeatureMatrix ();
+
+    /** feature matrix of rows zero vectors of the given dimension */
+    FeatureMatrix ( size_t rows, size_t dimension );
+
+    /** copy the feature vectors of a VVector, all vectors need the same dimension */
+    explicit FeatureMatrix ( const VVector & v );
+
+    /** copy the rows of a matrix */
+    explicit FeatureMatrix ( const Matrix & m );
+
+    /** copy constructor (mapped data is copied into memory) */
+    FeatureMatrix ( const FeatureMatrix & other );
+
+    /** assignment (mapped data is copied into memory) */
+    FeatureMatrix & operator= ( const FeatureMatrix & other );
+
+    /** simple destructor */
+    virtual ~FeatureMatrix ();
+
+    /** number of feature vectors */
+    inline size_t rows () const { return m_rows; };
+
+    /** dimension of the feature vectors */
+    inline size_t dimension () const { return m_dimension; };
+
+    /** true if there are no feature vectors */
+    inline bool empty () const { return m_rows == 0; };
+
+    /** true if the data is a (copy-on-write) memory mapping of a file */
+    inline bool isMapped () const { return m_mapping != NULL; };
+
+    /** element k of feature vector i */
+    inline double & operator() ( size_t i, size_t k ) { return m_data[ i * m_dimension + k ]; };
+
+    /** element k of feature vector i */
+    inline const double & operator() ( size_t i, size_t k ) const { return m_data[ i * m_dimension + k ]; };
+
+    /** pointer to the contiguous row-major data */
+    inline double *getDataPointer () { return m_data; };
+
+    /** pointer to the contiguous row-major data */
+    inline const double *getDataPointer () const { return m_data; };
+
+    /**
+    * @brief feature vector i as a vector with external storage, the view is
+    * invalidated by operations changing the memory (e.g. appendRow, reserve)
+    */
+    Vector getRow ( size_t i );
+
+    /** feature vector i as a vector with external storage (see getRow) */
+    const Vector getRow ( size_t i ) const;
+
+    /**
+    * @brief all feature vectors as columns of a (dimension x rows) matrix with
+    * external storage, this view is invalidated by operations changing the memory
+    */
+    Matrix getTransposedMatrixView ();
+
+    /** add a feature vector, amortized O(dimension); the first vector defines the dimension of
+     * a matrix without a dimension, otherwise the dimensions have to agree */
+    void appendRow ( const Vector & v );
+
+    /** add all feature vectors of another feature matrix */
+    void append ( const FeatureMatrix & other );
+
+    /** allocate memory for the given number of feature vectors */
+    void reserve ( size_t rows );
+
+    /** change the number of feature vectors and the dimension, all values are set to zero */
+    void resize ( size_t rows, size_t dimension );
+
+    /** convert to a VVector */
+    void toVVector ( VVector & v ) const;
+
+    /**
+    * @brief convert to a matrix
+    * @param dst destination matrix (will be resized)
+    * @param rowOriented if true, feature vectors are stored as rows (otherwise as columns)
+    */
+    void toMatrix ( Matrix & dst, bool rowOriented = true ) const;
+
+    /**
+    * @brief write all feature vectors in the binary format
+    * @param filename name of the file
+    * @param chunkSize number of bytes written by a single call
+    */
+    void writeBinary ( const std::string & filename, size_t chunkSize = 64*1024*1024 ) const;
+
+    /**
+    * @brief read a file in the binary format into memory
+    * @param filename name of the file
+    * @param chunkSize number of bytes read by a single call
+    */
+    void readBinary ( const std::string & filename, size_t chunkSize = 64*1024*1024 );
+
+    /**
+    * @brief map a file in the binary format into memory (copy-on-write, the file
+    * is never modified), falls back to readBinary if mapping is not supported
+    */
+    void mapBinary ( const std::string & filename );
+
+    /** remove all feature vectors and release the memory */
+    virtual void clear ();
+
+    virtual void restore ( std::istream & is, int format = FILEFORMAT_BINARY );
+    virtual void store ( std::ostream & os, int format = FILEFORMAT_BINARY ) const;
+};
+
+} // namespace
+
+#endif
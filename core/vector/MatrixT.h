@@ -24,6 +24,9 @@
 
 namespace NICE {
 
+template<class E>
+class MatrixExpression;
+
 /**
  * @class MatrixT
  * @brief  MatrixT is a simple matrix template class
@@ -131,6 +134,21 @@ public:
    */
   MatrixT(const MatrixT<ElementType>& v);
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+  /**
+   * @brief move constructor: takes the data of \c v, which is empty afterwards.
+   *        The data of a \c v with external storage is copied.
+   */
+  MatrixT(MatrixT<ElementType>&& v);
+#endif
+
+  /**
+   * @brief Evaluate a lazy expression (see ExpressionT.h).
+   * @param e expression, e.g. <tt>lazy(A) + transposed(B)</tt>
+   */
+  template<class E>
+  MatrixT(const MatrixExpression<E>& e);
+
   /**
    * @brief destructor
    */
@@ -275,7 +293,8 @@ public:
    */
    MatrixT<ElementType> transpose() const;
 
-   /*! @copydoc MatrixT::transpose() **/
+   /*! @copydoc MatrixT::transpose()
+    *  @note use transposed() (ExpressionT.h) for a view without copy **/
    MatrixT<ElementType> operator !()
    { return transpose(); };
 
@@ -293,6 +312,28 @@ public:
    */
   inline MatrixT<ElementType>& operator=(const ElementType& element);
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+  /**
+   * @brief Move assignment: takes the data of \c v if neither matrix uses
+   *        external storage, and copies the elements otherwise.
+   */
+  inline MatrixT<ElementType>& operator=(MatrixT<ElementType>&& v);
+#endif
+
+  /**
+   * @brief Evaluate a lazy expression (see ExpressionT.h) without temporaries.
+   *        The matrix is resized if necessary. If the expression reads the
+   *        matrix through a transposed view, a temporary is used.
+   */
+  template<class E>
+  inline MatrixT<ElementType>& operator=(const MatrixExpression<E>& e);
+
+  /**
+   * @brief Exchange the data of both matrices without copying the elements.
+   *        External storage is exchanged as well.
+   */
+  inline void swap(MatrixT<ElementType>& v);
+
   /**
    * @brief Set all elements to value \c element
    * @param element New value of all elements
@@ -676,6 +717,10 @@ inline NICE::ibinstream& operator>>(NICE::ibinstream& s, MatrixT<Tp> &r)
   s >> rows;
   s >> cols;
   r.resize(rows,cols);
+  if ( BinaryElementType<Tp>::id != 0 ) {
+    s.readBlock((char*) r.getDataPointer(), (size_t)rows * cols * sizeof(Tp));
+    return s;
+  }
   typename MatrixT<Tp>::iterator it=r.begin();
   for(;it!=r.end();it++)
     s>>*it;
@@ -689,12 +734,36 @@ inline NICE::obinstream& operator<<(NICE::obinstream& s, const MatrixT<Tp>& r)
   unsigned int cols=r.cols();
   s<<rows;
   s<<cols;
+  if ( BinaryElementType<Tp>::id != 0 ) {
+    s.writeBlock((const char*) r.getDataPointer(), (size_t)rows * cols * sizeof(Tp));
+    return s;
+  }
   typename MatrixT<Tp>::const_iterator it=r.begin();
   for(;it!=r.end();it++)
     s << *it;
   return s;
 }
 
+/**
+ * Write a matrix in the versioned binary block format (column-major data,
+ * see BinaryBlockHeader).
+ */
+template <class Tp>
+inline void writeBinaryBlock(NICE::obinstream& s, const MatrixT<Tp>& r, bool checksum = false)
+{
+  writeBinaryBlock(s, r.getDataPointer(), r.rows(), r.cols(), checksum);
+}
+
+/** Read a matrix in the versioned binary block format */
+template <class Tp>
+inline void readBinaryBlock(NICE::ibinstream& s, MatrixT<Tp>& r)
+{
+  BinaryBlockHeader header;
+  header.read(s);
+  r.resize(header.rows, header.cols);
+  readBinaryBlockData(s, header, r.getDataPointer());
+}
+
 typedef MatrixT<bool>   BoolMatrix;
 typedef MatrixT<char>   CharMatrix;
 typedef MatrixT<int>    IntMatrix;
@@ -725,6 +794,28 @@ VectorT<ElementType> operator*(const MatrixT<ElementType>&, const VectorT<Elemen
 template<class ElementType>
 MatrixT<ElementType> operator*(const MatrixT<ElementType>&, const MatrixT<ElementType>& );
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+/** Matrix addition reusing the data of a temporary */
+template<class ElementType>
+MatrixT<ElementType> operator+(MatrixT<ElementType>&&, const MatrixT<ElementType>&);
+
+/** Matrix substraction reusing the data of a temporary */
+template<class ElementType>
+MatrixT<ElementType> operator-(MatrixT<ElementType>&&, const MatrixT<ElementType>&);
+
+/** Multiplication of a temporary matrix with a scalar */
+template<class ElementType>
+MatrixT<ElementType> operator*(MatrixT<ElementType>&&, const double);
+
+/** Multiplication of a temporary matrix with a scalar */
+template<class ElementType>
+MatrixT<ElementType> operator*(const double, MatrixT<ElementType>&&);
+#endif
+
+/** exchange the data of two matrices */
+template<class ElementType>
+inline void swap(MatrixT<ElementType>& a, MatrixT<ElementType>& b) { a.swap(b); }
+
 /** Kronecker product of two matrices */
 template<class ElementType>
 void kroneckerProduct (const MatrixT<ElementType>& A, const MatrixT<ElementType>& B, MatrixT<ElementType>& dst);
@@ -7,6 +7,7 @@
 #define _THROW_EMatrix(string) fthrow(Exception, string)
 #include "core/vector/ippwrapper.h"
 #include "core/vector/MatrixT.h"
+#include "core/vector/ExpressionT.h"
 #include "vector"
 #include <algorithm>
 
@@ -22,14 +23,14 @@ namespace NICE
 	template<typename ElementType>
 	inline MatrixT<ElementType>::MatrixT(const size_t rows, const size_t cols)
 	{
-		setDataPointer(new ElementType[rows * cols], rows, cols, false);
+		setDataPointer(Allocator::newArray<ElementType>(rows * cols), rows, cols, false);
 	}
 
 #ifdef NICE_USELIB_LINAL
 	template<typename ElementType>
 	inline MatrixT<ElementType>::MatrixT(const LinAl::Matrix<ElementType>& m)
 	{
-		setDataPointer(new ElementType[m.rows() * m.cols()],
+		setDataPointer(Allocator::newArray<ElementType>(m.rows() * m.cols()),
 					   m.rows(), m.cols(), false);
 		for (unsigned int j = 0; j < cols(); j++)
 		{
@@ -46,7 +47,7 @@ namespace NICE
 	{
 		if (rows() * cols() == 0 && !externalStorage && getDataPointer() == NULL)
 		{
-			setDataPointer(new ElementType[v.rows() * v.cols()],
+			setDataPointer(Allocator::newArray<ElementType>(v.rows() * v.cols()),
 				 v.rows(), v.cols(), false);
 		}
 		else if (this->rows() != (unsigned int) v.rows()
@@ -69,7 +70,7 @@ namespace NICE
 	inline MatrixT<ElementType>::MatrixT(const size_t rows, const size_t cols,
 										 const ElementType& element)
 	{
-		setDataPointer(new ElementType[rows * cols], rows, cols, false);
+		setDataPointer(Allocator::newArray<ElementType>(rows * cols), rows, cols, false);
 		ippsSet(element, getDataPointer(), rows * cols);
 	}
 
@@ -77,7 +78,7 @@ namespace NICE
 	inline MatrixT<ElementType>::MatrixT(const ElementType* _data,
 										 const size_t rows, const size_t cols)
 	{
-		setDataPointer(new ElementType[rows * cols], rows, cols, false);
+		setDataPointer(Allocator::newArray<ElementType>(rows * cols), rows, cols, false);
 		ippsCopy(_data, getDataPointer(), rows * cols);
 	}
 
@@ -92,7 +93,7 @@ namespace NICE
 				setDataPointer(_data, rows, cols, true);
 				break;
 			case copy:
-				setDataPointer(new ElementType[rows * cols], rows, cols, false);
+				setDataPointer(Allocator::newArray<ElementType>(rows * cols), rows, cols, false);
 				ippsCopy(_data, getDataPointer(), rows * cols);
 				break;
 			default:
@@ -104,7 +105,7 @@ namespace NICE
 //template <class ElementType>
 //inline MatrixT<ElementType>::MatrixT(std::istream& input) {
 //  input >> dataSize;
-//  setDataPointer(new ElementType[dataSize], dataSize, false);
+//  setDataPointer(Allocator::newArray<ElementType>(dataSize), dataSize, false);
 //
 //  char c;
 //  input >> c;
@@ -133,17 +134,44 @@ namespace NICE
 	template<typename ElementType>
 	MatrixT<ElementType>::MatrixT(const MatrixT<ElementType>& v)
 	{
-		setDataPointer(new ElementType[v.rows() * v.cols()],
+		setDataPointer(Allocator::newArray<ElementType>(v.rows() * v.cols()),
 					   v.rows(), v.cols(), false);
 		ippsCopy(v.getDataPointer(), getDataPointer(), v.rows() * v.cols());
 	}
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+	template<typename ElementType>
+	MatrixT<ElementType>::MatrixT(MatrixT<ElementType>&& v)
+	{
+		if (v.externalStorage)
+		{
+			setDataPointer(Allocator::newArray<ElementType>(v.rows() * v.cols()),
+						   v.rows(), v.cols(), false);
+			ippsCopy(v.constData, getDataPointer(), v.rows() * v.cols());
+		}
+		else
+		{
+			setDataPointer(v.data, v.rows(), v.cols(), false);
+			v.setDataPointer(NULL, 0, 0, false);
+		}
+	}
+#endif
+
+	template<typename ElementType>
+	template<class E>
+	MatrixT<ElementType>::MatrixT(const MatrixExpression<E>& e)
+	{
+		setDataPointer(Allocator::newArray<ElementType>(e.rows() * e.cols()),
+					   e.rows(), e.cols(), false);
+		e.evaluateTo(getDataPointer());
+	}
+
 	template<typename ElementType>
 	inline MatrixT<ElementType>::~MatrixT()
 	{
 		if (!externalStorage && data != NULL)
 		{
-			delete[] data;
+			Allocator::deleteArray(data);
 			setDataPointer(NULL, 0, 0, false);
 		}
 	}
@@ -174,13 +202,13 @@ namespace NICE
 			size_t oldRows = rows();
 			size_t oldCols = cols();
 			ElementType* tmp = getDataPointer();
-			setDataPointer(new ElementType[_rows * _cols], _rows, _cols, false);
+			setDataPointer(Allocator::newArray<ElementType>(_rows * _cols), _rows, _cols, false);
 			ippsCopy(tmp, getDataPointer(), std::min(_rows * _cols, oldRows * oldCols));
-			delete[] tmp;
+			Allocator::deleteArray(tmp);
 		}
 		else
 		{
-			setDataPointer(new ElementType[_rows * _cols], _rows, _cols, false);
+			setDataPointer(Allocator::newArray<ElementType>(_rows * _cols), _rows, _cols, false);
 		}
 	}
 
@@ -307,7 +335,7 @@ namespace NICE
 	{
 		if (rows() * cols() == 0 && !externalStorage && getDataPointer() == NULL)
 		{
-			setDataPointer(new ElementType[v.rows() * v.cols()],
+			setDataPointer(Allocator::newArray<ElementType>(v.rows() * v.cols()),
 						   v.rows(), v.cols(), false);
 		}
 		else if (this->rows() != v.rows() || this->cols() != v.cols())
@@ -326,6 +354,65 @@ namespace NICE
 		return *this;
 	}
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+	template<typename ElementType>
+	inline MatrixT<ElementType>&
+	MatrixT<ElementType>::operator=(MatrixT<ElementType>&& v)
+	{
+		if (externalStorage || v.externalStorage)
+		{
+			return operator=(static_cast<const MatrixT<ElementType>&>(v));
+		}
+		if (this != &v)
+		{
+			Allocator::deleteArray(data);
+			setDataPointer(v.data, v.rows(), v.cols(), false);
+			v.setDataPointer(NULL, 0, 0, false);
+		}
+		return *this;
+	}
+#endif
+
+	template<typename ElementType>
+	template<class E>
+	inline MatrixT<ElementType>&
+	MatrixT<ElementType>::operator=(const MatrixExpression<E>& e)
+	{
+		const ElementType* begin = constData;
+		const ElementType* end = constData + rows() * cols();
+		bool resizing = (rows() != e.rows() || cols() != e.cols());
+		if (e.conflicts(begin, end) || (resizing && e.reads(begin, end)))
+		{
+			// the expression reads elements which would be overwritten or released
+			MatrixT<ElementType> tmp(e);
+			return operator=(tmp);
+		}
+		if (resizing)
+		{
+			if (rows() * cols() == 0 && !externalStorage && getDataPointer() == NULL)
+			{
+				setDataPointer(Allocator::newArray<ElementType>(e.rows() * e.cols()),
+							   e.rows(), e.cols(), false);
+			}
+			else
+			{
+				resize(e.rows(), e.cols());
+			}
+		}
+		e.evaluateTo(getDataPointer());
+		return *this;
+	}
+
+	template<typename ElementType>
+	inline void MatrixT<ElementType>::swap(MatrixT<ElementType>& v)
+	{
+		std::swap(externalStorage, v.externalStorage);
+		std::swap(constData, v.constData);
+		std::swap(data, v.data);
+		std::swap(m_rows, v.m_rows);
+		std::swap(m_cols, v.m_cols);
+	}
+
 	template<typename ElementType>
 	void MatrixT<ElementType>::transposeInplace()
 	{
@@ -827,6 +914,51 @@ MatrixT<ElementType>::operator _Op##= (const MatrixT<ElementType>& v) {   \
 		return dst;
 	}
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+	// The data of a temporary is only reused if the matrix owns it, a temporary
+	// with external storage refers to the data of another object.
+
+	/** Matrix addition reusing the data of a temporary */
+	template<class ElementType>
+	MatrixT<ElementType> operator+(MatrixT<ElementType> && a, const MatrixT<ElementType> & b)
+	{
+		if (a.isExternal())
+			return static_cast<const MatrixT<ElementType> &>(a) + b;
+		a += b;
+		return std::move(a);
+	}
+
+	/** Matrix substraction reusing the data of a temporary */
+	template<class ElementType>
+	MatrixT<ElementType> operator-(MatrixT<ElementType> && a, const MatrixT<ElementType> & b)
+	{
+		if (a.isExternal())
+			return static_cast<const MatrixT<ElementType> &>(a) - b;
+		a -= b;
+		return std::move(a);
+	}
+
+	/** Multiplication of a temporary matrix with a scalar */
+	template<class ElementType>
+	MatrixT<ElementType> operator*(MatrixT<ElementType> && a, const double s)
+	{
+		if (a.isExternal())
+			return static_cast<const MatrixT<ElementType> &>(a) * s;
+		a *= s;
+		return std::move(a);
+	}
+
+	/** Multiplication of a temporary matrix with a scalar */
+	template<class ElementType>
+	MatrixT<ElementType> operator*(const double s, MatrixT<ElementType> && a)
+	{
+		if (a.isExternal())
+			return s * static_cast<const MatrixT<ElementType> &>(a);
+		a *= s;
+		return std::move(a);
+	}
+#endif
+
 	/** Matrix multiplication with a vector */
 	template<class ElementType>
 	VectorT<ElementType> operator*(const MatrixT<ElementType> & a, const VectorT<ElementType> & b)
@@ -126,6 +126,14 @@ public:
    */
   RowMatrixT(const RowMatrixT<ElementType>& v);
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+  /**
+   * @brief move constructor: takes the data of \c v, which is empty afterwards.
+   *        The data of a \c v with external storage is copied.
+   */
+  RowMatrixT(RowMatrixT<ElementType>&& v);
+#endif
+
   virtual ~RowMatrixT();
 
   /**
@@ -246,6 +254,20 @@ public:
    */
   inline RowMatrixT<ElementType>& operator=(const ElementType& element);
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+  /**
+   * @brief Move assignment: takes the data of \c v if neither matrix uses
+   *        external storage, and copies the elements otherwise.
+   */
+  inline RowMatrixT<ElementType>& operator=(RowMatrixT<ElementType>&& v);
+#endif
+
+  /**
+   * @brief Exchange the data of both matrices without copying the elements.
+   *        External storage is exchanged as well.
+   */
+  inline void swap(RowMatrixT<ElementType>& v);
+
   /**
    * @brief Set all elements to value \c element
    * @param element New value of all elements
@@ -509,6 +531,10 @@ typedef RowMatrixT<int>   IntRowMatrix;
 typedef RowMatrixT<float> FloatRowMatrix;
 typedef RowMatrixT<double> DoubleRowMatrix;
 typedef RowMatrixT<char>  CharRowMatrix;
+
+/** exchange the data of two matrices */
+template<class ElementType>
+inline void swap(RowMatrixT<ElementType>& a, RowMatrixT<ElementType>& b) { a.swap(b); }
 }
 
 //#ifdef __GNUC__
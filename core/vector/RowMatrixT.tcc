@@ -15,13 +15,13 @@ inline RowMatrixT<ElementType>::RowMatrixT() {
 
 template<typename ElementType>
 inline RowMatrixT<ElementType>::RowMatrixT(const size_t rows, const size_t cols) {
-  setDataPointer(new ElementType[rows * cols], rows, cols, false);
+  setDataPointer(Allocator::newArray<ElementType>(rows * cols), rows, cols, false);
 }
 
 #ifdef NICE_USELIB_LINAL
 template<typename ElementType>
 inline RowMatrixT<ElementType>::RowMatrixT(const LinAl::Matrix<ElementType>& m) {
-  setDataPointer(new ElementType[m.rows() * m.cols()], 
+  setDataPointer(Allocator::newArray<ElementType>(m.rows() * m.cols()), 
                  m.rows(), m.cols(), false);
   for (unsigned int i = 0; i < rows(); i++) {
     for (unsigned int j = 0; j < cols(); j++) {
@@ -34,14 +34,14 @@ inline RowMatrixT<ElementType>::RowMatrixT(const LinAl::Matrix<ElementType>& m)
 template<typename ElementType>
 inline RowMatrixT<ElementType>::RowMatrixT(const size_t rows, const size_t cols,
                                      const ElementType& element) {
-  setDataPointer(new ElementType[rows * cols], rows, cols, false);
+  setDataPointer(Allocator::newArray<ElementType>(rows * cols), rows, cols, false);
   ippsSet(element, getDataPointer(), rows * cols);
 }
 
 template<typename ElementType>
 inline RowMatrixT<ElementType>::RowMatrixT(const ElementType* _data, 
                                      const size_t rows, const size_t cols) {
-  setDataPointer(new ElementType[rows * cols], rows, cols, false);
+  setDataPointer(Allocator::newArray<ElementType>(rows * cols), rows, cols, false);
   ippsCopy(_data, getDataPointer(), rows * cols);
 }
 
@@ -54,7 +54,7 @@ inline RowMatrixT<ElementType>::RowMatrixT(ElementType* _data,
     setDataPointer(_data, rows, cols, true);
     break;
   case copy:
-    setDataPointer(new ElementType[rows * cols], rows, cols, false);
+    setDataPointer(Allocator::newArray<ElementType>(rows * cols), rows, cols, false);
     ippsCopy(_data, getDataPointer(), rows * cols);
     break;
    default:
@@ -66,7 +66,7 @@ inline RowMatrixT<ElementType>::RowMatrixT(ElementType* _data,
 //template <class ElementType>
 //inline RowMatrixT<ElementType>::RowMatrixT(std::istream& input) {
 //  input >> dataSize;
-//  setDataPointer(new ElementType[dataSize], dataSize, false);
+//  setDataPointer(Allocator::newArray<ElementType>(dataSize), dataSize, false);
 //  
 //  char c;
 //  input >> c;
@@ -94,15 +94,29 @@ inline RowMatrixT<ElementType>::RowMatrixT(ElementType* _data,
 
 template<typename ElementType>
 RowMatrixT<ElementType>::RowMatrixT(const RowMatrixT<ElementType>& v) {
-  setDataPointer(new ElementType[v.rows() * v.cols()],
+  setDataPointer(Allocator::newArray<ElementType>(v.rows() * v.cols()),
                  v.rows(), v.cols(), false);
   ippsCopy(v.getDataPointer(), getDataPointer(), v.rows() * v.cols());
 }
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+template<typename ElementType>
+RowMatrixT<ElementType>::RowMatrixT(RowMatrixT<ElementType>&& v) {
+  if (v.externalStorage) {
+    setDataPointer(Allocator::newArray<ElementType>(v.rows() * v.cols()),
+                   v.rows(), v.cols(), false);
+    ippsCopy(v.constData, getDataPointer(), v.rows() * v.cols());
+  } else {
+    setDataPointer(v.data, v.rows(), v.cols(), false);
+    v.setDataPointer(NULL, 0, 0, false);
+  }
+}
+#endif
+
 template<typename ElementType>
 inline RowMatrixT<ElementType>::~RowMatrixT() {
   if (!externalStorage && data != NULL) {
-    delete[] data;
+    Allocator::deleteArray(data);
     setDataPointer(NULL, 0, 0, false);
   }
 }
@@ -128,11 +142,11 @@ void RowMatrixT<ElementType>::resize(size_t _rows, size_t _cols) {
     size_t oldRows = rows();
     size_t oldCols = cols();
     ElementType* tmp = getDataPointer();
-    setDataPointer(new ElementType[_rows * _cols], _rows, _cols, false);
+    setDataPointer(Allocator::newArray<ElementType>(_rows * _cols), _rows, _cols, false);
     ippsCopy(tmp, getDataPointer(), std::min(_rows * _cols, oldRows * oldCols));
-    delete[] tmp;
+    Allocator::deleteArray(tmp);
   } else {
-    setDataPointer(new ElementType[_rows * _cols], _rows, _cols, false);
+    setDataPointer(Allocator::newArray<ElementType>(_rows * _cols), _rows, _cols, false);
   }
 }
 
@@ -219,7 +233,7 @@ template<typename ElementType>
 inline RowMatrixT<ElementType>&
 RowMatrixT<ElementType>::operator=(const RowMatrixT<ElementType>& v) {
   if (rows() * cols() == 0 && !externalStorage && getDataPointer() == NULL) {
-    setDataPointer(new ElementType[v.rows() * v.cols()],
+    setDataPointer(Allocator::newArray<ElementType>(v.rows() * v.cols()),
                    v.rows(), v.cols(), false);
   } else if (this->rows() != v.rows() || this->cols() != v.cols()) {
     this->resize(v.rows(),v.cols());
@@ -235,6 +249,31 @@ RowMatrixT<ElementType>::operator=(const ElementType& element) {
   return *this;
 }
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+template<typename ElementType>
+inline RowMatrixT<ElementType>&
+RowMatrixT<ElementType>::operator=(RowMatrixT<ElementType>&& v) {
+  if (externalStorage || v.externalStorage) {
+    return operator=(static_cast<const RowMatrixT<ElementType>&>(v));
+  }
+  if (this != &v) {
+    Allocator::deleteArray(data);
+    setDataPointer(v.data, v.rows(), v.cols(), false);
+    v.setDataPointer(NULL, 0, 0, false);
+  }
+  return *this;
+}
+#endif
+
+template<typename ElementType>
+inline void RowMatrixT<ElementType>::swap(RowMatrixT<ElementType>& v) {
+  std::swap(externalStorage, v.externalStorage);
+  std::swap(constData, v.constData);
+  std::swap(data, v.data);
+  std::swap(m_rows, v.m_rows);
+  std::swap(m_cols, v.m_cols);
+}
+
 template<typename ElementType>
 void RowMatrixT<ElementType>::transposeInplace() {
   if (rows() != cols()) {
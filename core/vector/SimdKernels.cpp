@@ -0,0 +1,412 @@
+/**
+* @file SimdKernels.cpp
+* @brief scalar kernels and runtime dispatch of SimdKernels
+* @date 10/19/2026
+
+*/
+#include <cstdlib>
+#include <cstring>
+
+#ifndef WIN32
+#include <pthread.h>
+#endif
+
+#include "core/vector/SimdKernels.h"
+
+#ifdef NICE_SIMD_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+using namespace NICE;
+
+namespace {
+
+// scalar reference kernels
+
+template<class T>
+T scalarSum ( const T *p, int n )
+{
+  T s = T ( 0 );
+  for ( int i = 0 ; i < n ; i++ )
+    s += p[i];
+  return s;
+}
+
+template<class T>
+T scalarSumAbs ( const T *p, int n )
+{
+  T s = T ( 0 );
+  for ( int i = 0 ; i < n ; i++ )
+    s += p[i] < T ( 0 ) ? -p[i] : p[i];
+  return s;
+}
+
+template<class T>
+T scalarSumSquares ( const T *p, int n )
+{
+  T s = T ( 0 );
+  for ( int i = 0 ; i < n ; i++ )
+    s += p[i] * p[i];
+  return s;
+}
+
+template<class T>
+T scalarDot ( const T *a, const T *b, int n )
+{
+  T s = T ( 0 );
+  for ( int i = 0 ; i < n ; i++ )
+    s += a[i] * b[i];
+  return s;
+}
+
+template<class T>
+T scalarMinValue ( const T *p, int n )
+{
+  T s = p[0];
+  for ( int i = 1 ; i < n ; i++ )
+    s = s < p[i] ? s : p[i];
+  return s;
+}
+
+template<class T>
+T scalarMaxValue ( const T *p, int n )
+{
+  T s = p[0];
+  for ( int i = 1 ; i < n ; i++ )
+    s = s > p[i] ? s : p[i];
+  return s;
+}
+
+template<class T>
+T scalarMaxAbs ( const T *p, int n )
+{
+  T s = p[0] < T ( 0 ) ? -p[0] : p[0];
+  for ( int i = 1 ; i < n ; i++ )
+  {
+    T a = p[i] < T ( 0 ) ? -p[i] : p[i];
+    s = s > a ? s : a;
+  }
+  return s;
+}
+
+template<class T>
+void scalarAdd ( const T *a, const T *b, T *dst, int n )
+{
+  for ( int i = 0 ; i < n ; i++ )
+    dst[i] = a[i] + b[i];
+}
+
+template<class T>
+void scalarSub ( const T *a, const T *b, T *dst, int n )
+{
+  for ( int i = 0 ; i < n ; i++ )
+    dst[i] = a[i] - b[i];
+}
+
+template<class T>
+void scalarMul ( const T *a, const T *b, T *dst, int n )
+{
+  for ( int i = 0 ; i < n ; i++ )
+    dst[i] = a[i] * b[i];
+}
+
+template<class T>
+void scalarDiv ( const T *a, const T *b, T *dst, int n )
+{
+  for ( int i = 0 ; i < n ; i++ )
+    dst[i] = a[i] / b[i];
+}
+
+template<class T>
+void scalarAddC ( const T *a, T c, T *dst, int n )
+{
+  for ( int i = 0 ; i < n ; i++ )
+    dst[i] = a[i] + c;
+}
+
+template<class T>
+void scalarSubC ( const T *a, T c, T *dst, int n )
+{
+  for ( int i = 0 ; i < n ; i++ )
+    dst[i] = a[i] - c;
+}
+
+template<class T>
+void scalarSubCRev ( const T *a, T c, T *dst, int n )
+{
+  for ( int i = 0 ; i < n ; i++ )
+    dst[i] = c - a[i];
+}
+
+template<class T>
+void scalarMulC ( const T *a, T c, T *dst, int n )
+{
+  for ( int i = 0 ; i < n ; i++ )
+    dst[i] = a[i] * c;
+}
+
+template<class T>
+void scalarDivC ( const T *a, T c, T *dst, int n )
+{
+  for ( int i = 0 ; i < n ; i++ )
+    dst[i] = a[i] / c;
+}
+
+template<class T>
+void scalarAddProductC ( const T *a, T c, T *dst, int n )
+{
+  for ( int i = 0 ; i < n ; i++ )
+    dst[i] += a[i] * c;
+}
+
+template<class T>
+void scalarAbs ( const T *a, T *dst, int n )
+{
+  for ( int i = 0 ; i < n ; i++ )
+    dst[i] = a[i] < T ( 0 ) ? -a[i] : a[i];
+}
+
+template<class T>
+void scalarSet ( T value, T *dst, int n )
+{
+  for ( int i = 0 ; i < n ; i++ )
+    dst[i] = value;
+}
+
+void scalarConvert8u32f ( const unsigned char *src, float *dst, int n )
+{
+  for ( int i = 0 ; i < n ; i++ )
+    dst[i] = src[i];
+}
+
+void scalarConvert32f8u ( const float *src, unsigned char *dst, int n, bool round )
+{
+  const float offset = round ? 0.5f : 0.0f;
+  for ( int i = 0 ; i < n ; i++ )
+  {
+    float x = src[i];
+    x = x < 255.0f ? x : 255.0f;
+    x = x > 0.0f ? x : 0.0f;
+    dst[i] = static_cast<unsigned char> ( static_cast<int> ( x + offset ) );
+  }
+}
+
+void fillScalar ( SimdKernels::Table & t )
+{
+  t.sum32f = scalarSum<float>;
+  t.sum64f = scalarSum<double>;
+  t.sumAbs32f = scalarSumAbs<float>;
+  t.sumAbs64f = scalarSumAbs<double>;
+  t.sumSquares32f = scalarSumSquares<float>;
+  t.sumSquares64f = scalarSumSquares<double>;
+  t.dot32f = scalarDot<float>;
+  t.dot64f = scalarDot<double>;
+  t.minValue32f = scalarMinValue<float>;
+  t.minValue64f = scalarMinValue<double>;
+  t.maxValue32f = scalarMaxValue<float>;
+  t.maxValue64f = scalarMaxValue<double>;
+  t.maxAbs32f = scalarMaxAbs<float>;
+  t.maxAbs64f = scalarMaxAbs<double>;
+
+  t.add32f = scalarAdd<float>;
+  t.add64f = scalarAdd<double>;
+  t.sub32f = scalarSub<float>;
+  t.sub64f = scalarSub<double>;
+  t.mul32f = scalarMul<float>;
+  t.mul64f = scalarMul<double>;
+  t.div32f = scalarDiv<float>;
+  t.div64f = scalarDiv<double>;
+
+  t.addC32f = scalarAddC<float>;
+  t.addC64f = scalarAddC<double>;
+  t.subC32f = scalarSubC<float>;
+  t.subC64f = scalarSubC<double>;
+  t.subCRev32f = scalarSubCRev<float>;
+  t.subCRev64f = scalarSubCRev<double>;
+  t.mulC32f = scalarMulC<float>;
+  t.mulC64f = scalarMulC<double>;
+  t.divC32f = scalarDivC<float>;
+  t.divC64f = scalarDivC<double>;
+  t.addProductC32f = scalarAddProductC<float>;
+  t.addProductC64f = scalarAddProductC<double>;
+
+  t.abs32f = scalarAbs<float>;
+  t.abs64f = scalarAbs<double>;
+  t.set32f = scalarSet<float>;
+  t.set64f = scalarSet<double>;
+
+  t.convert8u32f = scalarConvert8u32f;
+  t.convert32f8u = scalarConvert32f8u;
+}
+
+#ifdef NICE_SIMD_X86
+
+void cpuid ( unsigned int leaf, unsigned int regs[4] )
+{
+#ifdef _MSC_VER
+  int info[4];
+  __cpuidex ( info, leaf, 0 );
+  for ( int i = 0 ; i < 4 ; i++ )
+    regs[i] = info[i];
+#else
+  __cpuid_count ( leaf, 0, regs[0], regs[1], regs[2], regs[3] );
+#endif
+}
+
+unsigned int maxLeaf ()
+{
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid ( info, 0 );
+  return info[0];
+#else
+  return __get_cpuid_max ( 0, NULL );
+#endif
+}
+
+//! register state enabled by the operating system
+unsigned long long xgetbv ()
+{
+#ifdef _MSC_VER
+  return _xgetbv ( 0 );
+#else
+  unsigned int eax, edx;
+  __asm__ __volatile__ ( "xgetbv" : "=a" ( eax ), "=d" ( edx ) : "c" ( 0 ) );
+  return ( ( unsigned long long ) edx << 32 ) | eax;
+#endif
+}
+
+#endif
+
+SimdKernels::InstructionSet detect ()
+{
+  SimdKernels::InstructionSet result = SimdKernels::SCALAR;
+#ifdef NICE_SIMD_X86
+  unsigned int leaves = maxLeaf();
+  if ( leaves < 1 )
+    return result;
+  unsigned int regs[4];
+  cpuid ( 1, regs );
+  if ( regs[3] & ( 1u << 26 ) )
+    result = SimdKernels::SSE2;
+
+  const bool osxsave = ( regs[2] & ( 1u << 27 ) ) != 0;
+  const bool avx = ( regs[2] & ( 1u << 28 ) ) != 0;
+  if ( !osxsave || !avx || leaves < 7 )
+    return result;
+  const unsigned long long xcr0 = xgetbv();
+  cpuid ( 7, regs );
+  // the operating system has to save the ymm (and zmm) registers
+  if ( ( regs[1] & ( 1u << 5 ) ) && ( xcr0 & 0x6 ) == 0x6 )
+    result = SimdKernels::AVX2;
+  if ( result == SimdKernels::AVX2 && ( regs[1] & ( 1u << 16 ) ) && ( xcr0 & 0xe6 ) == 0xe6 )
+    result = SimdKernels::AVX512;
+#endif
+  return result;
+}
+
+SimdKernels::Table tables[SimdKernels::AVX512 + 1];
+SimdKernels::InstructionSet supported = SimdKernels::SCALAR;
+volatile int current = SimdKernels::SCALAR;
+
+#ifndef WIN32
+pthread_once_t initializeOnce = PTHREAD_ONCE_INIT;
+#else
+bool initialized = false;
+#endif
+
+} // namespace
+
+void SimdKernels::initialize ()
+{
+  supported = detect();
+
+  fillScalar ( tables[SCALAR] );
+#ifdef NICE_SIMD_X86
+  if ( supported >= SSE2 )
+  {
+    tables[SSE2] = tables[SCALAR];
+    fillSSE2 ( tables[SSE2] );
+  }
+  if ( supported >= AVX2 )
+  {
+    tables[AVX2] = tables[SSE2];
+    fillAVX2 ( tables[AVX2] );
+  }
+  if ( supported >= AVX512 )
+  {
+    tables[AVX512] = tables[AVX2];
+    fillAVX512 ( tables[AVX512] );
+  }
+#endif
+
+  InstructionSet selected = supported;
+  const char *env = getenv ( "NICE_SIMD" );
+  if ( env != NULL )
+  {
+    for ( int i = SCALAR ; i <= AVX512 ; i++ )
+      if ( strcmp ( env, getName ( ( InstructionSet ) i ) ) == 0 && i < selected )
+        selected = ( InstructionSet ) i;
+  }
+  current = selected;
+}
+
+const SimdKernels::Table & SimdKernels::table ()
+{
+#ifndef WIN32
+  pthread_once ( &initializeOnce, initialize );
+#else
+#pragma omp critical(NiceSimdKernels)
+  if ( !initialized )
+  {
+    initialize();
+    initialized = true;
+  }
+#endif
+  return tables[current];
+}
+
+SimdKernels::InstructionSet SimdKernels::getSupportedInstructionSet ()
+{
+  table();
+  return supported;
+}
+
+SimdKernels::InstructionSet SimdKernels::getInstructionSet ()
+{
+  table();
+  return ( InstructionSet ) current;
+}
+
+SimdKernels::InstructionSet SimdKernels::setInstructionSet ( InstructionSet instructionSet )
+{
+  table();
+  current = instructionSet < supported ? instructionSet : supported;
+  return ( InstructionSet ) current;
+}
+
+const char *SimdKernels::getName ( InstructionSet instructionSet )
+{
+  switch ( instructionSet )
+  {
+    case SCALAR:
+      return "scalar";
+    case SSE2:
+      return "sse2";
+    case AVX2:
+      return "avx2";
+    case AVX512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+void SimdKernels::copy ( const void *src, void *dst, size_t n, size_t bytes )
+{
+  if ( n > 0 )
+    memmove ( dst, src, n * bytes );
+}
@@ -0,0 +1,196 @@
+/**
+* @file SimdKernels.h
+* @brief vectorized loops over float and double arrays with runtime CPU dispatch
+* @date 10/19/2026
+
+*/
+#ifndef _NICE_SIMDKERNELSINCLUDE
+#define _NICE_SIMDKERNELSINCLUDE
+
+#include <cstddef>
+
+// x86 compilers which can generate SSE2, AVX2 and AVX-512 code for single
+// translation units without global compiler flags
+#if ( defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86) ) && \
+    ( ( defined(__clang__) && __clang_major__ >= 6 ) || \
+      ( !defined(__clang__) && defined(__GNUC__) && ( __GNUC__ > 4 || ( __GNUC__ == 4 && __GNUC_MINOR__ >= 9 ) ) ) || \
+      ( defined(_MSC_VER) && _MSC_VER >= 1910 ) )
+#define NICE_SIMD_X86
+#endif
+
+namespace NICE {
+
+/**
+ * @class SimdKernels
+ * @brief Native kernels of the ipps and ippi wrappers for builds without IPP.
+ *
+ * Every kernel exists as a scalar reference implementation and as SSE2, AVX2
+ * and AVX-512 versions. The best instruction set of the CPU is selected at the
+ * first call; the environment variable NICE_SIMD ("scalar", "sse2", "avx2" or
+ * "avx512") and setInstructionSet() limit the selection.
+ *
+ * Element-wise kernels give exactly the results of the scalar versions.
+ * Reductions sum in a different order and may differ in the last bits.
+ * Pointers need no alignment, and the destination of an element-wise kernel
+ * may be identical to one of its sources (but must not overlap otherwise).
+ */
+class SimdKernels
+{
+  public:
+    //! instruction sets in increasing order
+    enum InstructionSet {
+      SCALAR = 0,
+      SSE2,
+      AVX2,
+      AVX512
+    };
+
+    /** the best instruction set supported by the CPU and the compiler */
+    static InstructionSet getSupportedInstructionSet ();
+
+    /** the instruction set of the kernels currently used */
+    static InstructionSet getInstructionSet ();
+
+    /**
+    * @brief select the kernels of an instruction set (for tests and benchmarks)
+    * @return the selected instruction set, at most getSupportedInstructionSet()
+    */
+    static InstructionSet setInstructionSet ( InstructionSet instructionSet );
+
+    /** name of an instruction set, e.g. "avx2" */
+    static const char *getName ( InstructionSet instructionSet );
+
+    /** function pointers of the kernels of one instruction set */
+    struct Table
+    {
+      float ( *sum32f ) ( const float *, int );
+      double ( *sum64f ) ( const double *, int );
+      float ( *sumAbs32f ) ( const float *, int );
+      double ( *sumAbs64f ) ( const double *, int );
+      float ( *sumSquares32f ) ( const float *, int );
+      double ( *sumSquares64f ) ( const double *, int );
+      float ( *dot32f ) ( const float *, const float *, int );
+      double ( *dot64f ) ( const double *, const double *, int );
+      float ( *minValue32f ) ( const float *, int );
+      double ( *minValue64f ) ( const double *, int );
+      float ( *maxValue32f ) ( const float *, int );
+      double ( *maxValue64f ) ( const double *, int );
+      float ( *maxAbs32f ) ( const float *, int );
+      double ( *maxAbs64f ) ( const double *, int );
+
+      void ( *add32f ) ( const float *, const float *, float *, int );
+      void ( *add64f ) ( const double *, const double *, double *, int );
+      void ( *sub32f ) ( const float *, const float *, float *, int );
+      void ( *sub64f ) ( const double *, const double *, double *, int );
+      void ( *mul32f ) ( const float *, const float *, float *, int );
+      void ( *mul64f ) ( const double *, const double *, double *, int );
+      void ( *div32f ) ( const float *, const float *, float *, int );
+      void ( *div64f ) ( const double *, const double *, double *, int );
+
+      void ( *addC32f ) ( const float *, float, float *, int );
+      void ( *addC64f ) ( const double *, double, double *, int );
+      void ( *subC32f ) ( const float *, float, float *, int );
+      void ( *subC64f ) ( const double *, double, double *, int );
+      void ( *subCRev32f ) ( const float *, float, float *, int );
+      void ( *subCRev64f ) ( const double *, double, double *, int );
+      void ( *mulC32f ) ( const float *, float, float *, int );
+      void ( *mulC64f ) ( const double *, double, double *, int );
+      void ( *divC32f ) ( const float *, float, float *, int );
+      void ( *divC64f ) ( const double *, double, double *, int );
+      void ( *addProductC32f ) ( const float *, float, float *, int );
+      void ( *addProductC64f ) ( const double *, double, double *, int );
+
+      void ( *abs32f ) ( const float *, float *, int );
+      void ( *abs64f ) ( const double *, double *, int );
+      void ( *set32f ) ( float, float *, int );
+      void ( *set64f ) ( double, double *, int );
+
+      void ( *convert8u32f ) ( const unsigned char *, float *, int );
+      void ( *convert32f8u ) ( const float *, unsigned char *, int, bool );
+    };
+
+    /** the kernels currently used */
+    static const Table &table ();
+
+    //! @name reductions, n > 0 for minValue(), maxValue() and maxAbs()
+    //@{
+    static float sum ( const float *p, int n ) { return table().sum32f ( p, n ); };
+    static double sum ( const double *p, int n ) { return table().sum64f ( p, n ); };
+    static float sumAbs ( const float *p, int n ) { return table().sumAbs32f ( p, n ); };
+    static double sumAbs ( const double *p, int n ) { return table().sumAbs64f ( p, n ); };
+    static float sumSquares ( const float *p, int n ) { return table().sumSquares32f ( p, n ); };
+    static double sumSquares ( const double *p, int n ) { return table().sumSquares64f ( p, n ); };
+    static float dot ( const float *a, const float *b, int n ) { return table().dot32f ( a, b, n ); };
+    static double dot ( const double *a, const double *b, int n ) { return table().dot64f ( a, b, n ); };
+    static float minValue ( const float *p, int n ) { return table().minValue32f ( p, n ); };
+    static double minValue ( const double *p, int n ) { return table().minValue64f ( p, n ); };
+    static float maxValue ( const float *p, int n ) { return table().maxValue32f ( p, n ); };
+    static double maxValue ( const double *p, int n ) { return table().maxValue64f ( p, n ); };
+    static float maxAbs ( const float *p, int n ) { return table().maxAbs32f ( p, n ); };
+    static double maxAbs ( const double *p, int n ) { return table().maxAbs64f ( p, n ); };
+    //@}
+
+    //! @name element-wise operations of two arrays, dst[i] = a[i] op b[i]
+    //@{
+    static void add ( const float *a, const float *b, float *dst, int n ) { table().add32f ( a, b, dst, n ); };
+    static void add ( const double *a, const double *b, double *dst, int n ) { table().add64f ( a, b, dst, n ); };
+    static void sub ( const float *a, const float *b, float *dst, int n ) { table().sub32f ( a, b, dst, n ); };
+    static void sub ( const double *a, const double *b, double *dst, int n ) { table().sub64f ( a, b, dst, n ); };
+    static void mul ( const float *a, const float *b, float *dst, int n ) { table().mul32f ( a, b, dst, n ); };
+    static void mul ( const double *a, const double *b, double *dst, int n ) { table().mul64f ( a, b, dst, n ); };
+    static void div ( const float *a, const float *b, float *dst, int n ) { table().div32f ( a, b, dst, n ); };
+    static void div ( const double *a, const double *b, double *dst, int n ) { table().div64f ( a, b, dst, n ); };
+    //@}
+
+    //! @name element-wise operations with a constant, dst[i] = a[i] op c (subCRev: c - a[i])
+    //@{
+    static void addC ( const float *a, float c, float *dst, int n ) { table().addC32f ( a, c, dst, n ); };
+    static void addC ( const double *a, double c, double *dst, int n ) { table().addC64f ( a, c, dst, n ); };
+    static void subC ( const float *a, float c, float *dst, int n ) { table().subC32f ( a, c, dst, n ); };
+    static void subC ( const double *a, double c, double *dst, int n ) { table().subC64f ( a, c, dst, n ); };
+    static void subCRev ( const float *a, float c, float *dst, int n ) { table().subCRev32f ( a, c, dst, n ); };
+    static void subCRev ( const double *a, double c, double *dst, int n ) { table().subCRev64f ( a, c, dst, n ); };
+    static void mulC ( const float *a, float c, float *dst, int n ) { table().mulC32f ( a, c, dst, n ); };
+    static void mulC ( const double *a, double c, double *dst, int n ) { table().mulC64f ( a, c, dst, n ); };
+    static void divC ( const float *a, float c, float *dst, int n ) { table().divC32f ( a, c, dst, n ); };
+    static void divC ( const double *a, double c, double *dst, int n ) { table().divC64f ( a, c, dst, n ); };
+    //@}
+
+    //! @name accumulation of a scaled array, dst[i] += a[i] * c (axpy)
+    //@{
+    static void addProductC ( const float *a, float c, float *dst, int n ) { table().addProductC32f ( a, c, dst, n ); };
+    static void addProductC ( const double *a, double c, double *dst, int n ) { table().addProductC64f ( a, c, dst, n ); };
+    //@}
+
+    //! @name copies and conversions
+    //@{
+    static void abs ( const float *a, float *dst, int n ) { table().abs32f ( a, dst, n ); };
+    static void abs ( const double *a, double *dst, int n ) { table().abs64f ( a, dst, n ); };
+    static void set ( float value, float *dst, int n ) { table().set32f ( value, dst, n ); };
+    static void set ( double value, double *dst, int n ) { table().set64f ( value, dst, n ); };
+
+    /** copy n elements of size bytes, source and destination may overlap */
+    static void copy ( const void *src, void *dst, size_t n, size_t bytes );
+
+    static void convert ( const unsigned char *src, float *dst, int n ) { table().convert8u32f ( src, dst, n ); };
+
+    /**
+    * @brief convert to unsigned char with saturation
+    * @param round round to the nearest value (halves away from zero) instead of truncating
+    */
+    static void convert ( const float *src, unsigned char *dst, int n, bool round )
+    { table().convert32f8u ( src, dst, n, round ); };
+    //@}
+
+  private:
+    static void initialize ();
+
+    //! overwrite the kernels of a table with those of an instruction set
+    static void fillSSE2 ( Table & table );
+    static void fillAVX2 ( Table & table );
+    static void fillAVX512 ( Table & table );
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,312 @@
+/**
+* @file SimdKernels.tcc
+* @brief kernels of SimdKernels for one instruction set
+* @date 10/19/2026
+
+*/
+// Included by the translation units of the instruction sets after the
+// register traits F32 and F64 are defined. These traits provide
+//   Scalar, Register, N, load, store, set1, zero, add, sub, mul, div,
+//   minimum, maximum and abs,
+// where minimum(a, b) is a < b ? a : b and maximum(a, b) is a > b ? a : b
+// like the min and max instructions. No standard header may be included
+// here, its inline functions would be compiled for the instruction set.
+
+namespace NICE {
+
+namespace {
+
+template<class V>
+typename V::Scalar simdHorizontalSum ( typename V::Register r )
+{
+  typename V::Scalar buffer[V::N];
+  V::store ( buffer, r );
+  typename V::Scalar s = buffer[0];
+  for ( int i = 1 ; i < V::N ; i++ )
+    s += buffer[i];
+  return s;
+}
+
+// element transformations of the sums
+struct SimdIdentity
+{
+  template<class V>
+  static typename V::Register map ( typename V::Register x ) { return x; }
+  template<class T>
+  static T mapScalar ( T x ) { return x; }
+};
+
+struct SimdAbsolute
+{
+  template<class V>
+  static typename V::Register map ( typename V::Register x ) { return V::abs ( x ); }
+  template<class T>
+  static T mapScalar ( T x ) { return x < T ( 0 ) ? -x : x; }
+};
+
+struct SimdSquare
+{
+  template<class V>
+  static typename V::Register map ( typename V::Register x ) { return V::mul ( x, x ); }
+  template<class T>
+  static T mapScalar ( T x ) { return x * x; }
+};
+
+template<class V, class M>
+typename V::Scalar simdSum ( const typename V::Scalar *p, int n )
+{
+  typedef typename V::Register R;
+  R a0 = V::zero();
+  R a1 = V::zero();
+  R a2 = V::zero();
+  R a3 = V::zero();
+  int i = 0;
+  for ( ; i + 4 * V::N <= n ; i += 4 * V::N )
+  {
+    a0 = V::add ( a0, M::template map<V> ( V::load ( p + i ) ) );
+    a1 = V::add ( a1, M::template map<V> ( V::load ( p + i + V::N ) ) );
+    a2 = V::add ( a2, M::template map<V> ( V::load ( p + i + 2 * V::N ) ) );
+    a3 = V::add ( a3, M::template map<V> ( V::load ( p + i + 3 * V::N ) ) );
+  }
+  for ( ; i + V::N <= n ; i += V::N )
+    a0 = V::add ( a0, M::template map<V> ( V::load ( p + i ) ) );
+  typename V::Scalar s = simdHorizontalSum<V> ( V::add ( V::add ( a0, a1 ), V::add ( a2, a3 ) ) );
+  for ( ; i < n ; i++ )
+    s += M::mapScalar ( p[i] );
+  return s;
+}
+
+template<class V>
+typename V::Scalar simdDot ( const typename V::Scalar *a, const typename V::Scalar *b, int n )
+{
+  typedef typename V::Register R;
+  R a0 = V::zero();
+  R a1 = V::zero();
+  R a2 = V::zero();
+  R a3 = V::zero();
+  int i = 0;
+  for ( ; i + 4 * V::N <= n ; i += 4 * V::N )
+  {
+    a0 = V::add ( a0, V::mul ( V::load ( a + i ), V::load ( b + i ) ) );
+    a1 = V::add ( a1, V::mul ( V::load ( a + i + V::N ), V::load ( b + i + V::N ) ) );
+    a2 = V::add ( a2, V::mul ( V::load ( a + i + 2 * V::N ), V::load ( b + i + 2 * V::N ) ) );
+    a3 = V::add ( a3, V::mul ( V::load ( a + i + 3 * V::N ), V::load ( b + i + 3 * V::N ) ) );
+  }
+  for ( ; i + V::N <= n ; i += V::N )
+    a0 = V::add ( a0, V::mul ( V::load ( a + i ), V::load ( b + i ) ) );
+  typename V::Scalar s = simdHorizontalSum<V> ( V::add ( V::add ( a0, a1 ), V::add ( a2, a3 ) ) );
+  for ( ; i < n ; i++ )
+    s += a[i] * b[i];
+  return s;
+}
+
+// extrema, the scalar and the vector comparison behave identically
+struct SimdMinimum
+{
+  template<class V>
+  static typename V::Register combine ( typename V::Register a, typename V::Register b ) { return V::minimum ( a, b ); }
+  template<class T>
+  static T combineScalar ( T a, T b ) { return a < b ? a : b; }
+};
+
+struct SimdMaximum
+{
+  template<class V>
+  static typename V::Register combine ( typename V::Register a, typename V::Register b ) { return V::maximum ( a, b ); }
+  template<class T>
+  static T combineScalar ( T a, T b ) { return a > b ? a : b; }
+};
+
+template<class V, class C, class M>
+typename V::Scalar simdExtremum ( const typename V::Scalar *p, int n )
+{
+  typedef typename V::Scalar T;
+  int i = 0;
+  T s;
+  if ( n >= V::N )
+  {
+    typename V::Register r = M::template map<V> ( V::load ( p ) );
+    for ( i = V::N ; i + V::N <= n ; i += V::N )
+      r = C::template combine<V> ( r, M::template map<V> ( V::load ( p + i ) ) );
+    T buffer[V::N];
+    V::store ( buffer, r );
+    s = buffer[0];
+    for ( int j = 1 ; j < V::N ; j++ )
+      s = C::combineScalar ( s, buffer[j] );
+  } else {
+    s = M::mapScalar ( p[0] );
+    i = 1;
+  }
+  for ( ; i < n ; i++ )
+    s = C::combineScalar ( s, M::mapScalar ( p[i] ) );
+  return s;
+}
+
+// element-wise operations
+struct SimdAdd
+{
+  template<class V>
+  static typename V::Register apply ( typename V::Register a, typename V::Register b ) { return V::add ( a, b ); }
+  template<class T>
+  static T applyScalar ( T a, T b ) { return a + b; }
+};
+
+struct SimdSub
+{
+  template<class V>
+  static typename V::Register apply ( typename V::Register a, typename V::Register b ) { return V::sub ( a, b ); }
+  template<class T>
+  static T applyScalar ( T a, T b ) { return a - b; }
+};
+
+struct SimdSubReverse
+{
+  template<class V>
+  static typename V::Register apply ( typename V::Register a, typename V::Register b ) { return V::sub ( b, a ); }
+  template<class T>
+  static T applyScalar ( T a, T b ) { return b - a; }
+};
+
+struct SimdMul
+{
+  template<class V>
+  static typename V::Register apply ( typename V::Register a, typename V::Register b ) { return V::mul ( a, b ); }
+  template<class T>
+  static T applyScalar ( T a, T b ) { return a * b; }
+};
+
+struct SimdDiv
+{
+  template<class V>
+  static typename V::Register apply ( typename V::Register a, typename V::Register b ) { return V::div ( a, b ); }
+  template<class T>
+  static T applyScalar ( T a, T b ) { return a / b; }
+};
+
+template<class V, class O>
+void simdBinary ( const typename V::Scalar *a, const typename V::Scalar *b, typename V::Scalar *dst, int n )
+{
+  int i = 0;
+  for ( ; i + 2 * V::N <= n ; i += 2 * V::N )
+  {
+    typename V::Register r0 = O::template apply<V> ( V::load ( a + i ), V::load ( b + i ) );
+    typename V::Register r1 = O::template apply<V> ( V::load ( a + i + V::N ), V::load ( b + i + V::N ) );
+    V::store ( dst + i, r0 );
+    V::store ( dst + i + V::N, r1 );
+  }
+  for ( ; i + V::N <= n ; i += V::N )
+    V::store ( dst + i, O::template apply<V> ( V::load ( a + i ), V::load ( b + i ) ) );
+  for ( ; i < n ; i++ )
+    dst[i] = O::applyScalar ( a[i], b[i] );
+}
+
+template<class V, class O>
+void simdConstant ( const typename V::Scalar *a, typename V::Scalar c, typename V::Scalar *dst, int n )
+{
+  const typename V::Register rc = V::set1 ( c );
+  int i = 0;
+  for ( ; i + 2 * V::N <= n ; i += 2 * V::N )
+  {
+    typename V::Register r0 = O::template apply<V> ( V::load ( a + i ), rc );
+    typename V::Register r1 = O::template apply<V> ( V::load ( a + i + V::N ), rc );
+    V::store ( dst + i, r0 );
+    V::store ( dst + i + V::N, r1 );
+  }
+  for ( ; i + V::N <= n ; i += V::N )
+    V::store ( dst + i, O::template apply<V> ( V::load ( a + i ), rc ) );
+  for ( ; i < n ; i++ )
+    dst[i] = O::applyScalar ( a[i], c );
+}
+
+template<class V>
+void simdAddProductC ( const typename V::Scalar *a, typename V::Scalar c, typename V::Scalar *dst, int n )
+{
+  const typename V::Register rc = V::set1 ( c );
+  int i = 0;
+  for ( ; i + 2 * V::N <= n ; i += 2 * V::N )
+  {
+    typename V::Register r0 = V::add ( V::load ( dst + i ), V::mul ( V::load ( a + i ), rc ) );
+    typename V::Register r1 = V::add ( V::load ( dst + i + V::N ), V::mul ( V::load ( a + i + V::N ), rc ) );
+    V::store ( dst + i, r0 );
+    V::store ( dst + i + V::N, r1 );
+  }
+  for ( ; i + V::N <= n ; i += V::N )
+    V::store ( dst + i, V::add ( V::load ( dst + i ), V::mul ( V::load ( a + i ), rc ) ) );
+  for ( ; i < n ; i++ )
+  {
+    // separate statements, not contracted to a fused multiply-add
+    const typename V::Scalar p = a[i] * c;
+    dst[i] += p;
+  }
+}
+
+template<class V>
+void simdAbs ( const typename V::Scalar *a, typename V::Scalar *dst, int n )
+{
+  int i = 0;
+  for ( ; i + V::N <= n ; i += V::N )
+    V::store ( dst + i, V::abs ( V::load ( a + i ) ) );
+  for ( ; i < n ; i++ )
+    dst[i] = SimdAbsolute::mapScalar ( a[i] );
+}
+
+template<class V>
+void simdSet ( typename V::Scalar value, typename V::Scalar *dst, int n )
+{
+  const typename V::Register r = V::set1 ( value );
+  int i = 0;
+  for ( ; i + V::N <= n ; i += V::N )
+    V::store ( dst + i, r );
+  for ( ; i < n ; i++ )
+    dst[i] = value;
+}
+
+template<class F, class D>
+void simdFill ( SimdKernels::Table & t )
+{
+  t.sum32f = simdSum<F, SimdIdentity>;
+  t.sum64f = simdSum<D, SimdIdentity>;
+  t.sumAbs32f = simdSum<F, SimdAbsolute>;
+  t.sumAbs64f = simdSum<D, SimdAbsolute>;
+  t.sumSquares32f = simdSum<F, SimdSquare>;
+  t.sumSquares64f = simdSum<D, SimdSquare>;
+  t.dot32f = simdDot<F>;
+  t.dot64f = simdDot<D>;
+  t.minValue32f = simdExtremum<F, SimdMinimum, SimdIdentity>;
+  t.minValue64f = simdExtremum<D, SimdMinimum, SimdIdentity>;
+  t.maxValue32f = simdExtremum<F, SimdMaximum, SimdIdentity>;
+  t.maxValue64f = simdExtremum<D, SimdMaximum, SimdIdentity>;
+  t.maxAbs32f = simdExtremum<F, SimdMaximum, SimdAbsolute>;
+  t.maxAbs64f = simdExtremum<D, SimdMaximum, SimdAbsolute>;
+
+  t.add32f = simdBinary<F, SimdAdd>;
+  t.add64f = simdBinary<D, SimdAdd>;
+  t.sub32f = simdBinary<F, SimdSub>;
+  t.sub64f = simdBinary<D, SimdSub>;
+  t.mul32f = simdBinary<F, SimdMul>;
+  t.mul64f = simdBinary<D, SimdMul>;
+  t.div32f = simdBinary<F, SimdDiv>;
+  t.div64f = simdBinary<D, SimdDiv>;
+
+  t.addC32f = simdConstant<F, SimdAdd>;
+  t.addC64f = simdConstant<D, SimdAdd>;
+  t.subC32f = simdConstant<F, SimdSub>;
+  t.subC64f = simdConstant<D, SimdSub>;
+  t.subCRev32f = simdConstant<F, SimdSubReverse>;
+  t.subCRev64f = simdConstant<D, SimdSubReverse>;
+  t.mulC32f = simdConstant<F, SimdMul>;
+  t.mulC64f = simdConstant<D, SimdMul>;
+  t.divC32f = simdConstant<F, SimdDiv>;
+  t.divC64f = simdConstant<D, SimdDiv>;
+  t.addProductC32f = simdAddProductC<F>;
+  t.addProductC64f = simdAddProductC<D>;
+
+  t.abs32f = simdAbs<F>;
+  t.abs64f = simdAbs<D>;
+  t.set32f = simdSet<F>;
+  t.set64f = simdSet<D>;
+}
+
+} // namespace
+
+} // namespace
@@ -0,0 +1,132 @@
+/**
+* @file SimdKernelsAVX2.cpp
+* @brief AVX2 kernels of SimdKernels
+* @date 10/19/2026
+
+*/
+#include "core/vector/SimdKernels.h"
+
+#ifdef NICE_SIMD_X86
+
+#include <immintrin.h>
+
+// only the functions of this file are compiled for AVX2, the remaining
+// library keeps the instruction set of the compiler flags
+#if defined(__clang__)
+#pragma clang attribute push ( __attribute__ ( ( target ( "avx2" ) ) ), apply_to = function )
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target ( "avx2" )
+// no fused multiply-add, the results have to equal the scalar kernels
+#pragma GCC optimize ( "fp-contract=off" )
+#endif
+
+namespace NICE {
+
+namespace {
+
+struct F32
+{
+  typedef float Scalar;
+  typedef __m256 Register;
+  enum { N = 8 };
+  static Register load ( const float *p ) { return _mm256_loadu_ps ( p ); }
+  static void store ( float *p, Register r ) { _mm256_storeu_ps ( p, r ); }
+  static Register set1 ( float v ) { return _mm256_set1_ps ( v ); }
+  static Register zero () { return _mm256_setzero_ps(); }
+  static Register add ( Register a, Register b ) { return _mm256_add_ps ( a, b ); }
+  static Register sub ( Register a, Register b ) { return _mm256_sub_ps ( a, b ); }
+  static Register mul ( Register a, Register b ) { return _mm256_mul_ps ( a, b ); }
+  static Register div ( Register a, Register b ) { return _mm256_div_ps ( a, b ); }
+  static Register minimum ( Register a, Register b ) { return _mm256_min_ps ( a, b ); }
+  static Register maximum ( Register a, Register b ) { return _mm256_max_ps ( a, b ); }
+  static Register abs ( Register a ) { return _mm256_andnot_ps ( _mm256_set1_ps ( -0.0f ), a ); }
+};
+
+struct F64
+{
+  typedef double Scalar;
+  typedef __m256d Register;
+  enum { N = 4 };
+  static Register load ( const double *p ) { return _mm256_loadu_pd ( p ); }
+  static void store ( double *p, Register r ) { _mm256_storeu_pd ( p, r ); }
+  static Register set1 ( double v ) { return _mm256_set1_pd ( v ); }
+  static Register zero () { return _mm256_setzero_pd(); }
+  static Register add ( Register a, Register b ) { return _mm256_add_pd ( a, b ); }
+  static Register sub ( Register a, Register b ) { return _mm256_sub_pd ( a, b ); }
+  static Register mul ( Register a, Register b ) { return _mm256_mul_pd ( a, b ); }
+  static Register div ( Register a, Register b ) { return _mm256_div_pd ( a, b ); }
+  static Register minimum ( Register a, Register b ) { return _mm256_min_pd ( a, b ); }
+  static Register maximum ( Register a, Register b ) { return _mm256_max_pd ( a, b ); }
+  static Register abs ( Register a ) { return _mm256_andnot_pd ( _mm256_set1_pd ( -0.0 ), a ); }
+};
+
+void convert8u32f ( const unsigned char *src, float *dst, int n )
+{
+  int i = 0;
+  for ( ; i + 16 <= n ; i += 16 )
+  {
+    __m128i bytes = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( src + i ) );
+    _mm256_storeu_ps ( dst + i, _mm256_cvtepi32_ps ( _mm256_cvtepu8_epi32 ( bytes ) ) );
+    _mm256_storeu_ps ( dst + i + 8, _mm256_cvtepi32_ps ( _mm256_cvtepu8_epi32 ( _mm_srli_si128 ( bytes, 8 ) ) ) );
+  }
+  for ( ; i < n ; i++ )
+    dst[i] = src[i];
+}
+
+inline __m256i saturate ( __m256 x, __m256 low, __m256 high, __m256 offset )
+{
+  return _mm256_cvttps_epi32 ( _mm256_add_ps ( _mm256_max_ps ( _mm256_min_ps ( x, high ), low ), offset ) );
+}
+
+void convert32f8u ( const float *src, unsigned char *dst, int n, bool round )
+{
+  const float offset = round ? 0.5f : 0.0f;
+  const __m256 low = _mm256_setzero_ps();
+  const __m256 high = _mm256_set1_ps ( 255.0f );
+  const __m256 roffset = _mm256_set1_ps ( offset );
+  int i = 0;
+  for ( ; i + 32 <= n ; i += 32 )
+  {
+    __m256i a = saturate ( _mm256_loadu_ps ( src + i ), low, high, roffset );
+    __m256i b = saturate ( _mm256_loadu_ps ( src + i + 8 ), low, high, roffset );
+    __m256i c = saturate ( _mm256_loadu_ps ( src + i + 16 ), low, high, roffset );
+    __m256i d = saturate ( _mm256_loadu_ps ( src + i + 24 ), low, high, roffset );
+    // the packs work within 128 bit lanes, the permutation restores the order
+    __m256i bytes = _mm256_packus_epi16 ( _mm256_packs_epi32 ( a, b ), _mm256_packs_epi32 ( c, d ) );
+    bytes = _mm256_permutevar8x32_epi32 ( bytes, _mm256_setr_epi32 ( 0, 4, 1, 5, 2, 6, 3, 7 ) );
+    _mm256_storeu_si256 ( reinterpret_cast<__m256i *> ( dst + i ), bytes );
+  }
+  for ( ; i < n ; i++ )
+  {
+    float x = src[i];
+    x = x < 255.0f ? x : 255.0f;
+    x = x > 0.0f ? x : 0.0f;
+    dst[i] = static_cast<unsigned char> ( static_cast<int> ( x + offset ) );
+  }
+}
+
+} // namespace
+
+} // namespace
+
+#include "core/vector/SimdKernels.tcc"
+
+namespace NICE {
+
+void SimdKernels::fillAVX2 ( Table & table )
+{
+  simdFill<F32, F64> ( table );
+  table.convert8u32f = convert8u32f;
+  table.convert32f8u = convert32f8u;
+}
+
+} // namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif
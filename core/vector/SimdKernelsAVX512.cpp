@@ -0,0 +1,91 @@
+/**
+* @file SimdKernelsAVX512.cpp
+* @brief AVX-512 kernels of SimdKernels
+* @date 10/19/2026
+
+*/
+#include "core/vector/SimdKernels.h"
+
+#ifdef NICE_SIMD_X86
+
+#include <immintrin.h>
+
+// only the functions of this file are compiled for AVX-512, the remaining
+// library keeps the instruction set of the compiler flags
+#if defined(__clang__)
+#pragma clang attribute push ( __attribute__ ( ( target ( "avx512f" ) ) ), apply_to = function )
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target ( "avx512f" )
+// no fused multiply-add, the results have to equal the scalar kernels
+#pragma GCC optimize ( "fp-contract=off" )
+#endif
+
+namespace NICE {
+
+namespace {
+
+struct F32
+{
+  typedef float Scalar;
+  typedef __m512 Register;
+  enum { N = 16 };
+  static Register load ( const float *p ) { return _mm512_loadu_ps ( p ); }
+  static void store ( float *p, Register r ) { _mm512_storeu_ps ( p, r ); }
+  static Register set1 ( float v ) { return _mm512_set1_ps ( v ); }
+  static Register zero () { return _mm512_setzero_ps(); }
+  static Register add ( Register a, Register b ) { return _mm512_add_ps ( a, b ); }
+  static Register sub ( Register a, Register b ) { return _mm512_sub_ps ( a, b ); }
+  static Register mul ( Register a, Register b ) { return _mm512_mul_ps ( a, b ); }
+  static Register div ( Register a, Register b ) { return _mm512_div_ps ( a, b ); }
+  static Register minimum ( Register a, Register b ) { return _mm512_min_ps ( a, b ); }
+  static Register maximum ( Register a, Register b ) { return _mm512_max_ps ( a, b ); }
+  // the floating point and of AVX-512 requires AVX512DQ
+  static Register abs ( Register a ) {
+    return _mm512_castsi512_ps ( _mm512_and_si512 ( _mm512_castps_si512 ( a ), _mm512_set1_epi32 ( 0x7fffffff ) ) );
+  }
+};
+
+struct F64
+{
+  typedef double Scalar;
+  typedef __m512d Register;
+  enum { N = 8 };
+  static Register load ( const double *p ) { return _mm512_loadu_pd ( p ); }
+  static void store ( double *p, Register r ) { _mm512_storeu_pd ( p, r ); }
+  static Register set1 ( double v ) { return _mm512_set1_pd ( v ); }
+  static Register zero () { return _mm512_setzero_pd(); }
+  static Register add ( Register a, Register b ) { return _mm512_add_pd ( a, b ); }
+  static Register sub ( Register a, Register b ) { return _mm512_sub_pd ( a, b ); }
+  static Register mul ( Register a, Register b ) { return _mm512_mul_pd ( a, b ); }
+  static Register div ( Register a, Register b ) { return _mm512_div_pd ( a, b ); }
+  static Register minimum ( Register a, Register b ) { return _mm512_min_pd ( a, b ); }
+  static Register maximum ( Register a, Register b ) { return _mm512_max_pd ( a, b ); }
+  static Register abs ( Register a ) {
+    return _mm512_castsi512_pd ( _mm512_and_si512 ( _mm512_castpd_si512 ( a ), _mm512_set1_epi64 ( 0x7fffffffffffffffLL ) ) );
+  }
+};
+
+} // namespace
+
+} // namespace
+
+#include "core/vector/SimdKernels.tcc"
+
+namespace NICE {
+
+// the conversions of AVX2 are kept
+void SimdKernels::fillAVX512 ( Table & table )
+{
+  simdFill<F32, F64> ( table );
+}
+
+} // namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif
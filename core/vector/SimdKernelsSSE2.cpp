@@ -0,0 +1,133 @@
+/**
+* @file SimdKernelsSSE2.cpp
+* @brief SSE2 kernels of SimdKernels
+* @date 10/19/2026
+
+*/
+#include "core/vector/SimdKernels.h"
+
+#ifdef NICE_SIMD_X86
+
+#include <emmintrin.h>
+
+// only the functions of this file are compiled for SSE2, the remaining
+// library keeps the instruction set of the compiler flags
+#if defined(__clang__)
+#pragma clang attribute push ( __attribute__ ( ( target ( "sse2" ) ) ), apply_to = function )
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target ( "sse2" )
+#endif
+
+namespace NICE {
+
+namespace {
+
+struct F32
+{
+  typedef float Scalar;
+  typedef __m128 Register;
+  enum { N = 4 };
+  static Register load ( const float *p ) { return _mm_loadu_ps ( p ); }
+  static void store ( float *p, Register r ) { _mm_storeu_ps ( p, r ); }
+  static Register set1 ( float v ) { return _mm_set1_ps ( v ); }
+  static Register zero () { return _mm_setzero_ps(); }
+  static Register add ( Register a, Register b ) { return _mm_add_ps ( a, b ); }
+  static Register sub ( Register a, Register b ) { return _mm_sub_ps ( a, b ); }
+  static Register mul ( Register a, Register b ) { return _mm_mul_ps ( a, b ); }
+  static Register div ( Register a, Register b ) { return _mm_div_ps ( a, b ); }
+  static Register minimum ( Register a, Register b ) { return _mm_min_ps ( a, b ); }
+  static Register maximum ( Register a, Register b ) { return _mm_max_ps ( a, b ); }
+  static Register abs ( Register a ) { return _mm_andnot_ps ( _mm_set1_ps ( -0.0f ), a ); }
+};
+
+struct F64
+{
+  typedef double Scalar;
+  typedef __m128d Register;
+  enum { N = 2 };
+  static Register load ( const double *p ) { return _mm_loadu_pd ( p ); }
+  static void store ( double *p, Register r ) { _mm_storeu_pd ( p, r ); }
+  static Register set1 ( double v ) { return _mm_set1_pd ( v ); }
+  static Register zero () { return _mm_setzero_pd(); }
+  static Register add ( Register a, Register b ) { return _mm_add_pd ( a, b ); }
+  static Register sub ( Register a, Register b ) { return _mm_sub_pd ( a, b ); }
+  static Register mul ( Register a, Register b ) { return _mm_mul_pd ( a, b ); }
+  static Register div ( Register a, Register b ) { return _mm_div_pd ( a, b ); }
+  static Register minimum ( Register a, Register b ) { return _mm_min_pd ( a, b ); }
+  static Register maximum ( Register a, Register b ) { return _mm_max_pd ( a, b ); }
+  static Register abs ( Register a ) { return _mm_andnot_pd ( _mm_set1_pd ( -0.0 ), a ); }
+};
+
+void convert8u32f ( const unsigned char *src, float *dst, int n )
+{
+  const __m128i zero = _mm_setzero_si128();
+  int i = 0;
+  for ( ; i + 16 <= n ; i += 16 )
+  {
+    __m128i bytes = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( src + i ) );
+    __m128i low = _mm_unpacklo_epi8 ( bytes, zero );
+    __m128i high = _mm_unpackhi_epi8 ( bytes, zero );
+    _mm_storeu_ps ( dst + i, _mm_cvtepi32_ps ( _mm_unpacklo_epi16 ( low, zero ) ) );
+    _mm_storeu_ps ( dst + i + 4, _mm_cvtepi32_ps ( _mm_unpackhi_epi16 ( low, zero ) ) );
+    _mm_storeu_ps ( dst + i + 8, _mm_cvtepi32_ps ( _mm_unpacklo_epi16 ( high, zero ) ) );
+    _mm_storeu_ps ( dst + i + 12, _mm_cvtepi32_ps ( _mm_unpackhi_epi16 ( high, zero ) ) );
+  }
+  for ( ; i < n ; i++ )
+    dst[i] = src[i];
+}
+
+inline __m128i saturate ( __m128 x, __m128 low, __m128 high, __m128 offset )
+{
+  return _mm_cvttps_epi32 ( _mm_add_ps ( _mm_max_ps ( _mm_min_ps ( x, high ), low ), offset ) );
+}
+
+void convert32f8u ( const float *src, unsigned char *dst, int n, bool round )
+{
+  const float offset = round ? 0.5f : 0.0f;
+  const __m128 low = _mm_setzero_ps();
+  const __m128 high = _mm_set1_ps ( 255.0f );
+  const __m128 roffset = _mm_set1_ps ( offset );
+  int i = 0;
+  for ( ; i + 16 <= n ; i += 16 )
+  {
+    __m128i a = saturate ( _mm_loadu_ps ( src + i ), low, high, roffset );
+    __m128i b = saturate ( _mm_loadu_ps ( src + i + 4 ), low, high, roffset );
+    __m128i c = saturate ( _mm_loadu_ps ( src + i + 8 ), low, high, roffset );
+    __m128i d = saturate ( _mm_loadu_ps ( src + i + 12 ), low, high, roffset );
+    __m128i bytes = _mm_packus_epi16 ( _mm_packs_epi32 ( a, b ), _mm_packs_epi32 ( c, d ) );
+    _mm_storeu_si128 ( reinterpret_cast<__m128i *> ( dst + i ), bytes );
+  }
+  for ( ; i < n ; i++ )
+  {
+    float x = src[i];
+    x = x < 255.0f ? x : 255.0f;
+    x = x > 0.0f ? x : 0.0f;
+    dst[i] = static_cast<unsigned char> ( static_cast<int> ( x + offset ) );
+  }
+}
+
+} // namespace
+
+} // namespace
+
+#include "core/vector/SimdKernels.tcc"
+
+namespace NICE {
+
+void SimdKernels::fillSSE2 ( Table & table )
+{
+  simdFill<F32, F64> ( table );
+  table.convert8u32f = convert8u32f;
+  table.convert32f8u = convert32f8u;
+}
+
+} // namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif
@@ -27,7 +27,10 @@ class SparseVectorT : public std::map<I, V>, public Persistent
       // SVECTOR dimension size index value index value ... END
       FORMAT_INDEX = 0,
       // index:value index:value \n
-      FORMAT_INDEX_LINE = -9999 
+      FORMAT_INDEX_LINE = -9999,
+      // binary: dimension, size, all indices and all values as contiguous blocks,
+      // restore replaces the previous content of the vector
+      FORMAT_BINARY = 1
     };
 
   protected:
@@ -221,6 +224,17 @@ class SparseVectorT : public std::map<I, V>, public Persistent
     void convertToVectorT(NICE::VectorT<V> & _v ) const ;     
 };
 
+/**
+ * Write a sparse vector in the versioned binary block format: the dimension
+ * followed by a block of all indices and a block of all values.
+ */
+template<class I, class V>
+void writeBinaryBlock ( NICE::obinstream & s, const SparseVectorT<I,V> & v, bool checksum = false );
+
+/** Read a sparse vector in the versioned binary block format */
+template<class I, class V>
+void readBinaryBlock ( NICE::ibinstream & s, SparseVectorT<I,V> & v );
+
 typedef SparseVectorT<unsigned long, double> SparseVectorLong;
 typedef SparseVectorT<unsigned int, double> SparseVectorInt;
 typedef SparseVectorT<unsigned short, double> SparseVector;
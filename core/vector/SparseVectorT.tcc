@@ -11,8 +11,52 @@
 #include <stdio.h>
 
 #include "core/vector/SparseVectorT.h"
+#include "core/basics/Log.h"
 
 namespace NICE {
+
+template<class I, class V>
+void writeBinaryBlock ( NICE::obinstream & s, const SparseVectorT<I,V> & v, bool checksum )
+{
+  std::vector<I> indices;
+  std::vector<V> values;
+  indices.reserve ( v.size() );
+  values.reserve ( v.size() );
+  for ( typename SparseVectorT<I,V>::const_iterator it = v.begin(); it != v.end(); it++ )
+  {
+    indices.push_back ( it->first );
+    values.push_back ( it->second );
+  }
+
+  unsigned long long dim = v.getDim();
+  s << dim;
+  writeBinaryBlock ( s, indices.empty() ? (const I *) NULL : &(indices[0]), indices.size(), 1, checksum );
+  writeBinaryBlock ( s, values.empty() ? (const V *) NULL : &(values[0]), values.size(), 1, checksum );
+}
+
+template<class I, class V>
+void readBinaryBlock ( NICE::ibinstream & s, SparseVectorT<I,V> & v )
+{
+  unsigned long long dim;
+  s >> dim;
+
+  BinaryBlockHeader header;
+  header.read ( s );
+  std::vector<I> indices ( header.numElements() );
+  readBinaryBlockData ( s, header, indices.empty() ? (I *) NULL : &(indices[0]) );
+
+  header.read ( s );
+  if ( header.numElements() != indices.size() )
+    fthrow ( Exception, "readBinaryBlock: number of indices and values of the sparse vector differ" );
+  std::vector<V> values ( header.numElements() );
+  readBinaryBlockData ( s, header, values.empty() ? (V *) NULL : &(values[0]) );
+
+  v.clear();
+  v.setDim ( dim );
+  for ( size_t i = 0; i < indices.size(); i++ )
+    v.insert ( v.end(), std::pair<I, V> ( indices[i], values[i] ) );
+}
+
 template<typename I, typename V>
 SparseVectorT<I,V>::SparseVectorT ( const std::map<I, V> & mymap ):std::map<I, V> ( mymap )
 {
@@ -230,6 +274,28 @@ void SparseVectorT<I,V>::restore ( std::istream & is, int format )
 
     // preserve dimension setting
     //dimension = -1;
+  } else if ( format == FORMAT_BINARY ) {
+    unsigned long long header[2];
+    is.read ( (char *) header, sizeof(header) );
+    if ( is.gcount() != (std::streamsize) sizeof(header) )
+      fthrow ( Exception, "Format error: unable to read the binary sparse vector header" );
+    dim = header[0];
+    size_t size = header[1];
+
+    std::vector<I> indices ( size );
+    std::vector<V> values ( size );
+    if ( size > 0 )
+    {
+      is.read ( (char *) &(indices[0]), size * sizeof(I) );
+      is.read ( (char *) &(values[0]), size * sizeof(V) );
+      if ( is.gcount() != (std::streamsize) ( size * sizeof(V) ) )
+        fthrow ( Exception, "Format error: unexpected end of the binary sparse vector" );
+    }
+    // the binary format stores the complete vector, previous entries are
+    // removed; indices are sorted, inserting at the end is amortized constant
+    std::map<I, V>::clear();
+    for ( size_t i = 0; i < size; i++ )
+      this->insert ( this->end(), std::pair<I, V> ( indices[i], values[i] ) );
   } else {
     fthrow(Exception, "Unknown format! (see SparseVectorT.h for details)");
   }
@@ -258,6 +324,23 @@ void SparseVectorT<I,V>::store ( std::ostream & os, int format ) const
       os << it->first << ":" << it->second;
     }
     os << std::endl;
+  } else if ( format == FORMAT_BINARY ) {
+    unsigned long long header[2] = { dim, this->size() };
+    std::vector<I> indices;
+    std::vector<V> values;
+    indices.reserve ( this->size() );
+    values.reserve ( this->size() );
+    for ( typename SparseVectorT<I,V>::const_iterator it = this->begin(); it != this->end(); it++ )
+    {
+      indices.push_back ( it->first );
+      values.push_back ( it->second );
+    }
+    os.write ( (const char *) header, sizeof(header) );
+    if ( this->size() > 0 )
+    {
+      os.write ( (const char *) &(indices[0]), indices.size() * sizeof(I) );
+      os.write ( (const char *) &(values[0]), values.size() * sizeof(V) );
+    }
   } else {
     fthrow(Exception, "Unknown format! (see SparseVectorT.h for details)");
   }
@@ -286,7 +369,7 @@ void SparseVectorT<I,V>::normalize ()
 
   if ( fabs ( sum ) < 1e-20 )
   {
-    fprintf ( stderr, "WARNING: normalization failed !\n" );
+    NICE_LOG_WARNING ( "SparseVectorT::normalize: normalization failed, the sum is zero !" );
     for ( typename SparseVectorT<I,V>::iterator it = this->begin(); it != this->end(); it++ )
       it->second = 0.0;
   } else 
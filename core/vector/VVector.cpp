@@ -11,6 +11,7 @@
 #include <algorithm>
 
 #include "VVector.h"
+#include "core/basics/Log.h"
 
 using namespace std;
 using namespace NICE;
@@ -146,7 +147,7 @@ void VVector::restore ( istream & is, int format )
   {
 
     if ( bufsize <= 0 ) {
-      fprintf ( stderr, "VVector: you have to set buf size !!\n" );
+      NICE_LOG_ERROR ( "VVector: you have to set buf size !!" );
       exit ( -1 );
     }
     unsigned char *buf = new unsigned char[bufsize];
@@ -178,35 +179,36 @@ void VVector::restore ( istream & is, int format )
   {
 
     if ( bufsize <= 0 ) {
-      fprintf ( stderr, "VVector: you have to set buf size !!\n" );
+      NICE_LOG_ERROR ( "VVector: you have to set buf size !!" );
       exit ( -1 );
     }
 
-    double *buf = new double[bufsize];
-    f = Vector ( bufsize );
+    // read directly into the memory of the new vectors
     if (ioUntilEndOfFile)
     {     
       while ( ! is.eof() )
       {
-        is.read ( ( char * ) buf, sizeof ( double ) *bufsize );
-        if ( is.gcount() != ( int ) ( sizeof ( double ) *bufsize ) ) break;
-        for ( size_t k = 0 ; k < bufsize ; k++ )
-          f[k] = buf[k];
-        push_back ( f );
+        push_back ( Vector ( bufsize ) );
+        is.read ( ( char * ) back().getDataPointer(), sizeof ( double ) *bufsize );
+        if ( is.gcount() != ( int ) ( sizeof ( double ) *bufsize ) ) {
+          pop_back();
+          break;
+        }
       }
     }
     else
     {
+      reserve ( size() + nrOfVectors );
       for (int i = 0; i < nrOfVectors; i++)
       {
-        is.read ( ( char * ) buf, sizeof ( double ) *bufsize );
-        if ( is.gcount() != ( int ) ( sizeof ( double ) *bufsize ) ) break;
-        for ( size_t k = 0 ; k < bufsize ; k++ )
-          f[k] = buf[k];
-        push_back ( f );        
+        push_back ( Vector ( bufsize ) );
+        is.read ( ( char * ) back().getDataPointer(), sizeof ( double ) *bufsize );
+        if ( is.gcount() != ( int ) ( sizeof ( double ) *bufsize ) ) {
+          pop_back();
+          break;
+        }
       }
     } 
-    delete [] buf;
   }
 
 }
@@ -244,16 +246,18 @@ void VVector::store ( ostream & os, int format ) const
     }
   } else if ( format == FILEFORMAT_BINARY_CHAR ) 
   {
+    std::vector<unsigned char> buf;
     for ( const_iterator i = begin();
           i != end();
           i++ )
     {
       const NICE::Vector & cluster = *i;
-      unsigned char *buf = new unsigned char[cluster.size() ];
+      if ( cluster.size() == 0 )
+        continue;
+      buf.resize ( cluster.size() );
       for ( size_t k = 0 ; k < cluster.size() ; k++ )
         buf[k] = ( unsigned char ) ( cluster[k] * 512 );
-      os.write ( ( char * ) buf, sizeof ( unsigned char ) *cluster.size() );
-      delete [] buf;
+      os.write ( ( char * ) &(buf[0]), sizeof ( unsigned char ) *cluster.size() );
     }
   } else if ( format == FILEFORMAT_BINARY_DOUBLE ) {
     for ( const_iterator i = begin();
@@ -261,13 +265,9 @@ void VVector::store ( ostream & os, int format ) const
           i++ )
     {
       const NICE::Vector & cluster = *i;
-      double *buf = new double[cluster.size() ];
-      for ( size_t k = 0 ; k < cluster.size() ; k++ )
-        buf[k] = ( double ) cluster[k];
-      os.write ( ( char * ) buf, sizeof ( double ) *cluster.size() );
-      delete [] buf;
-    }
+      os.write ( ( const char * ) cluster.getDataPointer(), sizeof ( double ) *cluster.size() );
     }
+  }
 }
 
 void VVector::clear()
@@ -11,11 +11,16 @@
 #include <vector>
 #include <stdexcept>
 #include <cstddef> // needed for ptrdiff_t
+#include <algorithm>
+#include <utility>
 
 
 #include "core/vector/ippwrapper.h"
 
 #include <core/basics/binstream.h>
+#include <core/basics/BinaryBlock.h>
+#include <core/basics/Allocator.h>
+#include <core/basics/CrossplatformDefines.h>
 
 #ifdef NICE_USELIB_LINAL
     #include <LinAl/vectorC.h>
@@ -33,6 +38,8 @@ template<class ElementType>
 class MatrixT;
 template<class ElementType>
 class RowMatrixT;
+template<class E>
+class VectorExpression;
 
 /**
  * @class VectorT
@@ -146,6 +153,21 @@ public:
     //! copy constructor
     VectorT(const VectorT<ElementType>& v);
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+    /**
+    * @brief move constructor: takes the data of \c v, which is empty afterwards.
+    *        The data of a \c v with external storage is copied.
+    */
+    VectorT(VectorT<ElementType>&& v);
+#endif
+
+    /**
+    * @brief Evaluate a lazy expression (see ExpressionT.h) in a single loop.
+    * @param e expression, e.g. <tt>lazy(a) + lazy(b) * s</tt>
+    */
+    template<class E>
+    VectorT(const VectorExpression<E>& e);
+
 
     /**
     * \}
@@ -481,6 +503,27 @@ public:
     */
     inline VectorT<ElementType>& operator=(const ElementType& element);
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+    /**
+    * @brief Move assignment: takes the data of \c v if neither vector uses
+    *        external storage, and copies the elements otherwise.
+    */
+    inline VectorT<ElementType>& operator=(VectorT<ElementType>&& v);
+#endif
+
+    /**
+    * @brief Evaluate a lazy expression (see ExpressionT.h) in a single loop
+    *        without temporaries. The vector is resized if necessary.
+    */
+    template<class E>
+    inline VectorT<ElementType>& operator=(const VectorExpression<E>& e);
+
+    /**
+    * @brief Exchange the data of both vectors without copying the elements.
+    *        External storage is exchanged as well.
+    */
+    inline void swap(VectorT<ElementType>& v);
+
     /**
     * @brief Add \c e to each element of \c this.
     * @param e value
@@ -601,6 +644,37 @@ public:
     * \{
     */
 
+    /**
+    * @brief In-place BLAS-1 update: this = this + alpha * x
+    *        (a single pass over the memory without any temporary vector)
+    * @pre Size of \c x and \c this must be equal
+    * @param alpha scalar factor
+    * @param x vector to add
+    */
+    inline void axpy(const ElementType& alpha, const VectorT<ElementType>& x);
+
+    /**
+    * @brief In-place BLAS-1 update: this = alpha * x + beta * this
+    *        (a single pass over the memory without any temporary vector)
+    * @pre Size of \c x and \c this must be equal
+    * @param alpha scalar factor of x
+    * @param x vector to add
+    * @param beta scalar factor of this
+    */
+    inline void axpby(const ElementType& alpha, const VectorT<ElementType>& x,
+                      const ElementType& beta);
+
+    /**
+    * @brief Fused scalar product and squared L2 norm computed in a single pass:
+    *        returns this * v and sets squaredNorm = this * this
+    * @pre Size of \c v and \c this must be equal
+    * @param v second factor of the scalar product
+    * @param squaredNorm squared L2 norm of this (output)
+    * @return this * v
+    */
+    inline ElementType scalarProductAndSquaredNorm(const VectorT<ElementType>& v,
+                                                   ElementType& squaredNorm) const;
+
     /**
     * Matrix Vector multiplication: this = a^{T if atranspose} * v
     * The formats of this, a and v must be consistent.
@@ -885,6 +959,10 @@ inline NICE::ibinstream& operator>>(NICE::ibinstream& s, VectorT<Tp> &r)
   unsigned int size;
   s >> size;
   r.resize(size);
+  if ( BinaryElementType<Tp>::id != 0 ) {
+    s.readBlock((char*) r.getDataPointer(), size * sizeof(Tp));
+    return s;
+  }
   typename VectorT<Tp>::iterator it=r.begin();
   for(;it!=r.end();it++)
     s>>*it;
@@ -896,11 +974,38 @@ inline NICE::obinstream& operator<<(NICE::obinstream& s, const VectorT<Tp>& r)
 {
   unsigned int size=r.size();
   s<<size;
+  if ( BinaryElementType<Tp>::id != 0 ) {
+    s.writeBlock((const char*) r.getDataPointer(), size * sizeof(Tp));
+    return s;
+  }
   typename VectorT<Tp>::const_iterator it=r.begin();
   for(;it!=r.end();it++)
     s << *it;
   return s;
 }
+
+/**
+ * Write a vector in the versioned binary block format (element type, byte
+ * order, size and an optional CRC-32 checksum, see BinaryBlockHeader).
+ */
+template <class Tp>
+inline void writeBinaryBlock(NICE::obinstream& s, const VectorT<Tp>& r, bool checksum = false)
+{
+  writeBinaryBlock(s, r.getDataPointer(), r.size(), 1, checksum);
+}
+
+/**
+ * Read a vector in the versioned binary block format, data written on a
+ * machine with a different byte order is converted.
+ */
+template <class Tp>
+inline void readBinaryBlock(NICE::ibinstream& s, VectorT<Tp>& r)
+{
+  BinaryBlockHeader header;
+  header.read(s);
+  r.resize(header.numElements());
+  readBinaryBlockData(s, header, r.getDataPointer());
+}
 //#endif
 
 typedef VectorT<bool>   BoolVector;
@@ -947,11 +1052,65 @@ inline VectorT<Tp> operator* ( double s, const VectorT<Tp> & x )
     return dst;
 }
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+// The data of a temporary is only reused if the vector owns it: a temporary
+// view (e.g. getRangeRef()) refers to the data of another vector, which must
+// not be modified.
+
+/** vector addition reusing the data of a temporary */
+template <class Tp>
+inline VectorT<Tp> operator+ ( VectorT<Tp> && x, const VectorT<Tp> & y )
+{
+    if ( x.isExternal() )
+        return static_cast<const VectorT<Tp> &> ( x ) + y;
+    x += y;
+    return std::move ( x );
+}
+
+/** vector subtraction reusing the data of a temporary */
+template <class Tp>
+inline VectorT<Tp> operator- ( VectorT<Tp> && x, const VectorT<Tp> & y )
+{
+    if ( x.isExternal() )
+        return static_cast<const VectorT<Tp> &> ( x ) - y;
+    x -= y;
+    return std::move ( x );
+}
+
+/** multiply a temporary vector with a scalar */
+template <class Tp>
+inline VectorT<Tp> operator* ( VectorT<Tp> && x, double s )
+{
+    if ( x.isExternal() )
+        return static_cast<const VectorT<Tp> &> ( x ) * s;
+    x *= s;
+    return std::move ( x );
+}
+
+/** multiply a temporary vector with a scalar */
+template <class Tp>
+inline VectorT<Tp> operator* ( double s, VectorT<Tp> && x )
+{
+    if ( x.isExternal() )
+        return s * static_cast<const VectorT<Tp> &> ( x );
+    x *= s;
+    return std::move ( x );
+}
+#endif
+
+/** exchange the data of two vectors */
+template <class Tp>
+inline void swap ( VectorT<Tp> & x, VectorT<Tp> & y )
+{
+    x.swap ( y );
+}
+
 
 } // namespace
 
 #include "core/vector/MatrixT.h"
 #include "core/vector/RowMatrixT.h"
+#include "core/vector/ExpressionT.h"
 
 //#ifdef __GNUC__
 #include "core/vector/VectorT.tcc"
@@ -9,6 +9,7 @@
 #include "core/vector/ippwrapper.h"
 #include "core/vector/VectorT.h"
 #include "core/vector/MatrixT.h"
+#include "core/vector/ExpressionT.h"
 
 #include <iostream>
 
@@ -21,20 +22,20 @@ inline VectorT<ElementType>::VectorT() {
 
 template<typename ElementType>
 inline VectorT<ElementType>::VectorT(const size_t size) {
-  setDataPointer(new ElementType[size], size, false);
+  setDataPointer(Allocator::newArray<ElementType>(size), size, false);
 }
 
 template<typename ElementType>
 inline VectorT<ElementType>::VectorT(const size_t size,
                                      const ElementType& element) {
-  setDataPointer(new ElementType[size], size, false);
+  setDataPointer(Allocator::newArray<ElementType>(size), size, false);
   ippsSet(element, getDataPointer(), size);
 }
 
 template<typename ElementType>
 inline VectorT<ElementType>::VectorT(const ElementType* _data,
                                      const size_t size) {
-  setDataPointer(new ElementType[size], size, false);
+  setDataPointer(Allocator::newArray<ElementType>(size), size, false);
   ippsCopy(_data, getDataPointer(), size);
 }
 
@@ -46,7 +47,7 @@ inline VectorT<ElementType>::VectorT(ElementType* _data, const size_t size,
     setDataPointer(_data, size, true);
     break;
   case copy:
-    setDataPointer(new ElementType[size], size, false);
+    setDataPointer(Allocator::newArray<ElementType>(size), size, false);
     ippsCopy(_data, getDataPointer(), size);
     break;
    default:
@@ -58,7 +59,7 @@ inline VectorT<ElementType>::VectorT(ElementType* _data, const size_t size,
 template<typename ElementType>
 VectorT<ElementType>::VectorT(const std::vector<ElementType>& v) {
 
-    setDataPointer(new ElementType[v.size()], v.size(), false);
+    setDataPointer(Allocator::newArray<ElementType>(v.size()), v.size(), false);
     ippsCopy(&(*v.begin()), getDataPointer(), v.size());
 }
 
@@ -85,7 +86,7 @@ VectorT<ElementType>::VectorT(std::istream& input, const bool & AwAFormat) {
   else
     input >> dataSize;
 
-  setDataPointer(new ElementType[dataSize], dataSize, false);
+  setDataPointer(Allocator::newArray<ElementType>(dataSize), dataSize, false);
 
   if (AwAFormat)
   {
@@ -132,15 +133,35 @@ VectorT<ElementType>::VectorT(std::istream& input, const bool & AwAFormat) {
 
 template<typename ElementType>
 VectorT<ElementType>::VectorT(const VectorT<ElementType>& v) {
-  setDataPointer(new ElementType[v.dataSize], v.dataSize, false);
+  setDataPointer(Allocator::newArray<ElementType>(v.dataSize), v.dataSize, false);
   ippsCopy(v.getDataPointer(), getDataPointer(), dataSize);
 }
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+template<typename ElementType>
+VectorT<ElementType>::VectorT(VectorT<ElementType>&& v) {
+  if (v.externalStorage) {
+    setDataPointer(Allocator::newArray<ElementType>(v.dataSize), v.dataSize, false);
+    ippsCopy(v.constData, getDataPointer(), dataSize);
+  } else {
+    setDataPointer(v.data, v.dataSize, false);
+    v.setDataPointer(NULL, 0, false);
+  }
+}
+#endif
+
+template<typename ElementType>
+template<class E>
+VectorT<ElementType>::VectorT(const VectorExpression<E>& e) {
+  setDataPointer(Allocator::newArray<ElementType>(e.size()), e.size(), false);
+  e.evaluateTo(getDataPointer());
+}
+
 
 #ifdef NICE_USELIB_LINAL
 template<typename ElementType>
 inline VectorT<ElementType>::VectorT(const LinAl::VectorC<ElementType>& v) {
-  setDataPointer(new ElementType[v.size()], v.size(), false);
+  setDataPointer(Allocator::newArray<ElementType>(v.size()), v.size(), false);
   for (unsigned int i = 0; i < size(); i++) {
       (*this)(i) = v(i);
   }
@@ -150,7 +171,7 @@ template<typename ElementType>
 inline VectorT<ElementType>&
 VectorT<ElementType>::operator=(const LinAl::VectorCC<ElementType>& v) {
   if (size() == 0 && !externalStorage && getDataPointer() == NULL) {
-    setDataPointer(new ElementType[v.size()], v.size(), false);
+    setDataPointer(Allocator::newArray<ElementType>(v.size()), v.size(), false);
   } else if (this->size() != (unsigned int) v.size()) {
     this->resize(v.size());
   }
@@ -165,7 +186,7 @@ VectorT<ElementType>::operator=(const LinAl::VectorCC<ElementType>& v) {
 template<typename ElementType>
 inline VectorT<ElementType>::~VectorT() {
   if (!externalStorage && data != NULL) {
-    delete[] data;
+    Allocator::deleteArray(data);
     setDataPointer(NULL, 0, false);
   }
 }
@@ -180,7 +201,7 @@ void VectorT<ElementType>::resize(size_t size) {
   {
     ElementType *tmp = getDataPointer();
     if ( tmp != NULL )
-      delete [] tmp;
+      Allocator::deleteArray(tmp);
     setDataPointer(NULL,0, false);
   }
   if(externalStorage) {
@@ -194,11 +215,11 @@ void VectorT<ElementType>::resize(size_t size) {
   if(getDataPointer() != NULL) {
     size_t oldSize = dataSize;
     ElementType *tmp=getDataPointer();
-    setDataPointer(new ElementType[size], size, false);
+    setDataPointer(Allocator::newArray<ElementType>(size), size, false);
     ippsCopy(tmp, getDataPointer(), std::min(size, oldSize));
-    delete[] tmp;
+    Allocator::deleteArray(tmp);
   } else {
-    setDataPointer(new ElementType[size], size, false);
+    setDataPointer(Allocator::newArray<ElementType>(size), size, false);
   }
 }
 
@@ -246,7 +267,7 @@ void VectorT<ElementType>::clear(void) {
       _THROW_EVector("Cannot clear VectorT (external storage used)");
   }
   if (data != NULL) {
-    delete[] data;
+    Allocator::deleteArray(data);
     setDataPointer(NULL, 0, false);
   }
 }
@@ -529,6 +550,57 @@ VectorT<ElementType>::scalarProduct(
   return result;
 }
 
+template<class ElementType>
+inline void
+VectorT<ElementType>::axpy(const ElementType& alpha,
+                           const VectorT<ElementType>& x) {
+  if (size() != x.size())
+    _THROW_EVector("VectorT::axpy(): x.size() != size()");
+
+  ElementType *dst = getDataPointer();
+  const ElementType *src = x.getDataPointer();
+  const size_t n = dataSize;
+  for (size_t i = 0; i < n; i++)
+    dst[i] += alpha * src[i];
+}
+
+template<class ElementType>
+inline void
+VectorT<ElementType>::axpby(const ElementType& alpha,
+                            const VectorT<ElementType>& x,
+                            const ElementType& beta) {
+  if (size() != x.size())
+    _THROW_EVector("VectorT::axpby(): x.size() != size()");
+
+  ElementType *dst = getDataPointer();
+  const ElementType *src = x.getDataPointer();
+  const size_t n = dataSize;
+  for (size_t i = 0; i < n; i++)
+    dst[i] = alpha * src[i] + beta * dst[i];
+}
+
+template<class ElementType>
+inline ElementType
+VectorT<ElementType>::scalarProductAndSquaredNorm(
+                           const VectorT<ElementType>& v,
+                           ElementType& squaredNorm) const {
+  if (size() != v.size())
+    _THROW_EVector("VectorT::scalarProductAndSquaredNorm(): v.size() != size()");
+
+  const ElementType *a = getDataPointer();
+  const ElementType *b = v.getDataPointer();
+  const size_t n = dataSize;
+  ElementType dot = ElementType(0);
+  ElementType sq = ElementType(0);
+  for (size_t i = 0; i < n; i++)
+  {
+    dot += a[i] * b[i];
+    sq += a[i] * a[i];
+  }
+  squaredNorm = sq;
+  return dot;
+}
+
 template<class ElementType>
 inline ElementType VectorT<ElementType>::Median() const {
    VectorT<ElementType> sorted(*this);
@@ -712,7 +784,7 @@ template<typename ElementType>
 inline VectorT<ElementType>&
 VectorT<ElementType>::operator=(const VectorT<ElementType>& v) {
   if (dataSize == 0 && !externalStorage && getDataPointer() == NULL) {
-    setDataPointer(new ElementType[v.size()], v.size(), false);
+    setDataPointer(Allocator::newArray<ElementType>(v.size()), v.size(), false);
   } else if (this->dataSize != v.size()) {
     this->resize(v.size());
   }
@@ -727,6 +799,52 @@ VectorT<ElementType>::operator=(const ElementType& element) {
   return *this;
 }
 
+#ifdef NICE_HAS_RVALUE_REFERENCES
+template<typename ElementType>
+inline VectorT<ElementType>&
+VectorT<ElementType>::operator=(VectorT<ElementType>&& v) {
+  if (externalStorage || v.externalStorage) {
+    return operator=(static_cast<const VectorT<ElementType>&>(v));
+  }
+  if (this != &v) {
+    Allocator::deleteArray(data);
+    setDataPointer(v.data, v.dataSize, false);
+    v.setDataPointer(NULL, 0, false);
+  }
+  return *this;
+}
+#endif
+
+template<typename ElementType>
+template<class E>
+inline VectorT<ElementType>&
+VectorT<ElementType>::operator=(const VectorExpression<E>& e) {
+  const ElementType *begin = constData;
+  const ElementType *end = constData + dataSize;
+  if (e.conflicts(begin, end) || (dataSize != e.size() && e.reads(begin, end))) {
+    // the expression reads elements which would be overwritten or released
+    VectorT<ElementType> tmp(e);
+    return operator=(tmp);
+  }
+  if (dataSize != e.size()) {
+    if (dataSize == 0 && !externalStorage && getDataPointer() == NULL) {
+      setDataPointer(Allocator::newArray<ElementType>(e.size()), e.size(), false);
+    } else {
+      resize(e.size());
+    }
+  }
+  e.evaluateTo(getDataPointer());
+  return *this;
+}
+
+template<typename ElementType>
+inline void VectorT<ElementType>::swap(VectorT<ElementType>& v) {
+  std::swap(externalStorage, v.externalStorage);
+  std::swap(constData, v.constData);
+  std::swap(data, v.data);
+  std::swap(dataSize, v.dataSize);
+}
+
 template<typename ElementType>
 void VectorT<ElementType>::flip() {
   ippsFlip_I(getDataPointer(), this->dataSize);
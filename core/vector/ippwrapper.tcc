@@ -1,5 +1,6 @@
 #include <core/vector/ippwrapper.h>
 #include <core/basics/RoundToNearest.h>
+#include <core/vector/SimdKernels.h>
 #include <algorithm>
 #include <numeric>
 #include <cmath>
@@ -1625,7 +1626,10 @@ template<class P1, class P2>
 inline IppStatus ippsNorm_L1(const P1* pSrc, int len, P2* pNorm) {
  if(len==0)
      return ippStsSizeErr;
- *pNorm = std::accumulate(pSrc, pSrc + len, static_cast<P2>(0));
+ P2 sum = static_cast<P2>(0);
+ for (int i=0;i<len;i++)
+     sum += static_cast<P2>(pSrc[i] < P1(0) ? -pSrc[i] : pSrc[i]);
+ *pNorm = sum;
  return ippStsNoErr;
 }
 template<class P1, class P2>
@@ -1636,7 +1640,10 @@ template<class P>
 inline IppStatus ippsNorm_L1(const P* pSrc, int len, P* pNorm) {
  if(len==0)
      return ippStsSizeErr;
- *pNorm = std::accumulate(pSrc, pSrc + len, static_cast<P>(0));
+ P sum = static_cast<P>(0);
+ for (int i=0;i<len;i++)
+     sum += pSrc[i] < P(0) ? -pSrc[i] : pSrc[i];
+ *pNorm = sum;
  return ippStsNoErr;
 }
 template<class P1, class P2>
@@ -16169,4 +16176,128 @@ inline IppStatus ippmEigenValuesSym_ma_L(const Ipp64f** ppSrc, int srcRoiShift,
   return ippmEigenValuesSym_ma_64f_L(ppSrc,srcRoiShift,srcStride1,srcStride2,pBuffer,pDstValues,widthHeight,count);
 }
 
+
+#else // NICE_USELIB_IPP
+
+// Without IPP the float and double versions of the functions used by VectorT
+// and MatrixT run on the vectorized kernels of SimdKernels. These overloads
+// are preferred to the generic templates above.
+#define _DEFINE_IPPS_SIMD(_Type)                                                   \
+inline IppStatus ippsCopy( const _Type* pSrc, _Type* pDst, int len ) {              \
+  NICE::SimdKernels::copy(pSrc,pDst,len,sizeof(_Type));                            \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsSet( _Type val, _Type* pDst, int len ) {                       \
+  NICE::SimdKernels::set(val,pDst,len);                                            \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsZero( _Type* pDst, int len ) {                                 \
+  NICE::SimdKernels::set(static_cast<_Type>(0),pDst,len);                          \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsSum(const _Type* pSrc, int len, _Type* pSum) {                 \
+  *pSum = NICE::SimdKernels::sum(pSrc,len);                                        \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsSum(const _Type* pSrc, int len, _Type* pSum,                   \
+                         IppHintAlgorithm) {                                       \
+  return ippsSum(pSrc,len,pSum);                                                   \
+}                                                                                  \
+inline IppStatus ippsMean(const _Type* pSrc, int len, _Type* pMean) {               \
+  if(len<=0)                                                                       \
+    return ippStsSizeErr;                                                          \
+  *pMean = NICE::SimdKernels::sum(pSrc,len) / len;                                 \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsMean(const _Type* pSrc, int len, _Type* pMean,                 \
+                          IppHintAlgorithm) {                                      \
+  return ippsMean(pSrc,len,pMean);                                                 \
+}                                                                                  \
+inline IppStatus ippsMax(const _Type* pSrc, int len, _Type* pMax) {                 \
+  if(len<=0)                                                                       \
+    return ippStsSizeErr;                                                          \
+  *pMax = NICE::SimdKernels::maxValue(pSrc,len);                                   \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsMin(const _Type* pSrc, int len, _Type* pMin) {                 \
+  if(len<=0)                                                                       \
+    return ippStsSizeErr;                                                          \
+  *pMin = NICE::SimdKernels::minValue(pSrc,len);                                   \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsNorm_Inf(const _Type* pSrc, int len, _Type* pNorm) {           \
+  if(len<=0)                                                                       \
+    return ippStsSizeErr;                                                          \
+  *pNorm = NICE::SimdKernels::maxAbs(pSrc,len);                                    \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsNorm_L1(const _Type* pSrc, int len, _Type* pNorm) {            \
+  if(len<=0)                                                                       \
+    return ippStsSizeErr;                                                          \
+  *pNorm = NICE::SimdKernels::sumAbs(pSrc,len);                                    \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsNorm_L2(const _Type* pSrc, int len, _Type* pNorm) {            \
+  if(len<=0)                                                                       \
+    return ippStsSizeErr;                                                          \
+  *pNorm = static_cast<_Type>(::sqrt(NICE::SimdKernels::sumSquares(pSrc,len)));    \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsDotProd(const _Type* pSrc1, const _Type* pSrc2, int len,       \
+                             _Type* pDp) {                                         \
+  if(len<=0)                                                                       \
+    return ippStsSizeErr;                                                          \
+  *pDp = NICE::SimdKernels::dot(pSrc1,pSrc2,len);                                  \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsAbs(const _Type* pSrc, _Type* pDst, int len) {                 \
+  NICE::SimdKernels::abs(pSrc,pDst,len);                                           \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsAbs_I(_Type* pSrcDst, int len) {                               \
+  NICE::SimdKernels::abs(pSrcDst,pSrcDst,len);                                     \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsAddC_I(_Type val, _Type* pSrcDst, int len) {                   \
+  NICE::SimdKernels::addC(pSrcDst,val,pSrcDst,len);                                \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsSubC_I(_Type val, _Type* pSrcDst, int len) {                   \
+  NICE::SimdKernels::subC(pSrcDst,val,pSrcDst,len);                                \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsSubCRev_I(_Type val, _Type* pSrcDst, int len) {                \
+  NICE::SimdKernels::subCRev(pSrcDst,val,pSrcDst,len);                             \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsMulC_I(_Type val, _Type* pSrcDst, int len) {                   \
+  NICE::SimdKernels::mulC(pSrcDst,val,pSrcDst,len);                                \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsDivC_I(_Type val, _Type* pSrcDst, int len) {                   \
+  if(val==0)                                                                       \
+    return ippStsDivByZeroErr;                                                     \
+  NICE::SimdKernels::divC(pSrcDst,val,pSrcDst,len);                                \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsAdd_I(const _Type* pSrc, _Type* pSrcDst, int len) {            \
+  NICE::SimdKernels::add(pSrcDst,pSrc,pSrcDst,len);                                \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsSub_I(const _Type* pSrc, _Type* pSrcDst, int len) {            \
+  NICE::SimdKernels::sub(pSrcDst,pSrc,pSrcDst,len);                                \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsMul_I(const _Type* pSrc, _Type* pSrcDst, int len) {            \
+  NICE::SimdKernels::mul(pSrcDst,pSrc,pSrcDst,len);                                \
+  return ippStsNoErr;                                                              \
+}                                                                                  \
+inline IppStatus ippsDiv_I(const _Type* pSrc, _Type* pSrcDst, int len) {            \
+  NICE::SimdKernels::div(pSrcDst,pSrc,pSrcDst,len);                                \
+  return ippStsNoErr;                                                              \
+}
+
+_DEFINE_IPPS_SIMD(Ipp32f)
+_DEFINE_IPPS_SIMD(Ipp64f)
+
 #endif
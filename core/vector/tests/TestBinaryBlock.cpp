@@ -0,0 +1,209 @@
+/*
+ * NICE-Core - efficient algebra and computer vision methods
+ *  - libbasicvector - A simple vector library
+ * See file License for license information.
+ */
+
+#ifdef NICE_USELIB_CPPUNIT
+#include "TestBinaryBlock.h"
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <core/basics/cppunitex.h>
+#include <core/basics/ChunkedBinStream.h>
+#include "core/vector/VectorT.h"
+#include "core/vector/MatrixT.h"
+#include "core/vector/SparseVectorT.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TestBinaryBlock );
+
+using namespace NICE;
+using namespace std;
+
+namespace {
+
+/** binary streams in memory, counting the number of calls */
+class omembinstream : public obinstream {
+public:
+  string data;
+  int calls;
+  omembinstream() : calls(0) {}
+  virtual void write(char* d, unsigned int length) { data.append(d, length); calls++; }
+};
+
+class imembinstream : public ibinstream {
+public:
+  string data;
+  size_t position;
+  int calls;
+  imembinstream(const string & d) : data(d), position(0), calls(0) {}
+  virtual void read(char* d, unsigned int length) {
+    if ( position + length > data.size() )
+      fthrow ( Exception, "imembinstream: end of data" );
+    memcpy(d, data.data() + position, length);
+    position += length;
+    calls++;
+  }
+};
+
+}
+
+void TestBinaryBlock::testLegacyFormat()
+{
+  Vector v = Vector::UniformRandom ( 1000, -1.0, 1.0, 1 );
+  omembinstream os;
+  os << v;
+  // size and one block instead of 1000 single elements
+  CPPUNIT_ASSERT_EQUAL ( 2, os.calls );
+  CPPUNIT_ASSERT_EQUAL ( sizeof(unsigned int) + 1000*sizeof(double), os.data.size() );
+
+  imembinstream is ( os.data );
+  Vector w;
+  is >> w;
+  CPPUNIT_ASSERT ( v == w );
+
+  IntMatrix M ( 7, 5 );
+  for ( uint i = 0 ; i < M.rows() ; i++ )
+    for ( uint j = 0 ; j < M.cols() ; j++ )
+      M(i,j) = i*10 + j;
+  omembinstream osm;
+  osm << M;
+  imembinstream ism ( osm.data );
+  IntMatrix N;
+  ism >> N;
+  CPPUNIT_ASSERT ( M == N );
+}
+
+void TestBinaryBlock::testBlockFormat()
+{
+  Matrix M ( 13, 29 );
+  for ( uint i = 0 ; i < M.rows() ; i++ )
+    for ( uint j = 0 ; j < M.cols() ; j++ )
+      M(i,j) = i - 0.5*j;
+  FloatVector v ( 17 );
+  for ( uint i = 0 ; i < v.size() ; i++ )
+    v[i] = i * 0.25f;
+
+  omembinstream os;
+  writeBinaryBlock ( os, M );
+  writeBinaryBlock ( os, v, true );
+
+  imembinstream is ( os.data );
+  Matrix N;
+  FloatVector w;
+  readBinaryBlock ( is, N );
+  readBinaryBlock ( is, w );
+  CPPUNIT_ASSERT ( M == N );
+  CPPUNIT_ASSERT ( v == w );
+
+  // the element type is checked
+  imembinstream is2 ( os.data );
+  FloatMatrix F;
+  CPPUNIT_ASSERT_THROW ( readBinaryBlock ( is2, F ), Exception );
+}
+
+void TestBinaryBlock::testChecksumAndByteOrder()
+{
+  IntVector v ( 10 );
+  for ( uint i = 0 ; i < v.size() ; i++ )
+    v[i] = 1000 * i + 1;
+
+  omembinstream os;
+  writeBinaryBlock ( os, v, true );
+
+  // corrupt the last byte of the data
+  string corrupted = os.data;
+  corrupted[corrupted.size()-1] ^= 0x10;
+  imembinstream isCorrupted ( corrupted );
+  IntVector w;
+  CPPUNIT_ASSERT_THROW ( readBinaryBlock ( isCorrupted, w ), Exception );
+
+  // simulate a file of a machine with the other byte order
+  string swapped = os.data;
+  char *h = &(swapped[0]);
+  h[7] ^= BinaryBlockHeader::flagBigEndian;
+  swapByteOrder ( h + 8, 2, sizeof(unsigned long long) );
+  swapByteOrder ( h + 24, 2, sizeof(unsigned int) );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)32, (size_t)( swapped.size() - v.size()*sizeof(int) ) );
+  // the checksum is computed on the stored bytes
+  swapByteOrder ( h + 32, v.size(), sizeof(int) );
+  unsigned int crc = crc32Checksum ( h + 32, v.size()*sizeof(int) );
+  memcpy ( h + 24, &crc, sizeof(crc) );
+  swapByteOrder ( h + 24, 1, sizeof(unsigned int) );
+
+  imembinstream isSwapped ( swapped );
+  readBinaryBlock ( isSwapped, w );
+  CPPUNIT_ASSERT ( v == w );
+
+  // standard check value of CRC-32
+  CPPUNIT_ASSERT_EQUAL ( 0xCBF43926u, crc32Checksum ( "123456789", 9 ) );
+}
+
+void TestBinaryBlock::testSparseVector()
+{
+  SparseVector v;
+  v[3] = 0.5;
+  v[17] = -2.0;
+  v[400] = 1e-3;
+  v.setDim ( 1000 );
+
+  omembinstream os;
+  writeBinaryBlock ( os, v, true );
+  imembinstream is ( os.data );
+  SparseVector w;
+  readBinaryBlock ( is, w );
+  CPPUNIT_ASSERT ( v == w );
+  CPPUNIT_ASSERT_EQUAL ( v.getDim(), w.getDim() );
+
+  stringstream ss;
+  v.store ( ss, SparseVector::FORMAT_BINARY );
+  SparseVector u;
+  u.restore ( ss, SparseVector::FORMAT_BINARY );
+  CPPUNIT_ASSERT ( v == u );
+  CPPUNIT_ASSERT_EQUAL ( v.getDim(), u.getDim() );
+
+  // restoring into a non-empty vector does not keep stale entries
+  stringstream ss2;
+  v.store ( ss2, SparseVector::FORMAT_BINARY );
+  u[v.begin()->first] = -1.0;
+  u[v.getDim() + 5] = 3.0;
+  u.restore ( ss2, SparseVector::FORMAT_BINARY );
+  CPPUNIT_ASSERT ( v == u );
+  CPPUNIT_ASSERT_EQUAL ( v.size(), u.size() );
+}
+
+void TestBinaryBlock::testChunkedStream()
+{
+  Vector v = Vector::UniformRandom ( 10000, 0.0, 1.0, 2 );
+  Matrix M ( 10, 10, 3.0 );
+  string filename = "TestBinaryBlock.chk";
+  {
+    // small chunks, such that blocks span several chunks
+    ochunkedbinstream os ( filename.c_str(), 4096 );
+    os << 42;
+    writeBinaryBlock ( os, v, true );
+    os << M;
+    os << std::string ( "end" );
+    os.close();
+  }
+
+  ichunkedbinstream is ( filename.c_str() );
+  int i;
+  Vector w;
+  Matrix N;
+  std::string tag;
+  is >> i;
+  readBinaryBlock ( is, w );
+  is >> N;
+  is >> tag;
+  CPPUNIT_ASSERT_EQUAL ( 42, i );
+  CPPUNIT_ASSERT ( v == w );
+  CPPUNIT_ASSERT ( M == N );
+  CPPUNIT_ASSERT_EQUAL ( std::string ( "end" ), tag );
+  CPPUNIT_ASSERT_THROW ( is >> i, Exception );
+  is.close();
+  remove ( filename.c_str() );
+}
+
+#endif
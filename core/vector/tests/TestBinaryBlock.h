@@ -0,0 +1,32 @@
+#ifndef _TESTBINARYBLOCK_H
+#define _TESTBINARYBLOCK_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * CppUnit-Testcase. 
+ */
+class TestBinaryBlock : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE( TestBinaryBlock );
+  CPPUNIT_TEST( testLegacyFormat );
+  CPPUNIT_TEST( testBlockFormat );
+  CPPUNIT_TEST( testChecksumAndByteOrder );
+  CPPUNIT_TEST( testSparseVector );
+  CPPUNIT_TEST( testChunkedStream );
+  CPPUNIT_TEST_SUITE_END();
+  
+private:
+ 
+public:
+  void setUp() {};
+  void tearDown() {};
+
+  void testLegacyFormat();
+  void testBlockFormat();
+  void testChecksumAndByteOrder();
+  void testSparseVector();
+  void testChunkedStream();
+
+};
+
+#endif // _TESTBINARYBLOCK_H
@@ -500,6 +500,29 @@ void TestEMatrix::testEigenValues() {
     CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(0.0, 1.0-det(I), 2E-15);
   }
 #endif
+  {
+    // A * v_k = lambda_k * v_k, orthonormal eigenvectors, decreasing eigenvalues
+    double array[]= {292,101,295,101,48,122,295,122,384};
+    MatrixT<double> c(array,3,3);
+    eigenvectorvalues(c,evecs,evals);
+    CPPUNIT_ASSERT(evals(0) >= evals(1) && evals(1) >= evals(2));
+    for(int k=0;k<3;k++) {
+      VectorT<double> v(3), cv(3);
+      for(int i=0;i<3;i++)
+        v(i) = evecs(i,k);
+      cv.multiply(c,v);
+      for(int i=0;i<3;i++)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(evals(k)*v(i), cv(i), 1E-10);
+    }
+    I.multiply(evecs,evecs,true,false);
+    for(int i=0;i<3;i++)
+      for(int j=0;j<3;j++)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(i==j ? 1.0 : 0.0, I(i,j), 1E-14);
+    VectorT<double> values(3);
+    eigenvalues(c,&values);
+    for(int i=0;i<3;i++)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_NOT_NAN(evals(i), values(i), 1E-10);
+  }
 #ifdef NICE_USELIB_LINAL
   {
     double array[]= {292,101,295,101,48,122,295,122,384};
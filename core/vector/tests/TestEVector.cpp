@@ -256,6 +256,21 @@ void TestEVector::testScalarProduct() {
   CPPUNIT_ASSERT_DOUBLES_EQUAL(4.5 * 7.3 * 10.0, v.scalarProduct(w), 1e-6);
 }
 
+void TestEVector::testAxpy() {
+  VectorT<double> v(10, 2.0);
+  VectorT<double> w(10, 3.0);
+  v.axpy(0.5, w);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(3.5, v[9], 1e-12);
+  v.axpby(2.0, w, -1.0);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(2.5, v[0], 1e-12);
+  w[3] = 1.0;
+  double squaredNorm = 0.0;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(2.5 * 28.0, v.scalarProductAndSquaredNorm(w, squaredNorm), 1e-12);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(10 * 2.5 * 2.5, squaredNorm, 1e-12);
+  VectorT<double> u(5, 1.0);
+  CPPUNIT_ASSERT_THROW(v.axpy(1.0, u), std::exception);
+}
+
 void TestEVector::testEqual() {
   VectorT<double> v(10, 4.5);
   VectorT<double> w(10, 4.5);
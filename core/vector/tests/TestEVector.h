@@ -24,6 +24,7 @@ class TestEVector : public CppUnit::TestFixture {
   CPPUNIT_TEST( testIO );
   CPPUNIT_TEST( testRangeChecks );
   CPPUNIT_TEST( testScalarProduct );
+  CPPUNIT_TEST( testAxpy );
   CPPUNIT_TEST( testEqual );
   CPPUNIT_TEST( testStatistics );
   CPPUNIT_TEST( testDistance );
@@ -95,6 +96,11 @@ public:
    */  
   void testScalarProduct();
 
+  /**
+   * Test the in-place updates axpy, axpby and scalarProductAndSquaredNorm.
+   */  
+  void testAxpy();
+
   /**
    * Test == and != operators 
    */  
@@ -0,0 +1,236 @@
+/*
+ * NICE-Core - efficient algebra and computer vision methods
+ *  - libbasicvector - A simple vector library
+ * See file License for license information.
+ */
+
+#ifdef NICE_USELIB_CPPUNIT
+#include "TestExpression.h"
+#include <core/basics/cppunitex.h>
+#include "core/vector/VectorT.h"
+#include "core/vector/MatrixT.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TestExpression );
+
+using namespace NICE;
+using namespace std;
+
+void TestExpression::setUp() {
+}
+
+void TestExpression::tearDown() {
+}
+
+void TestExpression::testVectorExpression() {
+  Vector a(4), b(4), c(4);
+  for (int i = 0; i < 4; i++) {
+    a[i] = i;
+    b[i] = 2 * i + 1;
+    c[i] = -i;
+  }
+
+  Vector r = lazy(a) + lazy(b) * 2.0 - lazy(c) / 2.0;
+  CPPUNIT_ASSERT_EQUAL(4, (int)r.size());
+  for (int i = 0; i < 4; i++)
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(a[i] + 2.0 * b[i] - 0.5 * c[i], r[i], 1e-12);
+
+  // existing vectors are resized
+  Vector s(1);
+  s = -(lazy(a) - b);
+  CPPUNIT_ASSERT_EQUAL(4, (int)s.size());
+  for (int i = 0; i < 4; i++)
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(b[i] - a[i], s[i], 1e-12);
+
+  // the eager operators are unchanged
+  Vector e = a + b;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, e[1], 1e-12);
+
+  Vector wrong(3);
+  CPPUNIT_ASSERT_THROW(r = lazy(a) + wrong, Exception);
+}
+
+void TestExpression::testVectorAliasing() {
+  Vector a(5), b(5);
+  for (int i = 0; i < 5; i++) {
+    a[i] = i;
+    b[i] = 1.0;
+  }
+
+  // elementwise reading of the destination is fine
+  a = lazy(a) * 2.0 + b;
+  for (int i = 0; i < 5; i++)
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0 * i + 1.0, a[i], 1e-12);
+
+  // the destination overlaps a shifted view of itself
+  Vector big(6);
+  for (int i = 0; i < 6; i++)
+    big[i] = i;
+  Vector front(big.getDataPointer(), 5, VectorBase::external);
+  Vector back(big.getDataPointer() + 1, 5, VectorBase::external);
+  front = lazy(back) + back;
+  for (int i = 0; i < 5; i++)
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0 * (i + 1), big[i], 1e-12);
+}
+
+void TestExpression::testMatrixExpression() {
+  Matrix a(2, 3), b(2, 3);
+  for (int i = 0; i < 2; i++)
+    for (int j = 0; j < 3; j++) {
+      a(i, j) = i + 10 * j;
+      b(i, j) = i * j;
+    }
+
+  Matrix r = 2.0 * lazy(a) - b + a;
+  CPPUNIT_ASSERT_EQUAL(2, (int)r.rows());
+  CPPUNIT_ASSERT_EQUAL(3, (int)r.cols());
+  for (int i = 0; i < 2; i++)
+    for (int j = 0; j < 3; j++)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0 * a(i, j) - b(i, j), r(i, j), 1e-12);
+
+  Matrix wrong(3, 2);
+  CPPUNIT_ASSERT_THROW(r = lazy(a) + wrong, Exception);
+}
+
+void TestExpression::testTransposed() {
+  Matrix a(2, 3), b(3, 2);
+  for (int i = 0; i < 2; i++)
+    for (int j = 0; j < 3; j++) {
+      a(i, j) = i + 10 * j;
+      b(j, i) = 1 + i - j;
+    }
+
+  Matrix t = transposed(a) + b;
+  CPPUNIT_ASSERT_EQUAL(3, (int)t.rows());
+  for (int i = 0; i < 2; i++)
+    for (int j = 0; j < 3; j++)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(a(i, j) + b(j, i), t(j, i), 1e-12);
+
+  // transposing a square matrix into itself
+  Matrix s(3, 3);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      s(i, j) = 3 * i + j;
+  s = transposed(s);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0 * j + i, s(i, j), 1e-12);
+
+  // products
+  Vector x(2);
+  x[0] = 1.0;
+  x[1] = -2.0;
+  Vector y = transposed(a) * x;
+  CPPUNIT_ASSERT_EQUAL(3, (int)y.size());
+  for (int j = 0; j < 3; j++)
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(a(0, j) - 2.0 * a(1, j), y[j], 1e-12);
+
+  Matrix p = transposed(a) * a;
+  Matrix q = a * transposed(a);
+  Matrix pp = transposed(b) * transposed(a);
+  CPPUNIT_ASSERT_EQUAL(3, (int)p.rows());
+  CPPUNIT_ASSERT_EQUAL(2, (int)q.rows());
+  CPPUNIT_ASSERT_EQUAL(2, (int)pp.rows());
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) {
+      double sum = 0.0;
+      for (int k = 0; k < 2; k++)
+        sum += a(k, i) * a(k, j);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(sum, p(i, j), 1e-12);
+    }
+  Matrix ab = a * b;
+  for (int i = 0; i < 2; i++)
+    for (int j = 0; j < 2; j++)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(ab(j, i), pp(i, j), 1e-12);
+}
+
+void TestExpression::testSwap() {
+  Vector a(3, 1.0), b(5, 2.0);
+  const double *pa = a.getDataPointer();
+  a.swap(b);
+  CPPUNIT_ASSERT_EQUAL(5, (int)a.size());
+  CPPUNIT_ASSERT_EQUAL(3, (int)b.size());
+  CPPUNIT_ASSERT(pa == b.getDataPointer());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, a[4], 1e-12);
+
+  Matrix m(2, 2, 1.0), n(3, 4, 2.0);
+  swap(m, n);
+  CPPUNIT_ASSERT_EQUAL(3, (int)m.rows());
+  CPPUNIT_ASSERT_EQUAL(2, (int)n.cols());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, m(2, 3), 1e-12);
+}
+
+void TestExpression::testMove() {
+#ifdef NICE_HAS_RVALUE_REFERENCES
+  Vector a(100, 1.0);
+  const double *pa = a.getDataPointer();
+  Vector b(std::move(a));
+  CPPUNIT_ASSERT(pa == b.getDataPointer());
+  CPPUNIT_ASSERT_EQUAL(0, (int)a.size());
+
+  Vector c;
+  c = std::move(b);
+  CPPUNIT_ASSERT(pa == c.getDataPointer());
+  CPPUNIT_ASSERT_EQUAL(100, (int)c.size());
+
+  // external storage is copied, not stolen
+  Vector view(c.getDataPointer(), 10, VectorBase::external);
+  Vector owned(std::move(view));
+  CPPUNIT_ASSERT(owned.getDataPointer() != c.getDataPointer());
+  owned[0] = 5.0;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, c[0], 1e-12);
+
+  Matrix m(10, 10, 3.0);
+  const double *pm = m.getDataPointer();
+  Matrix n(std::move(m));
+  CPPUNIT_ASSERT(pm == n.getDataPointer());
+  CPPUNIT_ASSERT_EQUAL(0, (int)m.rows());
+
+  // temporaries of chained operators are reused
+  Vector x(4, 1.0), y(4, 2.0), z(4, 3.0);
+  Vector sum = x + y + z;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, sum[3], 1e-12);
+#endif
+}
+
+void TestExpression::testTemporaryViews() {
+  Matrix m(4, 3, 1.0);
+  Vector v(6, 2.0);
+  Vector one(4, 1.0);
+  Vector two(3, 2.0);
+
+  Vector r = m.getColumnRef(1) + one;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, r[0], 1e-12);
+  r = m.getColumnRef(1) - one;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, r[0], 1e-12);
+  r = m.getColumnRef(1) * 3.0;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, r[3], 1e-12);
+  r = 3.0 * m.getColumnRef(1);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, r[3], 1e-12);
+  CPPUNIT_ASSERT(r.getDataPointer() != m.getColumnRef(1).getDataPointer());
+  CPPUNIT_ASSERT(m == Matrix(4, 3, 1.0));
+
+  r = v.getRangeRef(1, 3) + two;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, r[0], 1e-12);
+  r = v.getRangeRef(1, 3) - two;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, r[1], 1e-12);
+  r = v.getRangeRef(1, 3) * 0.5;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, r[2], 1e-12);
+  r = 0.5 * v.getRangeRef(1, 3);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, r[2], 1e-12);
+  CPPUNIT_ASSERT(v == Vector(6, 2.0));
+
+  // matrices with external storage
+  Matrix n(2, 2, 1.0);
+  Matrix ones(2, 2, 1.0);
+  Matrix s = Matrix(n.getDataPointer(), 2, 2, MatrixBase::external) + ones;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, s(1, 1), 1e-12);
+  s = Matrix(n.getDataPointer(), 2, 2, MatrixBase::external) - ones;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, s(1, 1), 1e-12);
+  s = Matrix(n.getDataPointer(), 2, 2, MatrixBase::external) * 4.0;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, s(0, 1), 1e-12);
+  s = 4.0 * Matrix(n.getDataPointer(), 2, 2, MatrixBase::external);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, s(0, 1), 1e-12);
+  CPPUNIT_ASSERT(n == ones);
+}
+
+#endif // NICE_USELIB_CPPUNIT
@@ -0,0 +1,68 @@
+/*
+ * NICE-Core - efficient algebra and computer vision methods
+ *  - libbasicvector - A simple vector library
+ * See file License for license information.
+ */
+#ifndef _TESTEXPRESSION_H
+#define _TESTEXPRESSION_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * CppUnit-Testcase.
+ * Tests for the lazy expressions, swap and move semantics of VectorT and MatrixT
+ */
+class TestExpression : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE( TestExpression );
+  CPPUNIT_TEST( testVectorExpression );
+  CPPUNIT_TEST( testVectorAliasing );
+  CPPUNIT_TEST( testMatrixExpression );
+  CPPUNIT_TEST( testTransposed );
+  CPPUNIT_TEST( testSwap );
+  CPPUNIT_TEST( testMove );
+  CPPUNIT_TEST( testTemporaryViews );
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+public:
+  void setUp();
+  void tearDown();
+
+  /**
+   * Test evaluation of lazy vector expressions.
+   */
+  void testVectorExpression();
+
+  /**
+   * Test assignment of expressions which read their destination.
+   */
+  void testVectorAliasing();
+
+  /**
+   * Test evaluation of lazy matrix expressions.
+   */
+  void testMatrixExpression();
+
+  /**
+   * Test transposed() and the products with transposed matrices.
+   */
+  void testTransposed();
+
+  /**
+   * Test swap of vectors and matrices.
+   */
+  void testSwap();
+
+  /**
+   * Test move construction and move assignment.
+   */
+  void testMove();
+
+  /**
+   * Test that operators on temporary views do not modify the viewed data.
+   */
+  void testTemporaryViews();
+};
+
+#endif // _TESTEXPRESSION_H
@@ -0,0 +1,168 @@
+/*
+ * NICE-Core - efficient algebra and computer vision methods
+ *  - libbasicvector - A simple vector library
+ * See file License for license information.
+ */
+
+#ifdef NICE_USELIB_CPPUNIT
+#include "TestFeatureMatrix.h"
+#include <string>
+#include <cstdio>
+#include <sstream>
+#include <core/basics/cppunitex.h>
+#include "core/vector/FeatureMatrix.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TestFeatureMatrix );
+
+using namespace NICE;
+using namespace std;
+
+void TestFeatureMatrix::testAppendAndViews()
+{
+  FeatureMatrix fm;
+  CPPUNIT_ASSERT ( fm.empty() );
+
+  for ( int i = 0 ; i < 100 ; i++ )
+  {
+    Vector v ( 3 );
+    v[0] = i; v[1] = 2*i; v[2] = -i;
+    fm.appendRow ( v );
+  }
+  CPPUNIT_ASSERT_EQUAL ( (size_t)100, fm.rows() );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)3, fm.dimension() );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 84.0, fm(42, 1), 1e-12 );
+
+  // rows are views on the data
+  Vector row = fm.getRow ( 42 );
+  row[2] = 7.0;
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 7.0, fm(42, 2), 1e-12 );
+
+  // the transposed matrix view shares the memory
+  Matrix M = fm.getTransposedMatrixView();
+  CPPUNIT_ASSERT_EQUAL ( 3u, M.rows() );
+  CPPUNIT_ASSERT_EQUAL ( 100u, M.cols() );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 7.0, M(2, 42), 1e-12 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 10.0, M(1, 5), 1e-12 );
+
+  fm.append ( fm );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)200, fm.rows() );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 7.0, fm(142, 2), 1e-12 );
+
+  Vector wrongSize ( 4 );
+  CPPUNIT_ASSERT_THROW ( fm.appendRow ( wrongSize ), Exception );
+
+  // appending another matrix
+  FeatureMatrix other;
+  other.append ( fm );
+  other.append ( fm );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)400, other.rows() );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)3, other.dimension() );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 7.0, other(342, 2), 1e-12 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 10.0, other(205, 1), 1e-12 );
+  CPPUNIT_ASSERT_THROW ( other.append ( FeatureMatrix ( 2, 4 ) ), Exception );
+
+  // appending a row of the matrix itself, which moves with the reallocation
+  FeatureMatrix full ( 16, 3 );
+  for ( size_t i = 0 ; i < full.rows() ; i++ )
+    full(i, 1) = i;
+  full.appendRow ( full.getRow ( 5 ) );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)17, full.rows() );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 5.0, full(16, 1), 0.0 );
+
+  // a matrix without rows but with a dimension keeps its dimension
+  FeatureMatrix sized ( 0, 3 );
+  CPPUNIT_ASSERT_THROW ( sized.appendRow ( wrongSize ), Exception );
+  sized.appendRow ( fm.getRow ( 42 ) );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)3, sized.dimension() );
+
+  // a cleared matrix takes the dimension of the next vector
+  sized.clear();
+  sized.appendRow ( wrongSize );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)4, sized.dimension() );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)1, sized.rows() );
+}
+
+void TestFeatureMatrix::testConversion()
+{
+  VVector vv;
+  for ( int i = 0 ; i < 10 ; i++ )
+    vv.push_back ( Vector::UniformRandom ( 5, 0.0, 1.0, i ) );
+
+  FeatureMatrix fm ( vv );
+  VVector back;
+  fm.toVVector ( back );
+  CPPUNIT_ASSERT_EQUAL ( vv.size(), back.size() );
+  for ( size_t i = 0 ; i < vv.size() ; i++ )
+    CPPUNIT_ASSERT ( vv[i] == back[i] );
+
+  Matrix A, B;
+  vv.toMatrix ( A );
+  fm.toMatrix ( B );
+  CPPUNIT_ASSERT ( A == B );
+
+  FeatureMatrix fm2 ( A );
+  fm2.toMatrix ( B, false );
+  CPPUNIT_ASSERT ( A.transpose() == B );
+}
+
+void TestFeatureMatrix::testBinaryIO()
+{
+  FeatureMatrix fm ( 37, 11 );
+  for ( size_t i = 0 ; i < fm.rows() ; i++ )
+    for ( size_t k = 0 ; k < fm.dimension() ; k++ )
+      fm(i, k) = i * 0.5 - k;
+
+  // small chunks to test the chunked reading and writing
+  string filename = "TestFeatureMatrix.bin";
+  fm.writeBinary ( filename, 100 );
+
+  FeatureMatrix fmRead;
+  fmRead.readBinary ( filename, 128 );
+  CPPUNIT_ASSERT_EQUAL ( fm.rows(), fmRead.rows() );
+  CPPUNIT_ASSERT_EQUAL ( fm.dimension(), fmRead.dimension() );
+  for ( size_t i = 0 ; i < fm.rows() ; i++ )
+    for ( size_t k = 0 ; k < fm.dimension() ; k++ )
+      CPPUNIT_ASSERT_DOUBLES_EQUAL ( fm(i, k), fmRead(i, k), 0.0 );
+
+  FeatureMatrix fmMapped;
+  fmMapped.mapBinary ( filename );
+  CPPUNIT_ASSERT_EQUAL ( fm.rows(), fmMapped.rows() );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( fm(36, 10), fmMapped(36, 10), 0.0 );
+
+  // appending copies the mapping into memory
+  fmMapped.appendRow ( fm.getRow ( 0 ) );
+  CPPUNIT_ASSERT ( ! fmMapped.isMapped() );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)38, fmMapped.rows() );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( fm(36, 10), fmMapped(36, 10), 0.0 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( fm(0, 3), fmMapped(37, 3), 0.0 );
+
+  // a row of the mapping itself is appended after the mapping was copied
+  FeatureMatrix fmMappedSelf;
+  fmMappedSelf.mapBinary ( filename );
+  fmMappedSelf.appendRow ( fmMappedSelf.getRow ( 5 ) );
+  CPPUNIT_ASSERT ( ! fmMappedSelf.isMapped() );
+  CPPUNIT_ASSERT_EQUAL ( (size_t)38, fmMappedSelf.rows() );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( fm(5, 7), fmMappedSelf(37, 7), 0.0 );
+  remove ( filename.c_str() );
+
+  // Persistent interface
+  stringstream ss;
+  fm.store ( ss );
+  FeatureMatrix fmStream;
+  fmStream.restore ( ss );
+  CPPUNIT_ASSERT_EQUAL ( fm.rows(), fmStream.rows() );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( fm(20, 7), fmStream(20, 7), 0.0 );
+
+  // binary double format of VVector
+  VVector vv;
+  fm.toVVector ( vv );
+  stringstream ssv;
+  vv.store ( ssv, VVector::FILEFORMAT_BINARY_DOUBLE );
+  VVector vvRead;
+  vvRead.setBufSize ( fm.dimension() );
+  vvRead.restore ( ssv, VVector::FILEFORMAT_BINARY_DOUBLE );
+  CPPUNIT_ASSERT_EQUAL ( vv.size(), vvRead.size() );
+  CPPUNIT_ASSERT ( vv[36] == vvRead[36] );
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef _TESTFEATUREMATRIX_H
+#define _TESTFEATUREMATRIX_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * CppUnit-Testcase. 
+ */
+class TestFeatureMatrix : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE( TestFeatureMatrix );
+  CPPUNIT_TEST( testAppendAndViews );
+  CPPUNIT_TEST( testConversion );
+  CPPUNIT_TEST( testBinaryIO );
+  CPPUNIT_TEST_SUITE_END();
+  
+private:
+ 
+public:
+  void setUp() {};
+  void tearDown() {};
+
+  void testAppendAndViews();
+  void testConversion();
+  void testBinaryIO();
+
+};
+
+#endif // _TESTFEATUREMATRIX_H
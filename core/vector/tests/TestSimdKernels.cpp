@@ -0,0 +1,250 @@
+/*
+ * NICE-Core - efficient algebra and computer vision methods
+ *  - libbasicvector - A simple vector library
+ * See file License for license information.
+ */
+
+#ifdef NICE_USELIB_CPPUNIT
+#include "TestSimdKernels.h"
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <core/basics/cppunitex.h>
+#include "core/vector/SimdKernels.h"
+#include "core/vector/VectorT.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TestSimdKernels );
+
+using namespace NICE;
+using namespace std;
+
+namespace {
+
+// sizes around the register widths and unaligned starts
+const int sizes[] = { 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1023 };
+const int numSizes = sizeof ( sizes ) / sizeof ( sizes[0] );
+const int maxSize = 1024 + 3;
+
+template<class T>
+void randomArray ( vector<T> & v, int n )
+{
+  v.resize ( n );
+  for ( int i = 0; i < n; i++ )
+    v[i] = static_cast<T> ( ( rand() % 20001 - 10000 ) / 1000.0 );
+}
+
+template<class T>
+void checkReductions ( double tolerance )
+{
+  vector<T> a, b;
+  randomArray ( a, maxSize );
+  randomArray ( b, maxSize );
+  for ( int s = 0; s < numSizes; s++ )
+    for ( int offset = 0; offset < 3; offset++ )
+    {
+      const T *pa = &a[offset];
+      const T *pb = &b[offset];
+      const int n = sizes[s];
+
+      SimdKernels::setInstructionSet ( SimdKernels::SCALAR );
+      T sum = SimdKernels::sum ( pa, n );
+      T sumAbs = SimdKernels::sumAbs ( pa, n );
+      T sumSquares = SimdKernels::sumSquares ( pa, n );
+      T dot = SimdKernels::dot ( pa, pb, n );
+      T minValue = SimdKernels::minValue ( pa, n );
+      T maxValue = SimdKernels::maxValue ( pa, n );
+      T maxAbs = SimdKernels::maxAbs ( pa, n );
+
+      for ( int set = SimdKernels::SSE2; set <= SimdKernels::getSupportedInstructionSet(); set++ )
+      {
+        SimdKernels::setInstructionSet ( ( SimdKernels::InstructionSet ) set );
+        const double scale = tolerance * n * 10.0;
+        CPPUNIT_ASSERT_DOUBLES_EQUAL ( sum, SimdKernels::sum ( pa, n ), scale );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL ( sumAbs, SimdKernels::sumAbs ( pa, n ), scale );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL ( sumSquares, SimdKernels::sumSquares ( pa, n ), scale * 10.0 );
+        CPPUNIT_ASSERT_DOUBLES_EQUAL ( dot, SimdKernels::dot ( pa, pb, n ), scale * 10.0 );
+        CPPUNIT_ASSERT_EQUAL ( minValue, SimdKernels::minValue ( pa, n ) );
+        CPPUNIT_ASSERT_EQUAL ( maxValue, SimdKernels::maxValue ( pa, n ) );
+        CPPUNIT_ASSERT_EQUAL ( maxAbs, SimdKernels::maxAbs ( pa, n ) );
+      }
+    }
+  SimdKernels::setInstructionSet ( SimdKernels::AVX512 );
+}
+
+template<class T>
+void checkElementwise ()
+{
+  vector<T> a, b;
+  randomArray ( a, maxSize );
+  randomArray ( b, maxSize );
+  for ( int i = 0; i < maxSize; i++ )
+    if ( b[i] == T ( 0 ) )
+      b[i] = T ( 1 );
+  const T c = T ( 1.5 );
+
+  for ( int s = 0; s < numSizes; s++ )
+    for ( int offset = 0; offset < 3; offset++ )
+    {
+      const T *pa = &a[offset];
+      const T *pb = &b[offset];
+      const int n = sizes[s];
+      const int ops = 13;
+
+      vector< vector<T> > expected ( ops, vector<T> ( n ) );
+      for ( int set = SimdKernels::SCALAR; set <= SimdKernels::getSupportedInstructionSet(); set++ )
+      {
+        SimdKernels::setInstructionSet ( ( SimdKernels::InstructionSet ) set );
+        vector< vector<T> > r ( ops, vector<T> ( n + 1, T ( 42 ) ) );
+        SimdKernels::add ( pa, pb, &r[0][0], n );
+        SimdKernels::sub ( pa, pb, &r[1][0], n );
+        SimdKernels::mul ( pa, pb, &r[2][0], n );
+        SimdKernels::div ( pa, pb, &r[3][0], n );
+        SimdKernels::addC ( pa, c, &r[4][0], n );
+        SimdKernels::subC ( pa, c, &r[5][0], n );
+        SimdKernels::subCRev ( pa, c, &r[6][0], n );
+        SimdKernels::mulC ( pa, c, &r[7][0], n );
+        SimdKernels::divC ( pa, c, &r[8][0], n );
+        SimdKernels::abs ( pa, &r[9][0], n );
+        SimdKernels::set ( c, &r[10][0], n );
+        // in-place operation
+        for ( int i = 0; i < n; i++ )
+          r[11][i] = pa[i];
+        SimdKernels::sub ( &r[11][0], pb, &r[11][0], n );
+        for ( int i = 0; i < n; i++ )
+          r[12][i] = pb[i];
+        SimdKernels::addProductC ( pa, c, &r[12][0], n );
+
+        for ( int k = 0; k < ops; k++ )
+        {
+          // nothing is written behind the end
+          CPPUNIT_ASSERT_EQUAL ( T ( 42 ), r[k][n] );
+          for ( int i = 0; i < n; i++ )
+          {
+            if ( set == SimdKernels::SCALAR )
+              expected[k][i] = r[k][i];
+            else
+              CPPUNIT_ASSERT_EQUAL ( expected[k][i], r[k][i] );
+          }
+        }
+      }
+      for ( int i = 0; i < n; i++ )
+      {
+        CPPUNIT_ASSERT_EQUAL ( T ( pa[i] + pb[i] ), expected[0][i] );
+        CPPUNIT_ASSERT_EQUAL ( T ( c - pa[i] ), expected[6][i] );
+        CPPUNIT_ASSERT_EQUAL ( expected[1][i], expected[11][i] );
+        CPPUNIT_ASSERT_EQUAL ( T ( pb[i] + T ( pa[i] * c ) ), expected[12][i] );
+      }
+    }
+  SimdKernels::setInstructionSet ( SimdKernels::AVX512 );
+}
+
+} // namespace
+
+void TestSimdKernels::setUp() {
+}
+
+void TestSimdKernels::tearDown() {
+  SimdKernels::setInstructionSet ( SimdKernels::AVX512 );
+}
+
+void TestSimdKernels::testDispatch() {
+  SimdKernels::InstructionSet supported = SimdKernels::getSupportedInstructionSet();
+  CPPUNIT_ASSERT_EQUAL ( ( int ) SimdKernels::SCALAR,
+                         ( int ) SimdKernels::setInstructionSet ( SimdKernels::SCALAR ) );
+  CPPUNIT_ASSERT_EQUAL ( ( int ) SimdKernels::SCALAR, ( int ) SimdKernels::getInstructionSet() );
+  CPPUNIT_ASSERT_EQUAL ( ( int ) supported,
+                         ( int ) SimdKernels::setInstructionSet ( SimdKernels::AVX512 ) );
+  CPPUNIT_ASSERT_EQUAL ( string ( "avx2" ), string ( SimdKernels::getName ( SimdKernels::AVX2 ) ) );
+}
+
+void TestSimdKernels::testReductions() {
+  checkReductions<float> ( 1e-5 );
+  checkReductions<double> ( 1e-12 );
+}
+
+void TestSimdKernels::testElementwise() {
+  checkElementwise<float>();
+  checkElementwise<double>();
+}
+
+void TestSimdKernels::testConversions() {
+  vector<unsigned char> bytes ( maxSize );
+  vector<float> floats ( maxSize );
+  for ( int i = 0; i < maxSize; i++ )
+  {
+    bytes[i] = static_cast<unsigned char> ( i * 7 );
+    // values outside of [0,255], halves and values close to halves
+    floats[i] = ( i % 600 ) * 0.5f - 20.0f + ( i % 3 == 0 ? 1e-3f : 0.0f );
+  }
+
+  for ( int s = 0; s < numSizes; s++ )
+  {
+    const int n = sizes[s];
+    vector<float> expectedFloats;
+    vector<unsigned char> expectedTruncated, expectedRounded;
+    for ( int set = SimdKernels::SCALAR; set <= SimdKernels::getSupportedInstructionSet(); set++ )
+    {
+      SimdKernels::setInstructionSet ( ( SimdKernels::InstructionSet ) set );
+      vector<float> f ( n );
+      vector<unsigned char> truncated ( n ), rounded ( n );
+      SimdKernels::convert ( &bytes[1], &f[0], n );
+      SimdKernels::convert ( &floats[1], &truncated[0], n, false );
+      SimdKernels::convert ( &floats[1], &rounded[0], n, true );
+      if ( set == SimdKernels::SCALAR )
+      {
+        expectedFloats = f;
+        expectedTruncated = truncated;
+        expectedRounded = rounded;
+        for ( int i = 0; i < n; i++ )
+        {
+          CPPUNIT_ASSERT_EQUAL ( ( float ) bytes[i + 1], f[i] );
+          const float x = floats[i + 1];
+          const int r = x < 0.0f ? 0 : ( x > 255.0f ? 255 : ( int ) floor ( x + 0.5f ) );
+          CPPUNIT_ASSERT_EQUAL ( r, ( int ) rounded[i] );
+        }
+      } else {
+        CPPUNIT_ASSERT ( expectedFloats == f );
+        CPPUNIT_ASSERT ( expectedTruncated == truncated );
+        CPPUNIT_ASSERT ( expectedRounded == rounded );
+      }
+    }
+  }
+}
+
+void TestSimdKernels::testVectorFunctions() {
+  VectorT<double> v ( 37 );
+  VectorT<float> w ( 37 );
+  double sum = 0.0, sumAbs = 0.0, sumSquares = 0.0, maxAbs = 0.0;
+  for ( int i = 0; i < 37; i++ )
+  {
+    v[i] = ( i % 2 == 0 ? 1.0 : -1.0 ) * i * 0.25;
+    w[i] = static_cast<float> ( v[i] );
+    sum += v[i];
+    sumAbs += fabs ( v[i] );
+    sumSquares += v[i] * v[i];
+    maxAbs = std::max ( maxAbs, fabs ( v[i] ) );
+  }
+
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( sum, v.Sum(), 1e-12 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( sum / 37.0, v.Mean(), 1e-12 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( sumAbs, v.normL1(), 1e-12 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( sqrt ( sumSquares ), v.normL2(), 1e-12 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( maxAbs, v.normInf(), 1e-12 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( sumSquares, v.scalarProduct ( v ), 1e-12 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( 9.0, v.Max(), 1e-12 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( -8.75, v.Min(), 1e-12 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( sumAbs, w.normL1(), 1e-4 );
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( sum, w.Sum(), 1e-4 );
+
+  VectorT<double> a ( v );
+  a.absInplace();
+  CPPUNIT_ASSERT_DOUBLES_EQUAL ( sumAbs, a.Sum(), 1e-12 );
+  a -= v;
+  a *= 2.0;
+  a += 1.0;
+  a /= 2.0;
+  for ( int i = 0; i < 37; i++ )
+    CPPUNIT_ASSERT_DOUBLES_EQUAL ( v[i] < 0 ? 0.5 - 2.0 * v[i] : 0.5, a[i], 1e-12 );
+}
+
+#endif // NICE_USELIB_CPPUNIT
@@ -0,0 +1,56 @@
+/*
+ * NICE-Core - efficient algebra and computer vision methods
+ *  - libbasicvector - A simple vector library
+ * See file License for license information.
+ */
+#ifndef _TESTSIMDKERNELS_H
+#define _TESTSIMDKERNELS_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * CppUnit-Testcase.
+ * Compares the vectorized kernels of SimdKernels with the scalar versions
+ */
+class TestSimdKernels : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE( TestSimdKernels );
+  CPPUNIT_TEST( testDispatch );
+  CPPUNIT_TEST( testReductions );
+  CPPUNIT_TEST( testElementwise );
+  CPPUNIT_TEST( testConversions );
+  CPPUNIT_TEST( testVectorFunctions );
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+public:
+  void setUp();
+  void tearDown();
+
+  /**
+   * Test selection of the instruction set.
+   */
+  void testDispatch();
+
+  /**
+   * Test sums, dot product and extrema of all instruction sets.
+   */
+  void testReductions();
+
+  /**
+   * Test element-wise arithmetics of all instruction sets.
+   */
+  void testElementwise();
+
+  /**
+   * Test conversions between unsigned char and float of all instruction sets.
+   */
+  void testConversions();
+
+  /**
+   * Test the VectorT functions which use the kernels.
+   */
+  void testVectorFunctions();
+};
+
+#endif // _TESTSIMDKERNELS_H